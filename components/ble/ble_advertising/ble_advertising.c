@@ -810,4 +810,135 @@ ret_code_t ble_advertising_advdata_update(ble_advertising_t   * const p_advertis
 }
 
 
+ret_code_t ble_advertising_field_get(ble_advertising_t const * const p_advertising,
+                                     uint8_t                         ad_type,
+                                     bool                            scan_rsp,
+                                     ble_advertising_field_t * const p_field)
+{
+    VERIFY_PARAM_NOT_NULL(p_advertising);
+    VERIFY_PARAM_NOT_NULL(p_field);
+    if (p_advertising->initialized == false)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    ble_data_t const * p_data = scan_rsp ? &p_advertising->adv_data.scan_rsp_data
+                                         : &p_advertising->adv_data.adv_data;
+    uint16_t offset = 0;
+    uint16_t len    = ble_advdata_search(p_data->p_data, p_data->len, &offset, ad_type);
+
+    if (len == 0)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    p_field->offset   = offset;
+    p_field->len      = len;
+    p_field->ad_type  = ad_type;
+    p_field->scan_rsp = scan_rsp;
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for checking that a field handle still matches the encoded data.
+ */
+static bool field_is_valid(ble_data_t const * const p_data, ble_advertising_field_t const * const p_field)
+{
+    return (   (p_field->offset >= 2)
+            && ((p_field->offset + p_field->len) <= p_data->len)
+            && (p_data->p_data[p_field->offset - 2] == (p_field->len + 1))
+            && (p_data->p_data[p_field->offset - 1] == p_field->ad_type));
+}
+
+
+/**@brief Function for copying encoded data into the swap buffer.
+ *
+ * @param[inout] p_data   Encoded data. Points to the swap buffer on return.
+ * @param[in]    p_buf0   First of the two buffers used for this data.
+ * @param[in]    p_buf1   Second of the two buffers used for this data.
+ */
+static void data_to_swap_buffer(ble_data_t * const p_data, uint8_t * p_buf0, uint8_t * p_buf1)
+{
+    uint8_t * p_swap = (p_data->p_data != p_buf0) ? p_buf0 : p_buf1;
+
+    memcpy(p_swap, p_data->p_data, p_data->len);
+    p_data->p_data = p_swap;
+}
+
+
+ret_code_t ble_advertising_fields_patch(ble_advertising_t             * const p_advertising,
+                                        ble_advertising_patch_t const * const p_patches,
+                                        uint8_t                               patch_count)
+{
+    VERIFY_PARAM_NOT_NULL(p_advertising);
+    VERIFY_PARAM_NOT_NULL(p_patches);
+    if (p_advertising->initialized == false)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    ble_gap_adv_data_t new_adv_data = p_advertising->adv_data;
+
+    for (uint32_t i = 0; i < patch_count; i++)
+    {
+        ble_advertising_field_t const * p_field = p_patches[i].p_field;
+
+        VERIFY_PARAM_NOT_NULL(p_field);
+        VERIFY_PARAM_NOT_NULL(p_patches[i].p_data);
+
+        if (!field_is_valid(p_field->scan_rsp ? &new_adv_data.scan_rsp_data
+                                              : &new_adv_data.adv_data, p_field))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        if ((p_patches[i].offset + p_patches[i].len) > p_field->len)
+        {
+            return NRF_ERROR_INVALID_LENGTH;
+        }
+    }
+
+    // The SoftDevice may be using the current buffers, and it rejects an update during
+    // advertising that reuses any of them. All buffers in use are therefore copied, also the
+    // one that is not patched.
+    if (new_adv_data.adv_data.len != 0)
+    {
+        data_to_swap_buffer(&new_adv_data.adv_data,
+                            p_advertising->enc_advdata[0],
+                            p_advertising->enc_advdata[1]);
+    }
+
+    if (new_adv_data.scan_rsp_data.len != 0)
+    {
+        data_to_swap_buffer(&new_adv_data.scan_rsp_data,
+                            p_advertising->enc_scan_rsp_data[0],
+                            p_advertising->enc_scan_rsp_data[1]);
+    }
+
+    for (uint32_t i = 0; i < patch_count; i++)
+    {
+        ble_advertising_field_t const * p_field = p_patches[i].p_field;
+        ble_data_t              const * p_data  = p_field->scan_rsp ? &new_adv_data.scan_rsp_data
+                                                                    : &new_adv_data.adv_data;
+
+        memcpy(&p_data->p_data[p_field->offset + p_patches[i].offset],
+               p_patches[i].p_data,
+               p_patches[i].len);
+    }
+
+    p_advertising->adv_data = new_adv_data;
+
+    if (p_advertising->p_adv_data == NULL)
+    {
+        // Directed advertising is ongoing. The data is configured when undirected advertising starts.
+        return NRF_SUCCESS;
+    }
+
+    return sd_ble_gap_adv_set_configure(&p_advertising->adv_handle,
+                                        p_advertising->p_adv_data,
+                                        NULL);
+}
+
+
 #endif // NRF_MODULE_ENABLED(BLE_ADVERTISING)
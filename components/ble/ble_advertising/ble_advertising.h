@@ -193,6 +193,28 @@ typedef struct
     ble_adv_error_handler_t error_handler; /**< Error handler that will propogate internal errors to the main applications. */
 } ble_advertising_init_t;
 
+/**@brief   Handle of a field (AD structure) in the encoded advertising or scan response data.
+ *
+ * @details Obtained with @ref ble_advertising_field_get. The handle stays valid until the data is
+ *          encoded again with @ref ble_advertising_advdata_update.
+ */
+typedef struct
+{
+    uint16_t offset;   /**< Offset of the field data in the encoded data. */
+    uint16_t len;      /**< Length of the field data, excluding the length and AD type bytes. */
+    uint8_t  ad_type;  /**< AD type of the field. */
+    bool     scan_rsp; /**< Whether the field is in the scan response data. */
+} ble_advertising_field_t;
+
+/**@brief   New content for a part of a field, used with @ref ble_advertising_fields_patch. */
+typedef struct
+{
+    ble_advertising_field_t const * p_field; /**< Field to patch. */
+    uint16_t                        offset;  /**< Offset within the field data, e.g. 2 to skip the company identifier of manufacturer specific data. */
+    uint8_t                 const * p_data;  /**< New content. */
+    uint16_t                        len;     /**< Length of the new content. */
+} ble_advertising_patch_t;
+
 
 /**@brief   Function for handling BLE events.
  *
@@ -343,6 +365,50 @@ ret_code_t ble_advertising_advdata_update(ble_advertising_t   * const p_advertis
                                           ble_advdata_t const * const p_advdata,
                                           ble_advdata_t const * const p_srdata);
 
+
+/**@brief   Function for getting a handle to a field in the encoded advertising data.
+ *
+ * @details The handle can be used with @ref ble_advertising_fields_patch to change the content of
+ *          the field without encoding all advertising data again.
+ *
+ * @param[in]  p_advertising Advertising Module instance.
+ * @param[in]  ad_type       AD type of the field, e.g. @ref BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA.
+ *                           The first field of this type is used.
+ * @param[in]  scan_rsp      Whether to search the scan response data instead of the advertising data.
+ * @param[out] p_field       Handle to the field.
+ *
+ * @retval @ref NRF_SUCCESS             If the field was found.
+ * @retval @ref NRF_ERROR_NULL          If \p p_advertising or \p p_field was null.
+ * @retval @ref NRF_ERROR_INVALID_STATE If advertising instance was not initialized.
+ * @retval @ref NRF_ERROR_NOT_FOUND     If there is no field of type \p ad_type.
+ */
+ret_code_t ble_advertising_field_get(ble_advertising_t const * const p_advertising,
+                                     uint8_t                         ad_type,
+                                     bool                            scan_rsp,
+                                     ble_advertising_field_t * const p_field);
+
+
+/**@brief   Function for changing the content of fields in the encoded advertising data.
+ *
+ * @details The current encoded data is copied to the swap buffer, the patches are applied to the
+ *          copy, and the buffers are swapped with a single call to
+ *          @ref sd_ble_gap_adv_set_configure(). The length of a field cannot be changed; use
+ *          @ref ble_advertising_advdata_update for that.
+ *
+ * @param[in]  p_advertising Advertising Module instance.
+ * @param[in]  p_patches     Patches to apply.
+ * @param[in]  patch_count   Number of elements in \p p_patches.
+ *
+ * @retval @ref NRF_ERROR_NULL           If \p p_advertising or \p p_patches was null.
+ * @retval @ref NRF_ERROR_INVALID_STATE  If advertising instance was not initialized.
+ * @retval @ref NRF_ERROR_INVALID_PARAM  If a field handle does not match the encoded data.
+ * @retval @ref NRF_ERROR_INVALID_LENGTH If a patch does not fit within its field.
+ * @retval @ref NRF_SUCCESS or any error from @ref sd_ble_gap_adv_set_configure().
+ */
+ret_code_t ble_advertising_fields_patch(ble_advertising_t             * const p_advertising,
+                                        ble_advertising_patch_t const * const p_patches,
+                                        uint8_t                               patch_count);
+
 /** @} */
 
 
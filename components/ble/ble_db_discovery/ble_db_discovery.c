@@ -44,6 +44,9 @@
 #include "ble_db_discovery.h"
 #include <stdlib.h>
 #include "ble_srv_common.h"
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+#include "fds.h"
+#endif
 #define NRF_LOG_MODULE_NAME ble_db_disc
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
@@ -61,6 +64,27 @@ static nrf_ble_gq_t                   * mp_gatt_queue; /**< Pointer to BLE GATT
 static uint32_t m_num_of_handlers_reg;      /**< The number of handlers registered with the DB Discovery module. */
 static bool     m_initialized = false;      /**< This variable Indicates if the module is initialized or not. */
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+#define CACHE_RECORD_VERSION   1            /**< Version of the cache record layout. */
+#define DB_HASH_CHAR_UUID      0x2B2A       /**< UUID of the Database Hash characteristic. */
+
+/**@brief Cached results of the discovery of one peer. */
+typedef struct
+{
+    uint8_t           version;                                  /**< Record layout version. */
+    uint8_t           srv_count;                                /**< Number of registered services at the time of the discovery. */
+    uint8_t           hash_valid;                               /**< The peer provided a Database Hash. */
+    uint8_t           reserved;
+    uint8_t           hash[BLE_DB_DISCOVERY_DB_HASH_LEN];       /**< Database Hash of the peer. */
+    ble_uuid_t        srv_uuids[BLE_DB_DISCOVERY_MAX_SRV];      /**< Registered services at the time of the discovery. */
+    ble_gatt_db_srv_t services[BLE_DB_DISCOVERY_MAX_SRV];       /**< Discovered services. */
+} cache_record_t;
+
+static cache_record_t m_cache_record;           /**< Record being written to flash. */
+static bool           m_cache_write_pending;    /**< @ref m_cache_record is in use by FDS. */
+static bool           m_cache_fds_registered;   /**< The FDS event handler has been registered. */
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
 /**@brief     Function for fetching the event handler provided by a registered application module.
  *
  * @param[in] srv_uuid UUID of the service.
@@ -112,6 +136,138 @@ static uint32_t registered_handler_set(ble_uuid_t                     const * p_
 }
 
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+/**@brief Function for handling FDS events related to the cache records.
+ *
+ * @param[in] p_evt FDS event.
+ */
+static void cache_fds_evt_handler(fds_evt_t const * p_evt)
+{
+    if (((p_evt->id == FDS_EVT_WRITE) || (p_evt->id == FDS_EVT_UPDATE)) &&
+        (p_evt->write.file_id == BLE_DB_DISCOVERY_CACHE_FILE_ID))
+    {
+        m_cache_write_pending = false;
+
+        if (p_evt->result != NRF_SUCCESS)
+        {
+            NRF_LOG_WARNING("Storing discovery cache record 0x%04X failed, error: 0x%08X.",
+                            p_evt->write.record_key, p_evt->result);
+        }
+    }
+}
+
+
+/**@brief Function for storing the results of a completed discovery in the cache.
+ *
+ * @param[in] p_db_discovery Pointer to the DB discovery structure.
+ */
+static void cache_store(ble_db_discovery_t const * p_db_discovery)
+{
+    ret_code_t        err_code;
+    fds_record_desc_t desc;
+    fds_find_token_t  token;
+    fds_record_t      record;
+
+    if (m_cache_write_pending)
+    {
+        // Skipped, the discovery will be done again on the next connection.
+        NRF_LOG_WARNING("Discovery cache busy, results not stored.");
+        return;
+    }
+
+    memset(&m_cache_record, 0, sizeof(m_cache_record));
+    m_cache_record.version    = CACHE_RECORD_VERSION;
+    m_cache_record.srv_count  = (uint8_t)m_num_of_handlers_reg;
+    m_cache_record.hash_valid = p_db_discovery->cache.hash_valid;
+    memcpy(m_cache_record.hash, p_db_discovery->cache.hash, sizeof(m_cache_record.hash));
+    memcpy(m_cache_record.srv_uuids, m_registered_handlers, sizeof(m_cache_record.srv_uuids));
+    memcpy(m_cache_record.services, p_db_discovery->services, sizeof(m_cache_record.services));
+
+    record.file_id           = BLE_DB_DISCOVERY_CACHE_FILE_ID;
+    record.key               = p_db_discovery->cache.peer_key + 1;
+    record.data.p_data       = &m_cache_record;
+    record.data.length_words = BYTES_TO_WORDS(sizeof(m_cache_record));
+
+    memset(&token, 0, sizeof(token));
+    if (fds_record_find(record.file_id, record.key, &desc, &token) == NRF_SUCCESS)
+    {
+        err_code = fds_record_update(&desc, &record);
+    }
+    else
+    {
+        err_code = fds_record_write(NULL, &record);
+    }
+
+    if (err_code == NRF_SUCCESS)
+    {
+        m_cache_write_pending = true;
+    }
+    else
+    {
+        NRF_LOG_WARNING("Discovery cache record not stored, error: 0x%08X.", err_code);
+    }
+}
+
+
+/**@brief Function for loading the cached discovery results of a peer.
+ *
+ * @details The results are used only if they were obtained with the same registered services
+ *          and the same Database Hash as the current ones.
+ *
+ * @param[in,out] p_db_discovery Pointer to the DB discovery structure. The services are filled in
+ *                               on success.
+ *
+ * @retval    true  If valid results were loaded.
+ * @retval    false If there are no valid results in the cache.
+ */
+static bool cache_load(ble_db_discovery_t * p_db_discovery)
+{
+    fds_record_desc_t      desc;
+    fds_find_token_t       token;
+    fds_flash_record_t     flash_record;
+    cache_record_t const * p_record;
+    bool                   hit = false;
+
+    memset(&token, 0, sizeof(token));
+    if (fds_record_find(BLE_DB_DISCOVERY_CACHE_FILE_ID,
+                        p_db_discovery->cache.peer_key + 1,
+                        &desc,
+                        &token) != NRF_SUCCESS)
+    {
+        return false;
+    }
+
+    if (fds_record_open(&desc, &flash_record) != NRF_SUCCESS)
+    {
+        return false;
+    }
+
+    p_record = (cache_record_t const *)flash_record.p_data;
+
+    if ((flash_record.p_header->length_words == BYTES_TO_WORDS(sizeof(cache_record_t))) &&
+        (p_record->version    == CACHE_RECORD_VERSION)                                  &&
+        (p_record->srv_count  == m_num_of_handlers_reg)                                 &&
+        (p_record->hash_valid == p_db_discovery->cache.hash_valid)                      &&
+        (memcmp(p_record->srv_uuids,
+                m_registered_handlers,
+                m_num_of_handlers_reg * sizeof(ble_uuid_t)) == 0))
+    {
+        hit = !p_record->hash_valid ||
+              (memcmp(p_record->hash, p_db_discovery->cache.hash, sizeof(p_record->hash)) == 0);
+    }
+
+    if (hit)
+    {
+        memcpy(p_db_discovery->services, p_record->services, sizeof(p_db_discovery->services));
+        p_db_discovery->srv_count = p_record->srv_count;
+    }
+
+    UNUSED_RETURN_VALUE(fds_record_close(&desc));
+    return hit;
+}
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
+
 /**@brief Function for sending all pending discovery events to the corresponding user modules.
  */
 static void pending_user_evts_send(ble_db_discovery_t * p_db_discovery)
@@ -330,6 +486,13 @@ static void on_srv_disc_completion(ble_db_discovery_t * p_db_discovery,
         // No more service discovery is needed.
         p_db_discovery->discovery_in_progress  = false;
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+        if (p_db_discovery->cache.active)
+        {
+            cache_store(p_db_discovery);
+        }
+#endif
+
         discovery_available_evt_trigger(p_db_discovery, conn_handle);
     }
 }
@@ -893,6 +1056,14 @@ uint32_t ble_db_discovery_init(ble_db_discovery_init_t * p_db_init)
     m_evt_handler           = p_db_init->evt_handler;
     mp_gatt_queue           = p_db_init->p_gatt_queue;
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+    if (!m_cache_fds_registered)
+    {
+        err_code = fds_register(cache_fds_evt_handler);
+        VERIFY_SUCCESS(err_code);
+        m_cache_fds_registered = true;
+    }
+#endif
 
     return err_code;
 }
@@ -923,7 +1094,14 @@ static uint32_t discovery_start(ble_db_discovery_t * const p_db_discovery, uint1
     ble_gatt_db_srv_t * p_srv_being_discovered;
     nrf_ble_gq_req_t    db_srv_disc_req;
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+    ble_db_discovery_cache_t cache = p_db_discovery->cache;
+
+    memset(p_db_discovery, 0x00, sizeof(ble_db_discovery_t));
+    p_db_discovery->cache = cache;
+#else
     memset(p_db_discovery, 0x00, sizeof(ble_db_discovery_t));
+#endif
     memset(&db_srv_disc_req, 0x00, sizeof(nrf_ble_gq_req_t));
 
     err_code = nrf_ble_gq_conn_handle_register(mp_gatt_queue, conn_handle);
@@ -976,10 +1154,186 @@ uint32_t ble_db_discovery_start(ble_db_discovery_t * const p_db_discovery, uint1
         return NRF_ERROR_BUSY;
     }
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+    memset(&p_db_discovery->cache, 0x00, sizeof(ble_db_discovery_cache_t));
+#endif
+
+    return discovery_start(p_db_discovery, conn_handle);
+}
+
+
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+/**@brief     Function for raising the events of a discovery loaded from the cache.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ */
+static void cache_replay(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    NRF_LOG_DEBUG("Discovery on connection handle 0x%x served from the cache.", conn_handle);
+
+    p_db_discovery->pending_usr_evt_index = 0;
+
+    for (uint32_t i = 0; i < m_num_of_handlers_reg; i++)
+    {
+        bool is_srv_found = (p_db_discovery->services[i].handle_range.start_handle != 0);
+
+        p_db_discovery->curr_srv_ind = i;
+        discovery_complete_evt_trigger(p_db_discovery, is_srv_found, conn_handle);
+    }
+
+    p_db_discovery->discoveries_count     = m_num_of_handlers_reg;
+    p_db_discovery->discovery_in_progress = false;
+
+    discovery_available_evt_trigger(p_db_discovery, conn_handle);
+}
+
+
+/**@brief     Function for serving the discovery from the cache or starting a full discovery.
+ *
+ * @param[in] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in] conn_handle    Connection Handle.
+ *
+ * @return    NRF_SUCCESS, or the error code returned by @ref discovery_start.
+ */
+static uint32_t cache_check(ble_db_discovery_t * p_db_discovery, uint16_t conn_handle)
+{
+    p_db_discovery->cache.hash_pending = false;
+
+    if (cache_load(p_db_discovery))
+    {
+        cache_replay(p_db_discovery, conn_handle);
+        return NRF_SUCCESS;
+    }
+
+    NRF_LOG_DEBUG("No valid discovery cache for peer 0x%04X.", p_db_discovery->cache.peer_key);
     return discovery_start(p_db_discovery, conn_handle);
 }
 
 
+uint32_t ble_db_discovery_cached_start(ble_db_discovery_t * const p_db_discovery,
+                                       uint16_t                   conn_handle,
+                                       uint16_t                   peer_key)
+{
+    ret_code_t       err_code;
+    nrf_ble_gq_req_t hash_read_req;
+
+    VERIFY_PARAM_NOT_NULL(p_db_discovery);
+    VERIFY_MODULE_INITIALIZED();
+
+    if (m_num_of_handlers_reg == 0)
+    {
+        // No user modules were registered. There are no services to discover.
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (p_db_discovery->discovery_in_progress)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    if (peer_key > BLE_DB_DISCOVERY_CACHE_KEY_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_db_discovery, 0x00, sizeof(ble_db_discovery_t));
+
+    err_code = nrf_ble_gq_conn_handle_register(mp_gatt_queue, conn_handle);
+    VERIFY_SUCCESS(err_code);
+
+    p_db_discovery->conn_handle    = conn_handle;
+    p_db_discovery->cache.active   = true;
+    p_db_discovery->cache.peer_key = peer_key;
+
+    // Read the Database Hash. The cache is checked when the read completes.
+    memset(&hash_read_req, 0x00, sizeof(nrf_ble_gq_req_t));
+
+    hash_read_req.type                                                = NRF_BLE_GQ_REQ_GATTC_READ_BY_UUID;
+    hash_read_req.params.gattc_read_by_uuid.uuid.type                 = BLE_UUID_TYPE_BLE;
+    hash_read_req.params.gattc_read_by_uuid.uuid.uuid                 = DB_HASH_CHAR_UUID;
+    hash_read_req.params.gattc_read_by_uuid.handle_range.start_handle = SRV_DISC_START_HANDLE;
+    hash_read_req.params.gattc_read_by_uuid.handle_range.end_handle   = BLE_GATT_HANDLE_END;
+    hash_read_req.error_handler.p_ctx                                 = p_db_discovery;
+    hash_read_req.error_handler.cb                                    = discovery_error_handler;
+
+    // A request refused by the SoftDevice is reported to the error handler from within
+    // nrf_ble_gq_item_add().
+    p_db_discovery->cache.hash_pending    = true;
+    p_db_discovery->discovery_in_progress = true;
+
+    err_code = nrf_ble_gq_item_add(mp_gatt_queue, &hash_read_req, conn_handle);
+    if (err_code != NRF_SUCCESS)
+    {
+        p_db_discovery->cache.hash_pending    = false;
+        p_db_discovery->discovery_in_progress = false;
+    }
+
+    return err_code;
+}
+
+
+uint32_t ble_db_discovery_cache_invalidate(uint16_t peer_key)
+{
+    fds_record_desc_t desc;
+    fds_find_token_t  token;
+
+    if (peer_key > BLE_DB_DISCOVERY_CACHE_KEY_MAX)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(&token, 0, sizeof(token));
+    if (fds_record_find(BLE_DB_DISCOVERY_CACHE_FILE_ID, peer_key + 1, &desc, &token) != NRF_SUCCESS)
+    {
+        return NRF_SUCCESS;
+    }
+
+    return fds_record_delete(&desc);
+}
+
+
+/**@brief     Function for handling the Database Hash read response.
+ *
+ * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
+ * @param[in] p_ble_gattc_evt   Pointer to the GATT Client event.
+ */
+static void on_db_hash_read_rsp(ble_db_discovery_t       * p_db_discovery,
+                                ble_gattc_evt_t    const * p_ble_gattc_evt)
+{
+    ble_gattc_evt_char_val_by_uuid_read_rsp_t const * p_rsp;
+    uint32_t                                          err_code;
+
+    if ((p_ble_gattc_evt->conn_handle != p_db_discovery->conn_handle) ||
+        !p_db_discovery->cache.hash_pending)
+    {
+        return;
+    }
+
+    p_rsp = &p_ble_gattc_evt->params.char_val_by_uuid_read_rsp;
+
+    if ((p_ble_gattc_evt->gatt_status == BLE_GATT_STATUS_SUCCESS) &&
+        (p_rsp->count > 0)                                         &&
+        (p_rsp->value_len == BLE_DB_DISCOVERY_DB_HASH_LEN))
+    {
+        // The list holds the handle followed by the value.
+        memcpy(p_db_discovery->cache.hash,
+               &p_rsp->handle_value[sizeof(uint16_t)],
+               BLE_DB_DISCOVERY_DB_HASH_LEN);
+        p_db_discovery->cache.hash_valid = true;
+    }
+
+    p_db_discovery->discovery_in_progress = false;
+
+    err_code = cache_check(p_db_discovery, p_ble_gattc_evt->conn_handle);
+    if (err_code != NRF_SUCCESS)
+    {
+        discovery_error_handler(err_code, p_db_discovery, p_ble_gattc_evt->conn_handle);
+    }
+}
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
+
 /**@brief     Function for handling disconnected event.
  *
  * @param[in] p_db_discovery    Pointer to the DB Discovery structure.
@@ -1019,6 +1373,12 @@ void ble_db_discovery_on_ble_evt(ble_evt_t const * p_ble_evt,
             on_descriptor_discovery_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
             break;
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+        case BLE_GATTC_EVT_CHAR_VAL_BY_UUID_READ_RSP:
+            on_db_hash_read_rsp(p_db_discovery, &(p_ble_evt->evt.gattc_evt));
+            break;
+#endif
+
         case BLE_GAP_EVT_DISCONNECTED:
             on_disconnected(p_db_discovery, &(p_ble_evt->evt.gap_evt));
             break;
@@ -64,6 +64,10 @@
  * @note The application must propagate BLE stack events to this module by calling
  *       ble_db_discovery_on_ble_evt().
  *
+ * @note If @ref BLE_DB_DISCOVERY_CACHE_ENABLED is set, the results of discoveries started with
+ *       @ref ble_db_discovery_cached_start are stored in flash using FDS. Later discoveries of
+ *       the same peer are served from the cache if the peer's Database Hash did not change.
+ *
  */
 
 #ifndef BLE_DB_DISCOVERY_H__
@@ -125,6 +129,9 @@ NRF_SDH_BLE_OBSERVERS(_name ## _obs,
 
 #define BLE_DB_DISCOVERY_MAX_SRV        6   /**< Maximum number of services supported by this module. This also indicates the maximum number of users allowed to be registered to this module (one user per service). */
 
+#define BLE_DB_DISCOVERY_CACHE_KEY_MAX  0xBFFE  /**< Largest peer key that can be used with the cache. */
+#define BLE_DB_DISCOVERY_DB_HASH_LEN    16      /**< Length of the GATT Database Hash. */
+
 
 /**@brief DB Discovery event type. */
 typedef enum
@@ -158,6 +165,18 @@ typedef struct
     ble_db_discovery_evt_handler_t evt_handler;  /**< Event handler which should be called to raise this event. */
 } ble_db_discovery_user_evt_t;
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+/**@brief Structure for holding the cache state of a discovery. */
+typedef struct
+{
+    bool     active;                             /**< Discovery results are stored in the cache when the discovery completes. */
+    bool     hash_pending;                       /**< Database Hash read is in progress. */
+    bool     hash_valid;                         /**< @p hash holds the Database Hash of the peer. */
+    uint16_t peer_key;                           /**< Key identifying the peer in the cache. */
+    uint8_t  hash[BLE_DB_DISCOVERY_DB_HASH_LEN]; /**< Database Hash read from the peer. */
+} ble_db_discovery_cache_t;
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
 /**@brief Structure for holding the information related to the GATT database at the server.
  *
  * @details This module identifies a remote database. Use one instance of this structure per
@@ -176,6 +195,9 @@ typedef struct
     uint16_t                    conn_handle;                                /**< Connection handle on which the discovery is started. */
     uint32_t                    pending_usr_evt_index;                      /**< The index to the pending user event array, pointing to the last added pending user event. */
     ble_db_discovery_user_evt_t pending_usr_evts[BLE_DB_DISCOVERY_MAX_SRV]; /**< Whenever a discovery related event is to be raised to a user module, it is stored in this array first. When all expected services have been discovered, all pending events are sent to the corresponding user modules. */
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+    ble_db_discovery_cache_t    cache;                                      /**< Cache state. This is intended for internal use during service discovery. */
+#endif
 } ble_db_discovery_t;
 
 /**@brief DB discovery module initialization struct. */
@@ -253,6 +275,49 @@ uint32_t ble_db_discovery_start(ble_db_discovery_t * p_db_discovery,
                                 uint16_t             conn_handle);
 
 
+#if BLE_DB_DISCOVERY_CACHE_ENABLED
+/**@brief Function for starting the discovery of the GATT database at a known server.
+ *
+ * @details The Database Hash characteristic of the peer is read first, through the GATT Queue.
+ *          When the read completes and the cache holds the results of an earlier discovery of
+ *          the peer, made with the same registered services and with the same Database Hash,
+ *          the @ref BLE_DB_DISCOVERY_COMPLETE and @ref BLE_DB_DISCOVERY_SRV_NOT_FOUND events are
+ *          raised from the cache. Otherwise, a full discovery is performed and its results are
+ *          stored in the cache.
+ *
+ *          A peer without the Database Hash characteristic is served from the cache as long
+ *          as the cache record exists. Call @ref ble_db_discovery_cache_invalidate when such
+ *          a peer indicates Service Changed.
+ *
+ * @note    The application must initialize FDS before calling this function.
+ *
+ * @param[out] p_db_discovery Pointer to the DB Discovery structure.
+ * @param[in]  conn_handle    The handle of the connection for which the discovery should be
+ *                            started.
+ * @param[in]  peer_key       Key identifying the peer, for example the Peer Manager peer ID. Must
+ *                            not exceed @ref BLE_DB_DISCOVERY_CACHE_KEY_MAX.
+ *
+ * @retval NRF_SUCCESS             Operation success.
+ * @retval NRF_ERROR_INVALID_PARAM If @p peer_key is out of range.
+ * @return                         Other error codes as for @ref ble_db_discovery_start.
+ */
+uint32_t ble_db_discovery_cached_start(ble_db_discovery_t * p_db_discovery,
+                                       uint16_t             conn_handle,
+                                       uint16_t             peer_key);
+
+
+/**@brief Function for removing the cached discovery results of a peer.
+ *
+ * @param[in] peer_key Key identifying the peer.
+ *
+ * @retval NRF_SUCCESS             If the results were removed or there were none.
+ * @retval NRF_ERROR_INVALID_PARAM If @p peer_key is out of range.
+ * @return                         Other error codes returned by @ref fds_record_delete.
+ */
+uint32_t ble_db_discovery_cache_invalidate(uint16_t peer_key);
+#endif // BLE_DB_DISCOVERY_CACHE_ENABLED
+
+
 /**@brief Function for handling the Application's BLE Stack events.
  *
  * @param[in]     p_ble_evt Pointer to the BLE event received.
@@ -42,6 +42,7 @@
 #include "ble.h"
 #include "ble_nus.h"
 #include "ble_srv_common.h"
+#include "app_util_platform.h"
 
 #define NRF_LOG_MODULE_NAME ble_nus
 #if BLE_NUS_CONFIG_LOG_ENABLED
@@ -64,6 +65,136 @@ NRF_LOG_MODULE_REGISTER();
 #define NUS_BASE_UUID                  {{0x9E, 0xCA, 0xDC, 0x24, 0x0E, 0xE5, 0xA9, 0xE0, 0x93, 0xF3, 0xA3, 0xB5, 0x00, 0x00, 0x40, 0x6E}} /**< Used vendor specific UUID. */
 
 
+/**@brief Function for getting the payload size of the notifications sent by the stream.
+ *
+ * @param[in] p_stream Streaming TX buffer.
+ */
+static uint16_t stream_payload_len(ble_nus_stream_t const * p_stream)
+{
+    uint16_t mtu = BLE_GATT_ATT_MTU_DEFAULT;
+
+    if (p_stream->p_gatt != NULL)
+    {
+        mtu = nrf_ble_gatt_eff_mtu_get(p_stream->p_gatt, p_stream->conn_handle);
+    }
+
+    return MIN(mtu - OPCODE_LENGTH - HANDLE_LENGTH, BLE_NUS_MAX_DATA_LEN);
+}
+
+
+/**@brief Function for moving the data from the stream to the SoftDevice until its TX queue is full.
+ *
+ * @param[in] p_nus Nordic UART Service structure.
+ */
+static void stream_fill(ble_nus_t * p_nus)
+{
+    ret_code_t                 err_code;
+    ble_gatts_hvx_params_t     hvx_params;
+    ble_nus_client_context_t * p_client;
+    ble_nus_stream_t         * p_stream = p_nus->p_stream;
+    nrf_ringbuf_t const      * p_ringbuf;
+    uint16_t                   payload_len;
+    uint8_t                    packet[BLE_NUS_MAX_DATA_LEN];
+
+    if (p_stream == NULL)
+    {
+        return;
+    }
+
+    err_code = blcm_link_ctx_get(p_nus->p_link_ctx_storage, p_stream->conn_handle, (void *) &p_client);
+    if ((err_code != NRF_SUCCESS) || (p_client == NULL) || !p_client->is_notification_enabled)
+    {
+        return;
+    }
+
+    p_ringbuf   = p_stream->p_ringbuf;
+    payload_len = stream_payload_len(p_stream);
+
+    memset(&hvx_params, 0, sizeof(hvx_params));
+    hvx_params.handle = p_nus->tx_handles.value_handle;
+    hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+
+    for (;;)
+    {
+        uint8_t * p_data;
+        size_t    length = payload_len;
+        uint16_t  hvx_len;
+
+        err_code = nrf_ringbuf_get(p_ringbuf, &p_data, &length, true);
+        if ((err_code != NRF_SUCCESS) || (length == 0))
+        {
+            // Buffer empty, access was released by nrf_ringbuf_get.
+            return;
+        }
+
+        if (length < payload_len)
+        {
+            // The data may continue from the beginning of the buffer.
+            uint8_t * p_tail;
+            size_t    tail_length = payload_len - length;
+
+            UNUSED_RETURN_VALUE(nrf_ringbuf_get(p_ringbuf, &p_tail, &tail_length, false));
+            if (tail_length != 0)
+            {
+                memcpy(packet, p_data, length);
+                memcpy(&packet[length], p_tail, tail_length);
+                p_data  = packet;
+                length += tail_length;
+            }
+        }
+
+        // The SoftDevice copies the notification data, so it can be freed right away.
+        hvx_len           = (uint16_t)length;
+        hvx_params.p_data = p_data;
+        hvx_params.p_len  = &hvx_len;
+
+        err_code = sd_ble_gatts_hvx(p_stream->conn_handle, &hvx_params);
+        if (err_code != NRF_SUCCESS)
+        {
+            UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_ringbuf, 0));
+            if (err_code == NRF_ERROR_RESOURCES)
+            {
+                p_stream->stats.queue_full++;
+            }
+            else
+            {
+                NRF_LOG_WARNING("Stream notification failed, error: 0x%08X.", err_code);
+            }
+            return;
+        }
+
+        UNUSED_RETURN_VALUE(nrf_ringbuf_free(p_ringbuf, hvx_len));
+        p_stream->stats.bytes_sent += hvx_len;
+        p_stream->stats.packets_sent++;
+    }
+}
+
+
+/**@brief Function for requesting data to be moved from the stream to the SoftDevice.
+ *
+ * @details Requests from different contexts are serialized. A request made while the data is
+ *          being moved in another context is executed by that context before it returns.
+ *
+ * @param[in] p_nus Nordic UART Service structure.
+ */
+static void stream_kick(ble_nus_t * p_nus)
+{
+    ble_nus_stream_t * p_stream = p_nus->p_stream;
+    uint32_t           req;
+
+    if ((p_stream == NULL) || (nrf_atomic_u32_add(&p_stream->fill_req, 1) != 1))
+    {
+        return;
+    }
+
+    do
+    {
+        req = p_stream->fill_req;
+        stream_fill(p_nus);
+    } while (nrf_atomic_u32_sub(&p_stream->fill_req, req) != 0);
+}
+
+
 /**@brief Function for handling the @ref BLE_GAP_EVT_CONNECTED event from the SoftDevice.
  *
  * @param[in] p_nus     Nordic UART Service structure.
@@ -116,6 +247,22 @@ static void on_connect(ble_nus_t * p_nus, ble_evt_t const * p_ble_evt)
 }
 
 
+/**@brief Function for handling the @ref BLE_GAP_EVT_DISCONNECTED event from the SoftDevice.
+ *
+ * @param[in] p_nus     Nordic UART Service structure.
+ * @param[in] p_ble_evt Pointer to the event received from BLE stack.
+ */
+static void on_disconnect(ble_nus_t * p_nus, ble_evt_t const * p_ble_evt)
+{
+    if ((p_nus->p_stream != NULL) &&
+        (p_nus->p_stream->conn_handle == p_ble_evt->evt.gap_evt.conn_handle))
+    {
+        p_nus->p_stream->conn_handle = BLE_CONN_HANDLE_INVALID;
+        p_nus->p_stream              = NULL;
+    }
+}
+
+
 /**@brief Function for handling the @ref BLE_GATTS_EVT_WRITE event from the SoftDevice.
  *
  * @param[in] p_nus     Nordic UART Service structure.
@@ -163,6 +310,10 @@ static void on_write(ble_nus_t * p_nus, ble_evt_t const * p_ble_evt)
                 p_nus->data_handler(&evt);
             }
 
+            if ((p_nus->p_stream != NULL) && (p_nus->p_stream->conn_handle == evt.conn_handle))
+            {
+                stream_kick(p_nus);
+            }
         }
     }
     else if ((p_evt_write->handle == p_nus->rx_handles.value_handle) &&
@@ -202,6 +353,13 @@ static void on_hvx_tx_complete(ble_nus_t * p_nus, ble_evt_t const * p_ble_evt)
         return;
     }
 
+    if ((p_nus->p_stream != NULL) &&
+        (p_nus->p_stream->conn_handle == p_ble_evt->evt.gatts_evt.conn_handle))
+    {
+        p_nus->p_stream->stats.tx_complete += p_ble_evt->evt.gatts_evt.params.hvn_tx_complete.count;
+        stream_kick(p_nus);
+    }
+
     if ((p_client->is_notification_enabled) && (p_nus->data_handler != NULL))
     {
         memset(&evt, 0, sizeof(ble_nus_evt_t));
@@ -230,6 +388,10 @@ void ble_nus_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
             on_connect(p_nus, p_ble_evt);
             break;
 
+        case BLE_GAP_EVT_DISCONNECTED:
+            on_disconnect(p_nus, p_ble_evt);
+            break;
+
         case BLE_GATTS_EVT_WRITE:
             on_write(p_nus, p_ble_evt);
             break;
@@ -351,4 +513,83 @@ uint32_t ble_nus_data_send(ble_nus_t * p_nus,
 }
 
 
+uint32_t ble_nus_stream_attach(ble_nus_t            * p_nus,
+                               ble_nus_stream_t     * p_stream,
+                               nrf_ble_gatt_t const * p_gatt,
+                               uint16_t               conn_handle)
+{
+    VERIFY_PARAM_NOT_NULL(p_nus);
+    VERIFY_PARAM_NOT_NULL(p_stream);
+
+    if (conn_handle == BLE_CONN_HANDLE_INVALID)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    nrf_ringbuf_init(p_stream->p_ringbuf);
+    memset(&p_stream->stats, 0, sizeof(p_stream->stats));
+    p_stream->p_gatt      = p_gatt;
+    p_stream->conn_handle = conn_handle;
+    p_stream->fill_req    = 0;
+    p_nus->p_stream       = p_stream;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ble_nus_stream_write(ble_nus_t     * p_nus,
+                              uint8_t const * p_data,
+                              uint16_t      * p_length)
+{
+    ret_code_t         err_code;
+    ble_nus_stream_t * p_stream;
+    size_t             length;
+
+    VERIFY_PARAM_NOT_NULL(p_nus);
+    VERIFY_PARAM_NOT_NULL(p_data);
+    VERIFY_PARAM_NOT_NULL(p_length);
+
+    p_stream = p_nus->p_stream;
+    if (p_stream == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    length = *p_length;
+
+    // The ring buffer supports a single producer, so writers are serialized.
+    CRITICAL_REGION_ENTER();
+    err_code = nrf_ringbuf_cpy_put(p_stream->p_ringbuf, p_data, &length);
+    if (err_code == NRF_SUCCESS)
+    {
+        nrf_ringbuf_cb_t const * p_cb = p_stream->p_ringbuf->p_cb;
+        uint32_t                 fill = p_cb->wr_idx - p_cb->rd_idx;
+
+        p_stream->stats.bytes_queued   += length;
+        p_stream->stats.bytes_rejected += *p_length - length;
+        p_stream->stats.buffer_max      = MAX(p_stream->stats.buffer_max, fill);
+    }
+    CRITICAL_REGION_EXIT();
+    VERIFY_SUCCESS(err_code);
+
+    stream_kick(p_nus);
+
+    err_code  = (length == *p_length) ? NRF_SUCCESS : NRF_ERROR_NO_MEM;
+    *p_length = (uint16_t)length;
+
+    return err_code;
+}
+
+
+void ble_nus_stream_stats_get(ble_nus_stream_t const * p_stream, ble_nus_stream_stats_t * p_stats)
+{
+    ASSERT(p_stream != NULL);
+    ASSERT(p_stats != NULL);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = p_stream->stats;
+    CRITICAL_REGION_EXIT();
+}
+
+
 #endif // NRF_MODULE_ENABLED(BLE_NUS)
@@ -70,6 +70,9 @@
 #include "ble_srv_common.h"
 #include "nrf_sdh_ble.h"
 #include "ble_link_ctx_manager.h"
+#include "nrf_ble_gatt.h"
+#include "nrf_ringbuf.h"
+#include "nrf_atomic.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -94,6 +97,20 @@ extern "C" {
                          ble_nus_on_ble_evt,                      \
                          &_name)
 
+/**@brief   Macro for defining a ble_nus streaming TX buffer.
+ *
+ * @param     _name Name of the instance.
+ * @param[in] _size Size of the ring buffer for the data to be sent (must be a power of 2).
+ * @hideinitializer
+ */
+#define BLE_NUS_STREAM_DEF(_name, _size)               \
+    NRF_RINGBUF_DEF(CONCAT_2(_name, _ringbuf), _size); \
+    static ble_nus_stream_t _name =                    \
+    {                                                  \
+        .p_ringbuf   = &CONCAT_2(_name, _ringbuf),     \
+        .conn_handle = BLE_CONN_HANDLE_INVALID         \
+    }
+
 #define BLE_UUID_NUS_SERVICE 0x0001 /**< The UUID of the Nordic UART Service. */
 
 #define OPCODE_LENGTH        1
@@ -176,6 +193,36 @@ typedef struct
 } ble_nus_init_t;
 
 
+/**@brief   Nordic UART Service streaming TX statistics.
+ *
+ * @details Counters wrap around. Throughput can be derived by sampling @p bytes_sent periodically.
+ */
+typedef struct
+{
+    uint32_t bytes_queued;   /**< Bytes accepted by @ref ble_nus_stream_write. */
+    uint32_t bytes_rejected; /**< Bytes not accepted by @ref ble_nus_stream_write because the buffer was full. */
+    uint32_t bytes_sent;     /**< Bytes passed to the SoftDevice. */
+    uint32_t packets_sent;   /**< Notifications passed to the SoftDevice. */
+    uint32_t tx_complete;    /**< Notifications reported as transmitted by the SoftDevice. */
+    uint32_t queue_full;     /**< Number of times the SoftDevice TX queue was found full. */
+    uint32_t buffer_max;     /**< Highest fill level of the buffer (in bytes). */
+} ble_nus_stream_stats_t;
+
+
+/**@brief   Nordic UART Service streaming TX buffer.
+ *
+ * @details Must be defined using @ref BLE_NUS_STREAM_DEF.
+ */
+typedef struct
+{
+    nrf_ringbuf_t const  * p_ringbuf;   /**< Ring buffer with the data to be sent. */
+    nrf_ble_gatt_t const * p_gatt;      /**< GATT module instance used to get the effective ATT MTU. */
+    uint16_t               conn_handle; /**< Handle of the connection the stream is attached to. */
+    nrf_atomic_u32_t       fill_req;    /**< Number of pending requests to move data to the SoftDevice. */
+    ble_nus_stream_stats_t stats;       /**< Statistics. */
+} ble_nus_stream_t;
+
+
 /**@brief   Nordic UART Service structure.
  *
  * @details This structure contains status information related to the service.
@@ -188,6 +235,7 @@ struct ble_nus_s
     ble_gatts_char_handles_t        rx_handles;         /**< Handles related to the RX characteristic (as provided by the SoftDevice). */
     blcm_link_ctx_storage_t * const p_link_ctx_storage; /**< Pointer to link context storage with handles of all current connections and its context. */
     ble_nus_data_handler_t          data_handler;       /**< Event handler to be called for handling received data. */
+    ble_nus_stream_t              * p_stream;           /**< Streaming TX buffer, NULL if not attached. */
 };
 
 
@@ -235,6 +283,59 @@ uint32_t ble_nus_data_send(ble_nus_t * p_nus,
                            uint16_t    conn_handle);
 
 
+/**@brief   Function for attaching a streaming TX buffer to a connection.
+ *
+ * @details In the streaming mode, data written with @ref ble_nus_stream_write is buffered and
+ *          packed into notifications of the effective ATT MTU size. The buffer is moved to the
+ *          SoftDevice whenever new data is written and whenever the SoftDevice reports that
+ *          notifications were transmitted, so the SoftDevice TX queue is kept full without any
+ *          action from the application. While the queue is full, the data written accumulates
+ *          in the buffer and is sent in full-sized notifications.
+ *
+ *          The stream is detached and its buffer discarded when the connection is terminated.
+ *
+ * @param[in] p_nus       Pointer to the Nordic UART Service structure.
+ * @param[in] p_stream    Streaming TX buffer defined with @ref BLE_NUS_STREAM_DEF.
+ * @param[in] p_gatt      GATT module instance used to get the effective ATT MTU. If NULL, the
+ *                        default ATT MTU is used.
+ * @param[in] conn_handle Connection Handle of the destination client.
+ *
+ * @retval NRF_SUCCESS             If the stream was attached.
+ * @retval NRF_ERROR_NULL          If @p p_nus or @p p_stream is NULL.
+ * @retval NRF_ERROR_INVALID_PARAM If @p conn_handle is invalid.
+ */
+uint32_t ble_nus_stream_attach(ble_nus_t            * p_nus,
+                               ble_nus_stream_t     * p_stream,
+                               nrf_ble_gatt_t const * p_gatt,
+                               uint16_t               conn_handle);
+
+
+/**@brief   Function for writing data to the streaming TX buffer.
+ *
+ * @details This function can be called from different interrupt priorities.
+ *
+ * @param[in]     p_nus    Pointer to the Nordic UART Service structure.
+ * @param[in]     p_data   Data to be sent.
+ * @param[in,out] p_length Length of the data. Amount of bytes accepted.
+ *
+ * @retval NRF_SUCCESS             If all the data was accepted.
+ * @retval NRF_ERROR_NO_MEM        If the buffer was full and only a part of the data was accepted.
+ * @retval NRF_ERROR_NULL          If any of the pointers is NULL.
+ * @retval NRF_ERROR_INVALID_STATE If no stream is attached.
+ */
+uint32_t ble_nus_stream_write(ble_nus_t     * p_nus,
+                              uint8_t const * p_data,
+                              uint16_t      * p_length);
+
+
+/**@brief   Function for getting the streaming TX statistics.
+ *
+ * @param[in]  p_stream Streaming TX buffer.
+ * @param[out] p_stats  Statistics.
+ */
+void ble_nus_stream_stats_get(ble_nus_stream_t const * p_stream, ble_nus_stream_stats_t * p_stats);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,9 @@
 #if NRF_MODULE_ENABLED(NRF_BLE_GQ)
 
 #include "nrf_ble_gq.h"
+#if NRF_BLE_GQ_LATENCY_STATS_ENABLED
+#include "app_timer.h"
+#endif
 
 #define NRF_LOG_MODULE_NAME nrf_ble_gq
 #include "nrf_log.h"
@@ -133,12 +136,13 @@ static ret_code_t gatts_hvx_alloc(nrf_memobj_pool_t const * p_data_pool,
 /**@brief Array of memory allocators for different types of @ref nrf_ble_gq_req_t. */
 static const req_data_alloc_t m_req_data_alloc[NRF_BLE_GQ_REQ_NUM] =
 {
-    [NRF_BLE_GQ_REQ_GATTC_READ]     = NULL,
-    [NRF_BLE_GQ_REQ_GATTC_WRITE]    = gattc_write_alloc,
-    [NRF_BLE_GQ_REQ_SRV_DISCOVERY]  = NULL,
-    [NRF_BLE_GQ_REQ_CHAR_DISCOVERY] = NULL,
-    [NRF_BLE_GQ_REQ_DESC_DISCOVERY] = NULL,
-    [NRF_BLE_GQ_REQ_GATTS_HVX]      = gatts_hvx_alloc
+    [NRF_BLE_GQ_REQ_GATTC_READ]         = NULL,
+    [NRF_BLE_GQ_REQ_GATTC_WRITE]        = gattc_write_alloc,
+    [NRF_BLE_GQ_REQ_SRV_DISCOVERY]      = NULL,
+    [NRF_BLE_GQ_REQ_CHAR_DISCOVERY]     = NULL,
+    [NRF_BLE_GQ_REQ_DESC_DISCOVERY]     = NULL,
+    [NRF_BLE_GQ_REQ_GATTS_HVX]          = gatts_hvx_alloc,
+    [NRF_BLE_GQ_REQ_GATTC_READ_BY_UUID] = NULL,
 };
 
 
@@ -170,15 +174,45 @@ __STATIC_INLINE void request_err_code_handle(nrf_ble_gq_req_t const * const p_re
 }
 
 
-/**@brief Function processes subsequent requests from the BGQ instance queue.
+/**@brief Function for updating the statistics of a connection after a request was taken from
+ *        its queue.
  *
- * @param[in] p_queue      Pointer to the queue instance.
- * @param[in] conn_handle  Connection handle.
+ * @param[in] p_conn_ctx Pointer to the connection context.
+ * @param[in] p_req      Pointer to the request.
+ */
+static void stats_dequeue_update(nrf_ble_gq_conn_ctx_t  * const p_conn_ctx,
+                                 nrf_ble_gq_req_t const * const p_req)
+{
+    nrf_ble_gq_conn_stats_t * p_stats = &p_conn_ctx->stats;
+
+    p_stats->dequeued++;
+    p_stats->depth--;
+
+#if NRF_BLE_GQ_LATENCY_STATS_ENABLED
+    uint32_t latency = app_timer_cnt_diff_compute(app_timer_cnt_get(), p_req->timestamp);
+
+    p_stats->latency_sum += latency;
+    p_stats->latency_max  = MAX(p_stats->latency_max, latency);
+#else
+    UNUSED_PARAMETER(p_req);
+#endif
+}
+
+
+/**@brief Function processes the request at the head of the BGQ instance queue.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ * @param[in] conn_id      ID of the connection whose queue is processed.
+ *
+ * @retval  true   If a request was taken from the queue.
+ * @retval  false  If the queue is empty or Softdevice is busy.
  */
-static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handle)
+static bool queue_process(nrf_ble_gq_t const * const p_gatt_queue, uint16_t conn_id)
 {
-    ret_code_t       err_code;
-    nrf_ble_gq_req_t ble_req;
+    ret_code_t                err_code;
+    nrf_ble_gq_req_t          ble_req;
+    nrf_queue_t const * const p_queue     = &p_gatt_queue->p_req_queue[conn_id];
+    uint16_t                  conn_handle = p_gatt_queue->p_conn_handles[conn_id];
 
     NRF_LOG_DEBUG("Processing the request queue...");
 
@@ -262,6 +296,14 @@ static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handl
                 }
             } break;
 
+            case NRF_BLE_GQ_REQ_GATTC_READ_BY_UUID:
+            {
+                NRF_LOG_DEBUG("GATTC Read Characteristic Value by UUID Request");
+                err_code = sd_ble_gattc_char_value_by_uuid_read(conn_handle,
+                                                                &ble_req.params.gattc_read_by_uuid.uuid,
+                                                                &ble_req.params.gattc_read_by_uuid.handle_range);
+            } break;
+
             default:
                 NRF_LOG_WARNING("Unimplemented GATT Request");
                 break;
@@ -281,13 +323,71 @@ static void queue_process(nrf_queue_t const * const p_queue, uint16_t conn_handl
                 NRF_LOG_DEBUG("Pointer to freed memory block: %p.", ble_req.p_mem_obj);
             }
             UNUSED_RETURN_VALUE(nrf_queue_pop(p_queue, &ble_req));
+            stats_dequeue_update(&p_gatt_queue->p_conn_ctx[conn_id], &ble_req);
 
             request_err_code_handle(&ble_req, conn_handle, err_code);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**@brief Function processes the queues of all registered connections in a weighted round-robin
+ *        manner.
+ *
+ * @details The queue of every connection can submit up to its weight of requests. The connection
+ *          served first is rotated on every call.
+ *
+ * @param[in] p_gatt_queue Pointer to the BGQ instance.
+ */
+static void queues_process(nrf_ble_gq_t const * const p_gatt_queue)
+{
+    uint16_t first_id = *p_gatt_queue->p_rr_id;
+
+    *p_gatt_queue->p_rr_id = (first_id + 1) % p_gatt_queue->max_conns;
+
+    for (uint16_t i = 0; i < p_gatt_queue->max_conns; i++)
+    {
+        uint16_t conn_id = (first_id + i) % p_gatt_queue->max_conns;
+
+        if (p_gatt_queue->p_conn_handles[conn_id] == BLE_CONN_HANDLE_INVALID)
+        {
+            continue;
+        }
+
+        for (uint8_t n = 0; n < p_gatt_queue->p_conn_ctx[conn_id].weight; n++)
+        {
+            if (!queue_process(p_gatt_queue, conn_id))
+            {
+                break;
+            }
         }
     }
 }
 
 
+/**@brief Function checks if the request is a Write Command that can replace the last request
+ *        in the queue.
+ *
+ * @param[in] p_req  Pointer to the new request.
+ * @param[in] p_last Pointer to the last request in the queue.
+ *
+ * @retval    true   The requests can be merged.
+ * @retval    false  The requests cannot be merged.
+ */
+static bool write_cmd_mergeable(nrf_ble_gq_req_t const * const p_req,
+                                nrf_ble_gq_req_t const * const p_last)
+{
+    return (p_req->type  == NRF_BLE_GQ_REQ_GATTC_WRITE)                           &&
+           (p_last->type == NRF_BLE_GQ_REQ_GATTC_WRITE)                           &&
+           (p_req->params.gattc_write.write_op  == BLE_GATT_OP_WRITE_CMD)         &&
+           (p_last->params.gattc_write.write_op == BLE_GATT_OP_WRITE_CMD)         &&
+           (p_req->params.gattc_write.handle == p_last->params.gattc_write.handle) &&
+           (p_req->params.gattc_write.offset == p_last->params.gattc_write.offset);
+}
+
+
 /**@brief Function purges all requests from BGQ instance queues that are
  *        no longer used by any connection.
  *
@@ -390,6 +490,13 @@ static bool request_process(nrf_ble_gq_req_t const * const p_req, uint16_t conn_
 
         } break;
 
+        case NRF_BLE_GQ_REQ_GATTC_READ_BY_UUID:
+            NRF_LOG_DEBUG("GATTC Read Characteristic Value by UUID Request");
+            err_code = sd_ble_gattc_char_value_by_uuid_read(conn_handle,
+                                                            &p_req->params.gattc_read_by_uuid.uuid,
+                                                            &p_req->params.gattc_read_by_uuid.handle_range);
+            break;
+
         default:
             NRF_LOG_WARNING("Unimplemented GATT Request");
             break;
@@ -446,6 +553,9 @@ static ret_code_t conn_handle_register(nrf_ble_gq_t const * const p_gatt_queue,
         if (p_gatt_queue->p_conn_handles[id] == BLE_CONN_HANDLE_INVALID)
         {
             p_gatt_queue->p_conn_handles[id] = conn_handle;
+
+            memset(&p_gatt_queue->p_conn_ctx[id], 0, sizeof(nrf_ble_gq_conn_ctx_t));
+            p_gatt_queue->p_conn_ctx[id].weight = NRF_BLE_GQ_DEFAULT_WEIGHT;
             return NRF_SUCCESS;
         }
     }
@@ -477,8 +587,11 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
                                nrf_ble_gq_req_t   * const p_req,
                                uint16_t                   conn_handle)
 {
-    ret_code_t err_code = NRF_SUCCESS;
-    uint16_t   conn_id;
+    ret_code_t                err_code = NRF_SUCCESS;
+    uint16_t                  conn_id;
+    nrf_ble_gq_conn_stats_t * p_stats;
+    nrf_ble_gq_req_t          last;
+    bool                      merged = false;
 
     NRF_LOG_DEBUG("Adding item to the request queue");
 
@@ -495,12 +608,15 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
         return NRF_ERROR_INVALID_PARAM;
     }
 
+    p_stats = &p_gatt_queue->p_conn_ctx[conn_id].stats;
+
     // Try processing a request without buffering.
     if (nrf_queue_is_empty(&p_gatt_queue->p_req_queue[conn_id]))
     {
         bool req_processed = request_process(p_req, conn_handle);
         if (req_processed)
         {
+            p_stats->direct++;
             return err_code;
         }
     }
@@ -514,15 +630,48 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
         VERIFY_SUCCESS(err_code);
     }
 
-    err_code = nrf_queue_push(&p_gatt_queue->p_req_queue[conn_id], p_req);
-    if ((err_code != NRF_SUCCESS) && (m_req_data_alloc[p_req->type] != NULL))
+    // Last writer wins. The replaced request keeps its position in the queue. Replacing fails if
+    // the peeked request was popped or another request was pushed in the meantime; the request
+    // is then pushed.
+    if ((nrf_queue_peek_back(&p_gatt_queue->p_req_queue[conn_id], &last) == NRF_SUCCESS) &&
+        write_cmd_mergeable(p_req, &last))
+    {
+#if NRF_BLE_GQ_LATENCY_STATS_ENABLED
+        p_req->timestamp = last.timestamp;
+#endif
+        merged = (nrf_queue_compare_replace_back(&p_gatt_queue->p_req_queue[conn_id],
+                                                 &last,
+                                                 p_req) == NRF_SUCCESS);
+    }
+
+    if (merged)
+    {
+        NRF_LOG_DEBUG("Write Command merged into queued request for handle 0x%04X.",
+                      p_req->params.gattc_write.handle);
+        nrf_memobj_free(last.p_mem_obj);
+        p_stats->merged++;
+    }
+    else
     {
-        nrf_memobj_free(p_req->p_mem_obj);
-        NRF_LOG_DEBUG("Pointer to freed memory block: %p.", p_req->p_mem_obj);
+#if NRF_BLE_GQ_LATENCY_STATS_ENABLED
+        p_req->timestamp = app_timer_cnt_get();
+#endif
+        err_code = nrf_queue_push(&p_gatt_queue->p_req_queue[conn_id], p_req);
+        if (err_code == NRF_SUCCESS)
+        {
+            p_stats->queued++;
+            p_stats->depth++;
+            p_stats->depth_max = MAX(p_stats->depth_max, p_stats->depth);
+        }
+        else if (m_req_data_alloc[p_req->type] != NULL)
+        {
+            nrf_memobj_free(p_req->p_mem_obj);
+            NRF_LOG_DEBUG("Pointer to freed memory block: %p.", p_req->p_mem_obj);
+        }
     }
 
     // Check if Softdevice is still busy.
-    queue_process(&p_gatt_queue->p_req_queue[conn_id], conn_handle);
+    UNUSED_RETURN_VALUE(queue_process(p_gatt_queue, conn_id));
     return err_code;
 }
 
@@ -556,6 +705,45 @@ ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, ui
 }
 
 
+ret_code_t nrf_ble_gq_conn_weight_set(nrf_ble_gq_t const * const p_gatt_queue,
+                                      uint16_t                   conn_handle,
+                                      uint8_t                    weight)
+{
+    uint16_t conn_id;
+
+    VERIFY_PARAM_NOT_NULL(p_gatt_queue);
+
+    conn_id = conn_handle_id_find(p_gatt_queue, conn_handle);
+    if ((conn_id == p_gatt_queue->max_conns) || (weight == 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_gatt_queue->p_conn_ctx[conn_id].weight = weight;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_ble_gq_conn_stats_get(nrf_ble_gq_t const * const p_gatt_queue,
+                                     uint16_t                   conn_handle,
+                                     nrf_ble_gq_conn_stats_t  * p_stats)
+{
+    uint16_t conn_id;
+
+    VERIFY_PARAM_NOT_NULL(p_gatt_queue);
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    conn_id = conn_handle_id_find(p_gatt_queue, conn_handle);
+    if (conn_id == p_gatt_queue->max_conns)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    *p_stats = p_gatt_queue->p_conn_ctx[conn_id].stats;
+    return NRF_SUCCESS;
+}
+
+
 void nrf_ble_gq_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
 {
     nrf_ble_gq_t * p_gatt_queue = (nrf_ble_gq_t *) p_context;
@@ -603,7 +791,7 @@ void nrf_ble_gq_on_ble_evt(ble_evt_t const * p_ble_evt, void * p_context)
     }
     else
     {
-        queue_process(&p_gatt_queue->p_req_queue[conn_id], conn_handle);
+        queues_process(p_gatt_queue);
     }
 }
 
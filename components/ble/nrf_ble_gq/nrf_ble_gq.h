@@ -100,13 +100,17 @@ extern "C" {
     NRF_QUEUE_DEF(uint16_t, CONCAT_2(_name, purge_queue), _max_connections,                            \
                   NRF_QUEUE_MODE_NO_OVERFLOW);                                                         \
     NRF_MEMOBJ_POOL_DEF(CONCAT_2(_name, pool), _pool_elem_size, _pool_elem_count);                     \
+    static nrf_ble_gq_conn_ctx_t CONCAT_2(_name, conn_ctx_arr)[_max_connections];                     \
+    static uint16_t CONCAT_2(_name, rr_id);                                                            \
     static nrf_ble_gq_t _name =                                                                        \
     {                                                                                                  \
         .max_conns      = (_max_connections),                                                          \
         .p_conn_handles = CONCAT_2(_name, conn_handles_arr),                                           \
         .p_req_queue    = CONCAT_2(_name, req_queue),                                                  \
         .p_purge_queue  = &CONCAT_2(_name, purge_queue),                                               \
-        .p_data_pool    = &CONCAT_2(_name, pool)                                                       \
+        .p_data_pool    = &CONCAT_2(_name, pool),                                                      \
+        .p_conn_ctx     = CONCAT_2(_name, conn_ctx_arr),                                               \
+        .p_rr_id        = &CONCAT_2(_name, rr_id)                                                      \
     };                                                                                                 \
     NRF_SDH_BLE_OBSERVER(_name ## _obs,                                                                \
                          NRF_BLE_GQ_BLE_OBSERVER_PRIO,                                                 \
@@ -130,6 +134,7 @@ typedef enum
     NRF_BLE_GQ_REQ_CHAR_DISCOVERY, /**< GATTC Characteristic Discovery Request. See @ref nrf_ble_gq_gattc_char_disc_t and @ref sd_ble_gattc_characteristics_discover. */
     NRF_BLE_GQ_REQ_DESC_DISCOVERY, /**< GATTC Characteristic Descriptor Discovery Request. See @ref nrf_ble_gq_gattc_desc_disc_t and @ref sd_ble_gattc_descriptors_discover*/
     NRF_BLE_GQ_REQ_GATTS_HVX,      /**< GATTS Handle Value Notification or Indication. See @ref nrf_ble_gq_gatts_hvx_t and @ref ble_gatts_hvx_params_t */
+    NRF_BLE_GQ_REQ_GATTC_READ_BY_UUID, /**< GATTC Read Characteristic Value by UUID Request. See @ref nrf_ble_gq_gattc_read_by_uuid_t and @ref sd_ble_gattc_char_value_by_uuid_read. */
     NRF_BLE_GQ_REQ_NUM             /**< Total number of different GATT Request types */
 } nrf_ble_gq_req_type_t;
 
@@ -164,6 +169,13 @@ typedef ble_gattc_handle_range_t nrf_ble_gq_gattc_desc_disc_t;
 /**@brief Structure used to describe @ref NRF_BLE_GQ_REQ_GATTS_HVX request type. */
 typedef ble_gatts_hvx_params_t nrf_ble_gq_gatts_hvx_t;
 
+/**@brief Structure used to describe @ref NRF_BLE_GQ_REQ_GATTC_READ_BY_UUID request type. */
+typedef struct
+{
+    ble_uuid_t               uuid;         /**< UUID of the Characteristic Value to be read. */
+    ble_gattc_handle_range_t handle_range; /**< Handle range in which the Characteristic Value is searched. */
+} nrf_ble_gq_gattc_read_by_uuid_t;
+
 /**@brief Structure used to handle SoftDevice error. */
 typedef struct
 {
@@ -186,9 +198,38 @@ typedef struct
         nrf_ble_gq_gattc_char_disc_t     gattc_char_disc; /**< GATTC characteristic discovery parameters. Filled when nrf_ble_gq_req_t::type is @ref NRF_BLE_GQ_REQ_CHAR_DISCOVERY. */
         nrf_ble_gq_gattc_desc_disc_t     gattc_desc_disc; /**< GATTC characteristic descriptor discovery parameters. Filled when nrf_ble_gq_req_t::type is NRF_BLE_GQ_REQ_DESC_DISCOVERY. */
         nrf_ble_gq_gatts_hvx_t           gatts_hvx;       /**< GATTS Handle Value Notification or Indication Parameters. Filled when nrf_ble_gq_req_t::type is @ref NRF_BLE_GQ_REQ_GATTS_HVX. */
+        nrf_ble_gq_gattc_read_by_uuid_t  gattc_read_by_uuid; /**< GATTC Read Characteristic Value by UUID parameters. Filled when nrf_ble_gq_req_t::type is @ref NRF_BLE_GQ_REQ_GATTC_READ_BY_UUID. */
     } params;
+#if NRF_BLE_GQ_LATENCY_STATS_ENABLED
+    uint32_t                         timestamp;     /**< Time at which the request was queued. Set internally. */
+#endif
 } nrf_ble_gq_req_t;
 
+/**@brief Statistics of the requests associated with one connection.
+ *
+ * @details The statistics are reset when the connection handle is registered.
+ */
+typedef struct
+{
+    uint32_t direct;      /**< Requests passed to the SoftDevice without queuing. */
+    uint32_t queued;      /**< Requests added to the queue. */
+    uint32_t dequeued;    /**< Requests passed to the SoftDevice from the queue. */
+    uint32_t merged;      /**< Write Commands that replaced a queued Write Command to the same handle. */
+    uint16_t depth;       /**< Number of requests currently in the queue. */
+    uint16_t depth_max;   /**< Highest number of requests in the queue. */
+#if NRF_BLE_GQ_LATENCY_STATS_ENABLED
+    uint32_t latency_max; /**< Longest time a request spent in the queue, in app_timer ticks. */
+    uint32_t latency_sum; /**< Total time spent in the queue by @p dequeued requests, in app_timer ticks. */
+#endif
+} nrf_ble_gq_conn_stats_t;
+
+/**@brief Scheduling context of one connection. */
+typedef struct
+{
+    uint8_t                 weight; /**< Maximal number of requests submitted from the queue in one scheduling round. */
+    nrf_ble_gq_conn_stats_t stats;  /**< Request statistics. */
+} nrf_ble_gq_conn_ctx_t;
+
 /**@brief Descriptor for the BLE GATT Queue instance. */
 typedef struct
 {
@@ -197,6 +238,8 @@ typedef struct
     nrf_queue_t const * const p_req_queue;    /**< Pointer to array of queue instances used to hold nrf_ble_gq_req_t instances.*/
     nrf_queue_t const * const p_purge_queue;  /**< Pointer to the queue instance used to hold indexes of queues to purge.*/
     nrf_memobj_pool_t const * p_data_pool;    /**< Memory pool used to obtain nrf_memobj_t instances.*/
+    nrf_ble_gq_conn_ctx_t   * p_conn_ctx;     /**< Pointer to array with scheduling contexts of registered connections.*/
+    uint16_t                * p_rr_id;        /**< Pointer to the ID of the connection served first in the next scheduling round.*/
 } nrf_ble_gq_t;
 
 
@@ -207,6 +250,15 @@ typedef struct
  *          this request will be processed immediately. Otherwise, the request remains in
  *          in the queue and is processed later.
  *
+ *          A Write Command (@ref BLE_GATT_OP_WRITE_CMD) replaces the last request in the queue
+ *          if that request is a Write Command to the same handle and offset. Only the latest
+ *          value is sent in that case.
+ *
+ *          Queued requests of all connections are served in rounds. In each round, the queue of
+ *          every connection can submit up to its weight of requests (see
+ *          @ref nrf_ble_gq_conn_weight_set) and the connection served first is rotated, so
+ *          a busy connection does not hold back the others.
+ *
  * @param[in] p_gatt_queue  Pointer to the BGQ instance.
  * @param[in] p_req         Pointer to the request.
  * @param[in] conn_handle   Connection handle associated with the request.
@@ -239,6 +291,40 @@ ret_code_t nrf_ble_gq_item_add(nrf_ble_gq_t const * const p_gatt_queue,
 ret_code_t nrf_ble_gq_conn_handle_register(nrf_ble_gq_t * const p_gatt_queue, uint16_t conn_handle);
 
 
+/**@brief Function for setting the scheduling weight of a connection.
+ *
+ * @details The weight is reset to @ref NRF_BLE_GQ_DEFAULT_WEIGHT when the connection handle is
+ *          registered.
+ *
+ * @param[in] p_gatt_queue  Pointer to the BGQ instance.
+ * @param[in] conn_handle   Connection handle.
+ * @param[in] weight        Maximal number of requests submitted from the queue of the connection
+ *                          in one scheduling round.
+ *
+ * @retval    NRF_SUCCESS             If the weight was set.
+ * @retval    NRF_ERROR_NULL          If \p p_gatt_queue was NULL.
+ * @retval    NRF_ERROR_INVALID_PARAM If \p conn_handle is not registered or \p weight is 0.
+ */
+ret_code_t nrf_ble_gq_conn_weight_set(nrf_ble_gq_t const * const p_gatt_queue,
+                                      uint16_t                   conn_handle,
+                                      uint8_t                    weight);
+
+
+/**@brief Function for getting the request statistics of a connection.
+ *
+ * @param[in]  p_gatt_queue  Pointer to the BGQ instance.
+ * @param[in]  conn_handle   Connection handle.
+ * @param[out] p_stats       Statistics.
+ *
+ * @retval    NRF_SUCCESS             If the statistics were retrieved.
+ * @retval    NRF_ERROR_NULL          Any pointer was NULL.
+ * @retval    NRF_ERROR_INVALID_PARAM If \p conn_handle is not registered.
+ */
+ret_code_t nrf_ble_gq_conn_stats_get(nrf_ble_gq_t const * const p_gatt_queue,
+                                     uint16_t                   conn_handle,
+                                     nrf_ble_gq_conn_stats_t  * p_stats);
+
+
 /**@brief     Function for handling BLE events from the SoftDevice.
  *
  * @details   This function handles the BLE events received from the SoftDevice. If a BLE
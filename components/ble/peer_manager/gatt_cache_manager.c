@@ -51,6 +51,12 @@
 #include "peer_data_storage.h"
 #include "peer_database.h"
 #include "nrf_mtx.h"
+#if PM_LOCAL_DB_COALESCE_ENABLED && PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS
+#include "app_timer.h"
+#define LOCAL_DB_FLUSH_TIMER 1  //!< Whether unstored CCCD changes are stored after a period without CCCD writes.
+#else
+#define LOCAL_DB_FLUSH_TIMER 0
+#endif
 
 #define NRF_LOG_MODULE_NAME peer_manager_gcm
 #if PM_LOG_ENABLED
@@ -87,6 +93,8 @@ static ble_conn_state_user_flag_id_t  m_flag_service_changed_sent;    /**< Flag
 static ble_conn_state_user_flag_id_t  m_flag_car_update_pending;      /**< Flag ID for flag collection to keep track of which connections need to have their Central Address Resolution value stored. */
 static ble_conn_state_user_flag_id_t  m_flag_car_handle_queried;      /**< Flag ID for flag collection to keep track of which connections are pending Central Address Resolution handle reply. */
 static ble_conn_state_user_flag_id_t  m_flag_car_value_queried;       /**< Flag ID for flag collection to keep track of which connections are pending Central Address Resolution value reply. */
+static ble_conn_state_user_flag_id_t  m_flag_local_db_dirty;          /**< Flag ID for flag collection to keep track of which connections have CCCD changes that have not yet been marked for a local DB update procedure. */
+static pm_local_db_cache_stats_t      m_local_db_stats;               /**< Counters of local DB storage. */
 
 #ifdef PM_SERVICE_CHANGED_ENABLED
     STATIC_ASSERT(PM_SERVICE_CHANGED_ENABLED || !NRF_SDH_BLE_SERVICE_CHANGED,
@@ -95,6 +103,10 @@ static ble_conn_state_user_flag_id_t  m_flag_car_value_queried;       /**< Flag
     #define PM_SERVICE_CHANGED_ENABLED 1
 #endif
 
+#if LOCAL_DB_FLUSH_TIMER
+APP_TIMER_DEF(m_local_db_flush_timer); /**< Timer restarted by every CCCD write, stores unstored CCCD changes when it expires. */
+#endif
+
 /**@brief Function for resetting the module variable(s) of the GSCM module.
  *
  * @param[out]  The instance to reset.
@@ -102,6 +114,7 @@ static ble_conn_state_user_flag_id_t  m_flag_car_value_queried;       /**< Flag
 static void internal_state_reset()
 {
     m_module_initialized = false;
+    memset(&m_local_db_stats, 0, sizeof(m_local_db_stats));
 }
 
 
@@ -248,6 +261,7 @@ static bool local_db_update_in_evt(uint16_t conn_handle)
     {
         case NRF_SUCCESS:
             success = true;
+            m_local_db_stats.stores++;
             break;
 
         case BLE_ERROR_INVALID_CONN_HANDLE:
@@ -503,6 +517,57 @@ static void car_update_needed(uint16_t conn_handle)
 }
 
 
+static void db_dirty_handle(uint16_t conn_handle, void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+    ble_conn_state_user_flag_set(conn_handle, m_flag_local_db_dirty, false);
+    local_db_update(conn_handle, true);
+}
+
+
+/**@brief Function for handling a CCCD write.
+ *
+ * @details If a local DB update is already pending for the connection, the write will be covered
+ *          by it. With @ref PM_LOCAL_DB_COALESCE_ENABLED, the connection is only marked as dirty,
+ *          and the update is done on disconnection, on @ref gcm_local_db_cache_flush, or once
+ *          @ref PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS have passed without CCCD writes.
+ *
+ * @param[in]  conn_handle  The connection the CCCD was written on.
+ */
+static void cccd_write_handle(uint16_t conn_handle)
+{
+    m_local_db_stats.cccd_writes++;
+
+    if (   ble_conn_state_user_flag_get(conn_handle, m_flag_local_db_update_pending)
+        || ble_conn_state_user_flag_get(conn_handle, m_flag_local_db_dirty))
+    {
+        m_local_db_stats.stores_saved++;
+    }
+
+#if PM_LOCAL_DB_COALESCE_ENABLED
+    ble_conn_state_user_flag_set(conn_handle, m_flag_local_db_dirty, true);
+#if LOCAL_DB_FLUSH_TIMER
+    // Restart the quiet period. If the timer cannot be started, store at once.
+    ret_code_t err_code = app_timer_stop(m_local_db_flush_timer);
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = app_timer_start(m_local_db_flush_timer,
+                                   APP_TIMER_TICKS(PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS),
+                                   NULL);
+    }
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_WARNING("Could not start the flush timer: %s. Storing CCCD changes now.",
+                        nrf_strerror_get(err_code));
+        db_dirty_handle(conn_handle, NULL);
+    }
+#endif
+#else
+    local_db_update(conn_handle, true);
+#endif
+}
+
+
 static __INLINE void update_pending_flags_check(void)
 {
     uint32_t count = ble_conn_state_for_each_set_user_flag(m_flag_local_db_update_pending,
@@ -610,6 +675,19 @@ void gcm_pdb_evt_handler(pm_evt_t * p_event)
 }
 
 
+#if LOCAL_DB_FLUSH_TIMER
+/**@brief Function for storing unstored CCCD changes once CCCD writes have stopped.
+ *
+ * @param[in]  p_context  Unused.
+ */
+static void local_db_flush_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+    gcm_local_db_cache_flush();
+}
+#endif
+
+
 ret_code_t gcm_init()
 {
     NRF_PM_DEBUG_CHECK(!m_module_initialized);
@@ -623,6 +701,7 @@ ret_code_t gcm_init()
     m_flag_car_update_pending      = ble_conn_state_user_flag_acquire();
     m_flag_car_handle_queried      = ble_conn_state_user_flag_acquire();
     m_flag_car_value_queried       = ble_conn_state_user_flag_acquire();
+    m_flag_local_db_dirty          = ble_conn_state_user_flag_acquire();
 
     if  ((m_flag_local_db_update_pending  == BLE_CONN_STATE_USER_FLAG_INVALID)
       || (m_flag_local_db_apply_pending   == BLE_CONN_STATE_USER_FLAG_INVALID)
@@ -631,6 +710,7 @@ ret_code_t gcm_init()
       || (m_flag_car_update_pending       == BLE_CONN_STATE_USER_FLAG_INVALID)
       || (m_flag_car_handle_queried       == BLE_CONN_STATE_USER_FLAG_INVALID)
       || (m_flag_car_value_queried        == BLE_CONN_STATE_USER_FLAG_INVALID)
+      || (m_flag_local_db_dirty           == BLE_CONN_STATE_USER_FLAG_INVALID)
       )
     {
         NRF_LOG_ERROR("Could not acquire conn_state user flags. Increase "\
@@ -638,6 +718,17 @@ ret_code_t gcm_init()
         return NRF_ERROR_INTERNAL;
     }
 
+#if LOCAL_DB_FLUSH_TIMER
+    ret_code_t err_code = app_timer_create(&m_local_db_flush_timer,
+                                           APP_TIMER_MODE_SINGLE_SHOT,
+                                           local_db_flush_timeout_handler);
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_ERROR("app_timer_create() returned %s.", nrf_strerror_get(err_code));
+        return NRF_ERROR_INTERNAL;
+    }
+#endif
+
     nrf_mtx_init(&m_db_update_in_progress_mutex);
 
     m_module_initialized = true;
@@ -704,7 +795,17 @@ void gcm_ble_evt_handler(ble_evt_t const * p_ble_evt)
         case BLE_GATTS_EVT_WRITE:
             if (cccd_written(&p_ble_evt->evt.gatts_evt.params.write))
             {
-                local_db_update(conn_handle, true);
+                cccd_write_handle(conn_handle);
+                update_pending_flags_check();
+            }
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            // The system attributes can still be retrieved until the next connection.
+            conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            if (ble_conn_state_user_flag_get(conn_handle, m_flag_local_db_dirty))
+            {
+                db_dirty_handle(conn_handle, NULL);
                 update_pending_flags_check();
             }
             break;
@@ -819,6 +920,28 @@ ret_code_t gcm_local_db_cache_update(uint16_t conn_handle)
 }
 
 
+void gcm_local_db_cache_flush(void)
+{
+    NRF_PM_DEBUG_CHECK(m_module_initialized);
+
+    uint32_t count = ble_conn_state_for_each_set_user_flag(m_flag_local_db_dirty,
+                                                           db_dirty_handle,
+                                                           NULL);
+    if (count != 0)
+    {
+        update_pending_flags_check();
+    }
+}
+
+
+void gcm_local_db_cache_stats_get(pm_local_db_cache_stats_t * p_stats)
+{
+    NRF_PM_DEBUG_CHECK(m_module_initialized);
+
+    *p_stats = m_local_db_stats;
+}
+
+
 #if PM_SERVICE_CHANGED_ENABLED
 void gcm_local_database_has_changed(void)
 {
@@ -101,6 +101,21 @@ ret_code_t gcm_local_db_cache_update(uint16_t conn_handle);
  */
 void gcm_local_database_has_changed(void);
 
+
+/**@brief Function for storing the system attributes of all connections which have unstored
+ *        CCCD changes.
+ *
+ * @details Only relevant when @ref PM_LOCAL_DB_COALESCE_ENABLED is set.
+ */
+void gcm_local_db_cache_flush(void);
+
+
+/**@brief Function for getting the counters of system attribute storage.
+ *
+ * @param[out] p_stats  Counters.
+ */
+void gcm_local_db_cache_stats_get(pm_local_db_cache_stats_t * p_stats);
+
 /** @}
   * @endcond
  */
@@ -48,6 +48,7 @@
 #include "peer_manager_internal.h"
 #include "peer_id.h"
 #include "fds.h"
+#include "app_util_platform.h"
 
 #define NRF_LOG_MODULE_NAME peer_manager_pds
 #if PM_LOG_ENABLED
@@ -89,6 +90,22 @@ static volatile bool m_peer_delete_deferred = false;
 // A token used for Flash Data Storage searches.
 static fds_find_token_t m_fds_ftok;
 
+#if PM_PEER_DATA_CACHE_SIZE
+// An entry in the cache of peer data records. Remembers where a record was found in flash, or
+// that it was not found, so that repeated reads do not have to search the flash.
+typedef struct
+{
+    pm_peer_id_t      peer_id;  // PM_PEER_ID_INVALID if the entry is unused.
+    pm_peer_data_id_t data_id;
+    bool              found;    // Whether the record exists. If false, rec_desc is unused.
+    fds_record_desc_t rec_desc;
+} pds_cache_entry_t;
+
+static pds_cache_entry_t m_cache[PM_PEER_DATA_CACHE_SIZE];
+static uint32_t          m_cache_victim;        // Next entry to replace when all entries are used.
+static volatile uint32_t m_cache_generation;    // Incremented whenever peer data in flash changes.
+#endif
+
 
 // Function for dispatching events to all registered event handlers.
 static void pds_evt_send(pm_evt_t * p_event)
@@ -251,6 +268,163 @@ static ret_code_t peer_data_find(pm_peer_id_t              peer_id,
 }
 
 
+#if PM_PEER_DATA_CACHE_SIZE
+static void cache_reset(void)
+{
+    for (uint32_t i = 0; i < PM_PEER_DATA_CACHE_SIZE; i++)
+    {
+        m_cache[i].peer_id = PM_PEER_ID_INVALID;
+    }
+
+    m_cache_victim = 0;
+}
+
+
+static pds_cache_entry_t * cache_find(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
+{
+    for (uint32_t i = 0; i < PM_PEER_DATA_CACHE_SIZE; i++)
+    {
+        if ((m_cache[i].peer_id == peer_id) && (m_cache[i].data_id == data_id))
+        {
+            return &m_cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+
+// Function for removing cache entries after a change in flash.
+// If data_id is PM_PEER_DATA_ID_INVALID, all entries of the peer are removed.
+static void cache_invalidate(pm_peer_id_t peer_id, pm_peer_data_id_t data_id)
+{
+    m_cache_generation++;
+
+    for (uint32_t i = 0; i < PM_PEER_DATA_CACHE_SIZE; i++)
+    {
+        if (   (m_cache[i].peer_id == peer_id)
+            && ((data_id == PM_PEER_DATA_ID_INVALID) || (m_cache[i].data_id == data_id)))
+        {
+            m_cache[i].peer_id = PM_PEER_ID_INVALID;
+        }
+    }
+}
+
+
+// Function for adding the result of a flash search to the cache.
+// p_desc is NULL if the record was not found. The result is discarded if the flash has changed
+// since the search was started, i.e. if generation is no longer current. The check and the insert
+// are done in a critical region so that an FDS event cannot invalidate the cache in between.
+static void cache_insert(pm_peer_id_t                    peer_id,
+                         pm_peer_data_id_t               data_id,
+                         fds_record_desc_t const * const p_desc,
+                         uint32_t                        generation)
+{
+    pds_cache_entry_t * p_entry = NULL;
+
+    CRITICAL_REGION_ENTER();
+
+    if (generation != m_cache_generation)
+    {
+        CRITICAL_REGION_EXIT();
+        return;
+    }
+
+    for (uint32_t i = 0; (p_entry == NULL) && (i < PM_PEER_DATA_CACHE_SIZE); i++)
+    {
+        if (m_cache[i].peer_id == PM_PEER_ID_INVALID)
+        {
+            p_entry = &m_cache[i];
+        }
+    }
+
+    if (p_entry == NULL)
+    {
+        p_entry        = &m_cache[m_cache_victim];
+        m_cache_victim = (m_cache_victim + 1) % PM_PEER_DATA_CACHE_SIZE;
+    }
+
+    p_entry->peer_id = peer_id;
+    p_entry->data_id = data_id;
+    p_entry->found   = (p_desc != NULL);
+
+    if (p_desc != NULL)
+    {
+        p_entry->rec_desc                = *p_desc;
+        p_entry->rec_desc.record_is_open = false;
+    }
+
+    CRITICAL_REGION_EXIT();
+}
+#endif // PM_PEER_DATA_CACHE_SIZE
+
+
+// Function for finding and opening a peer data record. The cache is consulted first, and updated
+// with the result of the search if the record was not in it.
+static ret_code_t peer_data_open(pm_peer_id_t               peer_id,
+                                 pm_peer_data_id_t          data_id,
+                                 fds_record_desc_t  * const p_desc,
+                                 fds_flash_record_t * const p_rec)
+{
+    ret_code_t ret;
+
+#if PM_PEER_DATA_CACHE_SIZE
+    pds_cache_entry_t * p_entry = cache_find(peer_id, data_id);
+
+    if (p_entry != NULL)
+    {
+        if (!p_entry->found)
+        {
+            return NRF_ERROR_NOT_FOUND;
+        }
+
+        *p_desc = p_entry->rec_desc;
+
+        if (fds_record_open(p_desc, p_rec) == NRF_SUCCESS)
+        {
+            // A record which has been deleted is still found at its old location until garbage
+            // collection, but its header no longer matches.
+            if (   (p_rec->p_header->file_id    == peer_id_to_file_id(peer_id))
+                && (p_rec->p_header->record_key == peer_data_id_to_record_key(data_id)))
+            {
+                // Keep the location in case FDS had to find the record again after garbage collection.
+                p_entry->rec_desc                = *p_desc;
+                p_entry->rec_desc.record_is_open = false;
+                return NRF_SUCCESS;
+            }
+
+            (void)fds_record_close(p_desc);
+        }
+
+        p_entry->peer_id = PM_PEER_ID_INVALID;
+    }
+
+    uint32_t const generation = m_cache_generation;
+#endif
+
+    ret = peer_data_find(peer_id, data_id, p_desc);
+
+#if PM_PEER_DATA_CACHE_SIZE
+    cache_insert(peer_id, data_id, (ret == NRF_SUCCESS) ? p_desc : NULL, generation);
+#endif
+
+    if (ret != NRF_SUCCESS)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    // Shouldn't fail, unless the record was deleted in the meanwhile or the CRC check has failed.
+    ret = fds_record_open(p_desc, p_rec);
+
+    if (ret != NRF_SUCCESS)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 static void peer_ids_load()
 {
     fds_record_desc_t  record_desc;
@@ -298,6 +472,10 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
                                                                         : PM_PEER_DATA_OP_UPDATE;
                 pds_evt.params.peer_data_update_succeeded.token = p_fds_evt->write.record_id;
 
+#if PM_PEER_DATA_CACHE_SIZE
+                cache_invalidate(pds_evt.peer_id, pds_evt.params.peer_data_update_succeeded.data_id);
+#endif
+
                 if (p_fds_evt->result == NRF_SUCCESS)
                 {
                     pds_evt.evt_id = PM_EVT_PEER_DATA_UPDATE_SUCCEEDED;
@@ -317,6 +495,10 @@ static void fds_evt_handler(fds_evt_t const * const p_fds_evt)
             if (    file_id_within_pm_range(p_fds_evt->del.file_id)
                 && (p_fds_evt->del.record_key == FDS_RECORD_KEY_DIRTY))
             {
+#if PM_PEER_DATA_CACHE_SIZE
+                cache_invalidate(pds_evt.peer_id, PM_PEER_DATA_ID_INVALID);
+#endif
+
                 if (p_fds_evt->result == NRF_SUCCESS)
                 {
                     pds_evt.evt_id = PM_EVT_PEER_DELETE_SUCCEEDED;
@@ -384,6 +566,10 @@ ret_code_t pds_init()
     peer_id_init();
     peer_ids_load();
 
+#if PM_PEER_DATA_CACHE_SIZE
+    cache_reset();
+#endif
+
     m_module_initialized = true;
 
     return NRF_SUCCESS;
@@ -405,15 +591,7 @@ ret_code_t pds_peer_data_read(pm_peer_id_t                    peer_id,
     VERIFY_PEER_ID_IN_RANGE(peer_id);
     VERIFY_PEER_DATA_ID_IN_RANGE(data_id);
 
-    ret = peer_data_find(peer_id, data_id, &rec_desc);
-
-    if (ret != NRF_SUCCESS)
-    {
-        return NRF_ERROR_NOT_FOUND;
-    }
-
-    // Shouldn't fail, unless the record was deleted in the meanwhile or the CRC check has failed.
-    ret = fds_record_open(&rec_desc, &rec_flash);
+    ret = peer_data_open(peer_id, data_id, &rec_desc, &rec_flash);
 
     if (ret != NRF_SUCCESS)
     {
@@ -459,6 +459,27 @@ void pm_local_database_has_changed(void)
 }
 
 
+ret_code_t pm_local_db_cache_flush(void)
+{
+    VERIFY_MODULE_INITIALIZED();
+
+    gcm_local_db_cache_flush();
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t pm_local_db_cache_stats_get(pm_local_db_cache_stats_t * p_stats)
+{
+    VERIFY_MODULE_INITIALIZED();
+    VERIFY_PARAM_NOT_NULL(p_stats);
+
+    gcm_local_db_cache_stats_get(p_stats);
+
+    return NRF_SUCCESS;
+}
+
+
 ret_code_t pm_id_addr_set(ble_gap_addr_t const * p_addr)
 {
     VERIFY_MODULE_INITIALIZED();
@@ -220,6 +220,37 @@ ret_code_t pm_conn_sec_params_reply(uint16_t               conn_handle,
 void pm_local_database_has_changed(void);
 
 
+/**@brief Function for storing system attributes which have changed since they were last stored.
+ *
+ * @details When @ref PM_LOCAL_DB_COALESCE_ENABLED is set, CCCD writes by bonded peers only mark
+ *          the connection as needing a store of the system attributes. The store happens when
+ *          the peer disconnects, when this function is called, or, if
+ *          @ref PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS is not 0, once that long has passed without
+ *          CCCD writes. In the last case, the store is started in the app_timer context. Call this
+ *          function for example before entering System OFF. Without the configuration option,
+ *          the system attributes are stored on each CCCD write, and this function does nothing.
+ *
+ * @note Changes which are not yet stored are lost on reset.
+ *
+ * @retval NRF_SUCCESS              If the stores were started, or if nothing needed to be stored.
+ *                                  A @ref PM_EVT_PEER_DATA_UPDATE_SUCCEEDED event is sent for
+ *                                  each store that completes.
+ * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
+ */
+ret_code_t pm_local_db_cache_flush(void);
+
+
+/**@brief Function for getting the counters of system attribute storage.
+ *
+ * @param[out] p_stats  Counters since the Peer Manager was initialized.
+ *
+ * @retval NRF_SUCCESS              If the counters were retrieved.
+ * @retval NRF_ERROR_NULL           If @p p_stats was NULL.
+ * @retval NRF_ERROR_INVALID_STATE  If the Peer Manager is not initialized.
+ */
+ret_code_t pm_local_db_cache_stats_get(pm_local_db_cache_stats_t * p_stats);
+
+
 /**@brief Function for getting the security status of a connection.
  *
  * @param[in]  conn_handle        Connection handle of the link as provided by the SoftDevice.
@@ -349,6 +349,18 @@ typedef struct
  */
 typedef void (*pm_evt_handler_t)(pm_evt_t const * p_event);
 
+
+/**@brief Counters of local GATT database (system attribute) storage.
+ *
+ * @sa pm_local_db_cache_stats_get
+ */
+typedef struct
+{
+    uint32_t cccd_writes;  /**< @brief Number of CCCD writes by bonded peers. */
+    uint32_t stores;       /**< @brief Number of times the system attributes were stored to flash. */
+    uint32_t stores_saved; /**< @brief Number of CCCD writes which did not need a store of their own, because a store was already pending for the connection. */
+} pm_local_db_cache_stats_t;
+
 #ifdef __cplusplus
 }
 #endif
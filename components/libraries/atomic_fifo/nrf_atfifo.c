@@ -187,3 +187,20 @@ bool nrf_atfifo_item_free(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_get_t * p
     NRF_LOG_INST_DEBUG(p_fifo->p_log, "Free (interrupted)");
     return false;
 }
+
+
+void * nrf_atfifo_item_peek(nrf_atfifo_t * const p_fifo)
+{
+    nrf_atfifo_postag_t head;
+    nrf_atfifo_postag_t tail;
+
+    /* Both tags are read as a whole to get consistent positions. */
+    head.tag = ((nrf_atfifo_postag_t volatile *)&p_fifo->head)->tag;
+    tail.tag = ((nrf_atfifo_postag_t volatile *)&p_fifo->tail)->tag;
+
+    if (head.pos.rd == tail.pos.rd)
+    {
+        return NULL;
+    }
+    return ((uint8_t*)(p_fifo->p_buf)) + head.pos.rd;
+}
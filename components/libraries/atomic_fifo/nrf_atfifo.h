@@ -414,6 +414,22 @@ void * nrf_atfifo_item_get(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_get_t *
  */
 bool nrf_atfifo_item_free(nrf_atfifo_t * const p_fifo, nrf_atfifo_item_get_t * p_context);
 
+/**
+ * @brief Function for looking at the next item to read without opening a reading operation.
+ *
+ * Returns the item that the next call to @ref nrf_atfifo_item_get would return.
+ * The item stays in the FIFO and the read position is not moved.
+ *
+ * @note
+ * The result is valid only if no other context reads from the FIFO between this call
+ * and the following @ref nrf_atfifo_item_get. Writers may run concurrently.
+ *
+ * @param[in] p_fifo FIFO object.
+ *
+ * @return Pointer to the next item or NULL if there is no more data in the FIFO.
+ */
+void * nrf_atfifo_item_peek(nrf_atfifo_t * const p_fifo);
+
 
 /** @} */
 
@@ -159,7 +159,131 @@ static bool nrf_atfifo_space_clear(nrf_atfifo_t * const p_fifo);
  * Implementation starts here
  */
 
-#if defined ( __CC_ARM )
+#if defined(NRF_ATOMIC_USE_BUILD_IN) && NRF_ATOMIC_USE_BUILD_IN
+
+/* Same algorithms as the exclusive access versions below, with the load and the conditional
+ * store of a tag replaced by a compare and exchange of the whole tag. */
+
+static inline uint16_t nrf_atfifo_pos_next(nrf_atfifo_t const * const p_fifo, uint16_t pos)
+{
+    uint32_t next = (uint32_t)pos + p_fifo->item_size;
+    if (next >= p_fifo->buf_size)
+    {
+        next -= p_fifo->buf_size;
+    }
+    return (uint16_t)next;
+}
+
+static inline bool nrf_atfifo_tag_swap(nrf_atfifo_postag_t * p_tag,
+                                       nrf_atfifo_postag_t * p_old,
+                                       nrf_atfifo_postag_t   new_tag)
+{
+    return __atomic_compare_exchange_n(&p_tag->tag, &p_old->tag, new_tag.tag,
+                                       false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+bool nrf_atfifo_wspace_req(nrf_atfifo_t * const p_fifo, nrf_atfifo_postag_t * const p_old_tail)
+{
+    nrf_atfifo_postag_t old_tail;
+    nrf_atfifo_postag_t new_tail;
+
+    old_tail.tag = __atomic_load_n(&p_fifo->tail.tag, __ATOMIC_SEQ_CST);
+    do
+    {
+        new_tail.pos.wr = nrf_atfifo_pos_next(p_fifo, old_tail.pos.wr);
+        new_tail.pos.rd = old_tail.pos.rd;
+        if (new_tail.pos.wr == __atomic_load_n(&p_fifo->head.pos.wr, __ATOMIC_SEQ_CST))
+        {
+            p_old_tail->tag = old_tail.tag;
+            return false;
+        }
+    } while (!nrf_atfifo_tag_swap(&p_fifo->tail, &old_tail, new_tail));
+
+    p_old_tail->tag = old_tail.tag;
+    return true;
+}
+
+
+void nrf_atfifo_wspace_close(nrf_atfifo_t * const p_fifo)
+{
+    nrf_atfifo_postag_t old_tail;
+    nrf_atfifo_postag_t new_tail;
+
+    old_tail.tag = __atomic_load_n(&p_fifo->tail.tag, __ATOMIC_SEQ_CST);
+    do
+    {
+        new_tail.pos.wr = old_tail.pos.wr;
+        new_tail.pos.rd = old_tail.pos.wr;
+    } while (!nrf_atfifo_tag_swap(&p_fifo->tail, &old_tail, new_tail));
+}
+
+
+bool nrf_atfifo_rspace_req(nrf_atfifo_t * const p_fifo, nrf_atfifo_postag_t * const p_old_head)
+{
+    nrf_atfifo_postag_t old_head;
+    nrf_atfifo_postag_t new_head;
+
+    old_head.tag = __atomic_load_n(&p_fifo->head.tag, __ATOMIC_SEQ_CST);
+    do
+    {
+        if (old_head.pos.rd == __atomic_load_n(&p_fifo->tail.pos.rd, __ATOMIC_SEQ_CST))
+        {
+            p_old_head->tag = old_head.tag;
+            return false;
+        }
+        new_head.pos.wr = old_head.pos.wr;
+        new_head.pos.rd = nrf_atfifo_pos_next(p_fifo, old_head.pos.rd);
+    } while (!nrf_atfifo_tag_swap(&p_fifo->head, &old_head, new_head));
+
+    p_old_head->tag = old_head.tag;
+    return true;
+}
+
+
+void nrf_atfifo_rspace_close(nrf_atfifo_t * const p_fifo)
+{
+    nrf_atfifo_postag_t old_head;
+    nrf_atfifo_postag_t new_head;
+
+    old_head.tag = __atomic_load_n(&p_fifo->head.tag, __ATOMIC_SEQ_CST);
+    do
+    {
+        new_head.pos.wr = old_head.pos.rd;
+        new_head.pos.rd = old_head.pos.rd;
+    } while (!nrf_atfifo_tag_swap(&p_fifo->head, &old_head, new_head));
+}
+
+
+bool nrf_atfifo_space_clear(nrf_atfifo_t * const p_fifo)
+{
+    bool                ret;
+    nrf_atfifo_postag_t old_head;
+    nrf_atfifo_postag_t new_head;
+
+    old_head.tag = __atomic_load_n(&p_fifo->head.tag, __ATOMIC_SEQ_CST);
+    do
+    {
+        nrf_atfifo_postag_t tail;
+        tail.tag = __atomic_load_n(&p_fifo->tail.tag, __ATOMIC_SEQ_CST);
+
+        new_head.pos.rd = tail.pos.rd;
+        if (old_head.pos.wr != old_head.pos.rd)
+        {
+            /* A read is in progress: release up to it only. */
+            new_head.pos.wr = old_head.pos.wr;
+            ret = false;
+        }
+        else
+        {
+            new_head.pos.wr = tail.pos.rd;
+            ret = (tail.pos.wr == tail.pos.rd);
+        }
+    } while (!nrf_atfifo_tag_swap(&p_fifo->head, &old_head, new_head));
+
+    return ret;
+}
+
+#elif defined ( __CC_ARM )
 
 
 __ASM bool nrf_atfifo_wspace_req(nrf_atfifo_t * const p_fifo, nrf_atfifo_postag_t * const p_old_tail)
@@ -83,11 +83,11 @@ static dfu_init_command_t const * mp_init = NULL;
 
 __ALIGN(4) extern const uint8_t pk[64];
 
-/** @brief Value length structure holding the public key.
+/** @brief Structure holding the public key prepared for signature verification.
  *
  * @details The pk value pointed to is the public key present in dfu_public_key.c
  */
-static nrf_crypto_ecc_public_key_t                  m_public_key;
+static nrf_crypto_ecdsa_prepared_key_t              m_public_key;
 
 /** @brief Structure to hold a signature
  */
@@ -222,10 +222,11 @@ static void crypto_init(void)
     // Convert public key to big-endian format for use in nrf_crypto.
     nrf_crypto_internal_double_swap_endian(pk_copy, pk, sizeof(pk) / 2);
 
-    err_code = nrf_crypto_ecc_public_key_from_raw(&g_nrf_crypto_ecc_secp256r1_curve_info,
-                                                  &m_public_key,
+    err_code = nrf_crypto_ecdsa_prepared_key_init(&m_public_key,
+                                                  &g_nrf_crypto_ecc_secp256r1_curve_info,
                                                   pk_copy,
-                                                  sizeof(pk));
+                                                  sizeof(pk),
+                                                  (nrf_crypto_ecdsa_precompute_t)NRF_DFU_VALIDATION_ECDSA_PRECOMPUTE);
     ASSERT(err_code == NRF_SUCCESS);
     UNUSED_PARAMETER(err_code);
 
@@ -384,12 +385,12 @@ static nrf_dfu_result_t nrf_dfu_validation_signature_check(dfu_signature_type_t
     // The signature is in little-endian format. Change it to big-endian format for nrf_crypto use.
     nrf_crypto_internal_double_swap_endian_in_place(m_signature, sizeof(m_signature) / 2);
 
-    err_code = nrf_crypto_ecdsa_verify(&verify_context,
-                                       &m_public_key,
-                                       m_sig_hash,
-                                       hash_len,
-                                       m_signature,
-                                       sizeof(m_signature));
+    err_code = nrf_crypto_ecdsa_prepared_verify(&verify_context,
+                                                &m_public_key,
+                                                m_sig_hash,
+                                                hash_len,
+                                                m_signature,
+                                                sizeof(m_signature));
     if (err_code != NRF_SUCCESS)
     {
         NRF_LOG_ERROR("Signature failed (err_code: 0x%x)", err_code);
@@ -50,11 +50,7 @@
 /**@internal @brief Type declaration of a template matching all possible context sizes
  *                  for this backend.
  */
-typedef struct
-{
-    nrf_crypto_aead_internal_context_t header;   /**< Common header for context. */
-    cf_aes_context                     context;
-} nrf_crypto_backend_cifra_aes_aead_context_t;
+typedef nrf_crypto_backend_aes_eax_context_t nrf_crypto_backend_cifra_aes_aead_context_t;
 
 
 static ret_code_t result_get(int error)
@@ -169,6 +165,168 @@ static ret_code_t backend_cifra_crypt(void * const           p_context,
     return ret_val;
 }
 
+/**@internal @brief Function for computing OMAC_K^t(input) as defined for EAX.
+ *
+ * @details Equivalent of the function used internally by cf_eax_encrypt().
+ */
+static void omac_compute(nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx,
+                         uint8_t                                       t,
+                         uint8_t const                               * p_input,
+                         size_t                                        input_size,
+                         uint8_t                                       out[CF_MAXBLOCK])
+{
+    uint8_t first_block[NRF_CRYPTO_AES_BLOCK_SIZE] = {0};
+
+    first_block[NRF_CRYPTO_AES_BLOCK_SIZE - 1] = t;
+
+    cf_cmac_stream_reset(&p_ctx->cmac);
+    cf_cmac_stream_update(&p_ctx->cmac, first_block, sizeof(first_block), (input_size == 0));
+    if (input_size != 0)
+    {
+        cf_cmac_stream_update(&p_ctx->cmac, p_input, input_size, 1);
+    }
+    cf_cmac_stream_final(&p_ctx->cmac, out);
+}
+
+/**@internal @brief Function for adding ciphertext to the OMAC of a streamed operation.
+ *
+ * @details Cifra needs the last bytes of the message in the call that finalizes the OMAC, so
+ *          up to one block is always held back in @c pending.
+ */
+static void omac_update(nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx,
+                        uint8_t const                               * p_data,
+                        size_t                                        size)
+{
+    size_t flush_size;
+
+    if (size >= sizeof(p_ctx->pending))
+    {
+        cf_cmac_stream_update(&p_ctx->cmac, p_ctx->pending, p_ctx->pending_size, 0);
+        cf_cmac_stream_update(&p_ctx->cmac, p_data, size - sizeof(p_ctx->pending), 0);
+        memcpy(p_ctx->pending, &p_data[size - sizeof(p_ctx->pending)], sizeof(p_ctx->pending));
+        p_ctx->pending_size = sizeof(p_ctx->pending);
+        return;
+    }
+
+    if (p_ctx->pending_size + size > sizeof(p_ctx->pending))
+    {
+        flush_size = p_ctx->pending_size + size - sizeof(p_ctx->pending);
+        cf_cmac_stream_update(&p_ctx->cmac, p_ctx->pending, flush_size, 0);
+        memmove(p_ctx->pending, &p_ctx->pending[flush_size], p_ctx->pending_size - flush_size);
+        p_ctx->pending_size -= flush_size;
+    }
+
+    memcpy(&p_ctx->pending[p_ctx->pending_size], p_data, size);
+    p_ctx->pending_size += size;
+}
+
+static ret_code_t backend_cifra_start(void * const           p_context,
+                                      nrf_crypto_operation_t operation,
+                                      uint8_t *              p_nonce,
+                                      uint8_t                nonce_size,
+                                      uint8_t *              p_adata,
+                                      size_t                 adata_size,
+                                      size_t                 data_size,
+                                      uint8_t                mac_size)
+{
+    uint8_t nonce_mac[CF_MAXBLOCK];
+    uint8_t header_mac[CF_MAXBLOCK];
+
+    nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
+
+    UNUSED_PARAMETER(data_size);
+
+    /* EAX mode allows following mac size: [1 ... 16] */
+    if ((mac_size < 1) || (mac_size > NRF_CRYPTO_AES_BLOCK_SIZE))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
+    }
+
+    if ((operation != NRF_CRYPTO_ENCRYPT) && (operation != NRF_CRYPTO_DECRYPT))
+    {
+        return NRF_ERROR_CRYPTO_INVALID_PARAM;
+    }
+
+    cf_cmac_stream_init(&p_ctx->cmac, &cf_aes, &p_ctx->context);
+
+    /* N = OMAC_K^0(nonce), H = OMAC_K^1(header), C = CTR_K^N(M) */
+    omac_compute(p_ctx, 0, p_nonce, nonce_size, nonce_mac);
+    omac_compute(p_ctx, 1, p_adata, adata_size, header_mac);
+    cf_ctr_init(&p_ctx->ctr, &cf_aes, &p_ctx->context, nonce_mac);
+
+    for (size_t i = 0; i < sizeof(p_ctx->tag); i++)
+    {
+        p_ctx->tag[i] = nonce_mac[i] ^ header_mac[i];
+    }
+
+    /* OMAC_K^2(C) starts with the tweak block. Holding it back keeps the final update non-empty. */
+    cf_cmac_stream_reset(&p_ctx->cmac);
+    memset(p_ctx->pending, 0, sizeof(p_ctx->pending));
+    p_ctx->pending[sizeof(p_ctx->pending) - 1] = 2;
+    p_ctx->pending_size = sizeof(p_ctx->pending);
+
+    p_ctx->mac_size  = mac_size;
+    p_ctx->operation = operation;
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_cifra_update(void * const p_context,
+                                       uint8_t *    p_data_in,
+                                       size_t       data_in_size,
+                                       uint8_t *    p_data_out)
+{
+    nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
+
+    /* The OMAC is calculated over the ciphertext. Take it before in-place decryption. */
+    if (p_ctx->operation == NRF_CRYPTO_DECRYPT)
+    {
+        omac_update(p_ctx, p_data_in, data_in_size);
+    }
+
+    cf_ctr_cipher(&p_ctx->ctr, p_data_in, p_data_out, data_in_size);
+
+    if (p_ctx->operation == NRF_CRYPTO_ENCRYPT)
+    {
+        omac_update(p_ctx, p_data_out, data_in_size);
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_cifra_finalize(void * const p_context, uint8_t * p_mac)
+{
+    uint8_t cipher_mac[CF_MAXBLOCK];
+    uint8_t diff = 0;
+
+    nrf_crypto_backend_cifra_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_cifra_aes_aead_context_t *)p_context;
+
+    cf_cmac_stream_update(&p_ctx->cmac, p_ctx->pending, p_ctx->pending_size, 1);
+    cf_cmac_stream_final(&p_ctx->cmac, cipher_mac);
+
+    for (size_t i = 0; i < p_ctx->mac_size; i++)
+    {
+        cipher_mac[i] ^= p_ctx->tag[i];
+    }
+
+    if (p_ctx->operation == NRF_CRYPTO_ENCRYPT)
+    {
+        memcpy(p_mac, cipher_mac, p_ctx->mac_size);
+        return NRF_SUCCESS;
+    }
+
+    /* Compare in constant time, like cf_eax_decrypt(). */
+    for (size_t i = 0; i < p_ctx->mac_size; i++)
+    {
+        diff |= cipher_mac[i] ^ p_mac[i];
+    }
+
+    return result_get((diff == 0) ? 0 : 1);
+}
+
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_CIFRA_AES_EAX)
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_128_info =
 {
@@ -177,7 +335,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_128_info =
 
     .init_fn   = backend_cifra_init,
     .uninit_fn = backend_cifra_uninit,
-    .crypt_fn  = backend_cifra_crypt
+    .crypt_fn  = backend_cifra_crypt,
+
+    .start_fn    = backend_cifra_start,
+    .update_fn   = backend_cifra_update,
+    .finalize_fn = backend_cifra_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_192_info =
@@ -187,7 +349,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_192_info =
 
     .init_fn   = backend_cifra_init,
     .uninit_fn = backend_cifra_uninit,
-    .crypt_fn  = backend_cifra_crypt
+    .crypt_fn  = backend_cifra_crypt,
+
+    .start_fn    = backend_cifra_start,
+    .update_fn   = backend_cifra_update,
+    .finalize_fn = backend_cifra_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_256_info =
@@ -197,7 +363,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_eax_256_info =
 
     .init_fn   = backend_cifra_init,
     .uninit_fn = backend_cifra_uninit,
-    .crypt_fn  = backend_cifra_crypt
+    .crypt_fn  = backend_cifra_crypt,
+
+    .start_fn    = backend_cifra_start,
+    .update_fn   = backend_cifra_update,
+    .finalize_fn = backend_cifra_finalize
 };
 #endif
 
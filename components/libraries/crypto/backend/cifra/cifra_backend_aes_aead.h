@@ -82,8 +82,15 @@ extern "C" {
 
 typedef struct
 {
-    nrf_crypto_aead_internal_context_t header;  /**< Common header for context. */
-    cf_aes_context                     context; /**< AES EAX context internal to Cifra. */
+    nrf_crypto_aead_internal_context_t header;        /**< Common header for context. */
+    cf_aes_context                     context;       /**< AES EAX context internal to Cifra. */
+    cf_ctr                             ctr;           /**< CTR state of a streamed operation. */
+    cf_cmac_stream                     cmac;          /**< OMAC state over the ciphertext of a streamed operation. */
+    uint8_t                            tag[16];       /**< OMAC of the nonce XORed with OMAC of the header. */
+    uint8_t                            pending[16];   /**< Ciphertext held back for the final OMAC block. */
+    uint8_t                            pending_size;  /**< Number of bytes in @ref pending. */
+    uint8_t                            mac_size;      /**< MAC size of a streamed operation. */
+    nrf_crypto_operation_t             operation;     /**< Direction of a streamed operation. */
 } nrf_crypto_backend_aes_eax_context_t;
 #endif
 
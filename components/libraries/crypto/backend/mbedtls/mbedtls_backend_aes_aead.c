@@ -184,6 +184,22 @@ static ret_code_t backend_mbedtls_uninit(void * const p_context)
     return NRF_SUCCESS;
 }
 
+/**@internal @brief Function for comparing a MAC in constant time.
+ *
+ * @retval true If the first @p size bytes of both buffers are equal.
+ */
+static bool mac_equal(uint8_t const * p_mac1, uint8_t const * p_mac2, size_t size)
+{
+    uint8_t diff = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        diff |= p_mac1[i] ^ p_mac2[i];
+    }
+
+    return (diff == 0);
+}
+
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS_AES_CCM)
 static ret_code_t backend_mbedtls_ccm_crypt(void * const            p_context,
                                             nrf_crypto_operation_t  operation,
@@ -251,6 +267,229 @@ static ret_code_t backend_mbedtls_ccm_crypt(void * const            p_context,
 
     return ret_val;
 }
+
+/**@internal @brief Function for encrypting one block with the key of the CCM context.
+ */
+static int ccm_block_encrypt(nrf_crypto_backend_aes_ccm_context_t * p_ccm,
+                             uint8_t const                          * p_in,
+                             uint8_t                                * p_out)
+{
+    size_t olen;
+
+    return mbedtls_cipher_update(&p_ccm->context.cipher_ctx, p_in, 16, p_out, &olen);
+}
+
+/**@internal @brief Function for adding up to one block to the CBC-MAC of a streamed CCM operation.
+ *
+ * @details Missing bytes of a partial block are treated as zero padding.
+ */
+static int ccm_cbc_mac_update(nrf_crypto_backend_aes_ccm_context_t * p_ccm,
+                              uint8_t const                        * p_data,
+                              size_t                                 size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        p_ccm->y[i] ^= p_data[i];
+    }
+
+    return ccm_block_encrypt(p_ccm, p_ccm->y, p_ccm->y);
+}
+
+/* The streamed CCM operation follows RFC 3610 and mbedtls_ccm_encrypt_and_tag(). mbed TLS does not
+ * offer a streaming CCM API, so the block cipher of its CCM context is used directly. */
+static ret_code_t backend_mbedtls_ccm_start(void * const           p_context,
+                                            nrf_crypto_operation_t operation,
+                                            uint8_t *              p_nonce,
+                                            uint8_t                nonce_size,
+                                            uint8_t *              p_adata,
+                                            size_t                 adata_size,
+                                            size_t                 data_size,
+                                            uint8_t                mac_size)
+{
+    int     result;
+    uint8_t b[16];
+    size_t  len_size;
+    size_t  use_len;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    /* CCM mode allows following MAC sizes: [4, 6, 8, 10, 12, 14, 16] */
+    if ((mac_size < NRF_CRYPTO_AES_CCM_MAC_MIN) || (mac_size > NRF_CRYPTO_AES_CCM_MAC_MAX) ||
+        ((mac_size & 0x01) != 0))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
+    }
+
+    if ((nonce_size < NRF_CRYPTO_AES_CCM_NONCE_SIZE_MIN) ||
+        (nonce_size > NRF_CRYPTO_AES_CCM_NONCE_SIZE_MAX))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_NONCE_SIZE;
+    }
+
+    if ((operation != NRF_CRYPTO_ENCRYPT) && (operation != NRF_CRYPTO_DECRYPT))
+    {
+        return NRF_ERROR_CRYPTO_INVALID_PARAM;
+    }
+
+    /* Like mbed TLS, only the two byte encoding of the adata length is supported. */
+    if (adata_size >= 0xFF00)
+    {
+        return NRF_ERROR_CRYPTO_INPUT_LENGTH;
+    }
+
+    len_size = 15 - nonce_size;
+    if ((len_size < sizeof(data_size)) && ((data_size >> (8 * len_size)) != 0))
+    {
+        return NRF_ERROR_CRYPTO_INPUT_LENGTH;
+    }
+
+    /* First block B_0: flags | nonce | message length. */
+    b[0] = (uint8_t)(((adata_size > 0) ? 0x40 : 0x00) |
+                     (((mac_size - 2) / 2) << 3)       |
+                     (len_size - 1));
+    memcpy(&b[1], p_nonce, nonce_size);
+    for (size_t i = 0; i < len_size; i++)
+    {
+        b[15 - i] = (i < sizeof(data_size)) ? (uint8_t)(data_size >> (8 * i)) : 0;
+    }
+
+    memset(p_ctx->ccm.y, 0, sizeof(p_ctx->ccm.y));
+    result = ccm_cbc_mac_update(&p_ctx->ccm, b, sizeof(b));
+
+    /* Adata is prefixed with its length and padded to a whole number of blocks. */
+    if ((result == 0) && (adata_size > 0))
+    {
+        memset(b, 0, sizeof(b));
+        b[0]    = (uint8_t)(adata_size >> 8);
+        b[1]    = (uint8_t)(adata_size);
+        use_len = MIN(adata_size, sizeof(b) - 2);
+        memcpy(&b[2], p_adata, use_len);
+        result = ccm_cbc_mac_update(&p_ctx->ccm, b, sizeof(b));
+
+        for (size_t offset = use_len; (result == 0) && (offset < adata_size); offset += use_len)
+        {
+            use_len = MIN(adata_size - offset, sizeof(b));
+            result  = ccm_cbc_mac_update(&p_ctx->ccm, &p_adata[offset], use_len);
+        }
+    }
+
+    if (result != 0)
+    {
+        return result_get(result);
+    }
+
+    /* Counter block A_1; A_0 is used for the MAC on finalization. */
+    memset(p_ctx->ccm.ctr, 0, sizeof(p_ctx->ccm.ctr));
+    p_ctx->ccm.ctr[0] = (uint8_t)(len_size - 1);
+    memcpy(&p_ctx->ccm.ctr[1], p_nonce, nonce_size);
+    p_ctx->ccm.ctr[15] = 1;
+
+    p_ctx->ccm.remaining = data_size;
+    p_ctx->ccm.operation = operation;
+    p_ctx->ccm.mac_size  = mac_size;
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_mbedtls_ccm_update(void * const p_context,
+                                             uint8_t *    p_data_in,
+                                             size_t       data_in_size,
+                                             uint8_t *    p_data_out)
+{
+    int     result = 0;
+    uint8_t s[16];
+    size_t  len_size;
+    size_t  use_len;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    if (data_in_size > p_ctx->ccm.remaining)
+    {
+        return NRF_ERROR_CRYPTO_INPUT_LENGTH;
+    }
+
+    p_ctx->ccm.remaining -= data_in_size;
+    len_size = (size_t)p_ctx->ccm.ctr[0] + 1;
+
+    for (size_t offset = 0; (result == 0) && (offset < data_in_size); offset += use_len)
+    {
+        use_len = MIN(data_in_size - offset, sizeof(s));
+
+        /* The MAC is calculated over the plaintext, which is the input on encryption. */
+        if (p_ctx->ccm.operation == NRF_CRYPTO_ENCRYPT)
+        {
+            result = ccm_cbc_mac_update(&p_ctx->ccm, &p_data_in[offset], use_len);
+        }
+
+        if (result == 0)
+        {
+            result = ccm_block_encrypt(&p_ctx->ccm, p_ctx->ccm.ctr, s);
+        }
+
+        for (size_t i = 0; (result == 0) && (i < use_len); i++)
+        {
+            p_data_out[offset + i] = p_data_in[offset + i] ^ s[i];
+        }
+
+        if ((result == 0) && (p_ctx->ccm.operation == NRF_CRYPTO_DECRYPT))
+        {
+            result = ccm_cbc_mac_update(&p_ctx->ccm, &p_data_out[offset], use_len);
+        }
+
+        for (size_t i = 0; i < len_size; i++)
+        {
+            if (++p_ctx->ccm.ctr[15 - i] != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    return result_get(result);
+}
+
+static ret_code_t backend_mbedtls_ccm_finalize(void * const p_context, uint8_t * p_mac)
+{
+    int     result;
+    uint8_t mac[16];
+    size_t  len_size;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    if (p_ctx->ccm.remaining != 0)
+    {
+        return NRF_ERROR_CRYPTO_INPUT_LENGTH;
+    }
+
+    /* MAC = CBC-MAC ^ E(A_0). */
+    len_size = (size_t)p_ctx->ccm.ctr[0] + 1;
+    memset(&p_ctx->ccm.ctr[16 - len_size], 0, len_size);
+
+    result = ccm_block_encrypt(&p_ctx->ccm, p_ctx->ccm.ctr, mac);
+    if (result != 0)
+    {
+        return result_get(result);
+    }
+
+    for (size_t i = 0; i < sizeof(mac); i++)
+    {
+        mac[i] ^= p_ctx->ccm.y[i];
+    }
+
+    if (p_ctx->ccm.operation == NRF_CRYPTO_ENCRYPT)
+    {
+        memcpy(p_mac, mac, p_ctx->ccm.mac_size);
+    }
+    else if (!mac_equal(mac, p_mac, p_ctx->ccm.mac_size))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_INVALID_MAC;
+    }
+
+    return NRF_SUCCESS;
+}
 #endif
 
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS_AES_GCM)
@@ -314,6 +553,96 @@ static ret_code_t backend_mbedtls_gcm_crypt(void * const            p_context,
 
     return ret_val;
 }
+
+static ret_code_t backend_mbedtls_gcm_start(void * const           p_context,
+                                            nrf_crypto_operation_t operation,
+                                            uint8_t *              p_nonce,
+                                            uint8_t                nonce_size,
+                                            uint8_t *              p_adata,
+                                            size_t                 adata_size,
+                                            size_t                 data_size,
+                                            uint8_t                mac_size)
+{
+    int result;
+    int mode;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    UNUSED_PARAMETER(data_size);
+
+    /* GCM allows following MAC size: [4 ... 16] */
+    if ((mac_size < NRF_CRYPTO_AES_GCM_MAC_MIN) || (mac_size > NRF_CRYPTO_AES_GCM_MAC_MAX))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
+    }
+
+    if (operation == NRF_CRYPTO_ENCRYPT)
+    {
+        mode = MBEDTLS_GCM_ENCRYPT;
+    }
+    else if (operation == NRF_CRYPTO_DECRYPT)
+    {
+        mode = MBEDTLS_GCM_DECRYPT;
+    }
+    else
+    {
+        return NRF_ERROR_CRYPTO_INVALID_PARAM;
+    }
+
+    result = mbedtls_gcm_starts(&p_ctx->gcm.context,
+                                mode,
+                                p_nonce,
+                                nonce_size,
+                                p_adata,
+                                adata_size);
+
+    p_ctx->gcm.operation = operation;
+    p_ctx->gcm.mac_size  = mac_size;
+
+    return result_get(result);
+}
+
+static ret_code_t backend_mbedtls_gcm_update(void * const p_context,
+                                             uint8_t *    p_data_in,
+                                             size_t       data_in_size,
+                                             uint8_t *    p_data_out)
+{
+    int result;
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    result = mbedtls_gcm_update(&p_ctx->gcm.context, data_in_size, p_data_in, p_data_out);
+
+    return result_get(result);
+}
+
+static ret_code_t backend_mbedtls_gcm_finalize(void * const p_context, uint8_t * p_mac)
+{
+    int     result;
+    uint8_t mac[16];
+
+    nrf_crypto_backend_mbedtls_aes_aead_context_t * p_ctx =
+        (nrf_crypto_backend_mbedtls_aes_aead_context_t *)p_context;
+
+    result = mbedtls_gcm_finish(&p_ctx->gcm.context, mac, p_ctx->gcm.mac_size);
+    if (result != 0)
+    {
+        return result_get(result);
+    }
+
+    if (p_ctx->gcm.operation == NRF_CRYPTO_ENCRYPT)
+    {
+        memcpy(p_mac, mac, p_ctx->gcm.mac_size);
+    }
+    else if (!mac_equal(mac, p_mac, p_ctx->gcm.mac_size))
+    {
+        return NRF_ERROR_CRYPTO_AEAD_INVALID_MAC;
+    }
+
+    return NRF_SUCCESS;
+}
 #endif
 
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS_AES_CCM)
@@ -324,7 +653,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_ccm_128_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_ccm_crypt
+    .crypt_fn  = backend_mbedtls_ccm_crypt,
+
+    .start_fn    = backend_mbedtls_ccm_start,
+    .update_fn   = backend_mbedtls_ccm_update,
+    .finalize_fn = backend_mbedtls_ccm_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_ccm_192_info =
@@ -334,7 +667,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_ccm_192_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_ccm_crypt
+    .crypt_fn  = backend_mbedtls_ccm_crypt,
+
+    .start_fn    = backend_mbedtls_ccm_start,
+    .update_fn   = backend_mbedtls_ccm_update,
+    .finalize_fn = backend_mbedtls_ccm_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_ccm_256_info =
@@ -344,7 +681,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_ccm_256_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_ccm_crypt
+    .crypt_fn  = backend_mbedtls_ccm_crypt,
+
+    .start_fn    = backend_mbedtls_ccm_start,
+    .update_fn   = backend_mbedtls_ccm_update,
+    .finalize_fn = backend_mbedtls_ccm_finalize
 };
 #endif
 
@@ -356,7 +697,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_128_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_gcm_crypt
+    .crypt_fn  = backend_mbedtls_gcm_crypt,
+
+    .start_fn    = backend_mbedtls_gcm_start,
+    .update_fn   = backend_mbedtls_gcm_update,
+    .finalize_fn = backend_mbedtls_gcm_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_192_info =
@@ -366,7 +711,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_192_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_gcm_crypt
+    .crypt_fn  = backend_mbedtls_gcm_crypt,
+
+    .start_fn    = backend_mbedtls_gcm_start,
+    .update_fn   = backend_mbedtls_gcm_update,
+    .finalize_fn = backend_mbedtls_gcm_finalize
 };
 
 nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_256_info =
@@ -376,7 +725,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_aes_gcm_256_info =
 
     .init_fn   = backend_mbedtls_init,
     .uninit_fn = backend_mbedtls_uninit,
-    .crypt_fn  = backend_mbedtls_gcm_crypt
+    .crypt_fn  = backend_mbedtls_gcm_crypt,
+
+    .start_fn    = backend_mbedtls_gcm_start,
+    .update_fn   = backend_mbedtls_gcm_update,
+    .finalize_fn = backend_mbedtls_gcm_finalize
 };
 #endif
 
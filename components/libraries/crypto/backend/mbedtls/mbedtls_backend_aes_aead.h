@@ -83,8 +83,13 @@ extern "C" {
 
 typedef struct
 {
-    nrf_crypto_aead_internal_context_t header;   /**< Common header for context. */
-    mbedtls_ccm_context                context;  /**< AES CCM context internal to mbed TLS. */
+    nrf_crypto_aead_internal_context_t header;    /**< Common header for context. */
+    mbedtls_ccm_context                context;   /**< AES CCM context internal to mbed TLS. */
+    uint8_t                            y[16];     /**< CBC-MAC state of a streamed operation. */
+    uint8_t                            ctr[16];   /**< Counter block of a streamed operation. */
+    size_t                             remaining; /**< Message bytes still expected by a streamed operation. */
+    nrf_crypto_operation_t             operation; /**< Direction of a streamed operation. */
+    uint8_t                            mac_size;  /**< MAC size of a streamed operation. */
 } nrf_crypto_backend_aes_ccm_context_t;
 #endif
 
@@ -106,8 +111,10 @@ typedef struct
 
 typedef struct
 {
-    nrf_crypto_aead_internal_context_t header;   /**< Common header for context. */
-    mbedtls_gcm_context                context;  /**< AES GCM context internal to mbed TLS. */
+    nrf_crypto_aead_internal_context_t header;    /**< Common header for context. */
+    mbedtls_gcm_context                context;   /**< AES GCM context internal to mbed TLS. */
+    nrf_crypto_operation_t             operation; /**< Direction of a streamed operation. */
+    uint8_t                            mac_size;  /**< MAC size of a streamed operation. */
 } nrf_crypto_backend_aes_gcm_context_t;
 #endif
 
@@ -173,4 +173,120 @@ ret_code_t nrf_crypto_backend_mbedtls_verify(
 }
 
 
+/** @brief Function for filling the table of precomputed multiples of a group generator.
+ *
+ *  mbed TLS keeps the table in the group after the first multiplication by its generator.
+ */
+static int group_precompute(mbedtls_ecp_group * p_group)
+{
+    int               result;
+    mbedtls_mpi       one;
+    mbedtls_ecp_point point;
+
+    mbedtls_mpi_init(&one);
+    mbedtls_ecp_point_init(&point);
+
+    result = mbedtls_mpi_lset(&one, 1);
+    if (result == 0)
+    {
+        result = mbedtls_ecp_mul(p_group, &point, &one, &p_group->G, NULL, NULL);
+    }
+
+    mbedtls_ecp_point_free(&point);
+    mbedtls_mpi_free(&one);
+
+    return result;
+}
+
+
+ret_code_t nrf_crypto_backend_mbedtls_ecdsa_prepare(
+    void       * p_prepared,
+    void const * p_public_key)
+{
+    nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t * p_prep =
+        (nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t *)p_prepared;
+
+    nrf_crypto_backend_mbedtls_ecc_public_key_t const * p_pub =
+        (nrf_crypto_backend_mbedtls_ecc_public_key_t const *)p_public_key;
+
+    mbedtls_ecp_group_init(&p_prep->group);
+
+    if (!nrf_crypto_backend_mbedtls_ecc_group_load(&p_prep->group, p_pub->header.p_info))
+    {
+        return NRF_ERROR_CRYPTO_INTERNAL;
+    }
+
+    if (group_precompute(&p_prep->group) != 0)
+    {
+        nrf_crypto_backend_mbedtls_ecdsa_prepared_free(p_prep);
+        return NRF_ERROR_CRYPTO_INTERNAL;
+    }
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_crypto_backend_mbedtls_ecdsa_prepared_verify(
+    void           * p_prepared,
+    void     const * p_public_key,
+    uint8_t  const * p_data,
+    size_t           data_size,
+    uint8_t  const * p_signature)
+{
+    int         result;
+    mbedtls_mpi r_mpi;
+    mbedtls_mpi s_mpi;
+
+    nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t * p_prep =
+        (nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t *)p_prepared;
+
+    nrf_crypto_backend_mbedtls_ecc_public_key_t const * p_pub =
+        (nrf_crypto_backend_mbedtls_ecc_public_key_t const *)p_public_key;
+
+    nrf_crypto_ecc_curve_info_t const * p_info = p_pub->header.p_info;
+
+    mbedtls_mpi_init(&r_mpi);
+    mbedtls_mpi_init(&s_mpi);
+
+    result = mbedtls_mpi_read_binary(&r_mpi, p_signature, p_info->raw_private_key_size);
+    if (result == 0)
+    {
+        result = mbedtls_mpi_read_binary(&s_mpi,
+                                         &p_signature[p_info->raw_private_key_size],
+                                         p_info->raw_private_key_size);
+        if (result == 0)
+        {
+            // u1 * G uses the table kept in the prepared group.
+            result = mbedtls_ecdsa_verify(&p_prep->group,
+                                          p_data,
+                                          data_size,
+                                          &p_pub->key,
+                                          &r_mpi,
+                                          &s_mpi);
+        }
+    }
+
+    mbedtls_mpi_free(&r_mpi);
+    mbedtls_mpi_free(&s_mpi);
+
+    if (result == MBEDTLS_ERR_ECP_VERIFY_FAILED)
+    {
+        return NRF_ERROR_CRYPTO_ECDSA_INVALID_SIGNATURE;
+    }
+    else if (result != 0)
+    {
+        return NRF_ERROR_CRYPTO_INTERNAL;
+    }
+    return NRF_SUCCESS;
+}
+
+
+void nrf_crypto_backend_mbedtls_ecdsa_prepared_free(void * p_prepared)
+{
+    nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t * p_prep =
+        (nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t *)p_prepared;
+
+    mbedtls_ecp_group_free(&p_prep->group);
+}
+
+
 #endif // NRF_MODULE_ENABLED(NRF_CRYPTO) && NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS)
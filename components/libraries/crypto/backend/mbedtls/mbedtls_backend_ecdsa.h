@@ -49,6 +49,15 @@
 #include "nrf_crypto_ecc_shared.h"
 #include "nrf_crypto_ecdsa_shared.h"
 
+/*lint -save -e????*/
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+#include "mbedtls/ecp.h"
+/*lint -restore*/
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -75,6 +84,51 @@ ret_code_t nrf_crypto_backend_mbedtls_verify(
     uint8_t  const * p_signature);
 
 
+/** @internal @brief Data kept by mbed TLS for a prepared public key.
+ *
+ * The group keeps a table of 2^(w-1) precomputed multiples of the curve generator after the first
+ * multiplication by the generator, where window size w is limited by MBEDTLS_ECP_WINDOW_SIZE.
+ * mbedtls_ecdsa_verify() uses the table for u1 * G. For secp256r1 the table takes about 2 kB of
+ * mbed TLS heap.
+ */
+typedef struct
+{
+    mbedtls_ecp_group group;            /**< @internal @brief Curve group holding the table of the curve generator. */
+} nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t;
+
+
+/** @internal See @ref nrf_crypto_backend_ecdsa_prepare_fn_t.
+ */
+ret_code_t nrf_crypto_backend_mbedtls_ecdsa_prepare(
+    void       * p_prepared,
+    void const * p_public_key);
+
+
+/** @internal See @ref nrf_crypto_backend_ecdsa_prepared_verify_fn_t.
+ */
+ret_code_t nrf_crypto_backend_mbedtls_ecdsa_prepared_verify(
+    void           * p_prepared,
+    void     const * p_public_key,
+    uint8_t  const * p_data,
+    size_t           data_size,
+    uint8_t  const * p_signature);
+
+
+/** @internal See @ref nrf_crypto_backend_ecdsa_prepared_free_fn_t.
+ */
+void nrf_crypto_backend_mbedtls_ecdsa_prepared_free(void * p_prepared);
+
+
+// Precomputed data of prepared keys is kept for all curves verified by mbed TLS
+#define NRF_CRYPTO_BACKEND_ECDSA_PREPARED_KEY_ENABLED 1
+typedef nrf_crypto_backend_mbedtls_ecdsa_prepared_key_t nrf_crypto_backend_ecdsa_prepared_key_t;
+// Verify implementation that the prepared key functions belong to
+#define nrf_crypto_backend_ecdsa_prepared_key_verify  nrf_crypto_backend_mbedtls_verify
+#define nrf_crypto_backend_ecdsa_prepare              nrf_crypto_backend_mbedtls_ecdsa_prepare
+#define nrf_crypto_backend_ecdsa_prepared_verify      nrf_crypto_backend_mbedtls_ecdsa_prepared_verify
+#define nrf_crypto_backend_ecdsa_prepared_free        nrf_crypto_backend_mbedtls_ecdsa_prepared_free
+
+
 #if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP192R1)
 // Context is not used by mbed TLS, so its size is 0
 #define NRF_CRYPTO_BACKEND_SECP192R1_SIGN_CONTEXT_SIZE   0
@@ -137,6 +137,97 @@ static ret_code_t backend_cc310_crypt(void * const           p_context,
     return NRF_SUCCESS;
 }
 
+static ret_code_t backend_oberon_start(void * const           p_context,
+                                       nrf_crypto_operation_t operation,
+                                       uint8_t *              p_nonce,
+                                       uint8_t                nonce_size,
+                                       uint8_t *              p_adata,
+                                       size_t                 adata_size,
+                                       size_t                 data_size,
+                                       uint8_t                mac_size)
+{
+    nrf_crypto_backend_chacha_poly_context_t * p_ctx =
+        (nrf_crypto_backend_chacha_poly_context_t *)p_context;
+
+    UNUSED_PARAMETER(data_size);
+
+    if (mac_size   != NRF_CRYPTO_CHACHA_POLY_MAC_SIZE)
+    {
+        return NRF_ERROR_CRYPTO_AEAD_MAC_SIZE;
+    }
+
+    if (nonce_size != NRF_CRYPTO_CHACHA_POLY_NONCE_SIZE)
+    {
+        return NRF_ERROR_CRYPTO_AEAD_NONCE_SIZE;
+    }
+
+    if ((operation != NRF_CRYPTO_ENCRYPT) && (operation != NRF_CRYPTO_DECRYPT))
+    {
+        return NRF_ERROR_CRYPTO_INVALID_PARAM;
+    }
+
+    /* The incremental API needs the nonce and the key again for every chunk. */
+    memcpy(p_ctx->nonce, p_nonce, sizeof(p_ctx->nonce));
+    p_ctx->operation = operation;
+
+    ocrypto_chacha20_poly1305_init(&p_ctx->stream, p_ctx->nonce, sizeof(p_ctx->nonce), p_ctx->key);
+    if (adata_size != 0)
+    {
+        ocrypto_chacha20_poly1305_update_aad(&p_ctx->stream, p_adata, adata_size);
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_oberon_update(void * const p_context,
+                                        uint8_t *    p_data_in,
+                                        size_t       data_in_size,
+                                        uint8_t *    p_data_out)
+{
+    nrf_crypto_backend_chacha_poly_context_t * p_ctx =
+        (nrf_crypto_backend_chacha_poly_context_t *)p_context;
+
+    if (p_ctx->operation == NRF_CRYPTO_ENCRYPT)
+    {
+        ocrypto_chacha20_poly1305_update_enc(&p_ctx->stream,
+                                             p_data_out,
+                                             p_data_in,
+                                             data_in_size,
+                                             p_ctx->nonce,
+                                             sizeof(p_ctx->nonce),
+                                             p_ctx->key);
+    }
+    else
+    {
+        ocrypto_chacha20_poly1305_update_dec(&p_ctx->stream,
+                                             p_data_out,
+                                             p_data_in,
+                                             data_in_size,
+                                             p_ctx->nonce,
+                                             sizeof(p_ctx->nonce),
+                                             p_ctx->key);
+    }
+
+    return NRF_SUCCESS;
+}
+
+static ret_code_t backend_oberon_finalize(void * const p_context, uint8_t * p_mac)
+{
+    nrf_crypto_backend_chacha_poly_context_t * p_ctx =
+        (nrf_crypto_backend_chacha_poly_context_t *)p_context;
+
+    if (p_ctx->operation == NRF_CRYPTO_ENCRYPT)
+    {
+        ocrypto_chacha20_poly1305_final_enc(&p_ctx->stream, p_mac);
+    }
+    else if (ocrypto_chacha20_poly1305_final_dec(&p_ctx->stream, p_mac) != 0)
+    {
+        return NRF_ERROR_CRYPTO_AEAD_INVALID_MAC;
+    }
+
+    return NRF_SUCCESS;
+}
+
 nrf_crypto_aead_info_t const g_nrf_crypto_chacha_poly_256_info =
 {
     .key_size  = NRF_CRYPTO_KEY_SIZE_256,
@@ -144,7 +235,11 @@ nrf_crypto_aead_info_t const g_nrf_crypto_chacha_poly_256_info =
 
     .init_fn   = backend_cc310_init,
     .uninit_fn = backend_cc310_uninit,
-    .crypt_fn  = backend_cc310_crypt
+    .crypt_fn  = backend_cc310_crypt,
+
+    .start_fn    = backend_oberon_start,
+    .update_fn   = backend_oberon_update,
+    .finalize_fn = backend_oberon_finalize
 };
 
 
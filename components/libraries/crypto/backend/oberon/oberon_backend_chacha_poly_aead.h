@@ -56,6 +56,7 @@
 
 #include "nrf_crypto_aead_shared.h"
 #include "ocrypto_chacha20_poly1305.h"
+#include "ocrypto_chacha20_poly1305_inc.h"
 #include "nrf_crypto_error.h"
 #include "nrf_crypto_types.h"
 
@@ -85,6 +86,10 @@ typedef struct
     nrf_crypto_aead_internal_context_t header;  /**< Common header for context. */
 
     uint8_t key[NRF_CRYPTO_OBERON_CHACHA_POLY_BACKEND_KEY_SIZE];
+
+    ocrypto_chacha20_poly1305_ctx stream;                   /**< State of a streamed operation. */
+    uint8_t nonce[NRF_CRYPTO_CHACHA_POLY_NONCE_SIZE];       /**< Nonce of a streamed operation. */
+    nrf_crypto_operation_t        operation;                /**< Direction of a streamed operation. */
 } nrf_crypto_backend_chacha_poly_context_t;
 #endif
 
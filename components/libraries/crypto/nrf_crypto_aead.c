@@ -74,8 +74,9 @@ ret_code_t nrf_crypto_aead_init(nrf_crypto_aead_context_t * const    p_context,
     VERIFY_TRUE((ret_val == NRF_SUCCESS) || (ret_val == NRF_ERROR_CRYPTO_CONTEXT_NOT_INITIALIZED),
                 ret_val);
 
-    p_int_context->init_value = NRF_CRYPTO_AEAD_INIT_MAGIC_VALUE;
-    p_int_context->p_info     = p_info;
+    p_int_context->init_value   = NRF_CRYPTO_AEAD_INIT_MAGIC_VALUE;
+    p_int_context->p_info       = p_info;
+    p_int_context->stream_state = NRF_CRYPTO_AEAD_STREAM_IDLE;
 
     ret_val = p_info->init_fn(p_context, p_key);
 
@@ -140,6 +141,9 @@ ret_code_t nrf_crypto_aead_crypt(nrf_crypto_aead_context_t * const p_context,
     VERIFY_FALSE(((p_data_out == NULL) && (data_in_size != 0)),
                  NRF_ERROR_CRYPTO_OUTPUT_NULL);
 
+    /* A one-shot operation abandons any streamed operation in progress. */
+    p_int_context->stream_state = NRF_CRYPTO_AEAD_STREAM_IDLE;
+
     ret_val = p_int_context->p_info->crypt_fn(p_context,
                                               operation,
                                               p_nonce,
@@ -154,6 +158,113 @@ ret_code_t nrf_crypto_aead_crypt(nrf_crypto_aead_context_t * const p_context,
     return ret_val;
 }
 
+ret_code_t nrf_crypto_aead_start(nrf_crypto_aead_context_t * const p_context,
+                                 nrf_crypto_operation_t            operation,
+                                 uint8_t *                         p_nonce,
+                                 uint8_t                           nonce_size,
+                                 uint8_t *                         p_adata,
+                                 size_t                            adata_size,
+                                 size_t                            data_size,
+                                 uint8_t                           mac_size)
+{
+    ret_code_t ret_val;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_TRUE((p_int_context->p_info->start_fn != NULL), NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE);
+
+    VERIFY_FALSE(((p_nonce == NULL) && (nonce_size != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    VERIFY_FALSE(((p_adata == NULL) && (adata_size != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    p_int_context->stream_state = NRF_CRYPTO_AEAD_STREAM_IDLE;
+
+    ret_val = p_int_context->p_info->start_fn(p_context,
+                                              operation,
+                                              p_nonce,
+                                              nonce_size,
+                                              p_adata,
+                                              adata_size,
+                                              data_size,
+                                              mac_size);
+    if (ret_val == NRF_SUCCESS)
+    {
+        p_int_context->stream_state = NRF_CRYPTO_AEAD_STREAM_ACTIVE;
+    }
+
+    return ret_val;
+}
+
+ret_code_t nrf_crypto_aead_update(nrf_crypto_aead_context_t * const p_context,
+                                  uint8_t *                         p_data_in,
+                                  size_t                            data_in_size,
+                                  uint8_t *                         p_data_out)
+{
+    ret_code_t ret_val;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_FALSE((p_int_context->stream_state == NRF_CRYPTO_AEAD_STREAM_IDLE),
+                 NRF_ERROR_CRYPTO_CONTEXT_NOT_INITIALIZED);
+
+    VERIFY_FALSE(((p_data_in == NULL) && (data_in_size != 0)),
+                 NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    VERIFY_FALSE(((p_data_out == NULL) && (data_in_size != 0)),
+                 NRF_ERROR_CRYPTO_OUTPUT_NULL);
+
+    if (data_in_size == 0)
+    {
+        return NRF_SUCCESS;
+    }
+
+    /* Backends keep no partial block between calls, so only the last chunk may be partial. */
+    VERIFY_TRUE((p_int_context->stream_state == NRF_CRYPTO_AEAD_STREAM_ACTIVE),
+                NRF_ERROR_CRYPTO_INPUT_LENGTH);
+
+    ret_val = p_int_context->p_info->update_fn(p_context, p_data_in, data_in_size, p_data_out);
+    VERIFY_SUCCESS(ret_val);
+
+    if ((data_in_size % NRF_CRYPTO_AEAD_STREAM_BLOCK_SIZE) != 0)
+    {
+        p_int_context->stream_state = NRF_CRYPTO_AEAD_STREAM_LAST;
+    }
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_crypto_aead_finalize(nrf_crypto_aead_context_t * const p_context,
+                                    uint8_t *                         p_mac)
+{
+    ret_code_t ret_val;
+
+    nrf_crypto_aead_internal_context_t * p_int_context =
+        (nrf_crypto_aead_internal_context_t *)p_context;
+
+    ret_val = context_verify(p_int_context);
+    VERIFY_SUCCESS(ret_val);
+
+    VERIFY_FALSE((p_int_context->stream_state == NRF_CRYPTO_AEAD_STREAM_IDLE),
+                 NRF_ERROR_CRYPTO_CONTEXT_NOT_INITIALIZED);
+
+    VERIFY_TRUE((p_mac != NULL), NRF_ERROR_CRYPTO_INPUT_NULL);
+
+    p_int_context->stream_state = NRF_CRYPTO_AEAD_STREAM_IDLE;
+
+    ret_val = p_int_context->p_info->finalize_fn(p_context, p_mac);
+    return ret_val;
+}
+
 #endif // NRF_MODULE_ENABLED(NRF_CRYPTO_AEAD)
 #endif // NRF_MODULE_ENABLED(NRF_CRYPTO)
 
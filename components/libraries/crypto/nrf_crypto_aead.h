@@ -196,8 +196,10 @@ ret_code_t nrf_crypto_aead_uninit(void * const p_context);
  *                              to 65535 bytes. Data out buffer must be at least the same length.
  * @param[out] p_data_out       Pointer to the output buffer where encrypted or decrypted data
  *                              will be stored. Must be at least 'data_in_size' bytes wide.
- *                                - GCM: On encryption, the p_data_out buffer can be the same as
- *                                       the p_data_in buffer.
+ *                              For the mbed TLS, Cifra and Oberon backends, the p_data_out buffer
+ *                              can be the same as the p_data_in buffer.
+ *                                - GCM (CC310 backend): On encryption, the p_data_out buffer can
+ *                                       be the same as the p_data_in buffer.
  *                                       On decryption, the p_data_out buffer cannot be the same
  *                                       as p_data_in buffer. If buffers overlap, the p_data_out
  *                                       buffer must trail at least 8 bytes behind the p_data_in
@@ -224,6 +226,80 @@ ret_code_t nrf_crypto_aead_crypt(nrf_crypto_aead_context_t * const p_context,
                                  uint8_t *                         p_mac,
                                  uint8_t                           mac_size);
 
+/**@brief Function for starting a streamed encryption or decryption.
+ *
+ * @details A streamed operation lets the message be processed in chunks with
+ *          @ref nrf_crypto_aead_update, so the complete message does not have to be present in
+ *          memory at once. The result is the same as for @ref nrf_crypto_aead_crypt with
+ *          the same parameters. Streaming is available for:
+ *            - CCM         (mbed TLS backend)
+ *            - EAX         (Cifra backend)
+ *            - GCM         (mbed TLS backend)
+ *            - CHACHA-POLY (Oberon backend)
+ *
+ * @note On decryption, @ref nrf_crypto_aead_update releases plaintext before the MAC is verified
+ *       by @ref nrf_crypto_aead_finalize. The plaintext must not be used before finalization
+ *       succeeded.
+ *
+ * @param[in]  p_context        Context object. Must be initialized before the call.
+ * @param[in]  operation        Parameter indicating whether an encrypt (NRF_CRYPTO_ENCRYPT) or
+ *                              a decrypt (NRF_CRYPTO_DECRYPT) operation shall be performed.
+ * @param[in]  p_nonce          Pointer to nonce. See @ref nrf_crypto_aead_crypt for valid sizes.
+ * @param[in]  nonce_size       Nonce byte size.
+ * @param[in]  p_adata          Pointer to additional authenticated data (adata).
+ * @param[in]  adata_size       Length of additional authenticated data in bytes.
+ * @param[in]  data_size        Total length of the message in bytes. CCM mode authenticates the
+ *                              length before any data, so the chunks passed to
+ *                              @ref nrf_crypto_aead_update must add up to this value. Other modes
+ *                              ignore it.
+ * @param[in]  mac_size         MAC byte size. See @ref nrf_crypto_aead_crypt for valid sizes.
+ *
+ * @retval NRF_SUCCESS                          Streamed operation was started.
+ * @retval NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE The backend cannot stream the selected mode.
+ */
+ret_code_t nrf_crypto_aead_start(nrf_crypto_aead_context_t * const p_context,
+                                 nrf_crypto_operation_t            operation,
+                                 uint8_t *                         p_nonce,
+                                 uint8_t                           nonce_size,
+                                 uint8_t *                         p_adata,
+                                 size_t                            adata_size,
+                                 size_t                            data_size,
+                                 uint8_t                           mac_size);
+
+/**@brief Function for encrypting or decrypting a chunk of a streamed message.
+ *
+ * @details Every chunk except the last one must be a multiple of
+ *          @ref NRF_CRYPTO_AEAD_STREAM_BLOCK_SIZE bytes long.
+ *
+ * @param[in]  p_context        Context object. A streamed operation must be started.
+ * @param[in]  p_data_in        Pointer to the input data chunk.
+ * @param[in]  data_in_size     Length of the input data chunk in bytes.
+ * @param[out] p_data_out       Pointer to the output buffer. Must be at least 'data_in_size' bytes
+ *                              wide. Can be the same as p_data_in to encrypt or decrypt in place.
+ *
+ * @retval NRF_SUCCESS                   Chunk was processed.
+ * @retval NRF_ERROR_CRYPTO_INPUT_LENGTH A previous chunk was not a multiple of
+ *                                       @ref NRF_CRYPTO_AEAD_STREAM_BLOCK_SIZE, or the chunks
+ *                                       exceed the data_size given to @ref nrf_crypto_aead_start.
+ */
+ret_code_t nrf_crypto_aead_update(nrf_crypto_aead_context_t * const p_context,
+                                  uint8_t *                         p_data_in,
+                                  size_t                            data_in_size,
+                                  uint8_t *                         p_data_out);
+
+/**@brief Function for finalizing a streamed encryption or decryption.
+ *
+ * @param[in]     p_context     Context object. A streamed operation must be started.
+ * @param[in,out] p_mac         On encryption, buffer where the MAC is stored. On decryption,
+ *                              the MAC to verify. Its size is the mac_size given to
+ *                              @ref nrf_crypto_aead_start.
+ *
+ * @retval NRF_SUCCESS                       MAC was generated or successfully verified.
+ * @retval NRF_ERROR_CRYPTO_AEAD_INVALID_MAC MAC did not match the decrypted message.
+ */
+ret_code_t nrf_crypto_aead_finalize(nrf_crypto_aead_context_t * const p_context,
+                                    uint8_t *                         p_mac);
+
 #ifdef __cplusplus
 }
 #endif
@@ -71,6 +71,7 @@ extern "C" {
 #define NRF_CRYPTO_AES_CCM_STAR_NONCE_SIZE      (13u)  /* [13] allowed nonce size in CCM* mode */
 #define NRF_CRYPTO_CHACHA_POLY_NONCE_SIZE       (12u)  /* [12] allowed nonce size in chacha-poly mode */
 #define NRF_CRYPTO_CHACHA_POLY_MAC_SIZE         (16u)  /* [16] allowed MAC size in chacha-poly mode */
+#define NRF_CRYPTO_AEAD_STREAM_BLOCK_SIZE       (16u)  /* Granularity of all but the last streamed chunk */
 
 /**@internal @brief Enumeration of supported modes of operation in nrf_crypto_aead.
  */
@@ -83,6 +84,15 @@ typedef enum
     NRF_CRYPTO_AEAD_MODE_CHACHA_POLY    // supported by: CC310 & OBERON
 } nrf_crypto_aead_mode_t;
 
+/**@internal @brief Enumeration of states of a streamed AEAD operation.
+ */
+typedef enum
+{
+    NRF_CRYPTO_AEAD_STREAM_IDLE,        //!< No streamed operation started.
+    NRF_CRYPTO_AEAD_STREAM_ACTIVE,      //!< Streamed operation started, more data can be added.
+    NRF_CRYPTO_AEAD_STREAM_LAST,        //!< Partial chunk processed, only finalization is allowed.
+} nrf_crypto_aead_stream_state_t;
+
 
 /**@internal @brief Type declaration to perform AEAD initialization in the nrf_crypto backend.
  *
@@ -112,6 +122,35 @@ typedef ret_code_t (*aead_crypt_fn_t)(void * const           p_context,
                                       uint8_t *              p_mac,
                                       uint8_t                mac_size);
 
+/**@internal @brief Type declaration to start a streamed AEAD operation in nrf_crypto backend.
+ *
+ *  This is internal API. See @ref nrf_crypto_aead_start for documentation.
+ */
+typedef ret_code_t (*aead_start_fn_t)(void * const           p_context,
+                                      nrf_crypto_operation_t operation,
+                                      uint8_t *              p_nonce,
+                                      uint8_t                nonce_size,
+                                      uint8_t *              p_adata,
+                                      size_t                 adata_size,
+                                      size_t                 data_size,
+                                      uint8_t                mac_size);
+
+/**@internal @brief Type declaration to process a chunk of a streamed AEAD operation in
+ *                  nrf_crypto backend.
+ *
+ *  This is internal API. See @ref nrf_crypto_aead_update for documentation.
+ */
+typedef ret_code_t (*aead_update_fn_t)(void * const p_context,
+                                       uint8_t *    p_data_in,
+                                       size_t       data_in_size,
+                                       uint8_t *    p_data_out);
+
+/**@internal @brief Type declaration to finalize a streamed AEAD operation in nrf_crypto backend.
+ *
+ *  This is internal API. See @ref nrf_crypto_aead_finalize for documentation.
+ */
+typedef ret_code_t (*aead_finalize_fn_t)(void * const p_context, uint8_t * p_mac);
+
 /**@internal @brief Type declaration for the nrf_crypto_aead info structure.
  *
  * @details     This structure contains the calling interface and any metadata required
@@ -125,6 +164,10 @@ typedef struct
     aead_init_fn_t   const init_fn;
     aead_uninit_fn_t const uninit_fn;
     aead_crypt_fn_t  const crypt_fn;
+
+    aead_start_fn_t    const start_fn;      //!< NULL if the backend cannot stream this mode.
+    aead_update_fn_t   const update_fn;
+    aead_finalize_fn_t const finalize_fn;
 } nrf_crypto_aead_info_t;
 
 /**@internal @brief Type declaration of internal representation of an AEAD context structure.
@@ -135,6 +178,7 @@ typedef struct
 {
     uint32_t init_value;
     nrf_crypto_aead_info_t const * p_info;
+    nrf_crypto_aead_stream_state_t stream_state;
 } nrf_crypto_aead_internal_context_t;
 
 /** @} */
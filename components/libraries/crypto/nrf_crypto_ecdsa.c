@@ -451,4 +451,115 @@ ret_code_t nrf_crypto_ecdsa_verify(
 }
 
 
+ret_code_t nrf_crypto_ecdsa_prepared_key_init(
+    nrf_crypto_ecdsa_prepared_key_t       * p_prepared_key,
+    nrf_crypto_ecc_curve_info_t     const * p_curve_info,
+    uint8_t                         const * p_raw_data,
+    size_t                                  raw_data_size,
+    nrf_crypto_ecdsa_precompute_t           precompute)
+{
+    ret_code_t result;
+
+    VERIFY_TRUE(p_prepared_key != NULL, NRF_ERROR_CRYPTO_OUTPUT_NULL);
+
+    p_prepared_key->header.init_value = 0;
+    p_prepared_key->backend_used      = false;
+
+    result = nrf_crypto_ecc_public_key_from_raw(p_curve_info,
+                                                &p_prepared_key->public_key,
+                                                p_raw_data,
+                                                raw_data_size);
+    VERIFY_SUCCESS(result);
+
+#if NRF_CRYPTO_BACKEND_ECDSA_PREPARED_KEY_ENABLED
+    // Precomputed data is only valid for curves verified by the backend that keeps it
+    if ((precompute != NRF_CRYPTO_ECDSA_PRECOMPUTE_NONE) &&
+        (BACKEND_IMPL_GET(verify_impl, p_curve_info->curve_type) ==
+         nrf_crypto_backend_ecdsa_prepared_key_verify))
+    {
+        result = nrf_crypto_backend_ecdsa_prepare(&p_prepared_key->backend,
+                                                  &p_prepared_key->public_key);
+        if (result != NRF_SUCCESS)
+        {
+            UNUSED_RETURN_VALUE(nrf_crypto_ecc_public_key_free(&p_prepared_key->public_key));
+            return result;
+        }
+        p_prepared_key->backend_used = true;
+    }
+#else
+    UNUSED_PARAMETER(precompute);
+#endif
+
+    p_prepared_key->header.p_info     = p_curve_info;
+    p_prepared_key->header.init_value = NRF_CRYPTO_INTERNAL_ECDSA_PREPARED_KEY_INIT_VALUE;
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t nrf_crypto_ecdsa_prepared_verify(
+    nrf_crypto_ecdsa_verify_context_t       * p_context,
+    nrf_crypto_ecdsa_prepared_key_t         * p_prepared_key,
+    uint8_t                           const * p_hash,
+    size_t                                    hash_size,
+    uint8_t                           const * p_signature,
+    size_t                                    signature_size)
+{
+    ret_code_t result;
+
+    result = nrf_crypto_internal_ecc_key_input_check(
+        (nrf_crypto_internal_ecc_key_header_t const *)p_prepared_key,
+        NRF_CRYPTO_INTERNAL_ECDSA_PREPARED_KEY_INIT_VALUE);
+    VERIFY_SUCCESS(result);
+
+#if NRF_CRYPTO_BACKEND_ECDSA_PREPARED_KEY_ENABLED
+    if (p_prepared_key->backend_used)
+    {
+        result = nrf_crypto_internal_ecc_raw_input_check(
+            p_signature,
+            signature_size,
+            2 * p_prepared_key->header.p_info->raw_private_key_size);
+        VERIFY_SUCCESS(result);
+        VERIFY_TRUE(p_hash != NULL, NRF_ERROR_CRYPTO_INPUT_NULL);
+
+        return nrf_crypto_backend_ecdsa_prepared_verify(&p_prepared_key->backend,
+                                                        &p_prepared_key->public_key,
+                                                        p_hash,
+                                                        hash_size,
+                                                        p_signature);
+    }
+#endif
+
+    return nrf_crypto_ecdsa_verify(p_context,
+                                   &p_prepared_key->public_key,
+                                   p_hash,
+                                   hash_size,
+                                   p_signature,
+                                   signature_size);
+}
+
+
+ret_code_t nrf_crypto_ecdsa_prepared_key_free(nrf_crypto_ecdsa_prepared_key_t * p_prepared_key)
+{
+    ret_code_t result;
+
+    result = nrf_crypto_internal_ecc_key_input_check(
+        (nrf_crypto_internal_ecc_key_header_t const *)p_prepared_key,
+        NRF_CRYPTO_INTERNAL_ECDSA_PREPARED_KEY_INIT_VALUE);
+    VERIFY_SUCCESS(result);
+
+#if NRF_CRYPTO_BACKEND_ECDSA_PREPARED_KEY_ENABLED
+    if (p_prepared_key->backend_used)
+    {
+        nrf_crypto_backend_ecdsa_prepared_free(&p_prepared_key->backend);
+        p_prepared_key->backend_used = false;
+    }
+#endif
+
+    p_prepared_key->header.init_value = 0;
+
+    return nrf_crypto_ecc_public_key_free(&p_prepared_key->public_key);
+}
+
+
 #endif // NRF_CRYPTO_ECC_ENABLED
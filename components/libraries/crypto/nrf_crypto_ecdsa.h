@@ -66,6 +66,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include "nrf_crypto_error.h"
 #include "nrf_crypto_ecc.h"
@@ -234,6 +235,77 @@ ret_code_t nrf_crypto_ecdsa_verify(
     uint8_t                           const * p_signature,
     size_t                                    signature_size);
 
+
+/** @brief Amount of data precomputed for a prepared public key.
+ *
+ *  Precomputed data trades RAM for faster verification. It is kept only by backends that support
+ *  it, currently mbed TLS. Other backends only keep the public key converted to their format.
+ */
+typedef enum
+{
+    NRF_CRYPTO_ECDSA_PRECOMPUTE_NONE,       /**< @brief Only keep the converted public key. */
+    NRF_CRYPTO_ECDSA_PRECOMPUTE_GENERATOR,  /**< @brief Also keep precomputed multiples of the curve generator. */
+} nrf_crypto_ecdsa_precompute_t;
+
+
+/** @brief Public key prepared for repeated signature verification.
+ */
+typedef struct
+{
+    nrf_crypto_internal_ecc_key_header_t    header;         /**< @internal @brief Common header with the init value of a prepared key. */
+    nrf_crypto_ecc_public_key_t             public_key;     /**< @internal @brief Public key converted to the backend format. */
+    bool                                    backend_used;   /**< @internal @brief True if @ref backend holds precomputed data. */
+    nrf_crypto_backend_ecdsa_prepared_key_t backend;        /**< @internal @brief Backend specific precomputed data. */
+} nrf_crypto_ecdsa_prepared_key_t;
+
+
+/** @brief Prepare a public key for repeated signature verification.
+ *
+ *  The raw public key is converted once and, depending on @p precompute, the backend calculates
+ *  data that is reused by every @ref nrf_crypto_ecdsa_prepared_verify call. Precomputed data is
+ *  allocated by the backend and must be released with @ref nrf_crypto_ecdsa_prepared_key_free.
+ *
+ *  @param[out] p_prepared_key  Pointer to structure where the prepared key will be put.
+ *  @param[in]  p_curve_info    Pointer to information on selected curve.
+ *  @param[in]  p_raw_data      Pointer to buffer containing a big-endian raw public key.
+ *  @param[in]  raw_data_size   Number of bytes in @p p_raw_data.
+ *  @param[in]  precompute      Amount of data to precompute.
+ */
+ret_code_t nrf_crypto_ecdsa_prepared_key_init(
+    nrf_crypto_ecdsa_prepared_key_t       * p_prepared_key,
+    nrf_crypto_ecc_curve_info_t     const * p_curve_info,
+    uint8_t                         const * p_raw_data,
+    size_t                                  raw_data_size,
+    nrf_crypto_ecdsa_precompute_t           precompute);
+
+
+/** @brief Verify a signature using a hash of a message and a prepared public key.
+ *
+ *  @param[in]     p_context       Pointer to temporary structure holding context information.
+ *                                 If it is NULL, necessary data will be allocated with
+ *                                 @ref NRF_CRYPTO_ALLOC and freed at the end of the function.
+ *                                 Not used if the backend keeps precomputed data.
+ *  @param[in]     p_prepared_key  Pointer to structure holding a prepared public key.
+ *  @param[in]     p_hash          Pointer to hash to verify.
+ *  @param[in]     hash_size       Number of bytes in p_hash.
+ *  @param[in]     p_signature     Pointer to buffer containing digital signature.
+ *  @param[in]     signature_size  Number of bytes in p_signature.
+ */
+ret_code_t nrf_crypto_ecdsa_prepared_verify(
+    nrf_crypto_ecdsa_verify_context_t       * p_context,
+    nrf_crypto_ecdsa_prepared_key_t         * p_prepared_key,
+    uint8_t                           const * p_hash,
+    size_t                                    hash_size,
+    uint8_t                           const * p_signature,
+    size_t                                    signature_size);
+
+
+/** @brief Release resources taken by a prepared public key.
+ *
+ *  @param[in]  p_prepared_key  Pointer to structure holding a prepared public key.
+ */
+ret_code_t nrf_crypto_ecdsa_prepared_key_free(nrf_crypto_ecdsa_prepared_key_t * p_prepared_key);
+
 #ifdef __cplusplus
 }
 #endif
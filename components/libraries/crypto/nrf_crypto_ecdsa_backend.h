@@ -242,6 +242,13 @@ typedef uint8_t nrf_crypto_backend_curve25519_verify_context_t;
 #define nrf_crypto_backend_curve25519_verify NULL
 #endif
 
+#if !defined(NRF_CRYPTO_BACKEND_ECDSA_PREPARED_KEY_ENABLED)
+// None of the enabled backends keeps precomputed data for prepared keys
+#define NRF_CRYPTO_BACKEND_ECDSA_PREPARED_KEY_ENABLED 0
+// Dummy typedef for unused backend data
+typedef uint32_t nrf_crypto_backend_ecdsa_prepared_key_t;
+#endif
+
 
 #ifdef __cplusplus
 }
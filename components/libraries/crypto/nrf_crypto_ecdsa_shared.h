@@ -52,6 +52,9 @@ extern "C" {
 #endif
 
 
+#define NRF_CRYPTO_INTERNAL_ECDSA_PREPARED_KEY_INIT_VALUE (0x4D465250) /**< @internal @brief Init value for prepared ECDSA public keys. ASCII "nRFP". */
+
+
 /** @internal @brief Function pointer for backend implementation of ECDSA sign.
  *
  * @note All parameters provided to the backend are vefified in frontend. Verification includes
@@ -96,6 +99,42 @@ typedef ret_code_t (*nrf_crypto_backend_ecdsa_verify_fn_t)(
     uint8_t const * p_signature);
 
 
+/** @internal @brief Function pointer for backend implementation of public key preparation.
+ *
+ * Backend keeps precomputed data in @p p_prepared that speeds up subsequent calls to
+ * @ref nrf_crypto_backend_ecdsa_prepared_verify_fn_t with the same public key.
+ *
+ * @param[out] p_prepared      Pointer to backend specific data of a prepared key.
+ * @param[in]  p_public_key    Pointer to public key.
+ */
+typedef ret_code_t (*nrf_crypto_backend_ecdsa_prepare_fn_t)(
+    void       * p_prepared,
+    void const * p_public_key);
+
+
+/** @internal @brief Function pointer for backend implementation of ECDSA verify with a prepared key.
+ *
+ * @param[in]  p_prepared      Pointer to backend specific data of a prepared key.
+ * @param[in]  p_public_key    Pointer to public key used to prepare @p p_prepared.
+ * @param[in]  p_data          Pointer to hash to verify.
+ * @param[in]  data_size       Size of @p p_data.
+ * @param[in]  p_signature     Pointer to signature to verify.
+ */
+typedef ret_code_t (*nrf_crypto_backend_ecdsa_prepared_verify_fn_t)(
+    void          * p_prepared,
+    void    const * p_public_key,
+    uint8_t const * p_data,
+    size_t          data_size,
+    uint8_t const * p_signature);
+
+
+/** @internal @brief Function pointer for backend implementation of prepared key deallocation.
+ *
+ * @param[in]  p_prepared      Pointer to backend specific data of a prepared key.
+ */
+typedef void (*nrf_crypto_backend_ecdsa_prepared_free_fn_t)(void * p_prepared);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,452 @@
+/**
+ * Copyright (c) 2016 - 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+
+#if NRF_MODULE_ENABLED(NRF_FSTORAGE)
+
+#include "nrf_fstorage_ram.h"
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "nrf_atomic.h"
+
+#if NRF_FSTORAGE_RAM_FILE_SUPPORT
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+
+STATIC_ASSERT((NRF_FSTORAGE_RAM_SIZE % NRF_FSTORAGE_RAM_PAGE_SIZE) == 0);
+
+
+static nrf_fstorage_info_t m_flash_info =
+{
+    .erase_unit   = NRF_FSTORAGE_RAM_PAGE_SIZE,
+    .program_unit = 4,
+    .rmap         = true,
+    .wmap         = false,
+};
+
+
+/* RAM image of the device, used unless a file is mapped. */
+static uint32_t m_image[NRF_FSTORAGE_RAM_SIZE / sizeof(uint32_t)];
+
+/* Contents of the device: either the RAM image or the mapped file. */
+static uint8_t * mp_flash = (uint8_t *)m_image;
+
+/* The RAM image was brought to the erased state. */
+static bool m_image_ready;
+
+/* Erase cycles of each page. */
+static uint32_t m_erase_cnt[NRF_FSTORAGE_RAM_PAGE_CNT];
+
+static nrf_fstorage_ram_stats_t m_stats;
+
+static uint32_t m_write_us = NRF_FSTORAGE_RAM_WRITE_TIME_US;
+static uint32_t m_erase_us = NRF_FSTORAGE_RAM_ERASE_TIME_US;
+
+/* An operation initiated by fstorage is ongoing. */
+static nrf_atomic_flag_t m_flash_operation_ongoing;
+
+#if NRF_FSTORAGE_RAM_FILE_SUPPORT
+/* Descriptor of the mapped file, or -1. */
+static int m_file = -1;
+#endif
+
+
+/* Send event to the event handler. */
+static void event_send(nrf_fstorage_t        const * p_fs,
+                       nrf_fstorage_evt_id_t         evt_id,
+                       ret_code_t                    result,
+                       void const *                  p_src,
+                       uint32_t                      addr,
+                       uint32_t                      len,
+                       void                        * p_param)
+{
+    if (p_fs->evt_handler == NULL)
+    {
+        /* Nothing to do. */
+        return;
+    }
+
+    nrf_fstorage_evt_t evt =
+    {
+        .result  = result,
+        .id      = evt_id,
+        .addr    = addr,
+        .p_src   = p_src,
+        .len     = len,
+        .p_param = p_param,
+    };
+
+    p_fs->evt_handler(&evt);
+}
+
+
+/* Check if a range of device addresses lies within the emulated flash. */
+static bool range_is_valid(uint32_t addr, uint32_t len)
+{
+    return (addr >= NRF_FSTORAGE_RAM_BASE_ADDR)
+        && ((addr - NRF_FSTORAGE_RAM_BASE_ADDR) <= NRF_FSTORAGE_RAM_SIZE)
+        && (len <= NRF_FSTORAGE_RAM_SIZE - (addr - NRF_FSTORAGE_RAM_BASE_ADDR));
+}
+
+
+static ret_code_t init(nrf_fstorage_t * p_fs, void * p_param)
+{
+    UNUSED_PARAMETER(p_param);
+
+    if (!m_image_ready)
+    {
+        /* A new chip comes erased. */
+        memset(m_image, 0xFF, sizeof(m_image));
+        m_image_ready = true;
+    }
+
+    p_fs->p_flash_info = &m_flash_info;
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t uninit(nrf_fstorage_t * p_fs, void * p_param)
+{
+    UNUSED_PARAMETER(p_fs);
+    UNUSED_PARAMETER(p_param);
+
+    (void) nrf_atomic_flag_clear(&m_flash_operation_ongoing);
+
+    return NRF_SUCCESS;
+}
+
+
+/* Named flash_read() and flash_write() to avoid clashing with the POSIX functions. */
+static ret_code_t flash_read(nrf_fstorage_t const * p_fs, uint32_t src, void * p_dest, uint32_t len)
+{
+    UNUSED_PARAMETER(p_fs);
+
+    if (!range_is_valid(src, len))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    memcpy(p_dest, &mp_flash[src - NRF_FSTORAGE_RAM_BASE_ADDR], len);
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t flash_write(nrf_fstorage_t const * p_fs,
+                              uint32_t               dest,
+                              void           const * p_src,
+                              uint32_t               len,
+                              void                 * p_param)
+{
+    ret_code_t       result      = NRF_SUCCESS;
+    uint8_t  const * p_data      = (uint8_t const *)p_src;
+    bool             clears_only = true;
+    uint8_t        * p_flash;
+
+    if (!range_is_valid(dest, len))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    p_flash = &mp_flash[dest - NRF_FSTORAGE_RAM_BASE_ADDR];
+
+    if (nrf_atomic_flag_set_fetch(&m_flash_operation_ongoing))
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if ((p_flash[i] & p_data[i]) != p_data[i])
+        {
+            clears_only = false;
+            break;
+        }
+    }
+
+    if (!clears_only)
+    {
+        m_stats.nor_violations++;
+    }
+
+    if (clears_only || !NRF_FSTORAGE_RAM_STRICT_NOR)
+    {
+        /* Programming can only clear bits. */
+        for (uint32_t i = 0; i < len; i++)
+        {
+            p_flash[i] &= p_data[i];
+        }
+
+        m_stats.writes++;
+        m_stats.bytes_written += len;
+        m_stats.busy_time_us  += (uint64_t)m_write_us * (len / m_flash_info.program_unit);
+    }
+    else
+    {
+        result = NRF_ERROR_INVALID_DATA;
+    }
+
+    /* Clear the flag before sending the event, to allow API calls in the event context. */
+    (void) nrf_atomic_flag_clear(&m_flash_operation_ongoing);
+
+    event_send(p_fs, NRF_FSTORAGE_EVT_WRITE_RESULT, result, p_src, dest, len, p_param);
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t erase(nrf_fstorage_t const * p_fs,
+                        uint32_t               page_addr,
+                        uint32_t               len,
+                        void                 * p_param)
+{
+    uint32_t first_page = (page_addr - NRF_FSTORAGE_RAM_BASE_ADDR) / NRF_FSTORAGE_RAM_PAGE_SIZE;
+
+    /* Bound the number of pages before converting it to bytes, it could overflow otherwise. */
+    if (   !range_is_valid(page_addr, 0)
+        || ((page_addr - NRF_FSTORAGE_RAM_BASE_ADDR) % NRF_FSTORAGE_RAM_PAGE_SIZE)
+        || (len > NRF_FSTORAGE_RAM_PAGE_CNT - first_page))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    if (nrf_atomic_flag_set_fetch(&m_flash_operation_ongoing))
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    memset(&mp_flash[first_page * NRF_FSTORAGE_RAM_PAGE_SIZE], 0xFF, len * NRF_FSTORAGE_RAM_PAGE_SIZE);
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        m_erase_cnt[first_page + i]++;
+    }
+
+    m_stats.erases++;
+    m_stats.pages_erased += len;
+    m_stats.busy_time_us += (uint64_t)m_erase_us * len;
+
+    /* Clear the flag before sending the event, to allow API calls in the event context. */
+    (void) nrf_atomic_flag_clear(&m_flash_operation_ongoing);
+
+    event_send(p_fs, NRF_FSTORAGE_EVT_ERASE_RESULT, NRF_SUCCESS, NULL, page_addr, len, p_param);
+
+    return NRF_SUCCESS;
+}
+
+
+static uint8_t const * rmap(nrf_fstorage_t const * p_fs, uint32_t addr)
+{
+    UNUSED_PARAMETER(p_fs);
+
+    if (!range_is_valid(addr, 1))
+    {
+        return NULL;
+    }
+
+    return &mp_flash[addr - NRF_FSTORAGE_RAM_BASE_ADDR];
+}
+
+
+static uint8_t * wmap(nrf_fstorage_t const * p_fs, uint32_t addr)
+{
+    UNUSED_PARAMETER(p_fs);
+    UNUSED_PARAMETER(addr);
+
+    /* Not supported. Writes must go through fstorage to keep NOR semantics. */
+    return NULL;
+}
+
+
+static bool is_busy(nrf_fstorage_t const * p_fs)
+{
+    UNUSED_PARAMETER(p_fs);
+
+    return m_flash_operation_ongoing;
+}
+
+
+void nrf_fstorage_ram_timing_set(uint32_t write_us, uint32_t erase_us)
+{
+    m_write_us = write_us;
+    m_erase_us = erase_us;
+}
+
+
+void nrf_fstorage_ram_stats_get(nrf_fstorage_ram_stats_t * p_stats)
+{
+    ASSERT(p_stats);
+
+    *p_stats = m_stats;
+}
+
+
+void nrf_fstorage_ram_stats_clear(void)
+{
+    memset(&m_stats, 0, sizeof(m_stats));
+    memset(m_erase_cnt, 0, sizeof(m_erase_cnt));
+}
+
+
+uint32_t const * nrf_fstorage_ram_erase_counts_get(void)
+{
+    return m_erase_cnt;
+}
+
+
+void nrf_fstorage_ram_reset(void)
+{
+    memset(mp_flash, 0xFF, NRF_FSTORAGE_RAM_SIZE);
+
+    if (mp_flash == (uint8_t *)m_image)
+    {
+        m_image_ready = true;
+    }
+}
+
+
+#if NRF_FSTORAGE_RAM_FILE_SUPPORT
+ret_code_t nrf_fstorage_ram_file_open(char const * p_path)
+{
+    off_t     size;
+    uint8_t * p_map;
+
+    if (p_path == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if ((m_file >= 0) || m_flash_operation_ongoing)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    m_file = open(p_path, O_RDWR | O_CREAT, 0644);
+    if (m_file < 0)
+    {
+        return NRF_ERROR_INTERNAL;
+    }
+
+    size = lseek(m_file, 0, SEEK_END);
+    if (size < 0)
+    {
+        goto fail;
+    }
+
+    /* Extend the file with erased flash. */
+    if (size < NRF_FSTORAGE_RAM_SIZE)
+    {
+        uint8_t erased[256];
+        memset(erased, 0xFF, sizeof(erased));
+
+        while (size < NRF_FSTORAGE_RAM_SIZE)
+        {
+            size_t  chunk = MIN(sizeof(erased), (size_t)(NRF_FSTORAGE_RAM_SIZE - size));
+            ssize_t done  = write(m_file, erased, chunk);
+            if (done <= 0)
+            {
+                goto fail;
+            }
+            size += done;
+        }
+    }
+
+    p_map = mmap(NULL, NRF_FSTORAGE_RAM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+    if (p_map == MAP_FAILED)
+    {
+        goto fail;
+    }
+
+    mp_flash = p_map;
+
+    return NRF_SUCCESS;
+
+fail:
+    (void) close(m_file);
+    m_file = -1;
+    return NRF_ERROR_INTERNAL;
+}
+
+
+ret_code_t nrf_fstorage_ram_file_close(void)
+{
+    ret_code_t rc = NRF_SUCCESS;
+
+    if ((m_file < 0) || m_flash_operation_ongoing)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (msync(mp_flash, NRF_FSTORAGE_RAM_SIZE, MS_SYNC) != 0)
+    {
+        rc = NRF_ERROR_INTERNAL;
+    }
+
+    (void) munmap(mp_flash, NRF_FSTORAGE_RAM_SIZE);
+    (void) close(m_file);
+
+    m_file   = -1;
+    mp_flash = (uint8_t *)m_image;
+
+    return rc;
+}
+#endif // NRF_FSTORAGE_RAM_FILE_SUPPORT
+
+
+/* The exported API. */
+nrf_fstorage_api_t nrf_fstorage_ram =
+{
+    .init    = init,
+    .uninit  = uninit,
+    .read    = flash_read,
+    .write   = flash_write,
+    .erase   = erase,
+    .rmap    = rmap,
+    .wmap    = wmap,
+    .is_busy = is_busy
+};
+
+
+#endif // NRF_FSTORAGE_ENABLED
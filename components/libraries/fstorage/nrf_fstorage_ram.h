@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2016 - 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @file
+ *
+ * @defgroup nrf_fstorage_ram RAM implementation
+ * @ingroup nrf_fstorage
+ * @{
+ *
+ * @brief API implementation of fstorage that emulates NOR flash in RAM.
+ *
+ * @details Intended for running and benchmarking flash users (for example FDS or the Peer
+ *          Manager) on a host. The emulated device behaves like the nRF flash:
+ *          - Programming can only clear bits. An erased page reads as 0xFF.
+ *          - Only whole pages can be erased.
+ *
+ *          All instances using this implementation share one emulated device which spans
+ *          @ref NRF_FSTORAGE_RAM_SIZE bytes from @ref NRF_FSTORAGE_RAM_BASE_ADDR. Operations
+ *          complete synchronously and the time they would take on the device is accumulated
+ *          in the statistics. Every page counts its erase cycles.
+ *
+ *          When @ref NRF_FSTORAGE_RAM_FILE_SUPPORT is enabled, the device can be backed by a
+ *          memory mapped file instead, so that its contents persist across runs.
+ */
+
+#ifndef NRF_FSTORAGE_RAM_H__
+#define NRF_FSTORAGE_RAM_H__
+
+#include "sdk_config.h"
+#include "nrf_fstorage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Number of pages of the emulated flash. */
+#define NRF_FSTORAGE_RAM_PAGE_CNT       (NRF_FSTORAGE_RAM_SIZE / NRF_FSTORAGE_RAM_PAGE_SIZE)
+
+
+/**@brief Statistics of the emulated flash. */
+typedef struct
+{
+    uint32_t writes;            //!< Number of write operations.
+    uint32_t bytes_written;     //!< Number of bytes programmed.
+    uint32_t erases;            //!< Number of erase operations.
+    uint32_t pages_erased;      //!< Number of page erase cycles.
+    uint32_t nor_violations;    //!< Number of writes which tried to change a bit from 0 to 1.
+    uint64_t busy_time_us;      //!< Time the device would have spent on writes and erases.
+} nrf_fstorage_ram_stats_t;
+
+
+/**@brief   API implementation that emulates NOR flash in RAM.
+ *
+ * @details An fstorage instance with this API implementation can be initialized by providing
+ *          this structure as a parameter to @ref nrf_fstorage_init.
+ *          The structure is defined in @c nrf_fstorage_ram.c.
+ */
+extern nrf_fstorage_api_t nrf_fstorage_ram;
+
+
+/**@brief Function for setting the modeled operation times.
+ *
+ * @param[in]   write_us    Time needed to program one word (in microseconds).
+ * @param[in]   erase_us    Time needed to erase one page (in microseconds).
+ */
+void nrf_fstorage_ram_timing_set(uint32_t write_us, uint32_t erase_us);
+
+
+/**@brief Function for reading the statistics of the emulated flash.
+ *
+ * @param[out]  p_stats     Statistics collected since the last @ref nrf_fstorage_ram_stats_clear.
+ */
+void nrf_fstorage_ram_stats_get(nrf_fstorage_ram_stats_t * p_stats);
+
+
+/**@brief Function for clearing the statistics, including the per-page erase counters. */
+void nrf_fstorage_ram_stats_clear(void);
+
+
+/**@brief Function for getting the per-page erase counters.
+ *
+ * Counter @c i belongs to the page at address
+ * @ref NRF_FSTORAGE_RAM_BASE_ADDR + @c i * @ref NRF_FSTORAGE_RAM_PAGE_SIZE.
+ *
+ * @return Array of @ref NRF_FSTORAGE_RAM_PAGE_CNT erase counters.
+ */
+uint32_t const * nrf_fstorage_ram_erase_counts_get(void);
+
+
+/**@brief Function for erasing the whole emulated flash.
+ *
+ * Brings the device to the state of a new chip. Counters are not affected.
+ */
+void nrf_fstorage_ram_reset(void);
+
+
+#if NRF_FSTORAGE_RAM_FILE_SUPPORT
+/**@brief Function for backing the emulated flash by a file.
+ *
+ * The file is created if needed and extended to @ref NRF_FSTORAGE_RAM_SIZE bytes. The added
+ * part reads as erased flash. The contents of the RAM image are not copied to the file.
+ *
+ * @param[in]   p_path  Path to the file.
+ *
+ * @retval  NRF_SUCCESS                 If the file was mapped.
+ * @retval  NRF_ERROR_NULL              If @p p_path is NULL.
+ * @retval  NRF_ERROR_INVALID_STATE     If a file is already mapped or an operation is ongoing.
+ * @retval  NRF_ERROR_INTERNAL          If the file could not be opened or mapped.
+ */
+ret_code_t nrf_fstorage_ram_file_open(char const * p_path);
+
+
+/**@brief Function for flushing and unmapping the file backing the emulated flash.
+ *
+ * The emulated flash is backed by the RAM image again.
+ *
+ * @retval  NRF_SUCCESS                 If the file was unmapped.
+ * @retval  NRF_ERROR_INVALID_STATE     If no file is mapped or an operation is ongoing.
+ * @retval  NRF_ERROR_INTERNAL          If the file could not be flushed.
+ */
+ret_code_t nrf_fstorage_ram_file_close(void);
+#endif // NRF_FSTORAGE_RAM_FILE_SUPPORT
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_FSTORAGE_RAM_H__
+/** @} */
@@ -59,6 +59,10 @@
 #error NRF_FSTORAGE_SD_MAX_WRITE_SIZE must be a multiple of the word size.
 #endif
 
+#if (NRF_FSTORAGE_SD_WRITE_COMBINE && (NRF_FSTORAGE_SD_COMBINE_MAX_OPS < 2))
+#error NRF_FSTORAGE_SD_COMBINE_MAX_OPS must allow at least two writes to be combined.
+#endif
+
 
 /**@brief   fstorage operation codes. */
 typedef enum
@@ -114,6 +118,25 @@ typedef struct
 } nrf_fstorage_sd_work_t;
 
 
+#if NRF_FSTORAGE_SD_WRITE_COMBINE
+/**@brief   Writes combined with the current operation. */
+typedef struct
+{
+    nrf_fstorage_sd_op_t  * p_op[NRF_FSTORAGE_SD_COMBINE_MAX_OPS - 1];     //!< Writes following the current operation.
+    nrf_atfifo_item_get_t   iget_ctx[NRF_FSTORAGE_SD_COMBINE_MAX_OPS - 1]; //!< Contexts used to free the writes.
+    uint32_t                cnt;                                           //!< Number of combined writes.
+    uint32_t                len;                                           //!< Total length, including the current operation.
+} nrf_fstorage_sd_combine_t;
+#endif
+
+/**@brief   Pages to erase in the background. */
+typedef struct
+{
+    uint32_t page;                      //!< Next page to erase.
+    uint32_t remaining;                 //!< Number of pages left to erase.
+} nrf_fstorage_sd_erase_ahead_t;
+
+
 void nrf_fstorage_sys_evt_handler(uint32_t, void *);
 bool nrf_fstorage_sdh_req_handler(nrf_sdh_req_evt_t, void *);
 void nrf_fstorage_sdh_state_handler(nrf_sdh_state_evt_t, void *);
@@ -153,6 +176,15 @@ NRF_SDH_STATE_OBSERVER(m_state_obs, 0) =
 static nrf_fstorage_sd_work_t   m_flags;        /* Internal status. */
 static nrf_fstorage_sd_op_t   * m_p_cur_op;     /* The current operation being executed. */
 static nrf_atfifo_item_get_t    m_iget_ctx;     /* Context for nrf_atfifo_item_get() and nrf_atfifo_item_free(). */
+static nrf_fstorage_sd_stats_t  m_stats;        /* Statistics. */
+
+static nrf_fstorage_sd_erase_ahead_t m_erase_ahead;     /* Pages to erase in the background. */
+static nrf_fstorage_sd_op_t          m_erase_ahead_op;  /* Background erase, not on the queue. */
+
+#if NRF_FSTORAGE_SD_WRITE_COMBINE
+static nrf_fstorage_sd_combine_t m_combine;     /* Writes combined with the current operation. */
+static uint32_t                  m_combine_buf[NRF_FSTORAGE_SD_MAX_WRITE_SIZE / sizeof(uint32_t)];
+#endif
 
 
 /* Send events to the application. */
@@ -199,6 +231,16 @@ static uint32_t write_execute(nrf_fstorage_sd_op_t const * p_op)
 {
     uint32_t chunk_len;
 
+#if NRF_FSTORAGE_SD_WRITE_COMBINE
+    if (m_combine.cnt != 0)
+    {
+        /* The data of all combined writes has been staged. It fits in one chunk. */
+        return sd_flash_write((uint32_t*)p_op->write.dest,
+                              m_combine_buf,
+                              m_combine.len / m_flash_info.program_unit);
+    }
+#endif
+
     chunk_len = MIN(p_op->write.len - p_op->write.offset, NRF_FSTORAGE_SD_MAX_WRITE_SIZE);
     chunk_len = MAX(1, chunk_len / m_flash_info.program_unit);
 
@@ -217,6 +259,23 @@ static uint32_t erase_execute(nrf_fstorage_sd_op_t const * p_op)
 }
 
 
+/* Check if a flash page is erased. */
+static bool page_is_erased(uint32_t page)
+{
+    uint32_t const * p_word = (uint32_t*)(page * m_flash_info.erase_unit);
+
+    for (uint32_t i = 0; i < m_flash_info.erase_unit / sizeof(uint32_t); i++)
+    {
+        if (p_word[i] != 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 /* Free the current queue element. */
 static void queue_free(void)
 {
@@ -224,6 +283,172 @@ static void queue_free(void)
 }
 
 
+/* Send the result of the current operation and free its queue element(s). */
+static void op_complete(ret_code_t result)
+{
+    if (m_p_cur_op == &m_erase_ahead_op)
+    {
+        /* Background erases are not on the queue and do not send events. */
+        if (result == NRF_SUCCESS)
+        {
+            m_stats.erases_ahead++;
+        }
+        return;
+    }
+
+    event_send(m_p_cur_op, result);
+
+#if NRF_FSTORAGE_SD_WRITE_COMBINE
+    for (uint32_t i = 0; i < m_combine.cnt; i++)
+    {
+        event_send(m_combine.p_op[i], result);
+    }
+
+    /* The combined writes were read while the current operation was held, so freeing
+     * them does not release any space. It is released when the current operation is freed. */
+    while (m_combine.cnt != 0)
+    {
+        m_combine.cnt--;
+        (void) nrf_atfifo_item_free(m_fifo, &m_combine.iget_ctx[m_combine.cnt]);
+    }
+#endif
+
+    queue_free();
+}
+
+
+/* Cancel the background erase if an operation touches the pages which are still to be erased. */
+static void erase_ahead_trim(uint32_t addr, uint32_t len)
+{
+    uint32_t const first = addr / m_flash_info.erase_unit;
+    uint32_t const last  = (addr + len - 1) / m_flash_info.erase_unit;
+
+    CRITICAL_REGION_ENTER();
+    if (   (m_erase_ahead.remaining != 0)
+        && (first < m_erase_ahead.page + m_erase_ahead.remaining)
+        && (last >= m_erase_ahead.page))
+    {
+        m_erase_ahead.remaining = 0;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+
+/* Load the next page to erase in the background. Pages which are already erased are skipped. */
+static bool erase_ahead_load(void)
+{
+    while (true)
+    {
+        uint32_t page;
+
+        CRITICAL_REGION_ENTER();
+        page = m_erase_ahead.page;
+        if (m_erase_ahead.remaining != 0)
+        {
+            m_erase_ahead.page++;
+            m_erase_ahead.remaining--;
+        }
+        else
+        {
+            page = UINT32_MAX;
+        }
+        CRITICAL_REGION_EXIT();
+
+        if (page == UINT32_MAX)
+        {
+            return false;
+        }
+
+        if (!page_is_erased(page))
+        {
+            memset(&m_erase_ahead_op, 0x00, sizeof(m_erase_ahead_op));
+
+            m_erase_ahead_op.op_code              = NRF_FSTORAGE_OP_ERASE;
+            m_erase_ahead_op.erase.page           = page;
+            m_erase_ahead_op.erase.pages_to_erase = 1;
+
+            m_p_cur_op = &m_erase_ahead_op;
+            return true;
+        }
+    }
+}
+
+
+#if NRF_FSTORAGE_SD_WRITE_COMBINE
+/* Combine the writes waiting on the queue with the current write, if they continue it. */
+static void write_combine(void)
+{
+    uint32_t end = m_p_cur_op->write.dest + m_p_cur_op->write.len;
+
+    m_combine.cnt = 0;
+    m_combine.len = m_p_cur_op->write.len;
+
+    while (m_combine.cnt < ARRAY_SIZE(m_combine.p_op))
+    {
+        nrf_fstorage_sd_op_t const * p_next = nrf_atfifo_item_peek(m_fifo);
+
+        if (   (p_next == NULL)
+            || (p_next->op_code != NRF_FSTORAGE_OP_WRITE)
+            || (p_next->write.dest != end)
+            || (m_combine.len + p_next->write.len > NRF_FSTORAGE_SD_MAX_WRITE_SIZE))
+        {
+            break;
+        }
+
+        m_combine.p_op[m_combine.cnt] = nrf_atfifo_item_get(m_fifo, &m_combine.iget_ctx[m_combine.cnt]);
+        ASSERT(m_combine.p_op[m_combine.cnt] == p_next);
+
+        m_combine.cnt++;
+        m_combine.len += p_next->write.len;
+        end           += p_next->write.len;
+    }
+
+    if (m_combine.cnt != 0)
+    {
+        uint8_t * p_buf = (uint8_t*)m_combine_buf;
+
+        memcpy(p_buf, m_p_cur_op->write.p_src, m_p_cur_op->write.len);
+        p_buf += m_p_cur_op->write.len;
+
+        for (uint32_t i = 0; i < m_combine.cnt; i++)
+        {
+            memcpy(p_buf, m_combine.p_op[i]->write.p_src, m_combine.p_op[i]->write.len);
+            p_buf += m_combine.p_op[i]->write.len;
+        }
+
+        m_stats.ops_combined += m_combine.cnt;
+    }
+}
+#endif
+
+
+/* Prepare an operation loaded from the queue for execution. */
+static void op_prepare(void)
+{
+    switch (m_p_cur_op->op_code)
+    {
+        case NRF_FSTORAGE_OP_WRITE:
+        {
+            uint32_t len = m_p_cur_op->write.len;
+
+#if NRF_FSTORAGE_SD_WRITE_COMBINE
+            write_combine();
+            len = m_combine.len;
+#endif
+            erase_ahead_trim(m_p_cur_op->write.dest, len);
+        } break;
+
+        case NRF_FSTORAGE_OP_ERASE:
+            erase_ahead_trim(m_p_cur_op->erase.page * m_flash_info.erase_unit,
+                             m_p_cur_op->erase.pages_to_erase * m_flash_info.erase_unit);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
 /* Load a new operation from the queue. */
 static bool queue_load_next(void)
 {
@@ -237,10 +462,15 @@ static bool queue_load_next(void)
 static void queue_process(void)
 {
     uint32_t rc;
+    bool     skipped = false;
 
     if (m_flags.state == NRF_FSTORAGE_STATE_IDLE)
     {
-        if (!queue_load_next())
+        if (queue_load_next())
+        {
+            op_prepare();
+        }
+        else if (!erase_ahead_load())
         {
             /* No more operations, nothing to do. */
             m_flags.queue_running = false;
@@ -257,7 +487,17 @@ static void queue_process(void)
             break;
 
         case NRF_FSTORAGE_OP_ERASE:
-            rc = erase_execute(m_p_cur_op);
+            if (page_is_erased(m_p_cur_op->erase.page + m_p_cur_op->erase.progress))
+            {
+                /* Nothing to do, do not spend a flash timeslot. */
+                m_stats.erases_skipped++;
+                skipped = true;
+                rc      = NRF_SUCCESS;
+            }
+            else
+            {
+                rc = erase_execute(m_p_cur_op);
+            }
             break;
 
          default:
@@ -271,8 +511,14 @@ static void queue_process(void)
         {
             /* The operation was accepted by the SoftDevice.
              * If the SoftDevice is enabled, wait for a system event. Otherwise,
-             * the SoftDevice call is synchronous and will not send an event so we simulate it. */
-            if (!m_flags.sd_enabled)
+             * the SoftDevice call is synchronous and will not send an event so we simulate it.
+             * A skipped erase did not involve the SoftDevice at all. */
+            if (!skipped)
+            {
+                m_stats.timeslots++;
+            }
+
+            if (!m_flags.sd_enabled || skipped)
             {
                 nrf_fstorage_sys_evt_handler(NRF_EVT_FLASH_OPERATION_SUCCESS, NULL);
             }
@@ -287,13 +533,12 @@ static void queue_process(void)
 
         default:
         {
-            /* An error has occurred. We cannot proceed further with this operation. */
-            event_send(m_p_cur_op, NRF_ERROR_INTERNAL);
+            /* An error has occurred. We cannot proceed further with this operation.
+             * Send the event and free the current queue element(s). */
+            op_complete(NRF_ERROR_INTERNAL);
             /* Reset the internal state so we can accept other operations. */
             m_flags.state         = NRF_FSTORAGE_STATE_IDLE;
             m_flags.queue_running = false;
-            /* Free the current queue element. */
-            queue_free();
         } break;
     }
 }
@@ -366,6 +611,8 @@ static bool on_operation_failure(nrf_fstorage_sd_op_t const * p_op)
         return true;
     }
 
+    m_stats.retries++;
+
     return false;
 }
 
@@ -397,6 +644,10 @@ static ret_code_t uninit(nrf_fstorage_t * p_fs, void * p_param)
      * The common uninitialization code is run by the caller. */
 
     memset(&m_flags, 0x00, sizeof(m_flags));
+    memset(&m_erase_ahead, 0x00, sizeof(m_erase_ahead));
+#if NRF_FSTORAGE_SD_WRITE_COMBINE
+    memset(&m_combine, 0x00, sizeof(m_combine));
+#endif
 
     (void) nrf_atfifo_clear(m_fifo);
 
@@ -556,13 +807,11 @@ void nrf_fstorage_sys_evt_handler(uint32_t sys_evt, void * p_context)
                  * so that queue_process() will fetch a new operation from the queue. */
                 m_flags.state = NRF_FSTORAGE_STATE_IDLE;
 
-                event_send(m_p_cur_op, (sys_evt == NRF_EVT_FLASH_OPERATION_SUCCESS) ?
-                                        NRF_SUCCESS : NRF_ERROR_TIMEOUT);
-
-                /* Free the queue element after sending out the event to prevent API calls made
+                /* The queue element is freed after sending out the event to prevent API calls made
                  * in the event context to queue elements indefinitely, without this function
                  * ever returning in case the SoftDevice calls are synchronous. */
-                queue_free();
+                op_complete((sys_evt == NRF_EVT_FLASH_OPERATION_SUCCESS) ?
+                            NRF_SUCCESS : NRF_ERROR_TIMEOUT);
             }
         } break;
     }
@@ -607,6 +856,62 @@ void nrf_fstorage_sdh_state_handler(nrf_sdh_state_evt_t state, void * p_context)
 }
 
 
+ret_code_t nrf_fstorage_sd_erase_ahead(nrf_fstorage_t const * p_fs, uint32_t page_addr, uint32_t len)
+{
+    if (p_fs == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    if ((p_fs->p_api != &nrf_fstorage_sd) || !m_flags.initialized)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (len != 0)
+    {
+        /* Bound the number of pages before converting it to bytes, it could overflow otherwise. */
+        if (   (page_addr % m_flash_info.erase_unit)
+            || (page_addr < p_fs->start_addr)
+            || (page_addr > p_fs->end_addr)
+            || (len > (p_fs->end_addr - page_addr + 1) / m_flash_info.erase_unit))
+        {
+            return NRF_ERROR_INVALID_ADDR;
+        }
+    }
+
+    CRITICAL_REGION_ENTER();
+    m_erase_ahead.page      = page_addr / m_flash_info.erase_unit;
+    m_erase_ahead.remaining = len;
+    CRITICAL_REGION_EXIT();
+
+    if (len != 0)
+    {
+        queue_start();
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void nrf_fstorage_sd_stats_get(nrf_fstorage_sd_stats_t * p_stats)
+{
+    ASSERT(p_stats);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_stats;
+    CRITICAL_REGION_EXIT();
+}
+
+
+void nrf_fstorage_sd_stats_clear(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(&m_stats, 0x00, sizeof(m_stats));
+    CRITICAL_REGION_EXIT();
+}
+
+
 /* Exported API implementation. */
 nrf_fstorage_api_t nrf_fstorage_sd =
 {
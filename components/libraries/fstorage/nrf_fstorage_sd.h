@@ -63,10 +63,61 @@ extern "C" {
  * @details An fstorage instance with this API implementation can be initialized by providing
  *          this structure as a parameter to @ref nrf_fstorage_init.
  *          The structure is defined in @c nrf_fstorage_sd.c.
+ *
+ *          If @c NRF_FSTORAGE_SD_WRITE_COMBINE is set, queued writes to contiguous addresses are
+ *          combined into one SoftDevice flash operation of up to
+ *          @c NRF_FSTORAGE_SD_MAX_WRITE_SIZE bytes, at most @c NRF_FSTORAGE_SD_COMBINE_MAX_OPS
+ *          writes at a time. Each write still gets its own event.
  */
 extern nrf_fstorage_api_t nrf_fstorage_sd;
 
 
+/**@brief   Statistics of the SoftDevice implementation. */
+typedef struct
+{
+    uint32_t timeslots;         //!< Number of flash operations accepted by the SoftDevice, including retries.
+    uint32_t retries;           //!< Number of flash operations retried after a timeout.
+    uint32_t ops_combined;      //!< Number of queued writes which were combined into the preceding write.
+    uint32_t erases_skipped;    //!< Number of page erases skipped because the page was already erased.
+    uint32_t erases_ahead;      //!< Number of pages erased in the background by @ref nrf_fstorage_sd_erase_ahead.
+} nrf_fstorage_sd_stats_t;
+
+
+/**@brief   Function for erasing flash pages in the background.
+ *
+ * @details The pages are erased one by one while the operation queue is empty, so that
+ *          requested operations are not delayed by more than one page erase. Pages which are
+ *          already erased are skipped. A later @ref nrf_fstorage_erase of a page erased this
+ *          way completes without using a SoftDevice flash timeslot.
+ *
+ *          The pages must not hold any data that is still needed. Any requested operation which
+ *          touches the pages cancels the rest of the background erase. No events are sent.
+ *          Only one range is erased in the background at a time; a new call replaces the range.
+ *
+ * @param[in]   p_fs        The fstorage instance.
+ * @param[in]   page_addr   Address of the first page to erase.
+ * @param[in]   len         Number of pages to erase. Zero cancels the background erase.
+ *
+ * @retval  NRF_SUCCESS             If the range was accepted.
+ * @retval  NRF_ERROR_NULL          If @p p_fs is NULL.
+ * @retval  NRF_ERROR_INVALID_STATE If @p p_fs is not initialized with this implementation.
+ * @retval  NRF_ERROR_INVALID_ADDR  If the range is unaligned or outside the boundaries of @p p_fs.
+ */
+ret_code_t nrf_fstorage_sd_erase_ahead(nrf_fstorage_t const * p_fs, uint32_t page_addr, uint32_t len);
+
+
+/**@brief   Function for reading the statistics.
+ *
+ * @param[out]  p_stats     Statistics collected since initialization or the last
+ *                          @ref nrf_fstorage_sd_stats_clear.
+ */
+void nrf_fstorage_sd_stats_get(nrf_fstorage_sd_stats_t * p_stats);
+
+
+/**@brief   Function for clearing the statistics. */
+void nrf_fstorage_sd_stats_clear(void);
+
+
 #ifdef __cplusplus
 }
 #endif
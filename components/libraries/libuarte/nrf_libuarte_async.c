@@ -46,6 +46,7 @@
 #include "nrfx_ppi.h"
 #include "nrf_uart.h"
 #include "nrf_queue.h"
+#include "app_util_platform.h"
 #define NRF_LOG_MODULE_NAME libUARTE_async
 #if NRF_LIBUARTE_CONFIG_LOG_ENABLED
 #define NRF_LOG_LEVEL       NRF_LIBUARTE_CONFIG_LOG_LEVEL
@@ -167,9 +168,84 @@ static uint32_t app_timer_us_to_ticks(uint32_t us)
                       1000000);
 }
 
+/* @brief Function for reserving the next chunk of the RX ring for the receiver.
+ *
+ * Chunks are handed out in the ring order, so the data received into consecutive chunks is
+ * contiguous in memory (apart from the wrap).
+ *
+ * @return Pointer to the chunk or NULL if the unreleased data leaves no room for it.
+ */
+static uint8_t * ring_chunk_reserve(const nrf_libuarte_async_t * p_libuarte)
+{
+    nrf_libuarte_async_ctrl_blk_t * p_ctrl_blk = p_libuarte->p_ctrl_blk;
+
+    if (p_ctrl_blk->ring_used + p_libuarte->rx_buf_size > p_ctrl_blk->ring_size)
+    {
+        return NULL;
+    }
+
+    uint8_t * p_data = &p_ctrl_blk->p_ring[p_ctrl_blk->ring_wr];
+    p_ctrl_blk->ring_wr = (p_ctrl_blk->ring_wr + p_libuarte->rx_buf_size) % p_ctrl_blk->ring_size;
+    p_ctrl_blk->ring_used += p_libuarte->rx_buf_size;
+
+    return p_data;
+}
+
+/* @brief Function for updating RTS according to the ring fill level and the watermarks. */
+static void ring_rts_update(const nrf_libuarte_async_t * p_libuarte)
+{
+    nrf_libuarte_async_ctrl_blk_t * p_ctrl_blk = p_libuarte->p_ctrl_blk;
+
+    if (!p_ctrl_blk->hwfc || (p_ctrl_blk->rx_high_wm == 0))
+    {
+        return;
+    }
+
+    /* libuarte_drv holds RTS inactive after rts_set until rts_clear is called. */
+    if (!p_ctrl_blk->rts_paused && (p_ctrl_blk->ring_pending >= p_ctrl_blk->rx_high_wm))
+    {
+        p_ctrl_blk->rts_paused = true;
+        nrf_libuarte_drv_rts_set(p_libuarte->p_libuarte);
+        NRF_LOG_DEBUG("RX ring above high watermark (%d), RTS deasserted.",
+                      p_ctrl_blk->ring_pending);
+    }
+    else if (p_ctrl_blk->rts_paused && (p_ctrl_blk->ring_pending <= p_ctrl_blk->rx_low_wm))
+    {
+        p_ctrl_blk->rts_paused = false;
+        nrf_libuarte_drv_rts_clear(p_libuarte->p_libuarte);
+        NRF_LOG_DEBUG("RX ring below low watermark (%d), RTS asserted.",
+                      p_ctrl_blk->ring_pending);
+    }
+}
+
+/* @brief Function for marking data written to the ring by the receiver as available. */
+static void ring_commit(const nrf_libuarte_async_t * p_libuarte, size_t length)
+{
+    if (p_libuarte->p_ctrl_blk->rx_ring)
+    {
+        p_libuarte->p_ctrl_blk->ring_pending += length;
+        ring_rts_update(p_libuarte);
+    }
+}
+
+/* @brief Function for getting the number of unreleased bytes that can be consumed in order. */
+static uint32_t ring_available(nrf_libuarte_async_ctrl_blk_t const * p_ctrl_blk)
+{
+    return (p_ctrl_blk->ring_gap_len != 0) ? p_ctrl_blk->ring_gap_before : p_ctrl_blk->ring_pending;
+}
+
+static uint8_t * rx_buffer_alloc(const nrf_libuarte_async_t * p_libuarte)
+{
+    if (p_libuarte->p_ctrl_blk->rx_ring)
+    {
+        return ring_chunk_reserve(p_libuarte);
+    }
+    return nrf_balloc_alloc(p_libuarte->p_rx_pool);
+}
+
 static bool rx_buffer_schedule(const nrf_libuarte_async_t * p_libuarte)
 {
-    uint8_t * p_data = nrf_balloc_alloc(p_libuarte->p_rx_pool);
+    uint8_t * p_data = rx_buffer_alloc(p_libuarte);
 
     if (p_data == NULL)
     {
@@ -199,6 +275,15 @@ static void uart_evt_handler(void * context, nrf_libuarte_drv_evt_t * p_evt)
     case NRF_LIBUARTE_DRV_EVT_TX_DONE:
     {
         NRF_LOG_DEBUG("(evt) TX completed (%d)", p_evt->data.rxtx.length);
+
+        /* Start the next queued buffer before notifying the user to keep the gap short. */
+        nrf_libuarte_async_data_t next;
+        if (nrf_queue_pop(p_libuarte->p_tx_queue, &next) == NRF_SUCCESS)
+        {
+            ret = nrf_libuarte_drv_tx(p_libuarte->p_libuarte, next.p_data, next.length);
+            APP_ERROR_CHECK_BOOL(ret == NRF_SUCCESS);
+        }
+
         nrf_libuarte_async_evt_t evt = {
             .type = NRF_LIBUARTE_ASYNC_EVT_TX_DONE,
             .data = {
@@ -267,6 +352,7 @@ static void uart_evt_handler(void * context, nrf_libuarte_drv_evt_t * p_evt)
                 APP_ERROR_CHECK_BOOL(false);
             }
 
+            ring_commit(p_libuarte, rx_amount);
             p_libuarte->p_ctrl_blk->evt_handler(p_libuarte->p_ctrl_blk->context, &evt);
         }
         else
@@ -293,6 +379,21 @@ static void uart_evt_handler(void * context, nrf_libuarte_drv_evt_t * p_evt)
         NRF_LOG_WARNING("Overrun error - data loss due to UARTE interrupt not handled on time.");
         uint32_t rx_amount = p_evt->data.overrun_err.overrun_length - p_libuarte->p_ctrl_blk->sub_rx_count;
         p_libuarte->p_ctrl_blk->rx_count += rx_amount;
+
+        if (p_libuarte->p_ctrl_blk->rx_ring)
+        {
+            /* The receiver skipped the chunk following the completed one. It is released
+             * automatically once the data received before it is released. */
+            if (p_libuarte->p_ctrl_blk->ring_gap_len != 0)
+            {
+                NRF_LOG_ERROR("Overrun with a previous one not consumed yet.");
+                APP_ERROR_CHECK_BOOL(false);
+            }
+            p_libuarte->p_ctrl_blk->ring_gap_before = p_libuarte->p_ctrl_blk->ring_pending;
+            p_libuarte->p_ctrl_blk->ring_gap_len    = p_libuarte->rx_buf_size;
+            UNUSED_RETURN_VALUE(nrf_queue_pop(p_libuarte->p_rx_queue,
+                                              &p_libuarte->p_ctrl_blk->p_curr_rx_buf));
+        }
         nrf_libuarte_async_evt_t evt = {
             .type = NRF_LIBUARTE_ASYNC_EVT_OVERRUN_ERROR,
             .data = {
@@ -333,6 +434,7 @@ void nrf_libuarte_async_timeout_handler(const nrf_libuarte_async_t * p_libuarte)
 
         p_libuarte->p_ctrl_blk->sub_rx_count += rx_amount;
         p_libuarte->p_ctrl_blk->rx_count = capt_rx_count;
+        ring_commit(p_libuarte, rx_amount);
         p_libuarte->p_ctrl_blk->evt_handler(p_libuarte->p_ctrl_blk->context, &evt);
     }
 
@@ -403,6 +505,45 @@ ret_code_t nrf_libuarte_async_init(const nrf_libuarte_async_t * const p_libuarte
         return NRF_ERROR_INVALID_STATE;
     }
 
+    if (p_config->rx_ring)
+    {
+        /* The ring is laid over the pool memory, which is contiguous only without
+         * balloc debug guards. */
+        if (p_libuarte->p_rx_pool->block_size != p_libuarte->rx_buf_size)
+        {
+            NRF_LOG_ERROR("RX ring requires pool blocks without debug overhead.");
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        uint32_t ring_size = p_libuarte->rx_buf_size *
+                             (p_libuarte->p_rx_pool->p_stack_limit - p_libuarte->p_rx_pool->p_stack_base);
+        /* The driver holds two chunks, the one being received and the next one, and the chunk at
+         * the read position is reused only when released completely. The next chunk is requested
+         * before the completed one is reported, so above ring_size minus three chunks the ring
+         * runs out of chunks before RTS is deasserted. */
+        uint32_t rx_wm_max = (ring_size > 3 * p_libuarte->rx_buf_size) ?
+                             (ring_size - 3 * p_libuarte->rx_buf_size) : 0;
+        if ((p_config->rx_high_wm != 0) &&
+            ((p_config->rx_high_wm > rx_wm_max) || (p_config->rx_low_wm >= p_config->rx_high_wm)))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        p_libuarte->p_ctrl_blk->p_ring    = p_libuarte->p_rx_pool->p_memory_begin;
+        p_libuarte->p_ctrl_blk->ring_size = ring_size;
+    }
+
+    p_libuarte->p_ctrl_blk->rx_ring         = p_config->rx_ring;
+    p_libuarte->p_ctrl_blk->rx_high_wm      = p_config->rx_high_wm;
+    p_libuarte->p_ctrl_blk->rx_low_wm       = p_config->rx_low_wm;
+    p_libuarte->p_ctrl_blk->ring_rd         = 0;
+    p_libuarte->p_ctrl_blk->ring_wr         = 0;
+    p_libuarte->p_ctrl_blk->ring_used       = 0;
+    p_libuarte->p_ctrl_blk->ring_pending    = 0;
+    p_libuarte->p_ctrl_blk->ring_gap_before = 0;
+    p_libuarte->p_ctrl_blk->ring_gap_len    = 0;
+    p_libuarte->p_ctrl_blk->rts_paused      = false;
+
     p_libuarte->p_ctrl_blk->evt_handler  = evt_handler;
     p_libuarte->p_ctrl_blk->rx_count     = 0;
     p_libuarte->p_ctrl_blk->p_curr_rx_buf = NULL;
@@ -540,6 +681,7 @@ ret_code_t nrf_libuarte_async_init(const nrf_libuarte_async_t * const p_libuarte
     }
 
     nrf_queue_reset(p_libuarte->p_rx_queue);
+    nrf_queue_reset(p_libuarte->p_tx_queue);
     p_libuarte->p_ctrl_blk->enabled = true;
 
     return ret;
@@ -584,12 +726,13 @@ void nrf_libuarte_async_uninit(const nrf_libuarte_async_t * const p_libuarte)
     }
 
     nrf_libuarte_drv_uninit(p_libuarte->p_libuarte);
+    nrf_queue_reset(p_libuarte->p_tx_queue);
 }
 
 void nrf_libuarte_async_enable(const nrf_libuarte_async_t * const p_libuarte)
 {
     uint8_t * p_data;
-    p_data = nrf_balloc_alloc(p_libuarte->p_rx_pool);
+    p_data = rx_buffer_alloc(p_libuarte);
     p_libuarte->p_ctrl_blk->alloc_cnt++;
     if (p_data == NULL)
     {
@@ -629,11 +772,106 @@ void nrf_libuarte_async_enable(const nrf_libuarte_async_t * const p_libuarte)
 
 ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte, uint8_t * p_data, size_t length)
 {
-    return nrf_libuarte_drv_tx(p_libuarte->p_libuarte, p_data, length);
+    ret_code_t ret = NRF_ERROR_BUSY;
+    nrf_libuarte_async_data_t tx = {
+        .p_data = p_data,
+        .length = length
+    };
+
+    /* TX done handler pops the queue from the interrupt. */
+    CRITICAL_REGION_ENTER();
+    if (nrf_queue_is_empty(p_libuarte->p_tx_queue))
+    {
+        ret = nrf_libuarte_drv_tx(p_libuarte->p_libuarte, p_data, length);
+    }
+    if (ret == NRF_ERROR_BUSY)
+    {
+        ret = (nrf_queue_push(p_libuarte->p_tx_queue, &tx) == NRF_SUCCESS) ?
+              NRF_SUCCESS : NRF_ERROR_BUSY;
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
+ret_code_t nrf_libuarte_async_rx_get(const nrf_libuarte_async_t * const p_libuarte,
+                                     uint8_t ** pp_data, size_t * p_length)
+{
+    nrf_libuarte_async_ctrl_blk_t * p_ctrl_blk = p_libuarte->p_ctrl_blk;
+
+    if (!p_ctrl_blk->rx_ring)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    CRITICAL_REGION_ENTER();
+    *pp_data  = &p_ctrl_blk->p_ring[p_ctrl_blk->ring_rd];
+    *p_length = MIN(ring_available(p_ctrl_blk), p_ctrl_blk->ring_size - p_ctrl_blk->ring_rd);
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_libuarte_async_rx_release(const nrf_libuarte_async_t * const p_libuarte,
+                                         size_t length)
+{
+    nrf_libuarte_async_ctrl_blk_t * p_ctrl_blk = p_libuarte->p_ctrl_blk;
+    ret_code_t ret = NRF_SUCCESS;
+
+    if (!p_ctrl_blk->rx_ring)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (length > ring_available(p_ctrl_blk))
+    {
+        ret = NRF_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        p_ctrl_blk->ring_rd       = (p_ctrl_blk->ring_rd + length) % p_ctrl_blk->ring_size;
+        p_ctrl_blk->ring_pending -= length;
+        p_ctrl_blk->ring_used    -= length;
+
+        if (p_ctrl_blk->ring_gap_len != 0)
+        {
+            p_ctrl_blk->ring_gap_before -= length;
+            if (p_ctrl_blk->ring_gap_before == 0)
+            {
+                p_ctrl_blk->ring_rd   = (p_ctrl_blk->ring_rd + p_ctrl_blk->ring_gap_len) %
+                                        p_ctrl_blk->ring_size;
+                p_ctrl_blk->ring_used -= p_ctrl_blk->ring_gap_len;
+                p_ctrl_blk->ring_gap_len = 0;
+            }
+        }
+
+        ring_rts_update(p_libuarte);
+
+        if (p_ctrl_blk->rx_halted &&
+            (p_ctrl_blk->ring_used + p_libuarte->rx_buf_size <= p_ctrl_blk->ring_size))
+        {
+            p_ctrl_blk->rx_halted = false;
+            bool scheduled = rx_buffer_schedule(p_libuarte);
+            ASSERT(scheduled);
+            UNUSED_VARIABLE(scheduled);
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
 }
 
 void nrf_libuarte_async_rx_free(const nrf_libuarte_async_t * const p_libuarte, uint8_t * p_data, size_t length)
 {
+    if (p_libuarte->p_ctrl_blk->rx_ring)
+    {
+        ASSERT(p_data == &p_libuarte->p_ctrl_blk->p_ring[p_libuarte->p_ctrl_blk->ring_rd]);
+        ret_code_t ret = nrf_libuarte_async_rx_release(p_libuarte, length);
+        APP_ERROR_CHECK_BOOL(ret == NRF_SUCCESS);
+        return;
+    }
+
     p_libuarte->p_ctrl_blk->rx_free_cnt += length;
     if (p_libuarte->p_ctrl_blk->rx_free_cnt == p_libuarte->rx_buf_size)
     {
@@ -129,6 +129,12 @@ typedef struct
     nrf_uarte_baudrate_t baudrate;   ///< Baudrate.
     bool                 pullup_rx;  ///< Pull up on RX pin.
     uint8_t              int_prio;   ///< Interrupt priority of UARTE (RTC, TIMER have int_prio - 1)
+    bool                 rx_ring;    ///< Receive into a contiguous ring, see @ref nrf_libuarte_async_rx_get.
+    uint32_t             rx_high_wm; ///< Number of unreleased bytes in the ring at which RTS is
+                                     ///< deasserted. 0 to disable. Used only with flow control.
+                                     ///< At most the ring size minus three RX buffers.
+    uint32_t             rx_low_wm;  ///< Number of unreleased bytes in the ring at which RTS is
+                                     ///< asserted again. Must be lower than @p rx_high_wm.
 } nrf_libuarte_async_config_t;
 
 /**
@@ -144,9 +150,21 @@ typedef struct {
     uint8_t * p_curr_rx_buf;
     uint32_t rx_free_cnt;
     uint32_t timeout_us;
+    uint8_t * p_ring;
+    uint32_t ring_size;
+    uint32_t ring_rd;
+    uint32_t ring_wr;
+    uint32_t ring_used;
+    uint32_t ring_pending;
+    uint32_t ring_gap_before;
+    uint32_t ring_gap_len;
+    uint32_t rx_high_wm;
+    uint32_t rx_low_wm;
     bool app_timer_created;
     bool hwfc;
     bool rx_halted;
+    bool rx_ring;
+    bool rts_paused;
     bool enabled;
 } nrf_libuarte_async_ctrl_blk_t;
 
@@ -162,6 +180,7 @@ typedef struct {
 typedef struct {
 	const nrf_balloc_t * p_rx_pool;
 	const nrf_queue_t * p_rx_queue;
+	const nrf_queue_t * p_tx_queue;
 	const nrfx_rtc_t * p_rtc;
 	const nrfx_timer_t * p_timer;
 #if NRF_LIBUARTE_ASYNC_WITH_APP_TIMER
@@ -229,7 +248,8 @@ void nrf_libuarte_async_timeout_handler(const nrf_libuarte_async_t * p_libuarte)
  *                     _rx_buf_size bytes is received.
  * @param _rx_buf_cnt  Number of buffers in the RX buffer pool. Size impacts accepted latency
  *                     between NRF_LIBUARTE_ASYNC_EVT_RX_DATA event and
- *                     @ref nrf_libuarte_async_rx_free.
+ *                     @ref nrf_libuarte_async_rx_free. In the RX ring mode, the buffers form
+ *                     a ring of _rx_buf_size * _rx_buf_cnt bytes.
  */
 #define NRF_LIBUARTE_ASYNC_DEFINE(_name, _uarte_idx, _timer0_idx,\
                                   _rtc1_idx, _timer1_idx,\
@@ -241,6 +261,8 @@ void nrf_libuarte_async_timeout_handler(const nrf_libuarte_async_t * p_libuarte)
                     "App timer support disabled");\
       NRF_LIBUARTE_DRV_DEFINE(CONCAT_2(_name, _libuarte), _uarte_idx, _timer0_idx);\
       NRF_QUEUE_DEF(uint8_t *, CONCAT_2(_name,_rxdata_queue), _rx_buf_cnt, NRF_QUEUE_MODE_NO_OVERFLOW);\
+      NRF_QUEUE_DEF(nrf_libuarte_async_data_t, CONCAT_2(_name,_txdata_queue), \
+                    NRF_LIBUARTE_ASYNC_TX_QUEUE_SIZE, NRF_QUEUE_MODE_NO_OVERFLOW);\
       NRF_BALLOC_DEF(CONCAT_2(_name,_rx_pool), _rx_buf_size, _rx_buf_cnt);\
       /* Create TIMER instance only if _timer1_idx != NRF_LIBUARTE_PERIPHERAL_NOT_USED */ \
       _LIBUARTE_ASYNC_EVAL(\
@@ -269,6 +291,7 @@ void nrf_libuarte_async_timeout_handler(const nrf_libuarte_async_t * p_libuarte)
       static const nrf_libuarte_async_t _name = {\
               .p_rx_pool = &CONCAT_2(_name,_rx_pool),\
               .p_rx_queue =  &CONCAT_2(_name,_rxdata_queue),\
+              .p_tx_queue =  &CONCAT_2(_name,_txdata_queue),\
               /* If p_rtc is not NULL it means that RTC is used for RX timeout */ \
               .p_rtc = _LIBUARTE_ASYNC_EVAL(NRFX_CONCAT_3(NRFX_RTC, _rtc1_idx, _ENABLED), (&CONCAT_2(_name, _rtc)), (NULL)),\
               /* If p_timer is not NULL it means that RTC is used for RX timeout */ \
@@ -356,16 +379,19 @@ void nrf_libuarte_async_rts_set(const nrf_libuarte_async_t * const p_libuarte);
 /**
  * @brief Function for sending data asynchronously over UARTE.
  *
+ * If a transfer is ongoing, the buffer is queued and sent as soon as the previous one
+ * completes. Every buffer is reported with its own @ref NRF_LIBUARTE_ASYNC_EVT_TX_DONE event.
+ *
  * @param[in] p_libuarte Libuarte_async instance.
- * @param[in] p_data  Pointer to data.
+ * @param[in] p_data  Pointer to data. Must stay valid until the TX done event.
  * @param[in] length  Number of bytes to send. Maximum possible length is
  *                    dependent on the used SoC (see the MAXCNT register
  *                    description in the Product Specification). The library
  *                    checks it with assertion.
  *
- * @retval NRF_ERROR_BUSY      Data is transferring.
+ * @retval NRF_ERROR_BUSY      TX queue is full.
  * @retval NRF_ERROR_INTERNAL  Error during configuration.
- * @retval NRF_SUCCESS         Buffer set for sending.
+ * @retval NRF_SUCCESS         Buffer set or queued for sending.
  */
 ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte,
                                  uint8_t * p_data, size_t length);
@@ -373,6 +399,9 @@ ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte,
 /**
  * @brief Function for deallocating received buffer data.
  *
+ * In the RX ring mode, data must be freed in the order in which it was received and this
+ * function is equivalent to @ref nrf_libuarte_async_rx_release.
+ *
  * @param[in] p_libuarte Libuarte_async instance.
  * @param[in] p_data  Pointer to data.
  * @param[in] length  Number of bytes to free.
@@ -380,6 +409,41 @@ ret_code_t nrf_libuarte_async_tx(const nrf_libuarte_async_t * const p_libuarte,
 void nrf_libuarte_async_rx_free(const nrf_libuarte_async_t * const p_libuarte,
                                 uint8_t * p_data, size_t length);
 
+/**
+ * @brief Function for getting received data in the RX ring mode.
+ *
+ * The data is not copied. The function returns the oldest received data that has not been
+ * released yet, up to the end of the ring. Data received after the wrap is returned by the
+ * next call, once the returned part is released. Data is reported with
+ * @ref NRF_LIBUARTE_ASYNC_EVT_RX_DATA events as well; the events only notify and may be
+ * ignored by a consumer that uses this function.
+ *
+ * @param[in]  p_libuarte Libuarte_async instance.
+ * @param[out] pp_data    Pointer to the data.
+ * @param[out] p_length   Number of contiguous bytes available. 0 if there is no data.
+ *
+ * @retval NRF_SUCCESS             Data returned.
+ * @retval NRF_ERROR_INVALID_STATE Instance is not in the RX ring mode.
+ */
+ret_code_t nrf_libuarte_async_rx_get(const nrf_libuarte_async_t * const p_libuarte,
+                                     uint8_t ** pp_data, size_t * p_length);
+
+/**
+ * @brief Function for releasing received data in the RX ring mode.
+ *
+ * Released space is given back to the receiver. If flow control is enabled and the number of
+ * unreleased bytes drops to the low watermark, RTS is asserted again.
+ *
+ * @param[in] p_libuarte Libuarte_async instance.
+ * @param[in] length     Number of bytes to release, starting from the oldest one.
+ *
+ * @retval NRF_SUCCESS             Data released.
+ * @retval NRF_ERROR_INVALID_STATE Instance is not in the RX ring mode.
+ * @retval NRF_ERROR_INVALID_PARAM More data is released than was received.
+ */
+ret_code_t nrf_libuarte_async_rx_release(const nrf_libuarte_async_t * const p_libuarte,
+                                         size_t length);
+
 /** @} */
 
 #endif //UART_ASYNC_H
@@ -78,7 +78,7 @@ extern "C" {
 @endverbatim
  *
  */
-#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(uint32_t)
+#define NRF_MEMOBJ_STD_HEADER_SIZE sizeof(void *)
 
 /**
  * @brief Macro for creating an nrf_memobj pool.
@@ -281,6 +281,75 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
     return status;
 }
 
+/**@brief Get the index of the back element. The queue must not be empty.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ *
+ * @return      Back element index.
+ */
+__STATIC_INLINE size_t nrf_queue_back_idx(nrf_queue_t const * p_queue)
+{
+    size_t back = p_queue->p_cb->back;
+
+    return (back == 0) ? p_queue->size : (back - 1);
+}
+
+ret_code_t nrf_queue_peek_back(nrf_queue_t const * p_queue, void * p_element)
+{
+    ret_code_t status = NRF_SUCCESS;
+
+    ASSERT(p_queue      != NULL);
+    ASSERT(p_element    != NULL);
+
+    CRITICAL_REGION_ENTER();
+
+    if (!nrf_queue_is_empty(p_queue))
+    {
+        memcpy(p_element,
+               (void const *)((size_t)p_queue->p_buffer +
+                              nrf_queue_back_idx(p_queue) * p_queue->element_size),
+               p_queue->element_size);
+    }
+    else
+    {
+        status = NRF_ERROR_NOT_FOUND;
+    }
+
+    CRITICAL_REGION_EXIT();
+    NRF_LOG_INST_DEBUG(p_queue->p_log, "peeked back element 0x%08X, status:%d", p_element, status);
+    return status;
+}
+
+ret_code_t nrf_queue_compare_replace_back(nrf_queue_t const * p_queue,
+                                          void const *        p_expected,
+                                          void const *        p_element)
+{
+    ret_code_t status = NRF_SUCCESS;
+
+    ASSERT(p_queue      != NULL);
+    ASSERT(p_expected   != NULL);
+    ASSERT(p_element    != NULL);
+
+    CRITICAL_REGION_ENTER();
+
+    void * p_back = (void *)((size_t)p_queue->p_buffer +
+                             nrf_queue_back_idx(p_queue) * p_queue->element_size);
+
+    if (!nrf_queue_is_empty(p_queue) &&
+        (memcmp(p_back, p_expected, p_queue->element_size) == 0))
+    {
+        memcpy(p_back, p_element, p_queue->element_size);
+    }
+    else
+    {
+        status = NRF_ERROR_NOT_FOUND;
+    }
+
+    CRITICAL_REGION_EXIT();
+    NRF_LOG_INST_DEBUG(p_queue->p_log, "compare-replaced back element 0x%08X, status:%d", p_element, status);
+    return status;
+}
+
 /* Purpose of this function is to provide number of continous bytes in the queue's
  * array before circullar buffer needs to wrapp.
  */
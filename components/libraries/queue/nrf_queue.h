@@ -360,6 +360,38 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
  */
 #define nrf_queue_peek(_p_queue, _p_element) nrf_queue_generic_pop((_p_queue), (_p_element), true)
 
+/**@brief Function for peeking the element at the back of the queue.
+ *
+ * The back element is the one that was pushed most recently.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[out]  p_element           Pointer where the element will be copied.
+ *
+ * @return      NRF_SUCCESS         If an element was returned.
+ * @return      NRF_ERROR_NOT_FOUND If there are no elements in the queue.
+ */
+ret_code_t nrf_queue_peek_back(nrf_queue_t const * p_queue, void * p_element);
+
+/**@brief Function for replacing the element at the back of the queue if it is still the expected
+ *        one.
+ *
+ * The comparison and the replacement are done in one critical region, so an element that was
+ * peeked with @ref nrf_queue_peek_back is replaced only if it was neither popped nor followed by
+ * another element in the meantime. The replaced element keeps its position in the queue. If it
+ * is not replaced, the caller can push the element instead.
+ *
+ * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
+ * @param[in]   p_expected          Pointer to the expected back element, compared byte by byte.
+ * @param[in]   p_element           Pointer to the element that will replace the back element.
+ *
+ * @return      NRF_SUCCESS         If the back element was replaced.
+ * @return      NRF_ERROR_NOT_FOUND If the queue is empty or its back element is not the expected
+ *                                  one.
+ */
+ret_code_t nrf_queue_compare_replace_back(nrf_queue_t const * p_queue,
+                                          void const *        p_expected,
+                                          void const *        p_element);
+
 /**@brief Function for writing elements to the queue.
  *
  * @param[in]   p_queue             Pointer to the nrf_queue_t instance.
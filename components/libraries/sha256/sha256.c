@@ -38,6 +38,7 @@
  *
  */
 #include <stdlib.h>
+#include <string.h>
 #include "sha256.h"
 #include "sdk_errors.h"
 #include "sdk_common.h"
@@ -53,6 +54,32 @@
 #define SIG0(x) (ROTRIGHT(x,7) ^ ROTRIGHT(x,18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x,17) ^ ROTRIGHT(x,19) ^ ((x) >> 10))
 
+// Message schedule kept in a rolling window of 16 words.
+#define SCHEDULE(m,i) ((m)[(i) & 15] += SIG1((m)[((i) - 2) & 15]) + (m)[((i) - 7) & 15] + \
+                                        SIG0((m)[((i) - 15) & 15]))
+
+// One round. Instead of shifting the working variables, the callers rotate the arguments.
+#define ROUND(a,b,c,d,e,f,g,h,i,w)                          \
+    do {                                                    \
+        uint32_t t1 = (h) + EP1(e) + CH(e,f,g) + k[i] + (w); \
+        (d) += t1;                                          \
+        (h)  = t1 + EP0(a) + MAJ(a,b,c);                    \
+    } while (0)
+
+#define ROUNDS_8(i,W)                                       \
+    do {                                                    \
+        ROUND(a,b,c,d,e,f,g,h,(i) + 0,W(m,(i) + 0));        \
+        ROUND(h,a,b,c,d,e,f,g,(i) + 1,W(m,(i) + 1));        \
+        ROUND(g,h,a,b,c,d,e,f,(i) + 2,W(m,(i) + 2));        \
+        ROUND(f,g,h,a,b,c,d,e,(i) + 3,W(m,(i) + 3));        \
+        ROUND(e,f,g,h,a,b,c,d,(i) + 4,W(m,(i) + 4));        \
+        ROUND(d,e,f,g,h,a,b,c,(i) + 5,W(m,(i) + 5));        \
+        ROUND(c,d,e,f,g,h,a,b,(i) + 6,W(m,(i) + 6));        \
+        ROUND(b,c,d,e,f,g,h,a,(i) + 7,W(m,(i) + 7));        \
+    } while (0)
+
+#define MSG(m,i) ((m)[i])
+
 
 static const uint32_t k[64] = {
     0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
@@ -73,12 +100,22 @@ static const uint32_t k[64] = {
  */
 void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
 {
-    uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+    uint32_t a, b, c, d, e, f, g, h, i, m[16];
 
-    for (i = 0, j = 0; i < 16; ++i, j += 4)
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-    for ( ; i < 64; ++i)
-        m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+    if (((uintptr_t)data & 0x03) == 0)
+    {
+        // Word loads, e.g. when hashing straight from flash.
+        const uint32_t * p_words = (const uint32_t *)data;
+
+        for (i = 0; i < 16; ++i)
+            m[i] = __REV(p_words[i]);
+    }
+    else
+    {
+        for (i = 0; i < 16; ++i, data += 4)
+            m[i] = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+                   ((uint32_t)data[2] << 8)  |  (uint32_t)data[3];
+    }
 
     a = ctx->state[0];
     b = ctx->state[1];
@@ -89,18 +126,10 @@ void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
     g = ctx->state[6];
     h = ctx->state[7];
 
-    for (i = 0; i < 64; ++i) {
-        t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-        t2 = EP0(a) + MAJ(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
-    }
+    for (i = 0; i < 16; i += 8)
+        ROUNDS_8(i, MSG);
+    for ( ; i < 64; i += 8)
+        ROUNDS_8(i, SCHEDULE);
 
     ctx->state[0] += a;
     ctx->state[1] += b;
@@ -140,18 +169,31 @@ ret_code_t sha256_update(sha256_context_t *ctx, const uint8_t * data, size_t len
         return NRF_ERROR_NULL;
     }
 
-    uint32_t i;
+    size_t chunk;
 
-    for (i = 0; i < len; ++i) {
-        ctx->data[ctx->datalen] = data[i];
-        ctx->datalen++;
-        if (ctx->datalen == 64) {
-            sha256_transform(ctx, ctx->data);
-            ctx->bitlen += 512;
-            ctx->datalen = 0;
-        }
+    // Complete a partially filled block first.
+    if (ctx->datalen > 0) {
+        chunk = MIN(len, 64 - ctx->datalen);
+        memcpy(&ctx->data[ctx->datalen], data, chunk);
+        ctx->datalen += chunk;
+        data         += chunk;
+        len          -= chunk;
+        if (ctx->datalen < 64)
+            return NRF_SUCCESS;
+        sha256_transform(ctx, ctx->data);
+        ctx->bitlen += 512;
+        ctx->datalen = 0;
+    }
+
+    // Hash whole blocks without copying them.
+    for ( ; len >= 64; data += 64, len -= 64) {
+        sha256_transform(ctx, data);
+        ctx->bitlen += 512;
     }
 
+    memcpy(ctx->data, data, len);
+    ctx->datalen = len;
+
     return NRF_SUCCESS;
 }
 
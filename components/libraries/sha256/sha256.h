@@ -92,6 +92,11 @@ ret_code_t sha256_init(sha256_context_t *ctx);
  * @details This function can be called multiple times in sequence. This is equivalent to calling
  *          the function once on a concatenation of the data from the different calls.
  *
+ *          Whole 64-byte blocks are hashed directly from @p data, so hashing a large buffer (for
+ *          example a firmware image in flash) does not copy it. Only the bytes that do not make up a
+ *          whole block are buffered in the instance. Passing word-aligned data in multiples of
+ *          64 bytes is the fastest way to use this function.
+ *
  * @param[in,out] ctx   Hash instance.
  * @param[in]     data  Data to be hashed.
  * @param[in]     len   Length of the data to be hashed.
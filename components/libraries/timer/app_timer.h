@@ -139,6 +139,10 @@ typedef struct
     nrf_sortlist_item_t         list_item;     /**< Token used by sortlist. */
     uint64_t                    end_val;       /**< RTC counter value when timer expires. */
     uint32_t                    repeat_period; /**< Repeat period (0 if single shot mode). */
+    uint32_t                    slack;         /**< Number of ticks the timer may expire ahead of end_val. */
+#if APP_TIMER_CONFIG_USE_HEAP
+    uint16_t                    heap_idx;      /**< Position of the timer in the heap. */
+#endif
     app_timer_timeout_handler_t handler;       /**< User handler. */
     void *                      p_context;     /**< User context. */
     NRF_LOG_INSTANCE_PTR_DECLARE(p_log)        /**< Pointer to instance of the logger object (Conditionally compiled). */
@@ -288,6 +292,39 @@ uint32_t app_timer_cnt_diff_compute(uint32_t   ticks_to,
  */
 uint8_t app_timer_op_queue_utilization_get(void);
 
+#ifdef APP_TIMER_V2
+/**@brief Wakeup statistics. */
+typedef struct
+{
+    uint32_t wakeups;   /**< Number of RTC compare events that expired a timer. */
+    uint32_t coalesced; /**< Number of timers expired ahead of time together with another timer.
+                             Each of them is a wakeup that did not have to happen. */
+} app_timer_wakeup_stats_t;
+
+/**@brief Function for setting the tolerance of a timer.
+ *
+ * When another timer expires, a timer that is due within its slack expires in the same RTC
+ * interrupt instead of requesting a separate wakeup. Timers never expire later than requested,
+ * only up to @p slack_ticks earlier. For repeated timers the period is kept relative to the
+ * nominal expiry time, so early expiries do not accumulate drift. Slack of a repeated timer is
+ * limited to one tick less than its period.
+ *
+ * @param[in] timer_id    Timer identifier.
+ * @param[in] slack_ticks Number of ticks the timer may expire ahead of time. Zero disables coalescing.
+ */
+void app_timer_slack_set(app_timer_id_t timer_id, uint32_t slack_ticks);
+
+/**@brief Function for reading wakeup statistics.
+ *
+ * @param[out] p_stats Statistics collected since @ref app_timer_init or the last
+ *                     @ref app_timer_wakeup_stats_clear.
+ */
+void app_timer_wakeup_stats_get(app_timer_wakeup_stats_t * p_stats);
+
+/**@brief Function for clearing wakeup statistics. */
+void app_timer_wakeup_stats_clear(void);
+#endif // APP_TIMER_V2
+
 /**
  * @brief Function for pausing RTC activity which drives app_timer.
  *
@@ -41,13 +41,12 @@
 #include "nrf_atfifo.h"
 #include "nrf_sortlist.h"
 #include "nrf_delay.h"
-#if APP_TIMER_WITH_PROFILER
 #include "app_util_platform.h"
-#endif
 #if APP_TIMER_CONFIG_USE_SCHEDULER
 #include "app_scheduler.h"
 #endif
 #include <stddef.h>
+#include <string.h>
 #define NRF_LOG_MODULE_NAME APP_TIMER_LOG_NAME
 #if APP_TIMER_CONFIG_LOG_ENABLED
 #define NRF_LOG_LEVEL       APP_TIMER_CONFIG_LOG_LEVEL
@@ -100,12 +99,21 @@ static bool                   m_global_active; /**< Flag used to globally disabl
 static uint64_t m_base_counter;
 static uint64_t m_stamp64;
 
+static app_timer_wakeup_stats_t m_wakeup_stats; /**< Wakeup and coalescing counters. */
+
 /* Request FIFO instance. */
 NRF_ATFIFO_DEF(m_req_fifo, timer_req_t, APP_TIMER_CONFIG_OP_QUEUE_SIZE);
 
+#if APP_TIMER_CONFIG_USE_HEAP
+STATIC_ASSERT(APP_TIMER_CONFIG_HEAP_SIZE <= UINT16_MAX);
+
+static app_timer_t * m_heap[APP_TIMER_CONFIG_HEAP_SIZE]; /**< Binary min-heap of queued timers ordered by end value. */
+static uint16_t      m_heap_cnt;                         /**< Number of timers in the heap. */
+#else
 /* Sortlist instance. */
 static bool compare_func(nrf_sortlist_item_t * p_item0, nrf_sortlist_item_t *p_item1);
 NRF_SORTLIST_DEF(m_app_timer_sortlist, compare_func); /**< Sortlist used for storing queued timers. */
+#endif
 
 /**
  * @brief Return current 64 bit timestamp
@@ -124,6 +132,116 @@ static uint64_t get_now(void)
 
     return now;
 }
+
+#if APP_TIMER_CONFIG_USE_HEAP
+static inline void heap_place(uint32_t idx, app_timer_t * p_timer)
+{
+    m_heap[idx]       = p_timer;
+    p_timer->heap_idx = (uint16_t)idx;
+}
+
+/**
+ * @brief Function for moving a timer towards the root until its parent expires no later.
+ *
+ * @param idx     Free slot where the timer is initially placed.
+ * @param p_timer Timer instance.
+ */
+static void heap_sift_up(uint32_t idx, app_timer_t * p_timer)
+{
+    while (idx > 0)
+    {
+        uint32_t parent = (idx - 1) / 2;
+        if (m_heap[parent]->end_val <= p_timer->end_val)
+        {
+            break;
+        }
+        heap_place(idx, m_heap[parent]);
+        idx = parent;
+    }
+    heap_place(idx, p_timer);
+}
+
+/**
+ * @brief Function for moving a timer towards the leaves until its children expire no earlier.
+ *
+ * @param idx     Free slot where the timer is initially placed.
+ * @param p_timer Timer instance.
+ */
+static void heap_sift_down(uint32_t idx, app_timer_t * p_timer)
+{
+    while (1)
+    {
+        uint32_t child = 2 * idx + 1;
+        if (child >= m_heap_cnt)
+        {
+            break;
+        }
+        if ((child + 1 < m_heap_cnt) && (m_heap[child + 1]->end_val < m_heap[child]->end_val))
+        {
+            child++;
+        }
+        if (p_timer->end_val <= m_heap[child]->end_val)
+        {
+            break;
+        }
+        heap_place(idx, m_heap[child]);
+        idx = child;
+    }
+    heap_place(idx, p_timer);
+}
+
+static void queue_add(app_timer_t * p_timer)
+{
+    if (m_heap_cnt == APP_TIMER_CONFIG_HEAP_SIZE)
+    {
+        /* If assert fails it suggests that APP_TIMER_CONFIG_HEAP_SIZE should be increased. */
+        NRF_LOG_INST_ERROR(p_timer->p_log, "Heap full, timer dropped.");
+        ASSERT(0);
+        p_timer->active = false;
+        return;
+    }
+    heap_sift_up(m_heap_cnt++, p_timer);
+}
+
+static bool queue_remove(app_timer_t * p_timer)
+{
+    uint32_t idx = p_timer->heap_idx;
+
+    if ((idx >= m_heap_cnt) || (m_heap[idx] != p_timer))
+    {
+        return false;
+    }
+
+    app_timer_t * p_last = m_heap[--m_heap_cnt];
+    if (idx < m_heap_cnt)
+    {
+        if ((idx > 0) && (p_last->end_val < m_heap[(idx - 1) / 2]->end_val))
+        {
+            heap_sift_up(idx, p_last);
+        }
+        else
+        {
+            heap_sift_down(idx, p_last);
+        }
+    }
+    return true;
+}
+
+static inline app_timer_t * queue_peek(void)
+{
+    return m_heap_cnt ? m_heap[0] : NULL;
+}
+
+static inline app_timer_t * queue_pop(void)
+{
+    app_timer_t * p_timer = queue_peek();
+    if (p_timer)
+    {
+        UNUSED_RETURN_VALUE(queue_remove(p_timer));
+    }
+    return p_timer;
+}
+#else
 /**
  * @brief Function used for comparing items in sorted list.
  */
@@ -137,6 +255,29 @@ static inline bool compare_func(nrf_sortlist_item_t * p_item0, nrf_sortlist_item
     return (p0_end <= p1_end) ? true : false;
 }
 
+static inline void queue_add(app_timer_t * p_timer)
+{
+    nrf_sortlist_add(&m_app_timer_sortlist, &p_timer->list_item);
+}
+
+static inline bool queue_remove(app_timer_t * p_timer)
+{
+    return nrf_sortlist_remove(&m_app_timer_sortlist, &p_timer->list_item);
+}
+
+static inline app_timer_t * queue_pop(void)
+{
+    nrf_sortlist_item_t * p_next_item = nrf_sortlist_pop(&m_app_timer_sortlist);
+    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
+}
+
+static inline app_timer_t * queue_peek(void)
+{
+    nrf_sortlist_item_t const * p_next_item = nrf_sortlist_peek(&m_app_timer_sortlist);
+    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
+}
+#endif // APP_TIMER_CONFIG_USE_HEAP
+
 #if APP_TIMER_CONFIG_USE_SCHEDULER
 static void scheduled_timeout_handler(void * p_event_data, uint16_t event_size)
 {
@@ -154,17 +295,18 @@ static void scheduled_timeout_handler(void * p_event_data, uint16_t event_size)
  * is in repeated mode then timer is rescheduled.
  *
  * @param p_timer Timer instance.
+ * @param slack   Number of ticks the timer is allowed to expire ahead of its end value.
  *
  * @return True if reevaluation of sortlist needed (becasue it was updated).
  */
-static bool timer_expire(app_timer_t * p_timer)
+static bool timer_expire(app_timer_t * p_timer, uint32_t slack)
 {
     ASSERT(p_timer->handler);
     bool ret = false;
 
     if ((m_global_active == true) && (p_timer != NULL) && (p_timer->active))
     {
-        if (get_now() >= p_timer->end_val) {
+        if (get_now() + slack >= p_timer->end_val) {
             /* timer expired */
             if (p_timer->repeat_period == 0)
             {
@@ -187,13 +329,13 @@ static bool timer_expire(app_timer_t * p_timer)
             if ((p_timer->repeat_period) && (p_timer->active))
             {
                 p_timer->end_val += p_timer->repeat_period;
-                nrf_sortlist_add(&m_app_timer_sortlist, &p_timer->list_item);
+                queue_add(p_timer);
                 ret = true;
             }
         }
         else
         {
-            nrf_sortlist_add(&m_app_timer_sortlist, &p_timer->list_item);
+            queue_add(p_timer);
             ret = true;
         }
     }
@@ -237,7 +379,7 @@ static bool rtc_schedule(app_timer_t * p_timer, bool * p_rerun)
 
     if (ret == NRF_ERROR_TIMEOUT)
     {
-        *p_rerun = timer_expire(p_timer);
+        *p_rerun = timer_expire(p_timer, 0);
     }
     else
     {
@@ -248,18 +390,6 @@ static bool rtc_schedule(app_timer_t * p_timer, bool * p_rerun)
     return false;
 }
 
-static inline app_timer_t * sortlist_pop(void)
-{
-    nrf_sortlist_item_t * p_next_item = nrf_sortlist_pop(&m_app_timer_sortlist);
-    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
-}
-
-static inline app_timer_t * sortlist_peek(void)
-{
-    nrf_sortlist_item_t const * p_next_item = nrf_sortlist_peek(&m_app_timer_sortlist);
-    return p_next_item ? CONTAINER_OF(p_next_item, app_timer_t, list_item) : NULL;
-}
-
 /**
  * @brief Function for deactivating all timers which are in the sorted list (active timers).
  */
@@ -268,7 +398,7 @@ static void sorted_list_stop_all(void)
     app_timer_t * p_next;
     do
     {
-        p_next = sortlist_pop();
+        p_next = queue_pop();
         if (p_next)
         {
             p_next->active = false;
@@ -287,6 +417,43 @@ static void on_overflow_evt(void)
     m_base_counter += (DRV_RTC_MAX_CNT + 1);
 }
 
+/**
+ * @brief Function for expiring queued timers which are due within their slack.
+ *
+ * Called after the active timer expired, while the CPU is awake anyway. Only the head of the
+ * queue is examined, so a timer with slack is coalesced once all timers due before it have expired.
+ */
+static void slack_expire(void)
+{
+    uint64_t      now    = get_now();
+    app_timer_t * p_next = queue_peek();
+
+    while (p_next && p_next->slack)
+    {
+        uint32_t slack = p_next->slack;
+        if (p_next->repeat_period && (slack >= p_next->repeat_period))
+        {
+            /* Repeated timer would be expired again in the same interrupt. */
+            slack = p_next->repeat_period - 1;
+        }
+
+        if (now + slack < p_next->end_val)
+        {
+            break;
+        }
+
+        p_next = queue_pop();
+        if (p_next->end_val > now)
+        {
+            NRF_LOG_INST_DEBUG(p_next->p_log, "Coalesced (%d ticks early).",
+                               (uint32_t)(p_next->end_val - now));
+            m_wakeup_stats.coalesced++;
+        }
+        UNUSED_RETURN_VALUE(timer_expire(p_next, slack));
+        p_next = queue_peek();
+    }
+}
+
 /**
  * #brief Function for handling RTC compare event - active timer expiration.
  */
@@ -299,8 +466,10 @@ static void on_compare_evt(drv_rtc_t const * const  p_instance)
                                           drv_rtc_compare_get(p_instance, 0)) < APP_TIMER_SAFE_WINDOW);
 
         NRF_LOG_INST_DEBUG(mp_active_timer->p_log, "Compare EVT");
-        UNUSED_RETURN_VALUE(timer_expire(mp_active_timer));
+        m_wakeup_stats.wakeups++;
+        UNUSED_RETURN_VALUE(timer_expire(mp_active_timer, 0));
         mp_active_timer = NULL;
+        slack_expire();
     }
     else
     {
@@ -328,7 +497,7 @@ static void rtc_update(drv_rtc_t const * const  p_instance)
 {
     while(1)
     {
-        app_timer_t * p_next = sortlist_peek();
+        app_timer_t * p_next = queue_peek();
         bool rtc_reconf = false;
         if (p_next) //Candidate for active timer
         {
@@ -345,14 +514,14 @@ static void rtc_update(drv_rtc_t const * const  p_instance)
                 if (mp_active_timer->active)
                 {
                     NRF_LOG_INST_DEBUG(mp_active_timer->p_log, "Timer preempted.");
-                    nrf_sortlist_add(&m_app_timer_sortlist, &mp_active_timer->list_item);
+                    queue_add(mp_active_timer);
                 }
             }
 
             if (rtc_reconf)
             {
                 bool rerun;
-                p_next = sortlist_pop();
+                p_next = queue_pop();
                 NRF_LOG_INST_DEBUG(p_next->p_log, "Activating timer (CC:%d/%08x).", p_next->end_val, p_next->end_val);
                 if (rtc_schedule(p_next, &rerun))
                 {
@@ -410,7 +579,7 @@ static void timer_req_process(drv_rtc_t const * const  p_instance)
                 if (!p_req->p_timer->active)
                 {
                     p_req->p_timer->active = true;
-                    nrf_sortlist_add(&m_app_timer_sortlist, &(p_req->p_timer->list_item));
+                    queue_add(p_req->p_timer);
                     NRF_LOG_INST_DEBUG(p_req->p_timer->p_log,"Start request (expiring at %d/0x%08x).",
                                                   p_req->p_timer->end_val, p_req->p_timer->end_val);
                 }
@@ -422,7 +591,7 @@ static void timer_req_process(drv_rtc_t const * const  p_instance)
                 }
                 else
                 {
-                    bool found = nrf_sortlist_remove(&m_app_timer_sortlist, &(p_req->p_timer->list_item));
+                    bool found = queue_remove(p_req->p_timer);
                     if (!found)
                     {
                          NRF_LOG_INFO("Timer not found on sortlist (stopping expired timer).");
@@ -432,6 +601,11 @@ static void timer_req_process(drv_rtc_t const * const  p_instance)
                 break;
             case TIMER_REQ_STOP_ALL:
                 sorted_list_stop_all();
+                if (mp_active_timer)
+                {
+                    mp_active_timer->active = false;
+                    mp_active_timer = NULL;
+                }
                 m_global_active = true;
                 NRF_LOG_INFO("Stop all request.");
                 break;
@@ -608,6 +782,27 @@ ret_code_t app_timer_stop_all(void)
     return timer_req_schedule(TIMER_REQ_STOP_ALL, NULL);
 }
 
+void app_timer_slack_set(app_timer_t * p_timer, uint32_t slack_ticks)
+{
+    ASSERT(p_timer);
+    p_timer->slack = slack_ticks;
+}
+
+void app_timer_wakeup_stats_get(app_timer_wakeup_stats_t * p_stats)
+{
+    ASSERT(p_stats);
+    CRITICAL_REGION_ENTER();
+    *p_stats = m_wakeup_stats;
+    CRITICAL_REGION_EXIT();
+}
+
+void app_timer_wakeup_stats_clear(void)
+{
+    CRITICAL_REGION_ENTER();
+    memset(&m_wakeup_stats, 0, sizeof(m_wakeup_stats));
+    CRITICAL_REGION_EXIT();
+}
+
 #if APP_TIMER_WITH_PROFILER
 uint8_t app_timer_op_queue_utilization_get(void)
 {
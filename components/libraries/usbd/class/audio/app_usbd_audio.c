@@ -64,6 +64,9 @@ STATIC_ASSERT(sizeof(app_usbd_audio_as_endpoint_desc_t) == 7);
 #define APP_USBD_AUDIO_STREAMING_IFACE_IDX  1 /**< Audio class streaming interface index */
 
 #define APP_USBD_CDC_AUDIO_STREAMING_EP_IDX 0 /**< Audio streaming isochronous endpoint index */
+#define APP_USBD_AUDIO_FEEDBACK_EP_IDX      1 /**< Audio streaming feedback endpoint index */
+
+#define APP_USBD_AUDIO_FEEDBACK_EP_SIZE     3 /**< Feedback endpoint packet size (10.14 format) */
 
 /**
  * @brief Auxiliary function to access audio class instance data.
@@ -427,6 +430,63 @@ static ret_code_t setup_event_handler(
 }
 
 
+/**
+ * @brief Auxiliary function to access isochronous endpoint address.
+ *
+ * @param[in] p_inst Class instance data.
+ *
+ * @return ISO endpoint address.
+ */
+static inline nrf_drv_usbd_ep_t ep_iso_addr_get(app_usbd_class_inst_t const * p_inst)
+{
+    app_usbd_class_iface_conf_t const * class_iface;
+
+    class_iface = app_usbd_class_iface_get(p_inst, APP_USBD_AUDIO_STREAMING_IFACE_IDX);
+
+    app_usbd_class_ep_conf_t const * ep_cfg;
+    ep_cfg = app_usbd_class_iface_ep_get(class_iface, APP_USBD_CDC_AUDIO_STREAMING_EP_IDX);
+
+    return app_usbd_class_ep_address_get(ep_cfg);
+}
+
+
+/**
+ * @brief Auxiliary function to check if the streaming interface has a feedback endpoint.
+ *
+ * @param[in] p_inst Class instance data.
+ *
+ * @return True if the feedback endpoint is configured.
+ */
+static inline bool ep_feedback_present(app_usbd_class_inst_t const * p_inst)
+{
+    app_usbd_class_iface_conf_t const * class_iface;
+
+    class_iface = app_usbd_class_iface_get(p_inst, APP_USBD_AUDIO_STREAMING_IFACE_IDX);
+
+    return app_usbd_class_iface_ep_count_get(class_iface) > APP_USBD_AUDIO_FEEDBACK_EP_IDX;
+}
+
+
+/**
+ * @brief Auxiliary function to access feedback endpoint address.
+ *
+ * @param[in] p_inst Class instance data.
+ *
+ * @return Feedback endpoint address.
+ */
+static inline nrf_drv_usbd_ep_t ep_feedback_addr_get(app_usbd_class_inst_t const * p_inst)
+{
+    app_usbd_class_iface_conf_t const * class_iface;
+
+    class_iface = app_usbd_class_iface_get(p_inst, APP_USBD_AUDIO_STREAMING_IFACE_IDX);
+
+    app_usbd_class_ep_conf_t const * ep_cfg;
+    ep_cfg = app_usbd_class_iface_ep_get(class_iface, APP_USBD_AUDIO_FEEDBACK_EP_IDX);
+
+    return app_usbd_class_ep_address_get(ep_cfg);
+}
+
+
 /**
  * @brief Endpoint IN event handler.
  *
@@ -459,24 +519,6 @@ static ret_code_t endpoint_out_event_handler(app_usbd_class_inst_t const * p_ins
 }
 
 
-/**
- * @brief Auxiliary function to access isochronous endpoint address.
- *
- * @param[in] p_inst Class instance data.
- *
- * @return ISO endpoint address.
- */
-static inline nrf_drv_usbd_ep_t ep_iso_addr_get(app_usbd_class_inst_t const * p_inst)
-{
-    app_usbd_class_iface_conf_t const * class_iface;
-
-    class_iface = app_usbd_class_iface_get(p_inst, APP_USBD_AUDIO_STREAMING_IFACE_IDX);
-
-    app_usbd_class_ep_conf_t const * ep_cfg;
-    ep_cfg = app_usbd_class_iface_ep_get(class_iface, APP_USBD_CDC_AUDIO_STREAMING_EP_IDX);
-
-    return app_usbd_class_ep_address_get(ep_cfg);
-}
 
 
 /**
@@ -501,6 +543,12 @@ static ret_code_t audio_event_handler(
             break;
 
         case APP_USBD_EVT_DRV_EPTRANSFER:
+            if (ep_feedback_present(p_inst) &&
+                (p_event->drv_evt.data.eptransfer.ep == ep_feedback_addr_get(p_inst)))
+            {
+                /* Feedback is sent by the class, nothing to report */
+                break;
+            }
             if (NRF_USBD_EPIN_CHECK(p_event->drv_evt.data.eptransfer.ep))
             {
                 ret = endpoint_in_event_handler(p_inst);
@@ -784,14 +832,43 @@ static bool audio_feed_descriptors(app_usbd_class_descriptor_ctx_t * p_ctx,
     APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_ENDPOINT); // bDescriptorType = Endpoint
 
     static app_usbd_class_ep_conf_t const * p_cur_ep = NULL;
-    p_cur_ep = app_usbd_class_iface_ep_get(p_cur_iface, 0);
+    p_cur_ep = app_usbd_class_iface_ep_get(p_cur_iface, APP_USBD_CDC_AUDIO_STREAMING_EP_IDX);
     APP_USBD_CLASS_DESCRIPTOR_WRITE(app_usbd_class_ep_address_get(p_cur_ep)); // bEndpointAddress
-    APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_EP_ATTR_TYPE_ISOCHRONOUS); // bmAttributes
+    if (ep_feedback_present(p_inst))
+    {
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_EP_ATTR_TYPE_ISOCHRONOUS |
+                                        APP_USBD_DESCRIPTOR_EP_ATTR_SYNC_ASYNCHRONOUS); // bmAttributes
+    }
+    else
+    {
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_EP_ATTR_TYPE_ISOCHRONOUS); // bmAttributes
+    }
     APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(p_audio->specific.inst.ep_size)); // wMaxPacketSize LSB
     APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(p_audio->specific.inst.ep_size)); // wMaxPacketSize MSB
     APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01); // bInterval
     APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bRefresh
-    APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bSynchAddress
+    if (ep_feedback_present(p_inst))
+    {
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(ep_feedback_addr_get(p_inst)); // bSynchAddress
+    }
+    else
+    {
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bSynchAddress
+    }
+
+    if (ep_feedback_present(p_inst))
+    {
+        /* FEEDBACK ENDPOINT DESCRIPTOR */
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x09); // bLength
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_ENDPOINT); // bDescriptorType = Endpoint
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(ep_feedback_addr_get(p_inst)); // bEndpointAddress
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_DESCRIPTOR_EP_ATTR_TYPE_ISOCHRONOUS); // bmAttributes
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(LSB_16(APP_USBD_AUDIO_FEEDBACK_EP_SIZE)); // wMaxPacketSize LSB
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(MSB_16(APP_USBD_AUDIO_FEEDBACK_EP_SIZE)); // wMaxPacketSize MSB
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x01); // bInterval
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(APP_USBD_AUDIO_FEEDBACK_REFRESH); // bRefresh
+        APP_USBD_CLASS_DESCRIPTOR_WRITE(0x00); // bSynchAddress
+    }
 
     APP_USBD_CLASS_DESCRIPTOR_END();
 }
@@ -847,6 +924,38 @@ ret_code_t app_usbd_audio_class_tx_start(
     return app_usbd_ep_transfer(ep_addr, &transfer);
 }
 
+ret_code_t app_usbd_audio_feedback_send(app_usbd_class_inst_t const * p_inst,
+                                        uint32_t                      feedback)
+{
+    app_usbd_audio_t const * p_audio     = audio_get(p_inst);
+    app_usbd_audio_ctx_t   * p_audio_ctx = audio_ctx_get(p_audio);
+
+    if (!ep_feedback_present(p_inst))
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    nrf_drv_usbd_ep_t ep_addr = ep_feedback_addr_get(p_inst);
+    ASSERT(NRF_USBD_EPISO_CHECK(ep_addr));
+
+    if (!p_audio_ctx->streaming)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (nrf_drv_usbd_ep_is_busy(ep_addr))
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    p_audio_ctx->feedback[0] = (uint8_t)(feedback);
+    p_audio_ctx->feedback[1] = (uint8_t)(feedback >> 8);
+    p_audio_ctx->feedback[2] = (uint8_t)(feedback >> 16);
+
+    NRF_DRV_USBD_TRANSFER_IN(transfer, p_audio_ctx->feedback, APP_USBD_AUDIO_FEEDBACK_EP_SIZE);
+    return app_usbd_ep_transfer(ep_addr, &transfer);
+}
+
 ret_code_t app_usbd_audio_sof_interrupt_register(app_usbd_class_inst_t const * p_inst, 
                                                  app_usbd_sof_interrupt_handler_t handler)
 {
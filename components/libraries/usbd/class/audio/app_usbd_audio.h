@@ -323,6 +323,26 @@ ret_code_t app_usbd_audio_class_tx_start(
     const void * p_buff,
     size_t size);
 
+/**
+ * @brief Send the sample rate feedback value to the host.
+ *
+ * Used by asynchronous OUT streams configured with @ref APP_USBD_AUDIO_CONFIG_OUT_FEEDBACK.
+ * The value is the number of samples the device consumes per frame in 10.14 fixed point
+ * format (see @ref app_usbd_audio_stream_feedback_get).
+ *
+ * @param p_inst   Base class instance.
+ * @param feedback Feedback value in 10.14 format.
+ *
+ * @retval NRF_SUCCESS             Feedback transfer started.
+ * @retval NRF_ERROR_NOT_SUPPORTED No feedback endpoint is configured.
+ * @retval NRF_ERROR_INVALID_STATE Streaming interface is not active.
+ * @retval NRF_ERROR_BUSY          Previous feedback value was not yet collected by the host.
+ *
+ * @note This function should be called in reaction to a SOF event.
+ */
+ret_code_t app_usbd_audio_feedback_send(app_usbd_class_inst_t const * p_inst,
+                                        uint32_t                      feedback);
+
 /**
  * @brief Register audio instance as the one that requires SOF events in interrupt.
  *
@@ -142,6 +142,7 @@ typedef struct {
     app_usbd_audio_req_t                request;        //!< Audio class request
     bool                                streaming;      //!< Streaming flag
     app_usbd_sof_interrupt_handler_t    sof_handler;    //!< SOF event handler
+    uint8_t                             feedback[3];    //!< Feedback endpoint packet (10.14 format)
 } app_usbd_audio_ctx_t;
 
 
@@ -176,6 +177,18 @@ typedef struct {
 #define APP_USBD_AUDIO_CONFIG_OUT(iface_control, iface_stream_out)  \
         ((iface_control), (iface_stream_out, NRF_DRV_USBD_EPOUT8))
 
+/**
+ * @brief Asynchronous OUT audio stream configuration with a feedback endpoint.
+ *
+ * The OUT endpoint is described as asynchronous, and the IN endpoint reports the
+ * device sample rate to the host (see @ref app_usbd_audio_feedback_send).
+ *
+ * @param iface_control     Interface number of audio control.
+ * @param iface_stream_out  Interface number of audio stream on OUT endpoint.
+ */
+#define APP_USBD_AUDIO_CONFIG_OUT_FEEDBACK(iface_control, iface_stream_out)  \
+        ((iface_control), (iface_stream_out, NRF_DRV_USBD_EPOUT8, NRF_DRV_USBD_EPIN8))
+
 /**
  * @brief Specific class constant data for audio class.
  *
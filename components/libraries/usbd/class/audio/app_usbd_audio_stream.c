@@ -0,0 +1,589 @@
+/**
+ * Copyright (c) 2016 - 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(APP_USBD_AUDIO)
+
+#include <string.h>
+#include "app_usbd_audio.h"
+#include "app_usbd_audio_stream.h"
+#include "app_util_platform.h"
+
+/**
+ * @defgroup app_usbd_audio_stream_internals USB Audio streaming internals
+ * @{
+ * @ingroup app_usbd_audio_stream
+ * @internal
+ */
+
+STATIC_ASSERT(APP_USBD_AUDIO_FEEDBACK_REFRESH <= APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS);
+
+/**
+ * @brief Rate correction per sample frame of jitter buffer level error.
+ *
+ * In 10.14 format: a level error of one sample frame is corrected in 256 USB frames.
+ */
+#define STREAM_LEVEL_GAIN       (1UL << (APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS - 8))
+
+/**
+ * @brief Limit of the level correction, as a right shift of the nominal rate (about 3%).
+ */
+#define STREAM_LEVEL_CORR_SHIFT 5
+
+/**
+ * @brief Number of USB frames after which the rate measurement totals are halved.
+ */
+#define STREAM_RATE_HORIZON     (1UL << 16)
+
+/**
+ * @brief Sample size in bytes.
+ *
+ * @param fmt Sample format.
+ *
+ * @return Sample size, or 0 for an invalid format.
+ */
+static uint8_t pcm_sample_size(app_usbd_audio_pcm_fmt_t fmt)
+{
+    switch (fmt)
+    {
+        case APP_USBD_AUDIO_PCM_S16:
+            return 2;
+        case APP_USBD_AUDIO_PCM_S24_3:
+            return 3;
+        case APP_USBD_AUDIO_PCM_S24_4:
+        case APP_USBD_AUDIO_PCM_S32:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Load a sample as a left-justified 32-bit value.
+ *
+ * @param fmt   Sample format.
+ * @param p_src Sample data. May be unaligned.
+ *
+ * @return Sample value.
+ */
+static inline int32_t pcm_load(app_usbd_audio_pcm_fmt_t fmt, uint8_t const * p_src)
+{
+    switch (fmt)
+    {
+        case APP_USBD_AUDIO_PCM_S16:
+            return (int32_t)(((uint32_t)p_src[0] << 16) | ((uint32_t)p_src[1] << 24));
+        case APP_USBD_AUDIO_PCM_S24_3:
+            return (int32_t)(((uint32_t)p_src[0] << 8)  |
+                             ((uint32_t)p_src[1] << 16) |
+                             ((uint32_t)p_src[2] << 24));
+        case APP_USBD_AUDIO_PCM_S24_4:
+            return (int32_t)(((uint32_t)p_src[0] << 8)  |
+                             ((uint32_t)p_src[1] << 16) |
+                             ((uint32_t)p_src[2] << 24));
+        case APP_USBD_AUDIO_PCM_S32:
+        default:
+            return (int32_t)(((uint32_t)p_src[0])       |
+                             ((uint32_t)p_src[1] << 8)  |
+                             ((uint32_t)p_src[2] << 16) |
+                             ((uint32_t)p_src[3] << 24));
+    }
+}
+
+/**
+ * @brief Store a left-justified 32-bit value as a sample.
+ *
+ * @param fmt   Sample format.
+ * @param p_dst Sample data. May be unaligned.
+ * @param value Sample value.
+ */
+static inline void pcm_store(app_usbd_audio_pcm_fmt_t fmt, uint8_t * p_dst, int32_t value)
+{
+    uint32_t v = (uint32_t)value;
+
+    switch (fmt)
+    {
+        case APP_USBD_AUDIO_PCM_S16:
+            p_dst[0] = (uint8_t)(v >> 16);
+            p_dst[1] = (uint8_t)(v >> 24);
+            break;
+        case APP_USBD_AUDIO_PCM_S24_3:
+            p_dst[0] = (uint8_t)(v >> 8);
+            p_dst[1] = (uint8_t)(v >> 16);
+            p_dst[2] = (uint8_t)(v >> 24);
+            break;
+        case APP_USBD_AUDIO_PCM_S24_4:
+            /* Sign extended into the top byte */
+            p_dst[0] = (uint8_t)(v >> 8);
+            p_dst[1] = (uint8_t)(v >> 16);
+            p_dst[2] = (uint8_t)(v >> 24);
+            p_dst[3] = (v & 0x80000000UL) ? 0xFF : 0x00;
+            break;
+        case APP_USBD_AUDIO_PCM_S32:
+        default:
+            p_dst[0] = (uint8_t)(v);
+            p_dst[1] = (uint8_t)(v >> 8);
+            p_dst[2] = (uint8_t)(v >> 16);
+            p_dst[3] = (uint8_t)(v >> 24);
+            break;
+    }
+}
+
+void app_usbd_audio_pcm_convert(void                     * p_dst,
+                                app_usbd_audio_pcm_fmt_t   dst_fmt,
+                                uint8_t                    dst_channels,
+                                void const               * p_src,
+                                app_usbd_audio_pcm_fmt_t   src_fmt,
+                                uint8_t                    src_channels,
+                                size_t                     frames)
+{
+    ASSERT((dst_channels > 0) && (src_channels > 0));
+    uint8_t const   dst_size = pcm_sample_size(dst_fmt);
+    uint8_t const   src_size = pcm_sample_size(src_fmt);
+    uint8_t       * p_out    = (uint8_t *)p_dst;
+    uint8_t const * p_in     = (uint8_t const *)p_src;
+
+    if ((dst_fmt == src_fmt) && (dst_channels == src_channels))
+    {
+        /* Same layout */
+        memcpy(p_out, p_in, frames * dst_channels * dst_size);
+        return;
+    }
+
+    if ((dst_fmt == APP_USBD_AUDIO_PCM_S16) && (src_fmt == APP_USBD_AUDIO_PCM_S16))
+    {
+        /* Channel remapping only, the most common case (PDM mono to USB stereo) */
+        for (size_t i = 0; i < frames; i++)
+        {
+            for (uint8_t ch = 0; ch < dst_channels; ch++)
+            {
+                uint8_t const * p_sample = p_in + 2 * (ch % src_channels);
+                p_out[0] = p_sample[0];
+                p_out[1] = p_sample[1];
+                p_out   += 2;
+            }
+            p_in += 2 * src_channels;
+        }
+        return;
+    }
+
+    if (dst_channels == src_channels)
+    {
+        size_t samples = frames * dst_channels;
+        for (size_t i = 0; i < samples; i++)
+        {
+            pcm_store(dst_fmt, p_out, pcm_load(src_fmt, p_in));
+            p_out += dst_size;
+            p_in  += src_size;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        for (uint8_t ch = 0; ch < dst_channels; ch++)
+        {
+            pcm_store(dst_fmt, p_out, pcm_load(src_fmt, p_in + src_size * (ch % src_channels)));
+            p_out += dst_size;
+        }
+        p_in += src_size * src_channels;
+    }
+}
+
+/**
+ * @brief Update level statistics. Must be called with interrupts disabled.
+ *
+ * @param p_stream Stream instance.
+ */
+static void stream_level_stats_update(app_usbd_audio_stream_t * p_stream)
+{
+    uint32_t frames = p_stream->level / p_stream->usb_frame_size;
+
+    if (frames < p_stream->stats.level_min)
+    {
+        p_stream->stats.level_min = frames;
+    }
+    if (frames > p_stream->stats.level_max)
+    {
+        p_stream->stats.level_max = frames;
+    }
+}
+
+/**
+ * @brief Rate correction for the current jitter buffer level.
+ *
+ * Positive when the buffer is below half, that is, when the writing side should speed up.
+ *
+ * @param p_stream Stream instance.
+ *
+ * @return Correction in 10.14 format.
+ */
+static int32_t stream_level_corr(app_usbd_audio_stream_t const * p_stream)
+{
+    int32_t half  = (int32_t)(p_stream->size / p_stream->usb_frame_size / 2);
+    int32_t level = (int32_t)(p_stream->level / p_stream->usb_frame_size);
+    int32_t limit = (int32_t)(p_stream->nominal >> STREAM_LEVEL_CORR_SHIFT);
+    int32_t corr  = (half - level) * (int32_t)STREAM_LEVEL_GAIN;
+
+    if (corr > limit)
+    {
+        corr = limit;
+    }
+    else if (corr < -limit)
+    {
+        corr = -limit;
+    }
+    return corr;
+}
+
+/**
+ * @brief Copy bytes into the jitter buffer at the write position.
+ *
+ * @param p_stream Stream instance.
+ * @param p_src    Data.
+ * @param len      Length, at most the free space.
+ */
+static void stream_copy_in(app_usbd_audio_stream_t * p_stream, uint8_t const * p_src, size_t len)
+{
+    uint8_t * p_buf = (uint8_t *)p_stream->config.p_buf;
+    size_t    chunk = MIN(len, p_stream->size - p_stream->wr);
+
+    memcpy(p_buf + p_stream->wr, p_src, chunk);
+    memcpy(p_buf, p_src + chunk, len - chunk);
+    p_stream->wr = (p_stream->wr + len) % p_stream->size;
+}
+
+/**
+ * @brief Copy bytes from the jitter buffer at the read position.
+ *
+ * @param p_stream Stream instance.
+ * @param p_dst    Destination.
+ * @param len      Length, at most the level.
+ */
+static void stream_copy_out(app_usbd_audio_stream_t * p_stream, uint8_t * p_dst, size_t len)
+{
+    uint8_t const * p_buf = (uint8_t const *)p_stream->config.p_buf;
+    size_t          chunk = MIN(len, p_stream->size - p_stream->rd);
+
+    memcpy(p_dst, p_buf + p_stream->rd, chunk);
+    memcpy(p_dst + chunk, p_buf, len - chunk);
+    p_stream->rd = (p_stream->rd + len) % p_stream->size;
+}
+
+/**
+ * @brief Check and update the primed state of the reading side.
+ *
+ * @param p_stream Stream instance.
+ *
+ * @return True if data may be read.
+ */
+static bool stream_primed(app_usbd_audio_stream_t * p_stream)
+{
+    if (!p_stream->primed && (p_stream->level >= p_stream->size / 2))
+    {
+        p_stream->primed = true;
+    }
+    return p_stream->primed;
+}
+
+ret_code_t app_usbd_audio_stream_init(app_usbd_audio_stream_t              * p_stream,
+                                      app_usbd_audio_stream_config_t const * p_config)
+{
+    ASSERT(p_stream != NULL);
+    ASSERT(p_config != NULL);
+
+    uint8_t usb_sample = pcm_sample_size(p_config->usb_fmt);
+    uint8_t dev_sample = pcm_sample_size(p_config->dev_fmt);
+
+    if ((p_config->p_buf == NULL)       ||
+        (usb_sample == 0)               ||
+        (dev_sample == 0)               ||
+        (p_config->usb_channels == 0)   ||
+        (p_config->dev_channels == 0)   ||
+        (p_config->sample_rate == 0))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    uint8_t usb_frame_size = usb_sample * p_config->usb_channels;
+
+    if ((p_config->ep_size < usb_frame_size) ||
+        (p_config->buf_size < 4 * (size_t)p_config->ep_size))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    memset(p_stream, 0, sizeof(*p_stream));
+    p_stream->config         = *p_config;
+    p_stream->usb_frame_size = usb_frame_size;
+    p_stream->dev_frame_size = dev_sample * p_config->dev_channels;
+    p_stream->size           = p_config->buf_size - (p_config->buf_size % usb_frame_size);
+    p_stream->nominal        = (uint32_t)(((uint64_t)p_config->sample_rate <<
+                                           APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS) / 1000);
+
+    app_usbd_audio_stream_reset(p_stream);
+    return NRF_SUCCESS;
+}
+
+void app_usbd_audio_stream_reset(app_usbd_audio_stream_t * p_stream)
+{
+    CRITICAL_REGION_ENTER();
+    p_stream->rd           = 0;
+    p_stream->wr           = 0;
+    p_stream->level        = 0;
+    p_stream->primed       = false;
+    p_stream->rate         = p_stream->nominal;
+    p_stream->dev_frames   = 0;
+    p_stream->sof_count    = 0;
+    p_stream->total_frames = 0;
+    p_stream->total_sofs   = 0;
+    p_stream->packet_acc   = 0;
+    memset(&p_stream->stats, 0, sizeof(p_stream->stats));
+    CRITICAL_REGION_EXIT();
+}
+
+size_t app_usbd_audio_stream_usb_write(app_usbd_audio_stream_t * p_stream,
+                                       void const              * p_data,
+                                       size_t                    size)
+{
+    ASSERT(p_stream->config.dir == APP_USBD_AUDIO_STREAM_OUT);
+
+    size_t len  = size - (size % p_stream->usb_frame_size);
+    size_t free = p_stream->size - p_stream->level;
+
+    if (len > free)
+    {
+        len = free;
+        p_stream->stats.overruns++;
+    }
+
+    stream_copy_in(p_stream, (uint8_t const *)p_data, len);
+
+    CRITICAL_REGION_ENTER();
+    p_stream->level += len;
+    stream_level_stats_update(p_stream);
+    CRITICAL_REGION_EXIT();
+
+    return len;
+}
+
+size_t app_usbd_audio_stream_usb_read(app_usbd_audio_stream_t * p_stream, void * p_data)
+{
+    ASSERT(p_stream->config.dir == APP_USBD_AUDIO_STREAM_IN);
+
+    if (!stream_primed(p_stream))
+    {
+        return 0;
+    }
+
+    /* More data than half of the buffer: send faster */
+    p_stream->packet_acc += (uint32_t)((int32_t)p_stream->rate - stream_level_corr(p_stream));
+
+    size_t frames = p_stream->packet_acc >> APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS;
+    p_stream->packet_acc -= frames << APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS;
+
+    frames = MIN(frames, p_stream->config.ep_size / p_stream->usb_frame_size);
+
+    size_t len = frames * p_stream->usb_frame_size;
+    if (len > p_stream->level)
+    {
+        len = p_stream->level;
+        p_stream->primed = false;
+        p_stream->stats.underruns++;
+    }
+
+    stream_copy_out(p_stream, (uint8_t *)p_data, len);
+
+    CRITICAL_REGION_ENTER();
+    p_stream->level -= len;
+    stream_level_stats_update(p_stream);
+    CRITICAL_REGION_EXIT();
+
+    return len;
+}
+
+void app_usbd_audio_stream_dev_read(app_usbd_audio_stream_t * p_stream,
+                                    void                    * p_dst,
+                                    size_t                    frames)
+{
+    ASSERT(p_stream->config.dir == APP_USBD_AUDIO_STREAM_OUT);
+
+    uint8_t * p_out = (uint8_t *)p_dst;
+    size_t    count = 0;
+
+    if (stream_primed(p_stream))
+    {
+        count = MIN(frames, p_stream->level / p_stream->usb_frame_size);
+
+        size_t left = count;
+        while (left > 0)
+        {
+            /* The buffer holds whole sample frames, so a frame never wraps */
+            size_t chunk = MIN(left, (p_stream->size - p_stream->rd) / p_stream->usb_frame_size);
+
+            app_usbd_audio_pcm_convert(p_out,
+                                       p_stream->config.dev_fmt,
+                                       p_stream->config.dev_channels,
+                                       (uint8_t const *)p_stream->config.p_buf + p_stream->rd,
+                                       p_stream->config.usb_fmt,
+                                       p_stream->config.usb_channels,
+                                       chunk);
+            p_out       += chunk * p_stream->dev_frame_size;
+            p_stream->rd = (p_stream->rd + chunk * p_stream->usb_frame_size) % p_stream->size;
+            left        -= chunk;
+        }
+
+        if (count < frames)
+        {
+            p_stream->primed = false;
+            p_stream->stats.underruns++;
+        }
+    }
+
+    /* Silence */
+    memset(p_out, 0, (frames - count) * p_stream->dev_frame_size);
+
+    CRITICAL_REGION_ENTER();
+    p_stream->level      -= count * p_stream->usb_frame_size;
+    p_stream->dev_frames += frames;
+    stream_level_stats_update(p_stream);
+    CRITICAL_REGION_EXIT();
+}
+
+void app_usbd_audio_stream_dev_write(app_usbd_audio_stream_t * p_stream,
+                                     void const              * p_src,
+                                     size_t                    frames)
+{
+    ASSERT(p_stream->config.dir == APP_USBD_AUDIO_STREAM_IN);
+
+    uint8_t const * p_in  = (uint8_t const *)p_src;
+    size_t          count = MIN(frames,
+                                (p_stream->size - p_stream->level) / p_stream->usb_frame_size);
+
+    if (count < frames)
+    {
+        p_stream->stats.overruns++;
+    }
+
+    size_t left = count;
+    while (left > 0)
+    {
+        size_t chunk = MIN(left, (p_stream->size - p_stream->wr) / p_stream->usb_frame_size);
+
+        app_usbd_audio_pcm_convert((uint8_t *)p_stream->config.p_buf + p_stream->wr,
+                                   p_stream->config.usb_fmt,
+                                   p_stream->config.usb_channels,
+                                   p_in,
+                                   p_stream->config.dev_fmt,
+                                   p_stream->config.dev_channels,
+                                   chunk);
+        p_in        += chunk * p_stream->dev_frame_size;
+        p_stream->wr = (p_stream->wr + chunk * p_stream->usb_frame_size) % p_stream->size;
+        left        -= chunk;
+    }
+
+    CRITICAL_REGION_ENTER();
+    p_stream->level      += count * p_stream->usb_frame_size;
+    p_stream->dev_frames += frames;
+    stream_level_stats_update(p_stream);
+    CRITICAL_REGION_EXIT();
+}
+
+void app_usbd_audio_stream_sof(app_usbd_audio_stream_t * p_stream)
+{
+    if (++p_stream->sof_count < (1U << APP_USBD_AUDIO_FEEDBACK_REFRESH))
+    {
+        return;
+    }
+
+    uint32_t frames;
+    CRITICAL_REGION_ENTER();
+    frames               = p_stream->dev_frames;
+    p_stream->dev_frames = 0;
+    CRITICAL_REGION_EXIT();
+
+    if ((frames == 0) && (p_stream->total_frames == 0))
+    {
+        /* Peripheral not started yet */
+        p_stream->sof_count = 0;
+        return;
+    }
+
+    /* The peripheral reports in whole DMA buffers, so the rate is averaged over a long
+     * horizon rather than per window. Halving the totals lets it follow slow drift. */
+    p_stream->total_frames += frames;
+    p_stream->total_sofs   += p_stream->sof_count;
+    p_stream->sof_count     = 0;
+
+    if (p_stream->total_sofs >= STREAM_RATE_HORIZON)
+    {
+        p_stream->total_frames /= 2;
+        p_stream->total_sofs   /= 2;
+    }
+
+    p_stream->rate = (uint32_t)(((uint64_t)p_stream->total_frames <<
+                                 APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS) /
+                                p_stream->total_sofs);
+}
+
+uint32_t app_usbd_audio_stream_feedback_get(app_usbd_audio_stream_t const * p_stream)
+{
+    /* Less data than half of the buffer: ask the host for more */
+    return (uint32_t)((int32_t)p_stream->rate + stream_level_corr(p_stream));
+}
+
+size_t app_usbd_audio_stream_level_get(app_usbd_audio_stream_t const * p_stream)
+{
+    return p_stream->level / p_stream->usb_frame_size;
+}
+
+void app_usbd_audio_stream_stats_get(app_usbd_audio_stream_t       * p_stream,
+                                     app_usbd_audio_stream_stats_t * p_stats)
+{
+    ASSERT(p_stats != NULL);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = p_stream->stats;
+    memset(&p_stream->stats, 0, sizeof(p_stream->stats));
+    p_stream->stats.level_min = p_stream->level / p_stream->usb_frame_size;
+    p_stream->stats.level_max = p_stream->stats.level_min;
+    CRITICAL_REGION_EXIT();
+}
+
+/** @} */
+#endif //NRF_MODULE_ENABLED(APP_USBD_AUDIO)
@@ -0,0 +1,300 @@
+/**
+ * Copyright (c) 2017 - 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef APP_USBD_AUDIO_STREAM_H__
+#define APP_USBD_AUDIO_STREAM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sdk_errors.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup app_usbd_audio_stream USB Audio streaming
+ * @ingroup app_usbd_audio
+ *
+ * @brief @tagAPI52840 Jitter buffer, clock drift compensation, and PCM conversion between
+ *        USB audio frames and audio peripheral DMA buffers.
+ *
+ * A stream connects the isochronous endpoint of the audio class with an audio peripheral
+ * (I2S or PDM) that runs from its own clock. Data is kept in a jitter buffer in the USB
+ * format and converted to or from the peripheral format when the peripheral DMA buffers
+ * are filled or emptied. The stream measures the peripheral clock against USB frames:
+ * - For OUT streams (host to device), the measured rate is the value to report on the
+ *   feedback endpoint (see @ref app_usbd_audio_feedback_send).
+ * - For IN streams (device to host), the measured rate sets the size of every packet.
+ *
+ * In both cases the rate is corrected by the jitter buffer level, so the buffer settles
+ * at half of its size.
+ *
+ * Calls for the USB side (@ref app_usbd_audio_stream_usb_write,
+ * @ref app_usbd_audio_stream_usb_read, @ref app_usbd_audio_stream_sof) and for the
+ * peripheral side (@ref app_usbd_audio_stream_dev_read, @ref app_usbd_audio_stream_dev_write)
+ * may come from different interrupt contexts.
+ * @{
+ */
+
+/**
+ * @brief Fractional bits of rate values (10.14 fixed point format of the feedback endpoint).
+ */
+#define APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS 14
+
+/**
+ * @brief PCM sample formats.
+ */
+typedef enum {
+    APP_USBD_AUDIO_PCM_S16,    /**< 16-bit samples, 2 bytes (USB and PDM, I2S 16-bit). */
+    APP_USBD_AUDIO_PCM_S24_3,  /**< 24-bit samples, packed in 3 bytes (USB). */
+    APP_USBD_AUDIO_PCM_S24_4,  /**< 24-bit samples, right-aligned in 4 bytes (I2S 24-bit). */
+    APP_USBD_AUDIO_PCM_S32,    /**< 32-bit samples, 4 bytes. */
+} app_usbd_audio_pcm_fmt_t;
+
+/**
+ * @brief Stream direction.
+ */
+typedef enum {
+    APP_USBD_AUDIO_STREAM_OUT, /**< Host to device: USB packets in, peripheral buffers out. */
+    APP_USBD_AUDIO_STREAM_IN,  /**< Device to host: peripheral buffers in, USB packets out. */
+} app_usbd_audio_stream_dir_t;
+
+/**
+ * @brief Stream configuration.
+ */
+typedef struct {
+    app_usbd_audio_stream_dir_t dir;          //!< Stream direction.
+    app_usbd_audio_pcm_fmt_t    usb_fmt;      //!< Sample format of USB packets.
+    uint8_t                     usb_channels; //!< Channels in USB packets.
+    app_usbd_audio_pcm_fmt_t    dev_fmt;      //!< Sample format of peripheral buffers.
+    uint8_t                     dev_channels; //!< Channels in peripheral buffers.
+    uint32_t                    sample_rate;  //!< Nominal sample rate in Hz.
+    uint16_t                    ep_size;      //!< Isochronous endpoint size in bytes.
+    void                      * p_buf;        //!< Jitter buffer memory.
+    size_t                      buf_size;     //!< Jitter buffer size in bytes.
+} app_usbd_audio_stream_config_t;
+
+/**
+ * @brief Stream statistics.
+ */
+typedef struct {
+    uint32_t underruns;  //!< Peripheral buffers (OUT) or USB packets (IN) padded or skipped.
+    uint32_t overruns;   //!< USB packets (OUT) or peripheral buffers (IN) partly dropped.
+    uint32_t level_min;  //!< Lowest jitter buffer level in sample frames since last clear.
+    uint32_t level_max;  //!< Highest jitter buffer level in sample frames since last clear.
+} app_usbd_audio_stream_stats_t;
+
+/**
+ * @brief Stream instance.
+ *
+ * All fields are private. Initialize with @ref app_usbd_audio_stream_init.
+ */
+typedef struct {
+    app_usbd_audio_stream_config_t config;     //!< Configuration.
+
+    uint8_t  usb_frame_size;   //!< Bytes per sample frame in USB format.
+    uint8_t  dev_frame_size;   //!< Bytes per sample frame in peripheral format.
+    size_t   size;             //!< Usable jitter buffer size, whole sample frames.
+    size_t   rd;               //!< Read position (owned by the reading side).
+    size_t   wr;               //!< Write position (owned by the writing side).
+    size_t   level;            //!< Bytes stored.
+    bool     primed;           //!< Reading started after the buffer was half full.
+
+    uint32_t nominal;          //!< Nominal rate, sample frames per USB frame.
+    uint32_t rate;             //!< Measured peripheral rate, sample frames per USB frame.
+    uint32_t dev_frames;       //!< Peripheral sample frames in the current window.
+    uint16_t sof_count;        //!< USB frames in the current window.
+    uint32_t total_frames;     //!< Peripheral sample frames in the measurement horizon.
+    uint32_t total_sofs;       //!< USB frames in the measurement horizon.
+    uint32_t packet_acc;       //!< Fractional sample frames carried to the next IN packet.
+
+    app_usbd_audio_stream_stats_t stats; //!< Statistics.
+} app_usbd_audio_stream_t;
+
+/**
+ * @brief Convert and remap PCM samples.
+ *
+ * Destination channel N is taken from source channel (N modulo source channels), so a mono
+ * source is duplicated to every destination channel, and extra source channels are dropped.
+ * Samples are scaled between formats by shifting: widening keeps the value, narrowing
+ * truncates the least significant bits.
+ *
+ * @param[out] p_dst        Destination buffer.
+ * @param[in]  dst_fmt      Destination sample format.
+ * @param[in]  dst_channels Destination channels.
+ * @param[in]  p_src        Source buffer.
+ * @param[in]  src_fmt      Source sample format.
+ * @param[in]  src_channels Source channels.
+ * @param[in]  frames       Number of sample frames.
+ */
+void app_usbd_audio_pcm_convert(void                     * p_dst,
+                                app_usbd_audio_pcm_fmt_t   dst_fmt,
+                                uint8_t                    dst_channels,
+                                void const               * p_src,
+                                app_usbd_audio_pcm_fmt_t   src_fmt,
+                                uint8_t                    src_channels,
+                                size_t                     frames);
+
+/**
+ * @brief Initialize a stream.
+ *
+ * @param[out] p_stream Stream instance.
+ * @param[in]  p_config Stream configuration. Copied.
+ *
+ * @retval NRF_SUCCESS             Stream initialized.
+ * @retval NRF_ERROR_INVALID_PARAM Invalid configuration, or the jitter buffer is smaller than
+ *                                 four endpoint sizes.
+ */
+ret_code_t app_usbd_audio_stream_init(app_usbd_audio_stream_t              * p_stream,
+                                      app_usbd_audio_stream_config_t const * p_config);
+
+/**
+ * @brief Empty the jitter buffer and restart clock measurement.
+ *
+ * Call when the streaming interface is selected.
+ *
+ * @param[in,out] p_stream Stream instance.
+ */
+void app_usbd_audio_stream_reset(app_usbd_audio_stream_t * p_stream);
+
+/**
+ * @brief Store a received USB packet (OUT streams).
+ *
+ * Call on @ref APP_USBD_AUDIO_USER_EVT_RX_DONE with the received data. Data that does not
+ * fit is dropped and counted as an overrun.
+ *
+ * @param[in,out] p_stream Stream instance.
+ * @param[in]     p_data   Packet data in USB format.
+ * @param[in]     size     Packet size in bytes.
+ *
+ * @return Number of bytes stored.
+ */
+size_t app_usbd_audio_stream_usb_write(app_usbd_audio_stream_t * p_stream,
+                                       void const              * p_data,
+                                       size_t                    size);
+
+/**
+ * @brief Fill the next USB packet (IN streams).
+ *
+ * Call on every SOF, then pass the packet to @ref app_usbd_audio_class_tx_start. The packet
+ * size follows the measured peripheral rate. Until the jitter buffer is half full, empty
+ * packets are returned.
+ *
+ * @param[in,out] p_stream Stream instance.
+ * @param[out]    p_data   Packet buffer, at least the endpoint size.
+ *
+ * @return Packet size in bytes.
+ */
+size_t app_usbd_audio_stream_usb_read(app_usbd_audio_stream_t * p_stream, void * p_data);
+
+/**
+ * @brief Fill a peripheral DMA buffer (OUT streams).
+ *
+ * Call when the peripheral requests the next buffer. Until the jitter buffer is half full,
+ * and on underrun, the buffer is filled with silence.
+ *
+ * @param[in,out] p_stream Stream instance.
+ * @param[out]    p_dst    Buffer in peripheral format.
+ * @param[in]     frames   Number of sample frames.
+ */
+void app_usbd_audio_stream_dev_read(app_usbd_audio_stream_t * p_stream,
+                                    void                    * p_dst,
+                                    size_t                    frames);
+
+/**
+ * @brief Store a filled peripheral DMA buffer (IN streams).
+ *
+ * Samples that do not fit are dropped and counted as an overrun.
+ *
+ * @param[in,out] p_stream Stream instance.
+ * @param[in]     p_src    Buffer in peripheral format.
+ * @param[in]     frames   Number of sample frames.
+ */
+void app_usbd_audio_stream_dev_write(app_usbd_audio_stream_t * p_stream,
+                                     void const              * p_src,
+                                     size_t                    frames);
+
+/**
+ * @brief Process a USB start of frame.
+ *
+ * Call from the SOF handler of the audio class. Every 2^@ref APP_USBD_AUDIO_FEEDBACK_REFRESH
+ * frames the peripheral rate measurement is updated.
+ *
+ * @param[in,out] p_stream Stream instance.
+ */
+void app_usbd_audio_stream_sof(app_usbd_audio_stream_t * p_stream);
+
+/**
+ * @brief Get the feedback value for the host (OUT streams).
+ *
+ * @param[in] p_stream Stream instance.
+ *
+ * @return Sample frames per USB frame in 10.14 format, for
+ *         @ref app_usbd_audio_feedback_send.
+ */
+uint32_t app_usbd_audio_stream_feedback_get(app_usbd_audio_stream_t const * p_stream);
+
+/**
+ * @brief Get the jitter buffer level.
+ *
+ * @param[in] p_stream Stream instance.
+ *
+ * @return Sample frames stored.
+ */
+size_t app_usbd_audio_stream_level_get(app_usbd_audio_stream_t const * p_stream);
+
+/**
+ * @brief Get and clear stream statistics.
+ *
+ * @param[in,out] p_stream Stream instance.
+ * @param[out]    p_stats  Statistics since the last call.
+ */
+void app_usbd_audio_stream_stats_get(app_usbd_audio_stream_t       * p_stream,
+                                     app_usbd_audio_stream_stats_t * p_stats);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_USBD_AUDIO_STREAM_H__ */
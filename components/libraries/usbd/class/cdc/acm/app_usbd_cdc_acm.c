@@ -361,6 +361,7 @@ static void cdc_acm_reset_port(app_usbd_class_inst_t const * p_inst)
     p_cdc_acm_ctx->last_read  = 0;
     p_cdc_acm_ctx->cur_read   = 0;
     p_cdc_acm_ctx->p_copy_pos = p_cdc_acm_ctx->internal_rx_buf;
+    memset(&p_cdc_acm_ctx->rx_ring, 0, sizeof(p_cdc_acm_ctx->rx_ring));
 }
 
 /**
@@ -431,6 +432,7 @@ static ret_code_t setup_req_class_out(app_usbd_class_inst_t const * p_inst,
                 p_cdc_acm_ctx->last_read  = 0;
                 p_cdc_acm_ctx->cur_read   = 0;
                 p_cdc_acm_ctx->p_copy_pos = p_cdc_acm_ctx->internal_rx_buf;
+                memset(&p_cdc_acm_ctx->rx_ring, 0, sizeof(p_cdc_acm_ctx->rx_ring));
             }
 
             return NRF_SUCCESS;
@@ -498,6 +500,8 @@ static bool cdc_acm_consumer(nrf_drv_usbd_ep_transfer_t * p_next,
     app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = (app_usbd_cdc_acm_ctx_t *) p_context;
     p_next->size = data_size;
 
+    p_cdc_acm_ctx->stats.rx_bytes += data_size;
+
     if (data_size <= p_cdc_acm_ctx->rx_transfer[0].read_left)
     {
         p_next->p_data.rx = p_cdc_acm_ctx->rx_transfer[0].p_buf;
@@ -535,6 +539,8 @@ static bool cdc_acm_single_shoot_consumer(nrf_drv_usbd_ep_transfer_t * p_next,
     app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = (app_usbd_cdc_acm_ctx_t *) p_context;
     p_next->size = data_size;
 
+    p_cdc_acm_ctx->stats.rx_bytes += data_size;
+
     if (data_size <= p_cdc_acm_ctx->rx_transfer[0].read_left)
     {
         p_next->p_data.rx = p_cdc_acm_ctx->rx_transfer[0].p_buf;
@@ -555,6 +561,158 @@ static bool cdc_acm_single_shoot_consumer(nrf_drv_usbd_ep_transfer_t * p_next,
     return false;
 }
 
+/**
+ * @brief Finds room for a packet in the receive ring.
+ *
+ * @param[in] p_ring Receive ring.
+ * @param[in] size   Packet size.
+ *
+ * @return Position for the packet, or the ring size if there is no room.
+ */
+static size_t cdc_acm_rx_ring_room(cdc_rx_ring_t const * p_ring, size_t size)
+{
+    if (p_ring->wrapped)
+    {
+        return (p_ring->rd - p_ring->wr >= size) ? p_ring->wr : p_ring->size;
+    }
+
+    if (p_ring->size - p_ring->wr >= size)
+    {
+        return p_ring->wr;
+    }
+
+    return (p_ring->rd >= size) ? 0 : p_ring->size;
+}
+
+/**
+ * @brief Returns the length of the oldest contiguous span in the receive ring.
+ *
+ * Moves the read position to the start of the buffer if all data before the wrap point
+ * has been read.
+ *
+ * @param[in,out] p_ring Receive ring.
+ *
+ * @return Span length.
+ */
+static size_t cdc_acm_rx_ring_span(cdc_rx_ring_t * p_ring)
+{
+    if (p_ring->wrapped && (p_ring->rd == p_ring->end))
+    {
+        p_ring->rd      = 0;
+        p_ring->wrapped = false;
+    }
+
+    return (p_ring->wrapped ? p_ring->end : p_ring->wr) - p_ring->rd;
+}
+
+/**
+ * @brief CDC ACM receive ring consumer.
+ *
+ * Places every packet in the receive ring and finalizes the transfer, so that the class gets
+ * an event for each packet.
+ *
+ * @note See @ref nrf_drv_usbd_consumer_t
+ */
+static bool cdc_acm_ring_consumer(nrf_drv_usbd_ep_transfer_t * p_next,
+                                  void *                       p_context,
+                                  size_t                       ep_size,
+                                  size_t                       data_size)
+{
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = (app_usbd_cdc_acm_ctx_t *) p_context;
+    cdc_rx_ring_t *          p_ring        = &p_cdc_acm_ctx->rx_ring;
+
+    // Room for a packet of the endpoint size was checked when the transfer was set up.
+    size_t pos = cdc_acm_rx_ring_room(p_ring, data_size);
+    ASSERT(pos < p_ring->size);
+
+    if (pos != p_ring->wr)
+    {
+        p_ring->end     = p_ring->wr;
+        p_ring->wr      = 0;
+        p_ring->wrapped = true;
+    }
+
+    p_ring->pending      = pos;
+    p_ring->pending_size = data_size;
+
+    p_next->p_data.rx = p_ring->p_buf + pos;
+    p_next->size      = data_size;
+
+    p_cdc_acm_ctx->stats.rx_bytes += data_size;
+    NRF_LOG_DEBUG("Received %d bytes at ring position %d.", data_size, pos);
+    return false;
+}
+
+/**
+ * @brief Sets up a transfer into the receive ring.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param p_inst  Generic USB class instance.
+ *
+ * @retval NRF_SUCCESS      Transfer set up, or already set up.
+ * @retval NRF_ERROR_NO_MEM No room in the ring for a packet.
+ * @retval other            Standard error code.
+ */
+static ret_code_t cdc_acm_rx_ring_arm(app_usbd_class_inst_t const * p_inst)
+{
+    app_usbd_cdc_acm_t const * p_cdc_acm     = cdc_acm_get(p_inst);
+    app_usbd_cdc_acm_ctx_t *   p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+    cdc_rx_ring_t *            p_ring        = &p_cdc_acm_ctx->rx_ring;
+
+    if (p_ring->armed)
+    {
+        return NRF_SUCCESS;
+    }
+
+    if (cdc_acm_rx_ring_room(p_ring, NRF_DRV_USBD_EPSIZE) == p_ring->size)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    nrf_drv_usbd_handler_desc_t const handler_desc = {
+        .handler.consumer = cdc_acm_ring_consumer,
+        .p_context        = p_cdc_acm_ctx
+    };
+
+    ret_code_t ret = app_usbd_ep_handled_transfer(data_ep_out_addr_get(p_inst), &handler_desc);
+    if (ret == NRF_SUCCESS)
+    {
+        p_ring->armed = true;
+    }
+    return ret;
+}
+
+/**
+ * @brief Commits a packet received into the receive ring and sets up the next transfer.
+ *
+ * @param p_inst  Generic USB class instance.
+ *
+ * @return Standard error code.
+ */
+static ret_code_t cdc_acm_rx_ring_block_finished(app_usbd_class_inst_t const * p_inst)
+{
+    app_usbd_cdc_acm_t const * p_cdc_acm     = cdc_acm_get(p_inst);
+    app_usbd_cdc_acm_ctx_t *   p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+    cdc_rx_ring_t *            p_ring        = &p_cdc_acm_ctx->rx_ring;
+
+    ret_code_t ret;
+    CRITICAL_REGION_ENTER();
+    p_ring->armed = false;
+    p_ring->wr    = p_ring->pending + p_ring->pending_size;
+
+    ret = cdc_acm_rx_ring_arm(p_inst);
+    if (ret == NRF_ERROR_NO_MEM)
+    {
+        // Re-armed when the user releases data.
+        p_cdc_acm_ctx->stats.rx_ring_full++;
+        ret = NRF_SUCCESS;
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
 /**
  * @brief Manage switching between user buffers and copying data from internal buffer.
  *
@@ -682,6 +840,8 @@ static ret_code_t cdc_acm_rx_block_finished(app_usbd_class_inst_t const *  p_ins
 static ret_code_t cdc_acm_endpoint_ev(app_usbd_class_inst_t const *  p_inst,
                                       app_usbd_complex_evt_t const * p_event)
 {
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(cdc_acm_get(p_inst));
+
     if (comm_ep_in_addr_get(p_inst) == p_event->drv_evt.data.eptransfer.ep)
     {
         NRF_LOG_INFO("EPIN_COMM: notify");
@@ -694,6 +854,7 @@ static ret_code_t cdc_acm_endpoint_ev(app_usbd_class_inst_t const *  p_inst,
         {
             case NRF_USBD_EP_OK:
                 NRF_LOG_INFO("EPIN_DATA: %02x done", p_event->drv_evt.data.eptransfer.ep);
+                p_cdc_acm_ctx->stats.tx_bytes += p_cdc_acm_ctx->tx_size;
                 user_event_handler(p_inst, APP_USBD_CDC_ACM_USER_EVT_TX_DONE);
                 return NRF_SUCCESS;
             case NRF_USBD_EP_ABORTED:
@@ -708,7 +869,14 @@ static ret_code_t cdc_acm_endpoint_ev(app_usbd_class_inst_t const *  p_inst,
         switch (p_event->drv_evt.data.eptransfer.status)
         {
             case NRF_USBD_EP_OK:
-                ret = cdc_acm_rx_block_finished(p_inst);
+                if (p_cdc_acm_ctx->rx_ring.p_buf != NULL)
+                {
+                    ret = cdc_acm_rx_ring_block_finished(p_inst);
+                }
+                else
+                {
+                    ret = cdc_acm_rx_block_finished(p_inst);
+                }
                 NRF_LOG_INFO("EPOUT_DATA: %02x done", p_event->drv_evt.data.eptransfer.ep);
                 user_event_handler(p_inst, APP_USBD_CDC_ACM_USER_EVT_RX_DONE);
                 return ret;
@@ -949,17 +1117,151 @@ ret_code_t app_usbd_cdc_acm_write(app_usbd_cdc_acm_t const * p_cdc_acm,
     }
     
     nrf_drv_usbd_ep_t ep = data_ep_in_addr_get(p_inst);
-    
+    ret_code_t        ret;
+
+    CRITICAL_REGION_ENTER();
     if (APP_USBD_CDC_ACM_ZLP_ON_EPSIZE_WRITE && ((length % NRF_DRV_USBD_EPSIZE) == 0))
     {
         NRF_DRV_USBD_TRANSFER_IN_ZLP(transfer, p_buf, length);
-        return app_usbd_ep_transfer(ep, &transfer);
+        ret = app_usbd_ep_transfer(ep, &transfer);
     }
     else
     {
         NRF_DRV_USBD_TRANSFER_IN(transfer, p_buf, length);
-        return app_usbd_ep_transfer(ep, &transfer);
+        ret = app_usbd_ep_transfer(ep, &transfer);
+    }
+
+    if (ret == NRF_SUCCESS)
+    {
+        p_cdc_acm_ctx->tx_size = length;
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
+/**
+ * @brief Skips exhausted and empty segments of a scatter list.
+ *
+ * @param[in,out] p_list Scatter list.
+ */
+static void cdc_acm_tx_list_skip(cdc_tx_list_t * p_list)
+{
+    while ((p_list->count > 0) && (p_list->pos == p_list->p_seg->length))
+    {
+        p_list->p_seg++;
+        p_list->count--;
+        p_list->pos = 0;
+    }
+}
+
+/**
+ * @brief CDC ACM scatter list feeder.
+ *
+ * Packets that lie entirely within one RAM segment are sent from the segment itself. Other
+ * packets are gathered into the driver feeder buffer.
+ *
+ * @note See @ref nrf_drv_usbd_feeder_t
+ */
+static bool cdc_acm_list_feeder(nrf_drv_usbd_ep_transfer_t * p_next,
+                                void *                       p_context,
+                                size_t                       ep_size)
+{
+    cdc_tx_list_t * p_list = (cdc_tx_list_t *) p_context;
+    size_t          size   = 0;
+
+    cdc_acm_tx_list_skip(p_list);
+
+    uint8_t const * p_src = (p_list->count > 0) ?
+                            (uint8_t const *)p_list->p_seg->p_data + p_list->pos : NULL;
+
+    if ((p_src != NULL)                                   &&
+        (p_list->p_seg->length - p_list->pos >= ep_size) &&
+        nrfx_is_in_ram(p_src))
+    {
+        p_next->p_data.tx = p_src;
+        size              = ep_size;
+        p_list->pos      += ep_size;
+    }
+    else
+    {
+        uint8_t * p_buffer = nrf_drv_usbd_feeder_buffer_get();
+
+        while ((size < ep_size) && (p_list->count > 0))
+        {
+            size_t chunk = MIN(ep_size - size, p_list->p_seg->length - p_list->pos);
+
+            memcpy(p_buffer + size,
+                   (uint8_t const *)p_list->p_seg->p_data + p_list->pos,
+                   chunk);
+            size        += chunk;
+            p_list->pos += chunk;
+            cdc_acm_tx_list_skip(p_list);
+        }
+        p_next->p_data.tx = (size > 0) ? p_buffer : NULL;
+    }
+    p_next->size = size;
+
+    cdc_acm_tx_list_skip(p_list);
+    if (p_list->count > 0)
+    {
+        return true;
+    }
+
+    // A zero length packet follows the last full packet if requested.
+    return (size == ep_size) && p_list->zlp;
+}
+
+ret_code_t app_usbd_cdc_acm_write_list(app_usbd_cdc_acm_t const *        p_cdc_acm,
+                                       app_usbd_cdc_acm_tx_seg_t const * p_segs,
+                                       size_t                            count)
+{
+    ASSERT((p_segs != NULL) || (count == 0));
+    app_usbd_class_inst_t const * p_inst = app_usbd_cdc_acm_class_inst_get(p_cdc_acm);
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+
+    if (0U == (p_cdc_acm_ctx->line_state & APP_USBD_CDC_ACM_LINE_STATE_DTR))
+    {
+        /*Port is not opened*/
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        total += p_segs[i].length;
     }
+
+    nrf_drv_usbd_ep_t ep = data_ep_in_addr_get(p_inst);
+    ret_code_t        ret;
+
+    CRITICAL_REGION_ENTER();
+    if (nrf_drv_usbd_ep_is_busy(ep))
+    {
+        ret = NRF_ERROR_BUSY;
+    }
+    else
+    {
+        p_cdc_acm_ctx->tx_list.p_seg = p_segs;
+        p_cdc_acm_ctx->tx_list.count = count;
+        p_cdc_acm_ctx->tx_list.pos   = 0;
+        p_cdc_acm_ctx->tx_list.zlp   = APP_USBD_CDC_ACM_ZLP_ON_EPSIZE_WRITE &&
+                                       ((total % NRF_DRV_USBD_EPSIZE) == 0);
+
+        nrf_drv_usbd_handler_desc_t const handler_desc = {
+            .handler.feeder = cdc_acm_list_feeder,
+            .p_context      = &p_cdc_acm_ctx->tx_list
+        };
+
+        ret = app_usbd_ep_handled_transfer(ep, &handler_desc);
+        if (ret == NRF_SUCCESS)
+        {
+            p_cdc_acm_ctx->tx_size = total;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
 }
 
 size_t app_usbd_cdc_acm_rx_size(app_usbd_cdc_acm_t const * p_cdc_acm)
@@ -990,6 +1292,12 @@ ret_code_t app_usbd_cdc_acm_read(app_usbd_cdc_acm_t const * p_cdc_acm,
         return NRF_ERROR_INVALID_STATE;
     }
 
+    if (p_cdc_acm_ctx->rx_ring.p_buf != NULL)
+    {
+        /*Receive ring is used*/
+        return NRF_ERROR_INVALID_STATE;
+    }
+
 #if (APP_USBD_CONFIG_EVENT_QUEUE_ENABLE == 0)
     CRITICAL_REGION_ENTER();
 #endif // (APP_USBD_CONFIG_EVENT_QUEUE_ENABLE == 0)
@@ -1063,6 +1371,12 @@ ret_code_t app_usbd_cdc_acm_read_any(app_usbd_cdc_acm_t const * p_cdc_acm,
         return NRF_ERROR_INVALID_STATE;
     }
 
+    if (p_cdc_acm_ctx->rx_ring.p_buf != NULL)
+    {
+        /*Receive ring is used*/
+        return NRF_ERROR_INVALID_STATE;
+    }
+
 #if (APP_USBD_CONFIG_EVENT_QUEUE_ENABLE == 0)
     CRITICAL_REGION_ENTER();
 #endif // (APP_USBD_CONFIG_EVENT_QUEUE_ENABLE == 0)
@@ -1106,6 +1420,153 @@ ret_code_t app_usbd_cdc_acm_read_any(app_usbd_cdc_acm_t const * p_cdc_acm,
     return ret;
 }
 
+ret_code_t app_usbd_cdc_acm_rx_ring_start(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                          void *                     p_buf,
+                                          size_t                     size)
+{
+    ASSERT(p_buf != NULL);
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+
+    if (size < 2 * NRF_DRV_USBD_EPSIZE)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (0U == (p_cdc_acm_ctx->line_state & APP_USBD_CDC_ACM_LINE_STATE_DTR))
+    {
+        /*Port is not opened*/
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    ret_code_t ret;
+    CRITICAL_REGION_ENTER();
+    if ((p_cdc_acm_ctx->rx_transfer[0].p_buf != NULL) ||
+        (p_cdc_acm_ctx->bytes_left > 0)               ||
+        (p_cdc_acm_ctx->rx_ring.p_buf != NULL))
+    {
+        ret = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        memset(&p_cdc_acm_ctx->rx_ring, 0, sizeof(p_cdc_acm_ctx->rx_ring));
+        p_cdc_acm_ctx->rx_ring.p_buf = p_buf;
+        p_cdc_acm_ctx->rx_ring.size  = size;
+
+        ret = cdc_acm_rx_ring_arm(app_usbd_cdc_acm_class_inst_get(p_cdc_acm));
+        if (ret != NRF_SUCCESS)
+        {
+            p_cdc_acm_ctx->rx_ring.p_buf = NULL;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
+void app_usbd_cdc_acm_rx_ring_stop(app_usbd_cdc_acm_t const * p_cdc_acm)
+{
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+
+    CRITICAL_REGION_ENTER();
+    if (p_cdc_acm_ctx->rx_ring.armed)
+    {
+        nrf_drv_usbd_ep_abort(data_ep_out_addr_get(app_usbd_cdc_acm_class_inst_get(p_cdc_acm)));
+    }
+    memset(&p_cdc_acm_ctx->rx_ring, 0, sizeof(p_cdc_acm_ctx->rx_ring));
+    CRITICAL_REGION_EXIT();
+}
+
+ret_code_t app_usbd_cdc_acm_rx_span_get(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                        uint8_t const **           pp_data,
+                                        size_t *                   p_length)
+{
+    ASSERT(pp_data != NULL);
+    ASSERT(p_length != NULL);
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+    cdc_rx_ring_t *          p_ring        = &p_cdc_acm_ctx->rx_ring;
+    ret_code_t               ret           = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (p_ring->p_buf == NULL)
+    {
+        ret = NRF_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        *p_length = cdc_acm_rx_ring_span(p_ring);
+        *pp_data  = p_ring->p_buf + p_ring->rd;
+        if (*p_length == 0)
+        {
+            ret = NRF_ERROR_NOT_FOUND;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
+ret_code_t app_usbd_cdc_acm_rx_span_release(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                            size_t                     length)
+{
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+    cdc_rx_ring_t *          p_ring        = &p_cdc_acm_ctx->rx_ring;
+    ret_code_t               ret;
+
+    CRITICAL_REGION_ENTER();
+    if (p_ring->p_buf == NULL)
+    {
+        ret = NRF_ERROR_INVALID_STATE;
+    }
+    else if (length > cdc_acm_rx_ring_span(p_ring))
+    {
+        ret = NRF_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        p_ring->rd += length;
+        if (p_ring->wrapped && (p_ring->rd == p_ring->end))
+        {
+            p_ring->rd      = 0;
+            p_ring->wrapped = false;
+        }
+        else if (!p_ring->wrapped && !p_ring->armed && (p_ring->rd == p_ring->wr))
+        {
+            // Ring is empty and no packet is being placed: start over for the longest span.
+            p_ring->rd = 0;
+            p_ring->wr = 0;
+        }
+
+        ret = cdc_acm_rx_ring_arm(app_usbd_cdc_acm_class_inst_get(p_cdc_acm));
+        if (ret == NRF_ERROR_NO_MEM)
+        {
+            ret = NRF_SUCCESS;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+
+void app_usbd_cdc_acm_stats_get(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                app_usbd_cdc_acm_stats_t * p_stats)
+{
+    ASSERT(p_stats != NULL);
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = p_cdc_acm_ctx->stats;
+    CRITICAL_REGION_EXIT();
+}
+
+void app_usbd_cdc_acm_stats_clear(app_usbd_cdc_acm_t const * p_cdc_acm)
+{
+    app_usbd_cdc_acm_ctx_t * p_cdc_acm_ctx = cdc_acm_ctx_get(p_cdc_acm);
+
+    CRITICAL_REGION_ENTER();
+    memset(&p_cdc_acm_ctx->stats, 0, sizeof(p_cdc_acm_ctx->stats));
+    CRITICAL_REGION_EXIT();
+}
+
 static ret_code_t cdc_acm_serial_state_notify(app_usbd_cdc_acm_t const * p_cdc_acm)
 {
     app_usbd_class_inst_t const * p_inst = app_usbd_cdc_acm_class_inst_get(p_cdc_acm);
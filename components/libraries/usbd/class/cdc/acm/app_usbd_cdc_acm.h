@@ -307,6 +307,122 @@ ret_code_t app_usbd_cdc_acm_read_any(app_usbd_cdc_acm_t const * p_cdc_acm,
                                      void *                     p_buf,
                                      size_t                     length);
 
+/**
+ * @brief Writes a scatter list to CDC ACM serial port.
+ *
+ * The segments are sent as a single transfer, as if they were concatenated and written with
+ * @ref app_usbd_cdc_acm_write. Packets that lie entirely in one RAM segment are sent directly
+ * from it; only packets that span segments or lie in flash are copied.
+ *
+ * This is asynchronous call. The class reads the segment list, not a copy of it, while the
+ * transfer is in progress. @p p_segs and the data of every segment must stay valid and unchanged
+ * until the @ref APP_USBD_CDC_ACM_USER_EVT_TX_DONE event, so the list must not be placed on the
+ * stack of a function that returns before that.
+ *
+ * @param[in] p_cdc_acm CDC ACM class instance (defined by @ref APP_USBD_CDC_ACM_GLOBAL_DEF).
+ * @param[in] p_segs    Segment list. Must stay valid until
+ *                      @ref APP_USBD_CDC_ACM_USER_EVT_TX_DONE.
+ * @param[in] count     Number of segments.
+ *
+ * @retval NRF_SUCCESS             Transfer started.
+ * @retval NRF_ERROR_INVALID_STATE Port is not opened.
+ * @retval NRF_ERROR_BUSY          Previous write is still in progress.
+ * @retval other                   Standard error code.
+ */
+ret_code_t app_usbd_cdc_acm_write_list(app_usbd_cdc_acm_t const *        p_cdc_acm,
+                                       app_usbd_cdc_acm_tx_seg_t const * p_segs,
+                                       size_t                            count);
+
+/**
+ * @brief Starts receiving into a user ring buffer.
+ *
+ * Instead of copying through the internal buffer into buffers passed to
+ * @ref app_usbd_cdc_acm_read, every packet is received directly into @p p_buf, and the OUT
+ * endpoint is re-armed by the class as long as there is room for another packet. Each
+ * @ref APP_USBD_CDC_ACM_USER_EVT_RX_DONE event means that new data is available with
+ * @ref app_usbd_cdc_acm_rx_span_get.
+ *
+ * @ref app_usbd_cdc_acm_read and @ref app_usbd_cdc_acm_read_any cannot be used while the ring
+ * is active. The ring is stopped when the port is closed.
+ *
+ * @param[in] p_cdc_acm CDC ACM class instance (defined by @ref APP_USBD_CDC_ACM_GLOBAL_DEF).
+ * @param[in] p_buf     Ring buffer, in RAM.
+ * @param[in] size      Size of the ring buffer. At least two endpoint sizes
+ *                      (@ref NRF_DRV_USBD_EPSIZE).
+ *
+ * @retval NRF_SUCCESS             Reception started.
+ * @retval NRF_ERROR_INVALID_STATE Port is not opened, a read is in progress, or data is
+ *                                 waiting in the internal buffer
+ *                                 (see @ref app_usbd_cdc_acm_bytes_stored).
+ * @retval NRF_ERROR_INVALID_PARAM Buffer is too small.
+ * @retval other                   Standard error code.
+ */
+ret_code_t app_usbd_cdc_acm_rx_ring_start(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                          void *                     p_buf,
+                                          size_t                     size);
+
+/**
+ * @brief Stops receiving into the user ring buffer.
+ *
+ * Data not yet released is discarded.
+ *
+ * @param[in] p_cdc_acm CDC ACM class instance (defined by @ref APP_USBD_CDC_ACM_GLOBAL_DEF).
+ */
+void app_usbd_cdc_acm_rx_ring_stop(app_usbd_cdc_acm_t const * p_cdc_acm);
+
+/**
+ * @brief Gets the oldest contiguous span of received data in the ring buffer.
+ *
+ * The data stays valid until it is released with @ref app_usbd_cdc_acm_rx_span_release.
+ * Received data can be split into two spans at the wrap point of the ring.
+ *
+ * @param[in]  p_cdc_acm CDC ACM class instance (defined by @ref APP_USBD_CDC_ACM_GLOBAL_DEF).
+ * @param[out] pp_data   Start of the span.
+ * @param[out] p_length  Length of the span.
+ *
+ * @retval NRF_SUCCESS             Span returned.
+ * @retval NRF_ERROR_NOT_FOUND     No data received.
+ * @retval NRF_ERROR_INVALID_STATE Receive ring is not active.
+ */
+ret_code_t app_usbd_cdc_acm_rx_span_get(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                        uint8_t const **           pp_data,
+                                        size_t *                   p_length);
+
+/**
+ * @brief Releases data returned by @ref app_usbd_cdc_acm_rx_span_get.
+ *
+ * The space is reused for new packets. The OUT endpoint is re-armed if it was left unarmed
+ * because the ring was full.
+ *
+ * @param[in] p_cdc_acm CDC ACM class instance (defined by @ref APP_USBD_CDC_ACM_GLOBAL_DEF).
+ * @param[in] length    Number of bytes to release, at most the length of the current span.
+ *
+ * @retval NRF_SUCCESS             Data released.
+ * @retval NRF_ERROR_INVALID_STATE Receive ring is not active.
+ * @retval NRF_ERROR_INVALID_LENGTH @p length exceeds the current span.
+ * @retval other                   Standard error code.
+ */
+ret_code_t app_usbd_cdc_acm_rx_span_release(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                            size_t                     length);
+
+/**
+ * @brief Gets the data counters.
+ *
+ * The counters wrap around. Sampling them periodically gives the throughput.
+ *
+ * @param[in]  p_cdc_acm CDC ACM class instance (defined by @ref APP_USBD_CDC_ACM_GLOBAL_DEF).
+ * @param[out] p_stats   Counters.
+ */
+void app_usbd_cdc_acm_stats_get(app_usbd_cdc_acm_t const * p_cdc_acm,
+                                app_usbd_cdc_acm_stats_t * p_stats);
+
+/**
+ * @brief Clears the data counters.
+ *
+ * @param[in] p_cdc_acm CDC ACM class instance (defined by @ref APP_USBD_CDC_ACM_GLOBAL_DEF).
+ */
+void app_usbd_cdc_acm_stats_clear(app_usbd_cdc_acm_t const * p_cdc_acm);
+
 /**
  * @brief Serial state notifications.
  * */
@@ -126,6 +126,55 @@ typedef struct {
     size_t    read_left;    //!< Bytes left to read into buffer.
 } cdc_rx_buffer_t;
 
+/**
+ * @brief CDC ACM receive ring.
+ *
+ * Packets are received back to back. A packet that does not fit before the end of the buffer is
+ * received at its start, and the data then ends at @ref end until the reader wraps around.
+ */
+typedef struct {
+    uint8_t * p_buf;        //!< Ring buffer, NULL if the receive ring is not used.
+    size_t    size;         //!< Size of the ring buffer.
+    size_t    rd;           //!< Read position.
+    size_t    wr;           //!< Write position, end of the received data.
+    size_t    end;          //!< End of the data before the wrap point, valid if @ref wrapped is set.
+    size_t    pending;      //!< Position of the packet being received.
+    size_t    pending_size; //!< Size of the packet being received.
+    bool      wrapped;      //!< The write position has wrapped around and is behind the read position.
+    bool      armed;        //!< An OUT transfer into the ring is set up.
+} cdc_rx_ring_t;
+
+/**
+ * @brief CDC ACM transmit segment.
+ *
+ * @ref app_usbd_cdc_acm_write_list
+ */
+typedef struct {
+    void const * p_data;    //!< Segment data, in RAM or flash.
+    size_t       length;    //!< Segment length.
+} app_usbd_cdc_acm_tx_seg_t;
+
+/**
+ * @brief CDC ACM scatter list transfer state.
+ */
+typedef struct {
+    app_usbd_cdc_acm_tx_seg_t const * p_seg; //!< Current segment.
+    size_t                            count; //!< Number of segments left, including the current one.
+    size_t                            pos;   //!< Position in the current segment.
+    bool                              zlp;   //!< Finish a transfer of a multiple of the endpoint size with a ZLP.
+} cdc_tx_list_t;
+
+/**
+ * @brief CDC ACM data counters.
+ *
+ * @ref app_usbd_cdc_acm_stats_get
+ */
+typedef struct {
+    uint32_t rx_bytes;      //!< Bytes received on the DATA OUT endpoint.
+    uint32_t tx_bytes;      //!< Bytes sent on the DATA IN endpoint.
+    uint32_t rx_ring_full;  //!< Number of times the DATA OUT endpoint was left unarmed because the receive ring was full.
+} app_usbd_cdc_acm_stats_t;
+
 /**
  * @brief CDC ACM class context.
  */
@@ -145,6 +194,12 @@ typedef struct {
     size_t  bytes_read;                             //!< Bytes currently written to user buffer.
     size_t  last_read;                              //!< Bytes read in last transfer.
     size_t  cur_read;                               //!< Bytes currently read to internal buffer.
+
+    cdc_rx_ring_t rx_ring;                          //!< Receive ring.
+    cdc_tx_list_t tx_list;                          //!< Scatter list being sent.
+    size_t        tx_size;                          //!< Bytes in the transfer being sent.
+
+    app_usbd_cdc_acm_stats_t stats;                 //!< Data counters.
 } app_usbd_cdc_acm_ctx_t;
 
 /**
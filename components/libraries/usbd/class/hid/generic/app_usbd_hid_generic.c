@@ -116,6 +116,48 @@ static inline bool hid_generic_transfer_next(app_usbd_hid_generic_t const * p_ge
 }
 
 
+/**
+ * @brief Moves the next pending merged report to the transfer buffer.
+ *
+ * @param[in]  p_generic  HID generic instance.
+ * @param[out] p_rep_buff Report buffer to fill.
+ *
+ * @retval true  Merged report prepared.
+ * @retval false No merged report is pending.
+ */
+static bool hid_generic_merged_pop(app_usbd_hid_generic_t const * p_generic,
+                                   app_usbd_hid_report_buffer_t * p_rep_buff)
+{
+    app_usbd_hid_generic_ctx_t * p_generic_ctx = hid_generic_ctx_get(p_generic);
+    bool                         found         = false;
+
+    CRITICAL_REGION_ENTER();
+    for (uint8_t i = 0; i < p_generic_ctx->merge_count; i++)
+    {
+        uint8_t idx = (p_generic_ctx->merge_next + i) % p_generic_ctx->merge_count;
+        app_usbd_hid_generic_merge_slot_t * p_slot = &p_generic_ctx->p_merge_slots[idx];
+
+        if (p_slot->pending)
+        {
+            /* Second half holds the report being sent */
+            memcpy(p_slot->p_buf + p_slot->size, p_slot->p_buf, p_slot->size);
+            p_slot->pending = false;
+
+            p_rep_buff->p_buff = p_slot->p_buf + p_slot->size;
+            p_rep_buff->size   = p_slot->size;
+
+            /* Round robin between slots */
+            p_generic_ctx->merge_next = (idx + 1) % p_generic_ctx->merge_count;
+            found = true;
+            break;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return found;
+}
+
+
 /**
  * @brief Triggers IN endpoint transfer.
  *
@@ -133,16 +175,19 @@ static inline ret_code_t hid_generic_transfer_set(app_usbd_hid_generic_t const *
     app_usbd_hid_state_flag_clr(&p_generic_ctx->hid_ctx,
                                 APP_USBD_HID_STATE_FLAG_TRANS_IN_PROGRESS);
 
-    if (!hid_generic_transfer_next(p_generic))
-    {
-        return NRF_SUCCESS;
-    }
-
     app_usbd_hid_report_buffer_t * p_rep_buff     = hid_generic_rep_buffer_get(p_generic);
     nrf_queue_t const            * p_rep_in_queue = p_generic->specific.inst.p_rep_in_queue;
+    ret_code_t                     ret;
 
-    ret_code_t ret = nrf_queue_pop(p_rep_in_queue, p_rep_buff);
-    ASSERT(ret == NRF_SUCCESS);
+    if (hid_generic_transfer_next(p_generic))
+    {
+        ret = nrf_queue_pop(p_rep_in_queue, p_rep_buff);
+        ASSERT(ret == NRF_SUCCESS);
+    }
+    else if (!hid_generic_merged_pop(p_generic, p_rep_buff))
+    {
+        return NRF_SUCCESS;
+    }
 
     NRF_DRV_USBD_TRANSFER_IN(transfer, p_rep_buff->p_buff, p_rep_buff->size);
     CRITICAL_REGION_ENTER();
@@ -151,12 +196,76 @@ static inline ret_code_t hid_generic_transfer_set(app_usbd_hid_generic_t const *
     {
         app_usbd_hid_state_flag_set(&p_generic_ctx->hid_ctx,
                                     APP_USBD_HID_STATE_FLAG_TRANS_IN_PROGRESS);
+        p_generic_ctx->stats.sent++;
     }
     CRITICAL_REGION_EXIT();
 
     return ret;
 }
 
+
+/**
+ * @brief Adds a relative field value to a merged report with saturation.
+ *
+ * @param[in,out] p_acc  Field in the merged report.
+ * @param[in]     p_val  Field in the new report.
+ * @param[in]     size   Field size (1 or 2 bytes).
+ *
+ * @retval true  Sum saturated.
+ * @retval false Sum exact.
+ */
+static bool hid_generic_field_add(uint8_t * p_acc, uint8_t const * p_val, uint8_t size)
+{
+    int32_t min = (size == 1) ? INT8_MIN : INT16_MIN;
+    int32_t max = (size == 1) ? INT8_MAX : INT16_MAX;
+    int32_t sum;
+
+    if (size == 1)
+    {
+        sum = (int32_t)(int8_t)p_acc[0] + (int8_t)p_val[0];
+    }
+    else
+    {
+        sum = (int32_t)(int16_t)uint16_decode(p_acc) + (int16_t)uint16_decode(p_val);
+    }
+
+    bool saturated = (sum < min) || (sum > max);
+    sum = MAX(min, MIN(max, sum));
+
+    if (size == 1)
+    {
+        p_acc[0] = (uint8_t)sum;
+    }
+    else
+    {
+        (void)uint16_encode((uint16_t)sum, p_acc);
+    }
+    return saturated;
+}
+
+
+/**
+ * @brief Checks if a report byte belongs to a relative field.
+ *
+ * @param[in] p_slot Coalescing slot.
+ * @param[in] idx    Byte index in the report.
+ *
+ * @retval true  Byte is a part of a relative field.
+ * @retval false Byte keeps the latest value.
+ */
+static bool hid_generic_byte_is_rel(app_usbd_hid_generic_merge_slot_t const * p_slot, size_t idx)
+{
+    for (uint8_t i = 0; i < p_slot->rel_count; i++)
+    {
+        if ((idx >= p_slot->p_rel[i].offset) &&
+            (idx < (size_t)p_slot->p_rel[i].offset + p_slot->p_rel[i].size))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 ret_code_t hid_generic_clear_buffer(app_usbd_class_inst_t const * p_inst)
 {
     ASSERT(p_inst != NULL);
@@ -174,6 +283,11 @@ ret_code_t hid_generic_clear_buffer(app_usbd_class_inst_t const * p_inst)
     }
 
     CRITICAL_REGION_ENTER();
+    for (uint8_t i = 0; i < p_generic_ctx->merge_count; i++)
+    {
+        p_generic_ctx->p_merge_slots[i].pending = false;
+    }
+
     uint8_t iface_count = app_usbd_class_iface_count_get(p_inst);
 
     app_usbd_class_iface_conf_t const * p_iface = NULL;
@@ -215,13 +329,22 @@ ret_code_t app_usbd_hid_generic_in_report_set(app_usbd_hid_generic_t const * p_g
         .p_buff = (void *)p_buff,
         .size   = size,
     };
+    ret_code_t ret;
+
+    CRITICAL_REGION_ENTER();
+    if (nrf_queue_is_full(p_rep_in_queue))
+    {
+        /* Queue works in overflow mode: the oldest report is overwritten */
+        p_generic_ctx->stats.dropped++;
+    }
+    ret = nrf_queue_push(p_rep_in_queue, &rep_buff);
+    CRITICAL_REGION_EXIT();
 
-    if (nrf_queue_push(p_rep_in_queue, &rep_buff) != NRF_SUCCESS)
+    if (ret != NRF_SUCCESS)
     {
         return NRF_ERROR_BUSY;
     }
 
-    ret_code_t ret = NRF_SUCCESS;
     if (app_usbd_hid_trans_required(&p_generic_ctx->hid_ctx) && 
         !p_generic_ctx->hid_ctx.idle_on)
     {
@@ -231,6 +354,144 @@ ret_code_t app_usbd_hid_generic_in_report_set(app_usbd_hid_generic_t const * p_g
     return ret;
 }
 
+ret_code_t app_usbd_hid_generic_merge_set(app_usbd_hid_generic_t const      * p_generic,
+                                          app_usbd_hid_generic_merge_slot_t * p_slots,
+                                          uint8_t                             count)
+{
+    app_usbd_hid_generic_ctx_t * p_generic_ctx = hid_generic_ctx_get(p_generic);
+
+    if (p_slots == NULL)
+    {
+        count = 0;
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        app_usbd_hid_generic_merge_slot_t const * p_slot = &p_slots[i];
+
+        if ((p_slot->p_buf == NULL)            ||
+            (p_slot->size == 0)                ||
+            (p_slot->size > NRF_DRV_USBD_EPSIZE))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        for (uint8_t j = 0; j < p_slot->rel_count; j++)
+        {
+            app_usbd_hid_generic_rel_field_t const * p_rel = &p_slot->p_rel[j];
+
+            if (((p_rel->size != 1) && (p_rel->size != 2)) ||
+                ((size_t)p_rel->offset + p_rel->size > p_slot->size))
+            {
+                return NRF_ERROR_INVALID_PARAM;
+            }
+        }
+    }
+
+    CRITICAL_REGION_ENTER();
+    for (uint8_t i = 0; i < count; i++)
+    {
+        p_slots[i].pending = false;
+    }
+    p_generic_ctx->p_merge_slots = p_slots;
+    p_generic_ctx->merge_count   = count;
+    p_generic_ctx->merge_next    = 0;
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_usbd_hid_generic_in_report_merge(app_usbd_hid_generic_t const * p_generic,
+                                                const void                   * p_buff,
+                                                size_t                         size)
+{
+    ASSERT(p_buff != NULL);
+    app_usbd_hid_generic_ctx_t        * p_generic_ctx = hid_generic_ctx_get(p_generic);
+    uint8_t const                     * p_report      = (uint8_t const *)p_buff;
+    app_usbd_hid_generic_merge_slot_t * p_slot        = NULL;
+
+    for (uint8_t i = 0; i < p_generic_ctx->merge_count; i++)
+    {
+        app_usbd_hid_generic_merge_slot_t * p_cur = &p_generic_ctx->p_merge_slots[i];
+
+        if ((p_cur->size == size) &&
+            ((p_cur->report_id == 0) || (p_cur->report_id == p_report[0])))
+        {
+            p_slot = p_cur;
+            break;
+        }
+    }
+
+    if (p_slot == NULL)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    CRITICAL_REGION_ENTER();
+    if (!p_slot->pending)
+    {
+        memcpy(p_slot->p_buf, p_report, size);
+        p_slot->pending = true;
+    }
+    else
+    {
+        bool saturated = false;
+
+        for (uint8_t i = 0; i < p_slot->rel_count; i++)
+        {
+            app_usbd_hid_generic_rel_field_t const * p_rel = &p_slot->p_rel[i];
+
+            saturated |= hid_generic_field_add(p_slot->p_buf + p_rel->offset,
+                                               p_report + p_rel->offset,
+                                               p_rel->size);
+        }
+
+        for (size_t i = 0; i < size; i++)
+        {
+            if (!hid_generic_byte_is_rel(p_slot, i))
+            {
+                p_slot->p_buf[i] = p_report[i];
+            }
+        }
+
+        p_generic_ctx->stats.merged++;
+        if (saturated)
+        {
+            p_generic_ctx->stats.dropped++;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    ret_code_t ret = NRF_SUCCESS;
+    if (app_usbd_hid_trans_required(&p_generic_ctx->hid_ctx) &&
+        !p_generic_ctx->hid_ctx.idle_on)
+    {
+        ret = hid_generic_transfer_set(p_generic);
+    }
+
+    return ret;
+}
+
+void app_usbd_hid_generic_stats_get(app_usbd_hid_generic_t const * p_generic,
+                                    app_usbd_hid_generic_stats_t * p_stats)
+{
+    ASSERT(p_stats != NULL);
+    app_usbd_hid_generic_ctx_t * p_generic_ctx = hid_generic_ctx_get(p_generic);
+
+    CRITICAL_REGION_ENTER();
+    *p_stats = p_generic_ctx->stats;
+    CRITICAL_REGION_EXIT();
+}
+
+void app_usbd_hid_generic_stats_clear(app_usbd_hid_generic_t const * p_generic)
+{
+    app_usbd_hid_generic_ctx_t * p_generic_ctx = hid_generic_ctx_get(p_generic);
+
+    CRITICAL_REGION_ENTER();
+    memset(&p_generic_ctx->stats, 0, sizeof(p_generic_ctx->stats));
+    CRITICAL_REGION_EXIT();
+}
+
 ret_code_t app_usbd_hid_generic_idle_report_set(app_usbd_hid_generic_t const * p_generic,
                                                 const void                   * p_buff,
                                                 size_t                         size)
@@ -420,20 +681,10 @@ static ret_code_t hid_generic_on_set_report(app_usbd_class_inst_t const * p_inst
  */
 static ret_code_t hid_generic_ep_transfer_in(app_usbd_class_inst_t const * p_inst)
 {
-    app_usbd_hid_generic_t const * p_generic     = hid_generic_get(p_inst);
-    app_usbd_hid_generic_ctx_t   * p_generic_ctx = hid_generic_ctx_get(p_generic);
-
-    nrf_queue_t const * p_rep_in_queue = p_generic->specific.inst.p_rep_in_queue;
-
-    if (nrf_queue_is_empty(p_rep_in_queue))
-    {
-        app_usbd_hid_state_flag_clr(&p_generic_ctx->hid_ctx,
-                                    APP_USBD_HID_STATE_FLAG_TRANS_IN_PROGRESS);
-        return NRF_SUCCESS;
-    }
+    app_usbd_hid_generic_t const * p_generic = hid_generic_get(p_inst);
 
-    /* Get next report to send */
-    return hid_generic_transfer_set((app_usbd_hid_generic_t const *)p_inst);
+    /* Get next report to send: queued or merged. Clears the transfer flag if there is none. */
+    return hid_generic_transfer_set(p_generic);
 }
 
 
@@ -205,6 +205,60 @@ ret_code_t app_usbd_hid_generic_in_report_set(app_usbd_hid_generic_t const * p_g
                                               const void * p_buff,
                                               size_t size);
 
+/**
+ * @brief Sets up IN report coalescing.
+ *
+ * Reports passed to @ref app_usbd_hid_generic_in_report_merge are not queued. Instead, each
+ * report is merged into the slot with the matching report ID: relative fields (for example,
+ * mouse motion deltas) are summed with saturation, and all other bytes take the latest value.
+ * One merged report per slot is sent each time the host polls the IN endpoint, so high-rate
+ * sources do not overflow the IN report queue.
+ *
+ * @param[in] p_generic HID generic class instance.
+ * @param[in] p_slots   Slot array. Must stay valid while in use. NULL disables coalescing.
+ * @param[in] count     Number of slots.
+ *
+ * @retval NRF_SUCCESS             Coalescing set up.
+ * @retval NRF_ERROR_INVALID_PARAM Report or relative field does not fit into a slot.
+ */
+ret_code_t app_usbd_hid_generic_merge_set(app_usbd_hid_generic_t const      * p_generic,
+                                          app_usbd_hid_generic_merge_slot_t * p_slots,
+                                          uint8_t                             count);
+
+/**
+ * @brief New IN report trigger, with coalescing.
+ *
+ * The report is copied. If a report for the same slot is waiting for transfer, both are
+ * merged (see @ref app_usbd_hid_generic_merge_set).
+ *
+ * @param[in] p_generic HID generic class instance.
+ * @param[in] p_buff    Report buffer.
+ * @param[in] size      Report size.
+ *
+ * @retval NRF_SUCCESS         Report stored or merged.
+ * @retval NRF_ERROR_NOT_FOUND No slot matches the report ID and size.
+ * @retval other               Standard error code.
+ */
+ret_code_t app_usbd_hid_generic_in_report_merge(app_usbd_hid_generic_t const * p_generic,
+                                                const void                   * p_buff,
+                                                size_t                         size);
+
+/**
+ * @brief Gets IN report statistics.
+ *
+ * @param[in]  p_generic HID generic class instance.
+ * @param[out] p_stats   Statistics.
+ */
+void app_usbd_hid_generic_stats_get(app_usbd_hid_generic_t const * p_generic,
+                                    app_usbd_hid_generic_stats_t * p_stats);
+
+/**
+ * @brief Clears IN report statistics.
+ *
+ * @param[in] p_generic HID generic class instance.
+ */
+void app_usbd_hid_generic_stats_clear(app_usbd_hid_generic_t const * p_generic);
+
 /**
  * @brief Returns last successful transfered IN report.
  *
@@ -71,12 +71,48 @@ typedef struct {
     nrf_queue_t const * p_rep_in_queue; //!< Input report queue.
 } app_usbd_hid_generic_inst_t;
 
+/**
+ * @brief Relative field of an IN report, summed when reports are merged.
+ */
+typedef struct {
+    uint8_t offset; //!< Offset of the field in the report, in bytes.
+    uint8_t size;   //!< Field size in bytes: 1 or 2 (signed, little endian).
+} app_usbd_hid_generic_rel_field_t;
+
+/**
+ * @brief IN report coalescing slot.
+ *
+ * Reports passed to @ref app_usbd_hid_generic_in_report_merge are merged into the slot while
+ * the IN endpoint is busy, and one merged report is sent when the host polls.
+ */
+typedef struct {
+    uint8_t                                  report_id; //!< Report ID matched against the first report byte, or 0 to match any report.
+    uint8_t                                  size;      //!< Report size in bytes.
+    uint8_t                                  rel_count; //!< Number of relative fields.
+    app_usbd_hid_generic_rel_field_t const * p_rel;     //!< Relative fields. Other bytes keep the latest value.
+    uint8_t                                * p_buf;     //!< Slot memory, 2 * size bytes: merged report and report being sent.
+    bool                                     pending;   //!< Merged report waiting for transfer (internal).
+} app_usbd_hid_generic_merge_slot_t;
+
+/**
+ * @brief HID generic IN report statistics.
+ */
+typedef struct {
+    uint32_t sent;    //!< Reports sent to the host.
+    uint32_t merged;  //!< Reports merged into a pending report.
+    uint32_t dropped; //!< Reports overwritten in the IN report queue, or merged with saturated relative fields.
+} app_usbd_hid_generic_stats_t;
+
 /**
  * @brief HID generic context
  *
  */
 typedef struct {
-    app_usbd_hid_ctx_t hid_ctx;          //!< HID class context.
+    app_usbd_hid_ctx_t                  hid_ctx;       //!< HID class context.
+    app_usbd_hid_generic_merge_slot_t * p_merge_slots; //!< IN report coalescing slots.
+    uint8_t                             merge_count;   //!< Number of coalescing slots.
+    uint8_t                             merge_next;    //!< Slot checked first for the next transfer.
+    app_usbd_hid_generic_stats_t        stats;         //!< IN report statistics.
 } app_usbd_hid_generic_ctx_t;
 
 
@@ -258,7 +258,7 @@ ret_code_t app_usbd_hid_mouse_x_move(app_usbd_hid_mouse_t const * p_mouse, int8_
         return NRF_SUCCESS;
     }
 
-    if (hid_mouse_acc_overflow_check(p_mouse_ctx->acc_y_axis, offset))
+    if (hid_mouse_acc_overflow_check(p_mouse_ctx->acc_x_axis, offset))
     {
         /*Overflow detected*/
         return NRF_ERROR_BUSY;
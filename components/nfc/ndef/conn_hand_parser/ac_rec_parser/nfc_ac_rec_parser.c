@@ -58,12 +58,17 @@
  *                                     null.
  * @retval NRF_ERROR_NO_MEM            If the buffer provided for Data Reference in \p p_ref_field
  *                                     does not have enough space to store it.
- * @retval NRF_ERROR_INVALID_LENGTH    If Data Reference length exceeds record payload.
+ * @retval NRF_ERROR_INVALID_LENGTH    If Data Reference or its length field exceeds record payload.
  */
 static ret_code_t ac_rec_reference_field_parse(uint8_t                    ** const pp_buff,
                                                uint32_t                   *  const p_len,
                                                nfc_ac_rec_data_ref_t      *  const p_ref_field)
 {
+    if (*p_len < AC_REC_DATA_REF_LEN_SIZE)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
     if (p_ref_field->length < **pp_buff)
     {
         return NRF_ERROR_NO_MEM;
@@ -135,6 +140,11 @@ static ret_code_t nfc_ac_payload_parse(uint8_t                    * p_buff,
     VERIFY_SUCCESS(err_code);
 
     // Copy Auxiliary Data Reference to ac record payload descriptor.
+    if (*p_len < AC_REC_AUX_DATA_REF_COUNT_SIZE)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
     if ( p_ac_rec_payload_data->aux_data_ref_count < *p_buff)
     {
         return NRF_ERROR_NO_MEM;
@@ -165,26 +175,46 @@ static ret_code_t nfc_ac_payload_parse(uint8_t                    * p_buff,
     return NRF_SUCCESS;
 }
 
-ret_code_t nfc_ac_rec_parse(nfc_ndef_record_desc_t    const * const p_rec_desc,
-                            nfc_ac_rec_payload_desc_t       * const p_ac_rec_payload_data)
+/**
+ * @brief Function for checking if the record type matches the Alternative Carrier record.
+ *
+ * @param[in] tnf          Type Name Format of the record.
+ * @param[in] p_type       Pointer to the record type.
+ * @param[in] type_length  Length of the record type.
+ *
+ * @retval NRF_SUCCESS                 If the type matches.
+ * @retval NRF_ERROR_INVALID_DATA      If the NDEF record type or TNF is incorrect.
+ */
+static ret_code_t ac_rec_type_check(nfc_ndef_record_tnf_t         tnf,
+                                    uint8_t               const * p_type,
+                                    uint8_t                       type_length)
 {
-    ret_code_t err_code;
-
-    if (p_rec_desc->tnf != TNF_WELL_KNOWN)
+    if (tnf != TNF_WELL_KNOWN)
     {
         return NRF_ERROR_INVALID_DATA;
     }
 
-    if (p_rec_desc->type_length != sizeof(nfc_ac_rec_type_field))
+    if (type_length != sizeof(nfc_ac_rec_type_field))
     {
         return NRF_ERROR_INVALID_DATA;
     }
 
-    if (memcmp(p_rec_desc->p_type, nfc_ac_rec_type_field, sizeof(nfc_ac_rec_type_field)) != 0)
+    if (memcmp(p_type, nfc_ac_rec_type_field, sizeof(nfc_ac_rec_type_field)) != 0)
     {
         return NRF_ERROR_INVALID_DATA;
     }
 
+    return NRF_SUCCESS;
+}
+
+ret_code_t nfc_ac_rec_parse(nfc_ndef_record_desc_t    const * const p_rec_desc,
+                            nfc_ac_rec_payload_desc_t       * const p_ac_rec_payload_data)
+{
+    ret_code_t err_code;
+
+    err_code = ac_rec_type_check(p_rec_desc->tnf, p_rec_desc->p_type, p_rec_desc->type_length);
+    VERIFY_SUCCESS(err_code);
+
     if (p_rec_desc->payload_constructor != (p_payload_constructor_t) nfc_ndef_bin_payload_memcopy)
     {
         return NRF_ERROR_NOT_SUPPORTED;
@@ -202,4 +232,26 @@ ret_code_t nfc_ac_rec_parse(nfc_ndef_record_desc_t    const * const p_rec_desc,
     return err_code;
 }
 
+ret_code_t nfc_ac_rec_iter_parse(nfc_ndef_msg_iter_record_t const * const p_record,
+                                 nfc_ac_rec_payload_desc_t        * const p_ac_rec_payload_data)
+{
+    ret_code_t err_code;
+
+    err_code = ac_rec_type_check(p_record->tnf, p_record->p_type, p_record->type_length);
+    VERIFY_SUCCESS(err_code);
+
+    if (p_record->chunk_count > 1)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    uint32_t payload_length = p_record->payload_length;
+
+    err_code = nfc_ac_payload_parse((uint8_t *) p_record->p_payload,
+                                    &payload_length,
+                                    p_ac_rec_payload_data);
+
+    return err_code;
+}
+
 #endif // NRF_MODULE_ENABLED(NFC_AC_REC_PARSER)
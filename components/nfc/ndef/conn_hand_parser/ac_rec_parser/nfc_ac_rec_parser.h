@@ -49,6 +49,7 @@
 #define __NFC_AC_REC_PARSER_H__
 
 #include "nfc_ndef_record.h"
+#include "nfc_ndef_msg_iter.h"
 #include "nfc_ac_rec.h"
 
 #ifdef __cplusplus
@@ -79,6 +80,26 @@ extern "C" {
 ret_code_t nfc_ac_rec_parse(nfc_ndef_record_desc_t    const * const p_rec_desc,
                             nfc_ac_rec_payload_desc_t       * const p_ac_rec_payload_data);
 
+/**
+ * @brief Function for parsing a record returned by the NDEF message iterator as Alternative
+ *        Carrier record.
+ *
+ * This function works like @ref nfc_ac_rec_parse, but on a record returned by
+ * @ref nfc_ndef_msg_iter_next, so no message descriptor is needed. A chunked record must be
+ * reassembled with @ref nfc_ndef_msg_iter_payload_reassemble first.
+ *
+ * @param[in]     p_record               Pointer to the record.
+ * @param[in,out] p_ac_rec_payload_data  Pointer to the structure that will be used to hold
+ *                                       parsed data.
+ *
+ * @retval NRF_SUCCESS                 If the function completed successfully.
+ * @retval NRF_ERROR_INVALID_DATA      If the NDEF record type or TNF is incorrect.
+ * @retval NRF_ERROR_NOT_SUPPORTED     If the payload has not been reassembled.
+ * @retval Other                       Other error codes as returned by @ref nfc_ac_rec_parse.
+ */
+ret_code_t nfc_ac_rec_iter_parse(nfc_ndef_msg_iter_record_t const * const p_record,
+                                 nfc_ac_rec_payload_desc_t        * const p_ac_rec_payload_data);
+
 #ifdef __cplusplus
 }
 #endif
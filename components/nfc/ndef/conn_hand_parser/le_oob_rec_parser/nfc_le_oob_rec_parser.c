@@ -53,6 +53,7 @@
  *                                             parsed data.
  *
  * @retval NRF_SUCCESS              If the function completed successfully.
+ * @retval NRF_ERROR_INVALID_LENGTH If the payload is longer than AD Type data can be.
  * @retval Other                    An error code that might have been returned by
  *                                  @ref nfc_ble_oob_advdata_parse function.
  */
@@ -60,32 +61,58 @@ static ret_code_t nfc_le_oob_payload_parse(uint8_t                    * p_buff,
                                            uint32_t                   * const p_len,
                                            nfc_ble_oob_pairing_data_t * const p_nfc_ble_oob_pairing_data)
 {
+    // The AD Type parser takes an 8-bit length.
+    if (*p_len > UINT8_MAX)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
     ret_code_t err_code = nfc_ble_oob_advdata_parse(p_buff,
                                                     *p_len,
                                                     p_nfc_ble_oob_pairing_data);
     return err_code;
 }
 
-ret_code_t nfc_le_oob_rec_parse(nfc_ndef_record_desc_t     const * const p_rec_desc,
-                                nfc_ble_oob_pairing_data_t       * const p_nfc_ble_oob_pairing_data)
+/**
+ * @brief Function for checking if the record type matches the LE OOB record.
+ *
+ * @param[in] tnf          Type Name Format of the record.
+ * @param[in] p_type       Pointer to the record type.
+ * @param[in] type_length  Length of the record type.
+ *
+ * @retval NRF_SUCCESS              If the type matches.
+ * @retval NRF_ERROR_INVALID_DATA   If the NDEF record type or TNF is incorrect.
+ */
+static ret_code_t le_oob_rec_type_check(nfc_ndef_record_tnf_t         tnf,
+                                        uint8_t               const * p_type,
+                                        uint8_t                       type_length)
 {
-    ret_code_t err_code;
-
-    if (p_rec_desc->tnf != TNF_MEDIA_TYPE)
+    if (tnf != TNF_MEDIA_TYPE)
     {
         return NRF_ERROR_INVALID_DATA;
     }
 
-    if (p_rec_desc->type_length != sizeof(le_oob_rec_type_field))
+    if (type_length != sizeof(le_oob_rec_type_field))
     {
         return NRF_ERROR_INVALID_DATA;
     }
 
-    if (memcmp(p_rec_desc->p_type, le_oob_rec_type_field, sizeof(le_oob_rec_type_field)) != 0)
+    if (memcmp(p_type, le_oob_rec_type_field, sizeof(le_oob_rec_type_field)) != 0)
     {
         return NRF_ERROR_INVALID_DATA;
     }
 
+    return NRF_SUCCESS;
+}
+
+ret_code_t nfc_le_oob_rec_parse(nfc_ndef_record_desc_t     const * const p_rec_desc,
+                                nfc_ble_oob_pairing_data_t       * const p_nfc_ble_oob_pairing_data)
+{
+    ret_code_t err_code;
+
+    err_code = le_oob_rec_type_check(p_rec_desc->tnf, p_rec_desc->p_type, p_rec_desc->type_length);
+    VERIFY_SUCCESS(err_code);
+
     if (p_rec_desc->payload_constructor != (p_payload_constructor_t) nfc_ndef_bin_payload_memcopy)
     {
         return NRF_ERROR_NOT_SUPPORTED;
@@ -101,4 +128,26 @@ ret_code_t nfc_le_oob_rec_parse(nfc_ndef_record_desc_t     const * const p_rec_d
     return err_code;
 }
 
+ret_code_t nfc_le_oob_rec_iter_parse(nfc_ndef_msg_iter_record_t const * const p_record,
+                                     nfc_ble_oob_pairing_data_t       * const p_nfc_ble_oob_pairing_data)
+{
+    ret_code_t err_code;
+
+    err_code = le_oob_rec_type_check(p_record->tnf, p_record->p_type, p_record->type_length);
+    VERIFY_SUCCESS(err_code);
+
+    if (p_record->chunk_count > 1)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    uint32_t payload_length = p_record->payload_length;
+
+    err_code = nfc_le_oob_payload_parse((uint8_t *) p_record->p_payload,
+                                        &payload_length,
+                                        p_nfc_ble_oob_pairing_data);
+
+    return err_code;
+}
+
 #endif // NRF_MODULE_ENABLED(NFC_LE_OOB_REC_PARSER)
@@ -49,6 +49,7 @@
 #define __NFC_LE_OOB_REC_PARSER_H__
 
 #include "nfc_ndef_record.h"
+#include "nfc_ndef_msg_iter.h"
 #include "nfc_ble_oob_advdata_parser.h"
 #include "nfc_ble_pair_common.h"
 
@@ -70,12 +71,33 @@ extern "C" {
  * @retval NRF_SUCCESS              If the function completed successfully.
  * @retval NRF_ERROR_INVALID_DATA   If the NDEF record type or TNF is incorrect.
  * @retval NRF_ERROR_NOT_SUPPORTED  If the payload descriptor is not binary.
+ * @retval NRF_ERROR_INVALID_LENGTH If the payload is longer than AD Type data can be.
  * @retval Other                    An error code that might have been returned by
  *                                  @ref nfc_ble_oob_advdata_parse function.
  */
 ret_code_t nfc_le_oob_rec_parse(nfc_ndef_record_desc_t     const * const p_rec_desc,
                                 nfc_ble_oob_pairing_data_t       * const p_nfc_ble_oob_pairing_data);
 
+/**
+ * @brief Function for parsing a record returned by the NDEF message iterator as LE OOB record.
+ *
+ * This function works like @ref nfc_le_oob_rec_parse, but on a record returned by
+ * @ref nfc_ndef_msg_iter_next, so no message descriptor is needed. A chunked record must be
+ * reassembled with @ref nfc_ndef_msg_iter_payload_reassemble first.
+ *
+ * @param[in]     p_record                     Pointer to the record.
+ * @param[in,out] p_nfc_ble_oob_pairing_data   Pointer to the structure that will be used to hold
+ *                                             parsed data.
+ *
+ * @retval NRF_SUCCESS              If the function completed successfully.
+ * @retval NRF_ERROR_INVALID_DATA   If the NDEF record type or TNF is incorrect.
+ * @retval NRF_ERROR_NOT_SUPPORTED  If the payload has not been reassembled.
+ * @retval Other                    An error code that might have been returned by
+ *                                  @ref nfc_le_oob_rec_parse function.
+ */
+ret_code_t nfc_le_oob_rec_iter_parse(nfc_ndef_msg_iter_record_t const * const p_record,
+                                     nfc_ble_oob_pairing_data_t       * const p_nfc_ble_oob_pairing_data);
+
 #ifdef __cplusplus
 }
 #endif
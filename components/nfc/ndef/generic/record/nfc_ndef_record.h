@@ -61,6 +61,7 @@ extern "C" {
  */
 
 
+#define NDEF_RECORD_CF_MASK                0x20 ///< Mask of the CF flag. If set, this flag indicates that the record is a chunk of a chunked payload, followed by further chunks.
 #define NDEF_RECORD_IL_MASK                0x08 ///< Mask of the ID field presence bit in the flags byte of an NDEF record.
 #define NDEF_RECORD_TNF_MASK               0x07 ///< Mask of the TNF value field in the first byte of an NDEF record.
 #define NDEF_RECORD_SR_MASK                0x10 ///< Mask of the SR flag. If set, this flag indicates that the PAYLOAD_LENGTH field has a size of 1 byte. Otherwise, PAYLOAD_LENGTH has 4 bytes.
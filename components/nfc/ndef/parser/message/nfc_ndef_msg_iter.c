@@ -0,0 +1,282 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NFC_NDEF_MSG_PARSER)
+
+#include <string.h>
+#include "nfc_ndef_msg_iter.h"
+#include "nfc_ndef_record_parser.h"
+
+/**
+ * @brief Function for decoding the record at the iterator position and moving past it.
+ *
+ * @param[in,out] p_iter         Pointer to the iterator.
+ * @param[out]    p_bin_pay_desc Pointer to the binary payload descriptor of the record.
+ * @param[out]    p_rec_desc     Pointer to the record descriptor.
+ * @param[out]    p_chunked      Set to true if the CF flag of the record is set.
+ */
+static ret_code_t raw_record_get(nfc_ndef_msg_iter_t         * const p_iter,
+                                 nfc_ndef_bin_payload_desc_t * const p_bin_pay_desc,
+                                 nfc_ndef_record_desc_t      * const p_rec_desc,
+                                 bool                        * const p_chunked)
+{
+    nfc_ndef_record_location_t record_location;
+
+    uint8_t const * p_nfc_data   = p_iter->p_nfc_data + p_iter->offset;
+    uint32_t        nfc_data_len = p_iter->nfc_data_len - p_iter->offset;
+
+    // The previous record was not marked as the last one.
+    if (nfc_data_len == 0)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    ret_code_t ret_code = ndef_record_parser(p_bin_pay_desc,
+                                             p_rec_desc,
+                                             &record_location,
+                                             p_nfc_data,
+                                             &nfc_data_len);
+    VERIFY_SUCCESS(ret_code);
+
+    // verify the records location flags
+    if (p_iter->offset == 0)
+    {
+        if ((record_location != NDEF_FIRST_RECORD) && (record_location != NDEF_LONE_RECORD))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+    }
+    else
+    {
+        if ((record_location != NDEF_MIDDLE_RECORD) && (record_location != NDEF_LAST_RECORD))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+    }
+
+    *p_chunked      = ((*p_nfc_data) & NDEF_RECORD_CF_MASK) != 0;
+    p_iter->offset += nfc_data_len;
+    p_iter->end     = (record_location == NDEF_LAST_RECORD) ||
+                      (record_location == NDEF_LONE_RECORD);
+
+    return NRF_SUCCESS;
+}
+
+
+/**
+ * @brief Function for skipping the remaining chunks of a chunked payload.
+ *
+ * Chunks that follow the first one must have the TNF field set to Unchanged and must have
+ * neither a type nor an ID. The last chunk has the CF flag cleared.
+ */
+static ret_code_t chunks_skip(nfc_ndef_msg_iter_t        * const p_iter,
+                              nfc_ndef_msg_iter_record_t * const p_record)
+{
+    nfc_ndef_bin_payload_desc_t bin_pay_desc;
+    nfc_ndef_record_desc_t      rec_desc;
+    bool                        chunked = true;
+    ret_code_t                  ret_code;
+
+    while (chunked)
+    {
+        // The message cannot end in the middle of a chunked payload.
+        if (p_iter->end)
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+
+        ret_code = raw_record_get(p_iter, &bin_pay_desc, &rec_desc, &chunked);
+        VERIFY_SUCCESS(ret_code);
+
+        if ((rec_desc.tnf != TNF_UNCHANGED) ||
+            (rec_desc.type_length != 0)     ||
+            (rec_desc.id_length != 0))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+
+        if (bin_pay_desc.payload_length > UINT32_MAX - p_record->payload_length)
+        {
+            return NRF_ERROR_INVALID_LENGTH;
+        }
+
+        p_record->payload_length += bin_pay_desc.payload_length;
+        p_record->chunk_count++;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+void nfc_ndef_msg_iter_init(nfc_ndef_msg_iter_t * const p_iter,
+                            uint8_t       const * const p_nfc_data,
+                            uint32_t                    nfc_data_len)
+{
+    p_iter->p_nfc_data   = p_nfc_data;
+    p_iter->nfc_data_len = nfc_data_len;
+    p_iter->offset       = 0;
+    p_iter->end          = false;
+}
+
+
+ret_code_t nfc_ndef_msg_iter_next(nfc_ndef_msg_iter_t        * const p_iter,
+                                  nfc_ndef_msg_iter_record_t * const p_record)
+{
+    nfc_ndef_bin_payload_desc_t bin_pay_desc;
+    nfc_ndef_record_desc_t      rec_desc;
+    bool                        chunked;
+    uint32_t                    record_offset = p_iter->offset;
+    ret_code_t                  ret_code;
+
+    if (p_iter->end)
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    ret_code = raw_record_get(p_iter, &bin_pay_desc, &rec_desc, &chunked);
+
+    // A chunk with the TNF field set to Unchanged can only follow the first chunk.
+    if ((ret_code == NRF_SUCCESS) && (rec_desc.tnf == TNF_UNCHANGED))
+    {
+        ret_code = NRF_ERROR_INVALID_DATA;
+    }
+
+    if (ret_code == NRF_SUCCESS)
+    {
+        p_record->tnf            = rec_desc.tnf;
+        p_record->p_type         = rec_desc.p_type;
+        p_record->type_length    = rec_desc.type_length;
+        p_record->p_id           = rec_desc.p_id;
+        p_record->id_length      = rec_desc.id_length;
+        p_record->p_payload      = bin_pay_desc.p_payload;
+        p_record->payload_length = bin_pay_desc.payload_length;
+        p_record->chunk_count    = 1;
+        p_record->p_chunks       = NULL;
+        p_record->chunks_length  = 0;
+
+        if (chunked)
+        {
+            ret_code = chunks_skip(p_iter, p_record);
+
+            p_record->p_payload     = NULL;
+            p_record->p_chunks      = p_iter->p_nfc_data + record_offset;
+            p_record->chunks_length = p_iter->offset - record_offset;
+        }
+    }
+
+    if (ret_code != NRF_SUCCESS)
+    {
+        p_iter->end = true;
+    }
+
+    return ret_code;
+}
+
+
+uint32_t nfc_ndef_msg_iter_offset_get(nfc_ndef_msg_iter_t const * const p_iter)
+{
+    return p_iter->offset;
+}
+
+
+ret_code_t nfc_ndef_msg_iter_payload_reassemble(nfc_ndef_msg_iter_record_t * const p_record,
+                                                uint8_t                    * const p_buf,
+                                                uint32_t                           buf_len)
+{
+    nfc_ndef_bin_payload_desc_t bin_pay_desc;
+    nfc_ndef_record_desc_t      rec_desc;
+    nfc_ndef_record_location_t  record_location;
+    ret_code_t                  ret_code;
+
+    if (p_record->chunk_count <= 1)
+    {
+        return NRF_SUCCESS;
+    }
+
+    VERIFY_PARAM_NOT_NULL(p_buf);
+
+    if (buf_len < p_record->payload_length)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    uint8_t const * p_chunk    = p_record->p_chunks;
+    uint32_t        chunks_len = p_record->chunks_length;
+    uint32_t        copied     = 0;
+
+    while (chunks_len > 0)
+    {
+        uint32_t chunk_len = chunks_len;
+
+        ret_code = ndef_record_parser(&bin_pay_desc,
+                                      &rec_desc,
+                                      &record_location,
+                                      p_chunk,
+                                      &chunk_len);
+        if ((ret_code != NRF_SUCCESS) ||
+            (bin_pay_desc.payload_length > p_record->payload_length - copied))
+        {
+            return NRF_ERROR_INVALID_DATA;
+        }
+
+        if (bin_pay_desc.payload_length > 0)
+        {
+            memcpy(p_buf + copied, bin_pay_desc.p_payload, bin_pay_desc.payload_length);
+            copied += bin_pay_desc.payload_length;
+        }
+
+        p_chunk    += chunk_len;
+        chunks_len -= chunk_len;
+    }
+
+    if (copied != p_record->payload_length)
+    {
+        return NRF_ERROR_INVALID_DATA;
+    }
+
+    p_record->p_payload     = (copied > 0) ? p_buf : NULL;
+    p_record->chunk_count   = 1;
+    p_record->p_chunks      = NULL;
+    p_record->chunks_length = 0;
+
+    return NRF_SUCCESS;
+}
+
+#endif // NRF_MODULE_ENABLED(NFC_NDEF_MSG_PARSER)
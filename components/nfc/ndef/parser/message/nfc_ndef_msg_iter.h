@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef NFC_NDEF_MSG_ITER_H__
+#define NFC_NDEF_MSG_ITER_H__
+
+/**@file
+ *
+ * @defgroup nfc_ndef_msg_iter Iterator over NDEF messages
+ * @{
+ * @ingroup  nfc_ndef_parser
+ *
+ * @brief    Zero-copy iterator over the records of a raw NFC NDEF message.
+ *
+ * Unlike @ref ndef_msg_parser, the iterator does not build a message descriptor, so it does not
+ * need a memory buffer that grows with the number of records. Each call to
+ * @ref nfc_ndef_msg_iter_next decodes one record and returns its type, ID, and payload as
+ * pointers into the raw message, which must stay unchanged while the record is in use.
+ *
+ * A chunked payload is returned as a single record. Its payload is not contiguous in the raw
+ * message, and it can be reassembled into a caller-provided buffer with
+ * @ref nfc_ndef_msg_iter_payload_reassemble when needed.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sdk_errors.h"
+#include "nfc_ndef_record.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief NDEF record returned by the iterator.
+ */
+typedef struct
+{
+    nfc_ndef_record_tnf_t   tnf;            ///< Type Name Format of the record.
+    uint8_t         const * p_type;         ///< Type field, or NULL if the type is empty.
+    uint8_t                 type_length;    ///< Length of the Type field.
+    uint8_t         const * p_id;           ///< ID field, or NULL if the record has no ID.
+    uint8_t                 id_length;      ///< Length of the ID field.
+    uint8_t         const * p_payload;      ///< Payload, or NULL if the payload is empty or chunked and not reassembled.
+    uint32_t                payload_length; ///< Length of the payload, summed over all chunks.
+    uint32_t                chunk_count;    ///< Number of chunks that the payload is still split into. 1 for a contiguous payload.
+    uint8_t         const * p_chunks;       ///< Raw chunk records, used for reassembly. NULL for a contiguous payload.
+    uint32_t                chunks_length;  ///< Length of the raw chunk records.
+} nfc_ndef_msg_iter_record_t;
+
+/**
+ * @brief Iterator state.
+ */
+typedef struct
+{
+    uint8_t const * p_nfc_data;   ///< Raw NDEF message.
+    uint32_t        nfc_data_len; ///< Size of the raw data.
+    uint32_t        offset;       ///< Offset of the next record in the raw data.
+    bool            end;          ///< The last record has been returned or an error has occurred.
+} nfc_ndef_msg_iter_t;
+
+/**
+ * @brief Function for initializing an iterator over an NDEF message.
+ *
+ * @param[out] p_iter       Pointer to the iterator.
+ * @param[in]  p_nfc_data   Pointer to the raw NDEF message.
+ * @param[in]  nfc_data_len Size of the data in the @p p_nfc_data buffer. The buffer may contain
+ *                          more data after the end of the message.
+ */
+void nfc_ndef_msg_iter_init(nfc_ndef_msg_iter_t * const p_iter,
+                            uint8_t       const * const p_nfc_data,
+                            uint32_t                    nfc_data_len);
+
+/**
+ * @brief Function for getting the next record of an NDEF message.
+ *
+ * The function validates the record location flags and the chunk structure in the same way as
+ * @ref ndef_msg_parser. After an error, the iteration ends.
+ *
+ * @param[in,out] p_iter   Pointer to the iterator.
+ * @param[out]    p_record Pointer to the structure that will be filled with the record.
+ *
+ * @retval NRF_SUCCESS               If the record was returned.
+ * @retval NRF_ERROR_NOT_FOUND       If the last record of the message has already been returned.
+ * @retval NRF_ERROR_INVALID_LENGTH  If the record is longer than the remaining input data.
+ * @retval NRF_ERROR_INVALID_DATA    If the message is not a valid NDEF message.
+ */
+ret_code_t nfc_ndef_msg_iter_next(nfc_ndef_msg_iter_t        * const p_iter,
+                                  nfc_ndef_msg_iter_record_t * const p_record);
+
+/**
+ * @brief Function for getting the length of the part of the raw data that has been iterated over.
+ *
+ * When @ref nfc_ndef_msg_iter_next has returned NRF_ERROR_NOT_FOUND, this is the length of
+ * the whole NDEF message.
+ *
+ * @param[in] p_iter Pointer to the iterator.
+ *
+ * @return Number of bytes of the raw data consumed so far.
+ */
+uint32_t nfc_ndef_msg_iter_offset_get(nfc_ndef_msg_iter_t const * const p_iter);
+
+/**
+ * @brief Function for reassembling a chunked payload into a contiguous buffer.
+ *
+ * On success, the record's @c p_payload points to @p p_buf. The function does nothing for
+ * a record that is not chunked; its @c p_payload already points into the raw message.
+ *
+ * @param[in,out] p_record Pointer to a record returned by @ref nfc_ndef_msg_iter_next.
+ *                         The raw message must not have been changed since.
+ * @param[out]    p_buf    Pointer to the buffer for the payload.
+ * @param[in]     buf_len  Size of the @p p_buf buffer.
+ *
+ * @retval NRF_SUCCESS             If the payload is contiguous.
+ * @retval NRF_ERROR_NULL          If @p p_buf is NULL and the payload needs to be reassembled.
+ * @retval NRF_ERROR_NO_MEM        If the buffer is too small to hold the payload.
+ * @retval NRF_ERROR_INVALID_DATA  If the raw message has been changed.
+ */
+ret_code_t nfc_ndef_msg_iter_payload_reassemble(nfc_ndef_msg_iter_record_t * const p_record,
+                                                uint8_t                    * const p_buf,
+                                                uint32_t                           buf_len);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NFC_NDEF_MSG_ITER_H__
@@ -127,13 +127,18 @@ ret_code_t ndef_record_parser(nfc_ndef_bin_payload_desc_t * p_bin_pay_desc,
         p_rec_desc->p_id      = NULL;
     }
 
-    expected_rec_size += p_rec_desc->type_length + p_rec_desc->id_length + payload_lenght;
+    expected_rec_size += p_rec_desc->type_length + p_rec_desc->id_length;
 
-    if (expected_rec_size > *p_nfc_data_len)
+    // Compare before adding the payload length, a long record can declare up to 4 GB of payload
+    // and the sum would wrap around.
+    if ((expected_rec_size > *p_nfc_data_len) ||
+        (payload_lenght > *p_nfc_data_len - expected_rec_size))
     {
         return NRF_ERROR_INVALID_LENGTH;
     }
 
+    expected_rec_size += payload_lenght;
+
     if (p_rec_desc->type_length > 0)
     {
         p_rec_desc->p_type = p_nfc_data;
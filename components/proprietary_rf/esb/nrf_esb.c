@@ -81,6 +81,13 @@ typedef enum {
 #define DISABLE_RF_IRQ()      NVIC_DisableIRQ(RADIO_IRQn)
 #define ENABLE_RF_IRQ()       NVIC_EnableIRQ(RADIO_IRQn)
 
+#ifdef NRF_SIM
+// The simulated radio only advances while time passes, see @ref nrf_sim.
+#define RADIO_DISABLE_WAIT()  nrf_delay_us(1)
+#else
+#define RADIO_DISABLE_WAIT()
+#endif
+
 #define _RADIO_SHORTS_COMMON ( RADIO_SHORTS_READY_START_Msk | RADIO_SHORTS_END_DISABLE_Msk | \
             RADIO_SHORTS_ADDRESS_RSSISTART_Msk | RADIO_SHORTS_DISABLED_RSSISTOP_Msk )
 
@@ -177,6 +184,7 @@ static nrf_esb_payload_rx_fifo_t    m_rx_fifo;
 // Payload buffers
 static  uint8_t                     m_tx_payload_buffer[NRF_ESB_MAX_PAYLOAD_LENGTH + 2];
 static  uint8_t                     m_rx_payload_buffer[NRF_ESB_MAX_PAYLOAD_LENGTH + 2];
+static  uint8_t                   * mp_rx_buffer = m_rx_payload_buffer;   /**< Buffer that NRF_RADIO->PACKETPTR points to when receiving. */
 
 // Random access buffer variables for better ACK payload handling
 nrf_esb_payload_random_access_buf_wrapper_t m_ack_pl_container[NRF_ESB_TX_FIFO_SIZE];
@@ -501,11 +509,45 @@ uint32_t nrf_esb_skip_tx()
     return NRF_SUCCESS;
 }
 
+#if NRF_ESB_RX_ZERO_COPY
+// The radio writes the two header bytes in front of the data, into the noack and pid fields.
+STATIC_ASSERT(offsetof(nrf_esb_payload_t, data) - offsetof(nrf_esb_payload_t, noack) == 2);
+#endif
+
+
+/** @brief  Function to select the buffer for the next packet to be received.
+ *
+ *  Without @ref NRF_ESB_RX_ZERO_COPY, packets are always received into m_rx_payload_buffer.
+ *  With it, the radio receives directly into the next free RX FIFO entry. The buffer is laid
+ *  out as on air, starting with the two header bytes, which end up in the noack and pid fields
+ *  of the entry until @ref rx_fifo_push_rfbuf fixes them up. If the RX FIFO is full,
+ *  m_rx_payload_buffer is used instead.
+ *
+ *  @return Buffer to assign to NRF_RADIO->PACKETPTR.
+ */
+static uint8_t * rx_buffer_select(void)
+{
+#if NRF_ESB_RX_ZERO_COPY
+    if (m_rx_fifo.count < NRF_ESB_RX_FIFO_SIZE)
+    {
+        mp_rx_buffer = &m_rx_fifo.p_payload[m_rx_fifo.entry_point]->noack;
+    }
+    else
+    {
+        mp_rx_buffer = m_rx_payload_buffer;
+    }
+#endif
+
+    return mp_rx_buffer;
+}
+
+
 /** @brief  Function to push the content of the rx_buffer to the RX FIFO.
  *
  *  The module will point the register NRF_RADIO->PACKETPTR to a buffer for receiving packets.
  *  After receiving a packet the module will call this function to copy the received data to
- *  the RX FIFO.
+ *  the RX FIFO. With @ref NRF_ESB_RX_ZERO_COPY the data is normally already in place, and only
+ *  the packet information is filled in.
  *
  *  @param  pipe Pipe number to set for the packet.
  *  @param  pid  Packet ID.
@@ -517,32 +559,39 @@ static bool rx_fifo_push_rfbuf(uint8_t pipe, uint8_t pid)
 {
     if (m_rx_fifo.count < NRF_ESB_RX_FIFO_SIZE)
     {
+        nrf_esb_payload_t * p_payload = m_rx_fifo.p_payload[m_rx_fifo.entry_point];
+        uint8_t             s1        = mp_rx_buffer[1];
+
         if (m_config_local.protocol == NRF_ESB_PROTOCOL_ESB_DPL)
         {
-            if (m_rx_payload_buffer[0] > NRF_ESB_MAX_PAYLOAD_LENGTH)
+            if (mp_rx_buffer[0] > NRF_ESB_MAX_PAYLOAD_LENGTH)
             {
                 return false;
             }
 
-            m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length = m_rx_payload_buffer[0];
+            p_payload->length = mp_rx_buffer[0];
         }
         else if (m_config_local.mode == NRF_ESB_MODE_PTX)
         {
             // Received packet is an acknowledgment
-            m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length = 0;
+            p_payload->length = 0;
         }
         else
         {
-            m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length = m_config_local.payload_length;
+            p_payload->length = m_config_local.payload_length;
         }
 
-        memcpy(m_rx_fifo.p_payload[m_rx_fifo.entry_point]->data, &m_rx_payload_buffer[2],
-               m_rx_fifo.p_payload[m_rx_fifo.entry_point]->length);
+        if (mp_rx_buffer != &p_payload->noack)
+        {
+            // Always the case without NRF_ESB_RX_ZERO_COPY. With it, the packet was received
+            // while the RX FIFO was full, or into an entry discarded by nrf_esb_flush_rx().
+            memcpy(p_payload->data, &mp_rx_buffer[2], p_payload->length);
+        }
 
-        m_rx_fifo.p_payload[m_rx_fifo.entry_point]->pipe  = pipe;
-        m_rx_fifo.p_payload[m_rx_fifo.entry_point]->rssi  = NRF_RADIO->RSSISAMPLE;
-        m_rx_fifo.p_payload[m_rx_fifo.entry_point]->pid   = pid;
-        m_rx_fifo.p_payload[m_rx_fifo.entry_point]->noack = !(m_rx_payload_buffer[1] & 0x01);
+        p_payload->pipe  = pipe;
+        p_payload->rssi  = NRF_RADIO->RSSISAMPLE;
+        p_payload->pid   = pid;
+        p_payload->noack = !(s1 & 0x01);
         if (++m_rx_fifo.entry_point >= NRF_ESB_RX_FIFO_SIZE)
         {
             m_rx_fifo.entry_point = 0;
@@ -701,7 +750,7 @@ static void on_radio_disabled_tx()
         update_rf_payload_format(0);
     }
 
-    NRF_RADIO->PACKETPTR        = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR        = (uint32_t)rx_buffer_select();
     on_radio_disabled           = on_radio_disabled_tx_wait_for_ack;
     m_nrf_esb_mainstate         = NRF_ESB_STATE_PTX_RX_ACK;
 }
@@ -726,9 +775,9 @@ static void on_radio_disabled_tx_wait_for_ack()
 
         (void) nrf_esb_skip_tx();
 
-        if (m_config_local.protocol != NRF_ESB_PROTOCOL_ESB && m_rx_payload_buffer[0] > 0)
+        if (m_config_local.protocol != NRF_ESB_PROTOCOL_ESB && mp_rx_buffer[0] > 0)
         {
-            if (rx_fifo_push_rfbuf((uint8_t)NRF_RADIO->TXADDRESS, m_rx_payload_buffer[1] >> 1))
+            if (rx_fifo_push_rfbuf((uint8_t)NRF_RADIO->TXADDRESS, mp_rx_buffer[1] >> 1))
             {
                 m_interrupt_flags |= NRF_ESB_INT_RX_DATA_RECEIVED_MSK;
             }
@@ -781,11 +830,14 @@ static void clear_events_restart_rx(void)
 {
     NRF_RADIO->SHORTS = m_radio_shorts_common;
     update_rf_payload_format(m_config_local.payload_length);
-    NRF_RADIO->PACKETPTR = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR = (uint32_t)rx_buffer_select();
     NRF_RADIO->EVENTS_DISABLED = 0;
     NRF_RADIO->TASKS_DISABLE = 1;
 
-    while (NRF_RADIO->EVENTS_DISABLED == 0);
+    while (NRF_RADIO->EVENTS_DISABLED == 0)
+    {
+        RADIO_DISABLE_WAIT();
+    }
 
     NRF_RADIO->EVENTS_DISABLED = 0;
     NRF_RADIO->SHORTS = m_radio_shorts_common | RADIO_SHORTS_DISABLED_TXEN_Msk;
@@ -813,18 +865,18 @@ static void on_radio_disabled_rx(void)
     }
 
     p_pipe_info = &m_rx_pipe_info[NRF_RADIO->RXMATCH];
-    if (NRF_RADIO->RXCRC             == p_pipe_info->crc &&
-        (m_rx_payload_buffer[1] >> 1) == p_pipe_info->pid
+    if (NRF_RADIO->RXCRC        == p_pipe_info->crc &&
+        (mp_rx_buffer[1] >> 1) == p_pipe_info->pid
        )
     {
         retransmit_payload = true;
         send_rx_event = false;
     }
 
-    p_pipe_info->pid = m_rx_payload_buffer[1] >> 1;
+    p_pipe_info->pid = mp_rx_buffer[1] >> 1;
     p_pipe_info->crc = NRF_RADIO->RXCRC;
 
-    if ((m_config_local.selective_auto_ack == false) || ((m_rx_payload_buffer[1] & 0x01) == 1))
+    if ((m_config_local.selective_auto_ack == false) || ((mp_rx_buffer[1] & 0x01) == 1))
     {
         ack = true;
     }
@@ -883,14 +935,14 @@ static void on_radio_disabled_rx(void)
                         m_tx_payload_buffer[0] = 0;
                     }
 
-                    m_tx_payload_buffer[1] = m_rx_payload_buffer[1];
+                    m_tx_payload_buffer[1] = mp_rx_buffer[1];
                 }
                 break;
 
             case NRF_ESB_PROTOCOL_ESB:
                 {
                     update_rf_payload_format(0);
-                    m_tx_payload_buffer[0] = m_rx_payload_buffer[0];
+                    m_tx_payload_buffer[0] = mp_rx_buffer[0];
                     m_tx_payload_buffer[1] = 0;
                 }
                 break;
@@ -901,10 +953,6 @@ static void on_radio_disabled_rx(void)
         NRF_RADIO->PACKETPTR = (uint32_t)m_tx_payload_buffer;
         on_radio_disabled = on_radio_disabled_rx_ack;
     }
-    else
-    {
-        clear_events_restart_rx();
-    }
 
     if (send_rx_event)
     {
@@ -916,6 +964,13 @@ static void on_radio_disabled_rx(void)
             NVIC_SetPendingIRQ(ESB_EVT_IRQ);
         }
     }
+
+    if (!ack)
+    {
+        // Restart only after the packet is pushed, so that the next packet is received into the
+        // next RX FIFO entry.
+        clear_events_restart_rx();
+    }
 }
 
 
@@ -924,7 +979,7 @@ static void on_radio_disabled_rx_ack(void)
     NRF_RADIO->SHORTS = m_radio_shorts_common | RADIO_SHORTS_DISABLED_TXEN_Msk;
     update_rf_payload_format(m_config_local.payload_length);
 
-    NRF_RADIO->PACKETPTR = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR = (uint32_t)rx_buffer_select();
     on_radio_disabled = on_radio_disabled_rx;
 
     m_nrf_esb_mainstate = NRF_ESB_STATE_PRX;
@@ -1137,16 +1192,14 @@ static nrf_esb_payload_random_access_buf_wrapper_t *find_free_payload_cont(void)
 }
 
 
-uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
+/** @brief  Function to add a payload to the TX FIFO.
+ *
+ *  Must be called with the radio interrupt disabled, after checking that the TX FIFO has room.
+ *
+ *  @param  p_payload Payload to add.
+ */
+static void tx_fifo_push(nrf_esb_payload_t const * p_payload)
 {
-    VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
-    VERIFY_PARAM_NOT_NULL(p_payload);
-    VERIFY_PAYLOAD_LENGTH(p_payload);
-    VERIFY_FALSE(m_tx_fifo.count >= NRF_ESB_TX_FIFO_SIZE, NRF_ERROR_NO_MEM);
-    VERIFY_TRUE(p_payload->pipe < NRF_ESB_PIPE_COUNT, NRF_ERROR_INVALID_PARAM);
-
-    DISABLE_RF_IRQ();
-
     if (m_config_local.mode == NRF_ESB_MODE_PTX)
     {
         memcpy(m_tx_fifo.p_payload[m_tx_fifo.entry_point], p_payload, sizeof(nrf_esb_payload_t));
@@ -1189,6 +1242,20 @@ uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
             m_tx_fifo.count++;
         }
     }
+}
+
+
+uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
+{
+    VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
+    VERIFY_PARAM_NOT_NULL(p_payload);
+    VERIFY_PAYLOAD_LENGTH(p_payload);
+    VERIFY_FALSE(m_tx_fifo.count >= NRF_ESB_TX_FIFO_SIZE, NRF_ERROR_NO_MEM);
+    VERIFY_TRUE(p_payload->pipe < NRF_ESB_PIPE_COUNT, NRF_ERROR_INVALID_PARAM);
+
+    DISABLE_RF_IRQ();
+
+    tx_fifo_push(p_payload);
 
     ENABLE_RF_IRQ();
 
@@ -1204,6 +1271,48 @@ uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload)
 }
 
 
+uint32_t nrf_esb_write_payloads(nrf_esb_payload_t const * p_payloads, uint32_t count)
+{
+    VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
+    VERIFY_PARAM_NOT_NULL(p_payloads);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        nrf_esb_payload_t const * p_payload = &p_payloads[i];
+
+        VERIFY_PAYLOAD_LENGTH(p_payload);
+        VERIFY_TRUE(p_payload->pipe < NRF_ESB_PIPE_COUNT, NRF_ERROR_INVALID_PARAM);
+    }
+
+    DISABLE_RF_IRQ();
+
+    // The radio interrupt is the only other user of the FIFO, so the room cannot change here.
+    if (count > NRF_ESB_TX_FIFO_SIZE - m_tx_fifo.count)
+    {
+        ENABLE_RF_IRQ();
+        return NRF_ERROR_NO_MEM;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        tx_fifo_push(&p_payloads[i]);
+    }
+
+    ENABLE_RF_IRQ();
+
+
+    if (count > 0 &&
+        m_config_local.mode == NRF_ESB_MODE_PTX &&
+        m_config_local.tx_mode == NRF_ESB_TXMODE_AUTO &&
+        m_nrf_esb_mainstate == NRF_ESB_STATE_IDLE)
+    {
+        start_tx_transaction();
+    }
+
+    return NRF_SUCCESS;
+}
+
+
 uint32_t nrf_esb_read_rx_payload(nrf_esb_payload_t * p_payload)
 {
     VERIFY_TRUE(m_esb_initialized, NRF_ERROR_INVALID_STATE);
@@ -1265,7 +1374,7 @@ uint32_t nrf_esb_start_rx(void)
 
     NRF_RADIO->RXADDRESSES  = m_esb_addr.rx_pipes_enabled;
     NRF_RADIO->FREQUENCY    = m_esb_addr.rf_channel;
-    NRF_RADIO->PACKETPTR    = (uint32_t)m_rx_payload_buffer;
+    NRF_RADIO->PACKETPTR    = (uint32_t)rx_buffer_select();
 
     NVIC_ClearPendingIRQ(RADIO_IRQn);
     NVIC_EnableIRQ(RADIO_IRQn);
@@ -1290,7 +1399,10 @@ uint32_t nrf_esb_stop_rx(void)
         on_radio_disabled = NULL;
         NRF_RADIO->EVENTS_DISABLED = 0;
         NRF_RADIO->TASKS_DISABLE = 1;
-        while (NRF_RADIO->EVENTS_DISABLED == 0);
+        while (NRF_RADIO->EVENTS_DISABLED == 0)
+        {
+            RADIO_DISABLE_WAIT();
+        }
         m_nrf_esb_mainstate = NRF_ESB_STATE_IDLE;
 
         return NRF_SUCCESS;
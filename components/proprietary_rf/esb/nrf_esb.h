@@ -96,6 +96,10 @@ extern "C" {
 // 252 is the largest possible payload size according to the nRF5 architecture.
 STATIC_ASSERT(NRF_ESB_MAX_PAYLOAD_LENGTH <= 252);
 
+#ifndef NRF_ESB_RX_ZERO_COPY
+#define     NRF_ESB_RX_ZERO_COPY                0                   //!< Set to 1 to let the radio receive directly into the next free RX FIFO entry instead of copying every packet from an intermediate buffer.
+#endif
+
 #define     NRF_ESB_SYS_TIMER                   NRF_TIMER2          //!< The timer that is used by the module.
 #define     NRF_ESB_SYS_TIMER_IRQ_Handler       TIMER2_IRQHandler   //!< The handler that is used by @ref NRF_ESB_SYS_TIMER.
 
@@ -404,6 +408,27 @@ bool nrf_esb_is_idle(void);
 uint32_t nrf_esb_write_payload(nrf_esb_payload_t const * p_payload);
 
 
+/**@brief Function for writing several payloads for transmission or acknowledgement.
+ *
+ * This function queues the payloads in the order in which they appear in @p p_payloads, in the
+ * same way as @ref nrf_esb_write_payload. The radio interrupt is disabled only once for the whole
+ * batch, and in automatic TX mode the transmission is started after all payloads are queued.
+ *
+ * Either all payloads are queued, or none of them.
+ *
+ * @param[in]   p_payloads    Array of payloads to queue.
+ * @param[in]   count         Number of payloads in @p p_payloads.
+ *
+ * @retval  NRF_SUCCESS                     If all payloads were successfully queued for writing.
+ * @retval  NRF_ERROR_NULL                  If the required parameter was NULL.
+ * @retval  NRF_INVALID_STATE               If the module is not initialized.
+ * @retval  NRF_ERROR_NO_MEM                If the TX FIFO does not have room for @p count payloads.
+ * @retval  NRF_ERROR_INVALID_LENGTH        If the length of a payload was invalid (zero or larger than the allowed maximum).
+ * @retval  NRF_ERROR_INVALID_PARAM         If the pipe of a payload was invalid.
+ */
+uint32_t nrf_esb_write_payloads(nrf_esb_payload_t const * p_payloads, uint32_t count);
+
+
 /**@brief Function for reading an RX payload.
  *
  * @param[in,out]   p_payload   Pointer to the structure that contains information and state of the payload.
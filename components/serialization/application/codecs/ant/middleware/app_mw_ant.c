@@ -57,6 +57,7 @@ static void tx_buf_alloc(uint8_t * * p_data, uint32_t * p_len)
         err_code = ser_sd_transport_tx_alloc(p_data, &len16);
     }
     while (err_code != NRF_SUCCESS);
+    ser_sd_transport_out_params_set(mp_out_params, ARRAY_SIZE(mp_out_params));
 
     *p_data[0] = SER_PKT_TYPE_ANT_CMD;
     *p_len     = (uint32_t)len16 - 1;
@@ -97,6 +97,7 @@ static void tx_buf_alloc(uint8_t * * p_data, uint16_t * p_len)
         err_code = ser_sd_transport_tx_alloc(p_data, p_len);
     }
     while (err_code != NRF_SUCCESS);
+    ser_sd_transport_out_params_set(mp_out_params, ARRAY_SIZE(mp_out_params));
     *p_data[0] = SER_PKT_TYPE_CMD;
     *p_len    -= 1;
 }
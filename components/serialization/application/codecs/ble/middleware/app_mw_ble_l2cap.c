@@ -45,6 +45,9 @@
 #include "app_error.h"
 
 #if defined(NRF_SD_BLE_API_VERSION) && ((NRF_SD_BLE_API_VERSION < 4) || (NRF_SD_BLE_API_VERSION >=5))
+//Pointer for sd calls output params
+static void * mp_out_params[1];
+
 static void tx_buf_alloc(uint8_t * * p_data, uint16_t * p_len)
 {
     uint32_t err_code;
@@ -54,6 +57,7 @@ static void tx_buf_alloc(uint8_t * * p_data, uint16_t * p_len)
         err_code = ser_sd_transport_tx_alloc(p_data, p_len);
     }
     while (err_code != NRF_SUCCESS);
+    ser_sd_transport_out_params_set(mp_out_params, ARRAY_SIZE(mp_out_params));
     *p_data[0] = SER_PKT_TYPE_CMD;
     *p_len    -= 1;
 }
@@ -203,7 +207,6 @@ uint32_t _sd_ble_l2cap_tx(uint16_t                         conn_handle,
 #endif
 
 #if NRF_SD_BLE_API_VERSION >= 5
-static void * mp_out_params[1];
 /**@brief Command response callback function for @ref ble_l2cap_ch_setup_req_enc BLE command.
  *
  * Callback for decoding the output parameters and the command response return code.
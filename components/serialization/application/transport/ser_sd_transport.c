@@ -40,10 +40,12 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 #include "ser_sd_transport.h"
 #include "ser_hal_transport.h"
 #include "nrf_error.h"
 #include "app_error.h"
+#include "nrf_assert.h"
 #include "ble_serialization.h"
 #include "ser_dbg_sd_str.h"
 #include "ser_app_power_system_off.h"
@@ -83,6 +85,132 @@ static volatile bool m_rsp_wait = false;
 /** SoftDevice call return value decoded by user decoder handler. */
 static uint32_t m_return_value;
 
+#ifdef BLE_STACK_SUPPORT_REQD
+/** Flag indicating that events of a batch packet are being passed to the event handler. The RX
+ *  buffer is freed once all of them are handled. */
+static bool m_evt_batch_dispatch = false;
+
+/**@brief Function for passing each event of a batch packet to the BLE event handler.
+ *
+ * @param[in]   p_data   Pointer to the events, after the packet type.
+ * @param[in]   length   Size of the events.
+ */
+static void evt_batch_dispatch(uint8_t * p_data, uint16_t length)
+{
+    uint32_t index = 0;
+
+    m_evt_batch_dispatch = true;
+
+    while ((index + sizeof (uint16_t)) <= length)
+    {
+        uint16_t const evt_len = uint16_decode(&p_data[index]);
+        index += sizeof (uint16_t);
+
+        if ((evt_len < SER_EVT_HEADER_SIZE) || (evt_len > (length - index)))
+        {
+            /* Malformed packet. */
+            APP_ERROR_HANDLER(evt_len);
+            break;
+        }
+
+        NRF_LOG_DEBUG("[EVT]: %s ", (uint32_t)ser_dbg_sd_evt_str_get(uint16_decode(&p_data[index + SER_EVT_ID_POS])));
+        m_ble_evt_handler(&p_data[index], evt_len);
+        index += evt_len;
+    }
+
+    m_evt_batch_dispatch = false;
+    (void)ser_sd_transport_rx_free(p_data);
+}
+#endif // BLE_STACK_SUPPORT_REQD
+
+/** Flag indicating whether commands are pipelined instead of waiting for their responses. */
+static bool m_pipeline_enabled = false;
+
+/** Output parameter pointers of the middleware for the command being written. */
+static void * * mp_out_params       = NULL;
+static uint8_t  m_out_params_count  = 0;
+
+/** Pipelined command awaiting response. */
+typedef struct
+{
+    ser_sd_transport_rsp_handler_t rsp_dec_handler;                             /**< User decoder handler for the response. */
+    void * *                       pp_out_params;                               /**< Middleware output parameter pointers read by the decoder. */
+    void *                         out_params[SER_SD_TRANSPORT_OUT_PARAMS_MAX]; /**< Output parameter pointers of this command. */
+    uint8_t                        out_params_count;                            /**< Number of output parameter pointers. */
+    uint8_t                        op_code;                                     /**< Op code of the command. */
+} pipeline_cmd_t;
+
+/** Pipelined commands awaiting response, in the order the commands were sent. */
+static pipeline_cmd_t m_pipeline_cmds[SER_SD_TRANSPORT_PIPELINE_DEPTH];
+
+/** Number of pipelined commands sent and responses received. The difference is the number of
+ *  commands awaiting response. */
+static volatile uint32_t m_pipeline_sent;
+static volatile uint32_t m_pipeline_received;
+
+/** First error returned by a pipelined command. */
+static volatile uint32_t m_pipeline_result;
+
+/** Flag indicating whether @ref ser_sd_transport_pipeline_end is waiting for the last response. */
+static volatile bool m_pipeline_end_wait = false;
+
+/**@brief Function for handling the response to a pipelined command.
+ *
+ * @param[in]   p_data   Pointer to the response, after the packet type.
+ * @param[in]   length   Size of the response.
+ */
+static void pipeline_rsp_handle(uint8_t * p_data, uint16_t length)
+{
+    pipeline_cmd_t const * p_cmd = &m_pipeline_cmds[m_pipeline_received % SER_SD_TRANSPORT_PIPELINE_DEPTH];
+
+    if ((length < SER_CMD_RSP_HEADER_SIZE) || (p_data[SER_CMD_OP_CODE_POS] != p_cmd->op_code))
+    {
+        /* Responses must arrive in the order of the commands. */
+        (void)ser_sd_transport_rx_free(p_data);
+        APP_ERROR_HANDLER(p_cmd->op_code);
+        return;
+    }
+
+    /* Later commands have replaced the output parameter pointers in the middleware. Give the
+     * decoder the pointers of this command, and put back those of the task context after. */
+    void *        task_out_params[SER_SD_TRANSPORT_OUT_PARAMS_MAX];
+    uint8_t const count = p_cmd->out_params_count;
+
+    if (count > 0)
+    {
+        memcpy(task_out_params, p_cmd->pp_out_params, count * sizeof(void *));
+        memcpy(p_cmd->pp_out_params, p_cmd->out_params, count * sizeof(void *));
+    }
+
+    uint32_t const result = p_cmd->rsp_dec_handler(p_data, length);
+    (void)ser_sd_transport_rx_free(p_data);
+
+    if (count > 0)
+    {
+        memcpy(p_cmd->pp_out_params, task_out_params, count * sizeof(void *));
+    }
+
+    if ((result != NRF_SUCCESS) && (m_pipeline_result == NRF_SUCCESS))
+    {
+        NRF_LOG_DEBUG("[SD_CALL]:%s, pipelined err_code= 0x%X",
+                      (uint32_t)ser_dbg_sd_call_str_get(p_cmd->op_code), result);
+        m_pipeline_result = result;
+    }
+
+    m_pipeline_received++;
+
+    /* If os handler is set, signal os that the last response has arrived.*/
+    if (m_pipeline_end_wait && (m_pipeline_sent == m_pipeline_received))
+    {
+        m_pipeline_end_wait = false;
+
+        if (m_os_rsp_set_handler)
+        {
+            m_os_rsp_set_handler();
+        }
+    }
+}
+
 /**@brief Function for handling the rx packets comming from hal_transport.
  *
  * @details
@@ -108,7 +236,11 @@ static void ser_sd_transport_rx_packet_handler(uint8_t * p_data, uint16_t length
 #ifdef ANT_STACK_SUPPORT_REQD
             case SER_PKT_TYPE_ANT_RESP:
 #endif // ANT_STACK_SUPPORT_REQD
-                if (m_rsp_wait)
+                if (m_pipeline_sent != m_pipeline_received)
+                {
+                    pipeline_rsp_handle(p_data, length);
+                }
+                else if (m_rsp_wait)
                 {
                     m_return_value = m_rsp_dec_handler(p_data, length);
                     (void)ser_sd_transport_rx_free(p_data);
@@ -136,6 +268,10 @@ static void ser_sd_transport_rx_packet_handler(uint8_t * p_data, uint16_t length
                 NRF_LOG_DEBUG("[EVT]: %s ", (uint32_t)ser_dbg_sd_evt_str_get(uint16_decode(&p_data[SER_EVT_ID_POS]))); // p_data points to EVT_ID
                 m_ble_evt_handler(p_data, length);
                 break;
+
+            case SER_PKT_TYPE_EVT_BATCH:
+                evt_batch_dispatch(p_data, length);
+                break;
 #endif // BLE_STACK_SUPPORT_REQD
 
 #ifdef ANT_STACK_SUPPORT_REQD
@@ -180,6 +316,23 @@ static void ser_sd_transport_hal_handler(ser_hal_transport_evt_t event)
         break;
     case SER_HAL_TRANSP_EVT_PHY_ERROR:
 
+        if (m_pipeline_sent != m_pipeline_received)
+        {
+            /* Responses to pipelined commands can no longer be expected. */
+            m_pipeline_result   = NRF_ERROR_INTERNAL;
+            m_pipeline_received = m_pipeline_sent;
+
+            if (m_pipeline_end_wait)
+            {
+                m_pipeline_end_wait = false;
+
+                if (m_os_rsp_set_handler)
+                {
+                    m_os_rsp_set_handler();
+                }
+            }
+        }
+
         if (m_rsp_wait)
         {
             m_return_value = NRF_ERROR_INTERNAL;
@@ -263,14 +416,18 @@ uint32_t ser_sd_transport_ot_rsp_wait_handler_set(ser_sd_transport_rsp_wait_hand
 
 bool ser_sd_transport_is_busy(void)
 {
-    return m_rsp_wait;
+    return m_rsp_wait || (m_pipeline_sent != m_pipeline_received);
 }
 
 uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len)
 {
     uint32_t err_code;
 
-    if (m_rsp_wait)
+    mp_out_params      = NULL;
+    m_out_params_count = 0;
+
+    if (m_rsp_wait ||
+        ((m_pipeline_sent - m_pipeline_received) >= SER_SD_TRANSPORT_PIPELINE_DEPTH))
     {
         err_code = NRF_ERROR_BUSY;
     }
@@ -281,6 +438,14 @@ uint32_t ser_sd_transport_tx_alloc(uint8_t * * pp_data, uint16_t * p_len)
     return err_code;
 }
 
+void ser_sd_transport_out_params_set(void * * pp_out_params, uint8_t count)
+{
+    ASSERT(count <= SER_SD_TRANSPORT_OUT_PARAMS_MAX);
+
+    mp_out_params      = pp_out_params;
+    m_out_params_count = count;
+}
+
 uint32_t ser_sd_transport_tx_free(uint8_t * p_data)
 {
     return ser_hal_transport_tx_pkt_free(p_data);
@@ -288,6 +453,14 @@ uint32_t ser_sd_transport_tx_free(uint8_t * p_data)
 
 uint32_t ser_sd_transport_rx_free(uint8_t * p_data)
 {
+#ifdef BLE_STACK_SUPPORT_REQD
+    if (m_evt_batch_dispatch)
+    {
+        /* The buffer holds more events. It is freed by evt_batch_dispatch(). */
+        return NRF_SUCCESS;
+    }
+#endif // BLE_STACK_SUPPORT_REQD
+
     p_data -= SER_PKT_TYPE_SIZE;
     return ser_hal_transport_rx_pkt_free(p_data);
 }
@@ -298,6 +471,34 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
 {
     uint32_t err_code = NRF_SUCCESS;
 
+    if (m_pipeline_enabled && cmd_rsp_decode_callback &&
+        ((p_buffer[SER_PKT_TYPE_POS] == SER_PKT_TYPE_CMD)
+#ifdef ANT_STACK_SUPPORT_REQD
+         || (p_buffer[SER_PKT_TYPE_POS] == SER_PKT_TYPE_ANT_CMD)
+#endif // ANT_STACK_SUPPORT_REQD
+        ))
+    {
+        /* Free space was ensured when the TX buffer was allocated. The command is recorded before
+         * sending, because the response is handled in interrupt context. */
+        pipeline_cmd_t * p_cmd = &m_pipeline_cmds[m_pipeline_sent % SER_SD_TRANSPORT_PIPELINE_DEPTH];
+
+        p_cmd->op_code          = p_buffer[SER_PKT_OP_CODE_POS];
+        p_cmd->rsp_dec_handler  = cmd_rsp_decode_callback;
+        p_cmd->pp_out_params    = mp_out_params;
+        p_cmd->out_params_count = m_out_params_count;
+        if (m_out_params_count > 0)
+        {
+            memcpy(p_cmd->out_params, mp_out_params, m_out_params_count * sizeof(void *));
+        }
+        m_pipeline_sent++;
+
+        err_code = ser_hal_transport_tx_pkt_send(p_buffer, length);
+        APP_ERROR_CHECK(err_code);
+
+        NRF_LOG_DEBUG("[SD_CALL]:%s, pipelined", (uint32_t)ser_dbg_sd_call_str_get(p_buffer[1]));
+        return NRF_SUCCESS;
+    }
+
     m_rsp_wait        = true;
     m_rsp_dec_handler = cmd_rsp_decode_callback;
     err_code          = ser_hal_transport_tx_pkt_send(p_buffer, length);
@@ -323,3 +524,26 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
     NRF_LOG_DEBUG("[SD_CALL]:%s, err_code= 0x%X", (uint32_t)ser_dbg_sd_call_str_get(p_buffer[1]), err_code);
     return err_code;
 }
+
+void ser_sd_transport_pipeline_begin(void)
+{
+    m_pipeline_result  = NRF_SUCCESS;
+    m_pipeline_enabled = true;
+}
+
+uint32_t ser_sd_transport_pipeline_end(void)
+{
+    m_pipeline_enabled  = false;
+    m_pipeline_end_wait = true;
+
+    /* If the last response arrived after the flag was set, it has been signalled and the wait
+     * handler consumes the signal. */
+    if ((m_pipeline_sent != m_pipeline_received) || !m_pipeline_end_wait)
+    {
+        m_os_rsp_wait_handler();
+    }
+
+    m_pipeline_end_wait = false;
+
+    return m_pipeline_result;
+}
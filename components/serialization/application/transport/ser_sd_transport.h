@@ -64,6 +64,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "ser_config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -152,6 +153,9 @@ uint32_t ser_sd_transport_tx_free(uint8_t * p_data);
 /**@brief Function for freeing an RX event packet.
  *
  * @note Function should be called once the SoftDevice event buffer is processed.
+ * @note Events of a batch packet (@ref SER_PKT_TYPE_EVT_BATCH) share one RX buffer. For these, the
+ *       event handler must finish with the buffer before returning. The call to this function
+ *       is then ignored, and the buffer is freed after the last event of the batch.
  *
  * @param[out] p_data       Pointer to the allocated RX buffer.
  *
@@ -185,6 +189,53 @@ uint32_t ser_sd_transport_cmd_write(const uint8_t *                p_buffer,
                                     ser_sd_transport_rsp_handler_t cmd_resp_decode_callback);
 
 
+/**@brief Function for registering the output parameter pointers of the command being written.
+ *
+ * @details The middleware keeps the pointers to the output parameters of a SoftDevice call in a
+ *          static array, which the response decoder reads. The registration is cleared by
+ *          @ref ser_sd_transport_tx_alloc, so it must be made after the TX buffer is allocated and
+ *          before @ref ser_sd_transport_cmd_write is called.
+ *
+ * @param[in] pp_out_params Array of output parameter pointers read by the response decoder.
+ * @param[in] count         Number of elements in the array, at most
+ *                          @ref SER_SD_TRANSPORT_OUT_PARAMS_MAX.
+ */
+void ser_sd_transport_out_params_set(void * * pp_out_params, uint8_t count);
+
+
+/**@brief Function for starting pipelined mode.
+ *
+ * @details In pipelined mode, @ref ser_sd_transport_cmd_write returns NRF_SUCCESS as soon as the
+ *          command is sent, without waiting for the response. Up to
+ *          @ref SER_SD_TRANSPORT_PIPELINE_DEPTH commands can await their responses, which the
+ *          Connectivity Chip sends in the order of the commands. The response decoder of each
+ *          command is called in serial peripheral interrupt context when its response arrives,
+ *          and the return code it decodes is reported by @ref ser_sd_transport_pipeline_end.
+ *
+ *          The output parameter pointers that the middleware registers with
+ *          @ref ser_sd_transport_out_params_set are saved with each command, so the decoder of
+ *          every command writes the output parameters of its own call.
+ *
+ * @warning Use pipelined mode only for SoftDevice calls that do not depend on the result of an
+ *          earlier call, for example sd_ble_gatts_hvx, sd_ble_gatts_value_set or
+ *          sd_ble_gap_scan_start. The output parameters of a call are written when its response
+ *          arrives, so they must stay valid until @ref ser_sd_transport_pipeline_end returns. Do
+ *          not pass output parameters that live on the stack of a function that returns earlier.
+ */
+void ser_sd_transport_pipeline_begin(void);
+
+
+/**@brief Function for ending pipelined mode.
+ *
+ * @details Blocks until the responses to all pipelined commands have been received.
+ *
+ * @retval NRF_SUCCESS  All pipelined commands succeeded.
+ * @return The first error code returned by a pipelined command, or NRF_ERROR_INTERNAL if the
+ *         physical layer reported an error.
+ */
+uint32_t ser_sd_transport_pipeline_end(void);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,15 @@
 
 #define SD_BLE_EVT_MAILBOX_QUEUE_SIZE 5 /**< Size of mailbox queue. */
 
+/* All events of a batch packet are pushed to the BLE mailbox at once. The mailbox holds a full
+ * batch on top of the events the application has not processed yet, so that it can fall behind
+ * by as many events as without batching. */
+#if SER_EVT_BATCH_ENABLED
+#define SD_BLE_EVT_BLE_MAILBOX_QUEUE_SIZE (SD_BLE_EVT_MAILBOX_QUEUE_SIZE + SER_EVT_BATCH_MAX_EVENTS - 1)
+#else
+#define SD_BLE_EVT_BLE_MAILBOX_QUEUE_SIZE SD_BLE_EVT_MAILBOX_QUEUE_SIZE
+#endif
+
 /** @brief Structure used to pass packet details through mailbox.
  */
 #if defined(BLE_STACK_SUPPORT_REQD)
@@ -83,7 +92,7 @@ typedef struct
 #if defined(BLE_STACK_SUPPORT_REQD)
 NRF_QUEUE_DEF(ser_sd_handler_evt_data_t,
               m_sd_ble_evt_mailbox,
-              SD_BLE_EVT_MAILBOX_QUEUE_SIZE,
+              SD_BLE_EVT_BLE_MAILBOX_QUEUE_SIZE,
               NRF_QUEUE_MODE_NO_OVERFLOW);
 #endif
 
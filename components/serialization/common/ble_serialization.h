@@ -64,6 +64,8 @@ typedef enum
     SER_PKT_TYPE_ANT_RESP,    /**< ANT Response packet type. */
     SER_PKT_TYPE_ANT_EVT,     /**< ANT Event packet type. */
 #endif
+    /* Fixed value, so that it is the same with and without ANT support. */
+    SER_PKT_TYPE_EVT_BATCH = 9, /**< Packet with several events, each preceded by its 16-bit length. */
     SER_PKT_TYPE_MAX          /**< Upper bound. */
 } ser_pkt_type_t;
 
@@ -88,6 +88,32 @@ extern "C" {
     #define SER_HAL_TRANSPORT_RX_MAX_PKT_SIZE         SER_HAL_TRANSPORT_CONN_TO_APP_MAX_PKT_SIZE
 #endif /* SER_CONNECTIVITY */
 
+/***********************************************************************************************//**
+ * SoftDevice transport configuration (application side).
+ **************************************************************************************************/
+
+/** Maximum number of commands sent in pipelined mode that may await a response at the same time. */
+#define SER_SD_TRANSPORT_PIPELINE_DEPTH     8
+
+/** Maximum number of output parameter pointers that the middleware keeps for one command. */
+#define SER_SD_TRANSPORT_OUT_PARAMS_MAX     3
+
+/***********************************************************************************************//**
+ * Event batching configuration.
+ **************************************************************************************************/
+
+/** Enable packing of several BLE events into one packet on the connectivity side. The application
+ *  side always accepts batched packets, but it must be built with the same setting, because it
+ *  sizes its event mailbox for a full batch. */
+#ifndef SER_EVT_BATCH_ENABLED
+#define SER_EVT_BATCH_ENABLED               0
+#endif
+
+/** Maximum number of BLE events in one batched packet. */
+#ifndef SER_EVT_BATCH_MAX_EVENTS
+#define SER_EVT_BATCH_MAX_EVENTS            4
+#endif
+
 
 /***********************************************************************************************//**
  * SER_PHY layer configuration.
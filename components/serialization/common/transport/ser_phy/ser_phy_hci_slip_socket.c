@@ -0,0 +1,795 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "ser_phy_hci.h"
+#include "ser_phy_hci_slip_socket.h"
+#include "ser_config.h"
+#include "app_error.h"
+#include "nrf_assert.h"
+// The system headers come last: termios.h defines macros (e.g. B0) that clash
+// with register names in the device header.
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#ifndef SER_PHY_SOCKET_PATH
+#define SER_PHY_SOCKET_PATH "/tmp/ser_phy.sock"   /**< Socket path, or terminal device if it starts with "/dev/". */
+#endif
+
+#ifndef SER_PHY_SOCKET_BAUDRATE
+#define SER_PHY_SOCKET_BAUDRATE SER_PHY_UART_BAUDRATE_VAL /**< Emulated line rate. 0 disables pacing. */
+#endif
+
+#ifndef SER_PHY_SOCKET_LOSS_PPM
+#define SER_PHY_SOCKET_LOSS_PPM 0   /**< Probability of dropping an outgoing frame, in parts per million. */
+#endif
+
+#ifndef SER_PHY_SOCKET_SEED
+#define SER_PHY_SOCKET_SEED 1       /**< Seed of the loss injection pseudo-random generator. */
+#endif
+
+#define APP_SLIP_END     0xC0 /**< SLIP code for identifying the beginning and end of a packet frame.. */
+#define APP_SLIP_ESC     0xDB /**< SLIP escape code. This code is used to specify that the following character is specially encoded. */
+#define APP_SLIP_ESC_END 0xDC /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xC0.. */
+#define APP_SLIP_ESC_ESC 0xDD /**< SLIP special code. When this code follows 0xDB, this character is interpreted as payload data 0xDB. */
+
+#define HDR_SIZE 4
+#define CRC_SIZE 2
+#define PKT_SIZE (SER_HAL_TRANSPORT_MAX_PKT_SIZE + HDR_SIZE + CRC_SIZE)
+
+// Every byte escaped, plus the two frame delimiters.
+#define FRAME_SIZE (2 * PKT_SIZE + 2)
+
+#define RX_CHUNK_SIZE 256
+
+#define NS_PER_SEC 1000000000ull
+#define BITS_PER_BYTE 10 // Start bit, 8 data bits, stop bit.
+
+#define DEV_PATH_PREFIX "/dev/"
+
+typedef struct {
+    ser_phy_hci_pkt_params_t header;
+    ser_phy_hci_pkt_params_t payload;
+    ser_phy_hci_pkt_params_t crc;
+} ser_phy_hci_slip_pkt_t;
+
+static ser_phy_hci_slip_evt_t           m_ser_phy_hci_slip_event;
+static ser_phy_hci_slip_event_handler_t m_ser_phy_hci_slip_event_handler; /**< Event handler for upper layer */
+
+static ser_phy_hci_slip_socket_config_t m_config =
+{
+    .baudrate = SER_PHY_SOCKET_BAUDRATE,
+    .loss_ppm = SER_PHY_SOCKET_LOSS_PPM,
+    .seed     = SER_PHY_SOCKET_SEED
+};
+static ser_phy_hci_slip_socket_stats_t  m_stats;
+static uint32_t                         m_rng_state;
+
+static int  m_listen_fd = -1;
+static int  m_fd        = -1;
+static bool m_fd_is_socket;
+static bool m_processing;
+static uint32_t m_event_count;   /**< Number of events passed to the upper layer. */
+
+static uint8_t                     m_tx_frame[FRAME_SIZE];
+static uint32_t                    m_tx_frame_len;
+static uint32_t                    m_tx_frame_pos;    /**< Number of bytes of the frame written to the socket. */
+static uint64_t                    m_tx_done_ns;      /**< Time at which the frame being sent leaves the emulated line. */
+static ser_phy_hci_slip_evt_type_t m_tx_evt_type;
+static bool                        m_tx_in_progress;
+static bool                        m_tx_line_done;    /**< The frame has left the emulated line and is being written. */
+static bool                        m_tx_stalled;      /**< The socket did not take the whole frame at once. */
+static ser_phy_hci_slip_pkt_t      m_tx_next_packet;
+static bool                        m_tx_next_pending;
+
+static uint8_t  m_rx_chunk[RX_CHUNK_SIZE];
+static uint32_t m_rx_chunk_len;
+static uint32_t m_rx_chunk_pos;
+static uint8_t  m_rx_frame[PKT_SIZE];
+static uint32_t m_rx_index;
+static bool     m_rx_sync;
+static bool     m_rx_escape;
+static bool     m_rx_overflow;
+
+static uint8_t m_small_buffer[HDR_SIZE];
+static uint8_t m_big_buffer[PKT_SIZE];
+
+static uint8_t * mp_small_buffer = NULL;
+static uint8_t * mp_big_buffer   = NULL;
+
+
+static uint64_t time_now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NS_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t line_time_ns(uint32_t num_of_bytes)
+{
+    if (m_config.baudrate == 0)
+    {
+        return 0;
+    }
+    return ((uint64_t)num_of_bytes * BITS_PER_BYTE * NS_PER_SEC) / m_config.baudrate;
+}
+
+// xorshift32, good enough for deciding which frames to drop and reproducible
+// across runs for a given seed.
+static bool loss_roll(void)
+{
+    if (m_config.loss_ppm == 0)
+    {
+        return false;
+    }
+
+    m_rng_state ^= m_rng_state << 13;
+    m_rng_state ^= m_rng_state >> 17;
+    m_rng_state ^= m_rng_state << 5;
+
+    return (m_rng_state % 1000000) < m_config.loss_ppm;
+}
+
+static void event_send(ser_phy_hci_slip_evt_type_t evt_type)
+{
+    m_event_count++;
+    m_ser_phy_hci_slip_event.evt_type = evt_type;
+    m_ser_phy_hci_slip_event_handler(&m_ser_phy_hci_slip_event);
+}
+
+static void rx_decoder_reset(void)
+{
+    m_rx_chunk_len = 0;
+    m_rx_chunk_pos = 0;
+    m_rx_index     = 0;
+    m_rx_sync      = false;
+    m_rx_escape    = false;
+    m_rx_overflow  = false;
+}
+
+static bool fd_nonblocking_set(int fd)
+{
+    int flags = fcntl(fd, F_GETFL);
+
+    return (flags >= 0) && (fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+static bool socket_address_get(struct sockaddr_un * p_addr)
+{
+    if (strlen(SER_PHY_SOCKET_PATH) >= sizeof(p_addr->sun_path))
+    {
+        return false;
+    }
+
+    memset(p_addr, 0, sizeof(*p_addr));
+    p_addr->sun_family = AF_UNIX;
+    strcpy(p_addr->sun_path, SER_PHY_SOCKET_PATH);
+    return true;
+}
+
+static bool path_is_device(void)
+{
+    return strncmp(SER_PHY_SOCKET_PATH, DEV_PATH_PREFIX, strlen(DEV_PATH_PREFIX)) == 0;
+}
+
+static int tty_open(void)
+{
+    struct termios tty;
+    int            fd = open(SER_PHY_SOCKET_PATH, O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (tcgetattr(fd, &tty) == 0)
+    {
+        cfmakeraw(&tty);
+        (void)tcsetattr(fd, TCSANOW, &tty);
+    }
+    return fd;
+}
+
+/**@brief Function for establishing the connection to the other side, if there is none yet. */
+static void link_connect(void)
+{
+    int fd;
+
+    if (m_fd >= 0)
+    {
+        return;
+    }
+
+    if (path_is_device())
+    {
+        fd = tty_open();
+        m_fd_is_socket = false;
+    }
+    else
+    {
+#ifdef SER_CONNECTIVITY
+        fd = accept(m_listen_fd, NULL, NULL);
+#else
+        struct sockaddr_un addr;
+
+        fd = -1;
+        if (socket_address_get(&addr))
+        {
+            fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        }
+        if ((fd >= 0) && (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0))
+        {
+            (void)close(fd);
+            fd = -1;
+        }
+#endif
+        if ((fd >= 0) && !fd_nonblocking_set(fd))
+        {
+            (void)close(fd);
+            fd = -1;
+        }
+        m_fd_is_socket = true;
+    }
+
+    if (fd >= 0)
+    {
+        m_fd = fd;
+        rx_decoder_reset();
+    }
+}
+
+/**@brief Function for closing the connection and reporting it to the upper layer. */
+static void link_down(int error)
+{
+    (void)close(m_fd);
+    m_fd = -1;
+    rx_decoder_reset();
+
+    m_ser_phy_hci_slip_event.evt_params.hw_error.error_code = (uint32_t)error;
+    event_send(SER_PHY_HCI_SLIP_EVT_HW_ERROR);
+}
+
+/**@brief Function for writing as much of the frame being sent as the socket takes.
+ *
+ * @details When the other side is not reading, the rest of the frame is left for a later call,
+ *          the same way a UART with flow control stalls. Reception goes on in the meantime.
+ *
+ * @retval true  The frame was written, or the socket is full.
+ * @retval false The write failed.
+ */
+static bool fd_write(void)
+{
+    while (m_tx_frame_pos < m_tx_frame_len)
+    {
+        uint8_t const * p_data  = &m_tx_frame[m_tx_frame_pos];
+        uint32_t        length  = m_tx_frame_len - m_tx_frame_pos;
+        ssize_t         written = m_fd_is_socket ? send(m_fd, p_data, length, MSG_NOSIGNAL)
+                                                 : write(m_fd, p_data, length);
+        if (written < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                m_tx_stalled = true;
+                return true;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        m_tx_frame_pos += (uint32_t)written;
+    }
+    return true;
+}
+
+static uint32_t slip_encode(uint32_t index, ser_phy_hci_pkt_params_t const * p_data)
+{
+    for (uint32_t i = 0; i < p_data->num_of_bytes; i++)
+    {
+        uint8_t data = p_data->p_buffer[i];
+
+        if (data == APP_SLIP_END)
+        {
+            m_tx_frame[index++] = APP_SLIP_ESC;
+            m_tx_frame[index++] = APP_SLIP_ESC_END;
+        }
+        else if (data == APP_SLIP_ESC)
+        {
+            m_tx_frame[index++] = APP_SLIP_ESC;
+            m_tx_frame[index++] = APP_SLIP_ESC_ESC;
+        }
+        else
+        {
+            m_tx_frame[index++] = data;
+        }
+    }
+    return index;
+}
+
+/**@brief Function for encoding a packet and starting its emulated transmission.
+ *
+ * @param[in] p_packet Packet to send. A packet without payload is an acknowledge packet.
+ * @param[in] start_ns Time at which the line becomes free.
+ */
+static void tx_frame_start(ser_phy_hci_slip_pkt_t const * p_packet, uint64_t start_ns)
+{
+    uint32_t index = 0;
+
+    m_tx_frame[index++] = APP_SLIP_END;
+    index = slip_encode(index, &p_packet->header);
+
+    if (p_packet->payload.p_buffer == NULL)
+    {
+        m_tx_evt_type = SER_PHY_HCI_SLIP_EVT_ACK_SENT;
+    }
+    else
+    {
+        index = slip_encode(index, &p_packet->payload);
+        if (p_packet->crc.p_buffer != NULL)
+        {
+            index = slip_encode(index, &p_packet->crc);
+        }
+        m_tx_evt_type = SER_PHY_HCI_SLIP_EVT_PKT_SENT;
+    }
+    m_tx_frame[index++] = APP_SLIP_END;
+
+    m_tx_frame_len   = index;
+    m_tx_frame_pos   = 0;
+    m_tx_done_ns     = start_ns + line_time_ns(index);
+    m_tx_in_progress = true;
+    m_tx_line_done   = false;
+    m_tx_stalled     = false;
+}
+
+/**@brief Function for finishing the transmission once the frame has left the emulated line.
+ *
+ * @details The frame is written to the socket only now, so that the other side also sees
+ *          the line delay. If the socket does not take the whole frame, the transmission
+ *          is finished by a later call.
+ */
+static void tx_process(void)
+{
+    if (!m_tx_in_progress)
+    {
+        return;
+    }
+
+    if (!m_tx_line_done)
+    {
+        if (time_now_ns() < m_tx_done_ns)
+        {
+            return;
+        }
+
+        m_tx_line_done = true;
+        m_stats.tx_frames++;
+        m_stats.tx_bytes += m_tx_frame_len;
+
+        // A frame sent while the other side is not connected is lost, the same as
+        // on a UART with nobody listening.
+        if ((m_fd < 0) || loss_roll())
+        {
+            m_stats.tx_dropped++;
+            m_tx_frame_pos = m_tx_frame_len;
+        }
+    }
+
+    if (m_fd < 0)
+    {
+        // The link went down while the frame was being written.
+        m_tx_frame_pos = m_tx_frame_len;
+    }
+    else if (!fd_write())
+    {
+        link_down(errno);
+    }
+    else if (m_tx_frame_pos < m_tx_frame_len)
+    {
+        return;
+    }
+
+    m_tx_in_progress = false;
+    ser_phy_hci_slip_evt_type_t evt_type = m_tx_evt_type;
+
+    if (m_tx_next_pending)
+    {
+        // After a stall, the line was busy until now.
+        m_tx_next_pending = false;
+        tx_frame_start(&m_tx_next_packet, m_tx_stalled ? time_now_ns() : m_tx_done_ns);
+    }
+
+    // Note that this notification may result in another packet send request,
+    // so everything must be cleaned up above.
+    event_send(evt_type);
+}
+
+uint32_t ser_phy_hci_slip_tx_pkt_send(const ser_phy_hci_pkt_params_t * p_header,
+                                      const ser_phy_hci_pkt_params_t * p_payload,
+                                      const ser_phy_hci_pkt_params_t * p_crc)
+{
+    ser_phy_hci_slip_pkt_t packet;
+
+    if (p_header == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    packet.header               = *p_header;
+    packet.payload.p_buffer     = NULL;
+    packet.payload.num_of_bytes = 0;
+    packet.crc.p_buffer         = NULL;
+    packet.crc.num_of_bytes     = 0;
+    if (p_payload != NULL)
+    {
+        packet.payload = *p_payload;
+    }
+    if (p_crc != NULL)
+    {
+        packet.crc = *p_crc;
+    }
+
+    if ((uint32_t)(packet.header.num_of_bytes + packet.payload.num_of_bytes +
+                   packet.crc.num_of_bytes) > PKT_SIZE)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    if (!m_tx_in_progress)
+    {
+        tx_frame_start(&packet, time_now_ns());
+    }
+    else if (!m_tx_next_pending)
+    {
+        m_tx_next_packet  = packet;
+        m_tx_next_pending = true;
+    }
+    else
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    return NRF_SUCCESS;
+}
+
+/* Function returns false when the end of the received data is reached or the link went down.*/
+static bool rx_chunk_fill(void)
+{
+    ssize_t received;
+
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    received = read(m_fd, m_rx_chunk, sizeof(m_rx_chunk));
+    if (received > 0)
+    {
+        m_rx_chunk_len   = (uint32_t)received;
+        m_rx_chunk_pos   = 0;
+        m_stats.rx_bytes += (uint32_t)received;
+        return true;
+    }
+
+    if (received == 0)
+    {
+        link_down(ECONNRESET);
+    }
+    else if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+    {
+        link_down(errno);
+    }
+    return false;
+}
+
+static uint8_t * rx_buffer_get(uint32_t num_of_bytes)
+{
+    uint8_t * p_buffer = NULL;
+
+    if ((num_of_bytes <= sizeof(m_small_buffer)) && (mp_small_buffer != NULL))
+    {
+        p_buffer        = mp_small_buffer;
+        mp_small_buffer = NULL;
+    }
+    else if (mp_big_buffer != NULL)
+    {
+        p_buffer      = mp_big_buffer;
+        mp_big_buffer = NULL;
+    }
+    return p_buffer;
+}
+
+/**@brief Function for decoding received data until a complete packet has been passed to
+ *        the upper layer.
+ *
+ * @details If no RX buffer is free when a packet is complete, decoding stops and the data is
+ *          left in the socket, which emulates hardware flow control.
+ */
+static void rx_process(void)
+{
+    for (;;)
+    {
+        if ((m_rx_chunk_pos == m_rx_chunk_len) && !rx_chunk_fill())
+        {
+            return;
+        }
+
+        uint8_t rx_byte = m_rx_chunk[m_rx_chunk_pos];
+
+        if (rx_byte == APP_SLIP_END)
+        {
+            if (m_rx_sync && (m_rx_index > 0))
+            {
+                if (m_rx_overflow)
+                {
+                    // Do not notify upper layer - the packet is too big and cannot be handled by slip.
+                    m_stats.rx_dropped++;
+                }
+                else
+                {
+                    uint8_t * p_buffer = rx_buffer_get(m_rx_index);
+                    if (p_buffer == NULL)
+                    {
+                        return;
+                    }
+                    m_rx_chunk_pos++;
+
+                    memcpy(p_buffer, m_rx_frame, m_rx_index);
+                    m_ser_phy_hci_slip_event.evt_params.received_pkt.p_buffer     = p_buffer;
+                    m_ser_phy_hci_slip_event.evt_params.received_pkt.num_of_bytes = m_rx_index;
+                    m_rx_index = 0;
+                    m_stats.rx_frames++;
+
+                    event_send(SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED);
+                    return;
+                }
+            }
+            m_rx_chunk_pos++;
+            m_rx_sync     = true;
+            m_rx_index    = 0;
+            m_rx_escape   = false;
+            m_rx_overflow = false;
+            continue;
+        }
+
+        m_rx_chunk_pos++;
+        if (!m_rx_sync)
+        {
+            continue;
+        }
+
+        if (m_rx_escape)
+        {
+            m_rx_escape = false;
+            if (rx_byte == APP_SLIP_ESC_END)
+            {
+                rx_byte = APP_SLIP_END;
+            }
+            else if (rx_byte == APP_SLIP_ESC_ESC)
+            {
+                rx_byte = APP_SLIP_ESC;
+            }
+        }
+        else if (rx_byte == APP_SLIP_ESC)
+        {
+            m_rx_escape = true;
+            continue;
+        }
+
+        if (m_rx_index < sizeof(m_rx_frame))
+        {
+            m_rx_frame[m_rx_index++] = rx_byte;
+        }
+        else
+        {
+            m_rx_overflow = true;
+        }
+    }
+}
+
+
+uint32_t ser_phy_hci_slip_rx_buf_free(uint8_t * p_buffer)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    if (p_buffer == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+    else if (p_buffer == m_small_buffer)
+    {
+        /* Free small buffer*/
+        if (mp_small_buffer == NULL)
+        {
+            mp_small_buffer = m_small_buffer;
+        }
+        else
+        {
+            err_code = NRF_ERROR_INVALID_STATE;
+        }
+    }
+    else if (p_buffer == m_big_buffer)
+    {
+        /* Free big buffer*/
+        if (mp_big_buffer == NULL)
+        {
+            mp_big_buffer = m_big_buffer;
+        }
+        else
+        {
+            err_code = NRF_ERROR_INVALID_STATE;
+        }
+    }
+
+    return err_code;
+}
+
+
+void ser_phy_hci_slip_socket_config_set(ser_phy_hci_slip_socket_config_t const * p_config)
+{
+    ASSERT(p_config != NULL);
+
+    m_config = *p_config;
+    // xorshift gets stuck at zero.
+    m_rng_state = (m_config.seed != 0) ? m_config.seed : 1;
+}
+
+
+void ser_phy_hci_slip_socket_stats_get(ser_phy_hci_slip_socket_stats_t * p_stats)
+{
+    ASSERT(p_stats != NULL);
+
+    *p_stats = m_stats;
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+
+bool ser_phy_hci_slip_socket_process(void)
+{
+    uint32_t event_count = m_event_count;
+
+    // Events are generated from here, and the upper layer may end up waiting
+    // for something (and calling this function) from inside its handler.
+    if ((m_ser_phy_hci_slip_event_handler == NULL) || m_processing)
+    {
+        return false;
+    }
+    m_processing = true;
+
+    link_connect();
+
+    tx_process();
+    if (m_ser_phy_hci_slip_event_handler != NULL)
+    {
+        rx_process();
+    }
+
+    m_processing = false;
+    return (m_event_count != event_count);
+}
+
+
+void ser_phy_hci_slip_reset(void)
+{
+    m_tx_in_progress  = false;
+    m_tx_next_pending = false;
+
+    rx_decoder_reset();
+    mp_small_buffer = m_small_buffer;
+    mp_big_buffer   = m_big_buffer;
+}
+
+uint32_t ser_phy_hci_slip_open(ser_phy_hci_slip_event_handler_t events_handler)
+{
+    if (events_handler == NULL)
+    {
+        return NRF_ERROR_NULL;
+    }
+
+    // Check if function was not called before.
+    if (m_ser_phy_hci_slip_event_handler != NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+#ifdef SER_CONNECTIVITY
+    if (!path_is_device())
+    {
+        struct sockaddr_un addr;
+
+        if (!socket_address_get(&addr))
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+
+        // Remove a socket left behind by a previous run.
+        (void)unlink(SER_PHY_SOCKET_PATH);
+
+        m_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((m_listen_fd < 0)                                                  ||
+            (bind(m_listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)   ||
+            (listen(m_listen_fd, 1) != 0)                                      ||
+            !fd_nonblocking_set(m_listen_fd))
+        {
+            if (m_listen_fd >= 0)
+            {
+                (void)close(m_listen_fd);
+                m_listen_fd = -1;
+            }
+            return NRF_ERROR_INVALID_PARAM;
+        }
+    }
+#endif
+
+    m_ser_phy_hci_slip_event_handler = events_handler;
+
+    ser_phy_hci_slip_socket_config_set(&m_config);
+    memset(&m_stats, 0, sizeof(m_stats));
+    ser_phy_hci_slip_reset();
+
+    link_connect();
+
+    return NRF_SUCCESS;
+}
+
+
+void ser_phy_hci_slip_close(void)
+{
+    if (m_fd >= 0)
+    {
+        (void)close(m_fd);
+        m_fd = -1;
+    }
+    if (m_listen_fd >= 0)
+    {
+        (void)close(m_listen_fd);
+        m_listen_fd = -1;
+#ifdef SER_CONNECTIVITY
+        (void)unlink(SER_PHY_SOCKET_PATH);
+#endif
+    }
+    m_ser_phy_hci_slip_event_handler = NULL;
+}
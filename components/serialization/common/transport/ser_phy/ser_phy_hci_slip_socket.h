@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @defgroup ser_phy_hci_slip_socket Socket HCI SLIP PHY for host builds
+ * @{
+ * @ingroup ser_phy_hci
+ *
+ * @brief HCI SLIP layer that runs over a Unix domain socket or a pseudo terminal.
+ *
+ * @details This module implements the API declared in @ref ser_phy_hci for Linux host builds,
+ *          so that the application and connectivity sides of the serialization stack can run as
+ *          two ordinary processes. It replaces ser_phy_hci_slip.c in a host build; the HCI layer
+ *          (ser_phy_hci.c) on top of it is used unchanged and provides acknowledgements and
+ *          retransmissions.
+ *
+ *          The connectivity side (SER_CONNECTIVITY defined) listens on @ref SER_PHY_SOCKET_PATH
+ *          and the application side connects to it. If the path starts with "/dev/", it is opened
+ *          as a terminal in raw mode instead, which allows running over a pty pair or a real UART.
+ *          Frames are SLIP encoded in both cases, so the byte stream is the same as on the wire.
+ *
+ *          The module can emulate the line rate of a UART: a frame is written to the socket, and
+ *          the corresponding @ref SER_PHY_HCI_SLIP_EVT_PKT_SENT or
+ *          @ref SER_PHY_HCI_SLIP_EVT_ACK_SENT event is generated, only after the time that
+ *          the frame would take to be transmitted at the configured baud rate. It can also drop
+ *          outgoing frames with a given probability to exercise the retransmission path.
+ *
+ * @note    There are no interrupts in a host build. @ref ser_phy_hci_slip_socket_process must be
+ *          called periodically, for example from the main loop and from the handler that waits
+ *          for a command response, and all events are generated from that context.
+ */
+
+#ifndef SER_PHY_HCI_SLIP_SOCKET_H__
+#define SER_PHY_HCI_SLIP_SOCKET_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**@brief Link emulation parameters. */
+typedef struct
+{
+    uint32_t baudrate; /**< Emulated line rate in bits per second (10 bits per byte). 0 disables pacing. */
+    uint32_t loss_ppm; /**< Probability of dropping an outgoing frame, in parts per million. */
+    uint32_t seed;     /**< Seed of the pseudo-random generator used for loss injection. */
+} ser_phy_hci_slip_socket_config_t;
+
+/**@brief Link statistics. */
+typedef struct
+{
+    uint32_t tx_frames;  /**< Frames transmitted, including dropped ones. */
+    uint32_t tx_dropped; /**< Frames dropped by loss injection. */
+    uint32_t tx_bytes;   /**< SLIP encoded bytes transmitted. */
+    uint32_t rx_frames;  /**< Frames passed to the upper layer. */
+    uint32_t rx_dropped; /**< Frames discarded because they were too long. While no RX buffer is free, reception stalls instead. */
+    uint32_t rx_bytes;   /**< SLIP encoded bytes received. */
+} ser_phy_hci_slip_socket_stats_t;
+
+/**@brief Function for changing the link emulation parameters.
+ *
+ * @details Parameters set before @ref ser_phy_hci_slip_open is called are used from the start.
+ *          Otherwise the compile-time defaults apply. Changing the seed restarts the
+ *          pseudo-random sequence, so that a run with loss injection can be repeated exactly.
+ *
+ * @param[in] p_config Link emulation parameters.
+ */
+void ser_phy_hci_slip_socket_config_set(ser_phy_hci_slip_socket_config_t const * p_config);
+
+/**@brief Function for reading and clearing the link statistics.
+ *
+ * @param[out] p_stats Statistics collected since the previous call or since the module was opened.
+ */
+void ser_phy_hci_slip_socket_stats_get(ser_phy_hci_slip_socket_stats_t * p_stats);
+
+/**@brief Function for processing the socket.
+ *
+ * @details The function accepts a pending connection, completes the frame being transmitted if
+ *          its emulated transmission time has elapsed and the socket takes it, and decodes the
+ *          received data. It does not block. A frame that the other side does not read is kept
+ *          and written by a later call.
+ *
+ * @retval true  An event was passed to the upper layer.
+ * @retval false Nothing happened.
+ */
+bool ser_phy_hci_slip_socket_process(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SER_PHY_HCI_SLIP_SOCKET_H__ */
+/** @} */
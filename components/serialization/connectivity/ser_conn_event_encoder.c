@@ -57,6 +57,145 @@
 
 #ifdef BLE_STACK_SUPPORT_REQD
 extern bool m_reset_ongoing;
+
+#if SER_EVT_BATCH_ENABLED
+/**@brief Function for allocating a TX buffer, copying a packet into it and sending it.
+ *
+ * @param[in]   p_pkt     Packet, including the packet type.
+ * @param[in]   pkt_len   Length of the packet.
+ */
+static void pkt_copy_send(uint8_t const * p_pkt, uint32_t pkt_len)
+{
+    uint32_t  err_code   = NRF_SUCCESS;
+    uint8_t * p_tx_buf   = NULL;
+    uint32_t  tx_buf_len = 0;
+
+    /* Allocate a memory buffer from HAL Transport layer for transmitting an event.
+     * Loop until a buffer is available. */
+    do
+    {
+        err_code = ser_hal_transport_tx_pkt_alloc(&p_tx_buf, (uint16_t *)&tx_buf_len);
+        if (err_code == NRF_ERROR_NO_MEM)
+        {
+            ser_conn_on_no_mem_handler();
+        }
+    }
+    while (err_code == NRF_ERROR_NO_MEM);
+    APP_ERROR_CHECK(err_code);
+
+    memcpy(p_tx_buf, p_pkt, pkt_len);
+    err_code = ser_hal_transport_tx_pkt_send(p_tx_buf, (uint16_t)pkt_len);
+    APP_ERROR_CHECK(err_code);
+
+    /* See ser_conn_ble_event_encoder() for why the scheduler is paused. */
+    if (!m_reset_ongoing)
+    {
+        app_sched_pause();
+    }
+}
+
+/** Events waiting to be sent in one packet, each preceded by its 16-bit length. */
+static uint8_t  m_batch_buf[SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE];
+static uint32_t m_batch_len;
+static uint32_t m_batch_count;
+
+/** Flag indicating whether @ref batch_flush is in the scheduler queue. */
+static bool     m_batch_flush_scheduled;
+
+/** Buffer for encoding one event before it is added to the batch. */
+static uint8_t  m_evt_buf[SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE];
+
+/**@brief Function for sending the events waiting in the batch.
+ *
+ * @details A batch with a single event is sent as an ordinary event packet.
+ */
+static void batch_send(void)
+{
+    if (m_batch_count == 1)
+    {
+        /* Overwrite the length field, so that the packet type directly precedes the event. */
+        uint8_t * p_pkt = &m_batch_buf[sizeof (uint16_t)];
+
+        p_pkt[SER_PKT_TYPE_POS] = SER_PKT_TYPE_EVT;
+        pkt_copy_send(p_pkt, m_batch_len - sizeof (uint16_t));
+    }
+    else if (m_batch_count > 1)
+    {
+        m_batch_buf[SER_PKT_TYPE_POS] = SER_PKT_TYPE_EVT_BATCH;
+        pkt_copy_send(m_batch_buf, m_batch_len);
+    }
+
+    m_batch_len   = SER_PKT_TYPE_SIZE;
+    m_batch_count = 0;
+}
+
+/**@brief Scheduler handler sending the batch once the events queued before it are processed.
+ */
+static void batch_flush(void * p_event_data, uint16_t event_size)
+{
+    UNUSED_PARAMETER(p_event_data);
+    UNUSED_PARAMETER(event_size);
+
+    m_batch_flush_scheduled = false;
+
+    if (m_reset_ongoing)
+    {
+        m_batch_len   = SER_PKT_TYPE_SIZE;
+        m_batch_count = 0;
+        return;
+    }
+
+    batch_send();
+}
+
+/**@brief Function for adding an encoded event to the batch.
+ *
+ * @param[in]   evt_len   Length of the event in @ref m_evt_buf.
+ */
+static void batch_add(uint32_t evt_len)
+{
+    if (m_batch_count == 0)
+    {
+        m_batch_len = SER_PKT_TYPE_SIZE;
+    }
+
+    if ((m_batch_len + sizeof (uint16_t) + evt_len) > sizeof (m_batch_buf))
+    {
+        batch_send();
+    }
+
+    if ((m_batch_len + sizeof (uint16_t) + evt_len) > sizeof (m_batch_buf))
+    {
+        /* The length field does not fit together with this event. Send it alone. */
+        m_evt_buf[SER_PKT_TYPE_POS] = SER_PKT_TYPE_EVT;
+        pkt_copy_send(m_evt_buf, SER_PKT_TYPE_SIZE + evt_len);
+        return;
+    }
+
+    m_batch_len += uint16_encode((uint16_t)evt_len, &m_batch_buf[m_batch_len]);
+    memcpy(&m_batch_buf[m_batch_len], &m_evt_buf[SER_PKT_OP_CODE_POS], evt_len);
+    m_batch_len += evt_len;
+    m_batch_count++;
+
+    if (m_batch_count >= SER_EVT_BATCH_MAX_EVENTS)
+    {
+        batch_send();
+    }
+    else if (!m_batch_flush_scheduled)
+    {
+        /* Events already in the scheduler queue are added to this batch before it is sent. */
+        if (app_sched_event_put(NULL, 0, batch_flush) == NRF_SUCCESS)
+        {
+            m_batch_flush_scheduled = true;
+        }
+        else
+        {
+            batch_send();
+        }
+    }
+}
+#endif // SER_EVT_BATCH_ENABLED
+
 void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
 {
     if (m_reset_ongoing)
@@ -72,10 +211,26 @@ void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
     UNUSED_PARAMETER(event_size);
 
     uint32_t    err_code   = NRF_SUCCESS;
-    uint8_t *   p_tx_buf   = NULL;
     uint32_t    tx_buf_len = 0;
     ble_evt_t * p_ble_evt  = (ble_evt_t *)p_event_data;
 
+#if SER_EVT_BATCH_ENABLED
+    /* The event is encoded only once, because some encoders release connection resources. */
+    tx_buf_len = sizeof (m_evt_buf) - SER_PKT_TYPE_SIZE;
+    err_code   = ble_event_enc(p_ble_evt, 0, &m_evt_buf[SER_PKT_OP_CODE_POS], &tx_buf_len);
+
+    if (NRF_ERROR_NOT_SUPPORTED != err_code)
+    {
+        APP_ERROR_CHECK(err_code);
+        batch_add(tx_buf_len);
+    }
+    else
+    {
+        APP_ERROR_CHECK(SER_WARNING_CODE);
+    }
+#else
+    uint8_t *   p_tx_buf   = NULL;
+
     /* Allocate a memory buffer from HAL Transport layer for transmitting an event.
      * Loop until a buffer is available. */
     do
@@ -120,6 +275,7 @@ void ser_conn_ble_event_encoder(void * p_event_data, uint16_t event_size)
         APP_ERROR_CHECK(err_code);
         APP_ERROR_CHECK(SER_WARNING_CODE);
     }
+#endif // SER_EVT_BATCH_ENABLED
 }
 #endif // BLE_STACK_SUPPORT_REQD
 
@@ -46,9 +46,22 @@
 #include "nrf_log_ctrl.h"
 #include "nrf_log_default_backends.h"
 #include "boards.h"
+#include "app_util.h"
+#include "nrf_delay.h"
+#include "nrf_timer.h"
 
 #include "common_test.h"
 
+#define STACK_PROBE_PATTERN     (0xA5)      /**< Value used to fill the stack area watched by @ref benchmark_stack_probe. */
+#define STACK_PROBE_MARGIN      (64)        /**< Bytes left unpainted below the stack pointer for the frame of @ref benchmark_stack_probe. */
+
+#if !NRFX_DELAY_DWT_PRESENT
+#define BENCHMARK_TIMER         NRF_TIMER1  /**< Timer used for the benchmarks on cores without the DWT cycle counter. */
+#endif
+
+static uint32_t           m_benchmark_start;  /**< Timer value at the start of the current benchmark measurement. */
+static uint8_t volatile * mp_stack_probe_top; /**< End of the stack area painted by @ref benchmark_stack_probe. */
+
 
 uint32_t unhexify(uint8_t * p_output, char const * p_input)
 {
@@ -123,3 +136,73 @@ void stop_time_measurement()
 {
     nrf_gpio_pin_set(LED_1);
 }
+
+void benchmark_timer_init(void)
+{
+#if NRFX_DELAY_DWT_PRESENT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#else
+    nrf_timer_mode_set(BENCHMARK_TIMER, NRF_TIMER_MODE_TIMER);
+    nrf_timer_bit_width_set(BENCHMARK_TIMER, NRF_TIMER_BIT_WIDTH_32);
+    nrf_timer_frequency_set(BENCHMARK_TIMER, NRF_TIMER_FREQ_1MHz);
+    nrf_timer_task_trigger(BENCHMARK_TIMER, NRF_TIMER_TASK_CLEAR);
+    nrf_timer_task_trigger(BENCHMARK_TIMER, NRF_TIMER_TASK_START);
+#endif
+}
+
+
+/**@brief Function for reading the free-running benchmark timer.
+ */
+static uint32_t benchmark_timer_get(void)
+{
+#if NRFX_DELAY_DWT_PRESENT
+    return DWT->CYCCNT;
+#else
+    nrf_timer_task_trigger(BENCHMARK_TIMER, NRF_TIMER_TASK_CAPTURE0);
+    return nrf_timer_cc_read(BENCHMARK_TIMER, NRF_TIMER_CC_CHANNEL0);
+#endif
+}
+
+
+void benchmark_timer_start(void)
+{
+    m_benchmark_start = benchmark_timer_get();
+}
+
+
+uint32_t benchmark_timer_stop(void)
+{
+    uint32_t elapsed = benchmark_timer_get() - m_benchmark_start;
+
+#if NRFX_DELAY_DWT_PRESENT
+    // Convert CPU cycles to microseconds.
+    elapsed /= (SystemCoreClock / 1000000UL);
+#endif
+    return elapsed;
+}
+
+
+uint32_t benchmark_stack_probe(bool paint)
+{
+    uint8_t volatile * p_stack = (uint8_t volatile *)STACK_BASE;
+
+    if (paint)
+    {
+        // Paint the free stack, from its limit up to just below the frame of this function.
+        mp_stack_probe_top = (uint8_t volatile *)__get_MSP() - STACK_PROBE_MARGIN;
+        for ( ; p_stack < mp_stack_probe_top; p_stack++)
+        {
+            *p_stack = STACK_PROBE_PATTERN;
+        }
+        return 0;
+    }
+
+    // The stack grows downwards, so the lowest overwritten byte marks the deepest use.
+    while ((p_stack < mp_stack_probe_top) && (*p_stack == STACK_PROBE_PATTERN))
+    {
+        p_stack++;
+    }
+    return (uint32_t)(mp_stack_probe_top - p_stack);
+}
@@ -51,6 +51,18 @@
 #define TEST_CASE_COUNT     NRF_SECTION_ITEM_COUNT(test_case_data, test_case_t)     /**< Get number of different test cases. */
 #define TEST_CASE_GET(i)    NRF_SECTION_ITEM_GET(test_case_data, test_case_t, (i))  /**< Get test case reference from array of test cases. */
 
+#ifndef TEST_BENCHMARK_ITERATIONS
+#define TEST_BENCHMARK_ITERATIONS       (32)        /**< Maximum number of times each benchmarked operation is run. */
+#endif
+
+#ifndef TEST_BENCHMARK_TIME_LIMIT_MS
+#define TEST_BENCHMARK_TIME_LIMIT_MS    (2000)      /**< Time after which a benchmark stops, even if it did not run @ref TEST_BENCHMARK_ITERATIONS times. */
+#endif
+
+#ifndef TEST_BENCHMARK_DATA_SIZE
+#define TEST_BENCHMARK_DATA_SIZE        (1024)      /**< Message size used for hash, HMAC, AES and AEAD benchmarks. Must be a multiple of 16. */
+#endif
+
 
 /**@brief Test vector expected result.
  *  Used to verify invalid behavior test cases.
@@ -275,6 +287,38 @@ void start_time_measurement(void);
 void stop_time_measurement(void);
 
 
+/**@brief Function for initializing the benchmark timer.
+ *
+ * @details The DWT cycle counter is used when the core has one, and TIMER1 otherwise.
+ */
+void benchmark_timer_init(void);
+
+
+/**@brief Function for starting a benchmark time measurement.
+ */
+void benchmark_timer_start(void);
+
+
+/**@brief Function for stopping a benchmark time measurement.
+ *
+ * @return Time in microseconds since the last call to @ref benchmark_timer_start.
+ */
+uint32_t benchmark_timer_stop(void);
+
+
+/**@brief Function for measuring the stack usage of code run between two calls.
+ *
+ * @details Call with @p paint set to true to fill the free stack, from the stack limit up to the
+ *          stack pointer, with a known pattern. Call it again, from the same function, with
+ *          @p paint set to false to find how much of that area was overwritten in between.
+ *
+ * @param[in] paint    True to prepare the stack area, false to check it.
+ *
+ * @return Number of stack bytes used since the area was prepared. 0 if @p paint is true.
+ */
+uint32_t benchmark_stack_probe(bool paint);
+
+
 /**@brief Macro for comparing two data buffers.
  *
  * @details Equal to a memcmp, except that it returns a 1 if memory areas are different.
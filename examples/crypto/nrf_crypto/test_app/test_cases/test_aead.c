@@ -68,6 +68,7 @@ NRF_SECTION_DEF(test_vector_aead_simple_data, test_vector_aead_t);
 #define AEAD_PLAINTEXT_BUF_SIZE_PLUS   AEAD_PLAINTEXT_BUF_SIZE + NUM_BUFFER_OVERFLOW_TEST_BYTES /**< Input buffer size for the AEAD plaintext, including 2 buffer overflow bytes. */
 #define AEAD_MAX_MAC_SIZE_PLUS         AEAD_MAC_SIZE + NUM_BUFFER_OVERFLOW_TEST_BYTES           /**< Input buffer size for the AEAD MAC, including 2 buffer overflow bytes. */
 #define AEAD_KEY_SIZE                  NRF_CRYPTO_KEY_SIZE_256 / (8)                            /**< Input buffer size for the AEAD key. */
+#define AEAD_STREAM_CHUNK_SIZE         (2 * NRF_CRYPTO_AEAD_STREAM_BLOCK_SIZE)                  /**< Chunk size used for the streamed AEAD operation. */
 
 /**< Get number of the AEAD test vectors. */
 #define TEST_VECTOR_AEAD_GET(i)         \
@@ -97,6 +98,44 @@ static uint8_t m_aead_ad_buf[AEAD_PLAINTEXT_BUF_SIZE];
 static uint8_t m_aead_nonce_buf[AEAD_MAX_TESTED_NONCE_SIZE];                                    /**< Buffer for holding the AEAD nonce data. */
 
 
+/**@brief Function for running a streamed AEAD operation in place, in chunks of
+ *        AEAD_STREAM_CHUNK_SIZE bytes.
+ */
+static ret_code_t aead_stream_crypt(nrf_crypto_operation_t operation,
+                                    size_t                 nonce_len,
+                                    size_t                 ad_len,
+                                    uint8_t              * p_buf,
+                                    size_t                 len,
+                                    uint8_t              * p_mac,
+                                    size_t                 mac_len)
+{
+    ret_code_t err_code;
+    size_t     chunk_len;
+
+    err_code = nrf_crypto_aead_start(&m_aead_context,
+                                     operation,
+                                     m_aead_nonce_buf,
+                                     nonce_len,
+                                     m_aead_ad_buf,
+                                     ad_len,
+                                     len,
+                                     mac_len);
+    VERIFY_SUCCESS(err_code);
+
+    for (size_t offset = 0; offset < len; offset += chunk_len)
+    {
+        chunk_len = MIN(len - offset, AEAD_STREAM_CHUNK_SIZE);
+        err_code  = nrf_crypto_aead_update(&m_aead_context,
+                                           &p_buf[offset],
+                                           chunk_len,
+                                           &p_buf[offset]);
+        VERIFY_SUCCESS(err_code);
+    }
+
+    return nrf_crypto_aead_finalize(&m_aead_context, p_mac);
+}
+
+
 /**@brief Function for running the test setup.
  */
 ret_code_t setup_test_case_aead(void)
@@ -219,6 +258,62 @@ ret_code_t exec_test_case_aead(test_info_t * p_test_info)
         TEST_VECTOR_OVERFLOW_ASSERT(m_aead_output_buf, output_len, "output buffer overflow");
         TEST_VECTOR_OVERFLOW_ASSERT(m_aead_output_mac_buf, mac_len, "MAC buffer overflow");
 
+        // Repeat valid test vectors as streamed in-place operations, if the backend supports it.
+        if ((p_test_vector->expected_err_code == NRF_SUCCESS) &&
+            (p_test_vector->crypt_expected_result == EXPECTED_TO_PASS) &&
+            (p_test_vector->mac_expected_result == EXPECTED_TO_PASS))
+        {
+            // Encrypt plaintext in place.
+            memcpy(m_aead_output_buf, m_aead_expected_output_buf, output_len);
+            memset(m_aead_output_mac_buf, 0xFF, sizeof(m_aead_output_mac_buf));
+
+            err_code = aead_stream_crypt(NRF_CRYPTO_ENCRYPT,
+                                         nonce_len,
+                                         ad_len,
+                                         m_aead_output_buf,
+                                         output_len,
+                                         m_aead_output_mac_buf,
+                                         mac_len);
+            if (err_code != NRF_ERROR_CRYPTO_FEATURE_UNAVAILABLE)
+            {
+                TEST_VECTOR_ASSERT_ERR_CODE((err_code == NRF_SUCCESS),
+                                            "streamed nrf_crypto_aead encryption");
+
+                // Verify the streamed ciphertext and MAC against the test vector.
+                TEST_VECTOR_MEMCMP_ASSERT(m_aead_input_buf,
+                                          m_aead_output_buf,
+                                          input_len,
+                                          EXPECTED_TO_PASS,
+                                          "Incorrect streamed AEAD ciphertext");
+
+                TEST_VECTOR_MEMCMP_ASSERT(m_aead_expected_mac_buf,
+                                          m_aead_output_mac_buf,
+                                          mac_len,
+                                          EXPECTED_TO_PASS,
+                                          "Incorrect streamed AEAD MAC");
+
+                TEST_VECTOR_OVERFLOW_ASSERT(m_aead_output_buf, output_len, "output buffer overflow");
+                TEST_VECTOR_OVERFLOW_ASSERT(m_aead_output_mac_buf, mac_len, "MAC buffer overflow");
+
+                // Decrypt the ciphertext in place. MAC will be verified in the lib.
+                err_code = aead_stream_crypt(NRF_CRYPTO_DECRYPT,
+                                             nonce_len,
+                                             ad_len,
+                                             m_aead_output_buf,
+                                             output_len,
+                                             m_aead_expected_mac_buf,
+                                             mac_len);
+                TEST_VECTOR_ASSERT_ERR_CODE((err_code == NRF_SUCCESS),
+                                            "streamed nrf_crypto_aead decryption");
+
+                TEST_VECTOR_MEMCMP_ASSERT(m_aead_expected_output_buf,
+                                          m_aead_output_buf,
+                                          output_len,
+                                          EXPECTED_TO_PASS,
+                                          "Incorrect streamed AEAD plaintext");
+            }
+        }
+
         NRF_LOG_INFO("#%04d Test vector passed: %s %s",
                      p_test_info->current_id,
                      p_test_info->p_test_case_name,
@@ -0,0 +1,684 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stddef.h>
+#include "nrf_error.h"
+#include "app_util.h"
+#include "nrf_section.h"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "common_test.h"
+#include "nrf_crypto.h"
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO)
+
+#define BENCHMARK_AES_MAC_SIZE      (16)                                        /**< Size of the AES CMAC and CBC-MAC output. */
+#define BENCHMARK_AEAD_MAC_MAX_SIZE (16)                                        /**< Largest AEAD MAC size used by the benchmarks. */
+#define BENCHMARK_KEY_MAX_SIZE      (32)                                        /**< Largest symmetric key size. */
+#define BENCHMARK_ECC_HASH_SIZE     (NRF_CRYPTO_HASH_SIZE_SHA256)               /**< Size of the message digest signed in ECDSA benchmarks. */
+#define BENCHMARK_AES_IV_SIZE       (16)                                        /**< Size of the AES initialization vector. */
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MBEDTLS)
+#define BENCHMARK_BACKEND_MBEDTLS   " mbedtls"
+#else
+#define BENCHMARK_BACKEND_MBEDTLS   ""
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_MICRO_ECC)
+#define BENCHMARK_BACKEND_MICRO_ECC " micro_ecc"
+#else
+#define BENCHMARK_BACKEND_MICRO_ECC ""
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_CIFRA)
+#define BENCHMARK_BACKEND_CIFRA     " cifra"
+#else
+#define BENCHMARK_BACKEND_CIFRA     ""
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_NRF_SW)
+#define BENCHMARK_BACKEND_NRF_SW    " nrf_sw"
+#else
+#define BENCHMARK_BACKEND_NRF_SW    ""
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_OBERON)
+#define BENCHMARK_BACKEND_OBERON    " oberon"
+#else
+#define BENCHMARK_BACKEND_OBERON    ""
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_CC310)
+#define BENCHMARK_BACKEND_CC310     " cc310"
+#else
+#define BENCHMARK_BACKEND_CC310     ""
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_CC310_BL)
+#define BENCHMARK_BACKEND_CC310_BL  " cc310_bl"
+#else
+#define BENCHMARK_BACKEND_CC310_BL  ""
+#endif
+
+
+/**@brief Function type for one benchmarked operation.
+ *
+ * @param[in] p_entry    Table entry describing the algorithm to run.
+ */
+typedef ret_code_t (*benchmark_op_t)(void const * p_entry);
+
+
+/**@brief Benchmarked hash algorithm.
+ */
+typedef struct
+{
+    char                         const * p_name;
+    nrf_crypto_hash_info_t       const * p_info;
+} benchmark_hash_t;
+
+
+/**@brief Benchmarked HMAC algorithm.
+ */
+typedef struct
+{
+    char                         const * p_name;
+    nrf_crypto_hmac_info_t       const * p_info;
+} benchmark_hmac_t;
+
+
+/**@brief Benchmarked AES mode.
+ */
+typedef struct
+{
+    char                         const * p_name;
+    nrf_crypto_aes_info_t        const * p_info;
+    size_t                               key_size;                          /**< Key size in bytes. */
+    bool                                 mac;                               /**< True if the mode outputs a MAC instead of ciphertext. */
+} benchmark_aes_t;
+
+
+/**@brief Benchmarked AEAD mode.
+ */
+typedef struct
+{
+    char                         const * p_name;
+    nrf_crypto_aead_info_t       const * p_info;
+    uint8_t                              nonce_size;
+    uint8_t                              mac_size;
+} benchmark_aead_t;
+
+
+/**@brief Benchmarked elliptic curve.
+ */
+typedef struct
+{
+    char                         const * p_name;
+    nrf_crypto_ecc_curve_info_t  const * p_info;
+    size_t                               sign_context_size;                 /**< Size of the ECDSA sign context for this curve. */
+    size_t                               verify_context_size;               /**< Size of the ECDSA verify context for this curve. */
+    size_t                               ecdh_context_size;                 /**< Size of the ECDH context for this curve. */
+    bool                                 ecdsa;                             /**< True if the curve can be used for ECDSA. */
+} benchmark_ecc_t;
+
+
+/**@brief Macro for defining an entry of the elliptic curve table. */
+#define BENCHMARK_ECC_CURVE(_curve, _name, _ecdsa)                                      \
+    {                                                                                   \
+        .p_name              = _name,                                                   \
+        .p_info              = &g_nrf_crypto_ecc_##_curve##_curve_info,                 \
+        .sign_context_size   = sizeof(nrf_crypto_ecdsa_##_curve##_sign_context_t),      \
+        .verify_context_size = sizeof(nrf_crypto_ecdsa_##_curve##_verify_context_t),    \
+        .ecdh_context_size   = sizeof(nrf_crypto_ecdh_##_curve##_context_t),            \
+        .ecdsa               = _ecdsa                                                   \
+    }
+
+
+static uint8_t m_data_in[TEST_BENCHMARK_DATA_SIZE];                             /**< Message processed by the symmetric benchmarks. */
+static uint8_t m_data_out[TEST_BENCHMARK_DATA_SIZE];                            /**< Output of the symmetric benchmarks. */
+static uint8_t m_key[BENCHMARK_KEY_MAX_SIZE];                                   /**< Symmetric key. */
+static uint8_t m_iv[BENCHMARK_AES_IV_SIZE];                                     /**< AES initialization vector. */
+static uint8_t m_nonce[16];                                                     /**< AEAD nonce. */
+static uint8_t m_mac[BENCHMARK_AEAD_MAC_MAX_SIZE];                              /**< AEAD MAC. */
+static uint8_t m_digest[NRF_CRYPTO_HASH_SIZE_SHA512];                           /**< Hash and HMAC output. */
+
+
+/**@brief Function for running one benchmark and logging the result.
+ *
+ * @details The operation is run until it was run @ref TEST_BENCHMARK_ITERATIONS times or
+ *          @ref TEST_BENCHMARK_TIME_LIMIT_MS has passed, whichever comes first.
+ *
+ * @param[in] p_test_info   Test suite information, updated with the outcome.
+ * @param[in] p_operation   Name of the operation, printed before @p p_name.
+ * @param[in] p_name        Name of the benchmarked algorithm.
+ * @param[in] op            Operation to benchmark.
+ * @param[in] p_entry       Table entry passed to @p op.
+ * @param[in] context_size  Size of the context needed by the operation.
+ */
+static void benchmark_run(test_info_t  * p_test_info,
+                          char const   * p_operation,
+                          char const   * p_name,
+                          benchmark_op_t op,
+                          void const   * p_entry,
+                          size_t         context_size)
+{
+    ret_code_t err_code;
+    uint64_t   time_us    = 0;
+    uint32_t   iterations = 0;
+    uint32_t   stack_usage;
+    uint32_t   ops_x100;
+
+    p_test_info->current_id++;
+
+    (void)benchmark_stack_probe(true);
+    do
+    {
+        benchmark_timer_start();
+        err_code = op(p_entry);
+        time_us += benchmark_timer_stop();
+        iterations++;
+    } while ((err_code == NRF_SUCCESS) &&
+             (iterations < TEST_BENCHMARK_ITERATIONS) &&
+             (time_us < TEST_BENCHMARK_TIME_LIMIT_MS * 1000ULL));
+    stack_usage = benchmark_stack_probe(false);
+
+    if (err_code != NRF_SUCCESS)
+    {
+        NRF_LOG_INFO("#%04d Benchmark failed: %s%s err: 0x%x",
+                     p_test_info->current_id, p_operation, p_name, err_code);
+        p_test_info->tests_failed++;
+        return;
+    }
+
+    // Operations per second with two decimals, as the logger cannot print floating point numbers.
+    ops_x100 = (uint32_t)((iterations * 100000000ULL) / MAX(time_us, 1));
+
+    NRF_LOG_INFO("%s%s: %u.%02u ops/s, stack %u B, context %u B",
+                 p_operation, p_name, ops_x100 / 100, ops_x100 % 100, stack_usage, context_size);
+    p_test_info->tests_passed++;
+
+    while (NRF_LOG_PROCESS());
+}
+
+
+/**@brief Function for logging which nrf_crypto backends are compiled in.
+ */
+static void benchmark_backends_log(void)
+{
+    NRF_LOG_INFO("Backends:"
+                 BENCHMARK_BACKEND_MBEDTLS
+                 BENCHMARK_BACKEND_MICRO_ECC
+                 BENCHMARK_BACKEND_CIFRA
+                 BENCHMARK_BACKEND_NRF_SW
+                 BENCHMARK_BACKEND_OBERON
+                 BENCHMARK_BACKEND_CC310
+                 BENCHMARK_BACKEND_CC310_BL);
+    NRF_LOG_INFO("Hash, HMAC, AES and AEAD benchmarks process %u bytes per operation",
+                 TEST_BENCHMARK_DATA_SIZE);
+}
+
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HASH)
+
+static benchmark_hash_t const m_hash_algorithms[] =
+{
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HASH_SHA256)
+    { "SHA-256", &g_nrf_crypto_hash_sha256_info },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HASH_SHA512)
+    { "SHA-512", &g_nrf_crypto_hash_sha512_info },
+#endif
+};
+
+static nrf_crypto_hash_context_t m_hash_context;                                /**< Hash context. */
+
+
+static ret_code_t benchmark_hash_op(void const * p_entry)
+{
+    benchmark_hash_t const * p_hash = p_entry;
+    size_t                   digest_size = sizeof(m_digest);
+
+    return nrf_crypto_hash_calculate(&m_hash_context,
+                                     p_hash->p_info,
+                                     m_data_in,
+                                     sizeof(m_data_in),
+                                     m_digest,
+                                     &digest_size);
+}
+
+
+static void benchmark_hash(test_info_t * p_test_info)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_hash_algorithms); i++)
+    {
+        benchmark_run(p_test_info,
+                      "",
+                      m_hash_algorithms[i].p_name,
+                      benchmark_hash_op,
+                      &m_hash_algorithms[i],
+                      m_hash_algorithms[i].p_info->context_size);
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_CRYPTO_HASH)
+
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HMAC)
+
+static benchmark_hmac_t const m_hmac_algorithms[] =
+{
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HMAC_SHA256)
+    { "HMAC-SHA-256", &g_nrf_crypto_hmac_sha256_info },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HMAC_SHA512)
+    { "HMAC-SHA-512", &g_nrf_crypto_hmac_sha512_info },
+#endif
+};
+
+static nrf_crypto_hmac_context_t m_hmac_context;                                /**< HMAC context. */
+
+
+static ret_code_t benchmark_hmac_op(void const * p_entry)
+{
+    benchmark_hmac_t const * p_hmac      = p_entry;
+    size_t                   digest_size = sizeof(m_digest);
+
+    return nrf_crypto_hmac_calculate(&m_hmac_context,
+                                     p_hmac->p_info,
+                                     m_digest,
+                                     &digest_size,
+                                     m_key,
+                                     sizeof(m_key),
+                                     m_data_in,
+                                     sizeof(m_data_in));
+}
+
+
+static void benchmark_hmac(test_info_t * p_test_info)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_hmac_algorithms); i++)
+    {
+        benchmark_run(p_test_info,
+                      "",
+                      m_hmac_algorithms[i].p_name,
+                      benchmark_hmac_op,
+                      &m_hmac_algorithms[i],
+                      m_hmac_algorithms[i].p_info->context_size);
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_CRYPTO_HMAC)
+
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES)
+
+static benchmark_aes_t const m_aes_modes[] =
+{
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_ECB_128)
+    { "AES-128-ECB",     &g_nrf_crypto_aes_ecb_128_info,     16, false },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_ECB_256)
+    { "AES-256-ECB",     &g_nrf_crypto_aes_ecb_256_info,     32, false },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CBC_128)
+    { "AES-128-CBC",     &g_nrf_crypto_aes_cbc_128_info,     16, false },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CBC_256)
+    { "AES-256-CBC",     &g_nrf_crypto_aes_cbc_256_info,     32, false },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CTR_128)
+    { "AES-128-CTR",     &g_nrf_crypto_aes_ctr_128_info,     16, false },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CTR_256)
+    { "AES-256-CTR",     &g_nrf_crypto_aes_ctr_256_info,     32, false },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CFB_128)
+    { "AES-128-CFB",     &g_nrf_crypto_aes_cfb_128_info,     16, false },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CBC_MAC_128)
+    { "AES-128-CBC-MAC", &g_nrf_crypto_aes_cbc_mac_128_info, 16, true  },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CMAC_128)
+    { "AES-128-CMAC",    &g_nrf_crypto_aes_cmac_128_info,    16, true  },
+#endif
+};
+
+static nrf_crypto_aes_context_t m_aes_context;                                  /**< AES context. */
+
+
+static ret_code_t benchmark_aes_op(void const * p_entry)
+{
+    benchmark_aes_t const * p_aes    = p_entry;
+    size_t                  out_size = p_aes->mac ? BENCHMARK_AES_MAC_SIZE : sizeof(m_data_out);
+
+    return nrf_crypto_aes_crypt(&m_aes_context,
+                                p_aes->p_info,
+                                p_aes->mac ? NRF_CRYPTO_MAC_CALCULATE : NRF_CRYPTO_ENCRYPT,
+                                m_key,
+                                m_iv,
+                                m_data_in,
+                                sizeof(m_data_in),
+                                m_data_out,
+                                &out_size);
+}
+
+
+static void benchmark_aes(test_info_t * p_test_info)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_aes_modes); i++)
+    {
+        benchmark_run(p_test_info,
+                      "",
+                      m_aes_modes[i].p_name,
+                      benchmark_aes_op,
+                      &m_aes_modes[i],
+                      m_aes_modes[i].p_info->context_size);
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_CRYPTO_AES)
+
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AEAD)
+
+static benchmark_aead_t const m_aead_modes[] =
+{
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CCM_128)
+    { "AES-128-CCM",       &g_nrf_crypto_aes_ccm_128_info,      13, 16 },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_CCM_STAR_128)
+    { "AES-128-CCM*",      &g_nrf_crypto_aes_ccm_star_128_info, 13, 8  },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_EAX_128)
+    { "AES-128-EAX",       &g_nrf_crypto_aes_eax_128_info,      16, 16 },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES_GCM_128)
+    { "AES-128-GCM",       &g_nrf_crypto_aes_gcm_128_info,      12, 16 },
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_CHACHA_POLY)
+    { "ChaCha20-Poly1305", &g_nrf_crypto_chacha_poly_256_info,  12, 16 },
+#endif
+};
+
+static nrf_crypto_aead_context_t m_aead_context;                                /**< AEAD context. */
+
+
+static ret_code_t benchmark_aead_op(void const * p_entry)
+{
+    benchmark_aead_t const * p_aead = p_entry;
+    ret_code_t               err_code;
+
+    // Key setup is included, as it is done for every message by most users of the API.
+    err_code = nrf_crypto_aead_init(&m_aead_context, p_aead->p_info, m_key);
+    if (err_code != NRF_SUCCESS)
+    {
+        return err_code;
+    }
+
+    err_code = nrf_crypto_aead_crypt(&m_aead_context,
+                                     NRF_CRYPTO_ENCRYPT,
+                                     m_nonce,
+                                     p_aead->nonce_size,
+                                     NULL,
+                                     0,
+                                     m_data_in,
+                                     sizeof(m_data_in),
+                                     m_data_out,
+                                     m_mac,
+                                     p_aead->mac_size);
+
+    UNUSED_RETURN_VALUE(nrf_crypto_aead_uninit(&m_aead_context));
+    return err_code;
+}
+
+
+static void benchmark_aead(test_info_t * p_test_info)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_aead_modes); i++)
+    {
+        // AEAD info structures do not carry a context size, so the size of the union is reported.
+        benchmark_run(p_test_info,
+                      "",
+                      m_aead_modes[i].p_name,
+                      benchmark_aead_op,
+                      &m_aead_modes[i],
+                      sizeof(nrf_crypto_aead_context_t));
+    }
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_CRYPTO_AEAD)
+
+
+#if NRF_CRYPTO_ECC_ENABLED && !NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_OPTIGA)
+
+static benchmark_ecc_t const m_ecc_curves[] =
+{
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_SECP192R1)
+    BENCHMARK_ECC_CURVE(secp192r1,  "secp192r1",  true),
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_SECP224R1)
+    BENCHMARK_ECC_CURVE(secp224r1,  "secp224r1",  true),
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_SECP256R1)
+    BENCHMARK_ECC_CURVE(secp256r1,  "secp256r1",  true),
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_SECP384R1)
+    BENCHMARK_ECC_CURVE(secp384r1,  "secp384r1",  true),
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_SECP521R1)
+    BENCHMARK_ECC_CURVE(secp521r1,  "secp521r1",  true),
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_SECP256K1)
+    BENCHMARK_ECC_CURVE(secp256k1,  "secp256k1",  true),
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_BP256R1)
+    BENCHMARK_ECC_CURVE(bp256r1,    "bp256r1",    true),
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_ECC_CURVE25519)
+    BENCHMARK_ECC_CURVE(curve25519, "curve25519", false),
+#endif
+};
+
+static nrf_crypto_ecc_private_key_t      m_private_key;                         /**< Own private key. */
+static nrf_crypto_ecc_public_key_t       m_public_key;                          /**< Own public key. */
+static nrf_crypto_ecc_private_key_t      m_peer_private_key;                    /**< Private key of the ECDH peer. */
+static nrf_crypto_ecc_public_key_t       m_peer_public_key;                     /**< Public key of the ECDH peer. */
+static nrf_crypto_ecdsa_sign_context_t   m_sign_context;                        /**< ECDSA sign context. */
+static nrf_crypto_ecdsa_verify_context_t m_verify_context;                      /**< ECDSA verify context. */
+static nrf_crypto_ecdh_context_t         m_ecdh_context;                        /**< ECDH context. */
+static nrf_crypto_ecdsa_signature_t      m_signature;                           /**< Signature made by the sign benchmark. */
+static size_t                            m_signature_size;                      /**< Size of @ref m_signature. */
+static uint8_t                           m_shared_secret[NRF_CRYPTO_ECDH_SHARED_SECRET_MAX_SIZE];
+
+
+static ret_code_t benchmark_ecdsa_sign_op(void const * p_entry)
+{
+    UNUSED_PARAMETER(p_entry);
+
+    m_signature_size = sizeof(m_signature);
+    return nrf_crypto_ecdsa_sign(&m_sign_context,
+                                 &m_private_key,
+                                 m_data_in,
+                                 BENCHMARK_ECC_HASH_SIZE,
+                                 m_signature,
+                                 &m_signature_size);
+}
+
+
+static ret_code_t benchmark_ecdsa_verify_op(void const * p_entry)
+{
+    UNUSED_PARAMETER(p_entry);
+
+    return nrf_crypto_ecdsa_verify(&m_verify_context,
+                                   &m_public_key,
+                                   m_data_in,
+                                   BENCHMARK_ECC_HASH_SIZE,
+                                   m_signature,
+                                   m_signature_size);
+}
+
+
+static ret_code_t benchmark_ecdh_op(void const * p_entry)
+{
+    size_t shared_secret_size = sizeof(m_shared_secret);
+
+    UNUSED_PARAMETER(p_entry);
+
+    return nrf_crypto_ecdh_compute(&m_ecdh_context,
+                                   &m_private_key,
+                                   &m_peer_public_key,
+                                   m_shared_secret,
+                                   &shared_secret_size);
+}
+
+
+static void benchmark_ecc(test_info_t * p_test_info)
+{
+    ret_code_t err_code;
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_ecc_curves); i++)
+    {
+        benchmark_ecc_t const * p_curve = &m_ecc_curves[i];
+
+        // Key generation is not benchmarked, it only prepares the keys for the other operations.
+        err_code = nrf_crypto_ecc_key_pair_generate(NULL, p_curve->p_info, &m_private_key, &m_public_key);
+        if (err_code != NRF_SUCCESS)
+        {
+            NRF_LOG_INFO("%s: key pair generation failed err: 0x%x", p_curve->p_name, err_code);
+            p_test_info->tests_failed++;
+            continue;
+        }
+
+        err_code = nrf_crypto_ecc_key_pair_generate(NULL, p_curve->p_info, &m_peer_private_key, &m_peer_public_key);
+        if (err_code == NRF_SUCCESS)
+        {
+            benchmark_run(p_test_info, "ECDH ", p_curve->p_name, benchmark_ecdh_op, p_curve,
+                          p_curve->ecdh_context_size);
+            UNUSED_RETURN_VALUE(nrf_crypto_ecc_private_key_free(&m_peer_private_key));
+            UNUSED_RETURN_VALUE(nrf_crypto_ecc_public_key_free(&m_peer_public_key));
+        }
+
+#if !NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_CC310_BL)
+        if (p_curve->ecdsa)
+        {
+            benchmark_run(p_test_info, "ECDSA sign ", p_curve->p_name, benchmark_ecdsa_sign_op,
+                          p_curve, p_curve->sign_context_size);
+
+            // The signature made by the last sign operation is verified.
+            benchmark_run(p_test_info, "ECDSA verify ", p_curve->p_name, benchmark_ecdsa_verify_op,
+                          p_curve, p_curve->verify_context_size);
+        }
+#endif
+
+        NRF_LOG_INFO("%s: private key %u B, public key %u B",
+                     p_curve->p_name,
+                     p_curve->p_info->private_key_size,
+                     p_curve->p_info->public_key_size);
+
+        UNUSED_RETURN_VALUE(nrf_crypto_ecc_private_key_free(&m_private_key));
+        UNUSED_RETURN_VALUE(nrf_crypto_ecc_public_key_free(&m_public_key));
+    }
+}
+
+#endif // NRF_CRYPTO_ECC_ENABLED && !NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_OPTIGA)
+
+
+/**@brief Function for running the test setup.
+ */
+ret_code_t setup_test_case_benchmark(void)
+{
+    // Fixed, non-zero inputs. The values do not matter for the timing of any enabled backend.
+    for (size_t i = 0; i < sizeof(m_data_in); i++)
+    {
+        m_data_in[i] = (uint8_t)i;
+    }
+    memset(m_key, 0x5A, sizeof(m_key));
+    memset(m_iv, 0x00, sizeof(m_iv));
+    memset(m_nonce, 0x3C, sizeof(m_nonce));
+
+    benchmark_timer_init();
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for the benchmark execution.
+ */
+ret_code_t exec_test_case_benchmark(test_info_t * p_test_info)
+{
+    benchmark_backends_log();
+
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HASH)
+    benchmark_hash(p_test_info);
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_HMAC)
+    benchmark_hmac(p_test_info);
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AES)
+    benchmark_aes(p_test_info);
+#endif
+#if NRF_MODULE_ENABLED(NRF_CRYPTO_AEAD)
+    benchmark_aead(p_test_info);
+#endif
+#if NRF_CRYPTO_ECC_ENABLED && !NRF_MODULE_ENABLED(NRF_CRYPTO_BACKEND_OPTIGA)
+    benchmark_ecc(p_test_info);
+#endif
+
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Function for running the test teardown.
+ */
+ret_code_t teardown_test_case_benchmark(void)
+{
+    return NRF_SUCCESS;
+}
+
+
+/** @brief  Macro for registering the benchmark test case by using section variables.
+ *
+ * @details     This macro places a variable in a section named "test_case_data",
+ *              which is initialized by main.
+ */
+NRF_SECTION_ITEM_REGISTER(test_case_data, test_case_t test_benchmark) =
+{
+    .p_test_case_name = "Benchmark",
+    .setup = setup_test_case_benchmark,
+    .exec = exec_test_case_benchmark,
+    .teardown = teardown_test_case_benchmark
+};
+
+#endif // NRF_MODULE_ENABLED(NRF_CRYPTO)
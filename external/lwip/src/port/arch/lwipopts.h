@@ -35,11 +35,16 @@
 
 #define NO_SYS                      1
 #define NO_SYS_NO_TIMERS            0
+// All lwIP allocations, including memp elements and PBUF_RAM pbufs, go through mem_malloc() which
+// is implemented in nrf_platform_port.c. By default it uses the memory manager heap. With
+// NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED set in sdk_config.h, it serves each request from the
+// smallest fitting nrf_balloc pool instead, so lwIP memory is fully reserved at compile time.
 #define MEM_LIBC_MALLOC             1
 #define MEMP_MEM_MALLOC             1
 #define MEM_ALIGNMENT               4
 #define MEM_SIZE                    0
 #define PBUF_POOL_SIZE              32
+
 #define LWIP_ARP                    0
 #define IP_REASS_MAX_PBUFS          0
 #define IP_FRAG_USES_STATIC_BUF     0
@@ -24,6 +24,9 @@
 #include "mem_manager.h"
 #include "iot_context_manager.h"
 #include "nrf_platform_port.h"
+#if NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
+#include "nrf_balloc.h"
+#endif
 
 /**
  * @defgroup nrf_driver_debug_log Module's Log Macros
@@ -71,29 +74,77 @@ struct blenetif {
   struct netif      netif;
 };
 
+/** Received packet wrapped in a custom pbuf, so that LwIP references it instead of a copy. */
+struct blenetif_rx_pbuf {
+  struct pbuf_custom pbuf;       /**< Must be first, LwIP releases the packet through this pbuf. */
+  uint8_t          * p_packet;   /**< Packet memory allocated by 6lowpan. */
+};
+
 struct blenetif m_blenetif_table[BLE_6LOWPAN_MAX_INTERFACE];   /**< Table maintaining network interface of LwIP and also corresponding 6lowpan interface. */
 
-/** @brief Function to add received packet to pbuf queue and notify the stack of received packet. */
+#if NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
+NRF_BALLOC_DEF(m_lwip_small_pool,  NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_SIZE,  NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_COUNT);
+NRF_BALLOC_DEF(m_lwip_medium_pool, NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_SIZE, NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_COUNT);
+NRF_BALLOC_DEF(m_lwip_large_pool,  NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_SIZE,  NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_COUNT);
+
+/** Pools backing mem_malloc(), in increasing order of block size. */
+static nrf_balloc_t const * const m_lwip_pools[] =
+{
+    &m_lwip_small_pool,
+    &m_lwip_medium_pool,
+    &m_lwip_large_pool
+};
+#endif // NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
+
+
+/** @brief Function to release a received packet once LwIP no longer references it. */
+static void blenetif_rx_pbuf_free(struct pbuf * p_buffer)
+{
+    struct blenetif_rx_pbuf * p_rx_pbuf = (struct blenetif_rx_pbuf *)p_buffer;
+
+    nrf_free(p_rx_pbuf->p_packet);
+    mem_free(p_rx_pbuf);
+}
+
+
+/** @brief Function to hand a received packet to the stack without copying it.
+ *
+ *  @details Ownership of the packet memory passes to this function. It is freed when the last
+ *           reference to the pbuf is released, which can be after this function returns, for
+ *           example when TCP queues out-of-sequence data.
+ */
 static void blenetif_input(struct netif  * p_netif,  uint8_t * p_payload, uint16_t payload_len)
 {
-    struct pbuf  * p_buffer;
+    struct blenetif_rx_pbuf * p_rx_pbuf;
+    struct pbuf             * p_buffer;
 
     NRF_DRIVER_ENTRY();
     NRF_DRIVER_DUMP(p_payload, payload_len);
 
-    // Allocate a pbuf chain of pbufs from the pool.
-    p_buffer = pbuf_alloc(PBUF_RAW, payload_len, PBUF_REF);
+    p_rx_pbuf = mem_malloc(sizeof(struct blenetif_rx_pbuf));
 
-    if (p_buffer != NULL)
+    if (p_rx_pbuf != NULL)
     {
-        p_buffer->payload = p_payload;
-        p_buffer->len     = payload_len;
-        p_buffer->tot_len = payload_len;
+        p_rx_pbuf->p_packet                  = p_payload;
+        p_rx_pbuf->pbuf.custom_free_function = blenetif_rx_pbuf_free;
+
+        p_buffer = pbuf_alloced_custom(PBUF_RAW,
+                                       payload_len,
+                                       PBUF_REF,
+                                       &p_rx_pbuf->pbuf,
+                                       p_payload,
+                                       payload_len);
+
+        // The stack always consumes the pbuf, also when the packet is dropped.
         if (ip6_input(p_buffer, p_netif) != ERR_OK)
         {
             NRF_DRIVER_LOG("IP Stack returned error.");
         }
-        UNUSED_VARIABLE(pbuf_free(p_buffer));
+    }
+    else
+    {
+        NRF_DRIVER_ERR("Dropping packet, failed to allocate pbuf.");
+        nrf_free(p_payload);
     }
 
     NRF_DRIVER_EXIT();
@@ -106,17 +157,18 @@ static err_t blenetif_output(struct netif * p_netif, struct pbuf * p_buffer, con
     struct blenetif * p_blenetif    = (struct blenetif *)p_netif->state;
     uint8_t         * p_payload;
     err_t             error_code    = ERR_MEM;
-    const    uint16_t requested_len = p_buffer->len;
+    const    uint16_t requested_len = p_buffer->tot_len;
 
 
     NRF_DRIVER_ENTRY();
-    NRF_DRIVER_DUMP(p_buffer->payload, requested_len);
+    NRF_DRIVER_DUMP(p_buffer->payload, p_buffer->len);
 
-    p_payload = nrf_malloc(p_buffer->len);
+    // 6lowpan compresses the packet in place and releases it with nrf_free() once sent.
+    p_payload = nrf_malloc(requested_len);
 
     if (NULL != p_payload)
     {
-        memcpy(p_payload, p_buffer->payload, p_buffer->len);
+        UNUSED_VARIABLE(pbuf_copy_partial(p_buffer, p_payload, requested_len, 0));
         uint32_t retval = ble_6lowpan_interface_send(p_blenetif->p_ble_interface,
                                                      p_payload,
                                                      requested_len);
@@ -195,6 +247,12 @@ static void blenetif_transport_callback(iot_interface_t     * p_interface,
                         break;
                     }
                 }
+
+                if (p_blenetif == NULL)
+                {
+                    NRF_DRIVER_ERR("No free network interface!");
+                    break;
+                }
             }
             else
             {
@@ -259,15 +317,15 @@ static void blenetif_transport_callback(iot_interface_t     * p_interface,
         {
             if (p_blenetif != NULL)
             {
-                // Handle received IP packet.
+                // Handle received IP packet. The packet is freed once the stack releases it.
                 blenetif_input(&p_blenetif->netif,
                                p_event->event_param.rx_event_param.p_packet,
                                p_event->event_param.rx_event_param.packet_len);
-                nrf_free(p_event->event_param.rx_event_param.p_packet);
             }
             else
             {
                 NRF_DRIVER_ERR("Dropping packet, unknown interface.");
+                nrf_free(p_event->event_param.rx_event_param.p_packet);
             }
             break;
         }
@@ -287,6 +345,14 @@ uint32_t nrf_driver_init(void)
     init_param.event_handler = blenetif_transport_callback;
     init_param.p_eui64       = EUI64_LOCAL_IID;
 
+#if NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
+    for (index = 0; index < ARRAY_SIZE(m_lwip_pools); index++)
+    {
+        err_code = nrf_balloc_init(m_lwip_pools[index]);
+        VERIFY_SUCCESS(err_code);
+    }
+#endif // NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
+
     err_code = iot_context_manager_init();
 
     if (err_code == NRF_SUCCESS)
@@ -327,6 +393,84 @@ u32_t sys_now(void)
     return sys_tick;
 }
 
+#if NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
+
+/**@brief Function for finding the pool that a block belongs to. */
+static nrf_balloc_t const * lwip_pool_find(void * p_mem)
+{
+    for (uint32_t index = 0; index < ARRAY_SIZE(m_lwip_pools); index++)
+    {
+        nrf_balloc_t const * p_pool  = m_lwip_pools[index];
+        uint8_t            * p_begin = p_pool->p_memory_begin;
+        size_t               size    = p_pool->block_size *
+                                       (size_t)(p_pool->p_stack_limit - p_pool->p_stack_base);
+
+        if (((uint8_t *)p_mem >= p_begin) && ((uint8_t *)p_mem < p_begin + size))
+        {
+            return p_pool;
+        }
+    }
+
+    return NULL;
+}
+
+void  mem_init(void)
+{
+}
+
+void *mem_trim(void *mem, mem_size_t size)
+{
+    // Blocks cannot shrink, LwIP accepts the block being trimmed in place.
+    UNUSED_PARAMETER(size);
+    return mem;
+}
+
+void *mem_malloc(mem_size_t size)
+{
+    // Use the smallest block that fits, falling back to larger blocks when a pool is exhausted.
+    for (uint32_t index = 0; index < ARRAY_SIZE(m_lwip_pools); index++)
+    {
+        if (NRF_BALLOC_ELEMENT_SIZE(m_lwip_pools[index]) >= size)
+        {
+            void * p_mem = nrf_balloc_alloc(m_lwip_pools[index]);
+
+            if (p_mem != NULL)
+            {
+                return p_mem;
+            }
+        }
+    }
+
+    NRF_DRIVER_ERR("Failed to allocate %d bytes.", size);
+
+    return NULL;
+}
+
+void *mem_calloc(mem_size_t count, mem_size_t size)
+{
+    void * p_mem = mem_malloc(count * size);
+
+    if (p_mem != NULL)
+    {
+        memset(p_mem, 0, count * size);
+    }
+
+    return p_mem;
+}
+
+void  mem_free(void *mem)
+{
+    if (mem != NULL)
+    {
+        nrf_balloc_t const * p_pool = lwip_pool_find(mem);
+
+        ASSERT(p_pool != NULL);
+        nrf_balloc_free(p_pool, mem);
+    }
+}
+
+#else
+
 void  mem_init(void)
 {
 }
@@ -350,3 +494,5 @@ void  mem_free(void *mem)
 {
     nrf_free(mem);
 }
+
+#endif // NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
@@ -52,6 +52,10 @@
 #include "iot_timer.h"
 #include "iot_errors.h"
 
+#if (NRF_TLS_SESSION_CACHE_SIZE > 0) && NRF_TLS_SESSION_CACHE_FDS_ENABLED
+#include "fds.h"
+#endif
+
 #if TLS_CONFIG_LOG_ENABLED
 
 #define NRF_LOG_MODULE_NAME TLS
@@ -112,6 +116,8 @@ typedef struct
     uint32_t               start_tick;                               /**< Indicator (in milliseconds) of when the timeout was requested. */
     uint32_t               intrmediate_delay;                        /**< Period indicating intermediate timeout period in milliseconds. */
     uint32_t               final_delay;                              /**< Final timeout period in milliseconds. */
+    uint32_t               session_cache_key;                        /**< Key under which the session of a client instance is cached. Zero if not cached. */
+    bool                   session_cached;                           /**< The session established on the instance has been cached. */
 } interface_t;
 
 
@@ -145,6 +151,46 @@ static uint8_t       m_input_buffer[INPUT_BUFFER_SIZE * NRF_TLS_MAX_INSTANCE_COU
 SDK_MUTEX_DEFINE(m_tls_mutex)                                                              /**< Mutex variable. Currently unused, this declaration does not occupy any space in RAM. */
 
 
+#if (NRF_TLS_SESSION_CACHE_SIZE > 0)
+
+/**@brief Session kept for resumption.
+ *
+ * @details The entry holds no references to allocated memory so that it can be stored in flash.
+ *          The peer certificate is not kept, it is not available on resumed sessions.
+ */
+typedef struct
+{
+    uint32_t key;                                                    /**< Session cache key of the client instance. Zero for sessions cached by a server. */
+    uint32_t timestamp;                                              /**< Wall clock time in milliseconds when the session was cached. */
+    uint32_t sequence;                                               /**< Order in which sessions were last used. The least recently used session is replaced first. */
+    int32_t  ciphersuite;                                            /**< Chosen ciphersuite. */
+    int32_t  compression;                                            /**< Chosen compression. */
+    uint32_t verify_result;                                          /**< Verification result of the peer certificate. */
+    uint32_t ticket_lifetime;                                        /**< Ticket lifetime hint from the server. */
+    uint16_t ticket_len;                                             /**< Length of the session ticket. Zero if no ticket is cached. */
+    uint8_t  id_len;                                                 /**< Length of the session identifier. */
+    uint8_t  in_use;                                                 /**< The entry holds a session. */
+    uint8_t  mfl_code;                                               /**< Negotiated maximum fragment length. */
+    uint8_t  trunc_hmac;                                             /**< Truncated HMAC is used. */
+    uint8_t  encrypt_then_mac;                                       /**< Encrypt-then-MAC is used. */
+    uint8_t  reserved;
+    uint8_t  id[32];                                                 /**< Session identifier. */
+    uint8_t  master[48];                                             /**< Master secret. */
+    uint8_t  ticket[NRF_TLS_SESSION_CACHE_TICKET_MAX_LEN];           /**< RFC 5077 session ticket. */
+} session_entry_t;
+
+static session_entry_t m_session_cache[NRF_TLS_SESSION_CACHE_SIZE];                        /**< Sessions kept for resumption. */
+static uint32_t        m_session_sequence;                                                 /**< Sequence number of the most recently cached session. */
+
+#if NRF_TLS_SESSION_CACHE_FDS_ENABLED
+static session_entry_t m_session_record;                                                   /**< Session being written to flash. */
+static bool            m_session_write_pending;                                            /**< @ref m_session_record is in use by FDS. */
+static bool            m_session_fds_registered;                                           /**< The FDS event handler has been registered. */
+#endif // NRF_TLS_SESSION_CACHE_FDS_ENABLED
+
+#endif // NRF_TLS_SESSION_CACHE_SIZE
+
+
 /**@brief Initializes the interface.
  *
  * @param[in] index Identifies instance in m_interface table to be initialized.
@@ -268,6 +314,11 @@ static uint32_t interface_alloc(nrf_tls_instance_t      * p_instance,
                 // Procedure was successful.
                 p_interface->transport_id = p_instance->transport_id;
                 p_instance->instance_id   = index;
+
+                if (p_options->role == NRF_TLS_ROLE_CLIENT)
+                {
+                    p_interface->session_cache_key = p_options->session_cache_key;
+                }
             }
             else
             {
@@ -446,6 +497,497 @@ static int random_vector_generate(void          * p_ctx,
 }
 
 
+#if (NRF_TLS_SESSION_CACHE_SIZE > 0)
+
+/**@brief Checks if a cached session is too old to be resumed.
+ *
+ * @param[in] p_entry Cached session.
+ *
+ * @retval true if the session shall not be resumed.
+ * @retval false otherwise.
+ */
+static bool session_entry_expired(session_entry_t const * p_entry)
+{
+    iot_timer_time_in_ms_t timestamp    = p_entry->timestamp;
+    iot_timer_time_in_ms_t elapsed_time = 0;
+
+    UNUSED_RETURN_VALUE(iot_timer_wall_clock_delta_get(&timestamp, &elapsed_time));
+
+    return (elapsed_time >= NRF_TLS_SESSION_CACHE_TIMEOUT);
+}
+
+
+/**@brief Finds the entry in which a session is to be cached.
+ *
+ * @details The entry already holding the session of the same client, or the session with the
+ *          same identifier for servers, is reused. Otherwise a free or expired entry is used, and
+ *          if there is none, the entry of the oldest session.
+ *
+ * @param[in] key       Session cache key of the client instance, zero for servers.
+ * @param[in] p_session Session to be cached. Only used for servers.
+ *
+ * @retval Pointer to the entry to be used.
+ */
+static session_entry_t * session_entry_alloc(uint32_t key, mbedtls_ssl_session const * p_session)
+{
+    session_entry_t * p_free   = NULL;
+    session_entry_t * p_oldest = &m_session_cache[0];
+    uint32_t          index;
+
+    for (index = 0; index < NRF_TLS_SESSION_CACHE_SIZE; index++)
+    {
+        session_entry_t * p_entry = &m_session_cache[index];
+
+        if (!p_entry->in_use || session_entry_expired(p_entry))
+        {
+            if (p_free == NULL)
+            {
+                p_free = p_entry;
+            }
+            continue;
+        }
+
+        if (key != 0)
+        {
+            if (p_entry->key == key)
+            {
+                return p_entry;
+            }
+        }
+        else if ((p_entry->key    == 0)                         &&
+                 (p_entry->id_len == p_session->id_len)         &&
+                 (memcmp(p_entry->id, p_session->id, p_entry->id_len) == 0))
+        {
+            return p_entry;
+        }
+
+        if ((int32_t)(p_entry->sequence - p_oldest->sequence) < 0)
+        {
+            p_oldest = p_entry;
+        }
+    }
+
+    return (p_free != NULL) ? p_free : p_oldest;
+}
+
+
+#if NRF_TLS_SESSION_CACHE_FDS_ENABLED
+
+/**@brief Maps a session cache key to the key of the record storing the session. */
+#define SESSION_RECORD_KEY(KEY) ((uint16_t)(((KEY) % 0xBFFEUL) + 1))
+
+
+/**@brief Handles FDS events related to the stored sessions.
+ *
+ * @param[in] p_evt FDS event.
+ */
+static void session_fds_evt_handler(fds_evt_t const * p_evt)
+{
+    if (((p_evt->id == FDS_EVT_WRITE) || (p_evt->id == FDS_EVT_UPDATE)) &&
+        (p_evt->write.file_id == NRF_TLS_SESSION_CACHE_FDS_FILE_ID))
+    {
+        m_session_write_pending = false;
+
+        if (p_evt->result != NRF_SUCCESS)
+        {
+            TLS_ERR("Storing session 0x%04x failed, error 0x%08lx",
+                    p_evt->write.record_key,
+                    p_evt->result);
+        }
+    }
+}
+
+
+/**@brief Stores a cached client session in flash.
+ *
+ * @param[in] p_entry Cached session.
+ */
+static void session_record_store(session_entry_t const * p_entry)
+{
+    uint32_t          err_code;
+    fds_record_desc_t desc;
+    fds_find_token_t  token;
+    fds_record_t      record;
+
+    if (m_session_write_pending)
+    {
+        // Skipped, the session is still resumed from RAM until the next reset.
+        TLS_LOG("Session storage busy, session not stored.");
+        return;
+    }
+
+    m_session_record = (*p_entry);
+
+    record.file_id           = NRF_TLS_SESSION_CACHE_FDS_FILE_ID;
+    record.key               = SESSION_RECORD_KEY(p_entry->key);
+    record.data.p_data       = &m_session_record;
+    record.data.length_words = BYTES_TO_WORDS(sizeof(m_session_record));
+
+    memset(&token, 0, sizeof(token));
+    if (fds_record_find(record.file_id, record.key, &desc, &token) == NRF_SUCCESS)
+    {
+        err_code = fds_record_update(&desc, &record);
+    }
+    else
+    {
+        err_code = fds_record_write(NULL, &record);
+    }
+
+    if (err_code == NRF_SUCCESS)
+    {
+        m_session_write_pending = true;
+    }
+    else
+    {
+        TLS_ERR("Session not stored, error 0x%08lx", err_code);
+
+        if (err_code == FDS_ERR_NO_SPACE_IN_FLASH)
+        {
+            // Make room for the next time a session is stored.
+            UNUSED_RETURN_VALUE(fds_gc());
+        }
+    }
+}
+
+
+/**@brief Loads a client session stored in flash into the cache.
+ *
+ * @param[in] key Session cache key of the client instance.
+ *
+ * @retval Pointer to the cached session if it was found in flash, else NULL.
+ */
+static session_entry_t * session_record_load(uint32_t key)
+{
+    fds_record_desc_t       desc;
+    fds_find_token_t        token;
+    fds_flash_record_t      flash_record;
+    session_entry_t const * p_record;
+    session_entry_t       * p_entry = NULL;
+
+    memset(&token, 0, sizeof(token));
+    if (fds_record_find(NRF_TLS_SESSION_CACHE_FDS_FILE_ID,
+                        SESSION_RECORD_KEY(key),
+                        &desc,
+                        &token) != NRF_SUCCESS)
+    {
+        return NULL;
+    }
+
+    if (fds_record_open(&desc, &flash_record) != NRF_SUCCESS)
+    {
+        return NULL;
+    }
+
+    p_record = (session_entry_t const *)flash_record.p_data;
+
+    if ((flash_record.p_header->length_words == BYTES_TO_WORDS(sizeof(session_entry_t))) &&
+        (p_record->in_use)                                                               &&
+        (p_record->key == key))
+    {
+        p_entry = session_entry_alloc(key, NULL);
+
+        (*p_entry)         = (*p_record);
+        p_entry->sequence  = ++m_session_sequence;
+        p_entry->timestamp = 0;
+
+        // The wall clock restarted with the reset, the server decides if the session is too old.
+        UNUSED_RETURN_VALUE(iot_timer_wall_clock_get(&p_entry->timestamp));
+    }
+
+    UNUSED_RETURN_VALUE(fds_record_close(&desc));
+
+    return p_entry;
+}
+
+#endif // NRF_TLS_SESSION_CACHE_FDS_ENABLED
+
+
+/**@brief Caches a session for resumption.
+ *
+ * @param[in] key       Session cache key of the client instance, zero for servers.
+ * @param[in] p_session Established session.
+ */
+static void session_cache_store(uint32_t key, mbedtls_ssl_session const * p_session)
+{
+    session_entry_t * p_entry = session_entry_alloc(key, p_session);
+
+    memset(p_entry, 0, sizeof(session_entry_t));
+
+    p_entry->key           = key;
+    p_entry->sequence      = ++m_session_sequence;
+    p_entry->ciphersuite   = p_session->ciphersuite;
+    p_entry->compression   = p_session->compression;
+    p_entry->verify_result = p_session->verify_result;
+    p_entry->id_len        = (uint8_t)p_session->id_len;
+    p_entry->in_use        = 1;
+
+    memcpy(p_entry->id, p_session->id, sizeof(p_entry->id));
+    memcpy(p_entry->master, p_session->master, sizeof(p_entry->master));
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+    if ((p_session->ticket != NULL) &&
+        (p_session->ticket_len <= NRF_TLS_SESSION_CACHE_TICKET_MAX_LEN))
+    {
+        memcpy(p_entry->ticket, p_session->ticket, p_session->ticket_len);
+        p_entry->ticket_len      = (uint16_t)p_session->ticket_len;
+        p_entry->ticket_lifetime = p_session->ticket_lifetime;
+    }
+#endif // MBEDTLS_SSL_SESSION_TICKETS && MBEDTLS_SSL_CLI_C
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    p_entry->mfl_code = p_session->mfl_code;
+#endif // MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+    p_entry->trunc_hmac = (uint8_t)p_session->trunc_hmac;
+#endif // MBEDTLS_SSL_TRUNCATED_HMAC
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+    p_entry->encrypt_then_mac = (uint8_t)p_session->encrypt_then_mac;
+#endif // MBEDTLS_SSL_ENCRYPT_THEN_MAC
+
+    UNUSED_RETURN_VALUE(iot_timer_wall_clock_get(&p_entry->timestamp));
+
+    TLS_LOG("Session cached, key 0x%08lx, id length %d", key, p_entry->id_len);
+
+#if NRF_TLS_SESSION_CACHE_FDS_ENABLED
+    if (key != 0)
+    {
+        session_record_store(p_entry);
+    }
+#endif // NRF_TLS_SESSION_CACHE_FDS_ENABLED
+}
+
+
+#if defined(MBEDTLS_SSL_SRV_C)
+
+/**@brief Session cache lookup function registered with the TLS library for server instances.
+ *
+ * @param[in]    p_ctx     Context registered with the library. Not used.
+ * @param[inout] p_session Session requested by the client. The master secret is filled in if
+ *                         the session is found.
+ *
+ * @retval 0 if the session was found and can be resumed.
+ * @retval 1 otherwise.
+ */
+static int session_cache_get(void * p_ctx, mbedtls_ssl_session * p_session)
+{
+    uint32_t index;
+
+    UNUSED_PARAMETER(p_ctx);
+
+    for (index = 0; index < NRF_TLS_SESSION_CACHE_SIZE; index++)
+    {
+        session_entry_t * p_entry = &m_session_cache[index];
+
+        if ((p_entry->in_use)                                    &&
+            (p_entry->key           == 0)                        &&
+            (p_entry->ciphersuite   == p_session->ciphersuite)   &&
+            (p_entry->compression   == p_session->compression)   &&
+            (p_entry->id_len        == p_session->id_len)        &&
+            (memcmp(p_entry->id, p_session->id, p_entry->id_len) == 0) &&
+            (!session_entry_expired(p_entry)))
+        {
+            memcpy(p_session->master, p_entry->master, sizeof(p_session->master));
+            p_session->verify_result = p_entry->verify_result;
+
+            // Resumed sessions are replaced last.
+            p_entry->sequence = ++m_session_sequence;
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+/**@brief Session cache store function registered with the TLS library for server instances.
+ *
+ * @param[in] p_ctx     Context registered with the library. Not used.
+ * @param[in] p_session Session established with a client.
+ *
+ * @retval 0 always, the session replaces the oldest one when the cache is full.
+ */
+static int session_cache_set(void * p_ctx, mbedtls_ssl_session const * p_session)
+{
+    UNUSED_PARAMETER(p_ctx);
+
+    session_cache_store(0, p_session);
+
+    return 0;
+}
+
+#endif // MBEDTLS_SSL_SRV_C
+
+
+/**@brief Offers the cached session to the server when a client instance starts the handshake.
+ *
+ * @param[in] p_interface TLS interface instance for which the procedure is requested.
+ */
+static void interface_session_resume(interface_t * p_interface)
+{
+#if defined(MBEDTLS_SSL_CLI_C)
+    session_entry_t * p_entry = NULL;
+    uint32_t          index;
+
+    if (p_interface->session_cache_key == 0)
+    {
+        return;
+    }
+
+    for (index = 0; index < NRF_TLS_SESSION_CACHE_SIZE; index++)
+    {
+        if ((m_session_cache[index].in_use) &&
+            (m_session_cache[index].key == p_interface->session_cache_key))
+        {
+            p_entry = &m_session_cache[index];
+            break;
+        }
+    }
+
+#if NRF_TLS_SESSION_CACHE_FDS_ENABLED
+    if (p_entry == NULL)
+    {
+        p_entry = session_record_load(p_interface->session_cache_key);
+    }
+#endif // NRF_TLS_SESSION_CACHE_FDS_ENABLED
+
+    if ((p_entry != NULL) && !session_entry_expired(p_entry))
+    {
+        mbedtls_ssl_session session;
+
+        mbedtls_ssl_session_init(&session);
+
+        session.ciphersuite   = p_entry->ciphersuite;
+        session.compression   = p_entry->compression;
+        session.verify_result = p_entry->verify_result;
+        session.id_len        = p_entry->id_len;
+
+        memcpy(session.id, p_entry->id, sizeof(session.id));
+        memcpy(session.master, p_entry->master, sizeof(session.master));
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+        if (p_entry->ticket_len > 0)
+        {
+            // The library keeps its own copy of the ticket.
+            session.ticket          = p_entry->ticket;
+            session.ticket_len      = p_entry->ticket_len;
+            session.ticket_lifetime = p_entry->ticket_lifetime;
+        }
+#endif // MBEDTLS_SSL_SESSION_TICKETS
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+        session.mfl_code = p_entry->mfl_code;
+#endif // MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#if defined(MBEDTLS_SSL_TRUNCATED_HMAC)
+        session.trunc_hmac = p_entry->trunc_hmac;
+#endif // MBEDTLS_SSL_TRUNCATED_HMAC
+#if defined(MBEDTLS_SSL_ENCRYPT_THEN_MAC)
+        session.encrypt_then_mac = p_entry->encrypt_then_mac;
+#endif // MBEDTLS_SSL_ENCRYPT_THEN_MAC
+
+        int result = mbedtls_ssl_set_session(&p_interface->context, &session);
+
+        TLS_LOG("[%p]: Resuming cached session, result %d", p_interface, result);
+        UNUSED_VARIABLE(result);
+    }
+#else
+    UNUSED_PARAMETER(p_interface);
+#endif // MBEDTLS_SSL_CLI_C
+}
+
+
+/**@brief Checks if a cached client session is the one established on an instance.
+ *
+ * @details This is the case when the handshake resumed the cached session and the server did not
+ *          issue a new ticket.
+ *
+ * @param[in] key       Session cache key of the client instance.
+ * @param[in] p_session Established session.
+ *
+ * @retval Pointer to the cached session if it is unchanged, else NULL.
+ */
+static session_entry_t * session_entry_unchanged(uint32_t key, mbedtls_ssl_session const * p_session)
+{
+    uint32_t index;
+
+    for (index = 0; index < NRF_TLS_SESSION_CACHE_SIZE; index++)
+    {
+        session_entry_t * p_entry = &m_session_cache[index];
+
+        if ((!p_entry->in_use) || (p_entry->key != key))
+        {
+            continue;
+        }
+
+        // A full handshake always derives a new master secret. The session ID is not compared,
+        // because the client sends a random one when it offers a ticket.
+        if (memcmp(p_entry->master, p_session->master, sizeof(p_entry->master)) != 0)
+        {
+            return NULL;
+        }
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+        if ((p_session->ticket != NULL) &&
+            (p_session->ticket_len <= NRF_TLS_SESSION_CACHE_TICKET_MAX_LEN))
+        {
+            if ((p_entry->ticket_len != p_session->ticket_len) ||
+                (memcmp(p_entry->ticket, p_session->ticket, p_entry->ticket_len) != 0))
+            {
+                return NULL;
+            }
+        }
+#endif // MBEDTLS_SSL_SESSION_TICKETS && MBEDTLS_SSL_CLI_C
+
+        return p_entry;
+    }
+
+    return NULL;
+}
+
+
+/**@brief Caches the session of a client instance once its handshake is complete.
+ *
+ * @details A resumed session is only stored again if the server issued a new ticket, so that
+ *          reconnecting does not rewrite the flash record every time.
+ *
+ * @param[in] p_interface TLS interface instance for which the procedure is requested.
+ */
+static void interface_session_save(interface_t * p_interface)
+{
+    if ((p_interface->session_cache_key != 0)                         &&
+        (!p_interface->session_cached)                                &&
+        (p_interface->context.state == MBEDTLS_SSL_HANDSHAKE_OVER)    &&
+        (p_interface->context.session != NULL))
+    {
+        session_entry_t * p_entry = session_entry_unchanged(p_interface->session_cache_key,
+                                                            p_interface->context.session);
+        if (p_entry != NULL)
+        {
+            // Resumed sessions are replaced last.
+            p_entry->sequence = ++m_session_sequence;
+        }
+        else
+        {
+            session_cache_store(p_interface->session_cache_key, p_interface->context.session);
+        }
+        p_interface->session_cached = true;
+    }
+}
+
+#else
+
+static void interface_session_resume(interface_t * p_interface)
+{
+    UNUSED_PARAMETER(p_interface);
+}
+
+
+static void interface_session_save(interface_t * p_interface)
+{
+    UNUSED_PARAMETER(p_interface);
+}
+
+#endif // NRF_TLS_SESSION_CACHE_SIZE
+
+
 /**@brief Routine called periodically to advance the SSL context state.
  *
  * @param[in] p_instance Provides transport identifier for the TLS instance.
@@ -464,6 +1006,8 @@ static void interface_continue(interface_t * p_interface)
 
         TLS_MUTEX_LOCK();
 
+        interface_session_save(p_interface);
+
         TLS_TRC("[%p]: mbedtls_ssl_read result(len) 0x%08lx",
                 p_interface,
                 len);
@@ -809,6 +1353,16 @@ static uint32_t interface_conf_setup(uint32_t                  instance_id,
         err_code = verify_options_set(p_interface, p_options->p_key_settings);
     }
 
+#if (NRF_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_SSL_SRV_C)
+    if ((err_code == NRF_SUCCESS) && (p_options->role == NRF_TLS_ROLE_SERVER))
+    {
+        mbedtls_ssl_conf_session_cache(&p_interface->conf,
+                                       NULL,
+                                       session_cache_get,
+                                       session_cache_set);
+    }
+#endif // NRF_TLS_SESSION_CACHE_SIZE && MBEDTLS_SSL_SRV_C
+
 #ifdef MBEDTLS_SSL_PROTO_DTLS
     if (err_code == NRF_SUCCESS)
     {
@@ -880,6 +1434,8 @@ static uint32_t interface_ssl_context_setup(uint32_t instance_id)
                                       tls_get_timer);
         }
 
+        interface_session_resume(p_interface);
+
         TLS_MUTEX_UNLOCK();
 
         result = mbedtls_ssl_handshake(&p_interface->context);
@@ -888,6 +1444,8 @@ static uint32_t interface_ssl_context_setup(uint32_t instance_id)
 
         TLS_LOG("mbedtls_ssl_handshake result %d", result);
 
+        interface_session_save(p_interface);
+
         if (result == MBEDTLS_ERR_SSL_CONN_EOF)
         {
             result = 0;
@@ -917,6 +1475,20 @@ uint32_t nrf_tls_init(void)
 
     UNUSED_RETURN_VALUE(nrf_drv_rng_init(NULL));
 
+#if (NRF_TLS_SESSION_CACHE_SIZE > 0) && NRF_TLS_SESSION_CACHE_FDS_ENABLED
+    if (!m_session_fds_registered)
+    {
+        uint32_t err_code = fds_register(session_fds_evt_handler);
+
+        if (err_code != NRF_SUCCESS)
+        {
+            return err_code;
+        }
+
+        m_session_fds_registered = true;
+    }
+#endif // NRF_TLS_SESSION_CACHE_SIZE && NRF_TLS_SESSION_CACHE_FDS_ENABLED
+
     return NRF_SUCCESS;
 }
 
@@ -1049,6 +1621,8 @@ uint32_t nrf_tls_write(nrf_tls_instance_t const * p_instance,
 
         TLS_MUTEX_LOCK();
 
+        interface_session_save(p_interface);
+
         if (actual_len < 0)
         {
             err_code = (NRF_ERROR_INTERNAL | IOT_TLS_ERR_BASE);
@@ -1093,6 +1667,22 @@ uint32_t nrf_tls_free(nrf_tls_instance_t const * p_instance)
 }
 
 
+void nrf_tls_session_cache_clear(void)
+{
+#if (NRF_TLS_SESSION_CACHE_SIZE > 0)
+    TLS_MUTEX_LOCK();
+
+    memset(m_session_cache, 0, sizeof(m_session_cache));
+
+#if NRF_TLS_SESSION_CACHE_FDS_ENABLED
+    UNUSED_RETURN_VALUE(fds_file_delete(NRF_TLS_SESSION_CACHE_FDS_FILE_ID));
+#endif // NRF_TLS_SESSION_CACHE_FDS_ENABLED
+
+    TLS_MUTEX_UNLOCK();
+#endif // NRF_TLS_SESSION_CACHE_SIZE
+}
+
+
 void nrf_tls_process(void)
 {
     uint32_t index;
@@ -155,6 +155,7 @@ typedef struct
     uint8_t                           transport_type;                /**< Indicates type of transport being secured. @ref nrf_transport_type_t for possible transports. */
     uint8_t                           role;                          /**< Indicates role to be played, server or client. @ref nrf_tls_role_t for possible roles. */
     nrf_tls_key_settings_t          * p_key_settings;                /**< Provide key configurations/certificates here. */
+    uint32_t                          session_cache_key;             /**< Identifies the server for session resumption on client instances. The session established on the instance is cached under this key, and later instances with the same key try to resume it with an abbreviated handshake. Zero disables resumption for the instance. Not used for server instances, which resume sessions cached by session identifier. */
 } nrf_tls_options_t;
 
 /**@brief Initialize TLS interface.
@@ -289,6 +290,15 @@ uint32_t nrf_tls_input(nrf_tls_instance_t const * p_instance,
                        uint32_t                   datalen);
 
 
+/**@brief Forget all cached sessions.
+ *
+ * @details This function removes all sessions kept for resumption, including sessions stored in
+ *          flash. It should be called when the credentials of the instances change. Instances
+ *          allocated afterwards perform a full handshake.
+ */
+void nrf_tls_session_cache_clear(void);
+
+
 /**@brief Function to continue TLS/DTLS operation after a busy state on transport.
  *
  * @details The transport writes requested by the TLS interface may return failure if transport
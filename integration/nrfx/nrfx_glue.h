@@ -58,6 +58,10 @@ extern "C" {
 
 #include <soc/nrfx_irqs.h>
 
+#ifdef NRF_SIM
+#include <nrf_sim_peripherals.h>
+#endif
+
 //------------------------------------------------------------------------------
 
 #include <nrf_assert.h>
@@ -130,7 +134,11 @@ static inline void _NRFX_IRQ_ENABLE(IRQn_Type irq_number)
 #define NRFX_IRQ_IS_ENABLED(irq_number)  _NRFX_IRQ_IS_ENABLED(irq_number)
 static inline bool _NRFX_IRQ_IS_ENABLED(IRQn_Type irq_number)
 {
+#ifdef NRF_SIM
+    return 0 != NVIC_GetEnableIRQ(irq_number);
+#else
     return 0 != (NVIC->ISER[irq_number / 32] & (1UL << (irq_number % 32)));
+#endif
 }
 
 /**
@@ -202,7 +210,11 @@ static inline bool _NRFX_IRQ_IS_PENDING(IRQn_Type irq_number)
 
 #include <soc/nrfx_coredep.h>
 
+#ifdef NRF_SIM
+#define NRFX_DELAY_US(us_time) nrf_sim_delay_us(us_time)
+#else
 #define NRFX_DELAY_US(us_time) nrfx_coredep_delay_us(us_time)
+#endif
 
 //------------------------------------------------------------------------------
 
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef CMSIS_NVIC_VIRTUAL_H__
+#define CMSIS_NVIC_VIRTUAL_H__
+
+/**
+ * @file
+ * @brief Redirection of the CMSIS NVIC functions to the virtual NVIC of @ref nrf_sim.
+ *
+ * Included by the CMSIS core header when @c CMSIS_NVIC_VIRTUAL is defined.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void     nrf_sim_nvic_irq_enable(IRQn_Type irq);
+void     nrf_sim_nvic_irq_disable(IRQn_Type irq);
+uint32_t nrf_sim_nvic_irq_enable_get(IRQn_Type irq);
+void     nrf_sim_nvic_pending_set(IRQn_Type irq);
+void     nrf_sim_nvic_pending_clear(IRQn_Type irq);
+uint32_t nrf_sim_nvic_pending_get(IRQn_Type irq);
+uint32_t nrf_sim_nvic_active_get(IRQn_Type irq);
+void     nrf_sim_nvic_priority_set(IRQn_Type irq, uint32_t priority);
+uint32_t nrf_sim_nvic_priority_get(IRQn_Type irq);
+void     nrf_sim_nvic_system_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define NVIC_SetPriorityGrouping(group)    ((void)(group))
+#define NVIC_GetPriorityGrouping()         (0UL)
+#define NVIC_EnableIRQ                     nrf_sim_nvic_irq_enable
+#define NVIC_GetEnableIRQ                  nrf_sim_nvic_irq_enable_get
+#define NVIC_DisableIRQ                    nrf_sim_nvic_irq_disable
+#define NVIC_GetPendingIRQ                 nrf_sim_nvic_pending_get
+#define NVIC_SetPendingIRQ                 nrf_sim_nvic_pending_set
+#define NVIC_ClearPendingIRQ               nrf_sim_nvic_pending_clear
+#define NVIC_GetActive                     nrf_sim_nvic_active_get
+#define NVIC_SetPriority                   nrf_sim_nvic_priority_set
+#define NVIC_GetPriority                   nrf_sim_nvic_priority_get
+#define NVIC_SystemReset                   nrf_sim_nvic_system_reset
+
+#endif // CMSIS_NVIC_VIRTUAL_H__
@@ -0,0 +1,747 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#define _GNU_SOURCE     /* MAP_32BIT */
+#include <stdlib.h>
+#include <string.h>
+#include "nrf_sim.h"
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+#include "nrf_assert.h"
+
+#if UINTPTR_MAX > UINT32_MAX
+#include <malloc.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#endif
+
+#define NRF_SIM_IRQ_COUNT       48      /**< Number of external interrupt lines on nRF52840. */
+#define NRF_SIM_PRIORITY_THREAD 0xFF    /**< Execution priority of thread mode. */
+#define NRF_SIM_NESTING_MAX     8       /**< Maximum interrupt nesting depth. */
+#define NRF_SIM_SETTLE_LIMIT    100000  /**< Bound on settle iterations, exceeded only by an interrupt storm. */
+#define NRF_SIM_STACK_SIZE      (1024 * 1024) /**< Size of the low stack used by @ref nrf_sim_main_run on 64-bit hosts. */
+
+typedef void (* nrf_sim_vector_t)(void);
+
+#define NRF_SIM_VECTOR_DECLARE(_name) extern void _name(void) __attribute__((weak))
+
+NRF_SIM_VECTOR_DECLARE(POWER_CLOCK_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(RADIO_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(UARTE0_UART0_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(GPIOTE_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(TIMER0_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(TIMER1_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(TIMER2_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(RTC0_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(RTC1_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SWI0_EGU0_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SWI1_EGU1_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SWI2_EGU2_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SWI3_EGU3_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SWI4_EGU4_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SWI5_EGU5_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(TIMER3_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(TIMER4_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SPIM2_SPIS2_SPI2_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(RTC2_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(USBD_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(UARTE1_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(QSPI_IRQHandler);
+NRF_SIM_VECTOR_DECLARE(SPIM3_IRQHandler);
+
+/* Undefined weak handlers resolve to NULL and their interrupts are never dispatched. */
+static nrf_sim_vector_t const m_vectors[NRF_SIM_IRQ_COUNT] =
+{
+    [POWER_CLOCK_IRQn]                      = POWER_CLOCK_IRQHandler,
+    [RADIO_IRQn]                            = RADIO_IRQHandler,
+    [UARTE0_UART0_IRQn]                     = UARTE0_UART0_IRQHandler,
+    [SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn] = SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler,
+    [SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn] = SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQHandler,
+    [GPIOTE_IRQn]                           = GPIOTE_IRQHandler,
+    [TIMER0_IRQn]                           = TIMER0_IRQHandler,
+    [TIMER1_IRQn]                           = TIMER1_IRQHandler,
+    [TIMER2_IRQn]                           = TIMER2_IRQHandler,
+    [RTC0_IRQn]                             = RTC0_IRQHandler,
+    [RTC1_IRQn]                             = RTC1_IRQHandler,
+    [SWI0_EGU0_IRQn]                        = SWI0_EGU0_IRQHandler,
+    [SWI1_EGU1_IRQn]                        = SWI1_EGU1_IRQHandler,
+    [SWI2_EGU2_IRQn]                        = SWI2_EGU2_IRQHandler,
+    [SWI3_EGU3_IRQn]                        = SWI3_EGU3_IRQHandler,
+    [SWI4_EGU4_IRQn]                        = SWI4_EGU4_IRQHandler,
+    [SWI5_EGU5_IRQn]                        = SWI5_EGU5_IRQHandler,
+    [TIMER3_IRQn]                           = TIMER3_IRQHandler,
+    [TIMER4_IRQn]                           = TIMER4_IRQHandler,
+    [SPIM2_SPIS2_SPI2_IRQn]                 = SPIM2_SPIS2_SPI2_IRQHandler,
+    [RTC2_IRQn]                             = RTC2_IRQHandler,
+    [USBD_IRQn]                             = USBD_IRQHandler,
+    [UARTE1_IRQn]                           = UARTE1_IRQHandler,
+    [QSPI_IRQn]                             = QSPI_IRQHandler,
+    [SPIM3_IRQn]                            = SPIM3_IRQHandler,
+};
+
+typedef bool (* nrf_sim_poll_t)(void);
+
+static nrf_sim_poll_t const m_polls[] =
+{
+    nrf_sim_ppi_poll,
+    nrf_sim_rtc_poll,
+    nrf_sim_timer_poll,
+    nrf_sim_uarte_poll,
+    nrf_sim_spim_poll,
+    nrf_sim_twim_poll,
+    nrf_sim_qspi_poll,
+    nrf_sim_radio_poll,
+};
+
+NRF_CLOCK_Type nrf_sim_clock_regs;
+NRF_POWER_Type nrf_sim_power_regs;
+NRF_GPIO_Type  nrf_sim_gpio_regs[2];
+
+static nrf_sim_time_t     m_time;
+static nrf_sim_action_t * mp_actions;
+static nrf_sim_periph_t * mp_periphs;
+static nrf_sim_stats_t    m_stats;
+static nrf_sim_error_t    m_error;
+static nrf_sim_periph_t   m_clock_periph;
+
+static bool     m_irq_enabled[NRF_SIM_IRQ_COUNT];
+static bool     m_irq_pending[NRF_SIM_IRQ_COUNT];
+static bool     m_irq_active[NRF_SIM_IRQ_COUNT];
+static uint8_t  m_irq_priority[NRF_SIM_IRQ_COUNT];
+static uint8_t  m_active_stack[NRF_SIM_NESTING_MAX];
+static uint8_t  m_active_depth;
+static uint32_t m_critical_nesting;
+
+
+static bool irq_is_valid(IRQn_Type irq)
+{
+    return (irq >= 0) && (irq < NRF_SIM_IRQ_COUNT);
+}
+
+
+static uint8_t execution_priority_get(void)
+{
+    if (m_active_depth == 0)
+    {
+        return NRF_SIM_PRIORITY_THREAD;
+    }
+    return m_irq_priority[m_active_stack[m_active_depth - 1]];
+}
+
+
+static volatile uint32_t * periph_reg(nrf_sim_periph_t const * p_periph, uint32_t offset)
+{
+    return (volatile uint32_t *)((uint8_t *)p_periph->p_reg + offset);
+}
+
+
+/**@brief Function for evaluating the interrupt line of a peripheral. */
+static void periph_level_update(nrf_sim_periph_t * p_periph)
+{
+    (void)nrf_sim_mask_update(&p_periph->inten,
+                              periph_reg(p_periph, 0x300),
+                              periph_reg(p_periph, 0x304),
+                              periph_reg(p_periph, 0x308));
+
+    uint32_t mask = p_periph->inten;
+    while (mask != 0)
+    {
+        uint32_t bit = 31 - __builtin_clz(mask);
+        mask &= ~(1UL << bit);
+        if (*periph_reg(p_periph, 0x100 + (bit * sizeof(uint32_t))) != 0)
+        {
+            m_irq_pending[p_periph->irq] = true;
+            break;
+        }
+    }
+}
+
+
+static void levels_update(void)
+{
+    for (nrf_sim_periph_t * p_periph = mp_periphs; p_periph != NULL; p_periph = p_periph->p_next)
+    {
+        periph_level_update(p_periph);
+    }
+}
+
+
+static bool irq_dispatch(void)
+{
+    if (m_critical_nesting != 0)
+    {
+        return false;
+    }
+
+    uint8_t current = execution_priority_get();
+    int32_t selected = -1;
+
+    for (int32_t irq = 0; irq < NRF_SIM_IRQ_COUNT; irq++)
+    {
+        if (m_irq_pending[irq] && m_irq_enabled[irq] && !m_irq_active[irq] &&
+            (m_vectors[irq] != NULL) && (m_irq_priority[irq] < current))
+        {
+            if ((selected < 0) || (m_irq_priority[irq] < m_irq_priority[selected]))
+            {
+                selected = irq;
+            }
+        }
+    }
+
+    if (selected < 0)
+    {
+        return false;
+    }
+
+    ASSERT(m_active_depth < NRF_SIM_NESTING_MAX);
+    m_irq_pending[selected] = false;
+    m_irq_active[selected]  = true;
+    m_active_stack[m_active_depth++] = (uint8_t)selected;
+    m_stats.irq_count++;
+
+    m_vectors[selected]();
+
+    m_active_depth--;
+    m_irq_active[selected] = false;
+    return true;
+}
+
+
+/**@brief CLOCK model. Oscillators start immediately. */
+static bool clock_poll(void)
+{
+    bool busy = false;
+
+    if (nrf_sim_task_take(&nrf_sim_clock_regs.TASKS_HFCLKSTART))
+    {
+        nrf_sim_reg_set(&nrf_sim_clock_regs.HFCLKSTAT,
+                        CLOCK_HFCLKSTAT_STATE_Msk | CLOCK_HFCLKSTAT_SRC_Msk);
+        nrf_sim_event_generate(&m_clock_periph, &nrf_sim_clock_regs.EVENTS_HFCLKSTARTED);
+        busy = true;
+    }
+    if (nrf_sim_task_take(&nrf_sim_clock_regs.TASKS_HFCLKSTOP))
+    {
+        nrf_sim_reg_set(&nrf_sim_clock_regs.HFCLKSTAT, 0);
+        busy = true;
+    }
+    if (nrf_sim_task_take(&nrf_sim_clock_regs.TASKS_LFCLKSTART))
+    {
+        nrf_sim_reg_set(&nrf_sim_clock_regs.LFCLKSTAT,
+                        CLOCK_LFCLKSTAT_STATE_Msk | nrf_sim_clock_regs.LFCLKSRC);
+        nrf_sim_event_generate(&m_clock_periph, &nrf_sim_clock_regs.EVENTS_LFCLKSTARTED);
+        busy = true;
+    }
+    if (nrf_sim_task_take(&nrf_sim_clock_regs.TASKS_LFCLKSTOP))
+    {
+        nrf_sim_reg_set(&nrf_sim_clock_regs.LFCLKSTAT, 0);
+        busy = true;
+    }
+    if (nrf_sim_task_take(&nrf_sim_clock_regs.TASKS_CAL))
+    {
+        nrf_sim_event_generate(&m_clock_periph, &nrf_sim_clock_regs.EVENTS_DONE);
+        busy = true;
+    }
+    return busy;
+}
+
+
+static bool models_poll(void)
+{
+    bool busy = clock_poll();
+
+    for (size_t i = 0; i < ARRAY_SIZE(m_polls); i++)
+    {
+        busy |= m_polls[i]();
+    }
+    return busy;
+}
+
+
+void nrf_sim_settle(void)
+{
+    uint32_t iterations = 0;
+    bool     progress;
+
+    if (m_error != NRF_SIM_ERROR_NONE)
+    {
+        return;
+    }
+
+    do
+    {
+        if (iterations++ == NRF_SIM_SETTLE_LIMIT)
+        {
+            m_error = NRF_SIM_ERROR_LIVELOCK;
+            return;
+        }
+
+        progress = models_poll();
+        levels_update();
+        progress |= irq_dispatch();
+    } while (progress);
+}
+
+
+static bool action_fire_next(nrf_sim_time_t limit)
+{
+    nrf_sim_action_t * p_action = mp_actions;
+
+    if ((m_error != NRF_SIM_ERROR_NONE) || (p_action == NULL) || (p_action->due > limit))
+    {
+        return false;
+    }
+
+    mp_actions          = p_action->p_next;
+    p_action->scheduled = false;
+    if (p_action->due > m_time)
+    {
+        m_time = p_action->due;
+    }
+    m_stats.action_count++;
+
+    p_action->handler(p_action->p_context);
+    return true;
+}
+
+
+#if UINTPTR_MAX > UINT32_MAX
+
+static ucontext_t   m_host_context;
+static ucontext_t   m_main_context;
+static int       (* mp_main_fn)(void);
+static int          m_main_result;
+
+
+static void main_trampoline(void)
+{
+    m_main_result = mp_main_fn();
+}
+
+
+int nrf_sim_main_run(int (* main_fn)(void))
+{
+    extern char end;    /* End of the data and bss segments, provided by the linker. */
+
+    /* Static data is low only in a non-PIE executable; the heap then has to stay on the
+     * program break that follows it. */
+    if (((uintptr_t)&end > UINT32_MAX) || (mallopt(M_MMAP_MAX, 0) == 0))
+    {
+        m_error = NRF_SIM_ERROR_ADDRESS;
+        return EXIT_FAILURE;
+    }
+
+    void * p_stack = mmap(NULL, NRF_SIM_STACK_SIZE, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (p_stack == MAP_FAILED)
+    {
+        m_error = NRF_SIM_ERROR_ADDRESS;
+        return EXIT_FAILURE;
+    }
+
+    mp_main_fn = main_fn;
+    (void)getcontext(&m_main_context);
+    m_main_context.uc_stack.ss_sp   = p_stack;
+    m_main_context.uc_stack.ss_size = NRF_SIM_STACK_SIZE;
+    m_main_context.uc_link          = &m_host_context;
+    makecontext(&m_main_context, main_trampoline, 0);
+    (void)swapcontext(&m_host_context, &m_main_context);
+
+    (void)munmap(p_stack, NRF_SIM_STACK_SIZE);
+    return m_main_result;
+}
+
+#else
+
+int nrf_sim_main_run(int (* main_fn)(void))
+{
+    return main_fn();
+}
+
+#endif // UINTPTR_MAX > UINT32_MAX
+
+
+void nrf_sim_init(void)
+{
+    m_time         = 0;
+    m_error        = NRF_SIM_ERROR_NONE;
+    mp_actions     = NULL;
+    mp_periphs     = NULL;
+    m_active_depth = 0;
+    m_critical_nesting = 0;
+    memset(&m_stats, 0, sizeof(m_stats));
+    memset(m_irq_enabled, 0, sizeof(m_irq_enabled));
+    memset(m_irq_pending, 0, sizeof(m_irq_pending));
+    memset(m_irq_active, 0, sizeof(m_irq_active));
+    memset(m_irq_priority, 0, sizeof(m_irq_priority));
+
+    memset(&nrf_sim_clock_regs, 0, sizeof(nrf_sim_clock_regs));
+    memset(&nrf_sim_power_regs, 0, sizeof(nrf_sim_power_regs));
+    memset(nrf_sim_gpio_regs, 0, sizeof(nrf_sim_gpio_regs));
+
+    m_clock_periph.p_reg = &nrf_sim_clock_regs;
+    m_clock_periph.irq   = POWER_CLOCK_IRQn;
+    nrf_sim_periph_register(&m_clock_periph);
+
+    nrf_sim_ppi_reset();
+    nrf_sim_rtc_reset();
+    nrf_sim_timer_reset();
+    nrf_sim_uarte_reset();
+    nrf_sim_spim_reset();
+    nrf_sim_twim_reset();
+    nrf_sim_qspi_reset();
+    nrf_sim_radio_reset();
+    nrf_sim_nvmc_reset();
+}
+
+
+nrf_sim_time_t nrf_sim_time_get(void)
+{
+    return m_time;
+}
+
+
+nrf_sim_error_t nrf_sim_error_get(void)
+{
+    return m_error;
+}
+
+
+void nrf_sim_action_schedule(nrf_sim_action_t * p_action, nrf_sim_time_t delay)
+{
+    ASSERT(p_action->handler != NULL);
+
+    nrf_sim_action_cancel(p_action);
+
+    p_action->due       = m_time + delay;
+    p_action->scheduled = true;
+
+    /* Actions due at the same time fire in the order of scheduling. */
+    nrf_sim_action_t ** pp_slot = &mp_actions;
+    while ((*pp_slot != NULL) && ((*pp_slot)->due <= p_action->due))
+    {
+        pp_slot = &(*pp_slot)->p_next;
+    }
+    p_action->p_next = *pp_slot;
+    *pp_slot         = p_action;
+}
+
+
+void nrf_sim_action_cancel(nrf_sim_action_t * p_action)
+{
+    if (!p_action->scheduled)
+    {
+        return;
+    }
+
+    nrf_sim_action_t ** pp_slot = &mp_actions;
+    while (*pp_slot != p_action)
+    {
+        pp_slot = &(*pp_slot)->p_next;
+    }
+    *pp_slot            = p_action->p_next;
+    p_action->scheduled = false;
+}
+
+
+void nrf_sim_run_for(nrf_sim_time_t duration)
+{
+    nrf_sim_time_t end = m_time + duration;
+
+    nrf_sim_settle();
+    while (action_fire_next(end))
+    {
+        nrf_sim_settle();
+    }
+    if (m_error != NRF_SIM_ERROR_NONE)
+    {
+        return;
+    }
+    m_time = end;
+    nrf_sim_settle();
+}
+
+
+bool nrf_sim_run_while(bool (* condition)(void * p_context), void * p_context, nrf_sim_time_t timeout)
+{
+    nrf_sim_time_t end = m_time + timeout;
+
+    nrf_sim_settle();
+    while (condition(p_context))
+    {
+        if (m_error != NRF_SIM_ERROR_NONE)
+        {
+            return false;
+        }
+        if (!action_fire_next(end))
+        {
+            m_time = end;
+            nrf_sim_settle();
+            return (m_error == NRF_SIM_ERROR_NONE) && !condition(p_context);
+        }
+        nrf_sim_settle();
+    }
+    return true;
+}
+
+
+bool nrf_sim_wfe(void)
+{
+    nrf_sim_settle();
+    if (!action_fire_next(UINT64_MAX))
+    {
+        return false;
+    }
+    m_stats.wfe_count++;
+    nrf_sim_settle();
+    return (m_error == NRF_SIM_ERROR_NONE);
+}
+
+
+void nrf_sim_delay_us(uint32_t time_us)
+{
+    nrf_sim_run_for(NRF_SIM_TIME_US(time_us));
+}
+
+
+void nrf_sim_stats_get(nrf_sim_stats_t * p_stats)
+{
+    *p_stats = m_stats;
+}
+
+
+void nrf_sim_periph_register(nrf_sim_periph_t * p_periph)
+{
+    p_periph->inten  = 0;
+    p_periph->p_next = mp_periphs;
+    mp_periphs       = p_periph;
+}
+
+
+IRQn_Type nrf_sim_irq_number_get(void const * p_reg)
+{
+    for (nrf_sim_periph_t * p_periph = mp_periphs; p_periph != NULL; p_periph = p_periph->p_next)
+    {
+        if (p_periph->p_reg == p_reg)
+        {
+            return p_periph->irq;
+        }
+    }
+    return NonMaskableInt_IRQn;
+}
+
+
+void nrf_sim_event_generate(nrf_sim_periph_t * p_periph, volatile uint32_t * p_event)
+{
+    UNUSED_PARAMETER(p_periph);
+
+    *p_event = 1;
+    nrf_sim_ppi_route(nrf_sim_ptr_to_reg(p_event));
+}
+
+
+uint32_t nrf_sim_mask_update(uint32_t          * p_mask,
+                             volatile uint32_t * p_reg,
+                             volatile uint32_t * p_set,
+                             volatile uint32_t * p_clr)
+{
+    if ((p_reg != NULL) && (*p_reg != *p_mask))
+    {
+        *p_mask = *p_reg;
+    }
+    /* SET is applied last, which resolves the usual disable/re-enable sequence correctly. */
+    uint32_t set = (*p_set != *p_mask) ? *p_set : 0;
+    *p_mask &= ~(*p_clr);
+    *p_mask |= set;
+    if (p_reg != NULL)
+    {
+        *p_reg = *p_mask;
+    }
+    *p_set = *p_mask;
+    *p_clr = 0;
+    return *p_mask;
+}
+
+
+bool nrf_sim_task_take(volatile uint32_t * p_task)
+{
+    if (*p_task == 0)
+    {
+        return false;
+    }
+    *p_task = 0;
+    return true;
+}
+
+
+void nrf_sim_task_trigger(volatile uint32_t * p_task)
+{
+    *p_task = 1;
+}
+
+
+void nrf_sim_nvic_irq_enable(IRQn_Type irq)
+{
+    if (irq_is_valid(irq))
+    {
+        /* Drivers set up INTEN right before enabling the interrupt. Take the writes in now,
+         * before later writes to the same registers overwrite them. */
+        levels_update();
+        m_irq_enabled[irq] = true;
+    }
+}
+
+
+void nrf_sim_nvic_irq_disable(IRQn_Type irq)
+{
+    if (irq_is_valid(irq))
+    {
+        m_irq_enabled[irq] = false;
+    }
+}
+
+
+uint32_t nrf_sim_nvic_irq_enable_get(IRQn_Type irq)
+{
+    return irq_is_valid(irq) ? m_irq_enabled[irq] : 0;
+}
+
+
+void nrf_sim_nvic_pending_set(IRQn_Type irq)
+{
+    if (irq_is_valid(irq))
+    {
+        m_irq_pending[irq] = true;
+    }
+}
+
+
+void nrf_sim_nvic_pending_clear(IRQn_Type irq)
+{
+    if (irq_is_valid(irq))
+    {
+        m_irq_pending[irq] = false;
+    }
+}
+
+
+uint32_t nrf_sim_nvic_pending_get(IRQn_Type irq)
+{
+    return irq_is_valid(irq) ? m_irq_pending[irq] : 0;
+}
+
+
+uint32_t nrf_sim_nvic_active_get(IRQn_Type irq)
+{
+    return irq_is_valid(irq) ? m_irq_active[irq] : 0;
+}
+
+
+void nrf_sim_nvic_priority_set(IRQn_Type irq, uint32_t priority)
+{
+    if (irq_is_valid(irq))
+    {
+        m_irq_priority[irq] = (uint8_t)priority;
+    }
+}
+
+
+uint32_t nrf_sim_nvic_priority_get(IRQn_Type irq)
+{
+    return irq_is_valid(irq) ? m_irq_priority[irq] : 0;
+}
+
+
+void nrf_sim_nvic_system_reset(void)
+{
+    abort();
+}
+
+
+/* Replacement of app_util_platform.c. Interrupts are only dispatched by the simulation core,
+ * so a critical region only has to hold the dispatch back. */
+
+void app_util_disable_irq(void)
+{
+    m_critical_nesting++;
+}
+
+
+void app_util_enable_irq(void)
+{
+    ASSERT(m_critical_nesting > 0);
+    m_critical_nesting--;
+    if (m_critical_nesting == 0)
+    {
+        nrf_sim_settle();
+    }
+}
+
+
+void app_util_critical_region_enter(uint8_t * p_nested)
+{
+    UNUSED_PARAMETER(p_nested);
+    app_util_disable_irq();
+}
+
+
+void app_util_critical_region_exit(uint8_t nested)
+{
+    UNUSED_PARAMETER(nested);
+    app_util_enable_irq();
+}
+
+
+uint8_t privilege_level_get(void)
+{
+    return APP_LEVEL_PRIVILEGED;
+}
+
+
+uint8_t current_int_priority_get(void)
+{
+    if (m_active_depth == 0)
+    {
+        return APP_IRQ_PRIORITY_THREAD;
+    }
+    return execution_priority_get();
+}
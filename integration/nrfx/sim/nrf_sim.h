@@ -0,0 +1,350 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef NRF_SIM_H__
+#define NRF_SIM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <nrf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup nrf_sim Host simulation of nrfx peripherals
+ * @{
+ * @ingroup nrfx
+ *
+ * @brief Deterministic register-level models of selected nRF52840 peripherals,
+ *        allowing nrfx drivers and the libraries built on top of them to run on a
+ *        Linux host.
+ *
+ * @details A host build defines @c NRF_SIM, @c NRF52840_XXAA and @c CMSIS_NVIC_VIRTUAL,
+ *          adds this directory to the include path and compiles the @c nrf_sim*.c files
+ *          in place of @c app_util_platform.c, @c nrf_nvmc.c and @c nrfx_nvmc.c.
+ *
+ *          EasyDMA pointer and PPI endpoint registers are 32 bits wide, so every buffer
+ *          and register block must have a 32-bit address. A 32-bit build
+ *          (<tt>gcc -m32</tt>) meets this by construction. A 64-bit build must be linked
+ *          with <tt>-no-pie</tt> and run the application through @ref nrf_sim_main_run,
+ *          which moves the heap and the stack below 4 GB.
+ *
+ *          The @c NRF_* peripheral pointers are redirected by @ref nrf_sim_peripherals.h
+ *          to register blocks in host RAM. Nothing runs concurrently with the application:
+ *          the models react to task writes and advance their state only when the virtual
+ *          clock is advanced by @ref nrf_sim_run_for, @ref nrf_sim_run_while,
+ *          @ref nrf_sim_wfe or @ref NRFX_DELAY_US. Pending interrupts are dispatched
+ *          to the vector table handlers (for example, @c UARTE0_UART0_IRQHandler) at the
+ *          same points. Blocking driver modes that busy-wait on an event without calling
+ *          @ref NRFX_DELAY_US are therefore not supported; use the event handler modes.
+ */
+
+/** @brief Virtual time in nanoseconds. */
+typedef uint64_t nrf_sim_time_t;
+
+/** @brief Number of nanoseconds in one microsecond. */
+#define NRF_SIM_TIME_US(us)     ((nrf_sim_time_t)(us) * 1000ULL)
+
+/** @brief Number of nanoseconds in one millisecond. */
+#define NRF_SIM_TIME_MS(ms)     ((nrf_sim_time_t)(ms) * 1000000ULL)
+
+/**
+ * @brief Handler of a scheduled action.
+ *
+ * @param[in] p_context User context passed to @ref nrf_sim_action_schedule.
+ */
+typedef void (* nrf_sim_action_handler_t)(void * p_context);
+
+/** @brief Action scheduled on the virtual time line. The structure is owned by the caller. */
+typedef struct nrf_sim_action_s
+{
+    struct nrf_sim_action_s * p_next;    //!< Next action in the time line. Internal.
+    nrf_sim_time_t            due;       //!< Time at which the action fires. Internal.
+    nrf_sim_action_handler_t  handler;   //!< Handler called when the action fires.
+    void                    * p_context; //!< Context passed to the handler.
+    bool                      scheduled; //!< True while the action is in the time line. Internal.
+} nrf_sim_action_t;
+
+/**
+ * @brief Peripheral interrupt line state shared by all models.
+ *
+ * Peripherals keep their interrupt enable mask in INTENSET/INTENCLR registers at
+ * offsets 0x304 and 0x308 and their events starting at offset 0x100, which lets the
+ * simulation core track INTEN writes and interrupt levels generically.
+ */
+typedef struct nrf_sim_periph_s
+{
+    struct nrf_sim_periph_s * p_next;   //!< Next registered peripheral. Internal.
+    void                    * p_reg;    //!< Register block of the peripheral.
+    IRQn_Type                 irq;      //!< Interrupt line of the peripheral.
+    uint32_t                  inten;    //!< Current interrupt enable mask. Internal.
+} nrf_sim_periph_t;
+
+/** @brief Simulation errors. */
+typedef enum
+{
+    NRF_SIM_ERROR_NONE,         //!< No error.
+    NRF_SIM_ERROR_LIVELOCK,     //!< Peripherals and interrupts kept generating work without time advancing,
+                                //!< for example, an interrupt handler that never clears its event.
+    NRF_SIM_ERROR_ADDRESS,      //!< Application memory cannot be given 32-bit addresses on this host.
+} nrf_sim_error_t;
+
+/** @brief Simulation statistics. */
+typedef struct
+{
+    uint32_t irq_count;        //!< Number of interrupt handler invocations.
+    uint32_t action_count;     //!< Number of fired scheduled actions.
+    uint32_t wfe_count;        //!< Number of @ref nrf_sim_wfe calls that advanced time.
+} nrf_sim_stats_t;
+
+/**
+ * @brief Function for running the application entry point on a 64-bit host.
+ *
+ * On a 32-bit host @p main_fn is called directly. On a 64-bit host the heap is restricted
+ * to the program break and @p main_fn runs on a stack mapped below 4 GB, so that local
+ * buffers can be handed to EasyDMA.
+ *
+ * @param[in] main_fn Application entry point.
+ *
+ * @return Value returned by @p main_fn, or EXIT_FAILURE with the error reported by
+ *         @ref nrf_sim_error_get set to @ref NRF_SIM_ERROR_ADDRESS if the memory layout
+ *         cannot be set up.
+ */
+int nrf_sim_main_run(int (* main_fn)(void));
+
+/**
+ * @brief Function for resetting the virtual clock, all register blocks and all models.
+ *
+ * The error reported by @ref nrf_sim_error_get is cleared.
+ */
+void nrf_sim_init(void);
+
+/**
+ * @brief Function for getting the simulation error.
+ *
+ * The error is sticky. After @ref NRF_SIM_ERROR_LIVELOCK is reported, the virtual clock no
+ * longer advances: @ref nrf_sim_run_for returns immediately and @ref nrf_sim_run_while and
+ * @ref nrf_sim_wfe return false.
+ *
+ * @return First error since @ref nrf_sim_init.
+ */
+nrf_sim_error_t nrf_sim_error_get(void);
+
+/**
+ * @brief Function for getting the current virtual time.
+ *
+ * @return Time in nanoseconds since @ref nrf_sim_init.
+ */
+nrf_sim_time_t nrf_sim_time_get(void);
+
+/**
+ * @brief Function for scheduling an action.
+ *
+ * If the action is already scheduled, it is moved to the new point in time.
+ *
+ * @param[in] p_action Action. @p handler and @p p_context must be set.
+ * @param[in] delay    Delay from the current virtual time, in nanoseconds.
+ */
+void nrf_sim_action_schedule(nrf_sim_action_t * p_action, nrf_sim_time_t delay);
+
+/**
+ * @brief Function for cancelling a scheduled action.
+ *
+ * @param[in] p_action Action. Cancelling an action that is not scheduled has no effect.
+ */
+void nrf_sim_action_cancel(nrf_sim_action_t * p_action);
+
+/**
+ * @brief Function for advancing the virtual clock by a given amount of time.
+ *
+ * All actions due in the interval fire in order and interrupts are dispatched after
+ * each of them. The function returns early if a simulation error occurs.
+ *
+ * @param[in] duration Time to advance, in nanoseconds.
+ */
+void nrf_sim_run_for(nrf_sim_time_t duration);
+
+/**
+ * @brief Function for advancing the virtual clock while a condition holds.
+ *
+ * @param[in] condition Function evaluated after every simulation step.
+ * @param[in] p_context Context passed to @p condition.
+ * @param[in] timeout   Maximum time to advance, in nanoseconds.
+ *
+ * @retval true  The condition became false.
+ * @retval false Timeout expired or nothing was left scheduled while the condition was still true,
+ *               or a simulation error occurred.
+ */
+bool nrf_sim_run_while(bool (* condition)(void * p_context), void * p_context, nrf_sim_time_t timeout);
+
+/**
+ * @brief Function for advancing the virtual clock up to the next scheduled action.
+ *
+ * Intended as a host replacement for @c __WFE in application main loops.
+ *
+ * @retval true  An action fired.
+ * @retval false Nothing is scheduled, the system would sleep forever, or a simulation error occurred.
+ */
+bool nrf_sim_wfe(void);
+
+/**
+ * @brief Function for delaying execution, used by @ref NRFX_DELAY_US in simulation builds.
+ *
+ * @param[in] time_us Delay in microseconds.
+ */
+void nrf_sim_delay_us(uint32_t time_us);
+
+/**
+ * @brief Function for processing pending task writes and interrupts without advancing time.
+ *
+ * If the system does not settle within a bounded number of iterations, processing stops and
+ * @ref NRF_SIM_ERROR_LIVELOCK is reported.
+ */
+void nrf_sim_settle(void);
+
+/**
+ * @brief Function for getting simulation statistics.
+ *
+ * @param[out] p_stats Statistics since @ref nrf_sim_init.
+ */
+void nrf_sim_stats_get(nrf_sim_stats_t * p_stats);
+
+/**
+ * @brief Function for registering a peripheral interrupt line. Used by the models.
+ *
+ * @param[in] p_periph Peripheral. @p p_reg and @p irq must be set.
+ */
+void nrf_sim_periph_register(nrf_sim_periph_t * p_periph);
+
+/**
+ * @brief Function for getting the interrupt line of a simulated peripheral, used by
+ *        @c NRFX_IRQ_NUMBER_GET in simulation builds.
+ *
+ * @param[in] p_reg Register block of the peripheral.
+ *
+ * @return Interrupt number, or a negative value if the peripheral has no modeled interrupt line.
+ */
+IRQn_Type nrf_sim_irq_number_get(void const * p_reg);
+
+/**
+ * @brief Function for generating a peripheral event. Used by the models.
+ *
+ * The event register is set, the event is routed through PPI and the interrupt line of the
+ * peripheral is evaluated at the next dispatch.
+ *
+ * @param[in] p_periph Peripheral generating the event.
+ * @param[in] p_event  Event register.
+ */
+void nrf_sim_event_generate(nrf_sim_periph_t * p_periph, volatile uint32_t * p_event);
+
+/**
+ * @brief Function for consuming a task register write. Used by the models.
+ *
+ * @param[in] p_task Task register.
+ *
+ * @retval true  The task was triggered since the last call; the register is cleared.
+ * @retval false The task was not triggered.
+ */
+bool nrf_sim_task_take(volatile uint32_t * p_task);
+
+/**
+ * @brief Function for triggering a task from within a model, for example, through a shortcut.
+ *
+ * @param[in] p_task Task register.
+ */
+void nrf_sim_task_trigger(volatile uint32_t * p_task);
+
+/**
+ * @brief Function for folding writes to a register triplet such as INTEN/INTENSET/INTENCLR
+ *        into the mask they control. Used by the models.
+ *
+ * A write to the plain register replaces the mask, a non-zero value in the CLR register is
+ * cleared out and a value written to the SET register that differs from the mask is OR-ed in.
+ * Writes are only seen when this function runs, so when both SET and CLR were written since
+ * the last call, SET takes precedence for the bits present in both. The registers are then
+ * written back so that reads return the mask.
+ *
+ * @param[in,out] p_mask Mask.
+ * @param[in]     p_reg  Plain register, for example INTEN. May be NULL.
+ * @param[in]     p_set  SET register.
+ * @param[in]     p_clr  CLR register.
+ *
+ * @return Updated mask.
+ */
+uint32_t nrf_sim_mask_update(uint32_t          * p_mask,
+                             volatile uint32_t * p_reg,
+                             volatile uint32_t * p_set,
+                             volatile uint32_t * p_clr);
+
+/**
+ * @brief Function for writing a register that is read-only for the application. Used by the models.
+ *
+ * @param[in] p_reg Register.
+ * @param[in] value Value.
+ */
+static inline void nrf_sim_reg_set(volatile uint32_t const * p_reg, uint32_t value)
+{
+    *(volatile uint32_t *)p_reg = value;
+}
+
+/** @name Virtual NVIC
+ *  @brief Functions used by @c cmsis_nvic_virtual.h in place of the CMSIS NVIC functions.
+ * @{ */
+void     nrf_sim_nvic_irq_enable(IRQn_Type irq);
+void     nrf_sim_nvic_irq_disable(IRQn_Type irq);
+uint32_t nrf_sim_nvic_irq_enable_get(IRQn_Type irq);
+void     nrf_sim_nvic_pending_set(IRQn_Type irq);
+void     nrf_sim_nvic_pending_clear(IRQn_Type irq);
+uint32_t nrf_sim_nvic_pending_get(IRQn_Type irq);
+uint32_t nrf_sim_nvic_active_get(IRQn_Type irq);
+void     nrf_sim_nvic_priority_set(IRQn_Type irq, uint32_t priority);
+uint32_t nrf_sim_nvic_priority_get(IRQn_Type irq);
+void     nrf_sim_nvic_system_reset(void);
+/** @} */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_SIM_H__
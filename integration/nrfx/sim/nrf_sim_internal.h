@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef NRF_SIM_INTERNAL_H__
+#define NRF_SIM_INTERNAL_H__
+
+#include <nrf_sim.h>
+#include "nordic_common.h"
+#include "nrf_assert.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Interface between the simulation core and the peripheral models.
+ *
+ * Every model provides a reset function, called from @ref nrf_sim_init, and a poll function,
+ * called whenever the core settles the system. The poll function consumes task writes, brings
+ * time-dependent registers up to date and returns true if it changed any state.
+ */
+
+void nrf_sim_uarte_reset(void);
+bool nrf_sim_uarte_poll(void);
+
+void nrf_sim_spim_reset(void);
+bool nrf_sim_spim_poll(void);
+
+void nrf_sim_twim_reset(void);
+bool nrf_sim_twim_poll(void);
+
+void nrf_sim_rtc_reset(void);
+bool nrf_sim_rtc_poll(void);
+
+void nrf_sim_timer_reset(void);
+bool nrf_sim_timer_poll(void);
+
+void nrf_sim_qspi_reset(void);
+bool nrf_sim_qspi_poll(void);
+
+void nrf_sim_radio_reset(void);
+bool nrf_sim_radio_poll(void);
+
+void nrf_sim_nvmc_reset(void);
+
+void nrf_sim_ppi_reset(void);
+bool nrf_sim_ppi_poll(void);
+
+/**
+ * @brief Function for triggering the tasks connected through PPI to an event.
+ *
+ * @param[in] event_address Address of the generated event register.
+ */
+void nrf_sim_ppi_route(uint32_t event_address);
+
+/**
+ * @brief Function for converting the value of an EasyDMA pointer or PPI endpoint register
+ *        to a host pointer.
+ *
+ * @param[in] value Register value.
+ */
+static inline void * nrf_sim_reg_to_ptr(uint32_t value)
+{
+    return (void *)(uintptr_t)value;
+}
+
+/**
+ * @brief Function for converting a host pointer to the value held by a 32-bit address register.
+ *
+ * @ref nrf_sim_main_run keeps all application memory in the low 4 GB of the address space,
+ * so the conversion does not lose information.
+ *
+ * @param[in] p_addr Host pointer.
+ */
+static inline uint32_t nrf_sim_ptr_to_reg(void const volatile * p_addr)
+{
+    ASSERT((uintptr_t)p_addr <= UINT32_MAX);
+    return (uint32_t)(uintptr_t)p_addr;
+}
+
+/**
+ * @brief Function for getting the number of nanoseconds needed to shift out a number of bits.
+ *
+ * @param[in] bits      Number of bits.
+ * @param[in] bit_rate  Bit rate in bits per second.
+ */
+static inline nrf_sim_time_t nrf_sim_bits_time(uint64_t bits, uint32_t bit_rate)
+{
+    return (bits * 1000000000ULL + bit_rate - 1) / bit_rate;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_SIM_INTERNAL_H__
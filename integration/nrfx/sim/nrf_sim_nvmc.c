@@ -0,0 +1,305 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+#include "nrf_nvmc.h"
+#include "nrfx_nvmc.h"
+#include "app_util_platform.h"
+
+/*
+ * Replacement of nrf_nvmc.c and nrfx_nvmc.c. Flash operations cannot be modeled through
+ * the NVMC registers, because the drivers poll READY without a delay between reads.
+ * Instead, the driver functions are implemented directly on the RAM image attached with
+ * nrf_sim_nvmc_flash_set(). Flash addresses are host addresses within that image.
+ *
+ * The CPU is halted while the flash is busy, so the virtual clock is advanced with
+ * interrupts held back; peripherals keep running and their interrupts are taken afterwards.
+ */
+
+NRF_NVMC_Type nrf_sim_nvmc_regs;
+
+static nrf_sim_nvmc_flash_t const * mp_flash;
+static nrf_sim_nvmc_stats_t         m_stats;
+
+#if defined(NRF_NVMC_PARTIAL_ERASE_PRESENT)
+static uint32_t m_partial_erase_address;
+static uint32_t m_partial_erase_duration_ms;
+static uint32_t m_partial_erase_elapsed_us;
+#endif
+
+
+static uint8_t * flash_ptr(uint32_t address, uint32_t length)
+{
+    ASSERT(mp_flash != NULL);
+
+    uint32_t base = nrf_sim_ptr_to_reg(mp_flash->p_memory);
+
+    ASSERT((address >= base) && (address - base <= mp_flash->size));
+    ASSERT(length <= mp_flash->size - (address - base));
+    return nrf_sim_reg_to_ptr(address);
+}
+
+
+static void flash_busy(uint32_t time_us)
+{
+    uint8_t nested;
+
+    app_util_critical_region_enter(&nested);
+    nrf_sim_run_for(NRF_SIM_TIME_US(time_us));
+    app_util_critical_region_exit(nested);
+}
+
+
+static void page_erase(uint32_t address)
+{
+    ASSERT((address % mp_flash->page_size) == 0);
+
+    memset(flash_ptr(address, mp_flash->page_size), 0xFF, mp_flash->page_size);
+    m_stats.pages_erased++;
+    flash_busy(mp_flash->page_erase_us);
+}
+
+
+/**@brief Function for programming a word. Only the bits set in @p mask are written. */
+static void word_program(uint32_t address, uint32_t value, uint32_t mask)
+{
+    ASSERT((address % sizeof(uint32_t)) == 0);
+
+    uint32_t * p_word = (uint32_t *)flash_ptr(address, sizeof(uint32_t));
+
+    value |= ~mask;
+    if ((~*p_word & value) != 0)
+    {
+        /* A bit can only go from 1 to 0; the write does not restore erased bits. */
+        m_stats.nor_violations++;
+    }
+    *p_word &= value;
+    m_stats.words_written++;
+    flash_busy(mp_flash->word_write_us);
+}
+
+
+static void byte_program(uint32_t address, uint8_t value)
+{
+    uint32_t shift = (address & 0x03UL) * 8;
+
+    word_program(address & ~0x03UL, (uint32_t)value << shift, 0xFFUL << shift);
+}
+
+
+void nrf_sim_nvmc_reset(void)
+{
+    memset(&nrf_sim_nvmc_regs, 0, sizeof(nrf_sim_nvmc_regs));
+    memset(&m_stats, 0, sizeof(m_stats));
+
+    nrf_sim_reg_set(&nrf_sim_nvmc_regs.READY, NVMC_READY_READY_Msk);
+    nrf_sim_reg_set(&nrf_sim_nvmc_regs.READYNEXT, NVMC_READYNEXT_READYNEXT_Msk);
+}
+
+
+void nrf_sim_nvmc_flash_set(nrf_sim_nvmc_flash_t const * p_flash)
+{
+    ASSERT((p_flash == NULL) || ((p_flash->size % p_flash->page_size) == 0));
+
+    mp_flash = p_flash;
+}
+
+
+void nrf_sim_nvmc_stats_get(nrf_sim_nvmc_stats_t * p_stats)
+{
+    *p_stats = m_stats;
+}
+
+
+void nrf_nvmc_page_erase(uint32_t address)
+{
+    page_erase(address);
+}
+
+
+void nrf_nvmc_write_byte(uint32_t address, uint8_t value)
+{
+    byte_program(address, value);
+}
+
+
+void nrf_nvmc_write_word(uint32_t address, uint32_t value)
+{
+    word_program(address, value, UINT32_MAX);
+}
+
+
+void nrf_nvmc_write_bytes(uint32_t address, const uint8_t * src, uint32_t num_bytes)
+{
+    for (uint32_t i = 0; i < num_bytes; i++)
+    {
+        byte_program(address + i, src[i]);
+    }
+}
+
+
+void nrf_nvmc_write_words(uint32_t address, const uint32_t * src, uint32_t num_words)
+{
+    for (uint32_t i = 0; i < num_words; i++)
+    {
+        word_program(address + sizeof(uint32_t) * i, src[i], UINT32_MAX);
+    }
+}
+
+
+nrfx_err_t nrfx_nvmc_page_erase(uint32_t address)
+{
+    if ((address % mp_flash->page_size) != 0)
+    {
+        return NRFX_ERROR_INVALID_ADDR;
+    }
+    page_erase(address);
+    return NRFX_SUCCESS;
+}
+
+
+nrfx_err_t nrfx_nvmc_uicr_erase(void)
+{
+    /* UICR is not modeled. */
+    return NRFX_ERROR_NOT_SUPPORTED;
+}
+
+
+void nrfx_nvmc_all_erase(void)
+{
+    for (uint32_t offset = 0; offset < mp_flash->size; offset += mp_flash->page_size)
+    {
+        page_erase(nrf_sim_ptr_to_reg(mp_flash->p_memory) + offset);
+    }
+}
+
+
+#if defined(NRF_NVMC_PARTIAL_ERASE_PRESENT)
+nrfx_err_t nrfx_nvmc_page_partial_erase_init(uint32_t address, uint32_t duration_ms)
+{
+    if ((address % mp_flash->page_size) != 0)
+    {
+        return NRFX_ERROR_INVALID_ADDR;
+    }
+
+    m_partial_erase_address     = address;
+    m_partial_erase_duration_ms = duration_ms;
+    m_partial_erase_elapsed_us  = 0;
+    return NRFX_SUCCESS;
+}
+
+
+bool nrfx_nvmc_page_partial_erase_continue(void)
+{
+    flash_busy(m_partial_erase_duration_ms * 1000UL);
+    m_partial_erase_elapsed_us += m_partial_erase_duration_ms * 1000UL;
+
+    if (m_partial_erase_elapsed_us < mp_flash->page_erase_us)
+    {
+        return false;
+    }
+
+    memset(flash_ptr(m_partial_erase_address, mp_flash->page_size), 0xFF, mp_flash->page_size);
+    m_stats.pages_erased++;
+    return true;
+}
+#endif // defined(NRF_NVMC_PARTIAL_ERASE_PRESENT)
+
+
+bool nrfx_nvmc_byte_writable_check(uint32_t address, uint8_t value)
+{
+    uint8_t current = *flash_ptr(address, 1);
+    return ((current & value) == value);
+}
+
+
+void nrfx_nvmc_byte_write(uint32_t address, uint8_t value)
+{
+    byte_program(address, value);
+}
+
+
+bool nrfx_nvmc_word_writable_check(uint32_t address, uint32_t value)
+{
+    uint32_t current = *(uint32_t *)flash_ptr(address, sizeof(uint32_t));
+    return ((current & value) == value);
+}
+
+
+void nrfx_nvmc_word_write(uint32_t address, uint32_t value)
+{
+    word_program(address, value, UINT32_MAX);
+}
+
+
+void nrfx_nvmc_bytes_write(uint32_t address, void const * src, uint32_t num_bytes)
+{
+    nrf_nvmc_write_bytes(address, (uint8_t const *)src, num_bytes);
+}
+
+
+void nrfx_nvmc_words_write(uint32_t address, void const * src, uint32_t num_words)
+{
+    uint32_t const * p_words = src;
+
+    for (uint32_t i = 0; i < num_words; i++)
+    {
+        word_program(address + sizeof(uint32_t) * i, p_words[i], UINT32_MAX);
+    }
+}
+
+
+uint32_t nrfx_nvmc_flash_size_get(void)
+{
+    return mp_flash->size;
+}
+
+
+uint32_t nrfx_nvmc_flash_page_size_get(void)
+{
+    return mp_flash->page_size;
+}
+
+
+uint32_t nrfx_nvmc_flash_page_count_get(void)
+{
+    return mp_flash->size / mp_flash->page_size;
+}
@@ -0,0 +1,341 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef NRF_SIM_PERIPHERALS_H__
+#define NRF_SIM_PERIPHERALS_H__
+
+#include <nrf_sim.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup nrf_sim_peripherals Simulated peripheral instances
+ * @{
+ * @ingroup nrf_sim
+ *
+ * @brief Register blocks of the simulated peripherals and the host-side interfaces of their models.
+ *
+ * This file is included by @c nrfx_glue.h in @c NRF_SIM builds, after the device header,
+ * and replaces the @c NRF_* peripheral pointers with pointers to the register blocks below.
+ * CLOCK, POWER and GPIO are backed by plain register blocks so that drivers configuring them
+ * do not fault; only the CLOCK start tasks are modeled.
+ */
+
+#define NRF_SIM_UARTE_COUNT  2  //!< Number of simulated UARTE instances.
+#define NRF_SIM_SPIM_COUNT   4  //!< Number of simulated SPIM instances.
+#define NRF_SIM_TWIM_COUNT   2  //!< Number of simulated TWIM instances.
+#define NRF_SIM_RTC_COUNT    3  //!< Number of simulated RTC instances.
+#define NRF_SIM_TIMER_COUNT  5  //!< Number of simulated TIMER instances.
+
+extern NRF_UARTE_Type nrf_sim_uarte_regs[NRF_SIM_UARTE_COUNT];
+extern NRF_SPIM_Type  nrf_sim_spim_regs[NRF_SIM_SPIM_COUNT];
+extern NRF_TWIM_Type  nrf_sim_twim_regs[NRF_SIM_TWIM_COUNT];
+extern NRF_RTC_Type   nrf_sim_rtc_regs[NRF_SIM_RTC_COUNT];
+extern NRF_TIMER_Type nrf_sim_timer_regs[NRF_SIM_TIMER_COUNT];
+extern NRF_NVMC_Type  nrf_sim_nvmc_regs;
+extern NRF_QSPI_Type  nrf_sim_qspi_regs;
+extern NRF_RADIO_Type nrf_sim_radio_regs;
+extern NRF_PPI_Type   nrf_sim_ppi_regs;
+extern NRF_CLOCK_Type nrf_sim_clock_regs;
+extern NRF_POWER_Type nrf_sim_power_regs;
+extern NRF_GPIO_Type  nrf_sim_gpio_regs[2];
+
+#undef NRF_UARTE0
+#undef NRF_UARTE1
+#undef NRF_SPIM0
+#undef NRF_SPIM1
+#undef NRF_SPIM2
+#undef NRF_SPIM3
+#undef NRF_TWIM0
+#undef NRF_TWIM1
+#undef NRF_RTC0
+#undef NRF_RTC1
+#undef NRF_RTC2
+#undef NRF_TIMER0
+#undef NRF_TIMER1
+#undef NRF_TIMER2
+#undef NRF_TIMER3
+#undef NRF_TIMER4
+#undef NRF_NVMC
+#undef NRF_QSPI
+#undef NRF_RADIO
+#undef NRF_PPI
+#undef NRF_CLOCK
+#undef NRF_POWER
+#undef NRF_P0
+#undef NRF_P1
+
+#define NRF_UARTE0  (&nrf_sim_uarte_regs[0])
+#define NRF_UARTE1  (&nrf_sim_uarte_regs[1])
+#define NRF_SPIM0   (&nrf_sim_spim_regs[0])
+#define NRF_SPIM1   (&nrf_sim_spim_regs[1])
+#define NRF_SPIM2   (&nrf_sim_spim_regs[2])
+#define NRF_SPIM3   (&nrf_sim_spim_regs[3])
+#define NRF_TWIM0   (&nrf_sim_twim_regs[0])
+#define NRF_TWIM1   (&nrf_sim_twim_regs[1])
+#define NRF_RTC0    (&nrf_sim_rtc_regs[0])
+#define NRF_RTC1    (&nrf_sim_rtc_regs[1])
+#define NRF_RTC2    (&nrf_sim_rtc_regs[2])
+#define NRF_TIMER0  (&nrf_sim_timer_regs[0])
+#define NRF_TIMER1  (&nrf_sim_timer_regs[1])
+#define NRF_TIMER2  (&nrf_sim_timer_regs[2])
+#define NRF_TIMER3  (&nrf_sim_timer_regs[3])
+#define NRF_TIMER4  (&nrf_sim_timer_regs[4])
+#define NRF_NVMC    (&nrf_sim_nvmc_regs)
+#define NRF_QSPI    (&nrf_sim_qspi_regs)
+#define NRF_RADIO   (&nrf_sim_radio_regs)
+#define NRF_PPI     (&nrf_sim_ppi_regs)
+#define NRF_CLOCK   (&nrf_sim_clock_regs)
+#define NRF_POWER   (&nrf_sim_power_regs)
+#define NRF_P0      (&nrf_sim_gpio_regs[0])
+#define NRF_P1      (&nrf_sim_gpio_regs[1])
+
+/**
+ * @brief Function for applying the writes to the PPI CHENSET and CHENCLR registers.
+ *
+ * Channels are enabled and disabled one at a time, and only the last of several consecutive
+ * writes to a register would be visible to the model. The PPI HAL calls this function after
+ * every such write in @c NRF_SIM builds.
+ */
+void nrf_sim_ppi_chen_update(void);
+
+/**
+ * @brief UARTE TX sink.
+ *
+ * Called when a transmission ends (ENDTX or TXSTOPPED) with the bytes that were sent.
+ *
+ * @param[in] p_context User context.
+ * @param[in] p_data    Transmitted data.
+ * @param[in] length    Number of transmitted bytes.
+ */
+typedef void (* nrf_sim_uarte_tx_handler_t)(void * p_context, uint8_t const * p_data, size_t length);
+
+/**
+ * @brief Function for setting the TX sink of a UARTE instance.
+ *
+ * @param[in] idx       Instance index.
+ * @param[in] handler   TX sink. NULL to discard transmitted data.
+ * @param[in] p_context Context passed to the sink.
+ */
+void nrf_sim_uarte_tx_handler_set(uint8_t idx, nrf_sim_uarte_tx_handler_t handler, void * p_context);
+
+/**
+ * @brief Function for injecting bytes on the RX line of a UARTE instance.
+ *
+ * Bytes are received one by one at the configured baud rate. When the receiver is not
+ * started, bytes are held back if hardware flow control is enabled and dropped with an
+ * overrun error otherwise.
+ *
+ * @param[in] idx    Instance index.
+ * @param[in] p_data Data.
+ * @param[in] length Number of bytes.
+ *
+ * @return Number of bytes accepted by the line model.
+ */
+size_t nrf_sim_uarte_rx_inject(uint8_t idx, uint8_t const * p_data, size_t length);
+
+/**
+ * @brief Function for connecting the TX line of a UARTE instance to the RX line of another one.
+ *
+ * @param[in] tx_idx Transmitting instance.
+ * @param[in] rx_idx Receiving instance. May be equal to @p tx_idx for a loopback.
+ */
+void nrf_sim_uarte_connect(uint8_t tx_idx, uint8_t rx_idx);
+
+/**
+ * @brief SPI slave device model.
+ *
+ * Called at the end of a transaction; the model fills @p p_rx.
+ */
+typedef void (* nrf_sim_spim_xfer_t)(void          * p_context,
+                                     uint8_t const * p_tx,
+                                     size_t          tx_length,
+                                     uint8_t       * p_rx,
+                                     size_t          rx_length);
+
+/**
+ * @brief Function for attaching a slave device model to a SPIM instance.
+ *
+ * @param[in] idx       Instance index.
+ * @param[in] xfer      Transfer function. NULL to read 0xFF on MISO.
+ * @param[in] p_context Context passed to @p xfer.
+ */
+void nrf_sim_spim_device_set(uint8_t idx, nrf_sim_spim_xfer_t xfer, void * p_context);
+
+/** @brief TWI slave device model. The functions return false to NACK the transfer. */
+typedef struct
+{
+    bool (* write)(void * p_context, uint8_t const * p_data, size_t length);
+    bool (* read)(void * p_context, uint8_t * p_data, size_t length);
+    void  * p_context;
+} nrf_sim_twim_device_t;
+
+/**
+ * @brief Function for attaching a slave device model to a TWIM bus.
+ *
+ * @param[in] idx      Instance index.
+ * @param[in] address  7-bit slave address.
+ * @param[in] p_device Device model. NULL to detach the address.
+ *
+ * @retval true  The device was attached.
+ * @retval false There is no room for more devices on the bus.
+ */
+bool nrf_sim_twim_device_set(uint8_t idx, uint8_t address, nrf_sim_twim_device_t const * p_device);
+
+/** @brief Size of the largest PDU: S0, LENGTH and S1 bytes followed by up to 255 bytes of payload. */
+#define NRF_SIM_RADIO_PDU_SIZE  258
+
+/** @brief Packet on air, as seen by the RADIO model. */
+typedef struct
+{
+    uint8_t  frequency;                     //!< Value of the FREQUENCY register of the sender.
+    uint64_t address;                       //!< Address, see @ref nrf_sim_radio_address_get.
+    uint16_t length;                        //!< Number of bytes in @p pdu.
+    bool     crc_error;                     //!< The packet is received with a CRC error.
+    uint8_t  pdu[NRF_SIM_RADIO_PDU_SIZE];   //!< S0, LENGTH and S1 bytes and the payload, as laid out in RAM.
+} nrf_sim_radio_packet_t;
+
+/**
+ * @brief RADIO TX sink.
+ *
+ * Called at the END event of every transmitted packet.
+ *
+ * @param[in] p_context User context.
+ * @param[in] p_packet  Transmitted packet.
+ */
+typedef void (* nrf_sim_radio_tx_handler_t)(void * p_context, nrf_sim_radio_packet_t const * p_packet);
+
+/**
+ * @brief Function for setting the TX sink of the RADIO model.
+ *
+ * @param[in] handler   TX sink. NULL to discard transmitted packets.
+ * @param[in] p_context Context passed to the sink.
+ */
+void nrf_sim_radio_tx_handler_set(nrf_sim_radio_tx_handler_t handler, void * p_context);
+
+/**
+ * @brief Function for putting a packet on air for the receiver.
+ *
+ * The packet is received only if the receiver is started and idle, and the frequency and the
+ * address match the FREQUENCY register and an address enabled in RXADDRESSES. The ADDRESS,
+ * PAYLOAD and END events follow at the configured bit rate, and the PDU is written to the
+ * buffer latched from PACKETPTR at START, truncated to MAXLEN bytes of payload.
+ *
+ * @param[in] p_packet Packet.
+ *
+ * @retval true  The packet is being received.
+ * @retval false The receiver did not pick up the packet.
+ */
+bool nrf_sim_radio_rx_inject(nrf_sim_radio_packet_t const * p_packet);
+
+/**
+ * @brief Function for getting the on-air address of a logical address.
+ *
+ * @param[in] logical Logical address, 0 to 7.
+ *
+ * @return Prefix byte in bits 32 to 39, the BALEN most significant bytes of the base address
+ *         in bits 0 to 31.
+ */
+uint64_t nrf_sim_radio_address_get(uint8_t logical);
+
+/** @brief Timing and geometry of the external flash attached to QSPI. */
+typedef struct
+{
+    uint8_t  * p_memory;           //!< Memory backing the flash contents.
+    uint32_t   size;               //!< Size of the flash, in bytes.
+    uint32_t   page_program_us;    //!< Time to program a 256-byte page.
+    uint32_t   erase_4k_us;        //!< Time to erase a 4 kB sector.
+    uint32_t   erase_64k_us;       //!< Time to erase a 64 kB block.
+    uint32_t   erase_all_us;       //!< Time to erase the whole chip.
+    uint32_t   jedec_id;           //!< Value returned by the RDID (0x9F) custom instruction.
+} nrf_sim_qspi_flash_t;
+
+/**
+ * @brief Function for attaching an external flash to the QSPI model.
+ *
+ * The flash follows NOR semantics: programming can only clear bits.
+ *
+ * @param[in] p_flash Flash description. Must remain valid while the simulation runs.
+ */
+void nrf_sim_qspi_flash_set(nrf_sim_qspi_flash_t const * p_flash);
+
+/** @brief Timing of the internal flash model used in place of the NVMC drivers. */
+typedef struct
+{
+    uint8_t  * p_memory;           //!< Memory backing the flash. Flash addresses are host addresses in this memory.
+    uint32_t   size;               //!< Size of the flash, in bytes. Must be a multiple of the page size.
+    uint32_t   page_size;          //!< Page size, in bytes.
+    uint32_t   word_write_us;      //!< Time to program one 32-bit word.
+    uint32_t   page_erase_us;      //!< Time to erase one page.
+} nrf_sim_nvmc_flash_t;
+
+/** @brief Internal flash statistics. */
+typedef struct
+{
+    uint32_t words_written;        //!< Number of programmed words.
+    uint32_t pages_erased;         //!< Number of erased pages.
+    uint32_t nor_violations;       //!< Number of writes that tried to set a bit from 0 to 1.
+} nrf_sim_nvmc_stats_t;
+
+/**
+ * @brief Function for attaching a RAM image as the internal flash.
+ *
+ * The NVMC driver functions (@c nrf_nvmc_* and @c nrfx_nvmc_*) operate on this image and
+ * advance the virtual clock by the configured program and erase times.
+ *
+ * @param[in] p_flash Flash description. Must remain valid while the simulation runs.
+ */
+void nrf_sim_nvmc_flash_set(nrf_sim_nvmc_flash_t const * p_flash);
+
+/**
+ * @brief Function for getting internal flash statistics.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void nrf_sim_nvmc_stats_get(nrf_sim_nvmc_stats_t * p_stats);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_SIM_PERIPHERALS_H__
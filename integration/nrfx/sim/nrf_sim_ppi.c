@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+#define PPI_CH_COUNT    20  /**< Number of programmable channels. */
+#define PPI_GROUP_COUNT 6   /**< Number of channel groups. */
+
+NRF_PPI_Type nrf_sim_ppi_regs;
+
+static uint32_t m_chen;
+
+void nrf_sim_ppi_chen_update(void)
+{
+    (void)nrf_sim_mask_update(&m_chen,
+                              &nrf_sim_ppi_regs.CHEN,
+                              &nrf_sim_ppi_regs.CHENSET,
+                              &nrf_sim_ppi_regs.CHENCLR);
+}
+
+
+static void task_trigger(uint32_t task_address)
+{
+    if (task_address != 0)
+    {
+        nrf_sim_task_trigger(nrf_sim_reg_to_ptr(task_address));
+    }
+}
+
+
+void nrf_sim_ppi_reset(void)
+{
+    memset(&nrf_sim_ppi_regs, 0, sizeof(nrf_sim_ppi_regs));
+    m_chen = 0;
+}
+
+
+bool nrf_sim_ppi_poll(void)
+{
+    bool busy = false;
+
+    nrf_sim_ppi_chen_update();
+    for (uint32_t i = 0; i < PPI_GROUP_COUNT; i++)
+    {
+        if (nrf_sim_task_take(&nrf_sim_ppi_regs.TASKS_CHG[i].EN))
+        {
+            m_chen |= nrf_sim_ppi_regs.CHG[i];
+            busy = true;
+        }
+        if (nrf_sim_task_take(&nrf_sim_ppi_regs.TASKS_CHG[i].DIS))
+        {
+            m_chen &= ~nrf_sim_ppi_regs.CHG[i];
+            busy = true;
+        }
+    }
+    nrf_sim_ppi_regs.CHEN    = m_chen;
+    nrf_sim_ppi_regs.CHENSET = m_chen;
+    return busy;
+}
+
+
+void nrf_sim_ppi_route(uint32_t event_address)
+{
+    nrf_sim_ppi_chen_update();
+
+    uint32_t mask = m_chen & ((1UL << PPI_CH_COUNT) - 1);
+    for (uint32_t ch = 0; mask != 0; ch++, mask >>= 1)
+    {
+        if ((mask & 1) && (nrf_sim_ppi_regs.CH[ch].EEP == event_address))
+        {
+            task_trigger(nrf_sim_ppi_regs.CH[ch].TEP);
+            task_trigger(nrf_sim_ppi_regs.FORK[ch].TEP);
+        }
+    }
+}
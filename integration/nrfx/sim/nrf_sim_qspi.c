@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+#define QSPI_BASE_HZ        32000000UL  /**< Frequency of the QSPI clock before the SCKFREQ divider. */
+#define QSPI_PAGE_SIZE      256         /**< Program page size of the external flash. */
+#define QSPI_SECTOR_SIZE    4096
+#define QSPI_BLOCK_SIZE     65536
+#define QSPI_OVERHEAD_BITS  32          /**< Opcode and 24-bit address of a read or write command. */
+
+/**
+ * @brief Marker set in a reserved bit of CINSTRCONF once the custom instruction was executed,
+ *        so that the next write of the same configuration is seen as a new instruction.
+ */
+#define QSPI_CINSTR_DONE    (1UL << 31)
+
+#define QSPI_OPCODE_RDSR    0x05
+#define QSPI_OPCODE_RDID    0x9F
+
+typedef struct
+{
+    nrf_sim_periph_t             periph;
+    nrf_sim_action_t             action;
+    nrf_sim_qspi_flash_t const * p_flash;
+} qspi_t;
+
+NRF_QSPI_Type nrf_sim_qspi_regs;
+
+static qspi_t m_qspi;
+
+
+static uint32_t sck_rate(void)
+{
+    uint32_t div = (nrf_sim_qspi_regs.IFCONFIG1 & QSPI_IFCONFIG1_SCKFREQ_Msk) >>
+                   QSPI_IFCONFIG1_SCKFREQ_Pos;
+    return QSPI_BASE_HZ / (div + 1);
+}
+
+
+static uint32_t read_lines(void)
+{
+    switch ((nrf_sim_qspi_regs.IFCONFIG0 & QSPI_IFCONFIG0_READOC_Msk) >> QSPI_IFCONFIG0_READOC_Pos)
+    {
+        case QSPI_IFCONFIG0_READOC_READ2O:
+        case QSPI_IFCONFIG0_READOC_READ2IO:
+            return 2;
+        case QSPI_IFCONFIG0_READOC_READ4O:
+        case QSPI_IFCONFIG0_READOC_READ4IO:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+
+static uint32_t write_lines(void)
+{
+    switch ((nrf_sim_qspi_regs.IFCONFIG0 & QSPI_IFCONFIG0_WRITEOC_Msk) >> QSPI_IFCONFIG0_WRITEOC_Pos)
+    {
+        case QSPI_IFCONFIG0_WRITEOC_PP2O:
+            return 2;
+        case QSPI_IFCONFIG0_WRITEOC_PP4O:
+        case QSPI_IFCONFIG0_WRITEOC_PP4IO:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+
+static nrf_sim_time_t transfer_time(uint32_t length, uint32_t lines)
+{
+    return nrf_sim_bits_time(QSPI_OVERHEAD_BITS + (8ULL * length) / lines, sck_rate());
+}
+
+
+/**@brief Function for checking that a flash range is backed by the attached memory. */
+static bool range_valid(uint32_t address, uint32_t length)
+{
+    return (m_qspi.p_flash != NULL) &&
+           (address <= m_qspi.p_flash->size) &&
+           (length <= m_qspi.p_flash->size - address);
+}
+
+
+static void ready_action(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    nrf_sim_reg_set(&nrf_sim_qspi_regs.STATUS, nrf_sim_qspi_regs.STATUS | QSPI_STATUS_READY_Msk);
+    nrf_sim_event_generate(&m_qspi.periph, &nrf_sim_qspi_regs.EVENTS_READY);
+}
+
+
+static void ready_schedule(nrf_sim_time_t delay)
+{
+    nrf_sim_reg_set(&nrf_sim_qspi_regs.STATUS, nrf_sim_qspi_regs.STATUS & ~QSPI_STATUS_READY_Msk);
+    nrf_sim_action_schedule(&m_qspi.action, delay);
+}
+
+
+static nrf_sim_time_t read_execute(void)
+{
+    NRF_QSPI_Type * p_reg = &nrf_sim_qspi_regs;
+
+    if (range_valid(p_reg->READ.SRC, p_reg->READ.CNT))
+    {
+        memcpy(nrf_sim_reg_to_ptr(p_reg->READ.DST), &m_qspi.p_flash->p_memory[p_reg->READ.SRC], p_reg->READ.CNT);
+    }
+    else
+    {
+        memset(nrf_sim_reg_to_ptr(p_reg->READ.DST), 0xFF, p_reg->READ.CNT);
+    }
+    return transfer_time(p_reg->READ.CNT, read_lines());
+}
+
+
+static nrf_sim_time_t write_execute(void)
+{
+    NRF_QSPI_Type * p_reg = &nrf_sim_qspi_regs;
+    uint8_t const * p_src = nrf_sim_reg_to_ptr(p_reg->WRITE.SRC);
+    nrf_sim_time_t  time  = transfer_time(p_reg->WRITE.CNT, write_lines());
+
+    if (!range_valid(p_reg->WRITE.DST, p_reg->WRITE.CNT))
+    {
+        return time;
+    }
+
+    /* Programming can only clear bits. */
+    uint8_t * p_dst = &m_qspi.p_flash->p_memory[p_reg->WRITE.DST];
+    for (uint32_t i = 0; i < p_reg->WRITE.CNT; i++)
+    {
+        p_dst[i] &= p_src[i];
+    }
+
+    uint32_t first = p_reg->WRITE.DST / QSPI_PAGE_SIZE;
+    uint32_t last  = (p_reg->WRITE.DST + MAX(p_reg->WRITE.CNT, 1) - 1) / QSPI_PAGE_SIZE;
+    return time + NRF_SIM_TIME_US((last - first + 1) * m_qspi.p_flash->page_program_us);
+}
+
+
+static nrf_sim_time_t erase_execute(void)
+{
+    NRF_QSPI_Type * p_reg = &nrf_sim_qspi_regs;
+    uint32_t        address;
+    uint32_t        length;
+    uint32_t        time_us;
+
+    if (m_qspi.p_flash == NULL)
+    {
+        return 0;
+    }
+
+    switch ((p_reg->ERASE.LEN & QSPI_ERASE_LEN_LEN_Msk) >> QSPI_ERASE_LEN_LEN_Pos)
+    {
+        case QSPI_ERASE_LEN_LEN_64KB:
+            address = p_reg->ERASE.PTR & ~(QSPI_BLOCK_SIZE - 1UL);
+            length  = QSPI_BLOCK_SIZE;
+            time_us = m_qspi.p_flash->erase_64k_us;
+            break;
+        case QSPI_ERASE_LEN_LEN_All:
+            address = 0;
+            length  = m_qspi.p_flash->size;
+            time_us = m_qspi.p_flash->erase_all_us;
+            break;
+        default:
+            address = p_reg->ERASE.PTR & ~(QSPI_SECTOR_SIZE - 1UL);
+            length  = QSPI_SECTOR_SIZE;
+            time_us = m_qspi.p_flash->erase_4k_us;
+            break;
+    }
+
+    if (range_valid(address, length))
+    {
+        memset(&m_qspi.p_flash->p_memory[address], 0xFF, length);
+    }
+    return transfer_time(0, 1) + NRF_SIM_TIME_US(time_us);
+}
+
+
+static nrf_sim_time_t cinstr_execute(uint32_t conf)
+{
+    NRF_QSPI_Type * p_reg  = &nrf_sim_qspi_regs;
+    uint32_t        length = (conf & QSPI_CINSTRCONF_LENGTH_Msk) >> QSPI_CINSTRCONF_LENGTH_Pos;
+
+    switch ((conf & QSPI_CINSTRCONF_OPCODE_Msk) >> QSPI_CINSTRCONF_OPCODE_Pos)
+    {
+        case QSPI_OPCODE_RDSR:
+            /* Operations complete before READY is raised, so the flash never reports WIP. */
+            p_reg->CINSTRDAT0 = 0;
+            break;
+        case QSPI_OPCODE_RDID:
+            p_reg->CINSTRDAT0 = (m_qspi.p_flash != NULL) ? m_qspi.p_flash->jedec_id : 0;
+            break;
+        default:
+            break;
+    }
+
+    p_reg->CINSTRCONF = conf | QSPI_CINSTR_DONE;
+    return nrf_sim_bits_time(8ULL * length, sck_rate());
+}
+
+
+void nrf_sim_qspi_reset(void)
+{
+    nrf_sim_qspi_flash_t const * p_flash = m_qspi.p_flash;
+
+    memset(&nrf_sim_qspi_regs, 0, sizeof(nrf_sim_qspi_regs));
+    memset(&m_qspi, 0, sizeof(m_qspi));
+
+    /* The attached flash survives a reset of the simulation. */
+    m_qspi.p_flash          = p_flash;
+    m_qspi.periph.p_reg     = &nrf_sim_qspi_regs;
+    m_qspi.periph.irq       = QSPI_IRQn;
+    m_qspi.action.handler   = ready_action;
+    m_qspi.action.p_context = &m_qspi;
+    nrf_sim_reg_set(&nrf_sim_qspi_regs.STATUS, QSPI_STATUS_READY_Msk);
+    nrf_sim_periph_register(&m_qspi.periph);
+}
+
+
+bool nrf_sim_qspi_poll(void)
+{
+    NRF_QSPI_Type * p_reg = &nrf_sim_qspi_regs;
+    bool            busy  = false;
+
+    if (nrf_sim_task_take(&p_reg->TASKS_ACTIVATE))
+    {
+        busy = true;
+        ready_schedule(transfer_time(0, 1));
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_READSTART))
+    {
+        busy = true;
+        ready_schedule(read_execute());
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_WRITESTART))
+    {
+        busy = true;
+        ready_schedule(write_execute());
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_ERASESTART))
+    {
+        busy = true;
+        ready_schedule(erase_execute());
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_DEACTIVATE))
+    {
+        busy = true;
+        nrf_sim_action_cancel(&m_qspi.action);
+        nrf_sim_reg_set(&p_reg->STATUS, p_reg->STATUS | QSPI_STATUS_READY_Msk);
+    }
+    if ((p_reg->CINSTRCONF != 0) && !(p_reg->CINSTRCONF & QSPI_CINSTR_DONE))
+    {
+        busy = true;
+        ready_schedule(cinstr_execute(p_reg->CINSTRCONF));
+    }
+    return busy;
+}
+
+
+void nrf_sim_qspi_flash_set(nrf_sim_qspi_flash_t const * p_flash)
+{
+    m_qspi.p_flash = p_flash;
+}
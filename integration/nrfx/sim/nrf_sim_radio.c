@@ -0,0 +1,546 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+#define RADIO_RAMP_UP_US        130     /**< TXRU and RXRU time in the default ramp-up mode. */
+#define RADIO_RAMP_UP_FAST_US   40      /**< TXRU and RXRU time in the fast ramp-up mode. */
+#define RADIO_TX_DISABLE_US     6       /**< Time from DISABLE to DISABLED in the TX states. */
+#define RADIO_RSSI_SAMPLE       60      /**< RSSISAMPLE of every received packet, -60 dBm. */
+
+typedef struct
+{
+    nrf_sim_periph_t           periph;
+    nrf_sim_action_t           action;      //!< Ramp-up, TX disable or the next packet phase.
+    nrf_sim_radio_tx_handler_t tx_handler;
+    void                     * p_tx_context;
+
+    uint32_t               state;           //!< Value of the STATE register.
+    bool                   on_air;          //!< A packet is being sent or received.
+    bool                   address_done;    //!< The ADDRESS event of the current packet was generated.
+    uint8_t              * p_packet;        //!< PACKETPTR latched at START.
+    uint8_t                rx_match;        //!< Logical address of the packet being received.
+    nrf_sim_radio_packet_t packet;          //!< Packet being sent or received.
+} radio_t;
+
+NRF_RADIO_Type nrf_sim_radio_regs;
+
+static radio_t m_radio;
+
+
+static void state_set(radio_t * p_radio, uint32_t state)
+{
+    NRF_RADIO_Type * p_reg = p_radio->periph.p_reg;
+
+    p_radio->state = state;
+    nrf_sim_reg_set(&p_reg->STATE, state);
+}
+
+
+static uint32_t bit_rate(radio_t const * p_radio)
+{
+    NRF_RADIO_Type const * p_reg = p_radio->periph.p_reg;
+
+    switch (p_reg->MODE & RADIO_MODE_MODE_Msk)
+    {
+        case RADIO_MODE_MODE_Nrf_2Mbit:
+        case RADIO_MODE_MODE_Ble_2Mbit:
+            return 2000000;
+        case 2: // Nrf_250Kbit on the devices that support it.
+        case RADIO_MODE_MODE_Ieee802154_250Kbit:
+            return 250000;
+        case RADIO_MODE_MODE_Ble_LR125Kbit:
+            return 125000;
+        case RADIO_MODE_MODE_Ble_LR500Kbit:
+            return 500000;
+        default:
+            return 1000000;
+    }
+}
+
+
+static uint32_t base_length(radio_t const * p_radio)
+{
+    NRF_RADIO_Type const * p_reg = p_radio->periph.p_reg;
+    return (p_reg->PCNF1 & RADIO_PCNF1_BALEN_Msk) >> RADIO_PCNF1_BALEN_Pos;
+}
+
+
+/**@brief Function for getting the number of header bytes in front of the payload in RAM. */
+static uint32_t header_length(radio_t const * p_radio, uint32_t * p_length_index)
+{
+    NRF_RADIO_Type const * p_reg  = p_radio->periph.p_reg;
+    uint32_t               pcnf0  = p_reg->PCNF0;
+    uint32_t               length = 0;
+
+    if (pcnf0 & RADIO_PCNF0_S0LEN_Msk)
+    {
+        length++;
+    }
+    *p_length_index = length;
+    if (pcnf0 & RADIO_PCNF0_LFLEN_Msk)
+    {
+        length++;
+    }
+    if ((pcnf0 & (RADIO_PCNF0_S1LEN_Msk | RADIO_PCNF0_S1INCL_Msk)) != 0)
+    {
+        length++;
+    }
+    return length;
+}
+
+
+/**@brief Function for getting the payload length given by the header and the static length. */
+static uint32_t payload_length(radio_t const * p_radio, uint8_t const * p_pdu)
+{
+    NRF_RADIO_Type const * p_reg = p_radio->periph.p_reg;
+    uint32_t               lflen = (p_reg->PCNF0 & RADIO_PCNF0_LFLEN_Msk) >> RADIO_PCNF0_LFLEN_Pos;
+    uint32_t               index;
+    uint32_t               length = (p_reg->PCNF1 & RADIO_PCNF1_STATLEN_Msk) >> RADIO_PCNF1_STATLEN_Pos;
+
+    (void)header_length(p_radio, &index);
+    if (lflen != 0)
+    {
+        length += p_pdu[index] & (0xFFUL >> (8 - MIN(lflen, 8)));
+    }
+    return length;
+}
+
+
+static uint32_t crc_length(radio_t const * p_radio)
+{
+    NRF_RADIO_Type const * p_reg = p_radio->periph.p_reg;
+    return (p_reg->CRCCNF & RADIO_CRCCNF_LEN_Msk) >> RADIO_CRCCNF_LEN_Pos;
+}
+
+
+/**@brief Function for getting the time from START to the ADDRESS event. */
+static nrf_sim_time_t address_time(radio_t const * p_radio)
+{
+    NRF_RADIO_Type const * p_reg = p_radio->periph.p_reg;
+
+    uint32_t preamble_bits = (p_reg->PCNF0 & RADIO_PCNF0_PLEN_Msk) ? 16 : 8;
+    return nrf_sim_bits_time(preamble_bits + 8 * (base_length(p_radio) + 1), bit_rate(p_radio));
+}
+
+
+/**@brief Function for getting the time from the ADDRESS event to the END event. */
+static nrf_sim_time_t pdu_time(radio_t const * p_radio, uint32_t pdu_length)
+{
+    return nrf_sim_bits_time(8 * (pdu_length + crc_length(p_radio)), bit_rate(p_radio));
+}
+
+
+/**@brief Function for calculating the CRC of a packet over its address and PDU bytes. */
+static uint32_t crc_calculate(radio_t const * p_radio, nrf_sim_radio_packet_t const * p_packet)
+{
+    NRF_RADIO_Type const * p_reg  = p_radio->periph.p_reg;
+    uint32_t               bits   = 8 * crc_length(p_radio);
+    uint32_t               mask   = (bits == 0) ? 0 : (0xFFFFFFUL >> (24 - bits));
+    uint32_t               crc    = p_reg->CRCINIT & mask;
+    uint8_t                bytes[5 + NRF_SIM_RADIO_PDU_SIZE];
+    uint32_t               count  = 0;
+
+    if (bits == 0)
+    {
+        return 0;
+    }
+    if ((p_reg->CRCCNF & RADIO_CRCCNF_SKIPADDR_Msk) == 0)
+    {
+        for (int32_t i = (int32_t)base_length(p_radio); i >= 0; i--)
+        {
+            bytes[count++] = (uint8_t)(p_packet->address >> (8 * (i + 4 - base_length(p_radio))));
+        }
+    }
+    memcpy(&bytes[count], p_packet->pdu, p_packet->length);
+    count += p_packet->length;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        for (uint32_t bit = 0; bit < 8; bit++)
+        {
+            bool feedback = ((crc >> (bits - 1)) & 1) ^ ((bytes[i] >> (7 - bit)) & 1);
+            crc = (crc << 1) & mask;
+            if (feedback)
+            {
+                crc ^= p_reg->CRCPOLY & mask;
+            }
+        }
+    }
+    return crc;
+}
+
+
+static bool address_match(radio_t * p_radio, uint64_t address)
+{
+    NRF_RADIO_Type const * p_reg = p_radio->periph.p_reg;
+
+    for (uint8_t logical = 0; logical < 8; logical++)
+    {
+        if ((p_reg->RXADDRESSES & (1UL << logical)) &&
+            (nrf_sim_radio_address_get(logical) == address))
+        {
+            p_radio->rx_match = logical;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static void disabled_enter(radio_t * p_radio)
+{
+    NRF_RADIO_Type * p_reg = p_radio->periph.p_reg;
+
+    state_set(p_radio, RADIO_STATE_STATE_Disabled);
+    nrf_sim_event_generate(&p_radio->periph, &p_reg->EVENTS_DISABLED);
+
+    if (p_reg->SHORTS & RADIO_SHORTS_DISABLED_TXEN_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_TXEN);
+    }
+    if (p_reg->SHORTS & RADIO_SHORTS_DISABLED_RXEN_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_RXEN);
+    }
+}
+
+
+static void ready_enter(radio_t * p_radio, uint32_t state)
+{
+    NRF_RADIO_Type * p_reg = p_radio->periph.p_reg;
+
+    state_set(p_radio, state);
+    nrf_sim_event_generate(&p_radio->periph, &p_reg->EVENTS_READY);
+
+    if (p_reg->SHORTS & RADIO_SHORTS_READY_START_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_START);
+    }
+}
+
+
+static void rx_complete(radio_t * p_radio)
+{
+    NRF_RADIO_Type * p_reg = p_radio->periph.p_reg;
+    uint32_t         index;
+    uint32_t         header  = header_length(p_radio, &index);
+    uint32_t         maxlen  = (p_reg->PCNF1 & RADIO_PCNF1_MAXLEN_Msk) >> RADIO_PCNF1_MAXLEN_Pos;
+    uint32_t         length  = payload_length(p_radio, p_radio->packet.pdu);
+    bool             crc_ok  = !p_radio->packet.crc_error;
+
+    /* A payload longer than MAXLEN is truncated and fails the CRC check. */
+    if (length > maxlen)
+    {
+        length = maxlen;
+        crc_ok = false;
+    }
+    memcpy(p_radio->p_packet, p_radio->packet.pdu, MIN(header + length, p_radio->packet.length));
+
+    nrf_sim_reg_set(&p_reg->CRCSTATUS, crc_ok ? 1 : 0);
+    nrf_sim_reg_set(&p_reg->RXCRC, crc_calculate(p_radio, &p_radio->packet));
+    nrf_sim_reg_set(&p_reg->RSSISAMPLE, RADIO_RSSI_SAMPLE);
+    nrf_sim_event_generate(&p_radio->periph, crc_ok ? &p_reg->EVENTS_CRCOK : &p_reg->EVENTS_CRCERROR);
+}
+
+
+static void end_enter(radio_t * p_radio)
+{
+    NRF_RADIO_Type * p_reg = p_radio->periph.p_reg;
+    bool             tx    = (p_radio->state == RADIO_STATE_STATE_Tx);
+
+    p_radio->on_air = false;
+    if (tx)
+    {
+        state_set(p_radio, RADIO_STATE_STATE_TxIdle);
+    }
+    else
+    {
+        rx_complete(p_radio);
+        state_set(p_radio, RADIO_STATE_STATE_RxIdle);
+    }
+    nrf_sim_event_generate(&p_radio->periph, &p_reg->EVENTS_PAYLOAD);
+    nrf_sim_event_generate(&p_radio->periph, &p_reg->EVENTS_END);
+
+    if (tx && (p_radio->tx_handler != NULL))
+    {
+        p_radio->tx_handler(p_radio->p_tx_context, &p_radio->packet);
+    }
+
+    if (p_reg->SHORTS & RADIO_SHORTS_END_DISABLE_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_DISABLE);
+    }
+    if (p_reg->SHORTS & RADIO_SHORTS_END_START_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_START);
+    }
+}
+
+
+/**@brief Action completing the current ramp-up, TX disable or packet phase. */
+static void radio_action(void * p_context)
+{
+    radio_t        * p_radio = p_context;
+    NRF_RADIO_Type * p_reg   = p_radio->periph.p_reg;
+
+    switch (p_radio->state)
+    {
+        case RADIO_STATE_STATE_TxRu:
+            ready_enter(p_radio, RADIO_STATE_STATE_TxIdle);
+            break;
+
+        case RADIO_STATE_STATE_RxRu:
+            ready_enter(p_radio, RADIO_STATE_STATE_RxIdle);
+            break;
+
+        case RADIO_STATE_STATE_TxDisable:
+            disabled_enter(p_radio);
+            break;
+
+        case RADIO_STATE_STATE_Tx:
+        case RADIO_STATE_STATE_Rx:
+            if (!p_radio->address_done)
+            {
+                p_radio->address_done = true;
+                if (p_radio->state == RADIO_STATE_STATE_Rx)
+                {
+                    nrf_sim_reg_set(&p_reg->RXMATCH, p_radio->rx_match);
+                }
+                nrf_sim_event_generate(&p_radio->periph, &p_reg->EVENTS_ADDRESS);
+                nrf_sim_action_schedule(&p_radio->action, pdu_time(p_radio, p_radio->packet.length));
+            }
+            else
+            {
+                end_enter(p_radio);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+static void start(radio_t * p_radio)
+{
+    NRF_RADIO_Type * p_reg = p_radio->periph.p_reg;
+
+    p_radio->p_packet = nrf_sim_reg_to_ptr(p_reg->PACKETPTR);
+
+    if (p_radio->state == RADIO_STATE_STATE_TxIdle)
+    {
+        uint32_t index;
+        uint32_t header = header_length(p_radio, &index);
+        uint32_t maxlen = (p_reg->PCNF1 & RADIO_PCNF1_MAXLEN_Msk) >> RADIO_PCNF1_MAXLEN_Pos;
+        uint32_t length = MIN(payload_length(p_radio, p_radio->p_packet), maxlen);
+
+        p_radio->packet.frequency = (uint8_t)p_reg->FREQUENCY;
+        p_radio->packet.address   = nrf_sim_radio_address_get((uint8_t)p_reg->TXADDRESS);
+        p_radio->packet.length    = (uint16_t)(header + length);
+        p_radio->packet.crc_error = false;
+        memcpy(p_radio->packet.pdu, p_radio->p_packet, p_radio->packet.length);
+
+        state_set(p_radio, RADIO_STATE_STATE_Tx);
+        p_radio->on_air       = true;
+        p_radio->address_done = false;
+        nrf_sim_action_schedule(&p_radio->action, address_time(p_radio));
+    }
+    else if (p_radio->state == RADIO_STATE_STATE_RxIdle)
+    {
+        /* The receiver listens until a packet is injected. */
+        state_set(p_radio, RADIO_STATE_STATE_Rx);
+        p_radio->on_air = false;
+    }
+}
+
+
+static void stop(radio_t * p_radio)
+{
+    nrf_sim_action_cancel(&p_radio->action);
+    p_radio->on_air = false;
+
+    if (p_radio->state == RADIO_STATE_STATE_Tx)
+    {
+        state_set(p_radio, RADIO_STATE_STATE_TxIdle);
+    }
+    else if (p_radio->state == RADIO_STATE_STATE_Rx)
+    {
+        state_set(p_radio, RADIO_STATE_STATE_RxIdle);
+    }
+}
+
+
+static void disable(radio_t * p_radio)
+{
+    nrf_sim_action_cancel(&p_radio->action);
+    p_radio->on_air = false;
+
+    switch (p_radio->state)
+    {
+        case RADIO_STATE_STATE_TxRu:
+        case RADIO_STATE_STATE_TxIdle:
+        case RADIO_STATE_STATE_Tx:
+            state_set(p_radio, RADIO_STATE_STATE_TxDisable);
+            nrf_sim_action_schedule(&p_radio->action, NRF_SIM_TIME_US(RADIO_TX_DISABLE_US));
+            break;
+
+        case RADIO_STATE_STATE_TxDisable:
+            nrf_sim_action_schedule(&p_radio->action, NRF_SIM_TIME_US(RADIO_TX_DISABLE_US));
+            break;
+
+        default:
+            /* The receiver is disabled at once. DISABLE in the DISABLED state still generates
+             * the DISABLED event. */
+            disabled_enter(p_radio);
+            break;
+    }
+}
+
+
+static void ramp_up(radio_t * p_radio, uint32_t state)
+{
+    NRF_RADIO_Type const * p_reg = p_radio->periph.p_reg;
+
+    if (p_radio->state != RADIO_STATE_STATE_Disabled)
+    {
+        return;
+    }
+    state_set(p_radio, state);
+    nrf_sim_action_schedule(&p_radio->action,
+                            NRF_SIM_TIME_US((p_reg->MODECNF0 & RADIO_MODECNF0_RU_Msk) ?
+                                            RADIO_RAMP_UP_FAST_US : RADIO_RAMP_UP_US));
+}
+
+
+void nrf_sim_radio_reset(void)
+{
+    memset(&nrf_sim_radio_regs, 0, sizeof(nrf_sim_radio_regs));
+    memset(&m_radio, 0, sizeof(m_radio));
+
+    nrf_sim_radio_regs.POWER = 1;
+    m_radio.periph.p_reg      = &nrf_sim_radio_regs;
+    m_radio.periph.irq        = RADIO_IRQn;
+    m_radio.action.handler    = radio_action;
+    m_radio.action.p_context  = &m_radio;
+    state_set(&m_radio, RADIO_STATE_STATE_Disabled);
+    nrf_sim_periph_register(&m_radio.periph);
+}
+
+
+bool nrf_sim_radio_poll(void)
+{
+    NRF_RADIO_Type * p_reg = &nrf_sim_radio_regs;
+    bool             busy  = false;
+
+    if (nrf_sim_task_take(&p_reg->TASKS_DISABLE))
+    {
+        busy = true;
+        disable(&m_radio);
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_TXEN))
+    {
+        busy = true;
+        ramp_up(&m_radio, RADIO_STATE_STATE_TxRu);
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_RXEN))
+    {
+        busy = true;
+        ramp_up(&m_radio, RADIO_STATE_STATE_RxRu);
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_STOP))
+    {
+        busy = true;
+        stop(&m_radio);
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_START))
+    {
+        busy = true;
+        start(&m_radio);
+    }
+    /* RSSI is sampled at a constant level. */
+    busy |= nrf_sim_task_take(&p_reg->TASKS_RSSISTART);
+    busy |= nrf_sim_task_take(&p_reg->TASKS_RSSISTOP);
+    return busy;
+}
+
+
+void nrf_sim_radio_tx_handler_set(nrf_sim_radio_tx_handler_t handler, void * p_context)
+{
+    m_radio.tx_handler   = handler;
+    m_radio.p_tx_context = p_context;
+}
+
+
+bool nrf_sim_radio_rx_inject(nrf_sim_radio_packet_t const * p_packet)
+{
+    NRF_RADIO_Type const * p_reg = &nrf_sim_radio_regs;
+
+    ASSERT(p_packet->length <= NRF_SIM_RADIO_PDU_SIZE);
+
+    if ((m_radio.state != RADIO_STATE_STATE_Rx) || m_radio.on_air ||
+        (p_packet->frequency != (p_reg->FREQUENCY & RADIO_FREQUENCY_FREQUENCY_Msk)) ||
+        !address_match(&m_radio, p_packet->address))
+    {
+        return false;
+    }
+
+    m_radio.packet       = *p_packet;
+    m_radio.on_air       = true;
+    m_radio.address_done = false;
+    nrf_sim_action_schedule(&m_radio.action, address_time(&m_radio));
+    return true;
+}
+
+
+uint64_t nrf_sim_radio_address_get(uint8_t logical)
+{
+    NRF_RADIO_Type const * p_reg  = &nrf_sim_radio_regs;
+    uint32_t               base   = (logical == 0) ? p_reg->BASE0 : p_reg->BASE1;
+    uint32_t               prefix = ((logical < 4) ? p_reg->PREFIX0 : p_reg->PREFIX1) >> (8 * (logical % 4));
+    uint32_t               balen  = base_length(&m_radio);
+
+    ASSERT(logical < 8);
+
+    /* Only the BALEN most significant bytes of the base address are sent. */
+    base = (balen == 0) ? 0 : (base & (0xFFFFFFFFUL << (8 * (4 - MIN(balen, 4)))));
+    return ((uint64_t)(prefix & 0xFF) << 32) | base;
+}
@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+#define RTC_CC_COUNT        4           /**< Number of compare registers. */
+#define RTC_COUNTER_MASK    0xFFFFFFUL  /**< COUNTER is 24 bits wide. */
+#define RTC_LFCLK_HZ        32768ULL    /**< Frequency of the low-frequency clock. */
+#define RTC_OVRFLW_TRIGGER  0xFFFFF0UL  /**< COUNTER value set by TRIGOVRFLW. */
+
+typedef struct
+{
+    nrf_sim_periph_t periph;
+    nrf_sim_action_t action;
+    bool             running;
+    nrf_sim_time_t   t0;               //!< Time at which COUNTER was equal to @p base.
+    uint32_t         base;             //!< COUNTER value at @p t0.
+    uint32_t         prescaler;        //!< Prescaler latched at START.
+    uint32_t         counter;          //!< COUNTER value at the last update.
+    uint32_t         cc[RTC_CC_COUNT]; //!< Compare values seen at the last update.
+    uint32_t         evten;            //!< Event routing mask.
+    uint32_t         routed;           //!< Event routing and interrupt mask seen at the last update.
+} rtc_t;
+
+NRF_RTC_Type nrf_sim_rtc_regs[NRF_SIM_RTC_COUNT];
+
+static rtc_t m_rtc[NRF_SIM_RTC_COUNT];
+
+static IRQn_Type const m_irqs[NRF_SIM_RTC_COUNT] = { RTC0_IRQn, RTC1_IRQn, RTC2_IRQn };
+
+
+static nrf_sim_time_t tick_period_num(rtc_t const * p_rtc)
+{
+    return 1000000000ULL * (p_rtc->prescaler + 1);
+}
+
+
+/**@brief Function for getting the number of ticks since @p t0. */
+static uint64_t ticks_elapsed(rtc_t const * p_rtc)
+{
+    return ((nrf_sim_time_get() - p_rtc->t0) * RTC_LFCLK_HZ) / tick_period_num(p_rtc);
+}
+
+
+/**@brief Function for getting the time from @p t0 at which the given tick happens. */
+static nrf_sim_time_t tick_time(rtc_t const * p_rtc, uint64_t tick)
+{
+    return (tick * tick_period_num(p_rtc) + RTC_LFCLK_HZ - 1) / RTC_LFCLK_HZ;
+}
+
+
+static void counter_restart(rtc_t * p_rtc, uint32_t value)
+{
+    p_rtc->t0      = nrf_sim_time_get();
+    p_rtc->base    = value & RTC_COUNTER_MASK;
+    p_rtc->counter = p_rtc->base;
+}
+
+
+static void schedule(rtc_t * p_rtc)
+{
+    nrf_sim_action_cancel(&p_rtc->action);
+    if (!p_rtc->running)
+    {
+        return;
+    }
+
+    /* Distance in ticks from the current COUNTER value to the next event. */
+    uint32_t distance = (RTC_COUNTER_MASK + 1) - p_rtc->counter;
+    uint32_t routed   = p_rtc->periph.inten | p_rtc->evten;
+
+    if (routed & RTC_EVTEN_TICK_Msk)
+    {
+        distance = 1;
+    }
+    for (uint32_t i = 0; i < RTC_CC_COUNT; i++)
+    {
+        uint32_t d = (p_rtc->cc[i] - p_rtc->counter) & RTC_COUNTER_MASK;
+        if (d == 0)
+        {
+            d = RTC_COUNTER_MASK + 1;
+        }
+        if (d < distance)
+        {
+            distance = d;
+        }
+    }
+
+    uint64_t       tick = ticks_elapsed(p_rtc) + distance;
+    nrf_sim_time_t due  = p_rtc->t0 + tick_time(p_rtc, tick);
+    nrf_sim_action_schedule(&p_rtc->action, due - nrf_sim_time_get());
+}
+
+
+/**@brief Function for bringing COUNTER up to date and generating the events passed on the way. */
+static void counter_update(rtc_t * p_rtc)
+{
+    NRF_RTC_Type * p_reg = p_rtc->periph.p_reg;
+
+    if (!p_rtc->running)
+    {
+        return;
+    }
+
+    uint32_t previous = p_rtc->counter;
+    uint32_t current  = (uint32_t)((p_rtc->base + ticks_elapsed(p_rtc)) & RTC_COUNTER_MASK);
+    uint32_t passed   = (current - previous) & RTC_COUNTER_MASK;
+
+    p_rtc->counter = current;
+    nrf_sim_reg_set(&p_reg->COUNTER, current);
+
+    if (passed == 0)
+    {
+        return;
+    }
+
+    if ((p_rtc->periph.inten | p_rtc->evten) & RTC_EVTEN_TICK_Msk)
+    {
+        nrf_sim_event_generate(&p_rtc->periph, &p_reg->EVENTS_TICK);
+    }
+    if (current < previous)
+    {
+        nrf_sim_event_generate(&p_rtc->periph, &p_reg->EVENTS_OVRFLW);
+    }
+    for (uint32_t i = 0; i < RTC_CC_COUNT; i++)
+    {
+        /* Compare matches in the interval (previous, current]. */
+        uint32_t d = (p_rtc->cc[i] - previous) & RTC_COUNTER_MASK;
+        if ((d != 0) && (d <= passed))
+        {
+            nrf_sim_event_generate(&p_rtc->periph, &p_reg->EVENTS_COMPARE[i]);
+        }
+    }
+}
+
+
+static void rtc_action(void * p_context)
+{
+    rtc_t * p_rtc = p_context;
+
+    counter_update(p_rtc);
+    schedule(p_rtc);
+}
+
+
+void nrf_sim_rtc_reset(void)
+{
+    memset(nrf_sim_rtc_regs, 0, sizeof(nrf_sim_rtc_regs));
+    memset(m_rtc, 0, sizeof(m_rtc));
+
+    for (uint32_t i = 0; i < NRF_SIM_RTC_COUNT; i++)
+    {
+        m_rtc[i].periph.p_reg    = &nrf_sim_rtc_regs[i];
+        m_rtc[i].periph.irq      = m_irqs[i];
+        m_rtc[i].action.handler   = rtc_action;
+        m_rtc[i].action.p_context = &m_rtc[i];
+        nrf_sim_periph_register(&m_rtc[i].periph);
+    }
+}
+
+
+bool nrf_sim_rtc_poll(void)
+{
+    bool busy = false;
+
+    for (uint32_t i = 0; i < NRF_SIM_RTC_COUNT; i++)
+    {
+        rtc_t        * p_rtc   = &m_rtc[i];
+        NRF_RTC_Type * p_reg   = p_rtc->periph.p_reg;
+        bool           changed = false;
+
+        (void)nrf_sim_mask_update(&p_rtc->evten, &p_reg->EVTEN, &p_reg->EVTENSET, &p_reg->EVTENCLR);
+        counter_update(p_rtc);
+
+        if (nrf_sim_task_take(&p_reg->TASKS_START))
+        {
+            if (!p_rtc->running)
+            {
+                p_rtc->running   = true;
+                p_rtc->prescaler = p_reg->PRESCALER & RTC_PRESCALER_PRESCALER_Msk;
+                counter_restart(p_rtc, p_rtc->counter);
+            }
+            changed = true;
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_STOP))
+        {
+            p_rtc->running = false;
+            changed = true;
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_CLEAR))
+        {
+            counter_restart(p_rtc, 0);
+            changed = true;
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_TRIGOVRFLW))
+        {
+            counter_restart(p_rtc, RTC_OVRFLW_TRIGGER);
+            changed = true;
+        }
+        if (changed)
+        {
+            nrf_sim_reg_set(&p_reg->COUNTER, p_rtc->counter);
+        }
+
+        bool reschedule = changed;
+        for (uint32_t cc = 0; cc < RTC_CC_COUNT; cc++)
+        {
+            if (p_rtc->cc[cc] != (p_reg->CC[cc] & RTC_COUNTER_MASK))
+            {
+                p_rtc->cc[cc] = p_reg->CC[cc] & RTC_COUNTER_MASK;
+                reschedule    = true;
+            }
+        }
+        if (p_rtc->routed != (p_rtc->periph.inten | p_rtc->evten))
+        {
+            p_rtc->routed = p_rtc->periph.inten | p_rtc->evten;
+            reschedule    = true;
+        }
+        if (reschedule || (p_rtc->running && !p_rtc->action.scheduled))
+        {
+            schedule(p_rtc);
+        }
+        busy |= changed;
+    }
+    return busy;
+}
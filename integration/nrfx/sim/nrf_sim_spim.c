@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+typedef struct
+{
+    nrf_sim_periph_t     periph;
+    nrf_sim_action_t     action;
+    nrf_sim_spim_xfer_t  xfer;
+    void               * p_xfer_context;
+    bool                 active;
+    uint8_t const      * p_tx;      //!< TXD.PTR latched at START.
+    uint32_t             tx_length; //!< TXD.MAXCNT latched at START.
+    uint8_t            * p_rx;      //!< RXD.PTR latched at START.
+    uint32_t             rx_length; //!< RXD.MAXCNT latched at START.
+} spim_t;
+
+NRF_SPIM_Type nrf_sim_spim_regs[NRF_SIM_SPIM_COUNT];
+
+static spim_t m_spim[NRF_SIM_SPIM_COUNT];
+
+static IRQn_Type const m_irqs[NRF_SIM_SPIM_COUNT] =
+{
+    SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn,
+    SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn,
+    SPIM2_SPIS2_SPI2_IRQn,
+    SPIM3_IRQn,
+};
+
+
+static uint32_t bit_rate(spim_t const * p_spim)
+{
+    NRF_SPIM_Type const * p_reg = p_spim->periph.p_reg;
+
+    switch (p_reg->FREQUENCY)
+    {
+        case SPIM_FREQUENCY_FREQUENCY_M16:
+            return 16000000UL;
+        case SPIM_FREQUENCY_FREQUENCY_M32:
+            return 32000000UL;
+        default:
+            /* K125 to M8 are multiples of 0x02000000, each step worth 125 kbps. */
+            return MAX((p_reg->FREQUENCY / SPIM_FREQUENCY_FREQUENCY_K125) * 125000UL, 125000UL);
+    }
+}
+
+
+static void xfer_action(void * p_context)
+{
+    spim_t        * p_spim = p_context;
+    NRF_SPIM_Type * p_reg  = p_spim->periph.p_reg;
+
+    if (p_spim->xfer != NULL)
+    {
+        p_spim->xfer(p_spim->p_xfer_context,
+                     p_spim->p_tx, p_spim->tx_length,
+                     p_spim->p_rx, p_spim->rx_length);
+    }
+    else
+    {
+        memset(p_spim->p_rx, 0xFF, p_spim->rx_length);
+    }
+
+    p_spim->active = false;
+    nrf_sim_reg_set(&p_reg->TXD.AMOUNT, p_spim->tx_length);
+    nrf_sim_reg_set(&p_reg->RXD.AMOUNT, p_spim->rx_length);
+    nrf_sim_event_generate(&p_spim->periph, &p_reg->EVENTS_ENDTX);
+    nrf_sim_event_generate(&p_spim->periph, &p_reg->EVENTS_ENDRX);
+    nrf_sim_event_generate(&p_spim->periph, &p_reg->EVENTS_END);
+
+    if (p_reg->SHORTS & SPIM_SHORTS_END_START_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_START);
+    }
+}
+
+
+void nrf_sim_spim_reset(void)
+{
+    memset(nrf_sim_spim_regs, 0, sizeof(nrf_sim_spim_regs));
+    memset(m_spim, 0, sizeof(m_spim));
+
+    for (uint32_t i = 0; i < NRF_SIM_SPIM_COUNT; i++)
+    {
+        m_spim[i].periph.p_reg     = &nrf_sim_spim_regs[i];
+        m_spim[i].periph.irq       = m_irqs[i];
+        m_spim[i].action.handler   = xfer_action;
+        m_spim[i].action.p_context = &m_spim[i];
+        nrf_sim_periph_register(&m_spim[i].periph);
+    }
+}
+
+
+bool nrf_sim_spim_poll(void)
+{
+    bool busy = false;
+
+    for (uint32_t i = 0; i < NRF_SIM_SPIM_COUNT; i++)
+    {
+        spim_t        * p_spim = &m_spim[i];
+        NRF_SPIM_Type * p_reg  = p_spim->periph.p_reg;
+
+        if (nrf_sim_task_take(&p_reg->TASKS_START))
+        {
+            busy = true;
+            if (!p_spim->active && (p_reg->ENABLE != 0))
+            {
+                p_spim->active    = true;
+                p_spim->p_tx      = nrf_sim_reg_to_ptr(p_reg->TXD.PTR);
+                p_spim->tx_length = p_reg->TXD.MAXCNT;
+                p_spim->p_rx      = nrf_sim_reg_to_ptr(p_reg->RXD.PTR);
+                p_spim->rx_length = p_reg->RXD.MAXCNT;
+                nrf_sim_event_generate(&p_spim->periph, &p_reg->EVENTS_STARTED);
+
+                uint32_t bytes = MAX(p_spim->tx_length, p_spim->rx_length);
+                nrf_sim_action_schedule(&p_spim->action, nrf_sim_bits_time(8ULL * bytes, bit_rate(p_spim)));
+            }
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_STOP))
+        {
+            busy = true;
+            if (p_spim->active)
+            {
+                nrf_sim_action_cancel(&p_spim->action);
+                p_spim->active = false;
+            }
+            nrf_sim_event_generate(&p_spim->periph, &p_reg->EVENTS_STOPPED);
+        }
+        busy |= nrf_sim_task_take(&p_reg->TASKS_SUSPEND);
+        busy |= nrf_sim_task_take(&p_reg->TASKS_RESUME);
+    }
+    return busy;
+}
+
+
+void nrf_sim_spim_device_set(uint8_t idx, nrf_sim_spim_xfer_t xfer, void * p_context)
+{
+    ASSERT(idx < NRF_SIM_SPIM_COUNT);
+
+    m_spim[idx].xfer           = xfer;
+    m_spim[idx].p_xfer_context = p_context;
+}
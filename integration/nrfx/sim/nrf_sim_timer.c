@@ -0,0 +1,298 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+#define TIMER_CC_COUNT      6           /**< Number of capture/compare registers modeled for every instance. */
+#define TIMER_BASE_HZ       16000000ULL /**< Frequency of the timer clock before the prescaler. */
+
+typedef struct
+{
+    nrf_sim_periph_t periph;
+    nrf_sim_action_t action;
+    bool             running;
+    nrf_sim_time_t   t0;                 //!< Time at which the counter was equal to @p base.
+    uint32_t         base;               //!< Counter value at @p t0.
+    uint64_t         ticks;              //!< Ticks counted since @p t0 at the last update.
+    uint32_t         counter;            //!< Counter value at the last update.
+    uint32_t         cc[TIMER_CC_COUNT]; //!< Compare values seen at the last update.
+    uint32_t         mode;               //!< MODE seen at the last update.
+    uint32_t         prescaler;          //!< PRESCALER latched at START.
+} sim_timer_t;
+
+NRF_TIMER_Type nrf_sim_timer_regs[NRF_SIM_TIMER_COUNT];
+
+static sim_timer_t m_timer[NRF_SIM_TIMER_COUNT];
+
+static IRQn_Type const m_irqs[NRF_SIM_TIMER_COUNT] =
+{
+    TIMER0_IRQn, TIMER1_IRQn, TIMER2_IRQn, TIMER3_IRQn, TIMER4_IRQn
+};
+
+
+static uint32_t counter_mask(sim_timer_t const * p_timer)
+{
+    NRF_TIMER_Type const * p_reg = p_timer->periph.p_reg;
+
+    switch (p_reg->BITMODE & TIMER_BITMODE_BITMODE_Msk)
+    {
+        case TIMER_BITMODE_BITMODE_08Bit:
+            return 0xFFUL;
+        case TIMER_BITMODE_BITMODE_24Bit:
+            return 0xFFFFFFUL;
+        case TIMER_BITMODE_BITMODE_32Bit:
+            return 0xFFFFFFFFUL;
+        default:
+            return 0xFFFFUL;
+    }
+}
+
+
+static bool is_timer_mode(sim_timer_t const * p_timer)
+{
+    return (p_timer->mode & TIMER_MODE_MODE_Msk) == TIMER_MODE_MODE_Timer;
+}
+
+
+static uint64_t frequency(sim_timer_t const * p_timer)
+{
+    return TIMER_BASE_HZ >> p_timer->prescaler;
+}
+
+
+static uint64_t ticks_elapsed(sim_timer_t const * p_timer)
+{
+    return ((nrf_sim_time_get() - p_timer->t0) * frequency(p_timer)) / 1000000000ULL;
+}
+
+
+static void counter_restart(sim_timer_t * p_timer, uint32_t value)
+{
+    p_timer->t0      = nrf_sim_time_get();
+    p_timer->base    = value;
+    p_timer->ticks   = 0;
+    p_timer->counter = value;
+}
+
+
+static void compare_check(sim_timer_t * p_timer, uint32_t previous, uint64_t passed)
+{
+    NRF_TIMER_Type * p_reg = p_timer->periph.p_reg;
+    uint32_t         mask  = counter_mask(p_timer);
+
+    for (uint32_t i = 0; i < TIMER_CC_COUNT; i++)
+    {
+        /* Compare matches in the interval (previous, previous + passed]. */
+        uint64_t d = (p_timer->cc[i] - previous) & mask;
+        if (d == 0)
+        {
+            d = (uint64_t)mask + 1;
+        }
+        if (d > passed)
+        {
+            continue;
+        }
+
+        nrf_sim_event_generate(&p_timer->periph, &p_reg->EVENTS_COMPARE[i]);
+        if (p_reg->SHORTS & (TIMER_SHORTS_COMPARE0_CLEAR_Msk << i))
+        {
+            counter_restart(p_timer, 0);
+        }
+        if (p_reg->SHORTS & (TIMER_SHORTS_COMPARE0_STOP_Msk << i))
+        {
+            p_timer->running = false;
+        }
+    }
+}
+
+
+static void counter_update(sim_timer_t * p_timer)
+{
+    if (!p_timer->running || !is_timer_mode(p_timer))
+    {
+        return;
+    }
+
+    uint64_t ticks    = ticks_elapsed(p_timer);
+    uint64_t passed   = ticks - p_timer->ticks;
+    uint32_t previous = p_timer->counter;
+
+    if (passed == 0)
+    {
+        return;
+    }
+
+    p_timer->ticks   = ticks;
+    p_timer->counter = (uint32_t)((p_timer->base + ticks) & counter_mask(p_timer));
+    compare_check(p_timer, previous, passed);
+}
+
+
+static void schedule(sim_timer_t * p_timer)
+{
+    nrf_sim_action_cancel(&p_timer->action);
+    if (!p_timer->running || !is_timer_mode(p_timer))
+    {
+        return;
+    }
+
+    uint32_t mask     = counter_mask(p_timer);
+    uint64_t distance = (uint64_t)mask + 1;
+
+    for (uint32_t i = 0; i < TIMER_CC_COUNT; i++)
+    {
+        uint64_t d = (p_timer->cc[i] - p_timer->counter) & mask;
+        if ((d != 0) && (d < distance))
+        {
+            distance = d;
+        }
+    }
+
+    uint64_t       tick = p_timer->ticks + distance;
+    uint64_t       freq = frequency(p_timer);
+    nrf_sim_time_t due  = p_timer->t0 + (tick * 1000000000ULL + freq - 1) / freq;
+
+    nrf_sim_action_schedule(&p_timer->action, due - nrf_sim_time_get());
+}
+
+
+static void timer_action(void * p_context)
+{
+    sim_timer_t * p_timer = p_context;
+
+    counter_update(p_timer);
+    schedule(p_timer);
+}
+
+
+void nrf_sim_timer_reset(void)
+{
+    memset(nrf_sim_timer_regs, 0, sizeof(nrf_sim_timer_regs));
+    memset(m_timer, 0, sizeof(m_timer));
+
+    for (uint32_t i = 0; i < NRF_SIM_TIMER_COUNT; i++)
+    {
+        nrf_sim_timer_regs[i].PRESCALER = 4;
+        m_timer[i].periph.p_reg     = &nrf_sim_timer_regs[i];
+        m_timer[i].periph.irq       = m_irqs[i];
+        m_timer[i].action.handler   = timer_action;
+        m_timer[i].action.p_context = &m_timer[i];
+        nrf_sim_periph_register(&m_timer[i].periph);
+    }
+}
+
+
+bool nrf_sim_timer_poll(void)
+{
+    bool busy = false;
+
+    for (uint32_t i = 0; i < NRF_SIM_TIMER_COUNT; i++)
+    {
+        sim_timer_t    * p_timer = &m_timer[i];
+        NRF_TIMER_Type * p_reg   = p_timer->periph.p_reg;
+        bool             changed = false;
+
+        counter_update(p_timer);
+
+        if (p_timer->mode != p_reg->MODE)
+        {
+            p_timer->mode = p_reg->MODE;
+            counter_restart(p_timer, p_timer->counter);
+            changed = true;
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_START))
+        {
+            if (!p_timer->running)
+            {
+                p_timer->running   = true;
+                p_timer->prescaler = p_reg->PRESCALER & TIMER_PRESCALER_PRESCALER_Msk;
+                if (p_timer->prescaler > 9)
+                {
+                    p_timer->prescaler = 9;
+                }
+                counter_restart(p_timer, p_timer->counter);
+            }
+            changed = true;
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_STOP) || nrf_sim_task_take(&p_reg->TASKS_SHUTDOWN))
+        {
+            p_timer->running = false;
+            changed = true;
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_CLEAR))
+        {
+            counter_restart(p_timer, 0);
+            changed = true;
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_COUNT))
+        {
+            if (p_timer->running && !is_timer_mode(p_timer))
+            {
+                uint32_t previous = p_timer->counter;
+                p_timer->ticks++;
+                p_timer->counter = (previous + 1) & counter_mask(p_timer);
+                compare_check(p_timer, previous, 1);
+            }
+            changed = true;
+        }
+        for (uint32_t cc = 0; cc < TIMER_CC_COUNT; cc++)
+        {
+            if (nrf_sim_task_take(&p_reg->TASKS_CAPTURE[cc]))
+            {
+                p_reg->CC[cc]  = p_timer->counter;
+                p_timer->cc[cc] = p_timer->counter;
+                changed = true;
+            }
+            if (p_timer->cc[cc] != p_reg->CC[cc])
+            {
+                p_timer->cc[cc] = p_reg->CC[cc];
+                changed = true;
+            }
+        }
+
+        if (changed || (p_timer->running && is_timer_mode(p_timer) && !p_timer->action.scheduled))
+        {
+            schedule(p_timer);
+        }
+        busy |= changed;
+    }
+    return busy;
+}
@@ -0,0 +1,303 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+#define TWIM_DEVICES_MAX    8   /**< Maximum number of devices attached to one bus. */
+#define TWIM_BYTE_BITS      9   /**< 8 data bits and ACK. */
+
+typedef struct
+{
+    uint8_t                       address;
+    nrf_sim_twim_device_t const * p_device;
+} twim_slot_t;
+
+typedef enum
+{
+    TWIM_IDLE,
+    TWIM_TX,
+    TWIM_RX,
+    TWIM_SUSPENDED,
+} twim_state_t;
+
+typedef struct
+{
+    nrf_sim_periph_t periph;
+    nrf_sim_action_t action;
+    twim_state_t     state;
+    bool             addressed;    //!< Start condition and address were sent and not yet followed by a stop.
+    twim_slot_t      devices[TWIM_DEVICES_MAX];
+} twim_t;
+
+NRF_TWIM_Type nrf_sim_twim_regs[NRF_SIM_TWIM_COUNT];
+
+static twim_t m_twim[NRF_SIM_TWIM_COUNT];
+
+static IRQn_Type const m_irqs[NRF_SIM_TWIM_COUNT] =
+{
+    SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn,
+    SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn,
+};
+
+
+static uint32_t bit_rate(twim_t const * p_twim)
+{
+    NRF_TWIM_Type const * p_reg = p_twim->periph.p_reg;
+
+    /* FREQUENCY holds the bit rate as a fraction of the 16 MHz clock, scaled by 2^32. */
+    uint32_t rate = (uint32_t)(((uint64_t)p_reg->FREQUENCY * 16000000ULL) >> 32);
+    return (rate != 0) ? rate : 100000UL;
+}
+
+
+static nrf_sim_twim_device_t const * device_find(twim_t const * p_twim, uint8_t address)
+{
+    for (uint32_t i = 0; i < TWIM_DEVICES_MAX; i++)
+    {
+        if ((p_twim->devices[i].p_device != NULL) && (p_twim->devices[i].address == address))
+        {
+            return p_twim->devices[i].p_device;
+        }
+    }
+    return NULL;
+}
+
+
+static void transfer_start(twim_t * p_twim, twim_state_t state, uint32_t length)
+{
+    /* Address byte is only sent after a start or a repeated start. */
+    uint64_t bytes = length + 1;
+
+    p_twim->state = state;
+    nrf_sim_action_schedule(&p_twim->action,
+                            nrf_sim_bits_time(TWIM_BYTE_BITS * bytes, bit_rate(p_twim)));
+}
+
+
+static void transfer_action(void * p_context)
+{
+    twim_t                      * p_twim   = p_context;
+    NRF_TWIM_Type               * p_reg    = p_twim->periph.p_reg;
+    nrf_sim_twim_device_t const * p_device = device_find(p_twim, (uint8_t)p_reg->ADDRESS);
+    bool                          tx       = (p_twim->state == TWIM_TX);
+    bool                          ack;
+
+    p_twim->addressed = true;
+    if (p_device == NULL)
+    {
+        p_reg->ERRORSRC |= TWIM_ERRORSRC_ANACK_Msk;
+        ack = false;
+    }
+    else if (tx)
+    {
+        ack = (p_device->write == NULL) ||
+              p_device->write(p_device->p_context, nrf_sim_reg_to_ptr(p_reg->TXD.PTR), p_reg->TXD.MAXCNT);
+        if (!ack)
+        {
+            p_reg->ERRORSRC |= TWIM_ERRORSRC_DNACK_Msk;
+        }
+    }
+    else
+    {
+        ack = (p_device->read == NULL) ||
+              p_device->read(p_device->p_context, nrf_sim_reg_to_ptr(p_reg->RXD.PTR), p_reg->RXD.MAXCNT);
+        if (!ack)
+        {
+            p_reg->ERRORSRC |= TWIM_ERRORSRC_ANACK_Msk;
+        }
+    }
+
+    p_twim->state = TWIM_IDLE;
+    if (!ack)
+    {
+        /* The master waits for the STOP task after an error. */
+        nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_ERROR);
+        return;
+    }
+
+    if (tx)
+    {
+        nrf_sim_reg_set(&p_reg->TXD.AMOUNT, p_reg->TXD.MAXCNT);
+        nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_LASTTX);
+        if (p_reg->SHORTS & TWIM_SHORTS_LASTTX_STARTRX_Msk)
+        {
+            nrf_sim_task_trigger(&p_reg->TASKS_STARTRX);
+        }
+        if (p_reg->SHORTS & TWIM_SHORTS_LASTTX_SUSPEND_Msk)
+        {
+            p_twim->state = TWIM_SUSPENDED;
+            nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_SUSPENDED);
+        }
+        if (p_reg->SHORTS & TWIM_SHORTS_LASTTX_STOP_Msk)
+        {
+            nrf_sim_task_trigger(&p_reg->TASKS_STOP);
+        }
+    }
+    else
+    {
+        nrf_sim_reg_set(&p_reg->RXD.AMOUNT, p_reg->RXD.MAXCNT);
+        nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_LASTRX);
+        if (p_reg->SHORTS & TWIM_SHORTS_LASTRX_STARTTX_Msk)
+        {
+            nrf_sim_task_trigger(&p_reg->TASKS_STARTTX);
+        }
+        if (p_reg->SHORTS & TWIM_SHORTS_LASTRX_SUSPEND_Msk)
+        {
+            p_twim->state = TWIM_SUSPENDED;
+            nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_SUSPENDED);
+        }
+        if (p_reg->SHORTS & TWIM_SHORTS_LASTRX_STOP_Msk)
+        {
+            nrf_sim_task_trigger(&p_reg->TASKS_STOP);
+        }
+    }
+}
+
+
+void nrf_sim_twim_reset(void)
+{
+    memset(nrf_sim_twim_regs, 0, sizeof(nrf_sim_twim_regs));
+
+    for (uint32_t i = 0; i < NRF_SIM_TWIM_COUNT; i++)
+    {
+        /* Attached devices survive a reset of the simulation. */
+        m_twim[i].state             = TWIM_IDLE;
+        m_twim[i].addressed         = false;
+        m_twim[i].periph.p_reg      = &nrf_sim_twim_regs[i];
+        m_twim[i].periph.irq        = m_irqs[i];
+        m_twim[i].action.handler    = transfer_action;
+        m_twim[i].action.p_context  = &m_twim[i];
+        m_twim[i].action.scheduled  = false;
+        nrf_sim_periph_register(&m_twim[i].periph);
+    }
+}
+
+
+bool nrf_sim_twim_poll(void)
+{
+    bool busy = false;
+
+    for (uint32_t i = 0; i < NRF_SIM_TWIM_COUNT; i++)
+    {
+        twim_t        * p_twim = &m_twim[i];
+        NRF_TWIM_Type * p_reg  = p_twim->periph.p_reg;
+
+        if (nrf_sim_task_take(&p_reg->TASKS_RESUME))
+        {
+            busy = true;
+            if (p_twim->state == TWIM_SUSPENDED)
+            {
+                p_twim->state = TWIM_IDLE;
+            }
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_STARTTX))
+        {
+            busy = true;
+            if (p_reg->ENABLE != 0)
+            {
+                nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_TXSTARTED);
+                transfer_start(p_twim, TWIM_TX, p_reg->TXD.MAXCNT);
+            }
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_STARTRX))
+        {
+            busy = true;
+            if (p_reg->ENABLE != 0)
+            {
+                nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_RXSTARTED);
+                transfer_start(p_twim, TWIM_RX, p_reg->RXD.MAXCNT);
+            }
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_SUSPEND))
+        {
+            busy = true;
+            if (p_twim->state == TWIM_IDLE)
+            {
+                p_twim->state = TWIM_SUSPENDED;
+                nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_SUSPENDED);
+            }
+        }
+        if (nrf_sim_task_take(&p_reg->TASKS_STOP))
+        {
+            busy = true;
+            nrf_sim_action_cancel(&p_twim->action);
+            p_twim->state     = TWIM_IDLE;
+            p_twim->addressed = false;
+            nrf_sim_event_generate(&p_twim->periph, &p_reg->EVENTS_STOPPED);
+        }
+    }
+    return busy;
+}
+
+
+bool nrf_sim_twim_device_set(uint8_t idx, uint8_t address, nrf_sim_twim_device_t const * p_device)
+{
+    ASSERT(idx < NRF_SIM_TWIM_COUNT);
+
+    twim_t      * p_twim = &m_twim[idx];
+    twim_slot_t * p_free = NULL;
+
+    for (uint32_t i = 0; i < TWIM_DEVICES_MAX; i++)
+    {
+        twim_slot_t * p_slot = &p_twim->devices[i];
+        if ((p_slot->p_device != NULL) && (p_slot->address == address))
+        {
+            p_slot->p_device = p_device;
+            return true;
+        }
+        if ((p_slot->p_device == NULL) && (p_free == NULL))
+        {
+            p_free = p_slot;
+        }
+    }
+
+    if (p_device == NULL)
+    {
+        return true;
+    }
+    if (p_free == NULL)
+    {
+        return false;
+    }
+    p_free->address  = address;
+    p_free->p_device = p_device;
+    return true;
+}
@@ -0,0 +1,338 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "nrf_sim_internal.h"
+#include "nrf_sim_peripherals.h"
+
+#define UARTE_RX_LINE_SIZE  4096    /**< Number of injected bytes the RX line model can hold. */
+#define UARTE_FRAME_BITS    10      /**< Start bit, 8 data bits and stop bit. */
+#define UARTE_NO_PEER       0xFF    /**< TX line is not connected to another instance. */
+
+typedef struct
+{
+    nrf_sim_periph_t           periph;
+    nrf_sim_action_t           tx_action;
+    nrf_sim_action_t           rx_action;
+    nrf_sim_uarte_tx_handler_t tx_handler;
+    void                     * p_tx_context;
+    uint8_t                    peer;        //!< Instance receiving the transmitted data.
+
+    bool            tx_active;
+    uint8_t const * p_tx;                   //!< TXD.PTR latched at STARTTX.
+    uint32_t        tx_length;              //!< TXD.MAXCNT latched at STARTTX.
+    uint32_t        tx_started;             //!< Bytes put on the line of the peer.
+    nrf_sim_time_t  tx_start;               //!< Time of STARTTX.
+
+    bool            rx_active;
+    uint8_t       * p_rx;                   //!< RXD.PTR latched at STARTRX.
+    uint32_t        rx_length;              //!< RXD.MAXCNT latched at STARTRX.
+    uint32_t        rx_amount;              //!< Bytes received into the current buffer.
+
+    uint8_t         line[UARTE_RX_LINE_SIZE]; //!< Bytes on the RX line, not yet received.
+    uint32_t        line_head;
+    uint32_t        line_count;
+} uarte_t;
+
+NRF_UARTE_Type nrf_sim_uarte_regs[NRF_SIM_UARTE_COUNT];
+
+static uarte_t m_uarte[NRF_SIM_UARTE_COUNT];
+
+static IRQn_Type const m_irqs[NRF_SIM_UARTE_COUNT] = { UARTE0_UART0_IRQn, UARTE1_IRQn };
+
+
+static uint32_t baudrate(uarte_t const * p_uarte)
+{
+    NRF_UARTE_Type const * p_reg = p_uarte->periph.p_reg;
+
+    /* BAUDRATE holds the baud rate as a fraction of the 16 MHz clock, scaled by 2^32. */
+    uint32_t baud = (uint32_t)(((uint64_t)p_reg->BAUDRATE * 16000000ULL) >> 32);
+    return (baud != 0) ? baud : 1;
+}
+
+
+static nrf_sim_time_t byte_time(uarte_t const * p_uarte)
+{
+    return nrf_sim_bits_time(UARTE_FRAME_BITS, baudrate(p_uarte));
+}
+
+
+static bool hwfc_enabled(uarte_t const * p_uarte)
+{
+    NRF_UARTE_Type const * p_reg = p_uarte->periph.p_reg;
+    return (p_reg->CONFIG & UARTE_CONFIG_HWFC_Msk) != 0;
+}
+
+
+static void rx_schedule(uarte_t * p_uarte)
+{
+    if ((p_uarte->line_count != 0) && !p_uarte->rx_action.scheduled)
+    {
+        nrf_sim_action_schedule(&p_uarte->rx_action, byte_time(p_uarte));
+    }
+}
+
+
+static void rx_end(uarte_t * p_uarte)
+{
+    NRF_UARTE_Type * p_reg = p_uarte->periph.p_reg;
+
+    p_uarte->rx_active = false;
+    nrf_sim_reg_set(&p_reg->RXD.AMOUNT, p_uarte->rx_amount);
+    nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_ENDRX);
+
+    if (p_reg->SHORTS & UARTE_SHORTS_ENDRX_STARTRX_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_STARTRX);
+    }
+    if (p_reg->SHORTS & UARTE_SHORTS_ENDRX_STOPRX_Msk)
+    {
+        nrf_sim_task_trigger(&p_reg->TASKS_STOPRX);
+    }
+}
+
+
+/**@brief Action receiving one byte from the RX line. */
+static void rx_action(void * p_context)
+{
+    uarte_t        * p_uarte = p_context;
+    NRF_UARTE_Type * p_reg   = p_uarte->periph.p_reg;
+
+    if (p_uarte->line_count == 0)
+    {
+        return;
+    }
+
+    if (!p_uarte->rx_active)
+    {
+        if (hwfc_enabled(p_uarte))
+        {
+            /* RTS is deasserted, the byte stays on the line until the receiver is started. */
+            return;
+        }
+        p_uarte->line_head = (p_uarte->line_head + 1) % UARTE_RX_LINE_SIZE;
+        p_uarte->line_count--;
+        p_reg->ERRORSRC |= UARTE_ERRORSRC_OVERRUN_Msk;
+        nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_ERROR);
+        rx_schedule(p_uarte);
+        return;
+    }
+
+    p_uarte->p_rx[p_uarte->rx_amount++] = p_uarte->line[p_uarte->line_head];
+    p_uarte->line_head = (p_uarte->line_head + 1) % UARTE_RX_LINE_SIZE;
+    p_uarte->line_count--;
+    nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_RXDRDY);
+
+    if (p_uarte->rx_amount == p_uarte->rx_length)
+    {
+        rx_end(p_uarte);
+    }
+    rx_schedule(p_uarte);
+}
+
+
+static void tx_deliver(uarte_t * p_uarte, uint32_t length)
+{
+    NRF_UARTE_Type * p_reg = p_uarte->periph.p_reg;
+
+    p_uarte->tx_active = false;
+    nrf_sim_reg_set(&p_reg->TXD.AMOUNT, length);
+
+    if (p_uarte->tx_handler != NULL)
+    {
+        p_uarte->tx_handler(p_uarte->p_tx_context, p_uarte->p_tx, length);
+    }
+}
+
+
+static void tx_action(void * p_context)
+{
+    uarte_t        * p_uarte = p_context;
+    NRF_UARTE_Type * p_reg   = p_uarte->periph.p_reg;
+
+    /* With a connected peer, every byte is put on its RX line when it starts to be shifted
+     * out, so that the peer receives it one byte time later, as on a wire. */
+    if ((p_uarte->peer != UARTE_NO_PEER) && (p_uarte->tx_started < p_uarte->tx_length))
+    {
+        (void)nrf_sim_uarte_rx_inject(p_uarte->peer, &p_uarte->p_tx[p_uarte->tx_started], 1);
+        p_uarte->tx_started++;
+        nrf_sim_action_schedule(&p_uarte->tx_action, byte_time(p_uarte));
+        return;
+    }
+
+    tx_deliver(p_uarte, p_uarte->tx_length);
+    nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_TXDRDY);
+    nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_ENDTX);
+}
+
+
+static void tasks_process(uarte_t * p_uarte, bool * p_busy)
+{
+    NRF_UARTE_Type * p_reg = p_uarte->periph.p_reg;
+
+    if (nrf_sim_task_take(&p_reg->TASKS_STARTTX))
+    {
+        *p_busy = true;
+        if (!p_uarte->tx_active && (p_reg->ENABLE != 0))
+        {
+            p_uarte->tx_active = true;
+            p_uarte->p_tx      = nrf_sim_reg_to_ptr(p_reg->TXD.PTR);
+            p_uarte->tx_length = p_reg->TXD.MAXCNT;
+            p_uarte->tx_start  = nrf_sim_time_get();
+            p_uarte->tx_started = 0;
+            nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_TXSTARTED);
+            nrf_sim_action_schedule(&p_uarte->tx_action,
+                                    (p_uarte->peer != UARTE_NO_PEER) ?
+                                    0 : byte_time(p_uarte) * p_uarte->tx_length);
+        }
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_STOPTX))
+    {
+        *p_busy = true;
+        if (p_uarte->tx_active)
+        {
+            /* Bytes fully shifted out before the stop are delivered. */
+            uint32_t sent = (uint32_t)((nrf_sim_time_get() - p_uarte->tx_start) / byte_time(p_uarte));
+            nrf_sim_action_cancel(&p_uarte->tx_action);
+            tx_deliver(p_uarte, MIN(sent, p_uarte->tx_length));
+        }
+        nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_TXSTOPPED);
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_STARTRX))
+    {
+        *p_busy = true;
+        if (!p_uarte->rx_active && (p_reg->ENABLE != 0))
+        {
+            p_uarte->rx_active = true;
+            p_uarte->p_rx      = nrf_sim_reg_to_ptr(p_reg->RXD.PTR);
+            p_uarte->rx_length = p_reg->RXD.MAXCNT;
+            p_uarte->rx_amount = 0;
+            nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_RXSTARTED);
+            if (p_uarte->rx_length == 0)
+            {
+                rx_end(p_uarte);
+            }
+            rx_schedule(p_uarte);
+        }
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_STOPRX))
+    {
+        *p_busy = true;
+        if (p_uarte->rx_active)
+        {
+            rx_end(p_uarte);
+        }
+        nrf_sim_event_generate(&p_uarte->periph, &p_reg->EVENTS_RXTO);
+    }
+    if (nrf_sim_task_take(&p_reg->TASKS_FLUSHRX))
+    {
+        *p_busy = true;
+        p_uarte->p_rx      = nrf_sim_reg_to_ptr(p_reg->RXD.PTR);
+        p_uarte->rx_length = p_reg->RXD.MAXCNT;
+        p_uarte->rx_amount = 0;
+        rx_end(p_uarte);
+    }
+}
+
+
+void nrf_sim_uarte_reset(void)
+{
+    memset(nrf_sim_uarte_regs, 0, sizeof(nrf_sim_uarte_regs));
+    memset(m_uarte, 0, sizeof(m_uarte));
+
+    for (uint32_t i = 0; i < NRF_SIM_UARTE_COUNT; i++)
+    {
+        m_uarte[i].periph.p_reg        = &nrf_sim_uarte_regs[i];
+        m_uarte[i].periph.irq          = m_irqs[i];
+        m_uarte[i].tx_action.handler   = tx_action;
+        m_uarte[i].tx_action.p_context = &m_uarte[i];
+        m_uarte[i].rx_action.handler   = rx_action;
+        m_uarte[i].rx_action.p_context = &m_uarte[i];
+        m_uarte[i].peer                = UARTE_NO_PEER;
+        nrf_sim_periph_register(&m_uarte[i].periph);
+    }
+}
+
+
+bool nrf_sim_uarte_poll(void)
+{
+    bool busy = false;
+
+    for (uint32_t i = 0; i < NRF_SIM_UARTE_COUNT; i++)
+    {
+        tasks_process(&m_uarte[i], &busy);
+    }
+    return busy;
+}
+
+
+void nrf_sim_uarte_tx_handler_set(uint8_t idx, nrf_sim_uarte_tx_handler_t handler, void * p_context)
+{
+    ASSERT(idx < NRF_SIM_UARTE_COUNT);
+
+    m_uarte[idx].tx_handler   = handler;
+    m_uarte[idx].p_tx_context = p_context;
+}
+
+
+size_t nrf_sim_uarte_rx_inject(uint8_t idx, uint8_t const * p_data, size_t length)
+{
+    ASSERT(idx < NRF_SIM_UARTE_COUNT);
+
+    uarte_t * p_uarte = &m_uarte[idx];
+    size_t    accepted = MIN(length, UARTE_RX_LINE_SIZE - p_uarte->line_count);
+
+    for (size_t i = 0; i < accepted; i++)
+    {
+        uint32_t tail = (p_uarte->line_head + p_uarte->line_count) % UARTE_RX_LINE_SIZE;
+        p_uarte->line[tail] = p_data[i];
+        p_uarte->line_count++;
+    }
+    rx_schedule(p_uarte);
+    return accepted;
+}
+
+
+void nrf_sim_uarte_connect(uint8_t tx_idx, uint8_t rx_idx)
+{
+    ASSERT(tx_idx < NRF_SIM_UARTE_COUNT);
+    ASSERT(rx_idx < NRF_SIM_UARTE_COUNT);
+
+    m_uarte[tx_idx].peer = rx_idx;
+}
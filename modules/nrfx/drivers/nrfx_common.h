@@ -218,7 +218,13 @@ do {                                                         \
  *
  * @return Interrupt number associated with the specified peripheral.
  */
+#ifdef NRF_SIM
+// In simulation builds, register blocks are in host memory and carry no peripheral ID.
+IRQn_Type nrf_sim_irq_number_get(void const * p_reg);
+#define NRFX_IRQ_NUMBER_GET(base_addr)  nrf_sim_irq_number_get((void const *)(base_addr))
+#else
 #define NRFX_IRQ_NUMBER_GET(base_addr)  NRFX_PERIPHERAL_ID_GET(base_addr)
+#endif
 
 /** @brief IRQ handler type. */
 typedef void (* nrfx_irq_handler_t)(void);
@@ -306,7 +312,13 @@ __STATIC_INLINE uint32_t nrfx_event_to_bitpos(uint32_t event);
 
 __STATIC_INLINE bool nrfx_is_in_ram(void const * p_object)
 {
+#ifdef NRF_SIM
+    // In simulation builds, all buffers are in host memory.
+    (void)p_object;
+    return true;
+#else
     return ((((uint32_t)p_object) & 0xE0000000u) == 0x20000000u);
+#endif
 }
 
 __STATIC_INLINE bool nrfx_is_word_aligned(void const * p_object)
@@ -366,11 +366,17 @@ __STATIC_INLINE nrf_ppi_task_t nrf_ppi_group_disable_task_get(uint8_t index);
 __STATIC_INLINE void nrf_ppi_channel_enable(nrf_ppi_channel_t channel)
 {
     NRF_PPI->CHENSET = PPI_CHENSET_CH0_Set << ((uint32_t) channel);
+#ifdef NRF_SIM
+    nrf_sim_ppi_chen_update();
+#endif
 }
 
 __STATIC_INLINE void nrf_ppi_channel_disable(nrf_ppi_channel_t channel)
 {
     NRF_PPI->CHENCLR = PPI_CHENCLR_CH0_Clear << ((uint32_t) channel);
+#ifdef NRF_SIM
+    nrf_sim_ppi_chen_update();
+#endif
 }
 
 __STATIC_INLINE nrf_ppi_channel_enable_t nrf_ppi_channel_enable_get(nrf_ppi_channel_t channel)
@@ -388,16 +394,25 @@ __STATIC_INLINE nrf_ppi_channel_enable_t nrf_ppi_channel_enable_get(nrf_ppi_chan
 __STATIC_INLINE void nrf_ppi_channel_disable_all(void)
 {
     NRF_PPI->CHENCLR = ((uint32_t)0xFFFFFFFFuL);
+#ifdef NRF_SIM
+    nrf_sim_ppi_chen_update();
+#endif
 }
 
 __STATIC_INLINE void nrf_ppi_channels_enable(uint32_t mask)
 {
     NRF_PPI->CHENSET = mask;
+#ifdef NRF_SIM
+    nrf_sim_ppi_chen_update();
+#endif
 }
 
 __STATIC_INLINE void nrf_ppi_channels_disable(uint32_t mask)
 {
     NRF_PPI->CHENCLR = mask;
+#ifdef NRF_SIM
+    nrf_sim_ppi_chen_update();
+#endif
 }
 
 __STATIC_INLINE void nrf_ppi_channel_endpoint_setup(nrf_ppi_channel_t channel,
@@ -541,7 +541,12 @@ __STATIC_INLINE uint32_t nrf_twim_errorsrc_get_and_clear(NRF_TWIM_Type * p_reg)
     uint32_t error_source = p_reg->ERRORSRC;
 
     // [error flags are cleared by writing '1' on their position]
+#ifdef NRF_SIM
+    // Simulated registers are plain memory, so the flags that were read are cleared here.
+    p_reg->ERRORSRC &= ~error_source;
+#else
     p_reg->ERRORSRC = error_source;
+#endif
 
     return error_source;
 }
@@ -523,7 +523,12 @@ __STATIC_INLINE void nrf_uarte_publish_clear(NRF_UARTE_Type *  p_reg,
 __STATIC_INLINE uint32_t nrf_uarte_errorsrc_get_and_clear(NRF_UARTE_Type * p_reg)
 {
     uint32_t errsrc_mask = p_reg->ERRORSRC;
+#ifdef NRF_SIM
+    // Simulated registers are plain memory, so the flags that were read are cleared here.
+    p_reg->ERRORSRC &= ~errsrc_mask;
+#else
     p_reg->ERRORSRC = errsrc_mask;
+#endif
     return errsrc_mask;
 }
 
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef APP_CONFIG_H__
+#define APP_CONFIG_H__
+
+#define NRF_CRYPTO_ENABLED                              1
+#define NRF_CRYPTO_ALLOCATOR                            3   // malloc(), as the host has a heap.
+
+// CCM and GCM from mbed TLS.
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ENABLED              1
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_CBC_ENABLED      0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_CTR_ENABLED      0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_ECB_ENABLED      0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_CFB_ENABLED      0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_CBC_MAC_ENABLED  0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_CMAC_ENABLED     0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_CCM_ENABLED      1
+#define NRF_CRYPTO_BACKEND_MBEDTLS_AES_GCM_ENABLED      1
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP192R1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP224R1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP256R1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP384R1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP521R1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP192K1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP224K1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_SECP256K1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_BP256R1_ENABLED  0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_BP384R1_ENABLED  0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_BP512R1_ENABLED  0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_ECC_CURVE25519_ENABLED 0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_HASH_SHA256_ENABLED  0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_HASH_SHA512_ENABLED  0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_HMAC_SHA256_ENABLED  0
+#define NRF_CRYPTO_BACKEND_MBEDTLS_HMAC_SHA512_ENABLED  0
+
+// EAX from Cifra.
+#define NRF_CRYPTO_BACKEND_CIFRA_ENABLED                1
+#define NRF_CRYPTO_BACKEND_CIFRA_AES_EAX_ENABLED        1
+
+// ChaCha-Poly from the Oberon backend. The Oberon library is not part of the tree, the test
+// provides its ChaCha20-Poly1305 functions on top of mbed TLS.
+#define NRF_CRYPTO_BACKEND_OBERON_ENABLED               1
+#define NRF_CRYPTO_BACKEND_OBERON_CHACHA_POLY_ENABLED   1
+#define NRF_CRYPTO_BACKEND_OBERON_ECC_SECP256R1_ENABLED 0
+#define NRF_CRYPTO_BACKEND_OBERON_ECC_CURVE25519_ENABLED 0
+#define NRF_CRYPTO_BACKEND_OBERON_ECC_ED25519_ENABLED   0
+#define NRF_CRYPTO_BACKEND_OBERON_HASH_SHA256_ENABLED   0
+#define NRF_CRYPTO_BACKEND_OBERON_HASH_SHA512_ENABLED   0
+#define NRF_CRYPTO_BACKEND_OBERON_HMAC_SHA256_ENABLED   0
+#define NRF_CRYPTO_BACKEND_OBERON_HMAC_SHA512_ENABLED   0
+
+#endif // APP_CONFIG_H__
@@ -0,0 +1,394 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host test of the streamed nrf_crypto AEAD operations.
+ *
+ * Every mode that can be streamed is checked against @ref nrf_crypto_aead_crypt with the same
+ * key, nonce and adata: CCM and GCM on the mbed TLS backend, EAX on the Cifra backend and
+ * ChaCha-Poly on the Oberon backend, whose library functions are provided on top of mbed TLS.
+ * Messages of odd lengths are split into chunks of several sizes and processed in place.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "sdk_common.h"
+#include "nrf_crypto.h"
+
+#define MESSAGE_MAX_SIZE    (300)   /**< Size of the largest message encrypted by the test. */
+#define ADATA_SIZE          (21)    /**< Size of the additional data, not a multiple of a block. */
+#define KEY_MAX_SIZE        (32)
+#define NONCE_MAX_SIZE      (16)
+#define MAC_MAX_SIZE        (16)
+#define RAND_SEED           (0x1D872B41)
+
+/* Streamed mode and the parameters it is used with. */
+typedef struct
+{
+    char const                   * p_name;
+    nrf_crypto_aead_info_t const * p_info;
+    uint8_t                        key_size;
+    uint8_t                        nonce_size;
+    uint8_t                        mac_size;
+} stream_mode_t;
+
+/* Message with its one-shot encryption. */
+typedef struct
+{
+    size_t  size;
+    uint8_t key[KEY_MAX_SIZE];
+    uint8_t nonce[NONCE_MAX_SIZE];
+    uint8_t adata[ADATA_SIZE];
+    uint8_t plaintext[MESSAGE_MAX_SIZE];
+    uint8_t ciphertext[MESSAGE_MAX_SIZE];
+    uint8_t mac[MAC_MAX_SIZE];
+} message_t;
+
+static stream_mode_t const m_modes[] =
+{
+    { "ccm_128",     &g_nrf_crypto_aes_ccm_128_info,     16, 13, 8  },
+    { "ccm_256",     &g_nrf_crypto_aes_ccm_256_info,     32, 7,  16 },
+    { "gcm_128",     &g_nrf_crypto_aes_gcm_128_info,     16, 12, 16 },
+    { "gcm_256",     &g_nrf_crypto_aes_gcm_256_info,     32, 12, 12 },
+    { "eax_128",     &g_nrf_crypto_aes_eax_128_info,     16, 16, 16 },
+    { "chacha_poly", &g_nrf_crypto_chacha_poly_256_info, 32, 12, 16 },
+};
+
+/* Message sizes around the block size and above the largest chunk. */
+static size_t const m_message_sizes[] = { 1, 15, 16, 17, 31, 64, 100, 257 };
+
+/* Chunk sizes; the last chunk of a message holds the remainder. 0 streams the message at once. */
+static size_t const m_chunk_sizes[] = { 16, 48, 80, 0 };
+
+static uint32_t                  m_rand_state = RAND_SEED;
+static nrf_crypto_aead_context_t m_context;
+
+
+static void rand_fill(uint8_t * p_buf, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        p_buf[i] = (uint8_t)host_test_rand(&m_rand_state);
+    }
+}
+
+
+/* Makes a random message and encrypts it with a one-shot call into a separate buffer. */
+static void message_make(message_t * p_msg, stream_mode_t const * p_mode, size_t size)
+{
+    p_msg->size = size;
+    rand_fill(p_msg->key, sizeof(p_msg->key));
+    rand_fill(p_msg->nonce, sizeof(p_msg->nonce));
+    rand_fill(p_msg->adata, sizeof(p_msg->adata));
+    rand_fill(p_msg->plaintext, size);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_init(&m_context, p_mode->p_info, p_msg->key));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_crypt(&m_context,
+                                                         NRF_CRYPTO_ENCRYPT,
+                                                         p_msg->nonce,
+                                                         p_mode->nonce_size,
+                                                         p_msg->adata,
+                                                         sizeof(p_msg->adata),
+                                                         p_msg->plaintext,
+                                                         size,
+                                                         p_msg->ciphertext,
+                                                         p_msg->mac,
+                                                         p_mode->mac_size));
+}
+
+
+/* Streams p_in through the context into p_out and finalizes with p_mac. */
+static ret_code_t stream(message_t const      * p_msg,
+                         stream_mode_t const  * p_mode,
+                         nrf_crypto_operation_t operation,
+                         uint8_t              * p_in,
+                         uint8_t              * p_out,
+                         size_t                 chunk_size,
+                         uint8_t              * p_mac)
+{
+    size_t offset = 0;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_start(&m_context,
+                                                         operation,
+                                                         (uint8_t *)p_msg->nonce,
+                                                         p_mode->nonce_size,
+                                                         (uint8_t *)p_msg->adata,
+                                                         sizeof(p_msg->adata),
+                                                         p_msg->size,
+                                                         p_mode->mac_size));
+    while (offset < p_msg->size)
+    {
+        size_t size = p_msg->size - offset;
+
+        if ((chunk_size != 0) && (size > chunk_size))
+        {
+            size = chunk_size;
+        }
+        TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                          nrf_crypto_aead_update(&m_context, &p_in[offset], size, &p_out[offset]));
+        offset += size;
+    }
+
+    return nrf_crypto_aead_finalize(&m_context, p_mac);
+}
+
+
+/* Streams p_buf through the context in place and finalizes with p_mac. */
+static ret_code_t stream_in_place(message_t const      * p_msg,
+                                  stream_mode_t const  * p_mode,
+                                  nrf_crypto_operation_t operation,
+                                  uint8_t              * p_buf,
+                                  size_t                 chunk_size,
+                                  uint8_t              * p_mac)
+{
+    return stream(p_msg, p_mode, operation, p_buf, p_buf, chunk_size, p_mac);
+}
+
+
+/* A streamed encryption gives the one-shot ciphertext and MAC, and decrypts back, both in place
+ * and into a separate buffer. */
+static void streamed_matches_one_shot(void)
+{
+    static message_t msg;
+    uint8_t          buf[MESSAGE_MAX_SIZE];
+    uint8_t          out[MESSAGE_MAX_SIZE];
+    uint8_t          mac[MAC_MAX_SIZE];
+
+    for (size_t m = 0; m < ARRAY_SIZE(m_modes); m++)
+    {
+        for (size_t s = 0; s < ARRAY_SIZE(m_message_sizes); s++)
+        {
+            message_make(&msg, &m_modes[m], m_message_sizes[s]);
+
+            for (size_t c = 0; c < ARRAY_SIZE(m_chunk_sizes); c++)
+            {
+                memcpy(buf, msg.plaintext, msg.size);
+                memset(mac, 0, sizeof(mac));
+                TEST_ASSERT_EQUAL(NRF_SUCCESS, stream_in_place(&msg,
+                                                               &m_modes[m],
+                                                               NRF_CRYPTO_ENCRYPT,
+                                                               buf,
+                                                               m_chunk_sizes[c],
+                                                               mac));
+                TEST_ASSERT_EQUAL(0, memcmp(buf, msg.ciphertext, msg.size));
+                TEST_ASSERT_EQUAL(0, memcmp(mac, msg.mac, m_modes[m].mac_size));
+
+                memset(out, 0, sizeof(out));
+                TEST_ASSERT_EQUAL(NRF_SUCCESS, stream(&msg,
+                                                      &m_modes[m],
+                                                      NRF_CRYPTO_DECRYPT,
+                                                      buf,
+                                                      out,
+                                                      m_chunk_sizes[c],
+                                                      mac));
+                TEST_ASSERT_EQUAL(0, memcmp(out, msg.plaintext, msg.size));
+                TEST_ASSERT_EQUAL(0, memcmp(buf, msg.ciphertext, msg.size));
+
+                TEST_ASSERT_EQUAL(NRF_SUCCESS, stream_in_place(&msg,
+                                                               &m_modes[m],
+                                                               NRF_CRYPTO_DECRYPT,
+                                                               buf,
+                                                               m_chunk_sizes[c],
+                                                               mac));
+                TEST_ASSERT_EQUAL(0, memcmp(buf, msg.plaintext, msg.size));
+            }
+
+            // The one-shot call also works in place.
+            memcpy(buf, msg.ciphertext, msg.size);
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_crypt(&m_context,
+                                                                 NRF_CRYPTO_DECRYPT,
+                                                                 msg.nonce,
+                                                                 m_modes[m].nonce_size,
+                                                                 msg.adata,
+                                                                 sizeof(msg.adata),
+                                                                 buf,
+                                                                 msg.size,
+                                                                 buf,
+                                                                 msg.mac,
+                                                                 m_modes[m].mac_size));
+            TEST_ASSERT_EQUAL(0, memcmp(buf, msg.plaintext, msg.size));
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_uninit(&m_context));
+        }
+    }
+}
+
+
+/* A changed MAC or ciphertext fails the streamed and the one-shot decryption. */
+static void mac_mismatch(void)
+{
+    static message_t msg;
+    uint8_t          buf[MESSAGE_MAX_SIZE];
+    uint8_t          mac[MAC_MAX_SIZE];
+
+    for (size_t m = 0; m < ARRAY_SIZE(m_modes); m++)
+    {
+        stream_mode_t const * p_mode = &m_modes[m];
+
+        message_make(&msg, p_mode, 100);
+
+        memcpy(buf, msg.ciphertext, msg.size);
+        memcpy(mac, msg.mac, sizeof(mac));
+        mac[p_mode->mac_size - 1] ^= 0x01;
+        TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_AEAD_INVALID_MAC,
+                          stream_in_place(&msg, p_mode, NRF_CRYPTO_DECRYPT, buf, 48, mac));
+
+        memcpy(buf, msg.ciphertext, msg.size);
+        buf[msg.size - 1] ^= 0x80;
+        TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_AEAD_INVALID_MAC,
+                          stream_in_place(&msg, p_mode, NRF_CRYPTO_DECRYPT, buf, 48, msg.mac));
+
+        memcpy(buf, msg.ciphertext, msg.size);
+        msg.adata[0] ^= 0x01;
+        TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_AEAD_INVALID_MAC,
+                          stream_in_place(&msg, p_mode, NRF_CRYPTO_DECRYPT, buf, 48, msg.mac));
+        msg.adata[0] ^= 0x01;
+
+        memcpy(buf, msg.ciphertext, msg.size);
+        memcpy(mac, msg.mac, sizeof(mac));
+        mac[0] ^= 0x01;
+        TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_AEAD_INVALID_MAC,
+                          nrf_crypto_aead_crypt(&m_context,
+                                                NRF_CRYPTO_DECRYPT,
+                                                msg.nonce,
+                                                p_mode->nonce_size,
+                                                msg.adata,
+                                                sizeof(msg.adata),
+                                                buf,
+                                                msg.size,
+                                                buf,
+                                                mac,
+                                                p_mode->mac_size));
+
+        // The context is usable again after a failed stream.
+        memcpy(buf, msg.ciphertext, msg.size);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                          stream_in_place(&msg, p_mode, NRF_CRYPTO_DECRYPT, buf, 16, msg.mac));
+        TEST_ASSERT_EQUAL(0, memcmp(buf, msg.plaintext, msg.size));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_uninit(&m_context));
+    }
+}
+
+
+/* Only the last chunk may be partial, and a finalized stream takes no more data. */
+static void chunk_rules(void)
+{
+    static message_t msg;
+    uint8_t          buf[MESSAGE_MAX_SIZE];
+    uint8_t          mac[MAC_MAX_SIZE];
+
+    for (size_t m = 0; m < ARRAY_SIZE(m_modes); m++)
+    {
+        stream_mode_t const * p_mode = &m_modes[m];
+
+        message_make(&msg, p_mode, 64);
+        memcpy(buf, msg.plaintext, msg.size);
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_start(&m_context,
+                                                             NRF_CRYPTO_ENCRYPT,
+                                                             msg.nonce,
+                                                             p_mode->nonce_size,
+                                                             msg.adata,
+                                                             sizeof(msg.adata),
+                                                             17,
+                                                             p_mode->mac_size));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_update(&m_context, buf, 17, buf));
+        TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_INPUT_LENGTH,
+                          nrf_crypto_aead_update(&m_context, &buf[17], 16, &buf[17]));
+        // An empty chunk is accepted after a partial one.
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_update(&m_context, &buf[17], 0, &buf[17]));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_finalize(&m_context, mac));
+
+        TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_CONTEXT_NOT_INITIALIZED,
+                          nrf_crypto_aead_update(&m_context, buf, 16, buf));
+        TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_CONTEXT_NOT_INITIALIZED,
+                          nrf_crypto_aead_finalize(&m_context, mac));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_uninit(&m_context));
+    }
+}
+
+
+/* CCM authenticates the message length first, so the chunks must add up to it. */
+static void ccm_length_bound(void)
+{
+    static message_t msg;
+    uint8_t          buf[MESSAGE_MAX_SIZE];
+    uint8_t          mac[MAC_MAX_SIZE];
+
+    message_make(&msg, &m_modes[0], 32);
+    memcpy(buf, msg.plaintext, sizeof(buf));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_start(&m_context,
+                                                         NRF_CRYPTO_ENCRYPT,
+                                                         msg.nonce,
+                                                         m_modes[0].nonce_size,
+                                                         msg.adata,
+                                                         sizeof(msg.adata),
+                                                         msg.size,
+                                                         m_modes[0].mac_size));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_update(&m_context, buf, 32, buf));
+    TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_INPUT_LENGTH,
+                      nrf_crypto_aead_update(&m_context, &buf[32], 16, &buf[32]));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_finalize(&m_context, mac));
+    TEST_ASSERT_EQUAL(0, memcmp(mac, msg.mac, m_modes[0].mac_size));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_start(&m_context,
+                                                         NRF_CRYPTO_ENCRYPT,
+                                                         msg.nonce,
+                                                         m_modes[0].nonce_size,
+                                                         msg.adata,
+                                                         sizeof(msg.adata),
+                                                         msg.size,
+                                                         m_modes[0].mac_size));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_update(&m_context, buf, 16, buf));
+    TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_INPUT_LENGTH, nrf_crypto_aead_finalize(&m_context, mac));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_aead_uninit(&m_context));
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_init());
+
+    host_test_run("streamed_matches_one_shot", streamed_matches_one_shot);
+    host_test_run("mac_mismatch", mac_mismatch);
+    host_test_run("chunk_rules", chunk_rules);
+    host_test_run("ccm_length_bound", ccm_length_bound);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_uninit());
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host replacement of the Oberon ChaCha20-Poly1305 functions used by the nrf_crypto Oberon
+ *        backend.
+ *
+ * The Oberon library is only shipped for the device, so the functions are built on the mbed TLS
+ * ChaCha20-Poly1305 implementation. This tests the streaming glue of the backend, not Oberon.
+ * The mbed TLS state of the incremental functions is kept here, so only one incremental
+ * operation can be in progress at a time.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "ocrypto_chacha20_poly1305.h"
+#include "ocrypto_chacha20_poly1305_inc.h"
+#include "mbedtls/chachapoly.h"
+
+static mbedtls_chachapoly_context            m_stream;         /**< State of the incremental operation. */
+static ocrypto_chacha20_poly1305_ctx const * mp_stream_owner;  /**< Context the state belongs to. */
+static uint8_t                               m_stream_nonce[ocrypto_chacha20_poly1305_NONCE_BYTES_MAX];
+static uint8_t                               m_stream_key[ocrypto_chacha20_poly1305_KEY_BYTES];
+
+
+void ocrypto_chacha20_poly1305_encrypt_aad(uint8_t         tag[ocrypto_chacha20_poly1305_TAG_BYTES],
+                                           uint8_t       * c,
+                                           uint8_t const * m, size_t m_len,
+                                           uint8_t const * a, size_t a_len,
+                                           uint8_t const * n, size_t n_len,
+                                           uint8_t const   k[ocrypto_chacha20_poly1305_KEY_BYTES])
+{
+    mbedtls_chachapoly_context ctx;
+
+    TEST_ASSERT_EQUAL(ocrypto_chacha20_poly1305_NONCE_BYTES_MAX, n_len);
+
+    mbedtls_chachapoly_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_setkey(&ctx, k));
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_encrypt_and_tag(&ctx, m_len, n, a, a_len, m, c, tag));
+    mbedtls_chachapoly_free(&ctx);
+}
+
+
+int ocrypto_chacha20_poly1305_decrypt_aad(uint8_t const   tag[ocrypto_chacha20_poly1305_TAG_BYTES],
+                                          uint8_t       * m,
+                                          uint8_t const * c, size_t c_len,
+                                          uint8_t const * a, size_t a_len,
+                                          uint8_t const * n, size_t n_len,
+                                          uint8_t const   k[ocrypto_chacha20_poly1305_KEY_BYTES])
+{
+    mbedtls_chachapoly_context ctx;
+    int                        result;
+
+    TEST_ASSERT_EQUAL(ocrypto_chacha20_poly1305_NONCE_BYTES_MAX, n_len);
+
+    mbedtls_chachapoly_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_setkey(&ctx, k));
+    result = mbedtls_chachapoly_auth_decrypt(&ctx, c_len, n, a, a_len, tag, c, m);
+    mbedtls_chachapoly_free(&ctx);
+
+    return (result == 0) ? 0 : -1;
+}
+
+
+void ocrypto_chacha20_poly1305_init(ocrypto_chacha20_poly1305_ctx * ctx,
+                                    uint8_t const                 * n, size_t n_len,
+                                    uint8_t const                   k[ocrypto_chacha20_poly1305_KEY_BYTES])
+{
+    TEST_ASSERT_EQUAL(ocrypto_chacha20_poly1305_NONCE_BYTES_MAX, n_len);
+
+    memset(ctx, 0, sizeof(*ctx));
+    mp_stream_owner = ctx;
+    memcpy(m_stream_nonce, n, n_len);
+    memcpy(m_stream_key, k, sizeof(m_stream_key));
+
+    mbedtls_chachapoly_init(&m_stream);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_setkey(&m_stream, k));
+    // The direction only matters to the order of the MAC and the cipher; set it on the first data.
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_starts(&m_stream, n, MBEDTLS_CHACHAPOLY_ENCRYPT));
+}
+
+
+void ocrypto_chacha20_poly1305_update_aad(ocrypto_chacha20_poly1305_ctx * ctx,
+                                          uint8_t const                 * a, size_t a_len)
+{
+    TEST_ASSERT(ctx == mp_stream_owner);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_update_aad(&m_stream, a, a_len));
+    ctx->aad_len += a_len;
+}
+
+
+/* Checks that every call gets the nonce and the key the operation was started with. */
+static void stream_update(ocrypto_chacha20_poly1305_ctx * ctx,
+                          mbedtls_chachapoly_mode_t       mode,
+                          uint8_t                       * out,
+                          uint8_t const                 * in, size_t len,
+                          uint8_t const                 * n, size_t n_len,
+                          uint8_t const                 * k)
+{
+    TEST_ASSERT(ctx == mp_stream_owner);
+    TEST_ASSERT_EQUAL(ocrypto_chacha20_poly1305_NONCE_BYTES_MAX, n_len);
+    TEST_ASSERT_EQUAL(0, memcmp(n, m_stream_nonce, n_len));
+    TEST_ASSERT_EQUAL(0, memcmp(k, m_stream_key, sizeof(m_stream_key)));
+
+    if (ctx->msg_len == 0)
+    {
+        m_stream.mode = mode;
+    }
+    TEST_ASSERT(m_stream.mode == mode);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_update(&m_stream, len, in, out));
+    ctx->msg_len += len;
+}
+
+
+void ocrypto_chacha20_poly1305_update_enc(ocrypto_chacha20_poly1305_ctx * ctx,
+                                          uint8_t                       * c,
+                                          uint8_t const                 * m, size_t m_len,
+                                          uint8_t const                 * n, size_t n_len,
+                                          uint8_t const                   k[ocrypto_chacha20_poly1305_KEY_BYTES])
+{
+    stream_update(ctx, MBEDTLS_CHACHAPOLY_ENCRYPT, c, m, m_len, n, n_len, k);
+}
+
+
+void ocrypto_chacha20_poly1305_update_dec(ocrypto_chacha20_poly1305_ctx * ctx,
+                                          uint8_t                       * m,
+                                          uint8_t const                 * c, size_t c_len,
+                                          uint8_t const                 * n, size_t n_len,
+                                          uint8_t const                   k[ocrypto_chacha20_poly1305_KEY_BYTES])
+{
+    stream_update(ctx, MBEDTLS_CHACHAPOLY_DECRYPT, m, c, c_len, n, n_len, k);
+}
+
+
+void ocrypto_chacha20_poly1305_final_enc(ocrypto_chacha20_poly1305_ctx * ctx,
+                                         uint8_t                         tag[ocrypto_chacha20_poly1305_TAG_BYTES])
+{
+    TEST_ASSERT(ctx == mp_stream_owner);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_finish(&m_stream, tag));
+    mbedtls_chachapoly_free(&m_stream);
+    mp_stream_owner = NULL;
+}
+
+
+int ocrypto_chacha20_poly1305_final_dec(ocrypto_chacha20_poly1305_ctx * ctx,
+                                        uint8_t const                   tag[ocrypto_chacha20_poly1305_TAG_BYTES])
+{
+    uint8_t calculated[ocrypto_chacha20_poly1305_TAG_BYTES];
+
+    TEST_ASSERT(ctx == mp_stream_owner);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_finish(&m_stream, calculated));
+    mbedtls_chachapoly_free(&m_stream);
+    mp_stream_owner = NULL;
+
+    return (memcmp(calculated, tag, sizeof(calculated)) == 0) ? 0 : -1;
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the app_timer2 timer queue and expiry coalescing on a fake RTC driver, and a
+ *        benchmark of the queue with many running timers.
+ *
+ * The same program is built with the heap (app_timer2_heap) and the sorted list
+ * (app_timer2_sortlist) queue backends.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "app_timer.h"
+#include "drv_rtc_fake.h"
+
+#define TIMER_COUNT     60          /**< Number of timers. */
+#define PERIOD_MIN      1000        /**< Shortest period in the many-timer cases, in ticks. */
+#define PERIOD_MAX      33000       /**< Longest period in the many-timer cases, in ticks. */
+#define SLACK_SHIFT     3           /**< Slack in the coalescing case, as a right shift of the period. */
+#define RUN_TICKS       (600 * 32768UL) /**< Length of the many-timer runs: 10 minutes. */
+
+typedef struct
+{
+    uint64_t start;    /**< Fake RTC time when the timer was started. */
+    uint32_t period;   /**< Timeout or repeat period. */
+    uint32_t slack;    /**< Slack of the timer. */
+    uint32_t expiries; /**< Number of expiries since the start. */
+} timer_ctx_t;
+
+static app_timer_t m_timers[TIMER_COUNT];
+static timer_ctx_t m_ctx[TIMER_COUNT];
+static uint32_t    m_expiries;      /**< Number of expiries of all timers. */
+static uint32_t    m_expiry_order;  /**< Bit mask of the timers expired, in order, in the stop test. */
+
+
+/* Every expiry happens at the nominal time or up to the slack earlier, never later. */
+static void timeout_handler(void * p_context)
+{
+    timer_ctx_t * p_ctx   = p_context;
+    uint64_t      now     = drv_rtc_fake_ticks_get();
+    uint64_t      nominal;
+
+    p_ctx->expiries++;
+    nominal = p_ctx->start + (uint64_t)p_ctx->expiries * p_ctx->period;
+    TEST_ASSERT(now <= nominal);
+    TEST_ASSERT(now + p_ctx->slack >= nominal);
+    m_expiries++;
+    m_expiry_order = (m_expiry_order << 4) | (uint32_t)(p_ctx - m_ctx);
+}
+
+
+static void timer_start(uint32_t idx, app_timer_mode_t mode, uint32_t period, uint32_t slack)
+{
+    app_timer_id_t id = &m_timers[idx];
+
+    memset(&m_ctx[idx], 0, sizeof(m_ctx[idx]));
+    m_ctx[idx].start  = drv_rtc_fake_ticks_get();
+    m_ctx[idx].period = period;
+    m_ctx[idx].slack  = slack;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_timer_create(&id, mode, timeout_handler));
+    app_timer_slack_set(id, slack);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_timer_start(id, period, &m_ctx[idx]));
+}
+
+
+static void timers_stop(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_timer_stop_all());
+    m_expiries = 0;
+}
+
+
+/* Single-shot timers started at the same time, some with equal timeouts, expire exactly once
+ * each at their own time. */
+static void single_shot(void)
+{
+    uint32_t seed = 0x5eed0041;
+
+    for (uint32_t i = 0; i < TIMER_COUNT; i++)
+    {
+        uint32_t timeout = (i % 4 == 0) ? 1000 : 5 + host_test_rand(&seed) % 5000;
+        timer_start(i, APP_TIMER_MODE_SINGLE_SHOT, timeout, 0);
+    }
+    drv_rtc_fake_advance(6000);
+
+    for (uint32_t i = 0; i < TIMER_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL(1, m_ctx[i].expiries);
+    }
+    TEST_ASSERT_EQUAL(TIMER_COUNT, m_expiries);
+    timers_stop();
+}
+
+
+/* Stopping the timer that is programmed into the RTC and a queued one leaves the others
+ * running in order. */
+static void stop(void)
+{
+    m_expiry_order = 0;
+    timer_start(1, APP_TIMER_MODE_SINGLE_SHOT, 10, 0);
+    timer_start(2, APP_TIMER_MODE_SINGLE_SHOT, 20, 0);
+    timer_start(3, APP_TIMER_MODE_SINGLE_SHOT, 30, 0);
+    timer_start(4, APP_TIMER_MODE_SINGLE_SHOT, 40, 0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_timer_stop(&m_timers[1]));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_timer_stop(&m_timers[3]));
+    drv_rtc_fake_advance(100);
+
+    TEST_ASSERT_EQUAL(0x24, m_expiry_order);
+    timers_stop();
+}
+
+
+/* A repeated timer keeps its period across RTC counter overflows. */
+static void repeated_overflow(void)
+{
+    uint32_t const period = 32768;
+    uint32_t const count  = (APP_TIMER_MAX_CNT_VAL + 1) / period + 10;
+
+    timer_start(0, APP_TIMER_MODE_REPEATED, period, 0);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        drv_rtc_fake_advance(period);
+    }
+    TEST_ASSERT_EQUAL(count, m_ctx[0].expiries);
+    timers_stop();
+}
+
+
+/**
+ * @brief Function for running repeated timers with random periods.
+ *
+ * @param[in] slack_shift Slack as a right shift of the period, or 32 for none.
+ *
+ * @return Number of RTC wakeups.
+ */
+static uint32_t many_timers_run(uint32_t slack_shift)
+{
+    uint32_t                 seed    = 0x5eed0042;
+    uint32_t                 wakeups = drv_rtc_fake_wakeups_get();
+    app_timer_wakeup_stats_t stats;
+
+    app_timer_wakeup_stats_clear();
+    for (uint32_t i = 0; i < TIMER_COUNT; i++)
+    {
+        uint32_t period = PERIOD_MIN + host_test_rand(&seed) % (PERIOD_MAX - PERIOD_MIN);
+        timer_start(i, APP_TIMER_MODE_REPEATED, period,
+                    (slack_shift < 32) ? (period >> slack_shift) : 0);
+    }
+    drv_rtc_fake_advance(RUN_TICKS);
+    wakeups = drv_rtc_fake_wakeups_get() - wakeups;
+
+    app_timer_wakeup_stats_get(&stats);
+    TEST_ASSERT(stats.wakeups <= wakeups);
+    TEST_ASSERT(stats.wakeups + stats.coalesced <= m_expiries);
+    if (slack_shift >= 32)
+    {
+        TEST_ASSERT_EQUAL(0, stats.coalesced);
+    }
+
+    /* Expiries at a nominal time within the slack of the end of the run may happen early. */
+    for (uint32_t i = 0; i < TIMER_COUNT; i++)
+    {
+        uint32_t nominal = RUN_TICKS / m_ctx[i].period;
+        TEST_ASSERT((m_ctx[i].expiries == nominal) || (m_ctx[i].expiries == nominal + 1));
+    }
+    timers_stop();
+    return wakeups;
+}
+
+
+/* Slack of an eighth of the period lets most expiries share an RTC wakeup. */
+static void coalescing(void)
+{
+    uint32_t exact  = many_timers_run(32);
+    uint32_t slack  = many_timers_run(SLACK_SHIFT);
+
+    printf("    wakeups without slack: %u\n", (unsigned)exact);
+    printf("    wakeups with slack:    %u\n", (unsigned)slack);
+    TEST_ASSERT(slack < exact / 2);
+}
+
+
+static void benchmark(void)
+{
+    uint64_t start = host_test_time_ns();
+    uint32_t expiries;
+
+    (void)many_timers_run(32);
+    expiries = 0;
+    for (uint32_t i = 0; i < TIMER_COUNT; i++)
+    {
+        expiries += RUN_TICKS / m_ctx[i].period;
+    }
+    printf("    %u timers: %u ns per expiry\n", TIMER_COUNT,
+           (unsigned)((host_test_time_ns() - start) / expiries));
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_timer_init());
+
+    host_test_run("single_shot", single_shot);
+    host_test_run("stop", stop);
+    host_test_run("repeated_overflow", repeated_overflow);
+    host_test_run("coalescing", coalescing);
+    host_test_run("benchmark", benchmark);
+    return 0;
+}
@@ -0,0 +1,394 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of ble_advertising_fields_patch against a SoftDevice stub that, like the
+ *        SoftDevice, rejects an update during advertising that reuses a buffer in use.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_sdh_ble.h"
+#include "ble_advertising.h"
+
+#define ADV_HANDLE          0       /**< Handle the stub gives to the advertising set. */
+#define COMPANY_ID_ADV      0x0059  /**< Company identifier of the advertising data. */
+#define COMPANY_ID_SR       0x1234  /**< Company identifier of the scan response data. */
+#define MANUF_DATA_LEN      6       /**< Length of the manufacturer specific data, without the company identifier. */
+
+BLE_ADVERTISING_DEF(m_advertising);
+
+static bool               m_sd_advertising;     /**< The stub is advertising. */
+static ble_gap_adv_data_t m_sd_data;            /**< Buffers configured in the stub. */
+static uint8_t            m_sd_adv[BLE_GAP_ADV_SET_DATA_SIZE_MAX];      /**< Advertising data as configured. */
+static uint8_t            m_sd_sr[BLE_GAP_ADV_SET_DATA_SIZE_MAX];       /**< Scan response data as configured. */
+static uint32_t           m_sd_configure_cnt;   /**< Number of accepted data updates. */
+
+static uint8_t            m_adv_manuf[MANUF_DATA_LEN + 1];
+static uint8_t            m_sr_manuf[MANUF_DATA_LEN];
+
+
+/**@brief Function for checking that a buffer is not reused while advertising. */
+static bool buffer_reused(ble_data_t const * p_new, ble_data_t const * p_cur)
+{
+    return (p_new->len != 0) && (p_new->p_data == p_cur->p_data);
+}
+
+
+uint32_t sd_ble_gap_adv_set_configure(uint8_t                    * p_adv_handle,
+                                      ble_gap_adv_data_t   const * p_adv_data,
+                                      ble_gap_adv_params_t const * p_adv_params)
+{
+    if (*p_adv_handle == BLE_GAP_ADV_SET_HANDLE_NOT_SET)
+    {
+        *p_adv_handle = ADV_HANDLE;
+    }
+    else if (*p_adv_handle != ADV_HANDLE)
+    {
+        return BLE_ERROR_INVALID_ADV_HANDLE;
+    }
+
+    if (m_sd_advertising &&
+        (   (p_adv_params != NULL)
+         || buffer_reused(&p_adv_data->adv_data, &m_sd_data.adv_data)
+         || buffer_reused(&p_adv_data->scan_rsp_data, &m_sd_data.scan_rsp_data)))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    if (p_adv_data != NULL)
+    {
+        m_sd_data = *p_adv_data;
+        memcpy(m_sd_adv, p_adv_data->adv_data.p_data, p_adv_data->adv_data.len);
+        memcpy(m_sd_sr, p_adv_data->scan_rsp_data.p_data, p_adv_data->scan_rsp_data.len);
+        m_sd_configure_cnt++;
+    }
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_adv_start(uint8_t adv_handle, uint8_t conn_cfg_tag)
+{
+    TEST_ASSERT_EQUAL(ADV_HANDLE, adv_handle);
+    TEST_ASSERT(!m_sd_advertising);
+    m_sd_advertising = true;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gap_adv_stop(uint8_t adv_handle)
+{
+    TEST_ASSERT_EQUAL(ADV_HANDLE, adv_handle);
+    m_sd_advertising = false;
+    return NRF_SUCCESS;
+}
+
+
+/* Fields that need these are not encoded by the test. */
+uint32_t sd_ble_uuid_encode(ble_uuid_t const * p_uuid, uint8_t * p_uuid_le_len, uint8_t * p_uuid_le)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gap_addr_get(ble_gap_addr_t * p_addr)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gap_appearance_get(uint16_t * p_appearance)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gap_device_name_get(uint8_t * p_dev_name, uint16_t * p_len)
+{
+    TEST_ASSERT(false);
+}
+
+
+/**@brief Function for encoding advertising data with manufacturer specific data of a given length. */
+static void advdata_set(ble_advdata_t            * p_advdata,
+                        ble_advdata_manuf_data_t * p_manuf,
+                        uint16_t                   company_id,
+                        uint8_t                  * p_data,
+                        uint16_t                   len)
+{
+    memset(p_advdata, 0, sizeof(*p_advdata));
+    p_manuf->company_identifier      = company_id;
+    p_manuf->data.p_data             = p_data;
+    p_manuf->data.size               = len;
+    p_advdata->name_type             = BLE_ADVDATA_NO_NAME;
+    p_advdata->p_manuf_specific_data = p_manuf;
+}
+
+
+/**@brief Function for initializing the module and starting fast advertising. */
+static void advertising_start(void)
+{
+    ble_advertising_init_t   init;
+    ble_advdata_manuf_data_t adv_manuf;
+    ble_advdata_manuf_data_t sr_manuf;
+
+    memset(&init, 0, sizeof(init));
+    advdata_set(&init.advdata, &adv_manuf, COMPANY_ID_ADV, m_adv_manuf, MANUF_DATA_LEN);
+    init.advdata.flags = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    advdata_set(&init.srdata, &sr_manuf, COMPANY_ID_SR, m_sr_manuf, sizeof(m_sr_manuf));
+    init.config.ble_adv_fast_enabled  = true;
+    init.config.ble_adv_fast_interval = 64;
+    init.config.ble_adv_fast_timeout  = 1000;
+
+    m_sd_advertising = false;
+    memset(&m_advertising, 0, sizeof(m_advertising));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_init(&m_advertising, &init));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_start(&m_advertising, BLE_ADV_MODE_FAST));
+    TEST_ASSERT(m_sd_advertising);
+}
+
+
+/**@brief Function for checking the manufacturer specific data the stub was configured with. */
+static void sd_manuf_check(bool scan_rsp, uint16_t company_id, uint8_t const * p_expected)
+{
+    uint8_t const * p_data = scan_rsp ? m_sd_sr : m_sd_adv;
+    uint16_t        len    = scan_rsp ? m_sd_data.scan_rsp_data.len : m_sd_data.adv_data.len;
+    uint16_t        offset = 0;
+
+    TEST_ASSERT_EQUAL(MANUF_DATA_LEN + 2,
+                      ble_advdata_search(p_data, len, &offset,
+                                         BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA));
+    TEST_ASSERT_EQUAL(company_id, uint16_decode(&p_data[offset]));
+    TEST_ASSERT(memcmp(&p_data[offset + 2], p_expected, MANUF_DATA_LEN) == 0);
+}
+
+
+/* Patching one field while advertising hands new buffers for both the advertising data and the
+ * scan response data to the SoftDevice. The buffers in use are left untouched. */
+static void patch_swap(void)
+{
+    ble_advertising_field_t adv_field;
+    ble_advertising_field_t sr_field;
+    uint8_t                 value[2] = {0xA5, 0x5A};
+
+    memset(m_adv_manuf, 0x11, sizeof(m_adv_manuf));
+    memset(m_sr_manuf, 0x22, sizeof(m_sr_manuf));
+    advertising_start();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      ble_advertising_field_get(&m_advertising,
+                                                BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+                                                false, &adv_field));
+    TEST_ASSERT_EQUAL(MANUF_DATA_LEN + 2, adv_field.len);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      ble_advertising_field_get(&m_advertising,
+                                                BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+                                                true, &sr_field));
+
+    for (uint32_t round = 0; round < 4; round++)
+    {
+        ble_gap_adv_data_t const previous  = m_sd_data;
+        uint8_t                  adv_before[BLE_GAP_ADV_SET_DATA_SIZE_MAX];
+        uint8_t                  sr_before[BLE_GAP_ADV_SET_DATA_SIZE_MAX];
+        bool                     scan_rsp  = (round % 2) != 0;
+        ble_advertising_patch_t  patch     = {
+            .p_field = scan_rsp ? &sr_field : &adv_field,
+            .offset  = 2 + round,
+            .p_data  = value,
+            .len     = sizeof(value),
+        };
+
+        memcpy(adv_before, previous.adv_data.p_data, previous.adv_data.len);
+        memcpy(sr_before, previous.scan_rsp_data.p_data, previous.scan_rsp_data.len);
+        value[0]++;
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+        TEST_ASSERT(m_sd_data.adv_data.p_data != previous.adv_data.p_data);
+        TEST_ASSERT(m_sd_data.scan_rsp_data.p_data != previous.scan_rsp_data.p_data);
+        TEST_ASSERT(memcmp(adv_before, previous.adv_data.p_data, previous.adv_data.len) == 0);
+        TEST_ASSERT(memcmp(sr_before, previous.scan_rsp_data.p_data, previous.scan_rsp_data.len) == 0);
+
+        memcpy(scan_rsp ? &m_sr_manuf[round] : &m_adv_manuf[round], value, sizeof(value));
+        sd_manuf_check(false, COMPANY_ID_ADV, m_adv_manuf);
+        sd_manuf_check(true, COMPANY_ID_SR, m_sr_manuf);
+    }
+
+    /* Both fields at once, with one SoftDevice call. */
+    uint32_t const                configure_cnt = m_sd_configure_cnt;
+    uint8_t const                 all[MANUF_DATA_LEN] = {1, 2, 3, 4, 5, 6};
+    ble_advertising_patch_t const patches[] = {
+        {.p_field = &adv_field, .offset = 2, .p_data = all, .len = sizeof(all)},
+        {.p_field = &sr_field,  .offset = 2, .p_data = all, .len = sizeof(all)},
+    };
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_fields_patch(&m_advertising, patches, 2));
+    TEST_ASSERT_EQUAL(configure_cnt + 1, m_sd_configure_cnt);
+    sd_manuf_check(false, COMPANY_ID_ADV, all);
+    sd_manuf_check(true, COMPANY_ID_SR, all);
+}
+
+
+/* A handle that no longer matches the encoded data is rejected, and nothing is changed. */
+static void stale_handle(void)
+{
+    ble_advertising_field_t  field;
+    ble_advertising_field_t  wrong;
+    ble_advdata_t            advdata;
+    ble_advdata_manuf_data_t manuf;
+    uint8_t const            value = 0xEE;
+    ble_advertising_patch_t  patch = {.p_field = &field, .offset = 2, .p_data = &value, .len = 1};
+
+    memset(m_adv_manuf, 0x33, sizeof(m_adv_manuf));
+    memset(m_sr_manuf, 0x44, sizeof(m_sr_manuf));
+    advertising_start();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      ble_advertising_field_get(&m_advertising,
+                                                BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+                                                false, &field));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      ble_advertising_field_get(&m_advertising,
+                                                BLE_GAP_AD_TYPE_SERVICE_DATA, false, &wrong));
+
+    /* The handle points to the wrong AD type, or to the other data. */
+    uint32_t const configure_cnt = m_sd_configure_cnt;
+
+    wrong         = field;
+    wrong.ad_type = BLE_GAP_AD_TYPE_SERVICE_DATA;
+    patch.p_field = &wrong;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+
+    wrong          = field;
+    wrong.scan_rsp = true;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+
+    wrong        = field;
+    wrong.offset = m_advertising.adv_data.adv_data.len;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+
+    wrong.offset = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+    TEST_ASSERT_EQUAL(configure_cnt, m_sd_configure_cnt);
+
+    /* The field was removed. Encoding twice brings back the first buffer, which still holds the
+     * bytes of the field beyond the encoded data. */
+    memset(&advdata, 0, sizeof(advdata));
+    advdata.name_type = BLE_ADVDATA_NO_NAME;
+    advdata.flags     = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_advdata_update(&m_advertising, &advdata, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_advdata_update(&m_advertising, &advdata, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      ble_advertising_field_get(&m_advertising,
+                                                BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+                                                false, &wrong));
+
+    patch.p_field = &field;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+
+    /* The field got longer when the data was encoded again. */
+    advdata_set(&advdata, &manuf, COMPANY_ID_ADV, m_adv_manuf, MANUF_DATA_LEN + 1);
+    advdata.flags = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_advdata_update(&m_advertising, &advdata, NULL));
+
+    ble_gap_adv_data_t const current = m_sd_data;
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+    TEST_ASSERT_EQUAL(configure_cnt + 3, m_sd_configure_cnt);
+    TEST_ASSERT(memcmp(&current, &m_advertising.adv_data, sizeof(current)) == 0);
+
+    /* A new handle works. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      ble_advertising_field_get(&m_advertising,
+                                                BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+                                                false, &field));
+    TEST_ASSERT_EQUAL(MANUF_DATA_LEN + 3, field.len);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_fields_patch(&m_advertising, &patch, 1));
+    TEST_ASSERT_EQUAL(value, m_sd_adv[field.offset + 2]);
+}
+
+
+/* A patch that does not fit within its field is rejected, also when it comes after a valid one,
+ * and nothing is changed. */
+static void out_of_field(void)
+{
+    ble_advertising_field_t field;
+    uint8_t const           value[MANUF_DATA_LEN + 2] = {0};
+
+    memset(m_adv_manuf, 0x55, sizeof(m_adv_manuf));
+    memset(m_sr_manuf, 0x66, sizeof(m_sr_manuf));
+    advertising_start();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      ble_advertising_field_get(&m_advertising,
+                                                BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA,
+                                                true, &field));
+
+    uint32_t const          configure_cnt = m_sd_configure_cnt;
+    ble_advertising_patch_t patches[2]    = {
+        {.p_field = &field, .offset = 2, .p_data = value, .len = 1},
+        {.p_field = &field, .offset = 0, .p_data = value, .len = field.len + 1},
+    };
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, ble_advertising_fields_patch(&m_advertising, &patches[1], 1));
+
+    patches[1].offset = field.len;
+    patches[1].len    = 1;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, ble_advertising_fields_patch(&m_advertising, patches, 2));
+
+    patches[1].offset = 1;
+    patches[1].len    = field.len;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, ble_advertising_fields_patch(&m_advertising, patches, 2));
+    TEST_ASSERT_EQUAL(configure_cnt, m_sd_configure_cnt);
+    sd_manuf_check(true, COMPANY_ID_SR, m_sr_manuf);
+
+    /* The whole field, company identifier included, fits. */
+    patches[1].offset = 0;
+    patches[1].len    = field.len;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_advertising_fields_patch(&m_advertising, &patches[1], 1));
+    TEST_ASSERT_EQUAL(configure_cnt + 1, m_sd_configure_cnt);
+    TEST_ASSERT_EQUAL(0, uint16_decode(&m_sd_sr[field.offset]));
+}
+
+
+int main(void)
+{
+    host_test_run("patch_swap", patch_swap);
+    host_test_run("stale_handle", stale_handle);
+    host_test_run("out_of_field", out_of_field);
+    return 0;
+}
@@ -0,0 +1,534 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the ble_db_discovery cache: a miss runs a full discovery and stores it, a hit
+ *        replays it without GATT procedures, and a changed Database Hash forces a rediscovery.
+ *
+ * The peer is a GATT server stub answering the SoftDevice calls from a table of attributes. FDS
+ * is replaced by the RAM fake.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "ble_db_discovery.h"
+#include "fds.h"
+#include "fds_fake.h"
+
+#define CONN_HANDLE     1       /**< Handle of the simulated connection. */
+#define PEER_KEY        3       /**< Cache key of the simulated peer. */
+#define OTHER_PEER_KEY  4       /**< Cache key of a peer never discovered. */
+#define SRV_UUID        0x180D  /**< Service present at the peer. */
+#define ABSENT_UUID     0x180F  /**< Service not present at the peer. */
+#define CHAR_CNT        2       /**< Characteristics of the service. */
+#define HASH_HANDLE     0x0005  /**< Handle of the Database Hash value. */
+#define EVTS_MAX        8       /**< Number of discovery events recorded. */
+
+NRF_BLE_GQ_DEF(m_gq, 1, 4);
+
+/**@brief Layout of the database of the peer. */
+typedef struct
+{
+    uint16_t srv_start;                 /**< Service declaration handle. */
+    uint16_t srv_end;                   /**< Last handle of the service. */
+    uint16_t char_decl[CHAR_CNT];       /**< Characteristic declaration handles. */
+    uint16_t char_uuid[CHAR_CNT];
+    uint16_t cccd;                      /**< CCCD of the first characteristic. */
+    bool     has_hash;                  /**< The peer has a Database Hash characteristic. */
+    uint8_t  hash[BLE_DB_DISCOVERY_DB_HASH_LEN];
+} peer_db_t;
+
+typedef enum
+{
+    REQ_NONE,
+    REQ_SRV,
+    REQ_CHAR,
+    REQ_DESC,
+    REQ_HASH,
+} req_t;
+
+static peer_db_t const m_db_v1 =
+{
+    .srv_start = 0x0010, .srv_end = 0x0015,
+    .char_decl = {0x0011, 0x0014}, .char_uuid = {0x2A37, 0x2A38},
+    .cccd      = 0x0013,
+    .has_hash  = true,
+    .hash      = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                  0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10},
+};
+
+/* The service moved, so the hash changed. */
+static peer_db_t const m_db_v2 =
+{
+    .srv_start = 0x0020, .srv_end = 0x0025,
+    .char_decl = {0x0021, 0x0024}, .char_uuid = {0x2A37, 0x2A38},
+    .cccd      = 0x0023,
+    .has_hash  = true,
+    .hash      = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                  0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x11},
+};
+
+static ble_db_discovery_t       m_disc;
+static peer_db_t                m_db;              /**< Database of the peer. */
+static req_t                    m_req;             /**< Request waiting for the peer's answer. */
+static ble_gattc_handle_range_t m_req_range;
+static uint16_t                 m_req_uuid;
+static uint32_t                 m_gatt_procedures; /**< Requests other than the hash read. */
+static ble_db_discovery_evt_t   m_evts[EVTS_MAX];
+static uint32_t                 m_evt_cnt;
+static fds_evt_id_t             m_fds_evt_id;      /**< Last FDS write event of the cache file. */
+static uint16_t                 m_fds_rec_key;     /**< Record key in that event. */
+
+
+static void req_set(req_t req, uint16_t conn_handle)
+{
+    TEST_ASSERT_EQUAL(CONN_HANDLE, conn_handle);
+    TEST_ASSERT_EQUAL(REQ_NONE, m_req);
+    m_req = req;
+}
+
+
+uint32_t sd_ble_gattc_primary_services_discover(uint16_t           conn_handle,
+                                                uint16_t           start_handle,
+                                                ble_uuid_t const * p_srvc_uuid)
+{
+    req_set(REQ_SRV, conn_handle);
+    m_req_range.start_handle = start_handle;
+    m_req_uuid               = p_srvc_uuid->uuid;
+    m_gatt_procedures++;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gattc_characteristics_discover(uint16_t                         conn_handle,
+                                               ble_gattc_handle_range_t const * p_handle_range)
+{
+    req_set(REQ_CHAR, conn_handle);
+    m_req_range = *p_handle_range;
+    m_gatt_procedures++;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gattc_descriptors_discover(uint16_t                         conn_handle,
+                                           ble_gattc_handle_range_t const * p_handle_range)
+{
+    req_set(REQ_DESC, conn_handle);
+    m_req_range = *p_handle_range;
+    m_gatt_procedures++;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gattc_char_value_by_uuid_read(uint16_t                         conn_handle,
+                                              ble_uuid_t const               * p_uuid,
+                                              ble_gattc_handle_range_t const * p_handle_range)
+{
+    req_set(REQ_HASH, conn_handle);
+    TEST_ASSERT_EQUAL(0x2B2A, p_uuid->uuid);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gattc_read(uint16_t conn_handle, uint16_t handle, uint16_t offset)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gattc_write(uint16_t conn_handle, ble_gattc_write_params_t const * p_write_params)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params)
+{
+    TEST_ASSERT(false);
+}
+
+
+static bool in_range(uint16_t handle)
+{
+    return (handle >= m_req_range.start_handle) && (handle <= m_req_range.end_handle);
+}
+
+
+/* Builds the answer of the peer to the request in m_req. */
+static void rsp_build(ble_evt_t * p_evt)
+{
+    ble_gattc_evt_t * p_gattc = &p_evt->evt.gattc_evt;
+    uint16_t          cnt     = 0;
+
+    p_gattc->conn_handle = CONN_HANDLE;
+    p_gattc->gatt_status = BLE_GATT_STATUS_SUCCESS;
+
+    switch (m_req)
+    {
+        case REQ_SRV:
+            p_evt->header.evt_id = BLE_GATTC_EVT_PRIM_SRVC_DISC_RSP;
+            if ((m_req_uuid == SRV_UUID) && (m_db.srv_start >= m_req_range.start_handle))
+            {
+                ble_gattc_service_t * p_srv = &p_gattc->params.prim_srvc_disc_rsp.services[0];
+
+                p_srv->uuid.type                 = BLE_UUID_TYPE_BLE;
+                p_srv->uuid.uuid                 = SRV_UUID;
+                p_srv->handle_range.start_handle = m_db.srv_start;
+                p_srv->handle_range.end_handle   = m_db.srv_end;
+                cnt = 1;
+            }
+            p_gattc->params.prim_srvc_disc_rsp.count = cnt;
+            break;
+
+        case REQ_CHAR:
+            p_evt->header.evt_id = BLE_GATTC_EVT_CHAR_DISC_RSP;
+            for (uint32_t i = 0; i < CHAR_CNT; i++)
+            {
+                if (in_range(m_db.char_decl[i]))
+                {
+                    ble_gattc_char_t * p_char = &p_gattc->params.char_disc_rsp.chars[cnt++];
+
+                    memset(p_char, 0, sizeof(*p_char));
+                    p_char->uuid.type    = BLE_UUID_TYPE_BLE;
+                    p_char->uuid.uuid    = m_db.char_uuid[i];
+                    p_char->handle_decl  = m_db.char_decl[i];
+                    p_char->handle_value = m_db.char_decl[i] + 1;
+                }
+            }
+            p_gattc->params.char_disc_rsp.count = cnt;
+            break;
+
+        case REQ_DESC:
+            p_evt->header.evt_id = BLE_GATTC_EVT_DESC_DISC_RSP;
+            if (in_range(m_db.cccd))
+            {
+                p_gattc->params.desc_disc_rsp.descs[0].handle    = m_db.cccd;
+                p_gattc->params.desc_disc_rsp.descs[0].uuid.type = BLE_UUID_TYPE_BLE;
+                p_gattc->params.desc_disc_rsp.descs[0].uuid.uuid = BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG;
+                cnt = 1;
+            }
+            p_gattc->params.desc_disc_rsp.count = cnt;
+            break;
+
+        case REQ_HASH:
+        {
+            ble_gattc_evt_char_val_by_uuid_read_rsp_t * p_rsp =
+                &p_gattc->params.char_val_by_uuid_read_rsp;
+
+            p_evt->header.evt_id = BLE_GATTC_EVT_CHAR_VAL_BY_UUID_READ_RSP;
+            if (m_db.has_hash)
+            {
+                p_rsp->value_len       = BLE_DB_DISCOVERY_DB_HASH_LEN;
+                p_rsp->handle_value[0] = LSB_16(HASH_HANDLE);
+                p_rsp->handle_value[1] = MSB_16(HASH_HANDLE);
+                memcpy(&p_rsp->handle_value[2], m_db.hash, BLE_DB_DISCOVERY_DB_HASH_LEN);
+                cnt = 1;
+            }
+            p_rsp->count = cnt;
+        } break;
+
+        default:
+            TEST_ASSERT(false);
+            break;
+    }
+
+    if (cnt == 0)
+    {
+        p_gattc->gatt_status = BLE_GATT_STATUS_ATTERR_ATTRIBUTE_NOT_FOUND;
+    }
+}
+
+
+/* Lets the peer answer until the discovery has nothing more to ask. */
+static void peer_run(void)
+{
+    union
+    {
+        ble_evt_t evt;
+        uint8_t   raw[sizeof(ble_evt_t) + 64];
+    } rsp;
+
+    while (m_req != REQ_NONE)
+    {
+        memset(&rsp, 0, sizeof(rsp));
+        rsp_build(&rsp.evt);
+        m_req = REQ_NONE;
+
+        ble_db_discovery_on_ble_evt(&rsp.evt, &m_disc);
+        nrf_ble_gq_on_ble_evt(&rsp.evt, &m_gq);
+    }
+}
+
+
+static void disconnect(void)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id           = BLE_GAP_EVT_DISCONNECTED;
+    evt.evt.gap_evt.conn_handle = CONN_HANDLE;
+
+    ble_db_discovery_on_ble_evt(&evt, &m_disc);
+    nrf_ble_gq_on_ble_evt(&evt, &m_gq);
+}
+
+
+static void db_disc_evt_handler(ble_db_discovery_evt_t * p_evt)
+{
+    TEST_ASSERT(m_evt_cnt < EVTS_MAX);
+    m_evts[m_evt_cnt++] = *p_evt;
+}
+
+
+static void fds_evt_handler(fds_evt_t const * p_evt)
+{
+    if (   ((p_evt->id == FDS_EVT_WRITE) || (p_evt->id == FDS_EVT_UPDATE))
+        && (p_evt->write.file_id == BLE_DB_DISCOVERY_CACHE_FILE_ID))
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, p_evt->result);
+        m_fds_evt_id  = p_evt->id;
+        m_fds_rec_key = p_evt->write.record_key;
+    }
+}
+
+
+/* Initializes the module with the services to discover. FDS keeps its records. */
+static void setup_with(uint16_t const * p_uuids, uint32_t uuid_cnt)
+{
+    static bool             initialized;
+    ble_db_discovery_init_t init;
+    ble_uuid_t              uuid = {.type = BLE_UUID_TYPE_BLE};
+
+    if (!initialized)
+    {
+        fds_fake_reset();
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, fds_register(fds_evt_handler));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, fds_init());
+        (void) fds_fake_process();
+        initialized = true;
+    }
+
+    memset(&m_disc, 0, sizeof(m_disc));
+    m_disc.conn_handle = BLE_CONN_HANDLE_INVALID;
+    (void) ble_db_discovery_close(&m_disc);
+
+    memset(&init, 0, sizeof(init));
+    init.evt_handler  = db_disc_evt_handler;
+    init.p_gatt_queue = &m_gq;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_db_discovery_init(&init));
+
+    for (uint32_t i = 0; i < uuid_cnt; i++)
+    {
+        uuid.uuid = p_uuids[i];
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_db_discovery_evt_register(&uuid));
+    }
+}
+
+
+static void setup(void)
+{
+    static uint16_t const uuids[] = {SRV_UUID, ABSENT_UUID};
+
+    setup_with(uuids, ARRAY_SIZE(uuids));
+}
+
+
+/* Connects to the peer with database p_db, runs the cached discovery and returns the number of
+ * GATT procedures it took besides the hash read. */
+static uint32_t connect(peer_db_t const * p_db, uint16_t peer_key)
+{
+    m_db              = *p_db;
+    m_evt_cnt         = 0;
+    m_gatt_procedures = 0;
+    m_fds_evt_id      = FDS_EVT_INIT;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_db_discovery_cached_start(&m_disc, CONN_HANDLE, peer_key));
+    TEST_ASSERT_EQUAL(REQ_HASH, m_req);
+    peer_run();
+
+    return m_gatt_procedures;
+}
+
+
+/* The events of a discovery of database p_db: the service with its characteristics and CCCD,
+ * the absent service, and the instance available again. */
+static void evts_check(peer_db_t const * p_db)
+{
+    ble_gatt_db_srv_t const * p_srv = &m_evts[0].params.discovered_db;
+
+    TEST_ASSERT_EQUAL(3, m_evt_cnt);
+
+    TEST_ASSERT_EQUAL(BLE_DB_DISCOVERY_COMPLETE, m_evts[0].evt_type);
+    TEST_ASSERT_EQUAL(CONN_HANDLE, m_evts[0].conn_handle);
+    TEST_ASSERT_EQUAL(SRV_UUID, p_srv->srv_uuid.uuid);
+    TEST_ASSERT_EQUAL(p_db->srv_start, p_srv->handle_range.start_handle);
+    TEST_ASSERT_EQUAL(p_db->srv_end, p_srv->handle_range.end_handle);
+    TEST_ASSERT_EQUAL(CHAR_CNT, p_srv->char_count);
+    for (uint32_t i = 0; i < CHAR_CNT; i++)
+    {
+        TEST_ASSERT_EQUAL(p_db->char_uuid[i], p_srv->charateristics[i].characteristic.uuid.uuid);
+        TEST_ASSERT_EQUAL(p_db->char_decl[i] + 1,
+                          p_srv->charateristics[i].characteristic.handle_value);
+    }
+    TEST_ASSERT_EQUAL(p_db->cccd, p_srv->charateristics[0].cccd_handle);
+    TEST_ASSERT_EQUAL(BLE_GATT_HANDLE_INVALID, p_srv->charateristics[1].cccd_handle);
+
+    TEST_ASSERT_EQUAL(BLE_DB_DISCOVERY_SRV_NOT_FOUND, m_evts[1].evt_type);
+    TEST_ASSERT_EQUAL(ABSENT_UUID, m_evts[1].params.discovered_db.srv_uuid.uuid);
+
+    TEST_ASSERT_EQUAL(BLE_DB_DISCOVERY_AVAILABLE, m_evts[2].evt_type);
+}
+
+
+/* The first connection misses and discovers, the second one is served from the cache. */
+static void miss_then_hit(void)
+{
+    fds_stat_t stat;
+
+    setup();
+
+    TEST_ASSERT(connect(&m_db_v1, PEER_KEY) > 0);
+    evts_check(&m_db_v1);
+
+    /* The record is written from the module's own buffer, after the discovery. */
+    TEST_ASSERT_EQUAL(1, fds_fake_process());
+    TEST_ASSERT_EQUAL(FDS_EVT_WRITE, m_fds_evt_id);
+    TEST_ASSERT_EQUAL(PEER_KEY + 1, m_fds_rec_key);
+    disconnect();
+
+    TEST_ASSERT_EQUAL(0, connect(&m_db_v1, PEER_KEY));
+    evts_check(&m_db_v1);
+    TEST_ASSERT_EQUAL(0, fds_fake_process());
+    disconnect();
+
+    /* Another peer has no record. */
+    TEST_ASSERT(connect(&m_db_v1, OTHER_PEER_KEY) > 0);
+    evts_check(&m_db_v1);
+    TEST_ASSERT_EQUAL(1, fds_fake_process());
+    TEST_ASSERT_EQUAL(OTHER_PEER_KEY + 1, m_fds_rec_key);
+    disconnect();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_db_discovery_cache_invalidate(OTHER_PEER_KEY));
+    (void) fds_fake_process();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, fds_stat(&stat));
+    TEST_ASSERT_EQUAL(1, stat.valid_records);
+}
+
+
+/* A changed Database Hash makes the cached record stale: the peer is discovered again and the
+ * record replaced. */
+static void hash_mismatch(void)
+{
+    setup();
+
+    TEST_ASSERT(connect(&m_db_v2, PEER_KEY) > 0);
+    evts_check(&m_db_v2);
+    TEST_ASSERT_EQUAL(1, fds_fake_process());
+    TEST_ASSERT_EQUAL(FDS_EVT_UPDATE, m_fds_evt_id);
+    TEST_ASSERT_EQUAL(PEER_KEY + 1, m_fds_rec_key);
+    disconnect();
+
+    TEST_ASSERT_EQUAL(0, connect(&m_db_v2, PEER_KEY));
+    evts_check(&m_db_v2);
+    disconnect();
+
+    /* Same hash, but the application registered other services. */
+    {
+        static uint16_t const more[]  = {SRV_UUID, ABSENT_UUID, 0x1810};
+        static uint16_t const fewer[] = {SRV_UUID};
+
+        setup_with(more, ARRAY_SIZE(more));
+        TEST_ASSERT(connect(&m_db_v2, PEER_KEY) > 0);
+        TEST_ASSERT_EQUAL(4, m_evt_cnt);
+        TEST_ASSERT_EQUAL(1, fds_fake_process());
+        disconnect();
+
+        setup_with(fewer, ARRAY_SIZE(fewer));
+        TEST_ASSERT(connect(&m_db_v2, PEER_KEY) > 0);
+        TEST_ASSERT_EQUAL(2, m_evt_cnt);
+        TEST_ASSERT_EQUAL(1, fds_fake_process());
+        disconnect();
+    }
+}
+
+
+/* A peer without a Database Hash is served from the cache until the record is invalidated. */
+static void no_hash_invalidate(void)
+{
+    peer_db_t db = m_db_v1;
+
+    db.has_hash = false;
+
+    setup();
+
+    TEST_ASSERT(connect(&db, PEER_KEY) > 0);
+    evts_check(&db);
+    (void) fds_fake_process();
+    disconnect();
+
+    TEST_ASSERT_EQUAL(0, connect(&db, PEER_KEY));
+    evts_check(&db);
+    disconnect();
+
+    /* A record of a peer with a hash does not match one without. */
+    TEST_ASSERT(connect(&m_db_v1, PEER_KEY) > 0);
+    evts_check(&m_db_v1);
+    (void) fds_fake_process();
+    disconnect();
+
+    TEST_ASSERT_EQUAL(0, connect(&m_db_v1, PEER_KEY));
+    disconnect();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_db_discovery_cache_invalidate(PEER_KEY));
+    TEST_ASSERT_EQUAL(1, fds_fake_process());
+
+    TEST_ASSERT(connect(&m_db_v1, PEER_KEY) > 0);
+    evts_check(&m_db_v1);
+    (void) fds_fake_process();
+    disconnect();
+}
+
+
+int main(void)
+{
+    host_test_run("miss_then_hit", miss_then_hit);
+    host_test_run("hash_mismatch", hash_mismatch);
+    host_test_run("no_hash_invalidate", no_hash_invalidate);
+    return 0;
+}
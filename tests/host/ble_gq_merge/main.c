@@ -0,0 +1,346 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the Write Command merging in nrf_ble_gq against a SoftDevice stub that
+ *        reports busy on demand.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "app_util_platform.h"
+#include "nrf_ble_gq.h"
+
+#define CONN_HANDLE         0       /**< Handle of the simulated connection. */
+#define ATTR_HANDLE         0x10    /**< Attribute written by the test. */
+#define QUEUE_SIZE          4       /**< Number of requests the queue can hold. */
+#define WRITES_MAX          16      /**< Number of writes the stub can record. */
+
+NRF_BLE_GQ_DEF(m_gq, 1, QUEUE_SIZE);
+
+/**@brief Write passed to the SoftDevice stub. */
+typedef struct
+{
+    uint8_t  write_op;
+    uint16_t handle;
+    uint8_t  value;
+} sd_write_t;
+
+static bool       m_sd_busy;            /**< The stub rejects writes with NRF_ERROR_BUSY. */
+static sd_write_t m_writes[WRITES_MAX]; /**< Writes accepted by the stub, in order. */
+static uint32_t   m_write_cnt;
+
+static uint32_t   m_region_exits;       /**< Number of critical regions left. */
+static uint32_t   m_irq_countdown;      /**< Critical region exits left until the interrupt. */
+static void    (* m_irq_handler)(void);
+
+
+/* The program is single-threaded. An interrupt that became pending inside a critical region is
+ * simulated by calling its handler when the region is left. */
+void app_util_critical_region_enter(uint8_t * p_nested)
+{
+    if (p_nested != NULL)
+    {
+        *p_nested = 0;
+    }
+}
+
+
+void app_util_critical_region_exit(uint8_t nested)
+{
+    m_region_exits++;
+    if ((m_irq_countdown > 0) && (--m_irq_countdown == 0))
+    {
+        m_irq_handler();
+    }
+}
+
+
+uint32_t sd_ble_gattc_write(uint16_t conn_handle, ble_gattc_write_params_t const * p_write_params)
+{
+    TEST_ASSERT_EQUAL(CONN_HANDLE, conn_handle);
+
+    if (m_sd_busy)
+    {
+        return NRF_ERROR_BUSY;
+    }
+
+    TEST_ASSERT(m_write_cnt < WRITES_MAX);
+    TEST_ASSERT_EQUAL(1, p_write_params->len);
+
+    m_writes[m_write_cnt].write_op = p_write_params->write_op;
+    m_writes[m_write_cnt].handle   = p_write_params->handle;
+    m_writes[m_write_cnt].value    = p_write_params->p_value[0];
+    m_write_cnt++;
+    return NRF_SUCCESS;
+}
+
+
+/* Requests other than writes are not used by the test. */
+uint32_t sd_ble_gattc_read(uint16_t conn_handle, uint16_t handle, uint16_t offset)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gattc_primary_services_discover(uint16_t           conn_handle,
+                                                uint16_t           start_handle,
+                                                ble_uuid_t const * p_srvc_uuid)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gattc_characteristics_discover(uint16_t                         conn_handle,
+                                               ble_gattc_handle_range_t const * p_handle_range)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gattc_descriptors_discover(uint16_t                         conn_handle,
+                                           ble_gattc_handle_range_t const * p_handle_range)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gattc_char_value_by_uuid_read(uint16_t                         conn_handle,
+                                              ble_uuid_t const               * p_uuid,
+                                              ble_gattc_handle_range_t const * p_handle_range)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params)
+{
+    TEST_ASSERT(false);
+}
+
+
+static void req_error_handler(uint32_t nrf_error, void * p_context, uint16_t conn_handle)
+{
+    TEST_ASSERT(false);
+}
+
+
+static ret_code_t write_add(uint8_t write_op, uint16_t handle, uint8_t value)
+{
+    nrf_ble_gq_req_t req;
+
+    memset(&req, 0, sizeof(req));
+    req.type                         = NRF_BLE_GQ_REQ_GATTC_WRITE;
+    req.error_handler.cb             = req_error_handler;
+    req.params.gattc_write.write_op  = write_op;
+    req.params.gattc_write.handle    = handle;
+    req.params.gattc_write.len       = 1;
+    req.params.gattc_write.p_value   = &value;
+    return nrf_ble_gq_item_add(&m_gq, &req, CONN_HANDLE);
+}
+
+
+/* The SoftDevice is free again; every GATTC event lets the queue submit one request. */
+static void queue_drain(void)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id              = BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE;
+    evt.evt.gattc_evt.conn_handle  = CONN_HANDLE;
+
+    m_sd_busy = false;
+    for (uint32_t i = 0; i < QUEUE_SIZE; i++)
+    {
+        nrf_ble_gq_on_ble_evt(&evt, &m_gq);
+    }
+}
+
+
+static void write_check(uint32_t idx, uint8_t write_op, uint16_t handle, uint8_t value)
+{
+    TEST_ASSERT(idx < m_write_cnt);
+    TEST_ASSERT_EQUAL(write_op, m_writes[idx].write_op);
+    TEST_ASSERT_EQUAL(handle, m_writes[idx].handle);
+    TEST_ASSERT_EQUAL(value, m_writes[idx].value);
+}
+
+
+/* A Write Command replaces only a queued Write Command to the same handle that is last in the
+ * queue. The replaced request keeps its position and its memory object is freed. The pool has
+ * one element more than the queue, for the new request of a merge, so a leaked memory object
+ * fails a later round. */
+static void write_cmd_merge(void)
+{
+    nrf_ble_gq_conn_stats_t stats;
+
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        m_write_cnt = 0;
+        m_sd_busy   = true;
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 1));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 2));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_REQ, ATTR_HANDLE, 3));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 4));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE + 1, 5));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE + 1, 6));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE + 1, 7));
+        TEST_ASSERT_EQUAL(0, m_write_cnt);
+
+        queue_drain();
+        TEST_ASSERT_EQUAL(4, m_write_cnt);
+        write_check(0, BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE,     2);
+        write_check(1, BLE_GATT_OP_WRITE_REQ, ATTR_HANDLE,     3);
+        write_check(2, BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE,     4);
+        write_check(3, BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE + 1, 7);
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_ble_gq_conn_stats_get(&m_gq, CONN_HANDLE, &stats));
+        TEST_ASSERT_EQUAL(4 * (round + 1), stats.queued);
+        TEST_ASSERT_EQUAL(3 * (round + 1), stats.merged);
+        TEST_ASSERT_EQUAL(0, stats.depth);
+        TEST_ASSERT_EQUAL(QUEUE_SIZE, stats.depth_max);
+    }
+}
+
+
+/* A Write Command to an idle SoftDevice is sent without queuing and is never merged. */
+static void write_cmd_direct(void)
+{
+    nrf_ble_gq_conn_stats_t stats;
+
+    m_write_cnt = 0;
+    m_sd_busy   = false;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 8));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 9));
+    TEST_ASSERT_EQUAL(2, m_write_cnt);
+    write_check(0, BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 8);
+    write_check(1, BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 9);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_ble_gq_conn_stats_get(&m_gq, CONN_HANDLE, &stats));
+    TEST_ASSERT_EQUAL(2, stats.direct);
+}
+
+
+/* The SoftDevice sends the front request and the application queues a write to another handle,
+ * from interrupt context. */
+static void irq_pop_push(void)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id              = BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE;
+    evt.evt.gattc_evt.conn_handle  = CONN_HANDLE;
+
+    m_sd_busy = false;
+    nrf_ble_gq_on_ble_evt(&evt, &m_gq);
+    m_sd_busy = true;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE + 1, 0x40));
+}
+
+
+/* A pop and a push from interrupt context at every critical region exit of a merging
+ * nrf_ble_gq_item_add(). Whether or not the Write Command is merged, no request is lost or sent
+ * twice, the last value written to the handle is the new one, and no memory object leaks, which
+ * would exhaust the pool within a few iterations. */
+static void write_cmd_merge_interrupted(void)
+{
+    uint32_t exits;
+
+    // Count the critical regions of an uninterrupted merge.
+    m_write_cnt = 0;
+    m_sd_busy   = true;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 1));
+    exits = m_region_exits;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 2));
+    exits = m_region_exits - exits;
+    queue_drain();
+    TEST_ASSERT_EQUAL(1, m_write_cnt);
+    TEST_ASSERT(exits > 0);
+
+    m_irq_handler = irq_pop_push;
+    for (uint32_t n = 1; n <= exits; n++)
+    {
+        uint32_t first_cnt = 0;
+        uint32_t new_cnt   = 0;
+        uint32_t other_cnt = 0;
+
+        m_write_cnt = 0;
+        m_sd_busy   = true;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 1));
+
+        m_irq_countdown = n;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, write_add(BLE_GATT_OP_WRITE_CMD, ATTR_HANDLE, 2));
+        TEST_ASSERT_EQUAL(0, m_irq_countdown);
+        queue_drain();
+
+        for (uint32_t i = 0; i < m_write_cnt; i++)
+        {
+            if (m_writes[i].handle == ATTR_HANDLE + 1)
+            {
+                TEST_ASSERT_EQUAL(0x40, m_writes[i].value);
+                other_cnt++;
+            }
+            else if (m_writes[i].value == 1)
+            {
+                TEST_ASSERT_EQUAL(0, new_cnt);
+                first_cnt++;
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL(2, m_writes[i].value);
+                new_cnt++;
+            }
+        }
+        TEST_ASSERT(first_cnt <= 1);
+        TEST_ASSERT_EQUAL(1, new_cnt);
+        TEST_ASSERT_EQUAL(1, other_cnt);
+    }
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_ble_gq_conn_handle_register(&m_gq, CONN_HANDLE));
+
+    host_test_run("write_cmd_merge", write_cmd_merge);
+    host_test_run("write_cmd_direct", write_cmd_direct);
+    host_test_run("write_cmd_merge_interrupted", write_cmd_merge_interrupted);
+    return 0;
+}
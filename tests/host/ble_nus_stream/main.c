@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the ble_nus streaming TX mode against a SoftDevice stub with a bounded
+ *        notification queue.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "ble_nus.h"
+#include "ble_conn_state.h"
+
+#define CONN_HANDLE         0       /**< Handle of the simulated connection. */
+#define HVN_QUEUE_SIZE      2       /**< Number of notifications the SoftDevice stub can queue. */
+#define ATT_MTU             247     /**< Effective ATT MTU reported by the GATT module stub. */
+#define PAYLOAD_LEN         (ATT_MTU - OPCODE_LENGTH - HANDLE_LENGTH)
+#define STREAM_SIZE         512     /**< Size of the streaming buffer. */
+#define STREAM_BYTES        20000   /**< Number of bytes sent in the packing test. */
+#define PACKETS_MAX         1024    /**< Number of notifications the stub can record. */
+
+BLE_NUS_DEF(m_nus, 1);
+BLE_NUS_STREAM_DEF(m_stream, STREAM_SIZE);
+
+static nrf_ble_gatt_t m_gatt;
+static uint16_t       m_next_handle;
+static uint8_t        m_cccd[2];
+
+static uint32_t       m_hvn_queued;                 /**< Notifications queued in the stub. */
+static uint8_t        m_air[STREAM_BYTES];          /**< Data of all notifications, in order. */
+static uint32_t       m_air_len;
+static uint16_t       m_packet_len[PACKETS_MAX];
+static uint32_t       m_packet_cnt;
+
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const * p_vs_uuid, uint8_t * p_uuid_type)
+{
+    *p_uuid_type = BLE_UUID_TYPE_VENDOR_BEGIN;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle)
+{
+    *p_handle = ++m_next_handle;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gatts_characteristic_add(uint16_t                         service_handle,
+                                         ble_gatts_char_md_t const      * p_char_md,
+                                         ble_gatts_attr_t const         * p_attr_char_value,
+                                         ble_gatts_char_handles_t       * p_handles)
+{
+    memset(p_handles, 0, sizeof(*p_handles));
+    p_handles->value_handle = ++m_next_handle;
+    if (p_char_md->char_props.notify)
+    {
+        p_handles->cccd_handle = ++m_next_handle;
+    }
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gatts_descriptor_add(uint16_t                 char_handle,
+                                     ble_gatts_attr_t const * p_attr,
+                                     uint16_t               * p_handle)
+{
+    *p_handle = ++m_next_handle;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gatts_value_get(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value)
+{
+    TEST_ASSERT_EQUAL(m_nus.tx_handles.cccd_handle, handle);
+    memcpy(p_value->p_value, m_cccd, sizeof(m_cccd));
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params)
+{
+    TEST_ASSERT_EQUAL(CONN_HANDLE, conn_handle);
+    TEST_ASSERT_EQUAL(m_nus.tx_handles.value_handle, p_hvx_params->handle);
+    TEST_ASSERT_EQUAL(BLE_GATT_HVX_NOTIFICATION, p_hvx_params->type);
+
+    if (m_hvn_queued == HVN_QUEUE_SIZE)
+    {
+        return NRF_ERROR_RESOURCES;
+    }
+
+    uint16_t length = *p_hvx_params->p_len;
+    TEST_ASSERT(length > 0);
+    TEST_ASSERT(m_air_len + length <= sizeof(m_air));
+    TEST_ASSERT(m_packet_cnt < PACKETS_MAX);
+
+    memcpy(&m_air[m_air_len], p_hvx_params->p_data, length);
+    m_air_len += length;
+    m_packet_len[m_packet_cnt++] = length;
+    m_hvn_queued++;
+    return NRF_SUCCESS;
+}
+
+
+uint16_t nrf_ble_gatt_eff_mtu_get(nrf_ble_gatt_t const * p_gatt, uint16_t conn_handle)
+{
+    TEST_ASSERT(p_gatt == &m_gatt);
+    return ATT_MTU;
+}
+
+
+uint16_t ble_conn_state_conn_idx(uint16_t conn_handle)
+{
+    return (conn_handle == CONN_HANDLE) ? 0 : BLE_CONN_STATE_MAX_CONNECTIONS;
+}
+
+
+static void nus_data_handler(ble_nus_evt_t * p_evt)
+{
+}
+
+
+static void gap_evt_send(uint16_t evt_id)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id          = evt_id;
+    evt.evt.gap_evt.conn_handle = CONN_HANDLE;
+    ble_nus_on_ble_evt(&evt, &m_nus);
+}
+
+
+static void cccd_write_send(uint16_t value)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                     = BLE_GATTS_EVT_WRITE;
+    evt.evt.gatts_evt.conn_handle         = CONN_HANDLE;
+    evt.evt.gatts_evt.params.write.handle = m_nus.tx_handles.cccd_handle;
+    evt.evt.gatts_evt.params.write.len    = 2;
+    evt.evt.gatts_evt.params.write.data[0] = LSB_16(value);
+    evt.evt.gatts_evt.params.write.data[1] = MSB_16(value);
+    ble_nus_on_ble_evt(&evt, &m_nus);
+}
+
+
+/* The stub transmits all queued notifications. */
+static void tx_complete_send(void)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                               = BLE_GATTS_EVT_HVN_TX_COMPLETE;
+    evt.evt.gatts_evt.conn_handle                   = CONN_HANDLE;
+    evt.evt.gatts_evt.params.hvn_tx_complete.count = (uint8_t)m_hvn_queued;
+    m_hvn_queued = 0;
+    ble_nus_on_ble_evt(&evt, &m_nus);
+}
+
+
+/* Connects with the given CCCD value and attaches the stream. */
+static void connect(uint16_t cccd, nrf_ble_gatt_t const * p_gatt)
+{
+    m_cccd[0]    = LSB_16(cccd);
+    m_cccd[1]    = MSB_16(cccd);
+    m_hvn_queued = 0;
+    m_air_len    = 0;
+    m_packet_cnt = 0;
+
+    gap_evt_send(BLE_GAP_EVT_CONNECTED);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_nus_stream_attach(&m_nus, &m_stream, p_gatt, CONN_HANDLE));
+}
+
+
+static void disconnect(void)
+{
+    ble_nus_client_context_t * p_client;
+
+    gap_evt_send(BLE_GAP_EVT_DISCONNECTED);
+
+    /* ble_nus never clears the notification flag of a link; start the next connection from a
+     * zeroed link context. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, blcm_link_ctx_get(m_nus.p_link_ctx_storage, CONN_HANDLE, (void *)&p_client));
+    memset(p_client, 0, sizeof(*p_client));
+}
+
+
+static uint32_t stream_write(uint8_t const * p_data, uint16_t length)
+{
+    uint16_t accepted = length;
+    uint32_t err_code = ble_nus_stream_write(&m_nus, p_data, &accepted);
+
+    TEST_ASSERT((err_code == NRF_SUCCESS) || (err_code == NRF_ERROR_NO_MEM));
+    TEST_ASSERT((err_code == NRF_SUCCESS) == (accepted == length));
+    return accepted;
+}
+
+
+/* Without a GATT module, the data is sent in notifications for the default ATT MTU. */
+static void default_mtu(void)
+{
+    uint8_t data[50];
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)i;
+    }
+
+    connect(BLE_GATT_HVX_NOTIFICATION, NULL);
+    TEST_ASSERT_EQUAL(sizeof(data), stream_write(data, sizeof(data)));
+    TEST_ASSERT_EQUAL(2, m_packet_cnt);
+    TEST_ASSERT_EQUAL(BLE_GATT_ATT_MTU_DEFAULT - 3, m_packet_len[0]);
+    TEST_ASSERT_EQUAL(BLE_GATT_ATT_MTU_DEFAULT - 3, m_packet_len[1]);
+
+    tx_complete_send();
+    TEST_ASSERT_EQUAL(3, m_packet_cnt);
+    TEST_ASSERT_EQUAL(sizeof(data) - 2 * (BLE_GATT_ATT_MTU_DEFAULT - 3), m_packet_len[2]);
+    TEST_ASSERT(memcmp(m_air, data, sizeof(data)) == 0);
+    disconnect();
+}
+
+
+/* Checks the notifications sent since @p first and returns the number of short ones. A
+ * notification shorter than the payload must have emptied the buffer. */
+static uint32_t short_packets_check(uint32_t first)
+{
+    uint32_t               count = 0;
+    ble_nus_stream_stats_t stats;
+
+    for (uint32_t i = first; i < m_packet_cnt; i++)
+    {
+        TEST_ASSERT(m_packet_len[i] <= PAYLOAD_LEN);
+        if (m_packet_len[i] < PAYLOAD_LEN)
+        {
+            TEST_ASSERT_EQUAL(m_packet_cnt - 1, i);
+            ble_nus_stream_stats_get(&m_stream, &stats);
+            TEST_ASSERT_EQUAL(stats.bytes_queued, stats.bytes_sent);
+            count++;
+        }
+    }
+    return count;
+}
+
+
+/* Small writes accumulate while the SoftDevice queue is full and leave in full notifications.
+ * The buffer wraps in the middle of notifications and is at times full, so part of the writes
+ * are retried. */
+static void mtu_packing(void)
+{
+    static uint8_t         data[STREAM_BYTES];
+    uint32_t               seed    = 0x5EED0028;
+    uint32_t               written = 0;
+    uint32_t               short_packets = 0;
+    ble_nus_stream_stats_t stats;
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)host_test_rand(&seed);
+    }
+
+    connect(BLE_GATT_HVX_NOTIFICATION, &m_gatt);
+
+    while (m_air_len < sizeof(data))
+    {
+        uint32_t packets = m_packet_cnt;
+
+        if (written < sizeof(data))
+        {
+            uint16_t length = (uint16_t)MIN(1 + host_test_rand(&seed) % 64, sizeof(data) - written);
+
+            written += stream_write(&data[written], length);
+            if ((host_test_rand(&seed) % 8) == 0)
+            {
+                tx_complete_send();
+            }
+        }
+        else
+        {
+            tx_complete_send();
+            TEST_ASSERT(m_packet_cnt > packets);
+        }
+
+        short_packets += short_packets_check(packets);
+    }
+
+    TEST_ASSERT(memcmp(m_air, data, sizeof(data)) == 0);
+    TEST_ASSERT(2 * (m_packet_cnt - short_packets) * PAYLOAD_LEN > sizeof(data));
+
+    tx_complete_send();
+    ble_nus_stream_stats_get(&m_stream, &stats);
+    TEST_ASSERT_EQUAL(sizeof(data), stats.bytes_queued);
+    TEST_ASSERT_EQUAL(sizeof(data), stats.bytes_sent);
+    TEST_ASSERT_EQUAL(m_packet_cnt, stats.packets_sent);
+    TEST_ASSERT_EQUAL(m_packet_cnt, stats.tx_complete);
+    TEST_ASSERT(stats.queue_full > 0);
+    TEST_ASSERT(stats.buffer_max <= STREAM_SIZE);
+    disconnect();
+}
+
+
+/* A full buffer accepts part of the data and reports the rest as rejected. */
+static void buffer_full(void)
+{
+    static uint8_t         data[STREAM_SIZE + 100];
+    ble_nus_stream_stats_t stats;
+
+    memset(data, 0x5A, sizeof(data));
+    connect(BLE_GATT_HVX_NOTIFICATION, &m_gatt);
+
+    /* The data is buffered first, then moved to the SoftDevice queue. */
+    TEST_ASSERT_EQUAL(STREAM_SIZE, stream_write(data, sizeof(data)));
+    TEST_ASSERT_EQUAL(HVN_QUEUE_SIZE, m_packet_cnt);
+    TEST_ASSERT_EQUAL(HVN_QUEUE_SIZE * PAYLOAD_LEN, stream_write(data, sizeof(data)));
+    TEST_ASSERT_EQUAL(0, stream_write(data, 1));
+
+    ble_nus_stream_stats_get(&m_stream, &stats);
+    TEST_ASSERT_EQUAL(2 * sizeof(data) + 1 - STREAM_SIZE - HVN_QUEUE_SIZE * PAYLOAD_LEN,
+                      stats.bytes_rejected);
+    TEST_ASSERT_EQUAL(STREAM_SIZE, stats.buffer_max);
+    TEST_ASSERT_EQUAL(3, stats.queue_full);
+
+    tx_complete_send();
+    TEST_ASSERT_EQUAL(2 * HVN_QUEUE_SIZE, m_packet_cnt);
+    TEST_ASSERT_EQUAL(1, stream_write(data, 1));
+    disconnect();
+}
+
+
+/* Data written before the client enables notifications is sent when it does. */
+static void cccd_enable(void)
+{
+    uint8_t data[30];
+
+    memset(data, 0xC3, sizeof(data));
+    connect(0, &m_gatt);
+
+    TEST_ASSERT_EQUAL(sizeof(data), stream_write(data, sizeof(data)));
+    TEST_ASSERT_EQUAL(0, m_packet_cnt);
+
+    cccd_write_send(BLE_GATT_HVX_NOTIFICATION);
+    TEST_ASSERT_EQUAL(1, m_packet_cnt);
+    TEST_ASSERT_EQUAL(sizeof(data), m_packet_len[0]);
+    disconnect();
+}
+
+
+static void disconnect_detaches(void)
+{
+    uint8_t  data   = 0;
+    uint16_t length = 1;
+
+    connect(BLE_GATT_HVX_NOTIFICATION, &m_gatt);
+    disconnect();
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, ble_nus_stream_write(&m_nus, &data, &length));
+    TEST_ASSERT(m_nus.p_stream == NULL);
+}
+
+
+int main(void)
+{
+    ble_nus_init_t nus_init;
+
+    memset(&nus_init, 0, sizeof(nus_init));
+    nus_init.data_handler = nus_data_handler;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ble_nus_init(&m_nus, &nus_init));
+
+    host_test_run("default_mtu", default_mtu);
+    host_test_run("mtu_packing", mtu_packing);
+    host_test_run("buffer_full", buffer_full);
+    host_test_run("cccd_enable", cccd_enable);
+    host_test_run("disconnect_detaches", disconnect_detaches);
+    return 0;
+}
@@ -0,0 +1,290 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include "sdk_common.h"
+#include "drv_rtc.h"
+#include "drv_rtc_fake.h"
+
+#define CC_COUNT      4                   /**< Number of compare channels. */
+#define EVT_OVERFLOW  CC_COUNT            /**< Event index of the overflow event. */
+#define EVT_COUNT     (CC_COUNT + 1)      /**< Number of events. */
+
+typedef struct
+{
+    drv_rtc_t const * p_instance;
+    drv_rtc_handler_t handler;
+    bool              running;
+    bool              in_irq;
+    bool              irq_triggered;
+    uint32_t          counter;
+    uint64_t          ticks;
+    uint32_t          wakeups;
+    uint32_t          cc[CC_COUNT];
+    bool              evt_enabled[EVT_COUNT];
+    bool              int_enabled[EVT_COUNT];
+    bool              evt_pending[EVT_COUNT];
+} rtc_fake_t;
+
+static rtc_fake_t m_rtc;
+
+static uint32_t ticks_sub(uint32_t a, uint32_t b)
+{
+    return (a - b) & DRV_RTC_MAX_CNT;
+}
+
+static bool irq_pending(void)
+{
+    for (uint32_t i = 0; i < EVT_COUNT; i++)
+    {
+        if (m_rtc.evt_pending[i] && m_rtc.int_enabled[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void irq_run(void)
+{
+    if (m_rtc.in_irq || (m_rtc.handler == NULL))
+    {
+        return;
+    }
+
+    m_rtc.in_irq = true;
+    while (m_rtc.irq_triggered || irq_pending())
+    {
+        m_rtc.irq_triggered = false;
+        m_rtc.handler(m_rtc.p_instance);
+    }
+    m_rtc.in_irq = false;
+}
+
+/**
+ * @brief Function for getting the number of ticks until the next enabled event.
+ */
+static uint32_t next_event_get(void)
+{
+    uint32_t next = ticks_sub(0, m_rtc.counter);
+
+    if (next == 0)
+    {
+        next = DRV_RTC_MAX_CNT + 1;
+    }
+    for (uint32_t i = 0; i < CC_COUNT; i++)
+    {
+        uint32_t diff = ticks_sub(m_rtc.cc[i], m_rtc.counter);
+        if (m_rtc.evt_enabled[i] && (diff != 0) && (diff < next))
+        {
+            next = diff;
+        }
+    }
+    return next;
+}
+
+void drv_rtc_fake_advance(uint32_t ticks)
+{
+    while (ticks > 0)
+    {
+        if (!m_rtc.running)
+        {
+            return;
+        }
+
+        uint32_t step = MIN(next_event_get(), ticks);
+        m_rtc.counter = (m_rtc.counter + step) & DRV_RTC_MAX_CNT;
+        m_rtc.ticks  += step;
+        ticks        -= step;
+
+        if ((m_rtc.counter == 0) && m_rtc.evt_enabled[EVT_OVERFLOW])
+        {
+            m_rtc.evt_pending[EVT_OVERFLOW] = true;
+        }
+        for (uint32_t i = 0; i < CC_COUNT; i++)
+        {
+            if (m_rtc.evt_enabled[i] && (m_rtc.cc[i] == m_rtc.counter))
+            {
+                m_rtc.evt_pending[i] = true;
+            }
+        }
+        if (irq_pending())
+        {
+            m_rtc.wakeups++;
+            irq_run();
+        }
+    }
+}
+
+uint64_t drv_rtc_fake_ticks_get(void)
+{
+    return m_rtc.ticks;
+}
+
+uint32_t drv_rtc_fake_wakeups_get(void)
+{
+    return m_rtc.wakeups;
+}
+
+ret_code_t drv_rtc_init(drv_rtc_t const * const  p_instance,
+                        drv_rtc_config_t const * p_config,
+                        drv_rtc_handler_t        handler)
+{
+    ASSERT(handler);
+    UNUSED_PARAMETER(p_config);
+
+    m_rtc.p_instance = p_instance;
+    m_rtc.handler    = handler;
+    return NRF_SUCCESS;
+}
+
+void drv_rtc_uninit(drv_rtc_t const * const p_instance)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.handler = NULL;
+    m_rtc.running = false;
+}
+
+void drv_rtc_start(drv_rtc_t const * const p_instance)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.running = true;
+}
+
+void drv_rtc_stop(drv_rtc_t const * const p_instance)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.running = false;
+}
+
+void drv_rtc_compare_set(drv_rtc_t const * const p_instance,
+                         uint32_t                cc,
+                         uint32_t                abs_value,
+                         bool                    irq_enable)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.cc[cc]          = abs_value & DRV_RTC_MAX_CNT;
+    m_rtc.evt_pending[cc] = false;
+    m_rtc.evt_enabled[cc] = true;
+    m_rtc.int_enabled[cc] = irq_enable;
+}
+
+ret_code_t drv_rtc_windowed_compare_set(drv_rtc_t const * const p_instance,
+                                        uint32_t                cc,
+                                        uint32_t                abs_value,
+                                        uint32_t                safe_window)
+{
+    UNUSED_PARAMETER(p_instance);
+    abs_value &= DRV_RTC_MAX_CNT;
+
+    m_rtc.cc[cc]          = abs_value;
+    m_rtc.evt_pending[cc] = false;
+    m_rtc.evt_enabled[cc] = true;
+
+    /* Counter equal to the value or behind it in the safe window: the event already occurred. */
+    if (ticks_sub(abs_value - 1, m_rtc.counter) > (DRV_RTC_MAX_CNT - safe_window))
+    {
+        m_rtc.int_enabled[cc] = false;
+        return NRF_ERROR_TIMEOUT;
+    }
+    m_rtc.int_enabled[cc] = true;
+    return NRF_SUCCESS;
+}
+
+void drv_rtc_overflow_enable(drv_rtc_t const * const p_instance, bool irq_enable)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.evt_enabled[EVT_OVERFLOW] = true;
+    m_rtc.int_enabled[EVT_OVERFLOW] = irq_enable;
+}
+
+void drv_rtc_overflow_disable(drv_rtc_t const * const p_instance)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.evt_enabled[EVT_OVERFLOW] = false;
+    m_rtc.int_enabled[EVT_OVERFLOW] = false;
+}
+
+bool drv_rtc_overflow_pending(drv_rtc_t const * const p_instance)
+{
+    UNUSED_PARAMETER(p_instance);
+    bool pending = m_rtc.evt_pending[EVT_OVERFLOW];
+    m_rtc.evt_pending[EVT_OVERFLOW] = false;
+    return pending;
+}
+
+void drv_rtc_compare_enable(drv_rtc_t const * const p_instance, uint32_t cc, bool irq_enable)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.evt_enabled[cc] = true;
+    m_rtc.int_enabled[cc] = irq_enable;
+}
+
+void drv_rtc_compare_disable(drv_rtc_t const * const p_instance, uint32_t cc)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.evt_enabled[cc] = false;
+    m_rtc.int_enabled[cc] = false;
+}
+
+bool drv_rtc_compare_pending(drv_rtc_t const * const p_instance, uint32_t cc)
+{
+    UNUSED_PARAMETER(p_instance);
+    bool pending = m_rtc.evt_pending[cc];
+    m_rtc.evt_pending[cc] = false;
+    return pending;
+}
+
+uint32_t drv_rtc_compare_get(drv_rtc_t const * const p_instance, uint32_t cc)
+{
+    UNUSED_PARAMETER(p_instance);
+    return m_rtc.cc[cc];
+}
+
+uint32_t drv_rtc_counter_get(drv_rtc_t const * const p_instance)
+{
+    UNUSED_PARAMETER(p_instance);
+    return m_rtc.counter;
+}
+
+void drv_rtc_irq_trigger(drv_rtc_t const * const p_instance)
+{
+    UNUSED_PARAMETER(p_instance);
+    m_rtc.irq_triggered = true;
+    irq_run();
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef DRV_RTC_FAKE_H__
+#define DRV_RTC_FAKE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup drv_rtc_fake RTC driver fake
+ * @{
+ * @ingroup host_test
+ *
+ * @brief Implementation of the @ref drv_rtc API without hardware, for host tests of app_timer.
+ *
+ * Time passes only in @ref drv_rtc_fake_advance, which moves the counter from one event to the
+ * next and runs the interrupt handler at every enabled compare or overflow event. An interrupt
+ * triggered with @ref drv_rtc_irq_trigger runs at once, or after the running handler returns.
+ */
+
+/**
+ * @brief Function for letting time pass.
+ *
+ * The counter moves only while the RTC is started.
+ *
+ * @param[in] ticks Number of ticks.
+ */
+void drv_rtc_fake_advance(uint32_t ticks);
+
+/**
+ * @brief Function for getting the number of counter increments since the program start.
+ *
+ * @return Counter value extended to 64 bits.
+ */
+uint64_t drv_rtc_fake_ticks_get(void);
+
+/**
+ * @brief Function for getting the number of interrupts generated by compare or overflow events.
+ *
+ * Each of them wakes the CPU up. Interrupts triggered by software are not counted.
+ *
+ * @return Number of interrupts since the program start.
+ */
+uint32_t drv_rtc_fake_wakeups_get(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRV_RTC_FAKE_H__
@@ -0,0 +1,644 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#include <string.h>
+#include "sdk_common.h"
+#include "fds.h"
+#include "fds_fake.h"
+
+#define FLASH_WORDS     4096    /**< Size of one half of the storage, in words. */
+#define RECORDS_MAX     64      /**< Number of records, valid or deleted, in one half. */
+#define OPS_MAX         16      /**< Number of queued operations. */
+#define USERS_MAX       8       /**< Number of event handlers. */
+#define HEADER_WORDS    BYTES_TO_WORDS(sizeof(fds_header_t))
+
+typedef struct
+{
+    fds_header_t * p_header;    /**< Location of the record. */
+    bool           valid;       /**< The record was not deleted. */
+} slot_t;
+
+typedef enum
+{
+    OP_INIT,
+    OP_WRITE,
+    OP_UPDATE,
+    OP_DEL_RECORD,
+    OP_DEL_FILE,
+    OP_GC,
+} op_type_t;
+
+typedef struct
+{
+    op_type_t    type;
+    uint32_t     record_id;     /**< ID of the record written, or deleted. */
+    uint32_t     old_id;        /**< ID of the record replaced by an update. */
+    fds_record_t record;        /**< Record to write. The data is copied when the write is done. */
+    uint16_t     file_id;       /**< File to delete. */
+} op_t;
+
+static uint32_t m_flash[2][FLASH_WORDS];
+static uint32_t m_half;             /**< Half of @ref m_flash in use. */
+static uint32_t m_used;             /**< Words used in the current half. */
+static uint32_t m_reserved;         /**< Words needed by the queued writes. */
+static slot_t   m_slots[RECORDS_MAX];
+static uint32_t m_slot_cnt;
+static uint32_t m_next_id;
+static uint32_t m_gc_cnt;
+static op_t     m_ops[OPS_MAX];
+static uint32_t m_op_head;
+static uint32_t m_op_cnt;
+static fds_cb_t m_users[USERS_MAX];
+static uint32_t m_user_cnt;
+static bool     m_initialized;
+
+
+static void evt_send(fds_evt_t const * p_evt)
+{
+    for (uint32_t i = 0; i < m_user_cnt; i++)
+    {
+        m_users[i](p_evt);
+    }
+}
+
+
+static slot_t * slot_find(uint32_t record_id)
+{
+    for (uint32_t i = 0; i < m_slot_cnt; i++)
+    {
+        if (m_slots[i].valid && (m_slots[i].p_header->record_id == record_id))
+        {
+            return &m_slots[i];
+        }
+    }
+    return NULL;
+}
+
+
+static op_t * op_alloc(op_type_t type)
+{
+    op_t * p_op;
+
+    if (m_op_cnt == OPS_MAX)
+    {
+        return NULL;
+    }
+
+    p_op = &m_ops[(m_op_head + m_op_cnt++) % OPS_MAX];
+    memset(p_op, 0, sizeof(*p_op));
+    p_op->type = type;
+    return p_op;
+}
+
+
+static ret_code_t write_enqueue(op_type_t                 type,
+                                fds_record_desc_t       * p_desc,
+                                fds_record_t      const * p_record)
+{
+    op_t * p_op;
+
+    if (!m_initialized)
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+    if ((p_record == NULL) || (p_record->data.p_data == NULL))
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+    if ((p_record->file_id == FDS_FILE_ID_INVALID) || (p_record->key == FDS_RECORD_KEY_DIRTY))
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+    if (m_used + m_reserved + HEADER_WORDS + p_record->data.length_words > FLASH_WORDS)
+    {
+        return FDS_ERR_NO_SPACE_IN_FLASH;
+    }
+
+    p_op = op_alloc(type);
+    if (p_op == NULL)
+    {
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    if (type == OP_UPDATE)
+    {
+        p_op->old_id = p_desc->record_id;
+    }
+
+    p_op->record    = *p_record;
+    p_op->record_id = ++m_next_id;
+    m_reserved     += HEADER_WORDS + p_record->data.length_words;
+
+    if (p_desc != NULL)
+    {
+        memset(p_desc, 0, sizeof(*p_desc));
+        p_desc->record_id = p_op->record_id;
+    }
+
+    return NRF_SUCCESS;
+}
+
+
+static void write_do(op_t const * p_op)
+{
+    uint32_t       length_words = p_op->record.data.length_words;
+    fds_header_t * p_header     = (fds_header_t *)&m_flash[m_half][m_used];
+    fds_evt_t      evt;
+
+    ASSERT(m_slot_cnt < RECORDS_MAX);
+
+    p_header->record_key   = p_op->record.key;
+    p_header->length_words = length_words;
+    p_header->file_id      = p_op->record.file_id;
+    p_header->crc16        = 0xFFFF;
+    p_header->record_id    = p_op->record_id;
+    memcpy(p_header + 1, p_op->record.data.p_data, length_words * sizeof(uint32_t));
+
+    m_used     += HEADER_WORDS + length_words;
+    m_reserved -= HEADER_WORDS + length_words;
+
+    m_slots[m_slot_cnt].p_header = p_header;
+    m_slots[m_slot_cnt].valid    = true;
+    m_slot_cnt++;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.id                = (p_op->type == OP_UPDATE) ? FDS_EVT_UPDATE : FDS_EVT_WRITE;
+    evt.result            = NRF_SUCCESS;
+    evt.write.record_id   = p_op->record_id;
+    evt.write.file_id     = p_op->record.file_id;
+    evt.write.record_key  = p_op->record.key;
+
+    if (p_op->type == OP_UPDATE)
+    {
+        slot_t * p_old = slot_find(p_op->old_id);
+
+        if (p_old != NULL)
+        {
+            p_old->valid                = false;
+            evt.write.is_record_updated = true;
+        }
+    }
+
+    evt_send(&evt);
+}
+
+
+static void del_record_do(op_t const * p_op)
+{
+    slot_t  * p_slot = slot_find(p_op->record_id);
+    fds_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.id            = FDS_EVT_DEL_RECORD;
+    evt.del.record_id = p_op->record_id;
+
+    if (p_slot != NULL)
+    {
+        p_slot->valid      = false;
+        evt.result         = NRF_SUCCESS;
+        evt.del.file_id    = p_slot->p_header->file_id;
+        evt.del.record_key = p_slot->p_header->record_key;
+    }
+    else
+    {
+        evt.result = FDS_ERR_NOT_FOUND;
+    }
+
+    evt_send(&evt);
+}
+
+
+static void del_file_do(op_t const * p_op)
+{
+    fds_evt_t evt;
+
+    for (uint32_t i = 0; i < m_slot_cnt; i++)
+    {
+        if (m_slots[i].valid && (m_slots[i].p_header->file_id == p_op->file_id))
+        {
+            m_slots[i].valid = false;
+        }
+    }
+
+    memset(&evt, 0, sizeof(evt));
+    evt.id             = FDS_EVT_DEL_FILE;
+    evt.result         = NRF_SUCCESS;
+    evt.del.file_id    = p_op->file_id;
+    evt.del.record_key = FDS_RECORD_KEY_DIRTY;
+
+    evt_send(&evt);
+}
+
+
+static void gc_do(void)
+{
+    uint32_t  half = m_half ^ 1;
+    uint32_t  used = 0;
+    uint32_t  cnt  = 0;
+    fds_evt_t evt;
+
+    for (uint32_t i = 0; i < m_slot_cnt; i++)
+    {
+        if (m_slots[i].valid)
+        {
+            uint32_t words = HEADER_WORDS + m_slots[i].p_header->length_words;
+
+            memcpy(&m_flash[half][used], m_slots[i].p_header, words * sizeof(uint32_t));
+            m_slots[cnt].p_header = (fds_header_t *)&m_flash[half][used];
+            m_slots[cnt].valid    = true;
+            used += words;
+            cnt++;
+        }
+    }
+
+    memset(m_flash[m_half], FDS_FAKE_POISON & 0xFF, sizeof(m_flash[m_half]));
+
+    m_half     = half;
+    m_used     = used;
+    m_slot_cnt = cnt;
+    m_gc_cnt++;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.id     = FDS_EVT_GC;
+    evt.result = NRF_SUCCESS;
+
+    evt_send(&evt);
+}
+
+
+void fds_fake_reset(void)
+{
+    memset(m_flash, 0xFF, sizeof(m_flash));
+    memset(m_slots, 0, sizeof(m_slots));
+
+    m_half        = 0;
+    m_used        = 0;
+    m_reserved    = 0;
+    m_slot_cnt    = 0;
+    m_next_id     = 0;
+    m_gc_cnt      = 0;
+    m_op_head     = 0;
+    m_op_cnt      = 0;
+    m_user_cnt    = 0;
+    m_initialized = false;
+}
+
+
+uint32_t fds_fake_process(void)
+{
+    uint32_t done = 0;
+
+    while (m_op_cnt > 0)
+    {
+        op_t op = m_ops[m_op_head];
+
+        m_op_head = (m_op_head + 1) % OPS_MAX;
+        m_op_cnt--;
+        done++;
+
+        switch (op.type)
+        {
+            case OP_INIT:
+            {
+                fds_evt_t evt;
+
+                memset(&evt, 0, sizeof(evt));
+                evt.id     = FDS_EVT_INIT;
+                evt.result = NRF_SUCCESS;
+                evt_send(&evt);
+            } break;
+
+            case OP_WRITE:
+            case OP_UPDATE:
+                write_do(&op);
+                break;
+
+            case OP_DEL_RECORD:
+                del_record_do(&op);
+                break;
+
+            case OP_DEL_FILE:
+                del_file_do(&op);
+                break;
+
+            case OP_GC:
+                gc_do();
+                break;
+        }
+    }
+
+    return done;
+}
+
+
+uint32_t fds_fake_gc_count_get(void)
+{
+    return m_gc_cnt;
+}
+
+
+ret_code_t fds_register(fds_cb_t cb)
+{
+    if (m_user_cnt == USERS_MAX)
+    {
+        return FDS_ERR_USER_LIMIT_REACHED;
+    }
+
+    m_users[m_user_cnt++] = cb;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_init(void)
+{
+    if (m_initialized)
+    {
+        return NRF_SUCCESS;
+    }
+
+    if (op_alloc(OP_INIT) == NULL)
+    {
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    m_initialized = true;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_record_write(fds_record_desc_t * p_desc, fds_record_t const * p_record)
+{
+    return write_enqueue(OP_WRITE, p_desc, p_record);
+}
+
+
+ret_code_t fds_record_update(fds_record_desc_t * p_desc, fds_record_t const * p_record)
+{
+    if (p_desc == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    return write_enqueue(OP_UPDATE, p_desc, p_record);
+}
+
+
+ret_code_t fds_record_delete(fds_record_desc_t * p_desc)
+{
+    op_t * p_op;
+
+    if (!m_initialized)
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+    if (p_desc == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    p_op = op_alloc(OP_DEL_RECORD);
+    if (p_op == NULL)
+    {
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    p_op->record_id = p_desc->record_id;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_file_delete(uint16_t file_id)
+{
+    op_t * p_op;
+
+    if (!m_initialized)
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+    if (file_id == FDS_FILE_ID_INVALID)
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    p_op = op_alloc(OP_DEL_FILE);
+    if (p_op == NULL)
+    {
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    p_op->file_id = file_id;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_gc(void)
+{
+    if (!m_initialized)
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+
+    return (op_alloc(OP_GC) != NULL) ? NRF_SUCCESS : FDS_ERR_NO_SPACE_IN_QUEUES;
+}
+
+
+/* The token holds the index of the next slot to look at in its page field. */
+static ret_code_t find(bool                match_file,
+                       uint16_t            file_id,
+                       bool                match_key,
+                       uint16_t            record_key,
+                       fds_record_desc_t * p_desc,
+                       fds_find_token_t  * p_token)
+{
+    if (!m_initialized)
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+    if ((p_desc == NULL) || (p_token == NULL))
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    for (uint32_t i = p_token->page; i < m_slot_cnt; i++)
+    {
+        fds_header_t const * p_header = m_slots[i].p_header;
+
+        if (   m_slots[i].valid
+            && (!match_file || (p_header->file_id == file_id))
+            && (!match_key  || (p_header->record_key == record_key)))
+        {
+            memset(p_desc, 0, sizeof(*p_desc));
+            p_desc->record_id    = p_header->record_id;
+            p_desc->p_record     = (uint32_t const *)p_header;
+            p_desc->gc_run_count = m_gc_cnt;
+
+            p_token->p_addr = (uint32_t const *)p_header;
+            p_token->page   = i + 1;
+            return NRF_SUCCESS;
+        }
+    }
+
+    return FDS_ERR_NOT_FOUND;
+}
+
+
+ret_code_t fds_record_find(uint16_t            file_id,
+                           uint16_t            record_key,
+                           fds_record_desc_t * p_desc,
+                           fds_find_token_t  * p_token)
+{
+    return find(true, file_id, true, record_key, p_desc, p_token);
+}
+
+
+ret_code_t fds_record_find_by_key(uint16_t            record_key,
+                                  fds_record_desc_t * p_desc,
+                                  fds_find_token_t  * p_token)
+{
+    return find(false, 0, true, record_key, p_desc, p_token);
+}
+
+
+ret_code_t fds_record_find_in_file(uint16_t            file_id,
+                                   fds_record_desc_t * p_desc,
+                                   fds_find_token_t  * p_token)
+{
+    return find(true, file_id, false, 0, p_desc, p_token);
+}
+
+
+ret_code_t fds_record_iterate(fds_record_desc_t * p_desc, fds_find_token_t * p_token)
+{
+    return find(false, 0, false, 0, p_desc, p_token);
+}
+
+
+ret_code_t fds_record_open(fds_record_desc_t * p_desc, fds_flash_record_t * p_flash_record)
+{
+    slot_t * p_slot;
+
+    if ((p_desc == NULL) || (p_flash_record == NULL))
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    p_slot = slot_find(p_desc->record_id);
+    if (p_slot == NULL)
+    {
+        return FDS_ERR_NOT_FOUND;
+    }
+
+    p_desc->p_record       = (uint32_t const *)p_slot->p_header;
+    p_desc->gc_run_count   = m_gc_cnt;
+    p_desc->record_is_open = true;
+
+    p_flash_record->p_header = p_slot->p_header;
+    p_flash_record->p_data   = p_slot->p_header + 1;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_record_close(fds_record_desc_t * p_desc)
+{
+    if (p_desc == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+    if (!p_desc->record_is_open)
+    {
+        return FDS_ERR_NO_OPEN_RECORDS;
+    }
+
+    p_desc->record_is_open = false;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_record_id_from_desc(fds_record_desc_t const * p_desc, uint32_t * p_record_id)
+{
+    if ((p_desc == NULL) || (p_record_id == NULL))
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    *p_record_id = p_desc->record_id;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_descriptor_from_rec_id(fds_record_desc_t * p_desc, uint32_t record_id)
+{
+    if (p_desc == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    memset(p_desc, 0, sizeof(*p_desc));
+    p_desc->record_id = record_id;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t fds_stat(fds_stat_t * p_stat)
+{
+    if (p_stat == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    memset(p_stat, 0, sizeof(*p_stat));
+    p_stat->pages_available = 2;
+    p_stat->words_used      = m_used;
+    p_stat->largest_contig  = FLASH_WORDS - m_used - m_reserved;
+
+    for (uint32_t i = 0; i < m_slot_cnt; i++)
+    {
+        if (m_slots[i].valid)
+        {
+            p_stat->valid_records++;
+        }
+        else
+        {
+            p_stat->dirty_records++;
+            p_stat->freeable_words += HEADER_WORDS + m_slots[i].p_header->length_words;
+        }
+    }
+
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef FDS_FAKE_H__
+#define FDS_FAKE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup fds_fake FDS fake
+ * @{
+ * @ingroup host_test
+ *
+ * @brief Implementation of the @ref fds API in RAM, for host tests of FDS users.
+ *
+ * Like FDS, the write, update and delete functions only queue the operation. It is carried out,
+ * and its event sent, in @ref fds_fake_process, so the data passed to a write must stay valid
+ * until then. Records are stored in one of two halves of a RAM area. Garbage collection copies
+ * the valid records to the other half and fills the old one with @ref FDS_FAKE_POISON, so that
+ * a record used through a stale address reads as garbage.
+ *
+ * Unlike FDS, garbage collection moves open records too.
+ */
+
+#define FDS_FAKE_POISON     0xA5A5A5A5  /**< Contents of the freed half after garbage collection. */
+
+/**
+ * @brief Function for erasing all records and dropping queued operations and registered users.
+ */
+void fds_fake_reset(void);
+
+/**
+ * @brief Function for carrying out the queued operations and sending their events.
+ *
+ * Operations queued from an event handler are carried out in the same call.
+ *
+ * @return Number of operations carried out.
+ */
+uint32_t fds_fake_process(void);
+
+/**
+ * @brief Function for getting the number of garbage collections run since the reset.
+ */
+uint32_t fds_fake_gc_count_get(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FDS_FAKE_H__
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+#ifndef HOST_TEST_H__
+#define HOST_TEST_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup host_test Host test support
+ * @{
+ *
+ * @brief Checks and helpers shared by the host test programs.
+ *
+ * A failed check, ASSERT or APP_ERROR_CHECK prints its location and terminates the program
+ * with a non-zero exit code, which makes the test run fail.
+ */
+
+/**
+ * @brief Macro for checking a condition.
+ *
+ * @param[in] expr Condition that must hold.
+ */
+#define TEST_ASSERT(expr)                                           \
+    do                                                              \
+    {                                                               \
+        if (!(expr))                                                \
+        {                                                           \
+            host_test_fail(__FILE__, __LINE__, #expr);              \
+        }                                                           \
+    } while (0)
+
+/**
+ * @brief Macro for checking that two integer values are equal.
+ *
+ * @param[in] expected Expected value.
+ * @param[in] actual   Actual value.
+ */
+#define TEST_ASSERT_EQUAL(expected, actual)                                     \
+    do                                                                          \
+    {                                                                           \
+        long long _expected = (long long)(expected);                            \
+        long long _actual   = (long long)(actual);                              \
+        if (_expected != _actual)                                               \
+        {                                                                       \
+            fprintf(stderr, "expected %lld, got %lld\n", _expected, _actual);   \
+            host_test_fail(__FILE__, __LINE__, #actual);                        \
+        }                                                                       \
+    } while (0)
+
+/**
+ * @brief Function for reporting a failed check and terminating the program.
+ *
+ * @param[in] p_file File name.
+ * @param[in] line   Line number.
+ * @param[in] p_expr Failed expression.
+ */
+void host_test_fail(char const * p_file, uint32_t line, char const * p_expr) __attribute__((noreturn));
+
+/**
+ * @brief Function for running one test case and printing its name.
+ *
+ * @param[in] p_name  Test case name.
+ * @param[in] test_fn Test case.
+ */
+void host_test_run(char const * p_name, void (* test_fn)(void));
+
+/**
+ * @brief Function for getting a pseudo-random number from a seeded xorshift generator.
+ *
+ * @param[in,out] p_state Generator state. Must not be 0.
+ *
+ * @return Next number.
+ */
+uint32_t host_test_rand(uint32_t * p_state);
+
+/**
+ * @brief Function for getting a monotonic wall-clock time stamp, for throughput figures.
+ *
+ * @return Time in nanoseconds.
+ */
+uint64_t host_test_time_ns(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_TEST_H__
@@ -0,0 +1,1037 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#ifndef SDK_CONFIG_H
+#define SDK_CONFIG_H
+// <<< Use Configuration Wizard in Context Menu >>>\n
+#ifdef USE_APP_CONFIG
+#include "app_config.h"
+#endif
+// <h> nRF_BLE
+
+//==========================================================
+// <e> BLE_DB_DISCOVERY_ENABLED - ble_db_discovery - Database discovery module
+//==========================================================
+#ifndef BLE_DB_DISCOVERY_ENABLED
+#define BLE_DB_DISCOVERY_ENABLED 0
+#endif
+// <e> BLE_DB_DISCOVERY_CACHE_ENABLED - Cache discovery results in flash, validated by the Database Hash.
+
+// <i> ble_db_discovery_cached_start() serves the discovery from an FDS record when the
+// <i> peer's Database Hash matches the one stored with it. Requires FDS.
+//==========================================================
+#ifndef BLE_DB_DISCOVERY_CACHE_ENABLED
+#define BLE_DB_DISCOVERY_CACHE_ENABLED 0
+#endif
+// <o> BLE_DB_DISCOVERY_CACHE_FILE_ID - FDS file ID used for the cache records <0x0000-0xBFFF>
+#ifndef BLE_DB_DISCOVERY_CACHE_FILE_ID
+#define BLE_DB_DISCOVERY_CACHE_FILE_ID 0x0DBC
+#endif
+
+// </e>
+
+// </e>
+
+// <e> NRF_BLE_GQ_ENABLED - nrf_ble_gq - BLE GATT Queue Module
+//==========================================================
+#ifndef NRF_BLE_GQ_ENABLED
+#define NRF_BLE_GQ_ENABLED 0
+#endif
+// <o> NRF_BLE_GQ_DATAPOOL_ELEMENT_SIZE - Default size of a single element in the pool of memory objects.
+#ifndef NRF_BLE_GQ_DATAPOOL_ELEMENT_SIZE
+#define NRF_BLE_GQ_DATAPOOL_ELEMENT_SIZE 20
+#endif
+
+// <o> NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT - Default number of elements in the pool of memory objects.
+#ifndef NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT
+#define NRF_BLE_GQ_DATAPOOL_ELEMENT_COUNT 8
+#endif
+
+// <o> NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN - Maximal size of the data inside GATTC write request (in bytes).
+#ifndef NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN
+#define NRF_BLE_GQ_GATTC_WRITE_MAX_DATA_LEN 16
+#endif
+
+// <o> NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN - Maximal size of the data inside GATTC notification or indication request (in bytes).
+#ifndef NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN
+#define NRF_BLE_GQ_GATTS_HVX_MAX_DATA_LEN 16
+#endif
+
+// <o> NRF_BLE_GQ_DEFAULT_WEIGHT - Requests submitted from the queue of a connection in one scheduling round.  <1-255>
+// <i> Used until the weight is changed with nrf_ble_gq_conn_weight_set().
+
+#ifndef NRF_BLE_GQ_DEFAULT_WEIGHT
+#define NRF_BLE_GQ_DEFAULT_WEIGHT 1
+#endif
+
+// <q> NRF_BLE_GQ_LATENCY_STATS_ENABLED  - Measure the time requests spend in the queue.
+// <i> Requires the app_timer library.
+
+#ifndef NRF_BLE_GQ_LATENCY_STATS_ENABLED
+#define NRF_BLE_GQ_LATENCY_STATS_ENABLED 0
+#endif
+
+// </e>
+
+// <e> PEER_MANAGER_ENABLED - peer_manager - Peer Manager
+//==========================================================
+#ifndef PEER_MANAGER_ENABLED
+#define PEER_MANAGER_ENABLED 0
+#endif
+// <o> PM_PEER_DATA_CACHE_SIZE - Number of peer data records whose location in flash is kept in RAM.
+// <i> Repeated reads of a cached record do not search the flash. 0 disables the cache.
+
+#ifndef PM_PEER_DATA_CACHE_SIZE
+#define PM_PEER_DATA_CACHE_SIZE 8
+#endif
+
+// <e> PM_LOCAL_DB_COALESCE_ENABLED - Store CCCD changes of bonded peers once instead of on every write.
+
+// <i> A CCCD write only marks the connection. The system attributes are stored on
+// <i> disconnection, on pm_local_db_cache_flush(), or after a quiet period. Unstored
+// <i> changes are lost on reset.
+//==========================================================
+#ifndef PM_LOCAL_DB_COALESCE_ENABLED
+#define PM_LOCAL_DB_COALESCE_ENABLED 0
+#endif
+// <o> PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS - Time without CCCD writes after which the changes are stored (in milliseconds).
+// <i> 0 disables the timer. Otherwise the app_timer library is required.
+
+#ifndef PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS
+#define PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS 0
+#endif
+
+// </e>
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> nRF_BLE_Services
+
+//==========================================================
+// <e> BLE_NUS_ENABLED - ble_nus - Nordic UART Service
+//==========================================================
+#ifndef BLE_NUS_ENABLED
+#define BLE_NUS_ENABLED 0
+#endif
+// <e> BLE_NUS_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef BLE_NUS_CONFIG_LOG_ENABLED
+#define BLE_NUS_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> nRF_DFU
+
+//==========================================================
+// <h> DFU security - nrf_dfu_validation DFU validation
+
+//==========================================================
+// <o> NRF_DFU_VALIDATION_ECDSA_PRECOMPUTE  - Data precomputed for the signing public key.
+
+// <i> Precomputed data is only kept by crypto backends that support it (mbed TLS) and takes
+// <i> RAM for as long as the bootloader runs. See nrf_crypto_ecdsa_precompute_t.
+// <0=> None
+// <1=> Curve generator
+
+#ifndef NRF_DFU_VALIDATION_ECDSA_PRECOMPUTE
+#define NRF_DFU_VALIDATION_ECDSA_PRECOMPUTE 0
+#endif
+
+// </h>
+//==========================================================
+
+// </h>
+//==========================================================
+
+// <h> nRF_Drivers
+
+//==========================================================
+// <e> NRFX_PPI_ENABLED - nrfx_ppi - PPI peripheral allocator
+//==========================================================
+#ifndef NRFX_PPI_ENABLED
+#define NRFX_PPI_ENABLED 0
+#endif
+// <e> NRFX_PPI_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRFX_PPI_CONFIG_LOG_ENABLED
+#define NRFX_PPI_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// <e> NRFX_RTC_ENABLED - nrfx_rtc - RTC peripheral driver
+//==========================================================
+#ifndef NRFX_RTC_ENABLED
+#define NRFX_RTC_ENABLED 0
+#endif
+// <q> NRFX_RTC0_ENABLED  - Enable RTC0 instance
+
+#ifndef NRFX_RTC0_ENABLED
+#define NRFX_RTC0_ENABLED 0
+#endif
+
+// <q> NRFX_RTC1_ENABLED  - Enable RTC1 instance
+
+#ifndef NRFX_RTC1_ENABLED
+#define NRFX_RTC1_ENABLED 0
+#endif
+
+// <q> NRFX_RTC2_ENABLED  - Enable RTC2 instance
+
+#ifndef NRFX_RTC2_ENABLED
+#define NRFX_RTC2_ENABLED 0
+#endif
+
+// <o> NRFX_RTC_MAXIMUM_LATENCY_US - Maximum possible time[us] in highest priority interrupt
+#ifndef NRFX_RTC_MAXIMUM_LATENCY_US
+#define NRFX_RTC_MAXIMUM_LATENCY_US 2000
+#endif
+
+// <o> NRFX_RTC_DEFAULT_CONFIG_FREQUENCY - Frequency  <16-32768>
+
+#ifndef NRFX_RTC_DEFAULT_CONFIG_FREQUENCY
+#define NRFX_RTC_DEFAULT_CONFIG_FREQUENCY 32768
+#endif
+
+// <q> NRFX_RTC_DEFAULT_CONFIG_RELIABLE  - Ensures safe compare event triggering
+
+#ifndef NRFX_RTC_DEFAULT_CONFIG_RELIABLE
+#define NRFX_RTC_DEFAULT_CONFIG_RELIABLE 0
+#endif
+
+// <o> NRFX_RTC_DEFAULT_CONFIG_IRQ_PRIORITY  - Interrupt priority
+
+// <0=> 0 (highest)
+// <1=> 1
+// <2=> 2
+// <3=> 3
+// <4=> 4
+// <5=> 5
+// <6=> 6
+// <7=> 7
+
+#ifndef NRFX_RTC_DEFAULT_CONFIG_IRQ_PRIORITY
+#define NRFX_RTC_DEFAULT_CONFIG_IRQ_PRIORITY 6
+#endif
+
+// <e> NRFX_RTC_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRFX_RTC_CONFIG_LOG_ENABLED
+#define NRFX_RTC_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// <e> NRFX_TIMER_ENABLED - nrfx_timer - TIMER periperal driver
+//==========================================================
+#ifndef NRFX_TIMER_ENABLED
+#define NRFX_TIMER_ENABLED 0
+#endif
+// <q> NRFX_TIMER0_ENABLED  - Enable TIMER0 instance
+
+#ifndef NRFX_TIMER0_ENABLED
+#define NRFX_TIMER0_ENABLED 0
+#endif
+
+// <q> NRFX_TIMER1_ENABLED  - Enable TIMER1 instance
+
+#ifndef NRFX_TIMER1_ENABLED
+#define NRFX_TIMER1_ENABLED 0
+#endif
+
+// <q> NRFX_TIMER2_ENABLED  - Enable TIMER2 instance
+
+#ifndef NRFX_TIMER2_ENABLED
+#define NRFX_TIMER2_ENABLED 0
+#endif
+
+// <q> NRFX_TIMER3_ENABLED  - Enable TIMER3 instance
+
+#ifndef NRFX_TIMER3_ENABLED
+#define NRFX_TIMER3_ENABLED 0
+#endif
+
+// <q> NRFX_TIMER4_ENABLED  - Enable TIMER4 instance
+
+#ifndef NRFX_TIMER4_ENABLED
+#define NRFX_TIMER4_ENABLED 0
+#endif
+
+// <o> NRFX_TIMER_DEFAULT_CONFIG_FREQUENCY  - Timer frequency if in Timer mode
+
+// <0=> 16 MHz
+// <1=> 8 MHz
+// <2=> 4 MHz
+// <3=> 2 MHz
+// <4=> 1 MHz
+// <5=> 500 kHz
+// <6=> 250 kHz
+// <7=> 125 kHz
+// <8=> 62.5 kHz
+// <9=> 31.25 kHz
+
+#ifndef NRFX_TIMER_DEFAULT_CONFIG_FREQUENCY
+#define NRFX_TIMER_DEFAULT_CONFIG_FREQUENCY 0
+#endif
+
+// <o> NRFX_TIMER_DEFAULT_CONFIG_MODE  - Timer mode or operation
+
+// <0=> Timer
+// <1=> Counter
+
+#ifndef NRFX_TIMER_DEFAULT_CONFIG_MODE
+#define NRFX_TIMER_DEFAULT_CONFIG_MODE 0
+#endif
+
+// <o> NRFX_TIMER_DEFAULT_CONFIG_BIT_WIDTH  - Timer counter bit width
+
+// <0=> 16 bit
+// <1=> 8 bit
+// <2=> 24 bit
+// <3=> 32 bit
+
+#ifndef NRFX_TIMER_DEFAULT_CONFIG_BIT_WIDTH
+#define NRFX_TIMER_DEFAULT_CONFIG_BIT_WIDTH 0
+#endif
+
+// <o> NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY  - Interrupt priority
+
+// <0=> 0 (highest)
+// <1=> 1
+// <2=> 2
+// <3=> 3
+// <4=> 4
+// <5=> 5
+// <6=> 6
+// <7=> 7
+
+#ifndef NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY
+#define NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY 6
+#endif
+
+// <e> NRFX_TIMER_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRFX_TIMER_CONFIG_LOG_ENABLED
+#define NRFX_TIMER_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// <e> NRFX_UARTE_ENABLED - nrfx_uarte - UARTE peripheral driver
+//==========================================================
+#ifndef NRFX_UARTE_ENABLED
+#define NRFX_UARTE_ENABLED 0
+#endif
+// <o> NRFX_UARTE0_ENABLED - Enable UARTE0 instance
+#ifndef NRFX_UARTE0_ENABLED
+#define NRFX_UARTE0_ENABLED 0
+#endif
+
+// <o> NRFX_UARTE1_ENABLED - Enable UARTE1 instance
+#ifndef NRFX_UARTE1_ENABLED
+#define NRFX_UARTE1_ENABLED 0
+#endif
+
+// <o> NRFX_UARTE_DEFAULT_CONFIG_HWFC  - Hardware Flow Control
+
+// <0=> Disabled
+// <1=> Enabled
+
+#ifndef NRFX_UARTE_DEFAULT_CONFIG_HWFC
+#define NRFX_UARTE_DEFAULT_CONFIG_HWFC 0
+#endif
+
+// <o> NRFX_UARTE_DEFAULT_CONFIG_PARITY  - Parity
+
+// <0=> Excluded
+// <14=> Included
+
+#ifndef NRFX_UARTE_DEFAULT_CONFIG_PARITY
+#define NRFX_UARTE_DEFAULT_CONFIG_PARITY 0
+#endif
+
+// <o> NRFX_UARTE_DEFAULT_CONFIG_BAUDRATE  - Default Baudrate
+
+// <323584=> 1200 baud
+// <643072=> 2400 baud
+// <1290240=> 4800 baud
+// <2576384=> 9600 baud
+// <3862528=> 14400 baud
+// <5152768=> 19200 baud
+// <7716864=> 28800 baud
+// <8388608=> 31250 baud
+// <10289152=> 38400 baud
+// <15007744=> 56000 baud
+// <15400960=> 57600 baud
+// <20615168=> 76800 baud
+// <30801920=> 115200 baud
+// <61865984=> 230400 baud
+// <67108864=> 250000 baud
+// <121634816=> 460800 baud
+// <251658240=> 921600 baud
+// <268435456=> 1000000 baud
+
+#ifndef NRFX_UARTE_DEFAULT_CONFIG_BAUDRATE
+#define NRFX_UARTE_DEFAULT_CONFIG_BAUDRATE 30801920
+#endif
+
+// <o> NRFX_UARTE_DEFAULT_CONFIG_IRQ_PRIORITY  - Interrupt priority
+
+// <0=> 0 (highest)
+// <1=> 1
+// <2=> 2
+// <3=> 3
+// <4=> 4
+// <5=> 5
+// <6=> 6
+// <7=> 7
+
+#ifndef NRFX_UARTE_DEFAULT_CONFIG_IRQ_PRIORITY
+#define NRFX_UARTE_DEFAULT_CONFIG_IRQ_PRIORITY 6
+#endif
+
+// <e> NRFX_UARTE_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRFX_UARTE_CONFIG_LOG_ENABLED
+#define NRFX_UARTE_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> nRF_IoT
+
+//==========================================================
+// <h> NRF_LWIP_DRIVER - lwIP driver
+
+//==========================================================
+// <e> NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED - Serve lwIP allocations from nrf_balloc pools.
+
+// <i> mem_malloc() takes each request from the smallest fitting pool instead of the memory
+// <i> manager heap, so lwIP memory is fully reserved at compile time.
+//==========================================================
+#ifndef NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED
+#define NRF_LWIP_DRIVER_CONFIG_BALLOC_ENABLED 0
+#endif
+// <o> NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_SIZE - Size of a small block (pbuf headers, TCP segments, timeouts).
+#ifndef NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_SIZE
+#define NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_SIZE 32
+#endif
+
+// <o> NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_COUNT - Number of small blocks.
+#ifndef NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_COUNT
+#define NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_COUNT 24
+#endif
+
+// <o> NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_SIZE - Size of a medium block (UDP and TCP PCBs).
+#ifndef NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_SIZE
+#define NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_SIZE 192
+#endif
+
+// <o> NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_COUNT - Number of medium blocks.
+#ifndef NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_COUNT
+#define NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_COUNT 6
+#endif
+
+// <o> NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_SIZE - Size of a large block (PBUF_RAM pbufs up to the IPv6 minimum MTU).
+#ifndef NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_SIZE
+#define NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_SIZE 1344
+#endif
+
+// <o> NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_COUNT - Number of large blocks.
+#ifndef NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_COUNT
+#define NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_COUNT 6
+#endif
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> NRF_TLS - nrf_tls session cache
+
+//==========================================================
+// <o> NRF_TLS_SESSION_CACHE_SIZE - Number of sessions kept for resumption.
+// <i> Zero disables session resumption.
+
+#ifndef NRF_TLS_SESSION_CACHE_SIZE
+#define NRF_TLS_SESSION_CACHE_SIZE 2
+#endif
+
+// <o> NRF_TLS_SESSION_CACHE_TIMEOUT - Time in milliseconds after which a cached session is no longer resumed.
+#ifndef NRF_TLS_SESSION_CACHE_TIMEOUT
+#define NRF_TLS_SESSION_CACHE_TIMEOUT 86400000
+#endif
+
+// <o> NRF_TLS_SESSION_CACHE_TICKET_MAX_LEN - Maximum length of a cached session ticket.
+// <i> A session with a longer ticket is cached without it and can only be resumed by its
+// <i> session ID. Tickets are only used if MBEDTLS_SSL_SESSION_TICKETS is enabled in the
+// <i> mbed TLS configuration.
+
+#ifndef NRF_TLS_SESSION_CACHE_TICKET_MAX_LEN
+#define NRF_TLS_SESSION_CACHE_TICKET_MAX_LEN 192
+#endif
+
+// <e> NRF_TLS_SESSION_CACHE_FDS_ENABLED - Store client sessions in flash using FDS.
+
+// <i> Stored sessions can be resumed after a reset. The master secret is stored unencrypted,
+// <i> so enable only if the flash is protected against readout.
+//==========================================================
+#ifndef NRF_TLS_SESSION_CACHE_FDS_ENABLED
+#define NRF_TLS_SESSION_CACHE_FDS_ENABLED 0
+#endif
+// <o> NRF_TLS_SESSION_CACHE_FDS_FILE_ID - FDS file used for the stored client sessions.
+#ifndef NRF_TLS_SESSION_CACHE_FDS_FILE_ID
+#define NRF_TLS_SESSION_CACHE_FDS_FILE_ID 0x7E5C
+#endif
+
+// </e>
+
+// </h>
+//==========================================================
+
+// </h>
+//==========================================================
+
+// <h> nRF_Libraries
+
+//==========================================================
+// <e> APP_TIMER_ENABLED - app_timer - Application timer functionality
+//==========================================================
+#ifndef APP_TIMER_ENABLED
+#define APP_TIMER_ENABLED 0
+#endif
+// <o> APP_TIMER_CONFIG_RTC_FREQUENCY  - Configure RTC prescaler.
+
+// <0=> 32768 Hz
+// <1=> 16384 Hz
+// <3=> 8192 Hz
+// <7=> 4096 Hz
+// <15=> 2048 Hz
+// <31=> 1024 Hz
+
+#ifndef APP_TIMER_CONFIG_RTC_FREQUENCY
+#define APP_TIMER_CONFIG_RTC_FREQUENCY 0
+#endif
+
+// <o> APP_TIMER_CONFIG_IRQ_PRIORITY  - Interrupt priority
+
+
+// <i> Priorities 0,2 (nRF51) and 0,1,4,5 (nRF52) are reserved for SoftDevice
+// <0=> 0 (highest)
+// <1=> 1
+// <2=> 2
+// <3=> 3
+// <4=> 4
+// <5=> 5
+// <6=> 6
+// <7=> 7
+
+#ifndef APP_TIMER_CONFIG_IRQ_PRIORITY
+#define APP_TIMER_CONFIG_IRQ_PRIORITY 6
+#endif
+
+// <o> APP_TIMER_CONFIG_OP_QUEUE_SIZE - Capacity of timer requests queue.
+// <i> Size of the queue depends on how many timers are used
+// <i> in the system, how often timers are started and overall
+// <i> system latency. If queue size is too small app_timer calls
+// <i> will fail.
+
+#ifndef APP_TIMER_CONFIG_OP_QUEUE_SIZE
+#define APP_TIMER_CONFIG_OP_QUEUE_SIZE 10
+#endif
+
+// <q> APP_TIMER_CONFIG_USE_SCHEDULER  - Enable scheduling app_timer events to app_scheduler
+
+
+#ifndef APP_TIMER_CONFIG_USE_SCHEDULER
+#define APP_TIMER_CONFIG_USE_SCHEDULER 0
+#endif
+
+// <q> APP_TIMER_KEEPS_RTC_ACTIVE  - Enable RTC always on
+
+
+// <i> If option is enabled RTC is kept running even if there is no active timers.
+// <i> This option can be used when app_timer is used for timestamping.
+
+#ifndef APP_TIMER_KEEPS_RTC_ACTIVE
+#define APP_TIMER_KEEPS_RTC_ACTIVE 0
+#endif
+
+// <o> APP_TIMER_SAFE_WINDOW_MS - Maximum possible latency (in milliseconds) of handling app_timer event.
+// <i> Maximum possible timeout that can be set is reduced by safe window.
+// <i> Example: RTC frequency 16384 Hz, maximum possible timeout 1024 seconds - APP_TIMER_SAFE_WINDOW_MS.
+// <i> Since RTC is not stopped when processor is halted in debugging session, this value
+// <i> must cover it if debugging is needed. It is possible to halt processor for APP_TIMER_SAFE_WINDOW_MS
+// <i> without corrupting app_timer behavior.
+
+#ifndef APP_TIMER_SAFE_WINDOW_MS
+#define APP_TIMER_SAFE_WINDOW_MS 300000
+#endif
+
+// <e> APP_TIMER_CONFIG_USE_HEAP - Keep active timers in a binary heap instead of a sorted list.
+
+// <i> Sorted list insertion is linear in the number of active timers while the heap
+// <i> needs a logarithmic number of steps for insertion, removal and popping the earliest
+// <i> timer. The heap is worth enabling when tens of timers are running at the same time.
+//==========================================================
+#ifndef APP_TIMER_CONFIG_USE_HEAP
+#define APP_TIMER_CONFIG_USE_HEAP 0
+#endif
+// <o> APP_TIMER_CONFIG_HEAP_SIZE - Maximum number of simultaneously active timers. <1-65535>
+#ifndef APP_TIMER_CONFIG_HEAP_SIZE
+#define APP_TIMER_CONFIG_HEAP_SIZE 32
+#endif
+
+// </e>
+
+// <q> APP_TIMER_WITH_PROFILER  - Enable app_timer profiling
+
+
+#ifndef APP_TIMER_WITH_PROFILER
+#define APP_TIMER_WITH_PROFILER 0
+#endif
+
+// </e>
+
+// <e> APP_USBD_AUDIO_ENABLED - app_usbd_audio - USB AUDIO class
+//==========================================================
+#ifndef APP_USBD_AUDIO_ENABLED
+#define APP_USBD_AUDIO_ENABLED 0
+#endif
+// <o> APP_USBD_AUDIO_FEEDBACK_REFRESH - Feedback endpoint refresh period, as a power of two of frames <1-9>
+
+// <i> Reported in the bRefresh field of the feedback endpoint descriptor.
+// <i> The feedback value should be sent at least this often.
+
+#ifndef APP_USBD_AUDIO_FEEDBACK_REFRESH
+#define APP_USBD_AUDIO_FEEDBACK_REFRESH 5
+#endif
+
+// </e>
+
+// <e> NRF_BALLOC_ENABLED - nrf_balloc - Block allocator module
+//==========================================================
+#ifndef NRF_BALLOC_ENABLED
+#define NRF_BALLOC_ENABLED 0
+#endif
+// <e> NRF_BALLOC_CONFIG_DEBUG_ENABLED - Enables debug mode in the module.
+//==========================================================
+#ifndef NRF_BALLOC_CONFIG_DEBUG_ENABLED
+#define NRF_BALLOC_CONFIG_DEBUG_ENABLED 0
+#endif
+// </e>
+
+// <e> NRF_BALLOC_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRF_BALLOC_CONFIG_LOG_ENABLED
+#define NRF_BALLOC_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// <e> NRF_FSTORAGE_ENABLED - nrf_fstorage - Flash abstraction library
+//==========================================================
+#ifndef NRF_FSTORAGE_ENABLED
+#define NRF_FSTORAGE_ENABLED 0
+#endif
+// <h> nrf_fstorage - Common settings
+
+// <i> Common settings to all fstorage implementations
+//==========================================================
+// <q> NRF_FSTORAGE_PARAM_CHECK_DISABLED  - Disable user input validation
+
+
+// <i> If selected, use ASSERT to validate user input.
+// <i> This effectively removes user input validation in production code.
+// <i> Recommended setting: OFF, only enable for debugging purposes.
+
+#ifndef NRF_FSTORAGE_PARAM_CHECK_DISABLED
+#define NRF_FSTORAGE_PARAM_CHECK_DISABLED 0
+#endif
+
+// </h>
+//==========================================================
+
+// <h> nrf_fstorage_sd - Implementation using the SoftDevice
+
+// <i> Configuration options for the fstorage implementation using the SoftDevice
+//==========================================================
+// <o> NRF_FSTORAGE_SD_QUEUE_SIZE - Size of the internal queue of operations
+// <i> Increase this value if API calls frequently return the error @ref NRF_ERROR_NO_MEM.
+
+#ifndef NRF_FSTORAGE_SD_QUEUE_SIZE
+#define NRF_FSTORAGE_SD_QUEUE_SIZE 4
+#endif
+
+// <o> NRF_FSTORAGE_SD_MAX_RETRIES - Maximum number of attempts at executing an operation when the SoftDevice is busy
+// <i> Increase this value if events frequently return the @ref NRF_ERROR_TIMEOUT error.
+// <i> The SoftDevice might fail to schedule flash access due to high BLE activity.
+
+#ifndef NRF_FSTORAGE_SD_MAX_RETRIES
+#define NRF_FSTORAGE_SD_MAX_RETRIES 8
+#endif
+
+// <o> NRF_FSTORAGE_SD_MAX_WRITE_SIZE - Maximum number of bytes to be written to flash in a single operation
+// <i> This value must be a multiple of four.
+// <i> Lowering this value can increase the chances of the SoftDevice being able to execute flash operations in between radio activity.
+// <i> This value is bound by the maximum number of bytes which can be written to flash in a single call to @ref sd_flash_write.
+// <i> That is 1024 bytes for nRF51 ICs and 4096 bytes for nRF52 ICs.
+
+#ifndef NRF_FSTORAGE_SD_MAX_WRITE_SIZE
+#define NRF_FSTORAGE_SD_MAX_WRITE_SIZE 4096
+#endif
+
+// <e> NRF_FSTORAGE_SD_WRITE_COMBINE - Combine queued contiguous writes into one flash operation
+
+// <i> Writes waiting on the queue that continue the current write are staged into one buffer
+// <i> of NRF_FSTORAGE_SD_MAX_WRITE_SIZE bytes and written in a single SoftDevice timeslot.
+// <i> Every write still gets its own event.
+//==========================================================
+#ifndef NRF_FSTORAGE_SD_WRITE_COMBINE
+#define NRF_FSTORAGE_SD_WRITE_COMBINE 0
+#endif
+// <o> NRF_FSTORAGE_SD_COMBINE_MAX_OPS - Maximum number of writes combined into one flash operation <2-255>
+#ifndef NRF_FSTORAGE_SD_COMBINE_MAX_OPS
+#define NRF_FSTORAGE_SD_COMBINE_MAX_OPS 8
+#endif
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> nrf_fstorage_ram - Implementation emulating NOR flash in RAM
+
+// <i> Configuration options for the fstorage implementation used on a host
+//==========================================================
+// <o> NRF_FSTORAGE_RAM_BASE_ADDR - Device address of the first byte of the emulated flash
+#ifndef NRF_FSTORAGE_RAM_BASE_ADDR
+#define NRF_FSTORAGE_RAM_BASE_ADDR 0
+#endif
+
+// <o> NRF_FSTORAGE_RAM_PAGE_SIZE - Size of a page of the emulated flash (in bytes)
+#ifndef NRF_FSTORAGE_RAM_PAGE_SIZE
+#define NRF_FSTORAGE_RAM_PAGE_SIZE 4096
+#endif
+
+// <o> NRF_FSTORAGE_RAM_SIZE - Size of the emulated flash (in bytes)
+// <i> Must be a multiple of NRF_FSTORAGE_RAM_PAGE_SIZE.
+
+#ifndef NRF_FSTORAGE_RAM_SIZE
+#define NRF_FSTORAGE_RAM_SIZE 262144
+#endif
+
+// <o> NRF_FSTORAGE_RAM_WRITE_TIME_US - Default time needed to program one word (in microseconds)
+#ifndef NRF_FSTORAGE_RAM_WRITE_TIME_US
+#define NRF_FSTORAGE_RAM_WRITE_TIME_US 41
+#endif
+
+// <o> NRF_FSTORAGE_RAM_ERASE_TIME_US - Default time needed to erase one page (in microseconds)
+#ifndef NRF_FSTORAGE_RAM_ERASE_TIME_US
+#define NRF_FSTORAGE_RAM_ERASE_TIME_US 85000
+#endif
+
+// <q> NRF_FSTORAGE_RAM_STRICT_NOR  - Reject writes which would need to change a bit from 0 to 1
+
+// <i> If disabled, such writes are performed like the hardware does it:
+// <i> the new data is ANDed with the flash contents. Both ways count them in the statistics.
+
+#ifndef NRF_FSTORAGE_RAM_STRICT_NOR
+#define NRF_FSTORAGE_RAM_STRICT_NOR 1
+#endif
+
+// <q> NRF_FSTORAGE_RAM_FILE_SUPPORT  - Allow backing the emulated flash by a memory mapped file
+
+// <i> Requires a POSIX host.
+
+#ifndef NRF_FSTORAGE_RAM_FILE_SUPPORT
+#define NRF_FSTORAGE_RAM_FILE_SUPPORT 0
+#endif
+
+// </h>
+//==========================================================
+
+// </e>
+
+// <e> NRF_SORTLIST_ENABLED - nrf_sortlist - Sorted list
+//==========================================================
+#ifndef NRF_SORTLIST_ENABLED
+#define NRF_SORTLIST_ENABLED 0
+#endif
+// <e> NRF_SORTLIST_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRF_SORTLIST_CONFIG_LOG_ENABLED
+#define NRF_SORTLIST_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// <q> NRF_LIBUARTE_ASYNC_WITH_APP_TIMER  - nrf_libuarte_async - libUARTE_async library
+
+#ifndef NRF_LIBUARTE_ASYNC_WITH_APP_TIMER
+#define NRF_LIBUARTE_ASYNC_WITH_APP_TIMER 0
+#endif
+
+// <o> NRF_LIBUARTE_ASYNC_TX_QUEUE_SIZE - Number of TX buffers queued behind the one being transferred.
+#ifndef NRF_LIBUARTE_ASYNC_TX_QUEUE_SIZE
+#define NRF_LIBUARTE_ASYNC_TX_QUEUE_SIZE 4
+#endif
+
+// <h> nrf_libuarte_drv - libUARTE_drv library
+
+//==========================================================
+// <q> NRF_LIBUARTE_DRV_HWFC_ENABLED  - Enable HWFC support in the driver
+
+#ifndef NRF_LIBUARTE_DRV_HWFC_ENABLED
+#define NRF_LIBUARTE_DRV_HWFC_ENABLED 0
+#endif
+
+// <q> NRF_LIBUARTE_DRV_UARTE0  - UARTE0 instance
+
+#ifndef NRF_LIBUARTE_DRV_UARTE0
+#define NRF_LIBUARTE_DRV_UARTE0 0
+#endif
+
+// <q> NRF_LIBUARTE_DRV_UARTE1  - UARTE1 instance
+
+#ifndef NRF_LIBUARTE_DRV_UARTE1
+#define NRF_LIBUARTE_DRV_UARTE1 0
+#endif
+
+// <e> NRF_QUEUE_ENABLED - nrf_queue - Queue module
+//==========================================================
+#ifndef NRF_QUEUE_ENABLED
+#define NRF_QUEUE_ENABLED 0
+#endif
+// <q> NRF_QUEUE_CLI_CMDS  - Enable CLI commands specific to the module
+
+#ifndef NRF_QUEUE_CLI_CMDS
+#define NRF_QUEUE_CLI_CMDS 0
+#endif
+
+// <e> NRF_QUEUE_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRF_QUEUE_CONFIG_LOG_ENABLED
+#define NRF_QUEUE_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <e> NRF_LIBUARTE_CONFIG_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NRF_LIBUARTE_CONFIG_LOG_ENABLED
+#define NRF_LIBUARTE_CONFIG_LOG_ENABLED 0
+#endif
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> nRF_Log
+
+//==========================================================
+// <e> NRF_LOG_ENABLED - nrf_log - Logger
+//==========================================================
+#ifndef NRF_LOG_ENABLED
+#define NRF_LOG_ENABLED 0
+#endif
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> nRF_NFC
+
+//==========================================================
+// <e> NFC_NDEF_MSG_ENABLED - nfc_ndef_msg - NFC NDEF Message generator module
+//==========================================================
+#ifndef NFC_NDEF_MSG_ENABLED
+#define NFC_NDEF_MSG_ENABLED 0
+#endif
+// <o> NFC_NDEF_MSG_TAG_TYPE  - NFC Tag Type.
+
+// <2=> Type 2 Tag
+// <4=> Type 4 Tag
+
+#ifndef NFC_NDEF_MSG_TAG_TYPE
+#define NFC_NDEF_MSG_TAG_TYPE 2
+#endif
+
+// </e>
+
+// <e> NFC_NDEF_MSG_PARSER_ENABLED - nfc_ndef_msg_parser - NFC NDEF message parser module
+//==========================================================
+#ifndef NFC_NDEF_MSG_PARSER_ENABLED
+#define NFC_NDEF_MSG_PARSER_ENABLED 0
+#endif
+// <e> NFC_NDEF_MSG_PARSER_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NFC_NDEF_MSG_PARSER_LOG_ENABLED
+#define NFC_NDEF_MSG_PARSER_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// <q> NFC_NDEF_RECORD_ENABLED  - nfc_ndef_record - NFC NDEF Record generator module
+
+#ifndef NFC_NDEF_RECORD_ENABLED
+#define NFC_NDEF_RECORD_ENABLED 0
+#endif
+
+// <e> NFC_NDEF_RECORD_PARSER_ENABLED - nfc_ndef_record_parser - NFC NDEF Record parser module
+//==========================================================
+#ifndef NFC_NDEF_RECORD_PARSER_ENABLED
+#define NFC_NDEF_RECORD_PARSER_ENABLED 0
+#endif
+// <e> NFC_NDEF_RECORD_PARSER_LOG_ENABLED - Enables logging in the module.
+//==========================================================
+#ifndef NFC_NDEF_RECORD_PARSER_LOG_ENABLED
+#define NFC_NDEF_RECORD_PARSER_LOG_ENABLED 0
+#endif
+// </e>
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <h> nRF_SoftDevice
+
+//==========================================================
+// <e> NRF_SDH_BLE_ENABLED - nrf_sdh_ble - SoftDevice BLE event handler
+//==========================================================
+#ifndef NRF_SDH_BLE_ENABLED
+#define NRF_SDH_BLE_ENABLED 0
+#endif
+// <h> BLE Stack configuration - Stack configuration parameters
+
+// <i> The SoftDevice handler will configure the stack with these parameters when calling @ref nrf_sdh_ble_default_cfg_set.
+// <i> Other libraries might depend on these values; keep them up-to-date even if you are not explicitely calling @ref nrf_sdh_ble_default_cfg_set.
+//==========================================================
+// <o> NRF_SDH_BLE_PERIPHERAL_LINK_COUNT - Maximum number of peripheral links.
+#ifndef NRF_SDH_BLE_PERIPHERAL_LINK_COUNT
+#define NRF_SDH_BLE_PERIPHERAL_LINK_COUNT 1
+#endif
+
+// <o> NRF_SDH_BLE_CENTRAL_LINK_COUNT - Maximum number of central links.
+#ifndef NRF_SDH_BLE_CENTRAL_LINK_COUNT
+#define NRF_SDH_BLE_CENTRAL_LINK_COUNT 0
+#endif
+
+// <o> NRF_SDH_BLE_TOTAL_LINK_COUNT - Total link count.
+// <i> Maximum number of total concurrent connections using the default configuration.
+
+#ifndef NRF_SDH_BLE_TOTAL_LINK_COUNT
+#define NRF_SDH_BLE_TOTAL_LINK_COUNT 1
+#endif
+
+// <o> NRF_SDH_BLE_GATT_MAX_MTU_SIZE - Static maximum MTU size.
+#ifndef NRF_SDH_BLE_GATT_MAX_MTU_SIZE
+#define NRF_SDH_BLE_GATT_MAX_MTU_SIZE 23
+#endif
+
+// </h>
+//==========================================================
+
+// <h> BLE Observers - Observers and priority levels
+
+//==========================================================
+// <o> NRF_SDH_BLE_OBSERVER_PRIO_LEVELS - Total number of priority levels for BLE observers.
+// <i> This setting configures the number of priority levels available for BLE event handlers.
+// <i> The priority level of a handler determines the order in which it receives events, with respect to other handlers.
+
+#ifndef NRF_SDH_BLE_OBSERVER_PRIO_LEVELS
+#define NRF_SDH_BLE_OBSERVER_PRIO_LEVELS 4
+#endif
+
+// <h> BLE Observers priorities - Invididual priorities
+
+//==========================================================
+// <o> NRF_BLE_GQ_BLE_OBSERVER_PRIO
+// <i> Priority with which BLE events are dispatched to the GATT Queue module.
+
+#ifndef NRF_BLE_GQ_BLE_OBSERVER_PRIO
+#define NRF_BLE_GQ_BLE_OBSERVER_PRIO 1
+#endif
+
+// <o> BLE_NUS_BLE_OBSERVER_PRIO
+// <i> Priority with which BLE events are dispatched to the UART Service.
+
+#ifndef BLE_NUS_BLE_OBSERVER_PRIO
+#define BLE_NUS_BLE_OBSERVER_PRIO 2
+#endif
+
+// </h>
+//==========================================================
+
+// </h>
+//==========================================================
+
+// </e>
+
+// </h>
+//==========================================================
+
+// <<< end of configuration section >>>
+#endif //SDK_CONFIG_H
+
@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host run of the nrf_crypto test_app benchmark test case against the mbed TLS backend.
+ *
+ * The test case is compiled from the test_app sources and registered in the test_case_data
+ * section, as on the device. This file provides the parts of common_test.c and of the device
+ * drivers that it uses: a microsecond timer, a stack probe and the RNG peripheral driver.
+ *
+ * The test cases run on a private stack, so that the stack probe has a known limit to paint
+ * from, like STACK_BASE on the device.
+ */
+#include <string.h>
+#include <stdarg.h>
+#include <ucontext.h>
+#include "host_test.h"
+#include "sdk_common.h"
+#include "nrf_section.h"
+#include "nrf_crypto.h"
+#include "nrf_drv_rng.h"
+#include "common_test.h"
+
+#define TEST_STACK_SIZE         (256 * 1024)    /**< Size of the stack the test cases run on. */
+#define STACK_PROBE_PATTERN     (0xA5)          /**< Value used to fill the stack area watched by @ref benchmark_stack_probe. */
+#define STACK_PROBE_MARGIN      (64)            /**< Bytes left unpainted below the frame of @ref benchmark_stack_probe. */
+#define RNG_SEED                (0x2545F491)    /**< Seed of the stubbed RNG peripheral. */
+
+NRF_SECTION_DEF(test_case_data, test_case_t);
+
+static uint8_t            m_test_stack[TEST_STACK_SIZE] __attribute__((aligned(16)));
+static ucontext_t         m_main_context;
+static ucontext_t         m_test_context;
+static uint64_t           m_benchmark_start;    /**< Time at the start of the current benchmark measurement. */
+static uint8_t volatile * mp_stack_probe_top;   /**< End of the stack area painted by @ref benchmark_stack_probe. */
+static uint32_t           m_rng_state = RNG_SEED;
+static bool               m_rng_initialized;
+static uint32_t           m_tests_passed;
+static uint32_t           m_tests_failed;
+
+
+void benchmark_timer_init(void)
+{
+}
+
+
+void benchmark_timer_start(void)
+{
+    m_benchmark_start = host_test_time_ns();
+}
+
+
+uint32_t benchmark_timer_stop(void)
+{
+    return (uint32_t)((host_test_time_ns() - m_benchmark_start) / 1000);
+}
+
+
+uint32_t benchmark_stack_probe(bool paint)
+{
+    uint8_t volatile * p_stack = m_test_stack;
+
+    if (paint)
+    {
+        // Paint the free stack, from its limit up to just below the frame of this function.
+        mp_stack_probe_top = (uint8_t volatile *)__builtin_frame_address(0) - STACK_PROBE_MARGIN;
+        TEST_ASSERT((mp_stack_probe_top > m_test_stack) &&
+                    (mp_stack_probe_top < &m_test_stack[TEST_STACK_SIZE]));
+        for ( ; p_stack < mp_stack_probe_top; p_stack++)
+        {
+            *p_stack = STACK_PROBE_PATTERN;
+        }
+        return 0;
+    }
+
+    // The stack grows downwards, so the lowest overwritten byte marks the deepest use.
+    while ((p_stack < mp_stack_probe_top) && (*p_stack == STACK_PROBE_PATTERN))
+    {
+        p_stack++;
+    }
+    // An untouched lowest byte means the probe did not overflow the private stack.
+    TEST_ASSERT(m_test_stack[0] == STACK_PROBE_PATTERN);
+    return (uint32_t)(mp_stack_probe_top - p_stack);
+}
+
+
+/* Prints a test_app log line. Arguments arrive as integers, like in the logger, and %s ones are
+ * turned back into strings. */
+void bench_log(char const * p_fmt, uint32_t argc, ...)
+{
+    va_list  args;
+    char     spec[16];
+    uint32_t used = 0;
+
+    va_start(args, argc);
+    printf("    ");
+    while (*p_fmt != '\0')
+    {
+        if (*p_fmt != '%')
+        {
+            putchar(*p_fmt++);
+            continue;
+        }
+
+        size_t len = strspn(p_fmt + 1, "-+ #0123456789.") + 2;
+        char   conv;
+
+        TEST_ASSERT(len < sizeof(spec));
+        memcpy(spec, p_fmt, len);
+        spec[len] = '\0';
+        conv      = spec[len - 1];
+        p_fmt    += len;
+
+        if (conv == '%')
+        {
+            putchar('%');
+            continue;
+        }
+
+        TEST_ASSERT(used < argc);
+        uintptr_t arg = va_arg(args, uintptr_t);
+        used++;
+
+        if (conv == 's')
+        {
+            printf(spec, (char const *)arg);
+        }
+        else
+        {
+            printf(spec, (unsigned)arg);
+        }
+    }
+    putchar('\n');
+    va_end(args);
+    TEST_ASSERT_EQUAL(argc, used);
+}
+
+
+ret_code_t nrf_drv_rng_init(nrf_drv_rng_config_t const * p_config)
+{
+    UNUSED_PARAMETER(p_config);
+    m_rng_initialized = true;
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_rng_uninit(void)
+{
+    m_rng_initialized = false;
+}
+
+
+void nrf_drv_rng_block_rand(uint8_t * p_buff, uint32_t length)
+{
+    TEST_ASSERT(m_rng_initialized);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        p_buff[i] = (uint8_t)host_test_rand(&m_rng_state);
+    }
+}
+
+
+/* Runs every registered test case, like the test_app main loop. */
+static void test_cases_run(void)
+{
+    for (size_t i = 0; i < TEST_CASE_COUNT; i++)
+    {
+        test_case_t * p_test_case = TEST_CASE_GET(i);
+        test_info_t   test_info   = { .p_test_case_name = p_test_case->p_test_case_name };
+
+        printf("    %s\n", p_test_case->p_test_case_name);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, p_test_case->setup());
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, p_test_case->exec(&test_info));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, p_test_case->teardown());
+
+        m_tests_passed += test_info.tests_passed;
+        m_tests_failed += test_info.tests_failed;
+    }
+}
+
+
+/* Runs the test_app benchmark. Every enabled algorithm must run without errors; the figures are
+ * informational, as host timing varies and the mbed TLS build is not the device one. */
+static void benchmark(void)
+{
+    TEST_ASSERT(TEST_CASE_COUNT > 0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_init());
+
+    TEST_ASSERT_EQUAL(0, getcontext(&m_test_context));
+    m_test_context.uc_stack.ss_sp   = m_test_stack;
+    m_test_context.uc_stack.ss_size = sizeof(m_test_stack);
+    m_test_context.uc_link          = &m_main_context;
+    makecontext(&m_test_context, test_cases_run, 0);
+    TEST_ASSERT_EQUAL(0, swapcontext(&m_main_context, &m_test_context));
+
+    TEST_ASSERT_EQUAL(0, m_tests_failed);
+    TEST_ASSERT(m_tests_passed > 0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_uninit());
+}
+
+
+int main(void)
+{
+    host_test_run("benchmark", benchmark);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/** @file
+ *
+ * @brief Host build of the nrf_crypto test_app benchmark test case.
+ *
+ * The test case source is compiled unchanged. Only NRF_LOG_INFO is redirected to
+ * @ref bench_log, which prints the same format strings to stdout. As with the logger, every
+ * argument is passed as an integer, so %s arguments are converted back to pointers there.
+ */
+#include <stdint.h>
+#include "nrf_log.h"
+
+void bench_log(char const * p_fmt, uint32_t argc, ...);
+
+#define BENCH_ARG(arg)                              ((uintptr_t)(arg))
+#define BENCH_LOG_0(fmt)                            bench_log(fmt, 0)
+#define BENCH_LOG_1(fmt, a0)                        bench_log(fmt, 1, BENCH_ARG(a0))
+#define BENCH_LOG_2(fmt, a0, a1)                    bench_log(fmt, 2, BENCH_ARG(a0), BENCH_ARG(a1))
+#define BENCH_LOG_3(fmt, a0, a1, a2)                bench_log(fmt, 3, BENCH_ARG(a0), BENCH_ARG(a1), \
+                                                              BENCH_ARG(a2))
+#define BENCH_LOG_4(fmt, a0, a1, a2, a3)            bench_log(fmt, 4, BENCH_ARG(a0), BENCH_ARG(a1), \
+                                                              BENCH_ARG(a2), BENCH_ARG(a3))
+#define BENCH_LOG_5(fmt, a0, a1, a2, a3, a4)        bench_log(fmt, 5, BENCH_ARG(a0), BENCH_ARG(a1), \
+                                                              BENCH_ARG(a2), BENCH_ARG(a3),         \
+                                                              BENCH_ARG(a4))
+#define BENCH_LOG_6(fmt, a0, a1, a2, a3, a4, a5)    bench_log(fmt, 6, BENCH_ARG(a0), BENCH_ARG(a1), \
+                                                              BENCH_ARG(a2), BENCH_ARG(a3),         \
+                                                              BENCH_ARG(a4), BENCH_ARG(a5))
+
+#undef  NRF_LOG_INFO
+#define NRF_LOG_INFO(...)   CONCAT_2(BENCH_LOG_, NUM_VA_ARGS_LESS_1(__VA_ARGS__))(__VA_ARGS__)
+
+#include "../../../examples/crypto/nrf_crypto/test_app/test_cases/test_benchmark.c"
@@ -0,0 +1,398 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host test of the nrf_crypto ECDSA prepared keys against the mbed TLS backend.
+ *
+ * Every curve enabled in the backend is verified with and without the precomputed table of
+ * generator multiples, and compared to @ref nrf_crypto_ecdsa_verify. The RNG peripheral driver
+ * used by key generation and signing is stubbed with a fixed seed.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "sdk_common.h"
+#include "nrf_crypto.h"
+#include "nrf_drv_rng.h"
+
+#define RNG_SEED            (0x2545F491)    /**< Seed of the stubbed RNG peripheral. */
+#define HASH_SIZE           (32)            /**< Size of the hashes signed by the test, as SHA-256. */
+#define BENCHMARK_VERIFIES  (50)            /**< Number of verifications timed per method. */
+
+static uint32_t m_rng_state = RNG_SEED;
+static bool     m_rng_initialized;
+
+/* Curves verified by mbed TLS in this build. */
+static nrf_crypto_ecc_curve_info_t const * const m_curves[] =
+{
+    &g_nrf_crypto_ecc_secp192r1_curve_info,
+    &g_nrf_crypto_ecc_secp224r1_curve_info,
+    &g_nrf_crypto_ecc_secp256r1_curve_info,
+    &g_nrf_crypto_ecc_secp384r1_curve_info,
+    &g_nrf_crypto_ecc_secp521r1_curve_info,
+    &g_nrf_crypto_ecc_secp192k1_curve_info,
+    &g_nrf_crypto_ecc_secp224k1_curve_info,
+    &g_nrf_crypto_ecc_secp256k1_curve_info,
+    &g_nrf_crypto_ecc_bp256r1_curve_info,
+    &g_nrf_crypto_ecc_bp384r1_curve_info,
+    &g_nrf_crypto_ecc_bp512r1_curve_info,
+};
+
+/* Key pair with a signature of a random hash. */
+typedef struct
+{
+    nrf_crypto_ecc_curve_info_t const * p_info;
+    nrf_crypto_ecc_raw_public_key_t     raw_public_key;
+    size_t                              raw_public_key_size;
+    nrf_crypto_ecc_public_key_t         public_key;
+    uint8_t                             hash[HASH_SIZE];
+    uint8_t                             signature[NRF_CRYPTO_ECDSA_SIGNATURE_MAX_SIZE];
+    size_t                              signature_size;
+} signed_hash_t;
+
+
+ret_code_t nrf_drv_rng_init(nrf_drv_rng_config_t const * p_config)
+{
+    UNUSED_PARAMETER(p_config);
+    m_rng_initialized = true;
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_rng_uninit(void)
+{
+    m_rng_initialized = false;
+}
+
+
+void nrf_drv_rng_block_rand(uint8_t * p_buff, uint32_t length)
+{
+    TEST_ASSERT(m_rng_initialized);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        p_buff[i] = (uint8_t)host_test_rand(&m_rng_state);
+    }
+}
+
+
+/* Generates a key pair on the curve and signs a random hash with it. */
+static void signed_hash_make(signed_hash_t * p_sh, nrf_crypto_ecc_curve_info_t const * p_info)
+{
+    nrf_crypto_ecc_private_key_t private_key;
+
+    memset(p_sh, 0, sizeof(*p_sh));
+    p_sh->p_info              = p_info;
+    p_sh->raw_public_key_size = sizeof(p_sh->raw_public_key);
+    p_sh->signature_size      = sizeof(p_sh->signature);
+
+    for (size_t i = 0; i < sizeof(p_sh->hash); i++)
+    {
+        p_sh->hash[i] = (uint8_t)host_test_rand(&m_rng_state);
+    }
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      nrf_crypto_ecc_key_pair_generate(NULL, p_info, &private_key, &p_sh->public_key));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecc_public_key_to_raw(&p_sh->public_key,
+                                                                    p_sh->raw_public_key,
+                                                                    &p_sh->raw_public_key_size));
+    TEST_ASSERT_EQUAL(p_info->raw_public_key_size, p_sh->raw_public_key_size);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_sign(NULL,
+                                                         &private_key,
+                                                         p_sh->hash,
+                                                         sizeof(p_sh->hash),
+                                                         p_sh->signature,
+                                                         &p_sh->signature_size));
+    TEST_ASSERT_EQUAL(2 * p_info->raw_private_key_size, p_sh->signature_size);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecc_private_key_free(&private_key));
+}
+
+
+static void signed_hash_free(signed_hash_t * p_sh)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecc_public_key_free(&p_sh->public_key));
+}
+
+
+/* Verifies with the prepared key and with nrf_crypto_ecdsa_verify, which must agree. */
+static ret_code_t verify_both(signed_hash_t                   * p_sh,
+                              nrf_crypto_ecdsa_prepared_key_t * p_prepared,
+                              uint8_t const                   * p_hash,
+                              uint8_t const                   * p_signature)
+{
+    ret_code_t prepared_result;
+    ret_code_t plain_result;
+
+    prepared_result = nrf_crypto_ecdsa_prepared_verify(NULL,
+                                                       p_prepared,
+                                                       p_hash,
+                                                       sizeof(p_sh->hash),
+                                                       p_signature,
+                                                       p_sh->signature_size);
+    plain_result    = nrf_crypto_ecdsa_verify(NULL,
+                                              &p_sh->public_key,
+                                              p_hash,
+                                              sizeof(p_sh->hash),
+                                              p_signature,
+                                              p_sh->signature_size);
+    TEST_ASSERT_EQUAL(plain_result, prepared_result);
+
+    return prepared_result;
+}
+
+
+/* Checks a valid signature, a tampered signature and a tampered hash with a prepared key. */
+static void curve_check(nrf_crypto_ecc_curve_info_t const * p_info,
+                        nrf_crypto_ecdsa_precompute_t       precompute)
+{
+    static signed_hash_t            sh;
+    nrf_crypto_ecdsa_prepared_key_t prepared;
+    uint8_t                         signature[NRF_CRYPTO_ECDSA_SIGNATURE_MAX_SIZE];
+    uint8_t                         hash[HASH_SIZE];
+
+    signed_hash_make(&sh, p_info);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_init(&prepared,
+                                                                      p_info,
+                                                                      sh.raw_public_key,
+                                                                      sh.raw_public_key_size,
+                                                                      precompute));
+    if (precompute == NRF_CRYPTO_ECDSA_PRECOMPUTE_NONE)
+    {
+        TEST_ASSERT(!prepared.backend_used);
+    }
+    else
+    {
+        // The comb table is filled when the key is prepared, not by the first verification.
+        TEST_ASSERT(prepared.backend_used);
+        TEST_ASSERT(prepared.backend.group.T_size > 0);
+    }
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, verify_both(&sh, &prepared, sh.hash, sh.signature));
+    // A second verification must not be affected by the state left by the first one.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, verify_both(&sh, &prepared, sh.hash, sh.signature));
+
+    memcpy(signature, sh.signature, sh.signature_size);
+    signature[sh.signature_size - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_ECDSA_INVALID_SIGNATURE,
+                      verify_both(&sh, &prepared, sh.hash, signature));
+
+    memcpy(signature, sh.signature, sh.signature_size);
+    signature[p_info->raw_private_key_size / 2] ^= 0x80;
+    TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_ECDSA_INVALID_SIGNATURE,
+                      verify_both(&sh, &prepared, sh.hash, signature));
+
+    memcpy(hash, sh.hash, sizeof(hash));
+    hash[0] ^= 0x01;
+    TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_ECDSA_INVALID_SIGNATURE,
+                      verify_both(&sh, &prepared, hash, sh.signature));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_free(&prepared));
+    TEST_ASSERT(!prepared.backend_used);
+
+    // A released key is rejected instead of verifying with freed data.
+    TEST_ASSERT(nrf_crypto_ecdsa_prepared_verify(NULL,
+                                                 &prepared,
+                                                 sh.hash,
+                                                 sizeof(sh.hash),
+                                                 sh.signature,
+                                                 sh.signature_size) != NRF_SUCCESS);
+    TEST_ASSERT(nrf_crypto_ecdsa_prepared_key_free(&prepared) != NRF_SUCCESS);
+
+    signed_hash_free(&sh);
+}
+
+
+static void precompute_none(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_curves); i++)
+    {
+        curve_check(m_curves[i], NRF_CRYPTO_ECDSA_PRECOMPUTE_NONE);
+    }
+}
+
+
+static void precompute_generator(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(m_curves); i++)
+    {
+        curve_check(m_curves[i], NRF_CRYPTO_ECDSA_PRECOMPUTE_GENERATOR);
+    }
+}
+
+
+/* A signature of another key must not verify, also when the prepared keys share a curve. */
+static void key_mismatch(void)
+{
+    static signed_hash_t            sh_a;
+    static signed_hash_t            sh_b;
+    nrf_crypto_ecdsa_prepared_key_t prepared_a;
+    nrf_crypto_ecdsa_prepared_key_t prepared_b;
+
+    signed_hash_make(&sh_a, &g_nrf_crypto_ecc_secp256r1_curve_info);
+    signed_hash_make(&sh_b, &g_nrf_crypto_ecc_secp256r1_curve_info);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_init(&prepared_a,
+                                                                      sh_a.p_info,
+                                                                      sh_a.raw_public_key,
+                                                                      sh_a.raw_public_key_size,
+                                                                      NRF_CRYPTO_ECDSA_PRECOMPUTE_GENERATOR));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_init(&prepared_b,
+                                                                      sh_b.p_info,
+                                                                      sh_b.raw_public_key,
+                                                                      sh_b.raw_public_key_size,
+                                                                      NRF_CRYPTO_ECDSA_PRECOMPUTE_GENERATOR));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, verify_both(&sh_a, &prepared_a, sh_a.hash, sh_a.signature));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, verify_both(&sh_b, &prepared_b, sh_b.hash, sh_b.signature));
+    TEST_ASSERT_EQUAL(NRF_ERROR_CRYPTO_ECDSA_INVALID_SIGNATURE,
+                      nrf_crypto_ecdsa_prepared_verify(NULL,
+                                                       &prepared_a,
+                                                       sh_b.hash,
+                                                       sizeof(sh_b.hash),
+                                                       sh_b.signature,
+                                                       sh_b.signature_size));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_free(&prepared_a));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_free(&prepared_b));
+    signed_hash_free(&sh_a);
+    signed_hash_free(&sh_b);
+}
+
+
+static uint32_t us_per_verify(uint64_t start)
+{
+    return (uint32_t)((host_test_time_ns() - start) / 1000 / BENCHMARK_VERIFIES);
+}
+
+
+/* Times repeated verifications on secp256r1. The figures are informational, as host timing varies
+ * and the mbed TLS build is not the device one; only the results are checked. */
+static void benchmark(void)
+{
+    static signed_hash_t            sh;
+    nrf_crypto_ecdsa_prepared_key_t prepared;
+    nrf_crypto_ecc_public_key_t     public_key;
+    uint64_t                        start;
+
+    signed_hash_make(&sh, &g_nrf_crypto_ecc_secp256r1_curve_info);
+
+    start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCHMARK_VERIFIES; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_verify(NULL,
+                                                               &sh.public_key,
+                                                               sh.hash,
+                                                               sizeof(sh.hash),
+                                                               sh.signature,
+                                                               sh.signature_size));
+    }
+    printf("    verify: %u us\n", us_per_verify(start));
+
+    // What a caller without a kept key pays, as the DFU signature check does.
+    start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCHMARK_VERIFIES; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecc_public_key_from_raw(sh.p_info,
+                                                                          &public_key,
+                                                                          sh.raw_public_key,
+                                                                          sh.raw_public_key_size));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_verify(NULL,
+                                                               &public_key,
+                                                               sh.hash,
+                                                               sizeof(sh.hash),
+                                                               sh.signature,
+                                                               sh.signature_size));
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecc_public_key_free(&public_key));
+    }
+    printf("    from_raw + verify: %u us\n", us_per_verify(start));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_init(&prepared,
+                                                                      sh.p_info,
+                                                                      sh.raw_public_key,
+                                                                      sh.raw_public_key_size,
+                                                                      NRF_CRYPTO_ECDSA_PRECOMPUTE_NONE));
+    start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCHMARK_VERIFIES; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_verify(NULL,
+                                                                        &prepared,
+                                                                        sh.hash,
+                                                                        sizeof(sh.hash),
+                                                                        sh.signature,
+                                                                        sh.signature_size));
+    }
+    printf("    prepared, no precompute: %u us\n", us_per_verify(start));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_free(&prepared));
+
+    start = host_test_time_ns();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_init(&prepared,
+                                                                      sh.p_info,
+                                                                      sh.raw_public_key,
+                                                                      sh.raw_public_key_size,
+                                                                      NRF_CRYPTO_ECDSA_PRECOMPUTE_GENERATOR));
+    printf("    prepare with generator table: %u us\n",
+           (uint32_t)((host_test_time_ns() - start) / 1000));
+    start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCHMARK_VERIFIES; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_verify(NULL,
+                                                                        &prepared,
+                                                                        sh.hash,
+                                                                        sizeof(sh.hash),
+                                                                        sh.signature,
+                                                                        sh.signature_size));
+    }
+    printf("    prepared, generator table: %u us\n", us_per_verify(start));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_ecdsa_prepared_key_free(&prepared));
+
+    signed_hash_free(&sh);
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_init());
+
+    host_test_run("precompute_none", precompute_none);
+    host_test_run("precompute_generator", precompute_generator);
+    host_test_run("key_mismatch", key_mismatch);
+    host_test_run("benchmark", benchmark);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_crypto_uninit());
+    return 0;
+}
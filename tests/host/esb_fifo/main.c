@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the nrf_esb RX FIFO and TX FIFO on the simulated RADIO.
+ *
+ * A scripted PTX peer on the other end of the air interface sends Dynamic Payload Length
+ * packets to the PRX under test and checks its acknowledgments.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_sim.h"
+#include "nrf_sim_peripherals.h"
+#include "nrf_error.h"
+#include "nrf_esb.h"
+
+#define RF_CHANNEL      2       /**< Default ESB channel. */
+#define PEER_PIPE       0       /**< Pipe used by the peer. */
+#define ACK_WINDOW_US   400     /**< Time from the start of a packet to the end of its acknowledgment. */
+#define LISTEN_WAIT_US  10      /**< Step while waiting for the receiver to listen. */
+#define PACKET_COUNT    300     /**< Number of payloads sent in the overflow test. */
+#define ACK_PL_COUNT    6       /**< Number of ACK payloads queued by the PRX. */
+
+static nrf_sim_radio_packet_t m_air[NRF_ESB_TX_FIFO_SIZE];  /**< Packets sent by the device under test. */
+static uint32_t               m_air_count;
+static uint32_t               m_rx_events;
+static uint32_t               m_tx_success_events;
+
+
+static void esb_evt_handler(nrf_esb_evt_t const * p_event)
+{
+    switch (p_event->evt_id)
+    {
+        case NRF_ESB_EVENT_RX_RECEIVED:
+            m_rx_events++;
+            break;
+
+        case NRF_ESB_EVENT_TX_SUCCESS:
+            m_tx_success_events++;
+            break;
+
+        default:
+            TEST_ASSERT(false);
+            break;
+    }
+}
+
+
+static void radio_tx_sink(void * p_context, nrf_sim_radio_packet_t const * p_packet)
+{
+    m_air[m_air_count % ARRAY_SIZE(m_air)] = *p_packet;
+    m_air_count++;
+}
+
+
+static void payload_fill(uint32_t seq, uint8_t * p_data, uint8_t * p_length)
+{
+    *p_length = 1 + seq % NRF_ESB_MAX_PAYLOAD_LENGTH;
+    for (uint8_t i = 0; i < *p_length; i++)
+    {
+        p_data[i] = (uint8_t)(seq + i);
+    }
+}
+
+
+/**@brief Function for sending one packet from the peer and waiting for the acknowledgment.
+ *
+ * @param[in]  pid      Packet ID.
+ * @param[in]  seq      Sequence number the payload is derived from.
+ * @param[out] p_ack    Acknowledgment, if any.
+ *
+ * @retval true  The PRX acknowledged the packet.
+ */
+static bool peer_send(uint8_t pid, uint32_t seq, nrf_sim_radio_packet_t * p_ack)
+{
+    nrf_sim_radio_packet_t packet = {
+        .frequency = RF_CHANNEL,
+        .address   = nrf_sim_radio_address_get(PEER_PIPE),
+    };
+    uint8_t  length;
+    uint32_t sent = m_air_count;
+    uint32_t wait;
+
+    payload_fill(seq, &packet.pdu[2], &length);
+    packet.pdu[0] = length;
+    packet.pdu[1] = (uint8_t)((pid << 1) | 0x01);
+    packet.length = 2 + length;
+
+    for (wait = 0; (wait < 100) && !nrf_sim_radio_rx_inject(&packet); wait++)
+    {
+        nrf_sim_run_for(NRF_SIM_TIME_US(LISTEN_WAIT_US));
+    }
+    TEST_ASSERT(wait < 100);
+    nrf_sim_run_for(NRF_SIM_TIME_US(ACK_WINDOW_US));
+
+    if (m_air_count == sent)
+    {
+        return false;
+    }
+    TEST_ASSERT_EQUAL(sent + 1, m_air_count);
+    *p_ack = m_air[sent % ARRAY_SIZE(m_air)];
+    TEST_ASSERT(p_ack->address == packet.address);
+    TEST_ASSERT_EQUAL(packet.pdu[1], p_ack->pdu[1]);
+    return true;
+}
+
+
+static void prx_start(void)
+{
+    nrf_esb_config_t config = NRF_ESB_DEFAULT_CONFIG;
+
+    config.mode          = NRF_ESB_MODE_PRX;
+    config.event_handler = esb_evt_handler;
+
+    nrf_sim_init();
+    nrf_sim_radio_tx_handler_set(radio_tx_sink, NULL);
+    m_air_count         = 0;
+    m_rx_events         = 0;
+    m_tx_success_events = 0;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_init(&config));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_start_rx());
+}
+
+
+/* The application reads slower than the peer sends, so the RX FIFO keeps filling up. Packets
+ * arriving while it is full are not acknowledged and the peer retransmits them; the peer also
+ * pretends to lose some acknowledgments and repeats packets the PRX already stored. Every
+ * payload must be read exactly once and in order. */
+static void prx_rx_overflow(void)
+{
+    uint32_t seed      = 0x5EED0037;
+    uint32_t next_tx   = 0;
+    uint32_t next_rx   = 0;
+    uint32_t nacks     = 0;
+    uint32_t lost_acks = 0;
+    uint8_t  pid       = 0;
+
+    prx_start();
+
+    while (next_rx < PACKET_COUNT)
+    {
+        nrf_sim_radio_packet_t ack;
+
+        if (next_tx < PACKET_COUNT)
+        {
+            if (!peer_send(pid, next_tx, &ack))
+            {
+                nacks++;
+            }
+            else if (host_test_rand(&seed) % 8 == 0)
+            {
+                lost_acks++;
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL(2, ack.length);
+                pid = (pid + 1) % (NRF_ESB_PID_MAX + 1);
+                next_tx++;
+            }
+        }
+
+        if ((next_tx == PACKET_COUNT) || (host_test_rand(&seed) % 3 == 0))
+        {
+            nrf_esb_payload_t payload;
+            uint8_t           expected[NRF_ESB_MAX_PAYLOAD_LENGTH];
+            uint8_t           length;
+
+            if (nrf_esb_read_rx_payload(&payload) == NRF_SUCCESS)
+            {
+                payload_fill(next_rx, expected, &length);
+                TEST_ASSERT_EQUAL(length, payload.length);
+                TEST_ASSERT(memcmp(expected, payload.data, length) == 0);
+                TEST_ASSERT_EQUAL(PEER_PIPE, payload.pipe);
+                TEST_ASSERT_EQUAL(0, payload.noack);
+                next_rx++;
+            }
+            else
+            {
+                /* Every acknowledged payload has been read. */
+                TEST_ASSERT_EQUAL(next_tx, next_rx);
+            }
+        }
+    }
+
+    nrf_esb_payload_t payload;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, nrf_esb_read_rx_payload(&payload));
+    TEST_ASSERT(nacks > PACKET_COUNT / 10);
+    TEST_ASSERT(lost_acks > 0);
+    TEST_ASSERT(m_rx_events > 0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_stop_rx());
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+/* ACK payloads queued in batches go out in order, one per new packet from the peer, and a
+ * repeated packet gets the same ACK payload again. */
+static void prx_ack_payload_order(void)
+{
+    nrf_esb_payload_t ack_pl[ACK_PL_COUNT];
+    uint8_t           pid = 0;
+    uint32_t          i;
+
+    prx_start();
+
+    for (i = 0; i < ACK_PL_COUNT; i++)
+    {
+        ack_pl[i].pipe  = PEER_PIPE;
+        ack_pl[i].noack = 0;
+        payload_fill(0x80 + i, ack_pl[i].data, &ack_pl[i].length);
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_write_payloads(&ack_pl[0], 4));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_write_payloads(&ack_pl[4], ACK_PL_COUNT - 4));
+
+    for (i = 0; i <= ACK_PL_COUNT; i++)
+    {
+        nrf_sim_radio_packet_t ack;
+        nrf_esb_payload_t      payload;
+        uint32_t               repeats = (i == 1) ? 2 : 1;
+
+        for (uint32_t r = 0; r < repeats; r++)
+        {
+            TEST_ASSERT(peer_send(pid, i, &ack));
+            if (i < ACK_PL_COUNT)
+            {
+                TEST_ASSERT_EQUAL(2 + ack_pl[i].length, ack.length);
+                TEST_ASSERT_EQUAL(ack_pl[i].length, ack.pdu[0]);
+                TEST_ASSERT(memcmp(ack_pl[i].data, &ack.pdu[2], ack_pl[i].length) == 0);
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL(0, ack.pdu[0]);
+            }
+        }
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_read_rx_payload(&payload));
+        TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, nrf_esb_read_rx_payload(&payload));
+        pid = (pid + 1) % (NRF_ESB_PID_MAX + 1);
+    }
+
+    TEST_ASSERT_EQUAL(ACK_PL_COUNT, m_tx_success_events);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_stop_rx());
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static bool ptx_busy(void * p_context)
+{
+    return !nrf_esb_is_idle();
+}
+
+
+/* A PTX batch is queued whole or not at all, and the packets go out back to back in order. */
+static void ptx_noack_batch(void)
+{
+    nrf_esb_config_t  config = NRF_ESB_DEFAULT_CONFIG;
+    nrf_esb_payload_t tx[NRF_ESB_TX_FIFO_SIZE];
+    uint32_t          i;
+
+    config.event_handler      = esb_evt_handler;
+    config.selective_auto_ack = true;
+
+    nrf_sim_init();
+    nrf_sim_radio_tx_handler_set(radio_tx_sink, NULL);
+    m_air_count         = 0;
+    m_tx_success_events = 0;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_init(&config));
+
+    for (i = 0; i < ARRAY_SIZE(tx); i++)
+    {
+        tx[i].pipe  = PEER_PIPE;
+        tx[i].noack = 1;
+        payload_fill(0x40 + i, tx[i].data, &tx[i].length);
+    }
+
+    /* An invalid entry rejects the whole batch. */
+    tx[2].length = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH, nrf_esb_write_payloads(tx, 3));
+    tx[2].length = 3;
+    TEST_ASSERT(nrf_esb_is_idle());
+
+    /* The first batch starts the transmission; the second does not fit and is not queued. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_write_payloads(&tx[0], 5));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, nrf_esb_write_payloads(&tx[4], 4));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_esb_write_payloads(&tx[5], 3));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, nrf_esb_write_payload(&tx[0]));
+
+    TEST_ASSERT(nrf_sim_run_while(ptx_busy, NULL, NRF_SIM_TIME_MS(10)));
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(tx), m_air_count);
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(tx), m_tx_success_events);
+
+    for (i = 0; i < ARRAY_SIZE(tx); i++)
+    {
+        nrf_sim_radio_packet_t const * p_packet = &m_air[i];
+
+        TEST_ASSERT(p_packet->address == nrf_sim_radio_address_get(PEER_PIPE));
+        TEST_ASSERT_EQUAL(RF_CHANNEL, p_packet->frequency);
+        TEST_ASSERT_EQUAL(tx[i].length, p_packet->pdu[0]);
+        TEST_ASSERT_EQUAL(((i + 1) % (NRF_ESB_PID_MAX + 1)) << 1, p_packet->pdu[1]);
+        TEST_ASSERT(memcmp(tx[i].data, &p_packet->pdu[2], tx[i].length) == 0);
+    }
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static int test_main(void)
+{
+    host_test_run("prx_rx_overflow", prx_rx_overflow);
+    host_test_run("prx_ack_payload_order", prx_ack_payload_order);
+    host_test_run("ptx_noack_batch", ptx_noack_batch);
+    return 0;
+}
+
+
+int main(void)
+{
+    int result = nrf_sim_main_run(test_main);
+
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+    return result;
+}
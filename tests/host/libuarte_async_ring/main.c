@@ -0,0 +1,478 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the libuarte_async RX ring and TX queue on the simulated UARTE, TIMER and PPI,
+ *        with and without flow control.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_sim.h"
+#include "nrf_sim_peripherals.h"
+#include "nrf_libuarte_async.h"
+#include "nrfx_gpiote.h"
+
+#define RX_BUF_SIZE     32      /**< Size of one RX chunk. */
+#define RX_BUF_CNT      4       /**< Number of RX chunks in the ring. */
+#define RX_TIMEOUT_US   100     /**< Receiver timeout. */
+#define BYTE_TIME_US    10      /**< Time of one byte (10 bits) at 1 Mbaud. */
+#define BURST_COUNT     400     /**< Number of bursts sent to the receiver. */
+#define TX_BUF_SIZE     16      /**< Size of one TX buffer. */
+#define TX_BUF_CNT      (NRF_LIBUARTE_ASYNC_TX_QUEUE_SIZE + 1)  /**< One in transfer, the rest queued. */
+#define HWFC_HIGH_WM    (RX_BUF_SIZE * (RX_BUF_CNT - 3))        /**< Highest watermark the ring allows. */
+#define HWFC_LOW_WM     (RX_BUF_SIZE / 2)
+#define HWFC_BYTES      2000    /**< Number of bytes the peer sends while it honours RTS. */
+#define HWFC_STEP       8       /**< Number of bytes the peer sends between checks of RTS. */
+
+NRF_LIBUARTE_ASYNC_DEFINE(libuarte, 0, 0, NRF_LIBUARTE_PERIPHERAL_NOT_USED, 1, RX_BUF_SIZE, RX_BUF_CNT);
+NRF_LIBUARTE_ASYNC_DEFINE(libuarte_hwfc, 1, 2, NRF_LIBUARTE_PERIPHERAL_NOT_USED, 3, RX_BUF_SIZE, RX_BUF_CNT);
+
+static uint8_t  m_evt_seq;          /**< Next byte expected in an RX data event. */
+static uint32_t m_evt_bytes;        /**< Number of bytes reported with RX data events. */
+static uint8_t  * m_tx_done[TX_BUF_CNT + 1];
+static uint32_t m_tx_done_cnt;
+static uint8_t  m_line[TX_BUF_CNT * TX_BUF_SIZE + 1];
+static size_t   m_line_len;
+
+static uint8_t  m_hwfc_tx_seq;      /**< Next byte sent to the flow controlled instance. */
+static uint8_t  m_hwfc_evt_seq;
+static uint32_t m_hwfc_evt_bytes;
+static uint8_t  m_hwfc_rx_seq;      /**< Next byte expected by the consumer. */
+static bool     m_rts_deasserted;   /**< RTS as seen by the peer. */
+static uint32_t m_rts_set_cnt;
+static uint32_t m_rts_clear_cnt;
+
+void __real_nrf_libuarte_drv_rts_set(const nrf_libuarte_drv_t * const p_libuarte);
+void __real_nrf_libuarte_drv_rts_clear(const nrf_libuarte_drv_t * const p_libuarte);
+
+
+static void libuarte_evt_handler(void * context, nrf_libuarte_async_evt_t * p_evt)
+{
+    switch (p_evt->type)
+    {
+        case NRF_LIBUARTE_ASYNC_EVT_RX_DATA:
+            /* The events point into the ring; the data stays there until it is released. */
+            for (size_t i = 0; i < p_evt->data.rxtx.length; i++)
+            {
+                TEST_ASSERT_EQUAL(m_evt_seq++, p_evt->data.rxtx.p_data[i]);
+            }
+            m_evt_bytes += p_evt->data.rxtx.length;
+            break;
+
+        case NRF_LIBUARTE_ASYNC_EVT_TX_DONE:
+            TEST_ASSERT(m_tx_done_cnt < ARRAY_SIZE(m_tx_done));
+            m_tx_done[m_tx_done_cnt++] = p_evt->data.rxtx.p_data;
+            break;
+
+        default:
+            TEST_ASSERT(false);
+            break;
+    }
+}
+
+
+static void libuarte_hwfc_evt_handler(void * context, nrf_libuarte_async_evt_t * p_evt)
+{
+    TEST_ASSERT_EQUAL(NRF_LIBUARTE_ASYNC_EVT_RX_DATA, p_evt->type);
+    for (size_t i = 0; i < p_evt->data.rxtx.length; i++)
+    {
+        TEST_ASSERT_EQUAL(m_hwfc_evt_seq++, p_evt->data.rxtx.p_data[i]);
+    }
+    m_hwfc_evt_bytes += p_evt->data.rxtx.length;
+}
+
+
+/* The simulation has no GPIOTE, so the RTS pin is not connected and the watermark requests are
+ * recorded here instead. The test plays the peer that watches RTS. */
+void __wrap_nrf_libuarte_drv_rts_set(const nrf_libuarte_drv_t * const p_libuarte)
+{
+    TEST_ASSERT(p_libuarte == libuarte_hwfc.p_libuarte);
+    TEST_ASSERT(!m_rts_deasserted);
+    /* The headroom above the high watermark still holds the chunks already reserved. */
+    TEST_ASSERT(!libuarte_hwfc.p_ctrl_blk->rx_halted);
+    m_rts_deasserted = true;
+    m_rts_set_cnt++;
+    __real_nrf_libuarte_drv_rts_set(p_libuarte);
+}
+
+
+void __wrap_nrf_libuarte_drv_rts_clear(const nrf_libuarte_drv_t * const p_libuarte)
+{
+    TEST_ASSERT(p_libuarte == libuarte_hwfc.p_libuarte);
+    TEST_ASSERT(m_rts_deasserted);
+    m_rts_deasserted = false;
+    m_rts_clear_cnt++;
+    __real_nrf_libuarte_drv_rts_clear(p_libuarte);
+}
+
+
+/* GPIOTE stubs for the driver with flow control support. They are never reached because the RTS
+ * pin is not connected. */
+nrfx_err_t nrfx_gpiote_init(void)
+{
+    TEST_ASSERT(false);
+    return NRFX_ERROR_INTERNAL;
+}
+
+
+nrfx_err_t nrfx_gpiote_out_init(nrfx_gpiote_pin_t pin, nrfx_gpiote_out_config_t const * p_config)
+{
+    TEST_ASSERT(false);
+    return NRFX_ERROR_INTERNAL;
+}
+
+
+void nrfx_gpiote_out_uninit(nrfx_gpiote_pin_t pin)
+{
+    TEST_ASSERT(false);
+}
+
+
+void nrfx_gpiote_out_task_enable(nrfx_gpiote_pin_t pin)
+{
+    TEST_ASSERT(false);
+}
+
+
+uint32_t nrfx_gpiote_set_task_addr_get(nrfx_gpiote_pin_t pin)
+{
+    TEST_ASSERT(false);
+    return 0;
+}
+
+
+uint32_t nrfx_gpiote_clr_task_addr_get(nrfx_gpiote_pin_t pin)
+{
+    TEST_ASSERT(false);
+    return 0;
+}
+
+
+static void tx_sink(void * p_context, uint8_t const * p_data, size_t length)
+{
+    TEST_ASSERT(m_line_len + length <= sizeof(m_line));
+    memcpy(&m_line[m_line_len], p_data, length);
+    m_line_len += length;
+}
+
+
+static bool tx_pending(void * p_context)
+{
+    return m_tx_done_cnt < *(uint32_t *)p_context;
+}
+
+
+/* Bursts of random length are received while the consumer releases the data in random
+ * pieces and leaves a random part of it in the ring, so the read position and the chunk
+ * boundaries drift across the wrap. Without flow control the consumer must keep up, which
+ * bounds the burst length to one chunk. */
+static void rx_ring_wrap(void)
+{
+    uint32_t  seed      = 0x5EED0027;
+    uint8_t   tx_seq    = 0;
+    uint8_t   rx_seq    = 0;
+    uint32_t  sent      = 0;
+    uint32_t  consumed  = 0;
+    uint32_t  wraps     = 0;
+    uint8_t * p_prev    = NULL;
+    uint8_t   burst[RX_BUF_SIZE];
+
+    for (uint32_t b = 0; b < BURST_COUNT; b++)
+    {
+        size_t length = 1 + host_test_rand(&seed) % RX_BUF_SIZE;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            burst[i] = tx_seq++;
+        }
+        TEST_ASSERT_EQUAL(length, nrf_sim_uarte_rx_inject(0, burst, length));
+        sent += length;
+
+        nrf_sim_run_for(NRF_SIM_TIME_US(length * BYTE_TIME_US + 2 * RX_TIMEOUT_US));
+        TEST_ASSERT_EQUAL(sent, m_evt_bytes);
+
+        uint32_t keep = host_test_rand(&seed) % (RX_BUF_SIZE / 2);
+        while (sent - consumed > keep)
+        {
+            uint8_t * p_data;
+            size_t    available;
+
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_libuarte_async_rx_get(&libuarte, &p_data, &available));
+            TEST_ASSERT(available > 0);
+            TEST_ASSERT(available <= sent - consumed);
+
+            size_t count = 1 + host_test_rand(&seed) % available;
+            count = MIN(count, sent - consumed - keep);
+            for (size_t i = 0; i < count; i++)
+            {
+                TEST_ASSERT_EQUAL(rx_seq++, p_data[i]);
+            }
+            if ((p_prev != NULL) && (p_data < p_prev))
+            {
+                wraps++;
+            }
+            p_prev = p_data;
+
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_libuarte_async_rx_release(&libuarte, count));
+            consumed += count;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      nrf_libuarte_async_rx_release(&libuarte, sent - consumed + 1));
+    TEST_ASSERT(wraps >= sent / (RX_BUF_SIZE * RX_BUF_CNT) - 1);
+    TEST_ASSERT(wraps > 10);
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+/* Buffers passed while a transfer is ongoing are queued and sent back to back in order,
+ * each with its own TX done event. */
+static void tx_queue_order(void)
+{
+    static uint8_t tx_buf[TX_BUF_CNT][TX_BUF_SIZE];
+    static uint8_t extra = 0xEE;
+    uint32_t       count = TX_BUF_CNT;
+
+    for (uint32_t i = 0; i < TX_BUF_CNT; i++)
+    {
+        memset(tx_buf[i], 0x10 + i, TX_BUF_SIZE);
+    }
+    nrf_sim_uarte_tx_handler_set(0, tx_sink, NULL);
+
+    nrf_sim_time_t start = nrf_sim_time_get();
+    for (uint32_t i = 0; i < TX_BUF_CNT; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_libuarte_async_tx(&libuarte, tx_buf[i], TX_BUF_SIZE));
+    }
+    TEST_ASSERT_EQUAL(NRF_ERROR_BUSY, nrf_libuarte_async_tx(&libuarte, &extra, 1));
+
+    TEST_ASSERT(nrf_sim_run_while(tx_pending, &count, NRF_SIM_TIME_MS(10)));
+    for (uint32_t i = 0; i < TX_BUF_CNT; i++)
+    {
+        TEST_ASSERT(m_tx_done[i] == tx_buf[i]);
+    }
+    TEST_ASSERT_EQUAL(sizeof(tx_buf), m_line_len);
+    TEST_ASSERT(memcmp(m_line, tx_buf, sizeof(tx_buf)) == 0);
+
+    /* The next buffer is started before the user is notified, without a gap on the line. */
+    nrf_sim_time_t expected = TX_BUF_CNT * TX_BUF_SIZE * NRF_SIM_TIME_US(BYTE_TIME_US);
+    TEST_ASSERT(nrf_sim_time_get() - start <= expected + NRF_SIM_TIME_US(BYTE_TIME_US));
+
+    /* The queue has drained. */
+    count++;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_libuarte_async_tx(&libuarte, &extra, 1));
+    TEST_ASSERT(nrf_sim_run_while(tx_pending, &count, NRF_SIM_TIME_MS(1)));
+    TEST_ASSERT(m_tx_done[TX_BUF_CNT] == &extra);
+    TEST_ASSERT_EQUAL(extra, m_line[m_line_len - 1]);
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+/**@brief Function for sending bytes to the flow controlled instance and receiving them. */
+static void hwfc_send(size_t length)
+{
+    uint8_t data[RX_BUF_SIZE * RX_BUF_CNT];
+
+    TEST_ASSERT(length <= sizeof(data));
+    for (size_t i = 0; i < length; i++)
+    {
+        data[i] = m_hwfc_tx_seq++;
+    }
+    TEST_ASSERT_EQUAL(length, nrf_sim_uarte_rx_inject(1, data, length));
+    nrf_sim_run_for(NRF_SIM_TIME_US(length * BYTE_TIME_US + 2 * RX_TIMEOUT_US));
+}
+
+
+/**@brief Function for consuming up to @p max bytes from the flow controlled instance.
+ *
+ * @return Number of bytes consumed.
+ */
+static size_t hwfc_consume(size_t max)
+{
+    size_t consumed = 0;
+
+    while (consumed < max)
+    {
+        uint8_t * p_data;
+        size_t    available;
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_libuarte_async_rx_get(&libuarte_hwfc, &p_data, &available));
+        if (available == 0)
+        {
+            break;
+        }
+
+        size_t count = MIN(available, max - consumed);
+        for (size_t i = 0; i < count; i++)
+        {
+            TEST_ASSERT_EQUAL(m_hwfc_rx_seq++, p_data[i]);
+        }
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_libuarte_async_rx_release(&libuarte_hwfc, count));
+        consumed += count;
+    }
+    return consumed;
+}
+
+
+/* A peer that honours RTS sends faster than the consumer releases. RTS is deasserted at the high
+ * watermark and asserted again at the low one, and the ring never runs out of chunks. */
+static void hwfc_watermark(void)
+{
+    uint32_t sent        = 0;
+    uint32_t consumed    = 0;
+    uint32_t pending_max = 0;
+
+    m_rts_set_cnt   = 0;
+    m_rts_clear_cnt = 0;
+    while (consumed < HWFC_BYTES)
+    {
+        if (!m_rts_deasserted && (sent < HWFC_BYTES))
+        {
+            size_t length = MIN(HWFC_STEP, HWFC_BYTES - sent);
+
+            hwfc_send(length);
+            sent += length;
+        }
+        else
+        {
+            nrf_sim_run_for(NRF_SIM_TIME_US(HWFC_STEP * BYTE_TIME_US));
+        }
+        TEST_ASSERT_EQUAL(sent, m_hwfc_evt_bytes);
+        TEST_ASSERT(!libuarte_hwfc.p_ctrl_blk->rx_halted);
+
+        pending_max = MAX(pending_max, sent - consumed);
+        TEST_ASSERT(sent - consumed < HWFC_HIGH_WM + HWFC_STEP);
+        TEST_ASSERT(!m_rts_deasserted || (sent - consumed > HWFC_LOW_WM));
+
+        consumed += hwfc_consume(HWFC_STEP / 2);
+    }
+
+    TEST_ASSERT(pending_max >= HWFC_HIGH_WM);
+    TEST_ASSERT(m_rts_set_cnt > 10);
+    TEST_ASSERT_EQUAL(m_rts_set_cnt, m_rts_clear_cnt);
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+/* A peer that ignores the watermark fills the ring. The receiver stops taking chunks, and
+ * reception resumes once the consumer releases data. The burst ends inside the last reserved
+ * chunk, whatever the read position: on hardware the driver deasserts RTS before that chunk is
+ * full, which needs the GPIOTE the simulation lacks. */
+static void hwfc_rx_halted(void)
+{
+    size_t const   burst     = RX_BUF_SIZE * (RX_BUF_CNT - 1);
+    uint32_t const evt_bytes = m_hwfc_evt_bytes;
+
+    m_rts_set_cnt   = 0;
+    m_rts_clear_cnt = 0;
+    hwfc_send(burst);
+    TEST_ASSERT_EQUAL(burst, m_hwfc_evt_bytes - evt_bytes);
+    TEST_ASSERT(m_rts_deasserted);
+    TEST_ASSERT_EQUAL(1, m_rts_set_cnt);
+    TEST_ASSERT(libuarte_hwfc.p_ctrl_blk->rx_halted);
+
+    TEST_ASSERT_EQUAL(burst, hwfc_consume(SIZE_MAX));
+    TEST_ASSERT(!libuarte_hwfc.p_ctrl_blk->rx_halted);
+    TEST_ASSERT(!m_rts_deasserted);
+
+    /* The ring goes on across the halt. */
+    for (uint32_t i = 0; i < 2 * RX_BUF_CNT; i++)
+    {
+        hwfc_send(RX_BUF_SIZE / 2);
+        TEST_ASSERT_EQUAL(RX_BUF_SIZE / 2, hwfc_consume(SIZE_MAX));
+    }
+    TEST_ASSERT_EQUAL(m_hwfc_evt_seq, m_hwfc_rx_seq);
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+/* nrf_libuarte_async_uninit() busy-waits on the UARTE stop events, which the simulation
+ * cannot serve, so the instance is initialized once for all test cases. */
+static int test_main(void)
+{
+    nrf_libuarte_async_config_t config = {
+        .tx_pin     = 6,
+        .rx_pin     = 8,
+        .cts_pin    = NRF_UARTE_PSEL_DISCONNECTED,
+        .rts_pin    = NRF_UARTE_PSEL_DISCONNECTED,
+        .timeout_us = RX_TIMEOUT_US,
+        .hwfc       = NRF_UARTE_HWFC_DISABLED,
+        .parity     = NRF_UARTE_PARITY_EXCLUDED,
+        .baudrate   = NRF_UARTE_BAUDRATE_1000000,
+        .int_prio   = APP_IRQ_PRIORITY_LOW,
+        .rx_ring    = true,
+    };
+
+    nrf_sim_init();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_libuarte_async_init(&libuarte, &config, libuarte_evt_handler, NULL));
+    nrf_libuarte_async_enable(&libuarte);
+
+    /* The high watermark must leave room for the two chunks the driver holds. */
+    config.tx_pin     = 26;
+    config.rx_pin     = 27;
+    config.hwfc       = NRF_UARTE_HWFC_ENABLED;
+    config.rx_high_wm = HWFC_HIGH_WM + 1;
+    config.rx_low_wm  = HWFC_LOW_WM;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      nrf_libuarte_async_init(&libuarte_hwfc, &config, libuarte_hwfc_evt_handler, NULL));
+    config.rx_high_wm = HWFC_HIGH_WM;
+    config.rx_low_wm  = HWFC_HIGH_WM;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      nrf_libuarte_async_init(&libuarte_hwfc, &config, libuarte_hwfc_evt_handler, NULL));
+    config.rx_low_wm  = HWFC_LOW_WM;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      nrf_libuarte_async_init(&libuarte_hwfc, &config, libuarte_hwfc_evt_handler, NULL));
+    nrf_libuarte_async_enable(&libuarte_hwfc);
+
+    host_test_run("rx_ring_wrap", rx_ring_wrap);
+    host_test_run("tx_queue_order", tx_queue_order);
+    host_test_run("hwfc_watermark", hwfc_watermark);
+    host_test_run("hwfc_rx_halted", hwfc_rx_halted);
+    return 0;
+}
+
+
+int main(void)
+{
+    int result = nrf_sim_main_run(test_main);
+
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+    return result;
+}
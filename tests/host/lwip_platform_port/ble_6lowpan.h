@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host replacement of the 6LoWPAN library header.
+ *
+ * The prebuilt ble_6lowpan library is not part of this SDK snapshot. The test provides the
+ * functions declared here.
+ */
+#ifndef BLE_6LOWPAN_H__
+#define BLE_6LOWPAN_H__
+
+#include <stdint.h>
+#include "iot_common.h"
+
+#define BLE_6LOWPAN_MAX_INTERFACE   1
+
+typedef enum
+{
+    BLE_6LO_EVT_ERROR,
+    BLE_6LO_EVT_INTERFACE_ADD,
+    BLE_6LO_EVT_INTERFACE_DELETE,
+    BLE_6LO_EVT_INTERFACE_DATA_RX
+} ble_6lowpan_event_id_t;
+
+typedef struct
+{
+    uint8_t  * p_packet;    /**< Decompressed packet, owned by the receiver. */
+    uint16_t   packet_len;
+    uint32_t   rx_contexts;
+} ble_6lowpan_data_rx_t;
+
+typedef struct
+{
+    ble_6lowpan_event_id_t event_id;
+    union
+    {
+        ble_6lowpan_data_rx_t rx_event_param;
+    } event_param;
+} ble_6lowpan_event_t;
+
+typedef void (*ble_6lowpan_evt_handler_t)(iot_interface_t     * p_interface,
+                                          ble_6lowpan_event_t * p_event);
+
+typedef struct
+{
+    eui64_t                   * p_eui64;
+    ble_6lowpan_evt_handler_t   event_handler;
+} ble_6lowpan_init_t;
+
+uint32_t ble_6lowpan_init(ble_6lowpan_init_t const * p_init);
+
+uint32_t ble_6lowpan_interface_send(iot_interface_t const * p_interface,
+                                    uint8_t const         * p_packet,
+                                    uint16_t                packet_len);
+
+#endif // BLE_6LOWPAN_H__
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host replacement of the IoT common header.
+ *
+ * The IoT components are not part of this SDK snapshot. Only the types and constants used by the
+ * lwIP platform port are provided.
+ */
+#ifndef IOT_COMMON_H__
+#define IOT_COMMON_H__
+
+#include <stdint.h>
+#include "sdk_common.h"
+
+#define EUI_64_ADDR_SIZE        8       /**< Size of an EUI-64 identifier. */
+#define IPV6_LL_ADDR_SIZE       6       /**< Size of the link layer address, a Bluetooth device address. */
+#define IPV6_IID_FLIP_VALUE     0x02    /**< Mask of the universal/local bit of the interface identifier. */
+#define EUI64_LOCAL_IID         NULL    /**< Derive the local identifier from the device address. */
+
+/**@brief Converts a 32-bit value from host to network byte order. */
+#define HTONL(val)  ((((uint32_t)(val) & 0xFF000000) >> 24) |                                     \
+                     (((uint32_t)(val) & 0x00FF0000) >> 8)  |                                     \
+                     (((uint32_t)(val) & 0x0000FF00) << 8)  |                                     \
+                     (((uint32_t)(val) & 0x000000FF) << 24))
+
+typedef struct
+{
+    uint8_t identifier[EUI_64_ADDR_SIZE];
+} eui64_t;
+
+typedef struct
+{
+    eui64_t   local_addr;
+    eui64_t   peer_addr;
+    void    * p_upper_stack;
+    void    * p_transport;
+} iot_interface_t;
+
+#endif // IOT_COMMON_H__
@@ -0,0 +1,465 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the lwIP platform port: mem_malloc() on nrf_balloc pools, received packets passed
+ *        to lwIP as custom pbufs, and transmission of pbuf chains.
+ *
+ * The port is built against the lwIP pbuf and memp core. The netif and IPv6 input functions, the
+ * 6LoWPAN library, the IoT context manager and the memory manager are replaced by the test.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "lwip/mem.h"
+#include "lwip/pbuf.h"
+#include "lwip/netif.h"
+#include "lwip/ip6.h"
+#include "lwip/priv/tcp_priv.h"
+#include "app_timer.h"
+#include "ble_ipsp.h"
+#include "ble_6lowpan.h"
+#include "iot_context_manager.h"
+#include "mem_manager.h"
+#include "nrf_platform_port.h"
+
+#define SMALL_SIZE      NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_SIZE
+#define MEDIUM_SIZE     NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_SIZE
+#define LARGE_SIZE      NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_SIZE
+#define SMALL_COUNT     NRF_LWIP_DRIVER_CONFIG_SMALL_BLOCK_COUNT
+#define MEDIUM_COUNT    NRF_LWIP_DRIVER_CONFIG_MEDIUM_BLOCK_COUNT
+#define LARGE_COUNT     NRF_LWIP_DRIVER_CONFIG_LARGE_BLOCK_COUNT
+#define BLOCK_COUNT     (SMALL_COUNT + MEDIUM_COUNT + LARGE_COUNT)
+#define PACKET_LEN      100     /**< Length of a received packet. */
+#define TX_FIRST_LEN    20      /**< Length of the first pbuf of a transmitted chain. */
+#define TX_SECOND_LEN   30      /**< Length of the second pbuf of a transmitted chain. */
+
+static ble_6lowpan_evt_handler_t m_6lowpan_handler;
+static iot_interface_t           m_interface;
+static iot_interface_t           m_other_interface;     /**< Interface that was never added. */
+static struct netif            * mp_netif;              /**< Interface added by the port. */
+static uint32_t                  m_interface_up_cnt;
+static uint32_t                  m_interface_down_cnt;
+static uint32_t                  m_nrf_alloc_cnt;       /**< Memory manager blocks not yet freed. */
+static uint32_t                  m_ip6_input_cnt;
+static struct pbuf             * mp_held_pbuf;          /**< Received pbuf still referenced by the stack. */
+static uint8_t                 * mp_sent;               /**< Packet passed to 6LoWPAN. */
+static uint16_t                  m_sent_len;
+static uint32_t                  m_send_result;
+
+struct tcp_pcb * tcp_active_pcbs;
+
+
+void tcp_segs_free(struct tcp_seg * seg)
+{
+    TEST_ASSERT(false);
+}
+
+
+void * nrf_malloc(uint32_t size)
+{
+    void * p_mem = malloc(size);
+
+    TEST_ASSERT(p_mem != NULL);
+    m_nrf_alloc_cnt++;
+    return p_mem;
+}
+
+
+void nrf_free(void * p_buffer)
+{
+    TEST_ASSERT(m_nrf_alloc_cnt > 0);
+    m_nrf_alloc_cnt--;
+    free(p_buffer);
+}
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return 0;
+}
+
+
+uint32_t iot_context_manager_init(void)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t iot_context_manager_table_alloc(iot_interface_t const * p_iot_interface)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t iot_context_manager_table_free(iot_interface_t const * p_iot_interface)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ble_6lowpan_init(ble_6lowpan_init_t const * p_init)
+{
+    m_6lowpan_handler = p_init->event_handler;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ble_6lowpan_interface_send(iot_interface_t const * p_interface,
+                                    uint8_t const         * p_packet,
+                                    uint16_t                packet_len)
+{
+    TEST_ASSERT(p_interface == &m_interface);
+    TEST_ASSERT(mp_sent == NULL);
+
+    if (m_send_result == NRF_SUCCESS)
+    {
+        mp_sent    = (uint8_t *)p_packet;
+        m_sent_len = packet_len;
+    }
+    return m_send_result;
+}
+
+
+void nrf_driver_interface_up(iot_interface_t const * p_interface)
+{
+    TEST_ASSERT(p_interface == &m_interface);
+    m_interface_up_cnt++;
+}
+
+
+void nrf_driver_interface_down(iot_interface_t const * p_interface)
+{
+    TEST_ASSERT(p_interface == &m_interface);
+    m_interface_down_cnt++;
+}
+
+
+struct netif * netif_add(struct netif * netif, void * state, netif_init_fn init, netif_input_fn input)
+{
+    TEST_ASSERT(mp_netif == NULL);
+    netif->state = state;
+    mp_netif     = netif;
+    TEST_ASSERT_EQUAL(ERR_OK, init(netif));
+    return netif;
+}
+
+
+void netif_set_up(struct netif * netif)
+{
+    netif->flags |= NETIF_FLAG_UP;
+}
+
+
+void netif_remove(struct netif * netif)
+{
+    TEST_ASSERT(netif == mp_netif);
+    mp_netif = NULL;
+}
+
+
+err_t ip6_input(struct pbuf * p, struct netif * inp)
+{
+    TEST_ASSERT(inp == mp_netif);
+    TEST_ASSERT(mp_held_pbuf == NULL);
+    m_ip6_input_cnt++;
+
+    // Keep a reference, as a queued or reassembled packet would, and consume the pbuf.
+    pbuf_ref(p);
+    mp_held_pbuf = p;
+    TEST_ASSERT_EQUAL(0, pbuf_free(p));
+    return ERR_OK;
+}
+
+
+/**@brief Function for counting the blocks that mem_malloc() can still serve for a given size. */
+static uint32_t blocks_available(mem_size_t size)
+{
+    void   * p_blocks[BLOCK_COUNT + 1];
+    uint32_t count = 0;
+
+    while ((p_blocks[count] = mem_malloc(size)) != NULL)
+    {
+        TEST_ASSERT(++count <= BLOCK_COUNT);
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        mem_free(p_blocks[i]);
+    }
+    return count;
+}
+
+
+/**@brief Function for initializing the port and adding an interface. */
+static void port_init(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_driver_init());
+    TEST_ASSERT(m_6lowpan_handler != NULL);
+
+    mp_netif             = NULL;
+    mp_held_pbuf         = NULL;
+    mp_sent              = NULL;
+    m_send_result        = NRF_SUCCESS;
+    m_interface_up_cnt   = 0;
+    m_interface_down_cnt = 0;
+    m_ip6_input_cnt      = 0;
+
+    for (uint32_t i = 0; i < EUI_64_ADDR_SIZE; i++)
+    {
+        m_interface.local_addr.identifier[i] = (uint8_t)(0x10 + i);
+    }
+
+    ble_6lowpan_event_t event = {.event_id = BLE_6LO_EVT_INTERFACE_ADD};
+
+    m_6lowpan_handler(&m_interface, &event);
+    TEST_ASSERT(mp_netif != NULL);
+    TEST_ASSERT_EQUAL(1, m_interface_up_cnt);
+    TEST_ASSERT_EQUAL(BLE_IPSP_MTU, mp_netif->mtu);
+    TEST_ASSERT(mp_netif->flags & NETIF_FLAG_UP);
+    TEST_ASSERT(mp_netif->output_ip6 != NULL);
+    TEST_ASSERT_EQUAL(HTONL(0xFE800000), mp_netif->ip6_addr[0].addr[0]);
+
+    // There is no free interface for a second link.
+    struct netif * p_netif = mp_netif;
+
+    mp_netif = NULL;
+    m_6lowpan_handler(&m_other_interface, &event);
+    TEST_ASSERT(mp_netif == NULL);
+    TEST_ASSERT_EQUAL(1, m_interface_up_cnt);
+    mp_netif = p_netif;
+}
+
+
+/**@brief Function for passing a received packet of the given length to the port. */
+static uint8_t * packet_receive(iot_interface_t * p_interface, uint16_t len)
+{
+    uint8_t           * p_packet = nrf_malloc(len);
+    ble_6lowpan_event_t event    =
+    {
+        .event_id = BLE_6LO_EVT_INTERFACE_DATA_RX,
+        .event_param.rx_event_param =
+        {
+            .p_packet   = p_packet,
+            .packet_len = len,
+        },
+    };
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        p_packet[i] = (uint8_t)i;
+    }
+    m_6lowpan_handler(p_interface, &event);
+    return p_packet;
+}
+
+
+/**@brief Requests are served from the smallest pool that fits and spill into larger pools. */
+static void mem_pools(void)
+{
+    void * p_small[SMALL_COUNT];
+    void * p_medium[MEDIUM_COUNT];
+    void * p_large[LARGE_COUNT];
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_driver_init());
+
+    for (uint32_t round = 0; round < 2; round++)
+    {
+        // Had small requests taken larger blocks, the larger requests would fail early.
+        for (uint32_t i = 0; i < SMALL_COUNT; i++)
+        {
+            p_small[i] = mem_malloc(SMALL_SIZE);
+            TEST_ASSERT(p_small[i] != NULL);
+        }
+        for (uint32_t i = 0; i < LARGE_COUNT; i++)
+        {
+            p_large[i] = mem_malloc(MEDIUM_SIZE + 1);
+            TEST_ASSERT(p_large[i] != NULL);
+        }
+        TEST_ASSERT(mem_malloc(MEDIUM_SIZE + 1) == NULL);
+        for (uint32_t i = 0; i < MEDIUM_COUNT; i++)
+        {
+            p_medium[i] = mem_malloc(SMALL_SIZE + 1);
+            TEST_ASSERT(p_medium[i] != NULL);
+        }
+        TEST_ASSERT(mem_malloc(1) == NULL);
+
+        // Each block goes back to its own pool, whatever the order.
+        for (uint32_t i = 0; i < MEDIUM_COUNT; i++)
+        {
+            mem_free(p_medium[i]);
+        }
+        mem_free(p_large[0]);
+        TEST_ASSERT_EQUAL(MEDIUM_COUNT + 1, blocks_available(SMALL_SIZE + 1));
+        TEST_ASSERT_EQUAL(1, blocks_available(MEDIUM_SIZE + 1));
+        for (uint32_t i = 0; i < SMALL_COUNT; i++)
+        {
+            mem_free(p_small[i]);
+        }
+        for (uint32_t i = 1; i < LARGE_COUNT; i++)
+        {
+            mem_free(p_large[i]);
+        }
+        TEST_ASSERT_EQUAL(BLOCK_COUNT, blocks_available(1));
+    }
+
+    // Requests larger than the largest block fail, whether or not the pools are empty.
+    TEST_ASSERT(mem_malloc(LARGE_SIZE + 1) == NULL);
+    TEST_ASSERT_EQUAL(LARGE_COUNT, blocks_available(LARGE_SIZE));
+    mem_free(NULL);
+
+    uint8_t * p_mem = mem_malloc(MEDIUM_SIZE);
+
+    memset(p_mem, 0xAA, MEDIUM_SIZE);
+    mem_free(p_mem);
+    p_mem = mem_calloc(MEDIUM_SIZE / 4, 4);
+    TEST_ASSERT(p_mem != NULL);
+    for (uint32_t i = 0; i < MEDIUM_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL(0, p_mem[i]);
+    }
+    TEST_ASSERT(mem_trim(p_mem, 1) == p_mem);
+    mem_free(p_mem);
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, blocks_available(1));
+}
+
+
+/**@brief Received packets reach lwIP without a copy and are freed with the last reference. */
+static void rx_zero_copy(void)
+{
+    port_init();
+
+    uint8_t * p_packet = packet_receive(&m_interface, PACKET_LEN);
+
+    TEST_ASSERT_EQUAL(1, m_ip6_input_cnt);
+    TEST_ASSERT(mp_held_pbuf != NULL);
+    TEST_ASSERT(mp_held_pbuf->payload == p_packet);
+    TEST_ASSERT_EQUAL(PACKET_LEN, mp_held_pbuf->len);
+    TEST_ASSERT_EQUAL(PACKET_LEN, mp_held_pbuf->tot_len);
+    TEST_ASSERT(mp_held_pbuf->next == NULL);
+    TEST_ASSERT_EQUAL(1, m_nrf_alloc_cnt);
+    TEST_ASSERT_EQUAL(BLOCK_COUNT - 1, blocks_available(1));
+
+    TEST_ASSERT_EQUAL(1, pbuf_free(mp_held_pbuf));
+    mp_held_pbuf = NULL;
+    TEST_ASSERT_EQUAL(0, m_nrf_alloc_cnt);
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, blocks_available(1));
+
+    // A packet for an interface that was never added is dropped.
+    (void)packet_receive(&m_other_interface, PACKET_LEN);
+    TEST_ASSERT_EQUAL(1, m_ip6_input_cnt);
+    TEST_ASSERT_EQUAL(0, m_nrf_alloc_cnt);
+
+    // A packet that cannot be wrapped in a pbuf is dropped.
+    void * p_blocks[BLOCK_COUNT];
+
+    for (uint32_t i = 0; i < BLOCK_COUNT; i++)
+    {
+        p_blocks[i] = mem_malloc(1);
+    }
+    (void)packet_receive(&m_interface, PACKET_LEN);
+    TEST_ASSERT_EQUAL(1, m_ip6_input_cnt);
+    TEST_ASSERT_EQUAL(0, m_nrf_alloc_cnt);
+    for (uint32_t i = 0; i < BLOCK_COUNT; i++)
+    {
+        mem_free(p_blocks[i]);
+    }
+
+    // Once the interface is deleted, its packets are dropped.
+    ble_6lowpan_event_t event = {.event_id = BLE_6LO_EVT_INTERFACE_DELETE};
+
+    m_6lowpan_handler(&m_interface, &event);
+    TEST_ASSERT(mp_netif == NULL);
+    TEST_ASSERT_EQUAL(1, m_interface_down_cnt);
+    (void)packet_receive(&m_interface, PACKET_LEN);
+    TEST_ASSERT_EQUAL(1, m_ip6_input_cnt);
+    TEST_ASSERT_EQUAL(0, m_nrf_alloc_cnt);
+}
+
+
+/**@brief A pbuf chain is sent as one contiguous packet. */
+static void tx_chain(void)
+{
+    port_init();
+
+    struct netif * p_netif  = mp_netif;
+    struct pbuf  * p_first  = pbuf_alloc(PBUF_RAW, TX_FIRST_LEN, PBUF_RAM);
+    struct pbuf  * p_second = pbuf_alloc(PBUF_RAW, TX_SECOND_LEN, PBUF_RAM);
+
+    TEST_ASSERT((p_first != NULL) && (p_second != NULL));
+    for (uint32_t i = 0; i < TX_FIRST_LEN; i++)
+    {
+        ((uint8_t *)p_first->payload)[i] = (uint8_t)i;
+    }
+    for (uint32_t i = 0; i < TX_SECOND_LEN; i++)
+    {
+        ((uint8_t *)p_second->payload)[i] = (uint8_t)(TX_FIRST_LEN + i);
+    }
+    pbuf_cat(p_first, p_second);
+
+    TEST_ASSERT_EQUAL(ERR_OK, p_netif->output_ip6(p_netif, p_first, NULL));
+    TEST_ASSERT(mp_sent != NULL);
+    TEST_ASSERT_EQUAL(TX_FIRST_LEN + TX_SECOND_LEN, m_sent_len);
+    for (uint32_t i = 0; i < m_sent_len; i++)
+    {
+        TEST_ASSERT_EQUAL(i, mp_sent[i]);
+    }
+
+    // 6LoWPAN owns the sent packet, the caller still owns the chain.
+    TEST_ASSERT_EQUAL(1, m_nrf_alloc_cnt);
+    nrf_free(mp_sent);
+    mp_sent = NULL;
+
+    // A packet that 6LoWPAN does not accept is freed.
+    m_send_result = NRF_ERROR_NO_MEM;
+    TEST_ASSERT_EQUAL(ERR_MEM, p_netif->output_ip6(p_netif, p_first, NULL));
+    TEST_ASSERT(mp_sent == NULL);
+    TEST_ASSERT_EQUAL(0, m_nrf_alloc_cnt);
+
+    TEST_ASSERT_EQUAL(2, pbuf_free(p_first));
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, blocks_available(1));
+}
+
+
+int main(void)
+{
+    host_test_run("mem_pools", mem_pools);
+    host_test_run("rx_zero_copy", rx_zero_copy);
+    host_test_run("tx_chain", tx_chain);
+    return 0;
+}
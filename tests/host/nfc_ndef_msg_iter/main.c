@@ -0,0 +1,1147 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the NDEF message iterator: generated messages, including chunked payloads,
+ *        a comparison with ndef_msg_parser, a fuzz run over random and corrupted messages, the
+ *        AC and LE OOB record parsers on iterator records, and a benchmark of both parsers on a
+ *        message with many records.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "app_util.h"
+#include "compiler_abstraction.h"
+#include "nfc_ndef_msg_iter.h"
+#include "nfc_ndef_msg_parser.h"
+#include "nfc_ac_rec_parser.h"
+#include "nfc_le_oob_rec_parser.h"
+
+#define NDEF_RECORD_MB_MASK 0x80
+#define NDEF_RECORD_ME_MASK 0x40
+
+#define MAX_RECORDS         8       /**< Maximum number of records in a generated message. */
+#define MAX_CHUNKS          4       /**< Maximum number of chunks of a generated payload. */
+#define MAX_FIELD_LEN       24      /**< Maximum length of a generated type or ID. */
+#define MAX_PAYLOAD_LEN     300     /**< Maximum length of a generated payload, above the short record limit. */
+#define MAX_TRAILER_LEN     8       /**< Maximum number of bytes after the end of a generated message. */
+#define RECORD_HDR_MAX_LEN  7       /**< Flags, type length, long payload length and ID length. */
+#define MSG_BUF_SIZE        (MAX_RECORDS * (MAX_CHUNKS * RECORD_HDR_MAX_LEN + 2 * MAX_FIELD_LEN + \
+                                            MAX_PAYLOAD_LEN) + MAX_TRAILER_LEN)
+
+#define GENERATED_RUNS      20000   /**< Number of generated messages checked against their records. */
+#define COMPARE_RUNS        5000    /**< Number of generated messages compared with ndef_msg_parser. */
+#define FUZZ_RUNS           200000  /**< Number of fuzzed messages. */
+
+#define BENCH_RECORDS       32      /**< Number of records in the benchmark message. */
+#define BENCH_PAYLOAD_LEN   32      /**< Payload length of the benchmark records. */
+#define BENCH_RUNS          20000   /**< Number of times the benchmark message is parsed. */
+#define BENCH_TYPE          LE_OOB_TYPE
+
+#define CH_FUZZ_RUNS        100000  /**< Number of fuzzed connection handover records. */
+#define AC_REF_BUF_LEN      4       /**< Size of the buffers for the Data References of an AC record. */
+#define AC_AUX_REF_MAX      2       /**< Number of Auxiliary Data References an AC record can hold. */
+#define OOB_NAME_BUF_LEN    8       /**< Size of the device name buffer for an LE OOB record. */
+#define AC_TYPE             "ac"
+#define LE_OOB_TYPE         "application/vnd.bluetooth.le.oob"
+
+#define MEMO_SIZE(records)  (NFC_NDEF_PARSER_REQIRED_MEMO_SIZE_CALC(records))
+
+/**@brief Record of a generated message. */
+typedef struct
+{
+    nfc_ndef_record_tnf_t tnf;
+    uint8_t               type[MAX_FIELD_LEN];
+    uint8_t               type_length;
+    uint8_t               id[MAX_FIELD_LEN];
+    uint8_t               id_length;
+    bool                  il;           /**< The ID Length field is present, also for an empty ID. */
+    uint8_t               payload[MAX_PAYLOAD_LEN];
+    uint32_t              payload_length;
+    uint32_t              chunk_count;
+} test_record_t;
+
+/**@brief Generated message. */
+typedef struct
+{
+    test_record_t records[MAX_RECORDS];
+    uint32_t      record_count;
+    uint8_t       raw[MSG_BUF_SIZE];
+    uint32_t      msg_length;           /**< Length of the NDEF message. */
+    uint32_t      raw_length;           /**< Length of the message and the bytes after it. */
+} test_msg_t;
+
+static test_msg_t m_msg;
+static uint32_t   m_rand = 0x6E646566;
+
+__ALIGN(8) static uint8_t m_memo[MEMO_SIZE(BENCH_RECORDS)];
+
+
+static uint32_t rand_below(uint32_t limit)
+{
+    return host_test_rand(&m_rand) % limit;
+}
+
+
+/**@brief Function for encoding one record, or one chunk of a payload.
+ *
+ * @return Length of the encoded record.
+ */
+static uint32_t record_write(uint8_t       * p_buf,
+                             uint8_t         flags,
+                             uint8_t const * p_type,
+                             uint8_t         type_length,
+                             uint8_t const * p_id,
+                             uint8_t         id_length,
+                             uint8_t const * p_payload,
+                             uint32_t        payload_length)
+{
+    uint32_t idx = 0;
+
+    p_buf[idx++] = flags;
+    p_buf[idx++] = type_length;
+    if (flags & NDEF_RECORD_SR_MASK)
+    {
+        p_buf[idx++] = (uint8_t)payload_length;
+    }
+    else
+    {
+        p_buf[idx++] = (uint8_t)(payload_length >> 24);
+        p_buf[idx++] = (uint8_t)(payload_length >> 16);
+        p_buf[idx++] = (uint8_t)(payload_length >> 8);
+        p_buf[idx++] = (uint8_t)payload_length;
+    }
+    if (flags & NDEF_RECORD_IL_MASK)
+    {
+        p_buf[idx++] = id_length;
+    }
+    memcpy(&p_buf[idx], p_type, type_length);
+    idx += type_length;
+    memcpy(&p_buf[idx], p_id, id_length);
+    idx += id_length;
+    memcpy(&p_buf[idx], p_payload, payload_length);
+    idx += payload_length;
+
+    return idx;
+}
+
+
+static void bytes_fill(uint8_t * p_buf, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        p_buf[i] = (uint8_t)host_test_rand(&m_rand);
+    }
+}
+
+
+/**@brief Function for generating a random valid message in m_msg.
+ *
+ * @param[in] chunked Whether payloads may be split into chunks.
+ */
+static void msg_generate(bool chunked)
+{
+    static nfc_ndef_record_tnf_t const tnfs[] =
+    {
+        TNF_EMPTY, TNF_WELL_KNOWN, TNF_MEDIA_TYPE, TNF_ABSOLUTE_URI, TNF_EXTERNAL_TYPE,
+        TNF_UNKNOWN_TYPE, TNF_RESERVED
+    };
+    uint32_t idx = 0;
+
+    m_msg.record_count = 1 + rand_below(MAX_RECORDS);
+    for (uint32_t i = 0; i < m_msg.record_count; i++)
+    {
+        test_record_t * p_rec = &m_msg.records[i];
+
+        p_rec->tnf            = tnfs[rand_below(ARRAY_SIZE(tnfs))];
+        p_rec->type_length    = (uint8_t)rand_below(MAX_FIELD_LEN + 1);
+        p_rec->id_length      = rand_below(2) ? (uint8_t)rand_below(MAX_FIELD_LEN + 1) : 0;
+        p_rec->il             = (p_rec->id_length > 0) || rand_below(2);
+        p_rec->payload_length = rand_below(4) ? rand_below(64) : rand_below(MAX_PAYLOAD_LEN + 1);
+        p_rec->chunk_count    = chunked ? 1 + rand_below(MAX_CHUNKS) : 1;
+        bytes_fill(p_rec->type, p_rec->type_length);
+        bytes_fill(p_rec->id, p_rec->id_length);
+        bytes_fill(p_rec->payload, p_rec->payload_length);
+
+        uint32_t offset = 0;
+
+        for (uint32_t chunk = 0; chunk < p_rec->chunk_count; chunk++)
+        {
+            bool     first  = (chunk == 0);
+            bool     last   = (chunk == p_rec->chunk_count - 1);
+            uint32_t length = last ? p_rec->payload_length - offset
+                                   : rand_below(p_rec->payload_length - offset + 1);
+            uint8_t  flags  = first ? p_rec->tnf : TNF_UNCHANGED;
+
+            if ((i == 0) && first)
+            {
+                flags |= NDEF_RECORD_MB_MASK;
+            }
+            if ((i == m_msg.record_count - 1) && last)
+            {
+                flags |= NDEF_RECORD_ME_MASK;
+            }
+            if (!last)
+            {
+                flags |= NDEF_RECORD_CF_MASK;
+            }
+            if ((length <= UINT8_MAX) && rand_below(4))
+            {
+                flags |= NDEF_RECORD_SR_MASK;
+            }
+            if (first && p_rec->il)
+            {
+                flags |= NDEF_RECORD_IL_MASK;
+            }
+
+            idx += record_write(&m_msg.raw[idx],
+                                flags,
+                                p_rec->type,
+                                first ? p_rec->type_length : 0,
+                                p_rec->id,
+                                first ? p_rec->id_length : 0,
+                                &p_rec->payload[offset],
+                                length);
+            offset += length;
+        }
+    }
+
+    m_msg.msg_length = idx;
+    m_msg.raw_length = idx + rand_below(MAX_TRAILER_LEN + 1);
+    bytes_fill(&m_msg.raw[idx], m_msg.raw_length - idx);
+}
+
+
+static bool field_equal(uint8_t const * p_actual,
+                        uint32_t        actual_length,
+                        uint8_t const * p_expected,
+                        uint32_t        expected_length)
+{
+    return (actual_length == expected_length) &&
+           ((expected_length == 0) || (memcmp(p_actual, p_expected, expected_length) == 0));
+}
+
+
+/**@brief Function for iterating over m_msg and checking every record against the generated one. */
+static void msg_check(void)
+{
+    nfc_ndef_msg_iter_t        iter;
+    nfc_ndef_msg_iter_record_t record;
+    uint8_t                    payload[MAX_PAYLOAD_LEN];
+
+    nfc_ndef_msg_iter_init(&iter, m_msg.raw, m_msg.raw_length);
+    for (uint32_t i = 0; i < m_msg.record_count; i++)
+    {
+        test_record_t const * p_rec = &m_msg.records[i];
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+        TEST_ASSERT_EQUAL((p_rec->tnf == TNF_RESERVED) ? TNF_UNKNOWN_TYPE : p_rec->tnf, record.tnf);
+        TEST_ASSERT(field_equal(record.p_type, record.type_length, p_rec->type, p_rec->type_length));
+        TEST_ASSERT(field_equal(record.p_id, record.id_length, p_rec->id, p_rec->id_length));
+        TEST_ASSERT_EQUAL(p_rec->payload_length, record.payload_length);
+        TEST_ASSERT_EQUAL(p_rec->chunk_count, record.chunk_count);
+
+        if (p_rec->chunk_count > 1)
+        {
+            TEST_ASSERT(record.p_payload == NULL);
+            if (p_rec->payload_length > 0)
+            {
+                TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM,
+                    nfc_ndef_msg_iter_payload_reassemble(&record, payload,
+                                                         p_rec->payload_length - 1));
+            }
+            TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                nfc_ndef_msg_iter_payload_reassemble(&record, payload, p_rec->payload_length));
+            TEST_ASSERT_EQUAL(1, record.chunk_count);
+        }
+        else
+        {
+            // Nothing to do for a contiguous payload.
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_payload_reassemble(&record, NULL, 0));
+        }
+        TEST_ASSERT(field_equal(record.p_payload, record.payload_length,
+                                p_rec->payload, p_rec->payload_length));
+    }
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, nfc_ndef_msg_iter_next(&iter, &record));
+    TEST_ASSERT_EQUAL(m_msg.msg_length, nfc_ndef_msg_iter_offset_get(&iter));
+}
+
+
+/* A message with a chunked payload, written by hand. */
+static void known_message(void)
+{
+    static uint8_t const msg[] =
+    {
+        // First chunk: MB, CF, SR, media type "a/b", payload "he".
+        0xB2, 3, 2, 'a', '/', 'b', 'h', 'e',
+        // Middle chunk: CF, SR, unchanged, payload "ll".
+        0x36, 0, 2, 'l', 'l',
+        // Last chunk: SR, unchanged, payload "o".
+        0x16, 0, 1, 'o',
+        // Well-known record "ac" with ID "X": ME, SR, IL.
+        0x59, 2, 4, 1, 'a', 'c', 'X', 1, 1, 'Y', 0,
+        // Not part of the message.
+        0xFF, 0xFF,
+    };
+    nfc_ndef_msg_iter_t        iter;
+    nfc_ndef_msg_iter_record_t record;
+    uint8_t                    payload[5];
+
+    nfc_ndef_msg_iter_init(&iter, msg, sizeof(msg));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+    TEST_ASSERT_EQUAL(TNF_MEDIA_TYPE, record.tnf);
+    TEST_ASSERT(field_equal(record.p_type, record.type_length, (uint8_t const *)"a/b", 3));
+    TEST_ASSERT_EQUAL(0, record.id_length);
+    TEST_ASSERT_EQUAL(5, record.payload_length);
+    TEST_ASSERT_EQUAL(3, record.chunk_count);
+    TEST_ASSERT(record.p_chunks == msg);
+    TEST_ASSERT_EQUAL(17, record.chunks_length);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, nfc_ndef_msg_iter_payload_reassemble(&record, NULL, 0));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      nfc_ndef_msg_iter_payload_reassemble(&record, payload, sizeof(payload)));
+    TEST_ASSERT(field_equal(record.p_payload, record.payload_length, (uint8_t const *)"hello", 5));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+    TEST_ASSERT_EQUAL(TNF_WELL_KNOWN, record.tnf);
+    TEST_ASSERT(field_equal(record.p_type, record.type_length, (uint8_t const *)"ac", 2));
+    TEST_ASSERT(field_equal(record.p_id, record.id_length, (uint8_t const *)"X", 1));
+    TEST_ASSERT(record.p_payload == &msg[24]);
+    TEST_ASSERT_EQUAL(4, record.payload_length);
+    TEST_ASSERT_EQUAL(1, record.chunk_count);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, nfc_ndef_msg_iter_next(&iter, &record));
+    TEST_ASSERT_EQUAL(sizeof(msg) - 2, nfc_ndef_msg_iter_offset_get(&iter));
+}
+
+
+/* Random valid messages are returned record by record, with chunked payloads reassembled. */
+static void generated_messages(void)
+{
+    for (uint32_t run = 0; run < GENERATED_RUNS; run++)
+    {
+        msg_generate(rand_below(2));
+        msg_check();
+    }
+}
+
+
+/* On messages without chunks, the iterator returns the records that ndef_msg_parser describes,
+ * and both reject the same truncated messages. */
+static void parser_equivalence(void)
+{
+    nfc_ndef_msg_iter_t        iter;
+    nfc_ndef_msg_iter_record_t record;
+
+    for (uint32_t run = 0; run < COMPARE_RUNS; run++)
+    {
+        uint32_t   memo_len;
+        uint32_t   msg_len;
+        ret_code_t parser_err;
+        ret_code_t iter_err;
+
+        msg_generate(false);
+
+        memo_len = sizeof(m_memo);
+        msg_len  = m_msg.raw_length;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ndef_msg_parser(m_memo, &memo_len, m_msg.raw, &msg_len));
+        TEST_ASSERT_EQUAL(m_msg.msg_length, msg_len);
+
+        nfc_ndef_msg_desc_t const * p_msg_desc = (nfc_ndef_msg_desc_t const *)m_memo;
+
+        TEST_ASSERT_EQUAL(m_msg.record_count, p_msg_desc->record_count);
+        nfc_ndef_msg_iter_init(&iter, m_msg.raw, m_msg.raw_length);
+        for (uint32_t i = 0; i < p_msg_desc->record_count; i++)
+        {
+            nfc_ndef_record_desc_t      const * p_rec_desc     = p_msg_desc->pp_record[i];
+            nfc_ndef_bin_payload_desc_t const * p_bin_pay_desc = p_rec_desc->p_payload_descriptor;
+
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+            TEST_ASSERT_EQUAL(p_rec_desc->tnf, record.tnf);
+            TEST_ASSERT(field_equal(record.p_type, record.type_length,
+                                    p_rec_desc->p_type, p_rec_desc->type_length));
+            TEST_ASSERT(field_equal(record.p_id, record.id_length,
+                                    p_rec_desc->p_id, p_rec_desc->id_length));
+            TEST_ASSERT_EQUAL(p_bin_pay_desc->payload_length, record.payload_length);
+            TEST_ASSERT((record.payload_length == 0) ||
+                        (record.p_payload == p_bin_pay_desc->p_payload));
+        }
+        TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, nfc_ndef_msg_iter_next(&iter, &record));
+
+        // Cut the message short.
+        msg_len    = rand_below(m_msg.msg_length);
+        memo_len   = sizeof(m_memo);
+        parser_err = ndef_msg_parser(m_memo, &memo_len, m_msg.raw, &msg_len);
+
+        nfc_ndef_msg_iter_init(&iter, m_msg.raw, msg_len);
+        do
+        {
+            iter_err = nfc_ndef_msg_iter_next(&iter, &record);
+        } while (iter_err == NRF_SUCCESS);
+
+        TEST_ASSERT(parser_err != NRF_SUCCESS);
+        TEST_ASSERT_EQUAL(parser_err, iter_err);
+    }
+}
+
+
+/**@brief Function for getting a length field value, biased towards the limits of the field. */
+static uint32_t length_value_get(void)
+{
+    switch (rand_below(4))
+    {
+        case 0:
+            return rand_below(16);
+
+        case 1:
+            return UINT32_MAX - rand_below(16);
+
+        case 2:
+            return (UINT32_MAX / 2) + rand_below(2);
+
+        default:
+            return host_test_rand(&m_rand);
+    }
+}
+
+
+/**@brief Function for writing records with random headers, whose lengths mostly do not match
+ *        the data that follows, to m_msg.raw.
+ */
+static void headers_generate(void)
+{
+    uint32_t idx = 0;
+
+    for (uint32_t i = 1 + rand_below(4); i > 0; i--)
+    {
+        uint8_t  flags  = (uint8_t)host_test_rand(&m_rand);
+        uint32_t length = length_value_get();
+
+        flags |= (idx == 0) ? NDEF_RECORD_MB_MASK : 0;
+        m_msg.raw[idx++] = flags;
+        m_msg.raw[idx++] = (uint8_t)length_value_get();
+        if (flags & NDEF_RECORD_SR_MASK)
+        {
+            m_msg.raw[idx++] = (uint8_t)length;
+        }
+        else
+        {
+            m_msg.raw[idx++] = (uint8_t)(length >> 24);
+            m_msg.raw[idx++] = (uint8_t)(length >> 16);
+            m_msg.raw[idx++] = (uint8_t)(length >> 8);
+            m_msg.raw[idx++] = (uint8_t)length;
+        }
+        if (flags & NDEF_RECORD_IL_MASK)
+        {
+            m_msg.raw[idx++] = (uint8_t)length_value_get();
+        }
+
+        uint32_t body_length = rand_below(32);
+
+        bytes_fill(&m_msg.raw[idx], body_length);
+        idx += body_length;
+    }
+
+    m_msg.raw_length = idx;
+}
+
+
+/**@brief Function for iterating over arbitrary data and checking that every returned record lies
+ *        within the data.
+ *
+ * @return Number of records returned.
+ */
+static uint32_t fuzz_run(uint8_t const * p_data, uint32_t length)
+{
+    nfc_ndef_msg_iter_t        iter;
+    nfc_ndef_msg_iter_record_t record;
+    ret_code_t                 err;
+    uint32_t                   prev_offset = 0;
+    uint32_t                   count       = 0;
+
+    nfc_ndef_msg_iter_init(&iter, p_data, length);
+    while ((err = nfc_ndef_msg_iter_next(&iter, &record)) == NRF_SUCCESS)
+    {
+        uint8_t const * p_start = p_data + prev_offset;
+        uint8_t const * p_end   = p_data + nfc_ndef_msg_iter_offset_get(&iter);
+
+        TEST_ASSERT((p_end > p_start) && (p_end <= p_data + length));
+        TEST_ASSERT((record.type_length == 0) ||
+                    ((record.p_type >= p_start) && (record.p_type + record.type_length <= p_end)));
+        TEST_ASSERT((record.id_length == 0) ||
+                    ((record.p_id >= p_start) && (record.p_id + record.id_length <= p_end)));
+        TEST_ASSERT(record.payload_length <= (uint32_t)(p_end - p_start));
+
+        if (record.chunk_count > 1)
+        {
+            TEST_ASSERT((record.p_chunks == p_start) &&
+                        (record.chunks_length == (uint32_t)(p_end - p_start)));
+
+            // An exact size heap buffer, so that the sanitizer catches a write past its end.
+            uint8_t * p_payload = malloc(record.payload_length + 1);
+
+            TEST_ASSERT(p_payload != NULL);
+            TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                nfc_ndef_msg_iter_payload_reassemble(&record, p_payload, record.payload_length));
+            free(p_payload);
+        }
+        else if (record.payload_length > 0)
+        {
+            TEST_ASSERT((record.p_payload >= p_start) &&
+                        (record.p_payload + record.payload_length <= p_end));
+        }
+
+        prev_offset = nfc_ndef_msg_iter_offset_get(&iter);
+        count++;
+    }
+
+    TEST_ASSERT((err == NRF_ERROR_NOT_FOUND)    ||
+                (err == NRF_ERROR_INVALID_DATA) ||
+                (err == NRF_ERROR_INVALID_LENGTH));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, nfc_ndef_msg_iter_next(&iter, &record));
+
+    return count;
+}
+
+
+/* Random data, random record headers and corrupted messages, in heap buffers of the exact input size, never make the
+ * iterator return a record outside the input. */
+static void fuzz(void)
+{
+    uint32_t records = 0;
+
+    for (uint32_t run = 0; run < FUZZ_RUNS; run++)
+    {
+        uint32_t source = rand_below(4);
+
+        if (source == 0)
+        {
+            // Random data. Usually starts with the MB flag so that the first record is parsed.
+            m_msg.raw_length = rand_below(64);
+            bytes_fill(m_msg.raw, m_msg.raw_length);
+            if ((m_msg.raw_length > 0) && rand_below(8))
+            {
+                m_msg.raw[0] |= NDEF_RECORD_MB_MASK;
+            }
+        }
+        else if (source == 1)
+        {
+            headers_generate();
+        }
+        else
+        {
+            // A generated message with a few bytes changed, possibly cut short.
+            msg_generate(rand_below(2));
+            for (uint32_t i = rand_below(4); i > 0; i--)
+            {
+                m_msg.raw[rand_below(m_msg.raw_length)] ^= (uint8_t)(1 << rand_below(8));
+            }
+            if (rand_below(4) == 0)
+            {
+                m_msg.raw_length = rand_below(m_msg.raw_length + 1);
+            }
+        }
+
+        uint8_t * p_data = malloc(m_msg.raw_length + 1);
+
+        TEST_ASSERT(p_data != NULL);
+        memcpy(p_data, m_msg.raw, m_msg.raw_length);
+        records += fuzz_run(p_data, m_msg.raw_length);
+        free(p_data);
+    }
+
+    // Enough of the corrupted messages must still be parsed for the run to be meaningful.
+    TEST_ASSERT(records > FUZZ_RUNS);
+}
+
+
+/**@brief Alternative Carrier record content, as returned by the AC record parsers. */
+typedef struct
+{
+    nfc_ac_rec_cps_t cps;
+    uint8_t          aux_count;
+    uint8_t          ref_lengths[1 + AC_AUX_REF_MAX];             /**< Carrier Data Reference first. */
+    uint8_t          refs[1 + AC_AUX_REF_MAX][AC_REF_BUF_LEN];
+} ac_content_t;
+
+/**@brief LE OOB record content, as returned by the LE OOB record parsers. */
+typedef struct
+{
+    ble_advdata_name_type_t name_type;
+    uint8_t                 name_len;
+    uint8_t                 name[OOB_NAME_BUF_LEN];
+    bool                    addr_present;
+    ble_gap_addr_t          addr;
+    bool                    tk_present;
+    ble_advdata_tk_value_t  tk;
+    bool                    lesc_confirm_present;
+    uint8_t                 lesc_confirm[AD_TYPE_CONFIRM_VALUE_DATA_SIZE];
+    bool                    lesc_random_present;
+    uint8_t                 lesc_random[AD_TYPE_RANDOM_VALUE_DATA_SIZE];
+    bool                    oob_flags_present;
+    uint8_t                 oob_flags;
+    ble_advdata_le_role_t   le_role;
+    uint16_t                appearance;
+    uint8_t                 flags;
+} oob_content_t;
+
+
+/**@brief Function for parsing an AC record with nfc_ac_rec_iter_parse, or with nfc_ac_rec_parse
+ *        if @p p_rec_desc is not NULL.
+ */
+static ret_code_t ac_parse(nfc_ndef_msg_iter_record_t const * p_record,
+                           nfc_ndef_record_desc_t     const * p_rec_desc,
+                           ac_content_t                     * p_content)
+{
+    nfc_ac_rec_data_ref_t     aux[AC_AUX_REF_MAX];
+    nfc_ac_rec_payload_desc_t desc =
+    {
+        .carrier_data_ref   = {AC_REF_BUF_LEN, p_content->refs[0]},
+        .max_aux_data_ref   = AC_AUX_REF_MAX,
+        .aux_data_ref_count = AC_AUX_REF_MAX,
+        .p_aux_data_ref     = aux,
+    };
+    ret_code_t err;
+
+    memset(p_content, 0, sizeof(*p_content));
+    for (uint32_t i = 0; i < AC_AUX_REF_MAX; i++)
+    {
+        aux[i].length = AC_REF_BUF_LEN;
+        aux[i].p_data = p_content->refs[1 + i];
+    }
+
+    err = (p_rec_desc != NULL) ? nfc_ac_rec_parse(p_rec_desc, &desc)
+                               : nfc_ac_rec_iter_parse(p_record, &desc);
+    if (err == NRF_SUCCESS)
+    {
+        p_content->cps            = desc.cps;
+        p_content->aux_count      = desc.aux_data_ref_count;
+        p_content->ref_lengths[0] = desc.carrier_data_ref.length;
+        for (uint32_t i = 0; i < desc.aux_data_ref_count; i++)
+        {
+            p_content->ref_lengths[1 + i] = aux[i].length;
+        }
+    }
+    return err;
+}
+
+
+/**@brief Function for parsing an LE OOB record with nfc_le_oob_rec_iter_parse, or with
+ *        nfc_le_oob_rec_parse if @p p_rec_desc is not NULL.
+ */
+static ret_code_t oob_parse(nfc_ndef_msg_iter_record_t const * p_record,
+                            nfc_ndef_record_desc_t     const * p_rec_desc,
+                            oob_content_t                    * p_content)
+{
+    nfc_ble_oob_pairing_data_t data;
+    ret_code_t                 err;
+
+    memset(p_content, 0, sizeof(*p_content));
+    memset(&data, 0, sizeof(data));
+    data.device_name.len      = OOB_NAME_BUF_LEN;
+    data.device_name.p_name   = p_content->name;
+    data.p_device_addr        = &p_content->addr;
+    data.p_tk_value           = &p_content->tk;
+    data.p_lesc_confirm_value = p_content->lesc_confirm;
+    data.p_lesc_random_value  = p_content->lesc_random;
+    data.p_sec_mgr_oob_flags  = &p_content->oob_flags;
+
+    err = (p_rec_desc != NULL) ? nfc_le_oob_rec_parse(p_rec_desc, &data)
+                               : nfc_le_oob_rec_iter_parse(p_record, &data);
+    if (err == NRF_SUCCESS)
+    {
+        p_content->name_type            = data.device_name.name_type;
+        p_content->name_len             = data.device_name.len;
+        p_content->addr_present         = (data.p_device_addr != NULL);
+        p_content->tk_present           = (data.p_tk_value != NULL);
+        p_content->lesc_confirm_present = (data.p_lesc_confirm_value != NULL);
+        p_content->lesc_random_present  = (data.p_lesc_random_value != NULL);
+        p_content->oob_flags_present    = (data.p_sec_mgr_oob_flags != NULL);
+        p_content->le_role              = data.le_role;
+        p_content->appearance           = data.appearance;
+        p_content->flags                = data.flags;
+    }
+    return err;
+}
+
+
+/**@brief Function for writing a record as one or two chunks.
+ *
+ * @return Length of the encoded record.
+ */
+static uint32_t ch_record_write(uint8_t       * p_buf,
+                                uint8_t         tnf,
+                                char    const * p_type,
+                                uint8_t const * p_payload,
+                                uint32_t        payload_length,
+                                uint32_t        first_chunk_length)
+{
+    uint8_t  flags  = tnf | NDEF_RECORD_MB_MASK;
+    uint32_t length = MIN(first_chunk_length, payload_length);
+    uint32_t idx;
+
+    if (length < payload_length)
+    {
+        flags |= NDEF_RECORD_CF_MASK;
+    }
+    else
+    {
+        flags |= NDEF_RECORD_ME_MASK;
+    }
+    if (length <= UINT8_MAX)
+    {
+        flags |= NDEF_RECORD_SR_MASK;
+    }
+    idx = record_write(p_buf, flags, (uint8_t const *)p_type, (uint8_t)strlen(p_type),
+                       (uint8_t const *)"", 0, p_payload, length);
+    if (length < payload_length)
+    {
+        length = payload_length - length;
+        flags  = TNF_UNCHANGED | NDEF_RECORD_ME_MASK;
+        flags |= (length <= UINT8_MAX) ? NDEF_RECORD_SR_MASK : 0;
+        idx   += record_write(&p_buf[idx], flags, (uint8_t const *)"", 0, (uint8_t const *)"", 0,
+                              &p_payload[payload_length - length], length);
+    }
+    return idx;
+}
+
+
+/* The AC and LE OOB record parsers on records returned by the iterator, compared with the
+ * parsers that take a record descriptor. */
+static void conn_hand_vectors(void)
+{
+    static uint8_t const ac_payload[] =
+    {
+        // Active, Carrier Data Reference "0", no Auxiliary Data Reference.
+        0x01, 1, '0', 0,
+    };
+    static uint8_t const oob_payload[] =
+    {
+        // LE Bluetooth Device Address, random.
+        8, BLE_GAP_AD_TYPE_LE_BLUETOOTH_DEVICE_ADDRESS, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x01,
+        // LE Role, only peripheral.
+        2, BLE_GAP_AD_TYPE_LE_ROLE, NFC_BLE_ADVDATA_ROLE_ENCODED_ONLY_PERIPH,
+        // Complete Local Name.
+        4, BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME, 'n', 'R', 'F',
+    };
+    nfc_ndef_msg_iter_t        iter;
+    nfc_ndef_msg_iter_record_t record;
+    ac_content_t               ac;
+    ac_content_t               ac_desc;
+    oob_content_t              oob;
+    oob_content_t              oob_desc;
+    uint8_t                    payload[MAX_PAYLOAD_LEN];
+    uint32_t                   msg_len;
+    uint32_t                   memo_len;
+
+    msg_len  = record_write(m_msg.raw, TNF_WELL_KNOWN | NDEF_RECORD_MB_MASK | NDEF_RECORD_SR_MASK,
+                            (uint8_t const *)AC_TYPE, sizeof(AC_TYPE) - 1, (uint8_t const *)"", 0,
+                            ac_payload, sizeof(ac_payload));
+    msg_len += record_write(&m_msg.raw[msg_len],
+                            TNF_MEDIA_TYPE | NDEF_RECORD_ME_MASK | NDEF_RECORD_SR_MASK |
+                            NDEF_RECORD_IL_MASK,
+                            (uint8_t const *)LE_OOB_TYPE, sizeof(LE_OOB_TYPE) - 1,
+                            (uint8_t const *)"0", 1,
+                            oob_payload, sizeof(oob_payload));
+
+    nfc_ndef_msg_iter_init(&iter, m_msg.raw, msg_len);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ac_parse(&record, NULL, &ac));
+    TEST_ASSERT_EQUAL(NFC_AC_CPS_ACTIVE, ac.cps);
+    TEST_ASSERT_EQUAL(1, ac.ref_lengths[0]);
+    TEST_ASSERT_EQUAL('0', ac.refs[0][0]);
+    TEST_ASSERT_EQUAL(0, ac.aux_count);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, oob_parse(&record, NULL, &oob));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, oob_parse(&record, NULL, &oob));
+    TEST_ASSERT(oob.addr_present);
+    TEST_ASSERT(memcmp(oob.addr.addr, &oob_payload[2], BLE_GAP_ADDR_LEN) == 0);
+    TEST_ASSERT_EQUAL(BLE_GAP_ADDR_TYPE_RANDOM_STATIC, oob.addr.addr_type);
+    TEST_ASSERT_EQUAL(BLE_ADVDATA_ROLE_ONLY_PERIPH, oob.le_role);
+    TEST_ASSERT_EQUAL(BLE_ADVDATA_FULL_NAME, oob.name_type);
+    TEST_ASSERT(field_equal(oob.name, oob.name_len, (uint8_t const *)"nRF", 3));
+    TEST_ASSERT(!oob.tk_present && !oob.lesc_confirm_present && !oob.oob_flags_present);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, ac_parse(&record, NULL, &ac_desc));
+
+    memo_len = sizeof(m_memo);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ndef_msg_parser(m_memo, &memo_len, m_msg.raw, &msg_len));
+
+    nfc_ndef_msg_desc_t const * p_msg_desc = (nfc_ndef_msg_desc_t const *)m_memo;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ac_parse(NULL, p_msg_desc->pp_record[0], &ac_desc));
+    TEST_ASSERT(memcmp(&ac, &ac_desc, sizeof(ac)) == 0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, oob_parse(NULL, p_msg_desc->pp_record[1], &oob_desc));
+    TEST_ASSERT(memcmp(&oob, &oob_desc, sizeof(oob)) == 0);
+
+    // A chunked record is parsed once it has been reassembled.
+    msg_len = ch_record_write(m_msg.raw, TNF_MEDIA_TYPE, LE_OOB_TYPE,
+                              oob_payload, sizeof(oob_payload), 5);
+    nfc_ndef_msg_iter_init(&iter, m_msg.raw, msg_len);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+    TEST_ASSERT_EQUAL(2, record.chunk_count);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_SUPPORTED, oob_parse(&record, NULL, &oob_desc));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      nfc_ndef_msg_iter_payload_reassemble(&record, payload, sizeof(payload)));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, oob_parse(&record, NULL, &oob_desc));
+    TEST_ASSERT(memcmp(&oob, &oob_desc, sizeof(oob)) == 0);
+
+    // AD structures take an 8-bit length. A longer payload is rejected rather than truncated to
+    // its low byte, which here would leave the valid AD structures alone.
+    static uint32_t const oob_lengths[] = {UINT8_MAX, UINT8_MAX + 1, UINT8_MAX + 1 + sizeof(oob_payload)};
+
+    memset(payload, 0, sizeof(payload));
+    memcpy(payload, oob_payload, sizeof(oob_payload));
+    for (uint32_t i = 0; i < ARRAY_SIZE(oob_lengths); i++)
+    {
+        ret_code_t expected = (oob_lengths[i] <= UINT8_MAX) ? NRF_SUCCESS : NRF_ERROR_INVALID_LENGTH;
+
+        msg_len = ch_record_write(m_msg.raw, TNF_MEDIA_TYPE, LE_OOB_TYPE,
+                                  payload, oob_lengths[i], oob_lengths[i]);
+        nfc_ndef_msg_iter_init(&iter, m_msg.raw, msg_len);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+        TEST_ASSERT_EQUAL(expected, oob_parse(&record, NULL, &oob_desc));
+
+        memo_len = sizeof(m_memo);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ndef_msg_parser(m_memo, &memo_len, m_msg.raw, &msg_len));
+        TEST_ASSERT_EQUAL(expected, oob_parse(NULL, p_msg_desc->pp_record[0], &oob_desc));
+    }
+}
+
+
+/**@brief AC record payload that the parser rejects. */
+typedef struct
+{
+    uint8_t    payload[8];
+    uint8_t    length;
+    ret_code_t err;
+} ac_vector_t;
+
+/* Malformed AC record payloads are rejected with the documented errors. */
+static void conn_hand_ac_errors(void)
+{
+    static ac_vector_t const vectors[] =
+    {
+        {{0x04, 1, '0', 0},              4, NRF_ERROR_INVALID_PARAM},  // Reserved CPS value.
+        {{0x01, 1},                      2, NRF_ERROR_INVALID_LENGTH}, // Shorter than the fixed fields.
+        {{0x01, 2, '0'},                 3, NRF_ERROR_INVALID_LENGTH}, // Reference past the end.
+        {{0x01, 1, '0'},                 3, NRF_ERROR_INVALID_LENGTH}, // No Auxiliary Data Reference count.
+        {{0x01, 0, 1},                   3, NRF_ERROR_INVALID_LENGTH}, // Auxiliary Data Reference missing.
+        {{0x01, 0, 1, 3, 'x'},           5, NRF_ERROR_INVALID_LENGTH}, // Auxiliary Data Reference past the end.
+        {{0x01, 1, '0', 0, 0},           5, NRF_ERROR_INVALID_LENGTH}, // Trailing byte.
+        {{0x01, 5, 'a', 'b', 'c', 'd', 'e', 0}, 8, NRF_ERROR_NO_MEM}, // Reference longer than the buffer.
+        {{0x01, 0, AC_AUX_REF_MAX + 1},  3, NRF_ERROR_NO_MEM},         // Too many Auxiliary Data References.
+        {{0x02, 0, 1, 1, 'x'},           5, NRF_SUCCESS},
+    };
+    nfc_ndef_msg_iter_t        iter;
+    nfc_ndef_msg_iter_record_t record;
+    ac_content_t               ac;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(vectors); i++)
+    {
+        uint32_t  msg_len;
+        uint8_t * p_data = malloc(MSG_BUF_SIZE);
+
+        TEST_ASSERT(p_data != NULL);
+        msg_len = ch_record_write(p_data, TNF_WELL_KNOWN, AC_TYPE,
+                                  vectors[i].payload, vectors[i].length, vectors[i].length);
+        // The payload ends the input, so that the sanitizer catches a read past it.
+        p_data = realloc(p_data, msg_len);
+        TEST_ASSERT(p_data != NULL);
+
+        nfc_ndef_msg_iter_init(&iter, p_data, msg_len);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+        TEST_ASSERT_EQUAL(vectors[i].err, ac_parse(&record, NULL, &ac));
+        free(p_data);
+    }
+    TEST_ASSERT_EQUAL(NFC_AC_CPS_ACTIVATING, ac.cps);
+    TEST_ASSERT_EQUAL(1, ac.aux_count);
+    TEST_ASSERT_EQUAL('x', ac.refs[1][0]);
+}
+
+
+/**@brief Function for generating a valid AC record payload.
+ *
+ * @return Length of the payload.
+ */
+static uint32_t ac_payload_generate(uint8_t * p_buf)
+{
+    uint32_t idx       = 0;
+    uint32_t aux_count = rand_below(AC_AUX_REF_MAX + 1);
+
+    p_buf[idx++] = (uint8_t)rand_below(NFC_AC_CPS_UNKNOWN + 1);
+    for (uint32_t i = 0; i <= aux_count; i++)
+    {
+        uint8_t length = (uint8_t)rand_below(AC_REF_BUF_LEN + 1);
+
+        if (i == 1)
+        {
+            p_buf[idx++] = (uint8_t)aux_count;
+        }
+        p_buf[idx++] = length;
+        bytes_fill(&p_buf[idx], length);
+        idx += length;
+    }
+    if (aux_count == 0)
+    {
+        p_buf[idx++] = 0;
+    }
+    return idx;
+}
+
+
+/**@brief Function for generating a valid LE OOB record payload with a random set of optional AD
+ *        structures. The device address and the role are always present, as required.
+ *
+ * @return Length of the payload.
+ */
+static uint32_t oob_payload_generate(uint8_t * p_buf)
+{
+    static struct
+    {
+        uint8_t type;
+        uint8_t length;     /**< Data length, 0 for a random one. */
+        bool    optional;
+    } const ad_types[] =
+    {
+        {BLE_GAP_AD_TYPE_FLAGS,                       AD_TYPE_FLAGS_DATA_SIZE,           true},
+        {BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME,         0,                                 true},
+        {BLE_GAP_AD_TYPE_SECURITY_MANAGER_TK_VALUE,   AD_TYPE_TK_VALUE_DATA_SIZE,        true},
+        {BLE_GAP_AD_TYPE_LESC_CONFIRMATION_VALUE,     AD_TYPE_CONFIRM_VALUE_DATA_SIZE,   true},
+        {BLE_GAP_AD_TYPE_LESC_RANDOM_VALUE,           AD_TYPE_RANDOM_VALUE_DATA_SIZE,    true},
+        {BLE_GAP_AD_TYPE_SECURITY_MANAGER_OOB_FLAGS,  AD_TYPE_OOB_FLAGS_DATA_SIZE,       true},
+        {BLE_GAP_AD_TYPE_APPEARANCE,                  AD_TYPE_APPEARANCE_DATA_SIZE,      true},
+        {BLE_GAP_AD_TYPE_LE_BLUETOOTH_DEVICE_ADDRESS, AD_TYPE_BLE_DEVICE_ADDR_DATA_SIZE, false},
+        {BLE_GAP_AD_TYPE_LE_ROLE,                     AD_TYPE_LE_ROLE_DATA_SIZE,         false},
+    };
+    uint32_t idx = 0;
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(ad_types); i++)
+    {
+        if (ad_types[i].optional && rand_below(2))
+        {
+            continue;
+        }
+
+        uint8_t length = (ad_types[i].length != 0) ? ad_types[i].length
+                                                   : (uint8_t)(1 + rand_below(OOB_NAME_BUF_LEN));
+
+        p_buf[idx++] = length + 1;
+        p_buf[idx++] = ad_types[i].type;
+        bytes_fill(&p_buf[idx], length);
+        if (ad_types[i].type == BLE_GAP_AD_TYPE_LE_ROLE)
+        {
+            p_buf[idx] = (uint8_t)rand_below(NFC_BLE_ADVDATA_ROLE_ENCODED_BOTH_CENTRAL_PREFERRED + 1);
+        }
+        idx += length;
+    }
+    return idx;
+}
+
+
+/**@brief Function for checking an error code of the AC or LE OOB record parsers. */
+static bool conn_hand_err_valid(ret_code_t err)
+{
+    return (err == NRF_SUCCESS)             ||
+           (err == NRF_ERROR_INVALID_DATA)  ||
+           (err == NRF_ERROR_NOT_SUPPORTED) ||
+           (err == NRF_ERROR_NO_MEM)        ||
+           (err == NRF_ERROR_INVALID_LENGTH)||
+           (err == NRF_ERROR_INVALID_PARAM) ||
+           (err == NRF_ERROR_NULL);
+}
+
+
+/* Valid and corrupted AC and LE OOB records, in heap buffers of the exact input size, are parsed
+ * without accesses outside the input. Valid ones are accepted. */
+static void conn_hand_fuzz(void)
+{
+    uint8_t  payload[MAX_PAYLOAD_LEN];
+    uint32_t accepted = 0;
+
+    for (uint32_t run = 0; run < CH_FUZZ_RUNS; run++)
+    {
+        bool     is_ac   = rand_below(2);
+        bool     corrupt = rand_below(4) != 0;
+        uint32_t length  = is_ac ? ac_payload_generate(payload) : oob_payload_generate(payload);
+
+        if (corrupt)
+        {
+            for (uint32_t i = rand_below(3); (i > 0) && (length > 0); i--)
+            {
+                payload[rand_below(length)] ^= (uint8_t)(1 << rand_below(8));
+            }
+            switch (rand_below(4))
+            {
+                case 0:
+                    length = rand_below(length + 1);
+                    break;
+
+                case 1:
+                    // Random bytes after the payload, sometimes past the 8-bit length.
+                    {
+                        uint32_t extra = rand_below(8) ? rand_below(8)
+                                                       : rand_below(MAX_PAYLOAD_LEN - length + 1);
+
+                        bytes_fill(&payload[length], extra);
+                        length += extra;
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        uint32_t  first_chunk = rand_below(4) ? length : rand_below(length + 1);
+        uint32_t  msg_len     = ch_record_write(m_msg.raw,
+                                                is_ac ? TNF_WELL_KNOWN : TNF_MEDIA_TYPE,
+                                                is_ac ? AC_TYPE : LE_OOB_TYPE,
+                                                payload, length, first_chunk);
+        uint8_t * p_data      = malloc(msg_len);
+        uint8_t * p_payload   = NULL;
+
+        TEST_ASSERT(p_data != NULL);
+        memcpy(p_data, m_msg.raw, msg_len);
+
+        nfc_ndef_msg_iter_t        iter;
+        nfc_ndef_msg_iter_record_t record;
+        ac_content_t               ac;
+        oob_content_t              oob;
+        ret_code_t                 err;
+
+        nfc_ndef_msg_iter_init(&iter, p_data, msg_len);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nfc_ndef_msg_iter_next(&iter, &record));
+        if (record.chunk_count > 1)
+        {
+            TEST_ASSERT_EQUAL(NRF_ERROR_NOT_SUPPORTED,
+                              is_ac ? ac_parse(&record, NULL, &ac) : oob_parse(&record, NULL, &oob));
+
+            p_payload = malloc(record.payload_length);
+            TEST_ASSERT(p_payload != NULL);
+            TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                nfc_ndef_msg_iter_payload_reassemble(&record, p_payload, record.payload_length));
+        }
+
+        err = is_ac ? ac_parse(&record, NULL, &ac) : oob_parse(&record, NULL, &oob);
+        TEST_ASSERT(conn_hand_err_valid(err));
+        TEST_ASSERT(corrupt || (err == NRF_SUCCESS));
+        TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA,
+                          is_ac ? oob_parse(&record, NULL, &oob) : ac_parse(&record, NULL, &ac));
+        accepted += (err == NRF_SUCCESS) ? 1 : 0;
+
+        free(p_payload);
+        free(p_data);
+    }
+
+    // Enough of the corrupted records must still be parsed for the run to be meaningful.
+    TEST_ASSERT(accepted > CH_FUZZ_RUNS / 3);
+}
+
+
+/* Parses a message with many records, like a connection handover message, with the iterator and
+ * with ndef_msg_parser. */
+static void benchmark(void)
+{
+    uint8_t                    payload[BENCH_PAYLOAD_LEN];
+    uint8_t                    id[2];
+    uint32_t                   msg_len = 0;
+    nfc_ndef_msg_iter_t        iter;
+    nfc_ndef_msg_iter_record_t record;
+    uint64_t                   start;
+    uint32_t                   count = 0;
+
+    bytes_fill(payload, sizeof(payload));
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++)
+    {
+        uint8_t flags = TNF_MEDIA_TYPE | NDEF_RECORD_SR_MASK | NDEF_RECORD_IL_MASK;
+
+        flags |= (i == 0) ? NDEF_RECORD_MB_MASK : 0;
+        flags |= (i == BENCH_RECORDS - 1) ? NDEF_RECORD_ME_MASK : 0;
+        id[0]  = (uint8_t)('0' + i / 10);
+        id[1]  = (uint8_t)('0' + i % 10);
+        msg_len += record_write(&m_msg.raw[msg_len], flags,
+                                (uint8_t const *)BENCH_TYPE, sizeof(BENCH_TYPE) - 1,
+                                id, sizeof(id),
+                                payload, sizeof(payload));
+    }
+
+    start = host_test_time_ns();
+    for (uint32_t run = 0; run < BENCH_RUNS; run++)
+    {
+        nfc_ndef_msg_iter_init(&iter, m_msg.raw, msg_len);
+        while (nfc_ndef_msg_iter_next(&iter, &record) == NRF_SUCCESS)
+        {
+            count++;
+        }
+    }
+    printf("    nfc_ndef_msg_iter: %u ns per message, %u bytes of RAM\n",
+           (unsigned)((host_test_time_ns() - start) / BENCH_RUNS),
+           (unsigned)(sizeof(iter) + sizeof(record)));
+    TEST_ASSERT_EQUAL(BENCH_RUNS * BENCH_RECORDS, count);
+
+    start = host_test_time_ns();
+    for (uint32_t run = 0; run < BENCH_RUNS; run++)
+    {
+        uint32_t memo_len = sizeof(m_memo);
+        uint32_t data_len = msg_len;
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ndef_msg_parser(m_memo, &memo_len, m_msg.raw, &data_len));
+    }
+    printf("    ndef_msg_parser:   %u ns per message, %u bytes of RAM\n",
+           (unsigned)((host_test_time_ns() - start) / BENCH_RUNS),
+           (unsigned)sizeof(m_memo));
+    TEST_ASSERT_EQUAL(BENCH_RECORDS, ((nfc_ndef_msg_desc_t const *)m_memo)->record_count);
+}
+
+
+int main(void)
+{
+    host_test_run("known_message", known_message);
+    host_test_run("generated_messages", generated_messages);
+    host_test_run("parser_equivalence", parser_equivalence);
+    host_test_run("fuzz", fuzz);
+    host_test_run("conn_hand_vectors", conn_hand_vectors);
+    host_test_run("conn_hand_ac_errors", conn_hand_ac_errors);
+    host_test_run("conn_hand_fuzz", conn_hand_fuzz);
+    host_test_run("benchmark", benchmark);
+    return 0;
+}
@@ -0,0 +1,334 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the nrf_fstorage_ram NOR flash emulation: 1 to 0 programming in the strict and
+ *        the AND modes, page erase granularity, wear and statistics counters, and persistence of
+ *        a file backed device.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_ram.h"
+
+#define PAGE_SIZE   NRF_FSTORAGE_RAM_PAGE_SIZE
+#define PAGE_ADDR(i) (NRF_FSTORAGE_RAM_BASE_ADDR + (i) * PAGE_SIZE)
+
+/* Build of nrf_fstorage_ram with NRF_FSTORAGE_RAM_STRICT_NOR disabled, see nrf_fstorage_ram_and.c. */
+extern nrf_fstorage_api_t nrf_fstorage_ram_and;
+
+void nrf_fstorage_ram_and_stats_get(nrf_fstorage_ram_stats_t * p_stats);
+
+static nrf_fstorage_evt_t m_evt;        /**< Last event received. */
+static uint32_t           m_evt_cnt;    /**< Number of events received. */
+
+
+static void fs_evt_handler(nrf_fstorage_evt_t * p_evt)
+{
+    m_evt = *p_evt;
+    m_evt_cnt++;
+}
+
+
+NRF_FSTORAGE_DEF(nrf_fstorage_t m_fs) =
+{
+    .evt_handler = fs_evt_handler,
+    .start_addr  = NRF_FSTORAGE_RAM_BASE_ADDR,
+    .end_addr    = NRF_FSTORAGE_RAM_BASE_ADDR + NRF_FSTORAGE_RAM_SIZE,
+};
+
+NRF_FSTORAGE_DEF(nrf_fstorage_t m_fs_and) =
+{
+    .evt_handler = fs_evt_handler,
+    .start_addr  = NRF_FSTORAGE_RAM_BASE_ADDR,
+    .end_addr    = NRF_FSTORAGE_RAM_BASE_ADDR + NRF_FSTORAGE_RAM_SIZE,
+};
+
+
+static void setup(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_init(&m_fs, &nrf_fstorage_ram, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_init(&m_fs_and, &nrf_fstorage_ram_and, NULL));
+    nrf_fstorage_ram_reset();
+    nrf_fstorage_ram_stats_clear();
+    nrf_fstorage_ram_timing_set(NRF_FSTORAGE_RAM_WRITE_TIME_US, NRF_FSTORAGE_RAM_ERASE_TIME_US);
+    memset(&m_evt, 0, sizeof(m_evt));
+    m_evt_cnt = 0;
+}
+
+
+static uint32_t word_read(nrf_fstorage_t const * p_fs, uint32_t addr)
+{
+    uint32_t word;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_read(p_fs, addr, &word, sizeof(word)));
+    return word;
+}
+
+
+static void word_write(nrf_fstorage_t const * p_fs, uint32_t addr, uint32_t const * p_word)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(p_fs, addr, p_word, sizeof(*p_word), NULL));
+    TEST_ASSERT_EQUAL(NRF_FSTORAGE_EVT_WRITE_RESULT, m_evt.id);
+    TEST_ASSERT_EQUAL(addr, m_evt.addr);
+}
+
+
+/* Strict mode: a write which would set a bit fails in its event and leaves the flash as it was. */
+static void strict_nor(void)
+{
+    static uint32_t const first  = 0x0F0F0F0F;
+    static uint32_t const second = 0x00FF00FF;
+    static uint32_t const clear  = 0x0000000F;
+    nrf_fstorage_ram_stats_t stats;
+
+    setup();
+
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(1)));
+
+    word_write(&m_fs, PAGE_ADDR(1), &first);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evt.result);
+    TEST_ASSERT_EQUAL(first, word_read(&m_fs, PAGE_ADDR(1)));
+
+    word_write(&m_fs, PAGE_ADDR(1), &second);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, m_evt.result);
+    TEST_ASSERT_EQUAL(first, word_read(&m_fs, PAGE_ADDR(1)));
+
+    /* Clearing more bits of a programmed word is allowed. */
+    word_write(&m_fs, PAGE_ADDR(1), &clear);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evt.result);
+    TEST_ASSERT_EQUAL(clear, word_read(&m_fs, PAGE_ADDR(1)));
+
+    nrf_fstorage_ram_stats_get(&stats);
+    TEST_ASSERT_EQUAL(2, stats.writes);
+    TEST_ASSERT_EQUAL(2 * sizeof(uint32_t), stats.bytes_written);
+    TEST_ASSERT_EQUAL(1, stats.nor_violations);
+    TEST_ASSERT_EQUAL(3, m_evt_cnt);
+
+    /* The device does not support writable mapping, or it could bypass the check. */
+    TEST_ASSERT(nrf_fstorage_wmap(&m_fs, PAGE_ADDR(1)) == NULL);
+    TEST_ASSERT_EQUAL(clear, *(uint32_t const *)nrf_fstorage_rmap(&m_fs, PAGE_ADDR(1)));
+}
+
+
+/* AND mode: the same write succeeds like on the hardware, and is still counted. */
+static void and_nor(void)
+{
+    static uint32_t const first  = 0x0F0F0F0F;
+    static uint32_t const second = 0x00FF00FF;
+    nrf_fstorage_ram_stats_t stats_before;
+    nrf_fstorage_ram_stats_t stats;
+
+    setup();
+    nrf_fstorage_ram_and_stats_get(&stats_before);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_erase(&m_fs_and, PAGE_ADDR(2), 1, NULL));
+
+    word_write(&m_fs_and, PAGE_ADDR(2), &first);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evt.result);
+
+    word_write(&m_fs_and, PAGE_ADDR(2), &second);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evt.result);
+    TEST_ASSERT_EQUAL(first & second, word_read(&m_fs_and, PAGE_ADDR(2)));
+
+    nrf_fstorage_ram_and_stats_get(&stats);
+    TEST_ASSERT_EQUAL(2, stats.writes - stats_before.writes);
+    TEST_ASSERT_EQUAL(1, stats.nor_violations - stats_before.nor_violations);
+
+    /* The strict device is separate and was not touched. */
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(2)));
+}
+
+
+/* Only whole pages are erased, and a bad range is rejected before any of it is erased. */
+static void erase_granularity(void)
+{
+    static uint32_t const zero = 0;
+    uint32_t              buf[PAGE_SIZE / sizeof(uint32_t)];
+    uint32_t              i;
+
+    setup();
+
+    for (i = 0; i < 3 * PAGE_SIZE; i += PAGE_SIZE / 4)
+    {
+        word_write(&m_fs, PAGE_ADDR(4) + i, &zero);
+    }
+    word_write(&m_fs, PAGE_ADDR(5) + PAGE_SIZE - sizeof(zero), &zero);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_erase(&m_fs, PAGE_ADDR(5), 1, NULL));
+    TEST_ASSERT_EQUAL(NRF_FSTORAGE_EVT_ERASE_RESULT, m_evt.id);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evt.result);
+    TEST_ASSERT_EQUAL(PAGE_ADDR(5), m_evt.addr);
+    TEST_ASSERT_EQUAL(1, m_evt.len);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_read(&m_fs, PAGE_ADDR(5), buf, sizeof(buf)));
+    for (i = 0; i < ARRAY_SIZE(buf); i++)
+    {
+        TEST_ASSERT_EQUAL(0xFFFFFFFF, buf[i]);
+    }
+
+    /* The neighbouring pages keep their contents up to the page boundary. */
+    TEST_ASSERT_EQUAL(0, word_read(&m_fs, PAGE_ADDR(4)));
+    TEST_ASSERT_EQUAL(0, word_read(&m_fs, PAGE_ADDR(4) + 3 * PAGE_SIZE / 4));
+    TEST_ASSERT_EQUAL(0, word_read(&m_fs, PAGE_ADDR(6)));
+
+    /* The implementation checks the range itself, the frontend checks can be compiled out. */
+    m_evt_cnt = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR,
+                      nrf_fstorage_ram.erase(&m_fs, PAGE_ADDR(4) + 4, 1, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR,
+                      nrf_fstorage_ram.erase(&m_fs, PAGE_ADDR(NRF_FSTORAGE_RAM_PAGE_CNT - 1), 2, NULL));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR,
+                      nrf_fstorage_ram.erase(&m_fs, PAGE_ADDR(NRF_FSTORAGE_RAM_PAGE_CNT), 1, NULL));
+
+    /* A page count which wraps around when converted to bytes. */
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR,
+                      nrf_fstorage_ram.erase(&m_fs, PAGE_ADDR(4), 0xFFFFFFFF / PAGE_SIZE + 2, NULL));
+    TEST_ASSERT_EQUAL(0, m_evt_cnt);
+    TEST_ASSERT_EQUAL(0, word_read(&m_fs, PAGE_ADDR(4)));
+
+    /* Up to the last page. */
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      nrf_fstorage_ram.erase(&m_fs, PAGE_ADDR(4), NRF_FSTORAGE_RAM_PAGE_CNT - 4, NULL));
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(4)));
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(6)));
+}
+
+
+/* Every page counts its erase cycles, and the time the device would be busy is accumulated. */
+static void wear_and_stats(void)
+{
+    static uint32_t const data[4] = {0x11111111, 0x22222222, 0x33333333, 0x44444444};
+    nrf_fstorage_ram_stats_t stats;
+    uint32_t const *         p_cnt = nrf_fstorage_ram_erase_counts_get();
+
+    setup();
+    nrf_fstorage_ram_timing_set(10, 1000);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_erase(&m_fs, PAGE_ADDR(3), 2, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_erase(&m_fs, PAGE_ADDR(3), 1, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(3), data, sizeof(data), NULL));
+
+    for (uint32_t i = 0; i < NRF_FSTORAGE_RAM_PAGE_CNT; i++)
+    {
+        TEST_ASSERT_EQUAL((i == 3) ? 2 : (i == 4) ? 1 : 0, p_cnt[i]);
+    }
+
+    nrf_fstorage_ram_stats_get(&stats);
+    TEST_ASSERT_EQUAL(1, stats.writes);
+    TEST_ASSERT_EQUAL(sizeof(data), stats.bytes_written);
+    TEST_ASSERT_EQUAL(2, stats.erases);
+    TEST_ASSERT_EQUAL(3, stats.pages_erased);
+    TEST_ASSERT_EQUAL(0, stats.nor_violations);
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(data) * 10 + 3 * 1000, stats.busy_time_us);
+
+    /* A reset erases the device without counting it. */
+    nrf_fstorage_ram_reset();
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(3)));
+    TEST_ASSERT_EQUAL(2, p_cnt[3]);
+
+    nrf_fstorage_ram_stats_clear();
+    nrf_fstorage_ram_stats_get(&stats);
+    TEST_ASSERT_EQUAL(0, stats.erases);
+    TEST_ASSERT_EQUAL(0, stats.busy_time_us);
+    TEST_ASSERT_EQUAL(0, p_cnt[3]);
+    TEST_ASSERT_EQUAL(0, p_cnt[4]);
+}
+
+
+/* The contents of a file backed device survive closing and reopening it. */
+static void file_persistence(void)
+{
+    static uint32_t const data[2] = {0xCAFEF00D, 0x0BADBEEF};
+    static uint32_t const ones    = 0xFFFFFFFF;
+    char                  path[]  = "/tmp/nrf_fstorage_ram_XXXXXX";
+    int                   fd;
+
+    setup();
+
+    fd = mkstemp(path);
+    TEST_ASSERT(fd >= 0);
+    (void) close(fd);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, nrf_fstorage_ram_file_close());
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_ram_file_open(path));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, nrf_fstorage_ram_file_open(path));
+
+    /* A new file reads as erased flash. */
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(NRF_FSTORAGE_RAM_PAGE_CNT - 1)));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(7), data, sizeof(data), NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evt.result);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_ram_file_close());
+
+    /* Back on the RAM image, which was not written. */
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(7)));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_ram_file_open(path));
+    TEST_ASSERT_EQUAL(data[0], word_read(&m_fs, PAGE_ADDR(7)));
+    TEST_ASSERT_EQUAL(data[1], word_read(&m_fs, PAGE_ADDR(7) + sizeof(uint32_t)));
+
+    /* NOR rules apply to the file too. */
+    word_write(&m_fs, PAGE_ADDR(7), &ones);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_DATA, m_evt.result);
+    TEST_ASSERT_EQUAL(data[0], word_read(&m_fs, PAGE_ADDR(7)));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_erase(&m_fs, PAGE_ADDR(7), 1, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_ram_file_close());
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_ram_file_open(path));
+    TEST_ASSERT_EQUAL(0xFFFFFFFF, word_read(&m_fs, PAGE_ADDR(7)));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_ram_file_close());
+
+    TEST_ASSERT_EQUAL(0, unlink(path));
+}
+
+
+int main(void)
+{
+    host_test_run("strict_nor", strict_nor);
+    host_test_run("and_nor", and_nor);
+    host_test_run("erase_granularity", erase_granularity);
+    host_test_run("wear_and_stats", wear_and_stats);
+    host_test_run("file_persistence", file_persistence);
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Second build of nrf_fstorage_ram with NRF_FSTORAGE_RAM_STRICT_NOR disabled.
+ *
+ * The public symbols are renamed so that it can be linked next to the strict build. It has
+ * its own emulated device.
+ */
+#define NRF_FSTORAGE_RAM_STRICT_NOR         0
+
+#define nrf_fstorage_ram                    nrf_fstorage_ram_and
+#define nrf_fstorage_ram_timing_set         nrf_fstorage_ram_and_timing_set
+#define nrf_fstorage_ram_stats_get          nrf_fstorage_ram_and_stats_get
+#define nrf_fstorage_ram_stats_clear        nrf_fstorage_ram_and_stats_clear
+#define nrf_fstorage_ram_erase_counts_get   nrf_fstorage_ram_and_erase_counts_get
+#define nrf_fstorage_ram_reset              nrf_fstorage_ram_and_reset
+#define nrf_fstorage_ram_file_open          nrf_fstorage_ram_and_file_open
+#define nrf_fstorage_ram_file_close         nrf_fstorage_ram_and_file_close
+
+#include "nrf_fstorage_ram.c"
@@ -0,0 +1,575 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of nrf_fstorage_sd on stubbed SoftDevice flash calls: combining of queued writes,
+ *        completion of combined writes on success, timeout and error, background erase, and
+ *        nrf_atfifo_item_peek().
+ *
+ * The flash is a mapping at FLASH_BASE, so that the 32-bit addresses used by fstorage can be
+ * dereferenced. sd_flash_write() and sd_flash_page_erase() change it at once and log the call.
+ * With the SoftDevice reported as enabled the test sends the flash system events itself.
+ */
+#include <string.h>
+#include <sys/mman.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "nrf_soc.h"
+#include "nrf_sdh.h"
+#include "nrf_atfifo.h"
+#include "nrf_fstorage.h"
+#include "nrf_fstorage_sd.h"
+
+#define FLASH_BASE      (0x10000000UL)
+#define PAGE_SIZE       (4096)
+#define PAGE_CNT        (8)
+#define PAGE_ADDR(i)    (FLASH_BASE + (i) * PAGE_SIZE)
+#define PAGE_NUM(i)     (PAGE_ADDR(i) / PAGE_SIZE)
+#define FLASH_OPS_MAX   (32)
+#define EVTS_MAX        (16)
+
+typedef enum
+{
+    FLASH_OP_WRITE,
+    FLASH_OP_ERASE,
+} flash_op_type_t;
+
+/* SoftDevice flash call. */
+typedef struct
+{
+    flash_op_type_t type;
+    uint32_t        addr;   /**< Destination of a write, page number of an erase. */
+    uint32_t        words;  /**< Length of a write. */
+} flash_op_t;
+
+void nrf_fstorage_sys_evt_handler(uint32_t sys_evt, void * p_context);
+
+static void fs_evt_handler(nrf_fstorage_evt_t * p_evt);
+
+NRF_FSTORAGE_DEF(nrf_fstorage_t m_fs) =
+{
+    .evt_handler = fs_evt_handler,
+    .start_addr  = PAGE_ADDR(0),
+    .end_addr    = PAGE_ADDR(PAGE_CNT) - 1,
+};
+
+/* Never initialized. */
+NRF_FSTORAGE_DEF(nrf_fstorage_t m_fs_other) =
+{
+    .evt_handler = fs_evt_handler,
+    .start_addr  = PAGE_ADDR(0),
+    .end_addr    = PAGE_ADDR(PAGE_CNT) - 1,
+};
+
+static bool               m_sd_enabled;
+static uint32_t           m_flash_rc;                   /**< Returned once by the next flash call, if set. */
+static flash_op_t         m_flash_ops[FLASH_OPS_MAX];
+static uint32_t           m_flash_op_cnt;
+static nrf_fstorage_evt_t m_evts[EVTS_MAX];
+static uint32_t           m_evt_cnt;
+static uint32_t           m_src[8][16];                 /**< Write sources, distinct data per row. */
+
+
+bool nrf_sdh_is_enabled(void)
+{
+    return m_sd_enabled;
+}
+
+
+ret_code_t nrf_sdh_request_continue(void)
+{
+    return NRF_SUCCESS;
+}
+
+
+static uint32_t flash_rc_take(void)
+{
+    uint32_t rc = m_flash_rc;
+
+    m_flash_rc = NRF_SUCCESS;
+    return rc;
+}
+
+
+uint32_t sd_flash_write(uint32_t * p_dst, uint32_t const * p_src, uint32_t size)
+{
+    TEST_ASSERT(m_flash_op_cnt < FLASH_OPS_MAX);
+    m_flash_ops[m_flash_op_cnt++] = (flash_op_t){FLASH_OP_WRITE, (uint32_t)p_dst, size};
+
+    uint32_t rc = flash_rc_take();
+    if (rc != NRF_SUCCESS)
+    {
+        return rc;
+    }
+
+    TEST_ASSERT(((uint32_t)p_dst >= PAGE_ADDR(0)) && ((uint32_t)(p_dst + size) <= PAGE_ADDR(PAGE_CNT)));
+    for (uint32_t i = 0; i < size; i++)
+    {
+        p_dst[i] &= p_src[i];
+    }
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_flash_page_erase(uint32_t page_number)
+{
+    TEST_ASSERT(m_flash_op_cnt < FLASH_OPS_MAX);
+    m_flash_ops[m_flash_op_cnt++] = (flash_op_t){FLASH_OP_ERASE, page_number, 0};
+
+    uint32_t rc = flash_rc_take();
+    if (rc != NRF_SUCCESS)
+    {
+        return rc;
+    }
+
+    TEST_ASSERT((page_number >= PAGE_NUM(0)) && (page_number < PAGE_NUM(PAGE_CNT)));
+    memset((void *)(page_number * PAGE_SIZE), 0xFF, PAGE_SIZE);
+    return NRF_SUCCESS;
+}
+
+
+static void fs_evt_handler(nrf_fstorage_evt_t * p_evt)
+{
+    TEST_ASSERT(m_evt_cnt < EVTS_MAX);
+    m_evts[m_evt_cnt++] = *p_evt;
+}
+
+
+static void setup(bool sd_enabled)
+{
+    m_sd_enabled   = sd_enabled;
+    m_flash_rc     = NRF_SUCCESS;
+    m_flash_op_cnt = 0;
+    m_evt_cnt      = 0;
+
+    memset((void *)FLASH_BASE, 0xFF, PAGE_CNT * PAGE_SIZE);
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_src); i++)
+    {
+        for (uint32_t j = 0; j < ARRAY_SIZE(m_src[0]); j++)
+        {
+            m_src[i][j] = (i << 24) | (j << 16) | 0xA5A5;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_init(&m_fs, &nrf_fstorage_sd, NULL));
+    nrf_fstorage_sd_stats_clear();
+}
+
+
+static void teardown(void)
+{
+    TEST_ASSERT(!nrf_fstorage_is_busy(&m_fs));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_uninit(&m_fs, NULL));
+}
+
+
+/* The SoftDevice reports the end of a flash operation. */
+static void flash_evt(uint32_t sys_evt)
+{
+    nrf_fstorage_sys_evt_handler(sys_evt, NULL);
+}
+
+
+static void flash_op_check(uint32_t idx, flash_op_type_t type, uint32_t addr, uint32_t words)
+{
+    TEST_ASSERT(idx < m_flash_op_cnt);
+    TEST_ASSERT_EQUAL(type, m_flash_ops[idx].type);
+    TEST_ASSERT_EQUAL(addr, m_flash_ops[idx].addr);
+    TEST_ASSERT_EQUAL(words, m_flash_ops[idx].words);
+}
+
+
+static void write_evt_check(uint32_t idx, uint32_t addr, void const * p_src, uint32_t len, ret_code_t result)
+{
+    TEST_ASSERT(idx < m_evt_cnt);
+    TEST_ASSERT_EQUAL(NRF_FSTORAGE_EVT_WRITE_RESULT, m_evts[idx].id);
+    TEST_ASSERT_EQUAL(result, m_evts[idx].result);
+    TEST_ASSERT_EQUAL(addr, m_evts[idx].addr);
+    TEST_ASSERT(p_src == m_evts[idx].p_src);
+    TEST_ASSERT_EQUAL(len, m_evts[idx].len);
+}
+
+
+static void page_dirty(uint32_t page)
+{
+    *(uint32_t *)(PAGE_ADDR(page) + 0x100) = 0x12345678;
+}
+
+
+static bool page_is_blank(uint32_t page)
+{
+    uint32_t const * p_word = (uint32_t const *)PAGE_ADDR(page);
+
+    for (uint32_t i = 0; i < PAGE_SIZE / sizeof(uint32_t); i++)
+    {
+        if (p_word[i] != 0xFFFFFFFF)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/* Writes waiting on the queue which continue the loaded write go out in one flash call, up to
+ * NRF_FSTORAGE_SD_COMBINE_MAX_OPS writes and NRF_FSTORAGE_SD_MAX_WRITE_SIZE bytes. Each write
+ * gets its own event and the queue elements of all of them are freed. */
+static void write_combine(void)
+{
+    static struct
+    {
+        uint32_t offset;
+        uint32_t len;
+    } const writes[] =
+    {
+        {   0, 16 },    // Runs at once, nothing to combine yet.
+        {  16, 16 },    // Combined with the next two, the limit of writes.
+        {  32,  8 },
+        {  40,  8 },
+        {  48,  8 },    // The next write would exceed the size limit.
+        {  56, 60 },    // The next write fits but is not contiguous.
+        { 200,  4 },    // Combined with the next.
+        { 204,  8 },
+    };
+    nrf_fstorage_sd_stats_t stats;
+
+    setup(true);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(writes); i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(1) + writes[i].offset,
+                                                          m_src[i], writes[i].len, NULL));
+    }
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, nrf_fstorage_write(&m_fs, PAGE_ADDR(2), m_src[0], 4, NULL));
+    TEST_ASSERT_EQUAL(1, m_flash_op_cnt);
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    }
+
+    TEST_ASSERT_EQUAL(5, m_flash_op_cnt);
+    flash_op_check(0, FLASH_OP_WRITE, PAGE_ADDR(1) +   0,  4);
+    flash_op_check(1, FLASH_OP_WRITE, PAGE_ADDR(1) +  16,  8);
+    flash_op_check(2, FLASH_OP_WRITE, PAGE_ADDR(1) +  48,  2);
+    flash_op_check(3, FLASH_OP_WRITE, PAGE_ADDR(1) +  56, 15);
+    flash_op_check(4, FLASH_OP_WRITE, PAGE_ADDR(1) + 200,  3);
+
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(writes), m_evt_cnt);
+    for (uint32_t i = 0; i < ARRAY_SIZE(writes); i++)
+    {
+        write_evt_check(i, PAGE_ADDR(1) + writes[i].offset, m_src[i], writes[i].len, NRF_SUCCESS);
+        TEST_ASSERT_EQUAL(0, memcmp((void *)(PAGE_ADDR(1) + writes[i].offset), m_src[i], writes[i].len));
+    }
+
+    nrf_fstorage_sd_stats_get(&stats);
+    TEST_ASSERT_EQUAL(5, stats.timeslots);
+    TEST_ASSERT_EQUAL(3, stats.ops_combined);
+
+    // All queue elements were freed: the queue takes as many writes as before.
+    m_evt_cnt = 0;
+    for (uint32_t i = 0; i < NRF_FSTORAGE_SD_QUEUE_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(2) + 8 * i, m_src[i], 4, NULL));
+    }
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, nrf_fstorage_write(&m_fs, PAGE_ADDR(3), m_src[0], 4, NULL));
+    for (uint32_t i = 0; i < NRF_FSTORAGE_SD_QUEUE_SIZE; i++)
+    {
+        flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    }
+    TEST_ASSERT_EQUAL(NRF_FSTORAGE_SD_QUEUE_SIZE, m_evt_cnt);
+
+    teardown();
+}
+
+
+/* A combined write that times out or fails sends the error to every write it holds. Queued
+ * erases are not combined. A busy SoftDevice delays the write until its own operation ends. */
+static void combine_failure(void)
+{
+    nrf_fstorage_sd_stats_t stats;
+
+    setup(true);
+    page_dirty(3);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(1) +  0, m_src[0], 8, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(1) +  8, m_src[1], 8, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(1) + 16, m_src[2], 8, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_erase(&m_fs, PAGE_ADDR(3), 1, NULL));
+
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    write_evt_check(0, PAGE_ADDR(1), m_src[0], 8, NRF_SUCCESS);
+    flash_op_check(1, FLASH_OP_WRITE, PAGE_ADDR(1) + 8, 4);
+
+    // Retried NRF_FSTORAGE_SD_MAX_RETRIES times, then both writes time out.
+    for (uint32_t i = 0; i < NRF_FSTORAGE_SD_MAX_RETRIES; i++)
+    {
+        flash_evt(NRF_EVT_FLASH_OPERATION_ERROR);
+        TEST_ASSERT_EQUAL(1, m_evt_cnt);
+        flash_op_check(2 + i, FLASH_OP_WRITE, PAGE_ADDR(1) + 8, 4);
+    }
+    flash_evt(NRF_EVT_FLASH_OPERATION_ERROR);
+    TEST_ASSERT_EQUAL(3, m_evt_cnt);
+    write_evt_check(1, PAGE_ADDR(1) +  8, m_src[1], 8, NRF_ERROR_TIMEOUT);
+    write_evt_check(2, PAGE_ADDR(1) + 16, m_src[2], 8, NRF_ERROR_TIMEOUT);
+
+    // The erase was not taken into the combined write.
+    flash_op_check(2 + NRF_FSTORAGE_SD_MAX_RETRIES, FLASH_OP_ERASE, PAGE_NUM(3), 0);
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    TEST_ASSERT_EQUAL(4, m_evt_cnt);
+    TEST_ASSERT_EQUAL(NRF_FSTORAGE_EVT_ERASE_RESULT, m_evts[3].id);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evts[3].result);
+    TEST_ASSERT(page_is_blank(3));
+
+    nrf_fstorage_sd_stats_get(&stats);
+    TEST_ASSERT_EQUAL(NRF_FSTORAGE_SD_MAX_RETRIES, stats.retries);
+    TEST_ASSERT_EQUAL(1, stats.ops_combined);
+
+    // Busy: the write waits for the flash event of the other operation and runs again.
+    m_evt_cnt      = 0;
+    m_flash_op_cnt = 0;
+    m_flash_rc     = NRF_ERROR_BUSY;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(2), m_src[3], 8, NULL));
+    TEST_ASSERT_EQUAL(1, m_flash_op_cnt);
+    TEST_ASSERT(nrf_fstorage_is_busy(&m_fs));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(2) + 8, m_src[4], 8, NULL));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(2) + 16, m_src[5], 8, NULL));
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    TEST_ASSERT_EQUAL(0, m_evt_cnt);
+    flash_op_check(1, FLASH_OP_WRITE, PAGE_ADDR(2), 2);
+
+    // The SoftDevice rejects the combined write: both writes fail and the queue stays usable.
+    m_flash_rc = NRF_ERROR_INVALID_ADDR;
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    flash_op_check(2, FLASH_OP_WRITE, PAGE_ADDR(2) + 8, 4);
+    TEST_ASSERT_EQUAL(3, m_evt_cnt);
+    write_evt_check(0, PAGE_ADDR(2),      m_src[3], 8, NRF_SUCCESS);
+    write_evt_check(1, PAGE_ADDR(2) +  8, m_src[4], 8, NRF_ERROR_INTERNAL);
+    write_evt_check(2, PAGE_ADDR(2) + 16, m_src[5], 8, NRF_ERROR_INTERNAL);
+    TEST_ASSERT(!nrf_fstorage_is_busy(&m_fs));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(2) + 8, m_src[4], 8, NULL));
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    write_evt_check(3, PAGE_ADDR(2) + 8, m_src[4], 8, NRF_SUCCESS);
+
+    teardown();
+}
+
+
+/* Out of range arguments are rejected, including a page count which wraps around when it is
+ * converted to bytes. */
+static void erase_ahead_args(void)
+{
+    setup(true);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_NULL, nrf_fstorage_sd_erase_ahead(NULL, PAGE_ADDR(0), 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, nrf_fstorage_sd_erase_ahead(&m_fs_other, PAGE_ADDR(0), 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(1) + 4, 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR, nrf_fstorage_sd_erase_ahead(&m_fs, FLASH_BASE - PAGE_SIZE, 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(PAGE_CNT), 1));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(6), 3));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_ADDR,
+                      nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(6), (UINT32_MAX / PAGE_SIZE) + 2));
+    TEST_ASSERT_EQUAL(0, m_flash_op_cnt);
+
+    // The last pages of the instance, and a cancel which never started anything.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(6), 2));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(6), 0));
+    TEST_ASSERT_EQUAL(0, m_flash_op_cnt);
+
+    teardown();
+}
+
+
+/* Pages are erased one at a time while the queue is empty. Requested operations go first, and
+ * one which touches the remaining pages cancels them. */
+static void erase_ahead(void)
+{
+    nrf_fstorage_sd_stats_t stats;
+
+    setup(true);
+    page_dirty(2);
+    page_dirty(3);
+    page_dirty(5);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(2), 4));
+    flash_op_check(0, FLASH_OP_ERASE, PAGE_NUM(2), 0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(6), m_src[0], 8, NULL));
+    TEST_ASSERT_EQUAL(1, m_flash_op_cnt);
+
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    flash_op_check(1, FLASH_OP_WRITE, PAGE_ADDR(6), 2);
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    flash_op_check(2, FLASH_OP_ERASE, PAGE_NUM(3), 0);
+
+    // Pages 4 and 5 are still to be erased; a write to page 4 cancels both.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_write(&m_fs, PAGE_ADDR(4), m_src[1], 8, NULL));
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    flash_op_check(3, FLASH_OP_WRITE, PAGE_ADDR(4), 2);
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    TEST_ASSERT_EQUAL(4, m_flash_op_cnt);
+    TEST_ASSERT(!nrf_fstorage_is_busy(&m_fs));
+
+    TEST_ASSERT(page_is_blank(2));
+    TEST_ASSERT(page_is_blank(3));
+    TEST_ASSERT_EQUAL(0, memcmp((void *)PAGE_ADDR(4), m_src[1], 8));
+    TEST_ASSERT(!page_is_blank(5));
+    TEST_ASSERT_EQUAL(2, m_evt_cnt);
+
+    nrf_fstorage_sd_stats_get(&stats);
+    TEST_ASSERT_EQUAL(2, stats.erases_ahead);
+
+    // Blank pages take no flash call.
+    m_flash_op_cnt = 0;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(2), 4));
+    flash_op_check(0, FLASH_OP_ERASE, PAGE_NUM(4), 0);
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    flash_op_check(1, FLASH_OP_ERASE, PAGE_NUM(5), 0);
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    TEST_ASSERT_EQUAL(2, m_flash_op_cnt);
+    TEST_ASSERT(page_is_blank(4));
+    TEST_ASSERT(page_is_blank(5));
+
+    // A requested erase of a page erased in the background completes at once.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_erase(&m_fs, PAGE_ADDR(5), 1, NULL));
+    TEST_ASSERT_EQUAL(2, m_flash_op_cnt);
+    TEST_ASSERT_EQUAL(3, m_evt_cnt);
+    TEST_ASSERT_EQUAL(NRF_FSTORAGE_EVT_ERASE_RESULT, m_evts[2].id);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, m_evts[2].result);
+    TEST_ASSERT_EQUAL(PAGE_ADDR(5), m_evts[2].addr);
+
+    nrf_fstorage_sd_stats_get(&stats);
+    TEST_ASSERT_EQUAL(4, stats.erases_ahead);
+    TEST_ASSERT_EQUAL(1, stats.erases_skipped);
+    TEST_ASSERT_EQUAL(6, stats.timeslots);
+
+    // A new range replaces the old one, and zero pages cancel it.
+    page_dirty(6);
+    page_dirty(7);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(6), 2));
+    flash_op_check(2, FLASH_OP_ERASE, PAGE_NUM(6), 0);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(6), 0));
+    flash_evt(NRF_EVT_FLASH_OPERATION_SUCCESS);
+    TEST_ASSERT_EQUAL(3, m_flash_op_cnt);
+    TEST_ASSERT(!page_is_blank(7));
+    teardown();
+
+    // Without the SoftDevice the flash calls are synchronous and the range is erased at once.
+    setup(false);
+    page_dirty(6);
+    page_dirty(7);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_fstorage_sd_erase_ahead(&m_fs, PAGE_ADDR(6), 2));
+    TEST_ASSERT_EQUAL(2, m_flash_op_cnt);
+    TEST_ASSERT(page_is_blank(6));
+    TEST_ASSERT(page_is_blank(7));
+    teardown();
+}
+
+
+NRF_ATFIFO_DEF(m_peek_fifo, uint32_t, 4);
+
+/* Peek shows the item the next get returns, also while an earlier item is held. */
+static void atfifo_peek(void)
+{
+    nrf_atfifo_item_put_t iput_ctx;
+    nrf_atfifo_item_get_t iget_ctx[2];
+    uint32_t            * p_item;
+    uint32_t            * p_first;
+    uint32_t              next = 0;
+    uint32_t              expected = 0;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, NRF_ATFIFO_INIT(m_peek_fifo));
+    TEST_ASSERT(nrf_atfifo_item_peek(m_peek_fifo) == NULL);
+
+    // Allocated but not put: not visible yet.
+    p_item = nrf_atfifo_item_alloc(m_peek_fifo, &iput_ctx);
+    *p_item = next++;
+    TEST_ASSERT(nrf_atfifo_item_peek(m_peek_fifo) == NULL);
+    TEST_ASSERT(nrf_atfifo_item_put(m_peek_fifo, &iput_ctx));
+
+    // Several rounds, so that the positions wrap around the buffer.
+    for (uint32_t round = 0; round < 10; round++)
+    {
+        p_item = nrf_atfifo_item_alloc(m_peek_fifo, &iput_ctx);
+        *p_item = next++;
+        TEST_ASSERT(nrf_atfifo_item_put(m_peek_fifo, &iput_ctx));
+
+        p_first = nrf_atfifo_item_peek(m_peek_fifo);
+        TEST_ASSERT(p_first != NULL);
+        TEST_ASSERT_EQUAL(expected, *p_first);
+        TEST_ASSERT(nrf_atfifo_item_peek(m_peek_fifo) == p_first);
+        TEST_ASSERT(nrf_atfifo_item_get(m_peek_fifo, &iget_ctx[0]) == p_first);
+
+        p_item = nrf_atfifo_item_peek(m_peek_fifo);
+        TEST_ASSERT(p_item != NULL);
+        TEST_ASSERT_EQUAL(expected + 1, *p_item);
+        TEST_ASSERT(nrf_atfifo_item_get(m_peek_fifo, &iget_ctx[1]) == p_item);
+        TEST_ASSERT(nrf_atfifo_item_peek(m_peek_fifo) == NULL);
+
+        // Freed in reverse order, as fstorage frees combined writes before the loaded one.
+        (void)nrf_atfifo_item_free(m_peek_fifo, &iget_ctx[1]);
+        (void)nrf_atfifo_item_free(m_peek_fifo, &iget_ctx[0]);
+        expected += 2;
+
+        p_item = nrf_atfifo_item_alloc(m_peek_fifo, &iput_ctx);
+        TEST_ASSERT(p_item != NULL);
+        *p_item = next++;
+        TEST_ASSERT(nrf_atfifo_item_put(m_peek_fifo, &iput_ctx));
+        TEST_ASSERT_EQUAL(expected, *(uint32_t *)nrf_atfifo_item_peek(m_peek_fifo));
+    }
+}
+
+
+int main(void)
+{
+    void * p_flash = mmap((void *)FLASH_BASE,
+                          PAGE_CNT * PAGE_SIZE,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                          -1,
+                          0);
+    TEST_ASSERT(p_flash == (void *)FLASH_BASE);
+
+    host_test_run("write_combine", write_combine);
+    host_test_run("combine_failure", combine_failure);
+    host_test_run("erase_ahead_args", erase_ahead_args);
+    host_test_run("erase_ahead", erase_ahead);
+    host_test_run("atfifo_peek", atfifo_peek);
+    return 0;
+}
@@ -0,0 +1,549 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the nrf_sim SPIM, TWIM, QSPI, NVMC and TIMER models: one transfer or event
+ *        sequence per model, driven through the unmodified nrfx drivers.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_sim.h"
+#include "nrf_sim_peripherals.h"
+#include "nrfx_spim.h"
+#include "nrfx_twim.h"
+#include "nrfx_qspi.h"
+#include "nrfx_nvmc.h"
+#include "nrfx_timer.h"
+
+#define SPIM_LENGTH         16          /**< Number of bytes in each direction of the SPIM transfer. */
+#define TWIM_DEV_ADDR       0x50        /**< Address of the simulated TWI memory. */
+#define TWIM_MISSING_ADDR   0x51        /**< Address without a device. */
+#define TWIM_MEM_SIZE       32
+#define TWIM_READ_OFFSET    4
+#define TWIM_READ_LENGTH    8
+#define QSPI_FLASH_SIZE     0x10000
+#define QSPI_SECTOR_ADDR    0x1000
+#define QSPI_LENGTH         256         /**< Number of bytes programmed and read back, one page. */
+#define QSPI_JEDEC_ID       0x1728C2    /**< RDID response, bytes in the order they are shifted out. */
+#define QSPI_ERASE_4K_US    45000
+#define QSPI_PROGRAM_US     800
+#define NVMC_PAGE_SIZE      4096
+#define NVMC_PAGE_COUNT     4
+#define NVMC_WORD_WRITE_US  41
+#define NVMC_PAGE_ERASE_US  85000
+#define TIMER_PERIOD_US     1000        /**< Period of the TIMER compare events. */
+#define TIMER_PERIODS       10
+#define TIMER_DELAY_US      10000       /**< Compare delay that falls inside a flash page erase. */
+#define COUNTER_CC          3           /**< Compare value of the counter mode TIMER. */
+
+static nrfx_spim_t const  m_spim    = NRFX_SPIM_INSTANCE(2);
+static nrfx_twim_t const  m_twim    = NRFX_TWIM_INSTANCE(0);
+static nrfx_timer_t const m_timer   = NRFX_TIMER_INSTANCE(1);
+static nrfx_timer_t const m_counter = NRFX_TIMER_INSTANCE(2);
+
+static uint8_t            m_spim_tx[SPIM_LENGTH];
+static uint8_t            m_spim_rx[SPIM_LENGTH];
+static uint8_t            m_spim_mosi[SPIM_LENGTH];     /**< Bytes seen by the SPI slave. */
+
+static uint8_t            m_twim_mem[TWIM_MEM_SIZE];    /**< Memory of the TWI slave. */
+static uint8_t            m_twim_reg;                   /**< Offset written to the TWI slave. */
+static bool               m_twim_write_nack;            /**< The TWI slave NACKs data writes. */
+
+static uint8_t            m_qspi_flash[QSPI_FLASH_SIZE];
+static uint32_t           m_qspi_tx[QSPI_LENGTH / sizeof(uint32_t)];
+static uint32_t           m_qspi_rx[QSPI_LENGTH / sizeof(uint32_t)];
+
+/* Flash addresses are host addresses, so the image is aligned to the page size. */
+__ALIGN(NVMC_PAGE_SIZE) static uint32_t m_nvmc_flash[NVMC_PAGE_COUNT * NVMC_PAGE_SIZE / sizeof(uint32_t)];
+
+static uint32_t           m_evt_count;                  /**< Number of driver events since the last check. */
+static uint32_t           m_evt_type;                   /**< Type of the last driver event. */
+static nrf_sim_time_t     m_evt_time;                   /**< Time of the last driver event. */
+static nrf_sim_time_t     m_timer_times[TIMER_PERIODS + 1];
+static bool               m_done;
+
+
+static void evt_record(uint32_t type)
+{
+    m_evt_count++;
+    m_evt_type = type;
+    m_evt_time = nrf_sim_time_get();
+    m_done     = true;
+}
+
+
+static bool flag_clear(void * p_context)
+{
+    return !*(bool *)p_context;
+}
+
+
+/**@brief Function for waiting for the next driver event. */
+static void evt_wait(void)
+{
+    TEST_ASSERT(nrf_sim_run_while(flag_clear, &m_done, NRF_SIM_TIME_MS(500)));
+    m_done = false;
+}
+
+
+static void spim_slave(void          * p_context,
+                       uint8_t const * p_tx,
+                       size_t          tx_length,
+                       uint8_t       * p_rx,
+                       size_t          rx_length)
+{
+    TEST_ASSERT_EQUAL(SPIM_LENGTH, tx_length);
+    TEST_ASSERT_EQUAL(SPIM_LENGTH, rx_length);
+    memcpy(m_spim_mosi, p_tx, tx_length);
+    for (size_t i = 0; i < rx_length; i++)
+    {
+        p_rx[i] = (uint8_t)~p_tx[i];
+    }
+}
+
+
+static void spim_handler(nrfx_spim_evt_t const * p_event, void * p_context)
+{
+    TEST_ASSERT(p_event->xfer_desc.p_rx_buffer == m_spim_rx);
+    evt_record(p_event->type);
+}
+
+
+/* nrfx_spim_uninit() busy-waits on STOPPED, which the simulation cannot serve, so the
+ * instance is initialized once. */
+static void spim_transfer(void)
+{
+    nrfx_spim_config_t    config = NRFX_SPIM_DEFAULT_CONFIG;
+    nrfx_spim_xfer_desc_t xfer   = NRFX_SPIM_XFER_TRX(m_spim_tx, SPIM_LENGTH, m_spim_rx, SPIM_LENGTH);
+
+    nrf_sim_init();
+    nrf_sim_spim_device_set(2, spim_slave, NULL);
+    m_evt_count = 0;
+
+    config.sck_pin   = 3;
+    config.mosi_pin  = 4;
+    config.miso_pin  = 5;
+    config.frequency = NRF_SPIM_FREQ_8M;
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_spim_init(&m_spim, &config, spim_handler, NULL));
+
+    for (uint32_t i = 0; i < SPIM_LENGTH; i++)
+    {
+        m_spim_tx[i] = (uint8_t)(0x3C + i * 5);
+    }
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_spim_xfer(&m_spim, &xfer, 0));
+    evt_wait();
+
+    TEST_ASSERT_EQUAL(1, m_evt_count);
+    TEST_ASSERT_EQUAL(NRFX_SPIM_EVENT_DONE, m_evt_type);
+    TEST_ASSERT(memcmp(m_spim_mosi, m_spim_tx, SPIM_LENGTH) == 0);
+    for (uint32_t i = 0; i < SPIM_LENGTH; i++)
+    {
+        TEST_ASSERT_EQUAL((uint8_t)~m_spim_tx[i], m_spim_rx[i]);
+    }
+
+    /* 8 bits per byte at 8 Mbps; both directions are shifted at the same time. */
+    TEST_ASSERT_EQUAL(SPIM_LENGTH * 8 * 1000000000ULL / 8000000, m_evt_time);
+
+    nrf_sim_spim_device_set(2, NULL, NULL);
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+/* The TWI slave is a memory: a write sets the offset, followed data is stored, a read returns
+ * the memory from the offset. */
+static bool twim_slave_write(void * p_context, uint8_t const * p_data, size_t length)
+{
+    if (m_twim_write_nack && (length > 1))
+    {
+        return false;
+    }
+    m_twim_reg = p_data[0];
+    TEST_ASSERT(m_twim_reg + length - 1 <= TWIM_MEM_SIZE);
+    memcpy(&m_twim_mem[m_twim_reg], &p_data[1], length - 1);
+    return true;
+}
+
+
+static bool twim_slave_read(void * p_context, uint8_t * p_data, size_t length)
+{
+    TEST_ASSERT(m_twim_reg + length <= TWIM_MEM_SIZE);
+    memcpy(p_data, &m_twim_mem[m_twim_reg], length);
+    return true;
+}
+
+
+static nrfx_twim_evt_type_t twim_xfer(nrfx_twim_xfer_desc_t const * p_xfer)
+{
+    m_evt_count = 0;
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_twim_xfer(&m_twim, p_xfer, 0));
+    evt_wait();
+    TEST_ASSERT_EQUAL(1, m_evt_count);
+    return (nrfx_twim_evt_type_t)m_evt_type;
+}
+
+
+static void twim_handler(nrfx_twim_evt_t const * p_event, void * p_context)
+{
+    evt_record(p_event->type);
+}
+
+
+/* nrfx_twim_uninit() is not used for the same reason as nrfx_spim_uninit(). */
+static void twim_transfer(void)
+{
+    static nrf_sim_twim_device_t const device =
+    {
+        .write = twim_slave_write,
+        .read  = twim_slave_read,
+    };
+    uint8_t reg = TWIM_READ_OFFSET;
+    uint8_t rx[TWIM_READ_LENGTH];
+    uint8_t tx[3] = {TWIM_MEM_SIZE - 2, 0xA1, 0xA2};
+
+    nrfx_twim_config_t config = NRFX_TWIM_DEFAULT_CONFIG;
+
+    nrf_sim_init();
+    TEST_ASSERT(nrf_sim_twim_device_set(0, TWIM_DEV_ADDR, &device));
+    config.scl = 27;
+    config.sda = 26;
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_twim_init(&m_twim, &config, twim_handler, NULL));
+    nrfx_twim_enable(&m_twim);
+
+    for (uint32_t i = 0; i < TWIM_MEM_SIZE; i++)
+    {
+        m_twim_mem[i] = (uint8_t)(0x80 + i);
+    }
+    m_twim_write_nack = false;
+
+    /* Write the offset, then read with a repeated start. */
+    nrfx_twim_xfer_desc_t read = NRFX_TWIM_XFER_DESC_TXRX(TWIM_DEV_ADDR, &reg, 1, rx, sizeof(rx));
+
+    TEST_ASSERT_EQUAL(NRFX_TWIM_EVT_DONE, twim_xfer(&read));
+    TEST_ASSERT(memcmp(rx, &m_twim_mem[TWIM_READ_OFFSET], sizeof(rx)) == 0);
+
+    /* 9 bits per byte; the address is sent before the write and again before the read.
+     * FREQUENCY holds the bit rate as a fraction of 16 MHz scaled by 2^32. */
+    uint64_t rate = ((uint64_t)NRF_TWIM_FREQ_400K * 16000000ULL) >> 32;
+    TEST_ASSERT_EQUAL((9ULL * (1 + 1) * 1000000000ULL + rate - 1) / rate +
+                      (9ULL * (1 + sizeof(rx)) * 1000000000ULL + rate - 1) / rate,
+                      m_evt_time);
+
+    nrfx_twim_xfer_desc_t write = NRFX_TWIM_XFER_DESC_TX(TWIM_DEV_ADDR, tx, sizeof(tx));
+
+    TEST_ASSERT_EQUAL(NRFX_TWIM_EVT_DONE, twim_xfer(&write));
+    TEST_ASSERT_EQUAL(0xA1, m_twim_mem[TWIM_MEM_SIZE - 2]);
+    TEST_ASSERT_EQUAL(0xA2, m_twim_mem[TWIM_MEM_SIZE - 1]);
+
+    /* Errors are reported once the bus is stopped, and the bus is usable afterwards. */
+    m_twim_write_nack = true;
+    TEST_ASSERT_EQUAL(NRFX_TWIM_EVT_DATA_NACK, twim_xfer(&write));
+    m_twim_write_nack = false;
+
+    nrfx_twim_xfer_desc_t missing = NRFX_TWIM_XFER_DESC_RX(TWIM_MISSING_ADDR, rx, sizeof(rx));
+
+    TEST_ASSERT_EQUAL(NRFX_TWIM_EVT_ADDRESS_NACK, twim_xfer(&missing));
+    TEST_ASSERT_EQUAL(NRFX_TWIM_EVT_DONE, twim_xfer(&read));
+
+    TEST_ASSERT(nrf_sim_twim_device_set(0, TWIM_DEV_ADDR, NULL));
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static void qspi_handler(nrfx_qspi_evt_t event, void * p_context)
+{
+    evt_record(event);
+}
+
+
+/**@brief Function for running a QSPI operation and returning its duration. */
+static nrf_sim_time_t qspi_wait(nrfx_err_t err_code)
+{
+    nrf_sim_time_t start = nrf_sim_time_get();
+
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, err_code);
+    m_evt_count = 0;
+    evt_wait();
+    TEST_ASSERT_EQUAL(1, m_evt_count);
+    TEST_ASSERT_EQUAL(NRFX_QSPI_EVENT_DONE, m_evt_type);
+    return m_evt_time - start;
+}
+
+
+static void qspi_transfer(void)
+{
+    static nrf_sim_qspi_flash_t const flash =
+    {
+        .p_memory        = m_qspi_flash,
+        .size            = QSPI_FLASH_SIZE,
+        .page_program_us = QSPI_PROGRAM_US,
+        .erase_4k_us     = QSPI_ERASE_4K_US,
+        .erase_64k_us    = 4 * QSPI_ERASE_4K_US,
+        .erase_all_us    = 16 * QSPI_ERASE_4K_US,
+        .jedec_id        = QSPI_JEDEC_ID,
+    };
+    nrfx_qspi_config_t config =
+    {
+        .pins =
+        {
+            .sck_pin = 19,
+            .csn_pin = 17,
+            .io0_pin = 20,
+            .io1_pin = 21,
+            .io2_pin = 22,
+            .io3_pin = 23,
+        },
+        .prot_if =
+        {
+            .readoc   = NRF_QSPI_READOC_READ4IO,
+            .writeoc  = NRF_QSPI_WRITEOC_PP4IO,
+            .addrmode = NRF_QSPI_ADDRMODE_24BIT,
+        },
+        .phy_if =
+        {
+            .spi_mode = NRF_QSPI_MODE_0,
+            .sck_freq = NRF_QSPI_FREQ_32MDIV2,
+        },
+        .irq_priority = 6,
+    };
+    nrf_qspi_cinstr_conf_t const rdid = NRFX_QSPI_DEFAULT_CINSTR(0x9F, NRF_QSPI_CINSTR_LEN_4B);
+    uint8_t                      id[3];
+
+    nrf_sim_init();
+    memset(m_qspi_flash, 0x00, sizeof(m_qspi_flash));
+    nrf_sim_qspi_flash_set(&flash);
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_qspi_init(&config, qspi_handler, NULL));
+
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_qspi_cinstr_xfer(&rdid, NULL, id));
+    TEST_ASSERT_EQUAL(QSPI_JEDEC_ID & 0xFF, id[0]);
+    TEST_ASSERT_EQUAL((QSPI_JEDEC_ID >> 8) & 0xFF, id[1]);
+    TEST_ASSERT_EQUAL(QSPI_JEDEC_ID >> 16, id[2]);
+
+    /* Only the addressed sector is erased. */
+    TEST_ASSERT(qspi_wait(nrfx_qspi_erase(NRF_QSPI_ERASE_LEN_4KB, QSPI_SECTOR_ADDR + 0x100)) >=
+                NRF_SIM_TIME_US(QSPI_ERASE_4K_US));
+    TEST_ASSERT_EQUAL(0x00, m_qspi_flash[QSPI_SECTOR_ADDR - 1]);
+    TEST_ASSERT_EQUAL(0xFF, m_qspi_flash[QSPI_SECTOR_ADDR]);
+    TEST_ASSERT_EQUAL(0xFF, m_qspi_flash[QSPI_SECTOR_ADDR + 4095]);
+    TEST_ASSERT_EQUAL(0x00, m_qspi_flash[QSPI_SECTOR_ADDR + 4096]);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_qspi_tx); i++)
+    {
+        m_qspi_tx[i] = 0xF0F0F0F0 ^ (i * 0x01010101);
+    }
+    TEST_ASSERT(qspi_wait(nrfx_qspi_write(m_qspi_tx, QSPI_LENGTH, QSPI_SECTOR_ADDR)) >=
+                NRF_SIM_TIME_US(QSPI_PROGRAM_US));
+    memset(m_qspi_rx, 0, sizeof(m_qspi_rx));
+    (void)qspi_wait(nrfx_qspi_read(m_qspi_rx, QSPI_LENGTH, QSPI_SECTOR_ADDR));
+    TEST_ASSERT(memcmp(m_qspi_rx, m_qspi_tx, QSPI_LENGTH) == 0);
+
+    /* Programming again only clears bits. */
+    uint32_t const pattern = 0x0F0F0F0F;
+
+    (void)qspi_wait(nrfx_qspi_write(&pattern, sizeof(pattern), QSPI_SECTOR_ADDR));
+    (void)qspi_wait(nrfx_qspi_read(m_qspi_rx, sizeof(uint32_t), QSPI_SECTOR_ADDR));
+    TEST_ASSERT_EQUAL(m_qspi_tx[0] & pattern, m_qspi_rx[0]);
+
+    nrfx_qspi_uninit();
+    nrf_sim_qspi_flash_set(NULL);
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static void timer_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    TEST_ASSERT_EQUAL(NRF_TIMER_EVENT_COMPARE0, event_type);
+    TEST_ASSERT(m_evt_count < ARRAY_SIZE(m_timer_times));
+    m_timer_times[m_evt_count] = nrf_sim_time_get();
+    evt_record(event_type);
+}
+
+
+/**@brief Function for capturing the counter. Tasks take effect when the simulation settles. */
+static uint32_t timer_capture(nrfx_timer_t const * p_timer)
+{
+    nrfx_timer_capture(p_timer, NRF_TIMER_CC_CHANNEL1);
+    nrf_sim_settle();
+    return nrfx_timer_capture_get(p_timer, NRF_TIMER_CC_CHANNEL1);
+}
+
+
+static void counter_handler(nrf_timer_event_t event_type, void * p_context)
+{
+    TEST_ASSERT_EQUAL(NRF_TIMER_EVENT_COMPARE0, event_type);
+    evt_record(event_type);
+}
+
+
+/**@brief Function for initializing TIMER1 at 1 MHz. */
+static void timer_init(void)
+{
+    nrfx_timer_config_t config = NRFX_TIMER_DEFAULT_CONFIG;
+
+    config.frequency = NRF_TIMER_FREQ_1MHz;
+    config.mode      = NRF_TIMER_MODE_TIMER;
+    config.bit_width = NRF_TIMER_BIT_WIDTH_32;
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_timer_init(&m_timer, &config, timer_handler));
+}
+
+
+static void timer_compare(void)
+{
+    nrf_sim_init();
+    m_evt_count = 0;
+    timer_init();
+
+    /* Periodic compare through the COMPARE0_CLEAR shortcut. */
+    nrfx_timer_extended_compare(&m_timer, NRF_TIMER_CC_CHANNEL0, TIMER_PERIOD_US,
+                                NRF_TIMER_SHORT_COMPARE0_CLEAR_MASK, true);
+    nrfx_timer_enable(&m_timer);
+    nrf_sim_run_for(NRF_SIM_TIME_US(TIMER_PERIODS * TIMER_PERIOD_US + TIMER_PERIOD_US / 2));
+
+    TEST_ASSERT_EQUAL(TIMER_PERIODS, m_evt_count);
+    for (uint32_t i = 0; i < TIMER_PERIODS; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SIM_TIME_US((i + 1) * TIMER_PERIOD_US), m_timer_times[i]);
+    }
+    TEST_ASSERT_EQUAL(TIMER_PERIOD_US / 2, timer_capture(&m_timer));
+
+    /* Stopped, the timer neither counts nor compares. */
+    nrfx_timer_disable(&m_timer);
+    nrf_sim_run_for(NRF_SIM_TIME_US(2 * TIMER_PERIOD_US));
+    TEST_ASSERT_EQUAL(TIMER_PERIODS, m_evt_count);
+    nrfx_timer_uninit(&m_timer);
+
+    /* In counter mode, only COUNT tasks advance the counter. */
+    nrfx_timer_config_t config = NRFX_TIMER_DEFAULT_CONFIG;
+
+    config.mode = NRF_TIMER_MODE_COUNTER;
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_timer_init(&m_counter, &config, counter_handler));
+    nrfx_timer_compare(&m_counter, NRF_TIMER_CC_CHANNEL0, COUNTER_CC, true);
+    nrfx_timer_enable(&m_counter);
+    m_evt_count = 0;
+    for (uint32_t i = 0; i < COUNTER_CC; i++)
+    {
+        nrf_sim_run_for(NRF_SIM_TIME_MS(1));
+        TEST_ASSERT_EQUAL(0, m_evt_count);
+        nrfx_timer_increment(&m_counter);
+    }
+    nrf_sim_settle();
+    TEST_ASSERT_EQUAL(1, m_evt_count);
+    TEST_ASSERT_EQUAL(COUNTER_CC, timer_capture(&m_counter));
+    nrfx_timer_uninit(&m_counter);
+
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static void nvmc_flash(void)
+{
+    static nrf_sim_nvmc_flash_t const flash =
+    {
+        .p_memory      = (uint8_t *)m_nvmc_flash,
+        .size          = sizeof(m_nvmc_flash),
+        .page_size     = NVMC_PAGE_SIZE,
+        .word_write_us = NVMC_WORD_WRITE_US,
+        .page_erase_us = NVMC_PAGE_ERASE_US,
+    };
+    uint32_t const       page     = (uint32_t)(uintptr_t)&m_nvmc_flash[NVMC_PAGE_SIZE / sizeof(uint32_t)];
+    uint32_t const       words[2] = {0x12345678, 0xFFFF0000};
+    nrf_sim_nvmc_stats_t stats;
+
+    nrf_sim_init();
+    memset(m_nvmc_flash, 0x00, sizeof(m_nvmc_flash));
+    nrf_sim_nvmc_flash_set(&flash);
+    TEST_ASSERT_EQUAL(NVMC_PAGE_COUNT, nrfx_nvmc_flash_page_count_get());
+    TEST_ASSERT_EQUAL(NRFX_ERROR_INVALID_ADDR, nrfx_nvmc_page_erase(page + sizeof(uint32_t)));
+
+    /* A compare due during the erase is taken once the CPU runs again. */
+    m_evt_count = 0;
+    timer_init();
+    nrfx_timer_extended_compare(&m_timer, NRF_TIMER_CC_CHANNEL0, TIMER_DELAY_US,
+                                NRF_TIMER_SHORT_COMPARE0_STOP_MASK, true);
+    nrfx_timer_enable(&m_timer);
+
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_nvmc_page_erase(page));
+    TEST_ASSERT_EQUAL(NRF_SIM_TIME_US(NVMC_PAGE_ERASE_US), nrf_sim_time_get());
+    TEST_ASSERT_EQUAL(1, m_evt_count);
+    TEST_ASSERT_EQUAL(NRF_SIM_TIME_US(NVMC_PAGE_ERASE_US), m_timer_times[0]);
+    nrfx_timer_uninit(&m_timer);
+
+    TEST_ASSERT_EQUAL(0, m_nvmc_flash[NVMC_PAGE_SIZE / sizeof(uint32_t) - 1]);
+    TEST_ASSERT_EQUAL(UINT32_MAX, m_nvmc_flash[NVMC_PAGE_SIZE / sizeof(uint32_t)]);
+    TEST_ASSERT_EQUAL(UINT32_MAX, m_nvmc_flash[2 * NVMC_PAGE_SIZE / sizeof(uint32_t) - 1]);
+    TEST_ASSERT_EQUAL(0, m_nvmc_flash[2 * NVMC_PAGE_SIZE / sizeof(uint32_t)]);
+
+    nrfx_nvmc_words_write(page, words, ARRAY_SIZE(words));
+    TEST_ASSERT_EQUAL(NRF_SIM_TIME_US(NVMC_PAGE_ERASE_US + 2 * NVMC_WORD_WRITE_US), nrf_sim_time_get());
+    TEST_ASSERT(memcmp((void *)(uintptr_t)page, words, sizeof(words)) == 0);
+
+    /* Programming cannot set bits; the violation is counted. */
+    TEST_ASSERT(!nrfx_nvmc_word_writable_check(page + sizeof(uint32_t), 0x0000FFFF));
+    nrfx_nvmc_word_write(page + sizeof(uint32_t), 0x0000FFFF);
+    TEST_ASSERT_EQUAL(0, m_nvmc_flash[NVMC_PAGE_SIZE / sizeof(uint32_t) + 1]);
+    nrfx_nvmc_byte_write(page + 2 * sizeof(uint32_t) + 1, 0x5A);
+    TEST_ASSERT_EQUAL(0xFFFF5AFF, m_nvmc_flash[NVMC_PAGE_SIZE / sizeof(uint32_t) + 2]);
+
+    nrf_sim_nvmc_stats_get(&stats);
+    TEST_ASSERT_EQUAL(1, stats.pages_erased);
+    TEST_ASSERT_EQUAL(4, stats.words_written);
+    TEST_ASSERT_EQUAL(1, stats.nor_violations);
+
+    nrf_sim_nvmc_flash_set(NULL);
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static int test_main(void)
+{
+    host_test_run("spim_transfer", spim_transfer);
+    host_test_run("twim_transfer", twim_transfer);
+    host_test_run("qspi_transfer", qspi_transfer);
+    host_test_run("timer_compare", timer_compare);
+    host_test_run("nvmc_flash", nvmc_flash);
+    return 0;
+}
+
+
+int main(void)
+{
+    int result = nrf_sim_main_run(test_main);
+
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+    return result;
+}
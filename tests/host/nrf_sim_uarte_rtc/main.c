@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Smoke test of the nrfx peripheral simulation: nrfx_uarte and nrfx_rtc running
+ *        unmodified on the simulated UARTE and RTC models.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_sim.h"
+#include "nrf_sim_peripherals.h"
+#include "nrfx_uarte.h"
+#include "nrfx_rtc.h"
+
+#define ECHO_LENGTH     32      /**< Number of bytes sent through the UARTE round trip. */
+#define RTC_CC_TICKS    328     /**< RTC compare value, about 10 ms at 32768 Hz. */
+
+static nrfx_uarte_t const m_uarte_host = NRFX_UARTE_INSTANCE(0);
+static nrfx_uarte_t const m_uarte_echo = NRFX_UARTE_INSTANCE(1);
+static nrfx_rtc_t const   m_rtc        = NRFX_RTC_INSTANCE(0);
+
+static uint8_t m_tx_buf[ECHO_LENGTH];
+static uint8_t m_echo_buf[ECHO_LENGTH];
+static uint8_t m_rx_buf[ECHO_LENGTH];
+
+static bool           m_rx_done;
+static nrf_sim_time_t m_rx_done_time;
+static bool           m_compare;
+static nrf_sim_time_t m_compare_time;
+
+
+static void uarte_host_handler(nrfx_uarte_event_t const * p_event, void * p_context)
+{
+    if (p_event->type == NRFX_UARTE_EVT_RX_DONE)
+    {
+        TEST_ASSERT_EQUAL(ECHO_LENGTH, p_event->data.rxtx.bytes);
+        m_rx_done      = true;
+        m_rx_done_time = nrf_sim_time_get();
+    }
+}
+
+
+/* The far end sends every received buffer back. */
+static void uarte_echo_handler(nrfx_uarte_event_t const * p_event, void * p_context)
+{
+    if (p_event->type == NRFX_UARTE_EVT_RX_DONE)
+    {
+        TEST_ASSERT_EQUAL(NRFX_SUCCESS,
+                          nrfx_uarte_tx(&m_uarte_echo, p_event->data.rxtx.p_data, p_event->data.rxtx.bytes));
+    }
+}
+
+
+static void rtc_handler(nrfx_rtc_int_type_t int_type)
+{
+    if (int_type == NRFX_RTC_INT_COMPARE0)
+    {
+        m_compare      = true;
+        m_compare_time = nrf_sim_time_get();
+    }
+}
+
+
+static bool flag_clear(void * p_context)
+{
+    return !*(bool *)p_context;
+}
+
+
+/* nrfx_uarte_uninit() busy-waits on TXSTOPPED, which the simulation cannot serve, so the
+ * instances are initialized once. */
+static void uarte_round_trip(void)
+{
+    nrfx_uarte_config_t config = NRFX_UARTE_DEFAULT_CONFIG;
+
+    nrf_sim_init();
+    nrf_sim_uarte_connect(0, 1);
+    nrf_sim_uarte_connect(1, 0);
+
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_uarte_init(&m_uarte_host, &config, uarte_host_handler));
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_uarte_init(&m_uarte_echo, &config, uarte_echo_handler));
+
+    for (uint32_t i = 0; i < ECHO_LENGTH; i++)
+    {
+        m_tx_buf[i] = (uint8_t)(0xA5 ^ (i * 7));
+    }
+    memset(m_rx_buf, 0, sizeof(m_rx_buf));
+    m_rx_done = false;
+
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_uarte_rx(&m_uarte_echo, m_echo_buf, sizeof(m_echo_buf)));
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_uarte_rx(&m_uarte_host, m_rx_buf, sizeof(m_rx_buf)));
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_uarte_tx(&m_uarte_host, m_tx_buf, sizeof(m_tx_buf)));
+
+    TEST_ASSERT(nrf_sim_run_while(flag_clear, &m_rx_done, NRF_SIM_TIME_MS(100)));
+    TEST_ASSERT(memcmp(m_tx_buf, m_rx_buf, ECHO_LENGTH) == 0);
+
+    /* 10 bits per byte, once in each direction. The echo is started from the interrupt
+     * handler without delay. BAUDRATE holds the rate as a fraction of 16 MHz scaled by 2^32. */
+    uint64_t       baud     = ((uint64_t)NRF_UARTE_BAUDRATE_115200 * 16000000ULL) >> 32;
+    nrf_sim_time_t expected = 2 * ECHO_LENGTH * (10 * 1000000000ULL / baud);
+    TEST_ASSERT(m_rx_done_time >= expected - NRF_SIM_TIME_US(10));
+    TEST_ASSERT(m_rx_done_time <= expected + NRF_SIM_TIME_US(10));
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static void rtc_compare(void)
+{
+    nrfx_rtc_config_t config = NRFX_RTC_DEFAULT_CONFIG;
+
+    nrf_sim_init();
+    m_compare = false;
+
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_rtc_init(&m_rtc, &config, rtc_handler));
+    TEST_ASSERT_EQUAL(NRFX_SUCCESS, nrfx_rtc_cc_set(&m_rtc, 0, RTC_CC_TICKS, true));
+    nrfx_rtc_enable(&m_rtc);
+
+    TEST_ASSERT(nrf_sim_run_while(flag_clear, &m_compare, NRF_SIM_TIME_MS(100)));
+    TEST_ASSERT_EQUAL(RTC_CC_TICKS, nrfx_rtc_counter_get(&m_rtc));
+
+    nrf_sim_time_t expected = RTC_CC_TICKS * 1000000000ULL / 32768;
+    TEST_ASSERT(m_compare_time >= expected - NRF_SIM_TIME_US(31));
+    TEST_ASSERT(m_compare_time <= expected + NRF_SIM_TIME_US(31));
+
+    nrfx_rtc_uninit(&m_rtc);
+}
+
+
+/* An interrupt handler that keeps its interrupt pending never lets the system settle. */
+void SWI0_EGU0_IRQHandler(void)
+{
+    NVIC_SetPendingIRQ(SWI0_EGU0_IRQn);
+}
+
+
+static void settle_livelock(void)
+{
+    nrf_sim_init();
+
+    NVIC_SetPriority(SWI0_EGU0_IRQn, 7);
+    NVIC_EnableIRQ(SWI0_EGU0_IRQn);
+    NVIC_SetPendingIRQ(SWI0_EGU0_IRQn);
+
+    nrf_sim_run_for(NRF_SIM_TIME_MS(5));
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_LIVELOCK, nrf_sim_error_get());
+    TEST_ASSERT_EQUAL(0, nrf_sim_time_get());
+    TEST_ASSERT(!nrf_sim_wfe());
+
+    nrf_sim_init();
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+}
+
+
+static int test_main(void)
+{
+    host_test_run("uarte_round_trip", uarte_round_trip);
+    host_test_run("rtc_compare", rtc_compare);
+    host_test_run("settle_livelock", settle_livelock);
+    return 0;
+}
+
+
+int main(void)
+{
+    int result = nrf_sim_main_run(test_main);
+
+    TEST_ASSERT_EQUAL(NRF_SIM_ERROR_NONE, nrf_sim_error_get());
+    return result;
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host replacement of the IoT error code header, which is not part of this tree.
+ *
+ * Only the codes used by the nrf_tls interface are defined.
+ */
+#ifndef IOT_ERRORS_H__
+#define IOT_ERRORS_H__
+
+#include "sdk_errors.h"
+
+#define IOT_TLS_ERR_BASE                (NRF_ERROR_IOT_ERR_BASE_START + 0x0800)
+
+#define NRF_TLS_NO_FREE_INSTANCE        (IOT_TLS_ERR_BASE + 0x0001)
+#define NRF_TLS_INVALID_CA_CERTIFICATE  (IOT_TLS_ERR_BASE + 0x0002)
+#define NRF_TLS_OWN_CERT_SETUP_FAILED   (IOT_TLS_ERR_BASE + 0x0003)
+#define NRF_TLS_CONFIGURATION_FAILED    (IOT_TLS_ERR_BASE + 0x0004)
+#define NRF_TLS_CONTEXT_SETUP_FAILED    (IOT_TLS_ERR_BASE + 0x0005)
+#define NRF_TLS_HANDSHAKE_IN_PROGRESS   (IOT_TLS_ERR_BASE + 0x0006)
+
+#endif // IOT_ERRORS_H__
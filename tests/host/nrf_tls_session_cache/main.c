@@ -0,0 +1,537 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Loopback test of the nrf_tls session cache.
+ *
+ * A client and a server nrf_tls instance are connected through in-memory pipes and complete
+ * PSK handshakes. A handshake resumed the cached session if the client ends up with the master
+ * secret of the previous connection; a full handshake always derives a new one. The server
+ * issues session tickets only in the ticket cases, so that resumption by session ID and by
+ * ticket are tested separately.
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "mbedtls/ssl_ticket.h"
+
+/* The instances and the session cache are static, so the interface is compiled into the test. */
+#include "../../../external/nrf_tls/mbedtls/tls_interface.c"
+
+#define SERVER_TRANSPORT_ID     1               /**< Transport of the server instance. */
+#define CLIENT_TRANSPORT_ID     2               /**< Transport of the client instance. */
+#define PIPE_SIZE               4096            /**< Bytes a pipe holds before they are delivered. */
+#define MEM_BLOCKS_MAX          512             /**< Number of blocks nrf_malloc() can have outstanding. */
+#define KEY_A                   0x0A0A0001      /**< Session cache key of the first server. */
+#define BENCH_HANDSHAKES        200             /**< Number of handshakes per benchmark run. */
+
+/**@brief Data written by one instance and not yet delivered to the other. */
+typedef struct
+{
+    uint8_t  data[PIPE_SIZE];
+    uint32_t len;
+} pipe_t;
+
+/**@brief Client and server instance pair. */
+typedef struct
+{
+    nrf_tls_instance_t server;
+    nrf_tls_instance_t client;
+    uint8_t            master[48];          /**< Master secret the client ended up with. */
+} link_t;
+
+static uint8_t const m_psk[]          = "0123456789abcdef";
+static uint8_t const m_psk_identity[] = "nrf_tls_client";
+
+static nrf_tls_preshared_key_t m_psk_settings =
+{
+    .p_identity     = m_psk_identity,
+    .p_secret_key   = m_psk,
+    .identity_len   = sizeof(m_psk_identity) - 1,
+    .secret_key_len = sizeof(m_psk) - 1,
+};
+
+static nrf_tls_key_settings_t m_key_settings =
+{
+    .p_psk = &m_psk_settings,
+};
+
+static pipe_t                     m_to_server;
+static pipe_t                     m_to_client;
+static uint32_t                   m_bytes;              /**< Bytes written by both instances. */
+static iot_timer_time_in_ms_t     m_wall_clock;
+static uint32_t                   m_rng_state = 0x6D2B79F5;
+static void                     * m_blocks[MEM_BLOCKS_MAX];
+static uint32_t                   m_block_count;
+static mbedtls_ssl_ticket_context m_ticket_context;
+static bool                       m_tickets;            /**< The server issues session tickets. */
+
+
+void * nrf_malloc(uint32_t size)
+{
+    void * p_mem = malloc(size);
+
+    if (p_mem != NULL)
+    {
+        TEST_ASSERT(m_block_count < MEM_BLOCKS_MAX);
+        m_blocks[m_block_count++] = p_mem;
+    }
+    return p_mem;
+}
+
+
+void * nrf_calloc(uint32_t count, uint32_t size)
+{
+    void * p_mem = nrf_malloc(count * size);
+
+    if (p_mem != NULL)
+    {
+        memset(p_mem, 0, count * size);
+    }
+    return p_mem;
+}
+
+
+/* Like the memory manager, ignores memory it did not allocate. */
+void nrf_free(void * p_mem)
+{
+    for (uint32_t i = 0; i < m_block_count; i++)
+    {
+        if (m_blocks[i] == p_mem)
+        {
+            m_blocks[i] = m_blocks[--m_block_count];
+            free(p_mem);
+            return;
+        }
+    }
+}
+
+
+ret_code_t nrf_drv_rng_init(nrf_drv_rng_config_t const * p_config)
+{
+    UNUSED_PARAMETER(p_config);
+    return NRF_SUCCESS;
+}
+
+
+void nrf_drv_rng_bytes_available(uint8_t * p_bytes_available)
+{
+    *p_bytes_available = RNG_CONFIG_POOL_SIZE;
+}
+
+
+ret_code_t nrf_drv_rng_rand(uint8_t * p_buff, uint8_t length)
+{
+    for (uint8_t i = 0; i < length; i++)
+    {
+        p_buff[i] = (uint8_t)host_test_rand(&m_rng_state);
+    }
+    return NRF_SUCCESS;
+}
+
+
+uint32_t iot_timer_wall_clock_get(iot_timer_time_in_ms_t * p_elapsed_time)
+{
+    *p_elapsed_time = m_wall_clock;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t iot_timer_wall_clock_delta_get(iot_timer_time_in_ms_t * p_past_time,
+                                        iot_timer_time_in_ms_t * p_delta_time)
+{
+    *p_delta_time = m_wall_clock - *p_past_time;
+    return NRF_SUCCESS;
+}
+
+
+static int ticket_rng(void * p_ctx, unsigned char * p_buffer, size_t size)
+{
+    UNUSED_PARAMETER(p_ctx);
+    for (size_t i = 0; i < size; i++)
+    {
+        p_buffer[i] = (uint8_t)host_test_rand(&m_rng_state);
+    }
+    return 0;
+}
+
+
+static uint32_t transport_output(nrf_tls_instance_t const * p_instance,
+                                 uint8_t            const * p_data,
+                                 uint32_t                   datalen)
+{
+    pipe_t * p_pipe = (p_instance->transport_id == SERVER_TRANSPORT_ID) ? &m_to_client
+                                                                        : &m_to_server;
+
+    TEST_ASSERT(p_pipe->len + datalen <= PIPE_SIZE);
+    memcpy(&p_pipe->data[p_pipe->len], p_data, datalen);
+    p_pipe->len += datalen;
+    m_bytes     += datalen;
+    return NRF_SUCCESS;
+}
+
+
+/* Delivers what is queued in a pipe. Returns false if the pipe was empty. */
+static bool pipe_deliver(pipe_t * p_pipe, nrf_tls_instance_t const * p_peer)
+{
+    uint8_t  data[PIPE_SIZE];
+    uint32_t len = p_pipe->len;
+
+    if (len == 0)
+    {
+        return false;
+    }
+
+    // The peer writes its response into the other pipe while the input is processed.
+    memcpy(data, p_pipe->data, len);
+    p_pipe->len = 0;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_input(p_peer, data, len));
+    return true;
+}
+
+
+static void pipes_run(link_t * p_link)
+{
+    while (pipe_deliver(&m_to_server, &p_link->server) |
+           pipe_deliver(&m_to_client, &p_link->client))
+    {
+    }
+}
+
+
+/* Connects a client with the given cache key to a new server instance, completes the handshake
+ * and checks that application data gets through. */
+static void link_open(link_t * p_link, uint32_t key)
+{
+    nrf_tls_options_t options =
+    {
+        .output_fn      = transport_output,
+        .transport_type = NRF_TLS_TYPE_STREAM,
+        .role           = NRF_TLS_ROLE_SERVER,
+        .p_key_settings = &m_key_settings,
+    };
+    uint8_t  data[8];
+    uint32_t len = sizeof("ping");
+
+    p_link->server.transport_id = SERVER_TRANSPORT_ID;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_alloc(&p_link->server, &options));
+
+    interface_t * p_server = m_interface[p_link->server.instance_id];
+    if (m_tickets)
+    {
+        mbedtls_ssl_conf_session_tickets_cb(&p_server->conf,
+                                            mbedtls_ssl_ticket_write,
+                                            mbedtls_ssl_ticket_parse,
+                                            &m_ticket_context);
+    }
+
+    options.role              = NRF_TLS_ROLE_CLIENT;
+    options.session_cache_key = key;
+    p_link->client.transport_id = CLIENT_TRANSPORT_ID;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_alloc(&p_link->client, &options));
+
+    interface_t * p_client = m_interface[p_link->client.instance_id];
+
+    pipes_run(p_link);
+    TEST_ASSERT_EQUAL(MBEDTLS_SSL_HANDSHAKE_OVER, p_client->context.state);
+    TEST_ASSERT_EQUAL(MBEDTLS_SSL_HANDSHAKE_OVER, p_server->context.state);
+    TEST_ASSERT(memcmp(p_client->context.session->master,
+                       p_server->context.session->master,
+                       sizeof(p_link->master)) == 0);
+    memcpy(p_link->master, p_client->context.session->master, sizeof(p_link->master));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_write(&p_link->client, (uint8_t const *)"ping", &len));
+    pipes_run(p_link);
+    len = sizeof(data);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_read(&p_link->server, data, &len));
+    TEST_ASSERT_EQUAL(sizeof("ping"), len);
+    TEST_ASSERT(memcmp(data, "ping", len) == 0);
+}
+
+
+static void link_close(link_t * p_link)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_free(&p_link->client));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_free(&p_link->server));
+    TEST_ASSERT_EQUAL(0, m_to_server.len);
+    TEST_ASSERT_EQUAL(0, m_to_client.len);
+}
+
+
+/* Connects, disconnects and returns whether the client resumed the session of p_previous. */
+static bool connect(uint32_t key, uint8_t const * p_previous, uint8_t * p_master)
+{
+    link_t   link;
+    bool     resumed;
+    uint32_t blocks = m_block_count;
+
+    link_open(&link, key);
+    link_close(&link);
+    TEST_ASSERT_EQUAL(blocks, m_block_count);
+
+    resumed = (p_previous != NULL) && (memcmp(link.master, p_previous, sizeof(link.master)) == 0);
+    if (p_master != NULL)
+    {
+        memcpy(p_master, link.master, sizeof(link.master));
+    }
+    return resumed;
+}
+
+
+static session_entry_t const * client_entry(uint32_t key)
+{
+    for (uint32_t i = 0; i < NRF_TLS_SESSION_CACHE_SIZE; i++)
+    {
+        if (m_session_cache[i].in_use && (m_session_cache[i].key == key))
+        {
+            return &m_session_cache[i];
+        }
+    }
+    return NULL;
+}
+
+
+static uint32_t server_entry_count(void)
+{
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < NRF_TLS_SESSION_CACHE_SIZE; i++)
+    {
+        count += (m_session_cache[i].in_use && (m_session_cache[i].key == 0)) ? 1 : 0;
+    }
+    return count;
+}
+
+
+static void test_setup(bool tickets)
+{
+    nrf_tls_session_cache_clear();
+    m_tickets = tickets;
+}
+
+
+/* The server caches the session by ID, and the client offers that ID on the next connection. */
+static void resume_by_session_id(void)
+{
+    uint8_t master[48];
+
+    test_setup(false);
+
+    TEST_ASSERT(!connect(KEY_A, NULL, master));
+    TEST_ASSERT(client_entry(KEY_A) != NULL);
+    TEST_ASSERT_EQUAL(0, client_entry(KEY_A)->ticket_len);
+    TEST_ASSERT_EQUAL(32, client_entry(KEY_A)->id_len);
+    TEST_ASSERT_EQUAL(1, server_entry_count());
+
+    TEST_ASSERT(connect(KEY_A, master, NULL));
+    TEST_ASSERT(connect(KEY_A, master, NULL));
+    TEST_ASSERT_EQUAL(1, server_entry_count());
+
+    // A client without a cache key always runs a full handshake.
+    TEST_ASSERT(!connect(0, master, NULL));
+}
+
+
+/* The server only issues tickets and keeps no sessions, so resumption can only use the ticket. */
+static void resume_by_ticket(void)
+{
+    uint8_t master[48];
+
+    test_setup(true);
+
+    TEST_ASSERT(!connect(KEY_A, NULL, master));
+    TEST_ASSERT(client_entry(KEY_A) != NULL);
+    TEST_ASSERT(client_entry(KEY_A)->ticket_len > 0);
+    TEST_ASSERT_EQUAL(0, server_entry_count());
+
+    TEST_ASSERT(connect(KEY_A, master, NULL));
+    TEST_ASSERT(connect(KEY_A, master, NULL));
+    TEST_ASSERT_EQUAL(0, server_entry_count());
+}
+
+
+/* With the cache full, a new session replaces the least recently used one. Resuming a session
+ * makes it the most recently used. */
+static void lru_eviction(void)
+{
+    uint8_t master[NRF_TLS_SESSION_CACHE_SIZE + 1][48];
+
+    test_setup(true);
+
+    for (uint32_t i = 0; i < NRF_TLS_SESSION_CACHE_SIZE; i++)
+    {
+        TEST_ASSERT(!connect(KEY_A + i, NULL, master[i]));
+    }
+    TEST_ASSERT(connect(KEY_A, master[0], NULL));
+
+    // Replaces KEY_A + 1, now the least recently used.
+    TEST_ASSERT(!connect(KEY_A + NRF_TLS_SESSION_CACHE_SIZE, NULL, master[NRF_TLS_SESSION_CACHE_SIZE]));
+    TEST_ASSERT(client_entry(KEY_A + 1) == NULL);
+    for (uint32_t i = 0; i <= NRF_TLS_SESSION_CACHE_SIZE; i++)
+    {
+        TEST_ASSERT((i == 1) || (client_entry(KEY_A + i) != NULL));
+    }
+
+    // KEY_A + 1 needs a full handshake and replaces KEY_A + 2.
+    TEST_ASSERT(!connect(KEY_A + 1, master[1], master[1]));
+    TEST_ASSERT(client_entry(KEY_A + 2) == NULL);
+    TEST_ASSERT(connect(KEY_A, master[0], NULL));
+    TEST_ASSERT(connect(KEY_A + 1, master[1], NULL));
+    TEST_ASSERT(connect(KEY_A + NRF_TLS_SESSION_CACHE_SIZE, master[NRF_TLS_SESSION_CACHE_SIZE], NULL));
+}
+
+
+/* Sessions older than NRF_TLS_SESSION_CACHE_TIMEOUT are neither offered by the client nor
+ * accepted by the server. */
+static void expiry(void)
+{
+    uint8_t master[48];
+
+    test_setup(false);
+    m_wall_clock = 10 * NRF_TLS_SESSION_CACHE_TIMEOUT;
+
+    TEST_ASSERT(!connect(KEY_A, NULL, master));
+    m_wall_clock += NRF_TLS_SESSION_CACHE_TIMEOUT - 1;
+    TEST_ASSERT(connect(KEY_A, master, NULL));
+
+    // The resumed session keeps the time of the full handshake.
+    m_wall_clock += 1;
+    TEST_ASSERT(!connect(KEY_A, master, master));
+    TEST_ASSERT(client_entry(KEY_A) != NULL);
+    TEST_ASSERT_EQUAL(m_wall_clock, client_entry(KEY_A)->timestamp);
+
+    // Only the server copy is too old: the client offers the session, the server refuses it.
+    for (uint32_t i = 0; i < NRF_TLS_SESSION_CACHE_SIZE; i++)
+    {
+        if (m_session_cache[i].in_use && (m_session_cache[i].key == 0))
+        {
+            m_session_cache[i].timestamp -= NRF_TLS_SESSION_CACHE_TIMEOUT;
+        }
+    }
+    TEST_ASSERT(!connect(KEY_A, master, master));
+    TEST_ASSERT(connect(KEY_A, master, NULL));
+}
+
+
+/* nrf_tls_session_cache_clear() forgets the sessions of both roles. */
+static void cache_clear(void)
+{
+    uint8_t master[48];
+
+    test_setup(false);
+
+    TEST_ASSERT(!connect(KEY_A, NULL, master));
+    TEST_ASSERT(!connect(KEY_A + 1, NULL, NULL));
+    TEST_ASSERT_EQUAL(2, server_entry_count());
+
+    nrf_tls_session_cache_clear();
+    for (uint32_t i = 0; i < NRF_TLS_SESSION_CACHE_SIZE; i++)
+    {
+        TEST_ASSERT(!m_session_cache[i].in_use);
+    }
+
+    TEST_ASSERT(!connect(KEY_A, master, master));
+    TEST_ASSERT(connect(KEY_A, master, NULL));
+}
+
+
+/* Runs handshakes and returns the average time of one in microseconds. */
+static uint32_t bench_run(bool resume, uint32_t * p_bytes)
+{
+    uint64_t start;
+    uint64_t time_ns = 0;
+
+    m_bytes = 0;
+    for (uint32_t i = 0; i < BENCH_HANDSHAKES; i++)
+    {
+        if (!resume)
+        {
+            nrf_tls_session_cache_clear();
+        }
+        start    = host_test_time_ns();
+        (void)connect(KEY_A, NULL, NULL);
+        time_ns += host_test_time_ns() - start;
+    }
+    *p_bytes = m_bytes / BENCH_HANDSHAKES;
+    return (uint32_t)(time_ns / BENCH_HANDSHAKES / 1000);
+}
+
+
+/* Prints the time and the bytes on the wire of full and resumed PSK handshakes, including one
+ * record of application data. The figures are informational; host timing varies. */
+static void benchmark(void)
+{
+    uint32_t bytes;
+    uint32_t time_us;
+
+    test_setup(false);
+    time_us = bench_run(false, &bytes);
+    printf("    full handshake:            %u us, %u B\n", (unsigned)time_us, (unsigned)bytes);
+    time_us = bench_run(true, &bytes);
+    printf("    resumed by session ID:     %u us, %u B\n", (unsigned)time_us, (unsigned)bytes);
+
+    test_setup(true);
+    time_us = bench_run(false, &bytes);
+    printf("    full handshake, ticket:    %u us, %u B\n", (unsigned)time_us, (unsigned)bytes);
+    time_us = bench_run(true, &bytes);
+    printf("    resumed by ticket:         %u us, %u B\n", (unsigned)time_us, (unsigned)bytes);
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, nrf_tls_init());
+
+    mbedtls_ssl_ticket_init(&m_ticket_context);
+    TEST_ASSERT_EQUAL(0, mbedtls_ssl_ticket_setup(&m_ticket_context,
+                                                  ticket_rng,
+                                                  NULL,
+                                                  MBEDTLS_CIPHER_AES_128_GCM,
+                                                  NRF_TLS_SESSION_CACHE_TIMEOUT / 1000));
+
+    host_test_run("resume_by_session_id", resume_by_session_id);
+    host_test_run("resume_by_ticket", resume_by_ticket);
+    host_test_run("lru_eviction", lru_eviction);
+    host_test_run("expiry", expiry);
+    host_test_run("cache_clear", cache_clear);
+    host_test_run("benchmark", benchmark);
+
+    mbedtls_ssl_ticket_free(&m_ticket_context);
+    return 0;
+}
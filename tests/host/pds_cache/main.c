@@ -0,0 +1,364 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the peer data record cache of peer_data_storage.c on the FDS fake: hits, a
+ *        cached miss followed by a write, updates, deletes, garbage collection moving the records,
+ *        replacement of entries, and a search result which is discarded because the flash
+ *        changed while the search ran.
+ *
+ * The flash searches are counted by wrapping fds_record_find() at link time.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "fds.h"
+#include "fds_fake.h"
+#include "peer_data_storage.h"
+
+#define PEER_DATA_WORDS     (4)
+
+ret_code_t __real_fds_record_find(uint16_t            file_id,
+                                  uint16_t            record_key,
+                                  fds_record_desc_t * p_desc,
+                                  fds_find_token_t  * p_token);
+
+static uint32_t m_find_cnt;             /**< Number of flash searches. */
+static bool     m_process_in_find;      /**< Carry out the queued FDS operations during a search. */
+static uint32_t m_pds_evt_cnt;
+static pm_evt_t m_pds_evt;              /**< Last Peer Data Storage event. */
+
+
+ret_code_t __wrap_fds_record_find(uint16_t            file_id,
+                                  uint16_t            record_key,
+                                  fds_record_desc_t * p_desc,
+                                  fds_find_token_t  * p_token)
+{
+    ret_code_t ret = __real_fds_record_find(file_id, record_key, p_desc, p_token);
+
+    m_find_cnt++;
+
+    if (m_process_in_find)
+    {
+        // An FDS event arrives after the flash was searched, before the result is used.
+        m_process_in_find = false;
+        (void)fds_fake_process();
+    }
+
+    return ret;
+}
+
+
+void pdb_pds_evt_handler(pm_evt_t * p_event)
+{
+    m_pds_evt = *p_event;
+    m_pds_evt_cnt++;
+}
+
+
+static void setup(void)
+{
+    fds_fake_reset();
+    m_find_cnt        = 0;
+    m_process_in_find = false;
+    m_pds_evt_cnt     = 0;
+}
+
+
+/* Starts Peer Data Storage on the empty fake. The initialization check of pds_init() is only
+ * active with NRF_PM_DEBUG, so every case can initialize it again. */
+static pm_peer_id_t pds_start(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, pds_init());
+    (void)fds_fake_process();
+
+    pm_peer_id_t peer_id = pds_peer_id_allocate();
+    TEST_ASSERT(peer_id != PM_PEER_ID_INVALID);
+    return peer_id;
+}
+
+
+static void store(pm_peer_id_t peer_id, pm_peer_data_id_t data_id, uint32_t const * p_words)
+{
+    pm_peer_data_const_t peer_data =
+    {
+        .data_id      = data_id,
+        .length_words = PEER_DATA_WORDS,
+        .p_all_data   = p_words,
+    };
+
+    uint32_t const evt_cnt = m_pds_evt_cnt;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, pds_peer_data_store(peer_id, &peer_data, NULL));
+    TEST_ASSERT_EQUAL(1, fds_fake_process());
+    TEST_ASSERT_EQUAL(evt_cnt + 1, m_pds_evt_cnt);
+    TEST_ASSERT_EQUAL(PM_EVT_PEER_DATA_UPDATE_SUCCEEDED, m_pds_evt.evt_id);
+}
+
+
+/* Reads a record and checks its contents and the number of flash searches it took. */
+static void read_check(pm_peer_id_t      peer_id,
+                       pm_peer_data_id_t data_id,
+                       uint32_t const *  p_expected,
+                       uint32_t          searches)
+{
+    uint32_t       buf[PEER_DATA_WORDS];
+    uint32_t const buf_len   = sizeof(buf);
+    uint32_t const find_cnt  = m_find_cnt;
+    pm_peer_data_t peer_data =
+    {
+        .p_all_data = buf,
+    };
+
+    memset(buf, 0, sizeof(buf));
+    ret_code_t ret = pds_peer_data_read(peer_id, data_id, &peer_data, &buf_len);
+
+    if (p_expected == NULL)
+    {
+        TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND, ret);
+    }
+    else
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ret);
+        TEST_ASSERT_EQUAL(data_id, peer_data.data_id);
+        TEST_ASSERT_EQUAL(PEER_DATA_WORDS, peer_data.length_words);
+        TEST_ASSERT_EQUAL(0, memcmp(buf, p_expected, sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL(find_cnt + searches, m_find_cnt);
+}
+
+
+/* Repeated reads of a record, and of a record that does not exist, search the flash once. A
+ * write of the missing record replaces the cached miss. */
+static void hit_and_miss(void)
+{
+    static uint32_t const bonding[PEER_DATA_WORDS] = { 1, 2, 3, 4 };
+    static uint32_t const app[PEER_DATA_WORDS]     = { 5, 6, 7, 8 };
+
+    setup();
+    pm_peer_id_t peer_id = pds_start();
+
+    store(peer_id, PM_PEER_DATA_ID_BONDING, bonding);
+    read_check(peer_id, PM_PEER_DATA_ID_BONDING, bonding, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_BONDING, bonding, 0);
+    read_check(peer_id, PM_PEER_DATA_ID_BONDING, bonding, 0);
+
+    read_check(peer_id, PM_PEER_DATA_ID_APPLICATION, NULL, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_APPLICATION, NULL, 0);
+
+    store(peer_id, PM_PEER_DATA_ID_APPLICATION, app);
+    read_check(peer_id, PM_PEER_DATA_ID_APPLICATION, app, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_APPLICATION, app, 0);
+
+    // The write did not touch the entry of the other record.
+    read_check(peer_id, PM_PEER_DATA_ID_BONDING, bonding, 0);
+
+    // Other peers have their own entries.
+    pm_peer_id_t other = pds_peer_id_allocate();
+    read_check(other, PM_PEER_DATA_ID_BONDING, NULL, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_BONDING, bonding, 0);
+}
+
+
+/* An update or a delete of a record drops its entry. So does a delete of the peer. */
+static void update_and_delete(void)
+{
+    static uint32_t const first[PEER_DATA_WORDS]  = { 1, 2, 3, 4 };
+    static uint32_t const second[PEER_DATA_WORDS] = { 9, 9, 9, 9 };
+
+    setup();
+    pm_peer_id_t peer_id = pds_start();
+
+    store(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, first);
+    store(peer_id, PM_PEER_DATA_ID_PEER_RANK, first);
+    read_check(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, first, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_PEER_RANK, first, 1);
+
+    store(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, second);
+    read_check(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, second, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, second, 0);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, pds_peer_data_delete(peer_id, PM_PEER_DATA_ID_GATT_REMOTE));
+    TEST_ASSERT_EQUAL(1, fds_fake_process());
+    read_check(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, NULL, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, NULL, 0);
+    read_check(peer_id, PM_PEER_DATA_ID_PEER_RANK, first, 0);
+
+    // Deleting the peer drops all its entries, also the cached miss.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, pds_peer_id_free(peer_id));
+    (void)fds_fake_process();
+    TEST_ASSERT_EQUAL(PM_EVT_PEER_DELETE_SUCCEEDED, m_pds_evt.evt_id);
+    TEST_ASSERT(!pds_peer_id_is_allocated(peer_id));
+    read_check(peer_id, PM_PEER_DATA_ID_PEER_RANK, NULL, 1);
+
+    // A peer which gets the same ID starts with no entries.
+    TEST_ASSERT_EQUAL(peer_id, pds_peer_id_allocate());
+    store(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, second);
+    read_check(peer_id, PM_PEER_DATA_ID_GATT_REMOTE, second, 1);
+}
+
+
+/* Garbage collection moves the records. A cached location still leads to the record, through
+ * its record ID, without a new search. */
+static void gc_relocation(void)
+{
+    static uint32_t const old[PEER_DATA_WORDS]  = { 1, 1, 1, 1 };
+    static uint32_t const kept[PEER_DATA_WORDS] = { 2, 2, 2, 2 };
+    static uint32_t const app[PEER_DATA_WORDS]  = { 3, 3, 3, 3 };
+    pm_peer_data_flash_t  peer_data;
+
+    setup();
+    pm_peer_id_t peer_id = pds_start();
+
+    // An outdated copy in front of the record, so that the record moves.
+    store(peer_id, PM_PEER_DATA_ID_BONDING, old);
+    store(peer_id, PM_PEER_DATA_ID_BONDING, kept);
+    store(peer_id, PM_PEER_DATA_ID_APPLICATION, app);
+    read_check(peer_id, PM_PEER_DATA_ID_BONDING, kept, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_APPLICATION, app, 1);
+
+    pm_peer_data_t flash_data;
+    memset(&flash_data, 0, sizeof(flash_data));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      pds_peer_data_read(peer_id, PM_PEER_DATA_ID_APPLICATION, &flash_data, NULL));
+    void const * p_before = flash_data.p_all_data;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, fds_gc());
+    TEST_ASSERT_EQUAL(1, fds_fake_process());
+    TEST_ASSERT_EQUAL(1, fds_fake_gc_count_get());
+    TEST_ASSERT_EQUAL(PM_EVT_FLASH_GARBAGE_COLLECTED, m_pds_evt.evt_id);
+
+    read_check(peer_id, PM_PEER_DATA_ID_BONDING, kept, 0);
+    read_check(peer_id, PM_PEER_DATA_ID_APPLICATION, app, 0);
+
+    // Reads without a buffer point to the new location.
+    memset(&flash_data, 0, sizeof(flash_data));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      pds_peer_data_read(peer_id, PM_PEER_DATA_ID_APPLICATION, &flash_data, NULL));
+    TEST_ASSERT(flash_data.p_all_data != p_before);
+    TEST_ASSERT_EQUAL(0, memcmp(flash_data.p_all_data, app, sizeof(app)));
+
+    // Iteration does not use the cache, and sees the same data.
+    pm_peer_id_t iter_peer_id;
+    pds_peer_data_iterate_prepare();
+    TEST_ASSERT(pds_peer_data_iterate(PM_PEER_DATA_ID_BONDING, &iter_peer_id, &peer_data));
+    TEST_ASSERT_EQUAL(peer_id, iter_peer_id);
+    TEST_ASSERT_EQUAL(0, memcmp(peer_data.p_all_data, kept, sizeof(kept)));
+    TEST_ASSERT(!pds_peer_data_iterate(PM_PEER_DATA_ID_BONDING, &iter_peer_id, &peer_data));
+}
+
+
+/* With all entries in use, the oldest one is replaced. */
+static void replacement(void)
+{
+    static uint32_t const data[PEER_DATA_WORDS] = { 4, 3, 2, 1 };
+    static pm_peer_data_id_t const data_ids[] =
+    {
+        PM_PEER_DATA_ID_BONDING,
+        PM_PEER_DATA_ID_SERVICE_CHANGED_PENDING,
+        PM_PEER_DATA_ID_GATT_LOCAL,
+        PM_PEER_DATA_ID_GATT_REMOTE,
+        PM_PEER_DATA_ID_PEER_RANK,
+    };
+
+    STATIC_ASSERT(ARRAY_SIZE(data_ids) == PM_PEER_DATA_CACHE_SIZE + 1);
+
+    setup();
+    pm_peer_id_t peer_id = pds_start();
+
+    store(peer_id, PM_PEER_DATA_ID_BONDING, data);
+
+    for (uint32_t i = 0; i < PM_PEER_DATA_CACHE_SIZE; i++)
+    {
+        read_check(peer_id, data_ids[i], (i == 0) ? data : NULL, 1);
+    }
+    for (uint32_t i = 0; i < PM_PEER_DATA_CACHE_SIZE; i++)
+    {
+        read_check(peer_id, data_ids[i], (i == 0) ? data : NULL, 0);
+    }
+
+    // The fifth record takes the entry of the first, the others stay.
+    read_check(peer_id, data_ids[PM_PEER_DATA_CACHE_SIZE], NULL, 1);
+    read_check(peer_id, data_ids[1], NULL, 0);
+    read_check(peer_id, data_ids[PM_PEER_DATA_CACHE_SIZE], NULL, 0);
+
+    // The first record comes back in the entry of the second.
+    read_check(peer_id, data_ids[0], data, 1);
+    read_check(peer_id, data_ids[PM_PEER_DATA_CACHE_SIZE], NULL, 0);
+    read_check(peer_id, data_ids[2], NULL, 0);
+    read_check(peer_id, data_ids[1], NULL, 1);
+}
+
+
+/* A write completes while the flash is searched for the record. The search did not see the
+ * record, and its result must not be cached. */
+static void stale_search(void)
+{
+    static uint32_t const data[PEER_DATA_WORDS] = { 7, 7, 7, 7 };
+    pm_peer_data_const_t  peer_data =
+    {
+        .data_id      = PM_PEER_DATA_ID_CENTRAL_ADDR_RES,
+        .length_words = PEER_DATA_WORDS,
+        .p_all_data   = data,
+    };
+
+    setup();
+    pm_peer_id_t peer_id = pds_start();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, pds_peer_data_store(peer_id, &peer_data, NULL));
+
+    m_pds_evt_cnt     = 0;
+    m_process_in_find = true;
+    read_check(peer_id, PM_PEER_DATA_ID_CENTRAL_ADDR_RES, NULL, 1);
+    TEST_ASSERT_EQUAL(1, m_pds_evt_cnt);
+    TEST_ASSERT_EQUAL(PM_EVT_PEER_DATA_UPDATE_SUCCEEDED, m_pds_evt.evt_id);
+
+    read_check(peer_id, PM_PEER_DATA_ID_CENTRAL_ADDR_RES, data, 1);
+    read_check(peer_id, PM_PEER_DATA_ID_CENTRAL_ADDR_RES, data, 0);
+}
+
+
+int main(void)
+{
+    host_test_run("hit_and_miss", hit_and_miss);
+    host_test_run("update_and_delete", update_and_delete);
+    host_test_run("gc_relocation", gc_relocation);
+    host_test_run("replacement", replacement);
+    host_test_run("stale_search", stale_search);
+    return 0;
+}
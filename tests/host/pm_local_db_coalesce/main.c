@@ -0,0 +1,421 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the CCCD write coalescing in the GATT Cache Manager: CCCD changes are stored
+ *        once per burst of writes, on disconnection, on flush and after the quiet period.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "app_timer.h"
+#include "drv_rtc_fake.h"
+#include "ble_conn_state.h"
+#include "gatt_cache_manager.h"
+#include "gatts_cache_manager.h"
+#include "id_manager.h"
+#include "peer_database.h"
+#include "peer_data_storage.h"
+
+#define CONN_COUNT      4   /**< Number of simulated connections. */
+#define FLAG_COUNT      16  /**< Number of user flags the ble_conn_state stub has. */
+
+static uint32_t m_flags[FLAG_COUNT];       /**< Bit mask of connections per user flag. */
+static uint32_t m_flag_cnt;                /**< Number of user flags acquired. */
+static uint32_t m_stores[CONN_COUNT];      /**< Local DB stores started, per connection. */
+static uint32_t m_stores_pending;          /**< Local DB stores not yet reported as done. */
+
+// GATT Cache Manager event handler in Peer Database.
+extern void gcm_pdb_evt_handler(pm_evt_t * p_event);
+
+
+/* ble_conn_state stub. */
+
+ble_conn_state_user_flag_id_t ble_conn_state_user_flag_acquire(void)
+{
+    if (m_flag_cnt == FLAG_COUNT)
+    {
+        return BLE_CONN_STATE_USER_FLAG_INVALID;
+    }
+    return (ble_conn_state_user_flag_id_t)m_flag_cnt++;
+}
+
+
+bool ble_conn_state_user_flag_get(uint16_t conn_handle, ble_conn_state_user_flag_id_t flag_id)
+{
+    TEST_ASSERT(conn_handle < CONN_COUNT);
+    return (m_flags[flag_id] & (1UL << conn_handle)) != 0;
+}
+
+
+void ble_conn_state_user_flag_set(uint16_t                      conn_handle,
+                                  ble_conn_state_user_flag_id_t flag_id,
+                                  bool                          value)
+{
+    TEST_ASSERT(conn_handle < CONN_COUNT);
+    if (value)
+    {
+        m_flags[flag_id] |= (1UL << conn_handle);
+    }
+    else
+    {
+        m_flags[flag_id] &= ~(1UL << conn_handle);
+    }
+}
+
+
+uint32_t ble_conn_state_for_each_set_user_flag(ble_conn_state_user_flag_id_t  flag_id,
+                                               ble_conn_state_user_function_t user_function,
+                                               void                         * p_context)
+{
+    uint32_t count = 0;
+
+    for (uint16_t i = 0; i < CONN_COUNT; i++)
+    {
+        if (m_flags[flag_id] & (1UL << i))
+        {
+            user_function(i, p_context);
+            count++;
+        }
+    }
+    return count;
+}
+
+
+ble_conn_state_conn_handle_list_t ble_conn_state_conn_handles(void)
+{
+    ble_conn_state_conn_handle_list_t list = {.len = CONN_COUNT};
+
+    for (uint16_t i = 0; i < CONN_COUNT; i++)
+    {
+        list.conn_handles[i] = i;
+    }
+    return list;
+}
+
+
+/* Peer Manager stubs. Only the local DB store is exercised; it completes when the test calls
+ * stores_complete(). */
+
+ret_code_t gscm_local_db_cache_update(uint16_t conn_handle)
+{
+    TEST_ASSERT(conn_handle < CONN_COUNT);
+    TEST_ASSERT_EQUAL(0, m_stores_pending);
+    m_stores[conn_handle]++;
+    m_stores_pending++;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t gscm_local_db_cache_apply(uint16_t conn_handle)
+{
+    return BLE_ERROR_INVALID_CONN_HANDLE;
+}
+
+
+void gscm_local_database_has_changed(void)
+{
+}
+
+
+void gscm_db_change_notification_done(pm_peer_id_t peer_id)
+{
+}
+
+
+bool gscm_service_changed_ind_needed(uint16_t conn_handle)
+{
+    return false;
+}
+
+
+ret_code_t gscm_service_changed_ind_send(uint16_t conn_handle)
+{
+    return NRF_ERROR_INVALID_STATE;
+}
+
+
+pm_peer_id_t im_peer_id_get_by_conn_handle(uint16_t conn_handle)
+{
+    return (pm_peer_id_t)conn_handle;
+}
+
+
+uint16_t im_conn_handle_get(pm_peer_id_t peer_id)
+{
+    return (uint16_t)peer_id;
+}
+
+
+ret_code_t pdb_peer_data_ptr_get(pm_peer_id_t                 peer_id,
+                                 pm_peer_data_id_t            data_id,
+                                 pm_peer_data_flash_t * const p_peer_data)
+{
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
+ret_code_t pds_peer_data_read(pm_peer_id_t                    peer_id,
+                              pm_peer_data_id_t               data_id,
+                              pm_peer_data_t          * const p_data,
+                              uint32_t          const * const p_buf_len)
+{
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
+ret_code_t pds_peer_data_store(pm_peer_id_t                 peer_id,
+                               pm_peer_data_const_t const * p_peer_data,
+                               pm_store_token_t           * p_store_token)
+{
+    return NRF_SUCCESS;
+}
+
+
+void pm_gcm_evt_handler(pm_evt_t * p_gcm_evt)
+{
+    TEST_ASSERT(p_gcm_evt->evt_id != PM_EVT_ERROR_UNEXPECTED);
+    TEST_ASSERT(p_gcm_evt->evt_id != PM_EVT_STORAGE_FULL);
+}
+
+
+/* SoftDevice stubs. */
+
+uint32_t sd_ble_gatts_initial_user_handle_get(uint16_t * p_handle)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_attr_get(uint16_t handle, ble_uuid_t * p_uuid, ble_gatts_attr_md_t * p_md)
+{
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
+uint32_t sd_ble_gatts_value_get(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value)
+{
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
+uint32_t sd_ble_gattc_char_value_by_uuid_read(uint16_t                         conn_handle,
+                                              ble_uuid_t const               * p_uuid,
+                                              ble_gattc_handle_range_t const * p_handle_range)
+{
+    return NRF_ERROR_BUSY;
+}
+
+
+uint32_t sd_ble_gattc_read(uint16_t conn_handle, uint16_t handle, uint16_t offset)
+{
+    return NRF_ERROR_BUSY;
+}
+
+
+/**@brief Function for reporting all started local DB stores as done, as Peer Database would. */
+static void stores_complete(void)
+{
+    while (m_stores_pending != 0)
+    {
+        pm_evt_t evt =
+        {
+            .evt_id = PM_EVT_PEER_DATA_UPDATE_SUCCEEDED,
+            .params.peer_data_update_succeeded =
+            {
+                .data_id = PM_PEER_DATA_ID_GATT_LOCAL,
+                .action  = PM_PEER_DATA_OP_UPDATE,
+            },
+        };
+
+        m_stores_pending--;
+        gcm_pdb_evt_handler(&evt);
+    }
+}
+
+
+static void cccd_write(uint16_t conn_handle)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                         = BLE_GATTS_EVT_WRITE;
+    evt.evt.gatts_evt.conn_handle             = conn_handle;
+    evt.evt.gatts_evt.params.write.op         = BLE_GATTS_OP_WRITE_REQ;
+    evt.evt.gatts_evt.params.write.uuid.type  = BLE_UUID_TYPE_BLE;
+    evt.evt.gatts_evt.params.write.uuid.uuid  = BLE_UUID_DESCRIPTOR_CLIENT_CHAR_CONFIG;
+    evt.evt.gatts_evt.params.write.len        = 2;
+    gcm_ble_evt_handler(&evt);
+}
+
+
+static void disconnect(uint16_t conn_handle)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id           = BLE_GAP_EVT_DISCONNECTED;
+    evt.evt.gap_evt.conn_handle = conn_handle;
+    gcm_ble_evt_handler(&evt);
+}
+
+
+static void advance_ms(uint32_t ms)
+{
+    drv_rtc_fake_advance(APP_TIMER_TICKS(ms));
+    stores_complete();
+}
+
+
+static uint32_t stores_total(void)
+{
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < CONN_COUNT; i++)
+    {
+        total += m_stores[i];
+    }
+    return total;
+}
+
+
+/* Brings every test case to a state without dirty connections and clears the counters. */
+static void reset(void)
+{
+    gcm_local_db_cache_flush();
+    advance_ms(2 * PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS);
+    memset(m_stores, 0, sizeof(m_stores));
+}
+
+
+/* A burst of CCCD writes is stored once, after the quiet period. */
+static void writes_coalesced(void)
+{
+    pm_local_db_cache_stats_t stats_before;
+    pm_local_db_cache_stats_t stats;
+
+    reset();
+    gcm_local_db_cache_stats_get(&stats_before);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        cccd_write(0);
+        advance_ms(100);
+    }
+    TEST_ASSERT_EQUAL(0, stores_total());
+
+    advance_ms(PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS);
+    TEST_ASSERT_EQUAL(1, m_stores[0]);
+    TEST_ASSERT_EQUAL(1, stores_total());
+
+    gcm_local_db_cache_stats_get(&stats);
+    TEST_ASSERT_EQUAL(10, stats.cccd_writes  - stats_before.cccd_writes);
+    TEST_ASSERT_EQUAL(1,  stats.stores       - stats_before.stores);
+    TEST_ASSERT_EQUAL(9,  stats.stores_saved - stats_before.stores_saved);
+}
+
+
+/* Every CCCD write restarts the quiet period, so writes closer together than the delay are
+ * never stored while they go on. */
+static void quiet_period_restarts(void)
+{
+    uint32_t const gap = PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS * 9 / 10;
+
+    reset();
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        cccd_write(1);
+        advance_ms(gap);
+    }
+    TEST_ASSERT_EQUAL(0, stores_total());
+
+    cccd_write(1);
+    advance_ms(PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS - 1);
+    TEST_ASSERT_EQUAL(0, stores_total());
+    advance_ms(2);
+    TEST_ASSERT_EQUAL(1, m_stores[1]);
+    TEST_ASSERT_EQUAL(1, stores_total());
+}
+
+
+/* Disconnection stores at once, and the timer expiry after it finds nothing left to store. */
+static void disconnect_stores(void)
+{
+    reset();
+    cccd_write(2);
+    cccd_write(2);
+    disconnect(2);
+    stores_complete();
+    TEST_ASSERT_EQUAL(1, m_stores[2]);
+
+    advance_ms(2 * PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS);
+    TEST_ASSERT_EQUAL(1, stores_total());
+}
+
+
+/* An explicit flush stores every dirty connection once, one store at a time. */
+static void flush_api(void)
+{
+    reset();
+    cccd_write(0);
+    cccd_write(3);
+    cccd_write(0);
+
+    gcm_local_db_cache_flush();
+    TEST_ASSERT_EQUAL(1, stores_total());
+    stores_complete();
+    TEST_ASSERT_EQUAL(1, m_stores[0]);
+    TEST_ASSERT_EQUAL(1, m_stores[3]);
+
+    advance_ms(2 * PM_LOCAL_DB_COALESCE_FLUSH_DELAY_MS);
+    TEST_ASSERT_EQUAL(2, stores_total());
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_timer_init());
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, gcm_init());
+
+    host_test_run("writes_coalesced", writes_coalesced);
+    host_test_run("quiet_period_restarts", quiet_period_restarts);
+    host_test_run("disconnect_stores", disconnect_stores);
+    host_test_run("flush_api", flush_api);
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host version of nrf_mtx.h, which is left out of the include path. The original uses
+ *        the Cortex-M data memory barrier instruction.
+ */
+#ifndef NRF_MTX_H__
+#define NRF_MTX_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nrf_atomic.h"
+#include "nrf_assert.h"
+
+#define NRF_MTX_LOCKED      1
+#define NRF_MTX_UNLOCKED    0
+
+typedef nrf_atomic_u32_t nrf_mtx_t;
+
+static inline void nrf_mtx_init(nrf_mtx_t * p_mtx)
+{
+    ASSERT(p_mtx != NULL);
+    *p_mtx = NRF_MTX_UNLOCKED;
+}
+
+static inline void nrf_mtx_destroy(nrf_mtx_t * p_mtx)
+{
+    ASSERT(p_mtx != NULL);
+    *p_mtx = NRF_MTX_UNLOCKED;
+}
+
+static inline bool nrf_mtx_trylock(nrf_mtx_t * p_mtx)
+{
+    ASSERT(p_mtx != NULL);
+    return (nrf_atomic_u32_fetch_store(p_mtx, NRF_MTX_LOCKED) == NRF_MTX_UNLOCKED);
+}
+
+static inline void nrf_mtx_unlock(nrf_mtx_t * p_mtx)
+{
+    ASSERT(p_mtx != NULL);
+    ASSERT(*p_mtx == NRF_MTX_LOCKED);
+    *p_mtx = NRF_MTX_UNLOCKED;
+}
+
+#endif // NRF_MTX_H__
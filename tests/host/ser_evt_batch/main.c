@@ -0,0 +1,543 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of BLE event batching: events encoded on the connectivity side are packed into
+ *        batch packets, carried over a fake HAL transport and split again by the application
+ *        side SoftDevice transport. The transport also models the line time of a UART, for
+ *        the event rate with and without batching.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "app_util.h"
+#include "app_scheduler.h"
+#include "ble_serialization.h"
+#include "ser_hal_transport.h"
+#include "ser_sd_transport.h"
+#include "ser_conn_event_encoder.h"
+#include "ser_conn_handlers.h"
+#include "ser_app_power_system_off.h"
+#include "ble_conn.h"
+
+#define SCHED_QUEUE_SIZE    16  /**< Number of events the scheduler stub can hold. */
+#define WIRE_PKT_COUNT      16  /**< Number of packets the fake transport can hold. */
+#define EVT_COUNT_MAX       16  /**< Number of events the application side can record. */
+#define PKT_SIZE            SER_HAL_TRANSPORT_MAX_PKT_SIZE
+
+/* UART link model. ser_phy_hci frames a packet with a 4-byte header and a 2-byte CRC, SLIP adds a
+ * delimiter at each end, and the peer acknowledges each packet with a header-only frame before
+ * the next one is sent. */
+#define UART_BAUDRATE       SER_PHY_UART_BAUDRATE_VAL
+#define UART_BITS_PER_BYTE  10  /**< Start bit, 8 data bits and stop bit. */
+#define HCI_HDR_SIZE        4
+#define HCI_CRC_SIZE        2
+#define SLIP_OVERHEAD       2
+#define SLIP_END            0xC0
+#define SLIP_ESC            0xDB
+
+#define BENCH_EVT_COUNT     256 /**< Events sent per benchmark run. */
+#define BENCH_EVT_LEN       20  /**< Payload of a benchmark event, as of a notification. */
+
+/**@brief Scheduled event. */
+typedef struct
+{
+    app_sched_event_handler_t handler;
+    ble_evt_t                 evt;
+} sched_item_t;
+
+/**@brief Packet on the fake transport. */
+typedef struct
+{
+    uint8_t  data[PKT_SIZE];
+    uint16_t len;
+} wire_pkt_t;
+
+/**@brief Event received on the application side. */
+typedef struct
+{
+    uint16_t evt_id;
+    uint16_t len;
+} rx_evt_t;
+
+bool m_reset_ongoing;   /**< Defined by the connectivity handlers, which are not part of the test. */
+
+static sched_item_t m_sched_queue[SCHED_QUEUE_SIZE];
+static uint32_t     m_sched_rd;
+static uint32_t     m_sched_wr;
+static uint32_t     m_sched_paused;
+
+static ser_hal_transport_events_handler_t m_hal_handler;
+
+static uint8_t      m_tx_buf[PKT_SIZE];
+static bool         m_tx_buf_used;
+static wire_pkt_t   m_wire[WIRE_PKT_COUNT];     /**< Packets sent by the connectivity side. */
+static uint32_t     m_wire_rd;
+static uint32_t     m_wire_wr;
+
+static uint8_t      m_rx_buf[PKT_SIZE];
+static bool         m_rx_buf_used;
+static uint32_t     m_rx_free_cnt;              /**< Number of RX buffers freed. */
+
+static rx_evt_t     m_rx_evts[EVT_COUNT_MAX];   /**< Events received on the application side. */
+static uint32_t     m_rx_evt_cnt;
+
+static uint64_t     m_line_bits;                /**< Bits on the emulated UART, both directions. */
+
+
+/* Scheduler stub. It behaves like app_scheduler with APP_SCHEDULER_WITH_PAUSE, which cannot be
+ * built for a 64-bit host. */
+
+uint32_t app_sched_event_put(void const *              p_event_data,
+                             uint16_t                  event_size,
+                             app_sched_event_handler_t handler)
+{
+    TEST_ASSERT(event_size <= sizeof(ble_evt_t));
+
+    if ((m_sched_wr - m_sched_rd) == SCHED_QUEUE_SIZE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    sched_item_t * p_item = &m_sched_queue[m_sched_wr++ % SCHED_QUEUE_SIZE];
+
+    p_item->handler = handler;
+    if (p_event_data != NULL)
+    {
+        memcpy(&p_item->evt, p_event_data, event_size);
+    }
+    return NRF_SUCCESS;
+}
+
+
+void app_sched_pause(void)
+{
+    m_sched_paused++;
+}
+
+
+void app_sched_resume(void)
+{
+    TEST_ASSERT(m_sched_paused > 0);
+    m_sched_paused--;
+}
+
+
+static void sched_execute(void)
+{
+    while ((m_sched_paused == 0) && (m_sched_rd != m_sched_wr))
+    {
+        sched_item_t * p_item = &m_sched_queue[m_sched_rd++ % SCHED_QUEUE_SIZE];
+
+        p_item->handler(&p_item->evt, sizeof(p_item->evt));
+    }
+}
+
+
+/* Event encoder stub: the event ID followed by header.evt_len bytes of payload. */
+
+uint32_t ble_event_enc(ble_evt_t const * const p_event,
+                       uint32_t                event_len,
+                       uint8_t * const         p_buf,
+                       uint32_t * const        p_buf_len)
+{
+    uint32_t const len = SER_EVT_HEADER_SIZE + p_event->header.evt_len;
+
+    if (len > *p_buf_len)
+    {
+        return NRF_ERROR_DATA_SIZE;
+    }
+
+    (void)uint16_encode(p_event->header.evt_id, &p_buf[SER_EVT_ID_POS]);
+    for (uint32_t i = SER_EVT_HEADER_SIZE; i < len; i++)
+    {
+        p_buf[i] = (uint8_t)(p_event->header.evt_id + i);
+    }
+    *p_buf_len = len;
+    return NRF_SUCCESS;
+}
+
+
+void ser_conn_on_no_mem_handler(void)
+{
+    TEST_ASSERT(false);
+}
+
+
+/**@brief Function for adding the time a packet and its acknowledgement take on the UART.
+ *
+ * @param[in] p_buffer     Packet.
+ * @param[in] num_of_bytes Packet size.
+ */
+static void uart_line_add(uint8_t const * p_buffer, uint16_t num_of_bytes)
+{
+    uint32_t bytes = SLIP_OVERHEAD + HCI_HDR_SIZE + num_of_bytes + HCI_CRC_SIZE;
+
+    for (uint16_t i = 0; i < num_of_bytes; i++)
+    {
+        if ((p_buffer[i] == SLIP_END) || (p_buffer[i] == SLIP_ESC))
+        {
+            bytes++;
+        }
+    }
+    // Acknowledgement from the peer.
+    bytes += SLIP_OVERHEAD + HCI_HDR_SIZE;
+
+    m_line_bits += (uint64_t)bytes * UART_BITS_PER_BYTE;
+}
+
+
+/* Fake HAL transport. The connectivity side sends, the application side receives. */
+
+uint32_t ser_hal_transport_open(ser_hal_transport_events_handler_t events_handler)
+{
+    m_hal_handler = events_handler;
+    return NRF_SUCCESS;
+}
+
+
+void ser_hal_transport_close(void)
+{
+    m_hal_handler = NULL;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_alloc(uint8_t ** pp_memory, uint16_t * p_num_of_bytes)
+{
+    if (m_tx_buf_used)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+    m_tx_buf_used   = true;
+    *pp_memory      = m_tx_buf;
+    *p_num_of_bytes = sizeof(m_tx_buf);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_free(uint8_t * p_buffer)
+{
+    TEST_ASSERT(p_buffer == m_tx_buf);
+    m_tx_buf_used = false;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of_bytes)
+{
+    TEST_ASSERT(p_buffer == m_tx_buf);
+    TEST_ASSERT(num_of_bytes <= PKT_SIZE);
+    TEST_ASSERT(m_wire_wr < WIRE_PKT_COUNT);
+
+    memcpy(m_wire[m_wire_wr].data, p_buffer, num_of_bytes);
+    m_wire[m_wire_wr].len = num_of_bytes;
+    m_wire_wr++;
+    uart_line_add(p_buffer, num_of_bytes);
+    m_tx_buf_used = false;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer)
+{
+    TEST_ASSERT(p_buffer == m_rx_buf);
+    TEST_ASSERT(m_rx_buf_used);
+    m_rx_buf_used = false;
+    m_rx_free_cnt++;
+    return NRF_SUCCESS;
+}
+
+
+bool ser_app_power_system_off_get(void)
+{
+    return false;
+}
+
+
+void ser_app_power_system_off_enter(void)
+{
+}
+
+
+/* Application side event handler. It checks the event and frees it, as the SoftDevice handler
+ * does after decoding. */
+static void ble_evt_handler(uint8_t * p_buffer, uint16_t length)
+{
+    uint16_t const evt_id = uint16_decode(&p_buffer[SER_EVT_ID_POS]);
+
+    TEST_ASSERT(m_rx_evt_cnt < EVT_COUNT_MAX);
+    TEST_ASSERT(length >= SER_EVT_HEADER_SIZE);
+    for (uint32_t i = SER_EVT_HEADER_SIZE; i < length; i++)
+    {
+        TEST_ASSERT_EQUAL((uint8_t)(evt_id + i), p_buffer[i]);
+    }
+
+    m_rx_evts[m_rx_evt_cnt].evt_id = evt_id;
+    m_rx_evts[m_rx_evt_cnt].len    = length - SER_EVT_HEADER_SIZE;
+    m_rx_evt_cnt++;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_rx_free(p_buffer));
+}
+
+
+static void os_rsp_wait_handler(void)
+{
+    TEST_ASSERT(false);
+}
+
+
+/**@brief Function for passing a BLE event to the connectivity side, as its SoftDevice event
+ *        handler does.
+ *
+ * @param[in] evt_id      Event ID.
+ * @param[in] payload_len Length of the encoded event after the event ID.
+ */
+static void evt_put(uint16_t evt_id, uint16_t payload_len)
+{
+    ble_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id  = evt_id;
+    evt.header.evt_len = payload_len;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      app_sched_event_put(&evt, sizeof(evt), ser_conn_ble_event_encoder));
+}
+
+
+/**@brief Function for running the connectivity side until all events are sent, and delivering
+ *        the packets to the application side.
+ */
+static void run(void)
+{
+    uint32_t rd = m_wire_rd;
+
+    sched_execute();
+    while (rd != m_wire_wr)
+    {
+        wire_pkt_t const * p_pkt = &m_wire[rd++];
+
+        TEST_ASSERT(!m_rx_buf_used);
+        m_rx_buf_used = true;
+        memcpy(m_rx_buf, p_pkt->data, p_pkt->len);
+
+        ser_hal_transport_evt_t evt =
+        {
+            .evt_type = SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED,
+            .evt_params.rx_pkt_received =
+            {
+                .p_buffer     = m_rx_buf,
+                .num_of_bytes = p_pkt->len,
+            },
+        };
+        m_hal_handler(evt);
+        TEST_ASSERT(!m_rx_buf_used);
+
+        // The packet is sent, which lets the connectivity side encode the next event.
+        app_sched_resume();
+        sched_execute();
+    }
+    TEST_ASSERT_EQUAL(0, m_sched_paused);
+    TEST_ASSERT(m_sched_rd == m_sched_wr);
+}
+
+
+static void reset(void)
+{
+    m_wire_rd     = m_wire_wr = 0;
+    m_rx_evt_cnt  = 0;
+    m_rx_free_cnt = 0;
+}
+
+
+static void rx_evt_check(uint32_t idx, uint16_t evt_id, uint16_t payload_len)
+{
+    TEST_ASSERT(idx < m_rx_evt_cnt);
+    TEST_ASSERT_EQUAL(evt_id, m_rx_evts[idx].evt_id);
+    TEST_ASSERT_EQUAL(payload_len, m_rx_evts[idx].len);
+}
+
+
+/* Events queued together go out in one batch packet, and the application side receives each of
+ * them and frees the RX buffer once. */
+static void events_batched(void)
+{
+    reset();
+    evt_put(0x10, 20);
+    evt_put(0x11, 0);
+    evt_put(0x12, 40);
+    run();
+
+    TEST_ASSERT_EQUAL(1, m_wire_wr);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT_BATCH, m_wire[0].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(3, m_rx_evt_cnt);
+    rx_evt_check(0, 0x10, 20);
+    rx_evt_check(1, 0x11, 0);
+    rx_evt_check(2, 0x12, 40);
+    TEST_ASSERT_EQUAL(1, m_rx_free_cnt);
+}
+
+
+/* A batch is sent once it holds SER_EVT_BATCH_MAX_EVENTS events. */
+static void batch_max_events(void)
+{
+    reset();
+    for (uint16_t i = 0; i < SER_EVT_BATCH_MAX_EVENTS + 2; i++)
+    {
+        evt_put(0x20 + i, 8);
+    }
+    run();
+
+    TEST_ASSERT_EQUAL(2, m_wire_wr);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT_BATCH, m_wire[0].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT_BATCH, m_wire[1].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(SER_EVT_BATCH_MAX_EVENTS + 2, m_rx_evt_cnt);
+    for (uint16_t i = 0; i < SER_EVT_BATCH_MAX_EVENTS + 2; i++)
+    {
+        rx_evt_check(i, 0x20 + i, 8);
+    }
+    TEST_ASSERT_EQUAL(2, m_rx_free_cnt);
+}
+
+
+/* A lone event goes out as an ordinary event packet. */
+static void single_event(void)
+{
+    reset();
+    evt_put(0x30, 12);
+    run();
+
+    TEST_ASSERT_EQUAL(1, m_wire_wr);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT, m_wire[0].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(1 + SER_EVT_HEADER_SIZE + 12, m_wire[0].len);
+    TEST_ASSERT_EQUAL(1, m_rx_evt_cnt);
+    rx_evt_check(0, 0x30, 12);
+}
+
+
+/* Events that do not fit in one packet are sent in separate packets, including an event that
+ * only fits without the length field. */
+static void large_events(void)
+{
+    uint16_t const max_payload = PKT_SIZE - SER_PKT_TYPE_SIZE - SER_EVT_HEADER_SIZE;
+
+    reset();
+    evt_put(0x40, 300);
+    evt_put(0x41, 300);
+    evt_put(0x42, max_payload);
+    evt_put(0x43, 4);
+    evt_put(0x44, 4);
+    run();
+
+    TEST_ASSERT_EQUAL(4, m_wire_wr);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT, m_wire[0].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT, m_wire[1].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT, m_wire[2].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(PKT_SIZE, m_wire[2].len);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_EVT_BATCH, m_wire[3].data[SER_PKT_TYPE_POS]);
+    TEST_ASSERT_EQUAL(5, m_rx_evt_cnt);
+    rx_evt_check(0, 0x40, 300);
+    rx_evt_check(1, 0x41, 300);
+    rx_evt_check(2, 0x42, max_payload);
+    rx_evt_check(3, 0x43, 4);
+    rx_evt_check(4, 0x44, 4);
+}
+
+
+/**@brief Function for sending events in bursts and measuring the event rate on the UART.
+ *
+ * @param[in] burst Number of events queued before the connectivity side runs.
+ *
+ * @return Events per second at the emulated line rate.
+ */
+static uint32_t evt_rate_measure(uint32_t burst)
+{
+    uint64_t const line_bits = m_line_bits;
+
+    for (uint32_t sent = 0; sent < BENCH_EVT_COUNT; sent += burst)
+    {
+        reset();
+        for (uint16_t i = 0; i < burst; i++)
+        {
+            evt_put(0x50 + i, BENCH_EVT_LEN);
+        }
+        run();
+        TEST_ASSERT_EQUAL(burst, m_rx_evt_cnt);
+    }
+
+    return (uint32_t)(BENCH_EVT_COUNT * (uint64_t)UART_BAUDRATE / (m_line_bits - line_bits));
+}
+
+
+/* Event rate over a UART at SER_PHY_UART_BAUDRATE_VAL. Events that arrive one at a time go out
+ * in separate packets, each waiting for its acknowledgement; a burst shares the framing and the
+ * acknowledgement of a batch. */
+static void evt_rate_uart(void)
+{
+    uint32_t const single  = evt_rate_measure(1);
+    uint32_t const batched = evt_rate_measure(SER_EVT_BATCH_MAX_EVENTS);
+    uint32_t const burst   = evt_rate_measure(SCHED_QUEUE_SIZE);
+
+    printf("    %u baud, %u-byte events: %u evt/s single, %u evt/s batched, %u evt/s burst of %u\n",
+           (unsigned)UART_BAUDRATE, BENCH_EVT_LEN,
+           (unsigned)single, (unsigned)batched, (unsigned)burst, SCHED_QUEUE_SIZE);
+
+    // A full batch saves the framing and the acknowledgement of all but one event.
+    TEST_ASSERT(batched * 4 > single * 5);
+    // A longer burst is split into full batches.
+    TEST_ASSERT_EQUAL(batched, burst);
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(9, SER_PKT_TYPE_EVT_BATCH);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_open(ble_evt_handler,
+                                                         NULL,
+                                                         os_rsp_wait_handler,
+                                                         NULL,
+                                                         NULL));
+
+    host_test_run("events_batched", events_batched);
+    host_test_run("batch_max_events", batch_max_events);
+    host_test_run("single_event", single_event);
+    host_test_run("large_events", large_events);
+    host_test_run("evt_rate_uart", evt_rate_uart);
+    return 0;
+}
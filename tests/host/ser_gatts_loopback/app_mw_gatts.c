@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Application side GATTS middleware, built with its SoftDevice API functions renamed so
+ *        that the Connectivity middleware in the same program can call the SoftDevice stubs.
+ */
+#define _sd_ble_gatts_sys_attr_set              app_sd_ble_gatts_sys_attr_set
+#define _sd_ble_gatts_hvx                       app_sd_ble_gatts_hvx
+#define _sd_ble_gatts_service_add               app_sd_ble_gatts_service_add
+#define _sd_ble_gatts_service_changed           app_sd_ble_gatts_service_changed
+#define _sd_ble_gatts_include_add               app_sd_ble_gatts_include_add
+#define _sd_ble_gatts_characteristic_add        app_sd_ble_gatts_characteristic_add
+#define _sd_ble_gatts_descriptor_add            app_sd_ble_gatts_descriptor_add
+#define _sd_ble_gatts_rw_authorize_reply        app_sd_ble_gatts_rw_authorize_reply
+#define _sd_ble_gatts_value_get                 app_sd_ble_gatts_value_get
+#define _sd_ble_gatts_value_set                 app_sd_ble_gatts_value_set
+#define _sd_ble_gatts_sys_attr_get              app_sd_ble_gatts_sys_attr_get
+#define _sd_ble_gatts_attr_get                  app_sd_ble_gatts_attr_get
+#define _sd_ble_gatts_initial_user_handle_get   app_sd_ble_gatts_initial_user_handle_get
+#define _sd_ble_gatts_exchange_mtu_reply        app_sd_ble_gatts_exchange_mtu_reply
+
+#include "../../../components/serialization/application/codecs/ble/middleware/app_mw_ble_gatts.c"
@@ -0,0 +1,514 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Loopback test of the application side GATTS middleware and SoftDevice transport against
+ *        the Connectivity command decoder and GATTS middleware, with stubs in place of the
+ *        SoftDevice. Checks that the output parameters of blocking and pipelined
+ *        sd_ble_gatts_value_set() and sd_ble_gatts_hvx() calls are written to the caller's
+ *        structures, and measures the calls per second of both modes.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "app_util.h"
+#include "ble_gatts.h"
+#include "ble_serialization.h"
+#include "ser_config.h"
+#include "ser_hal_transport.h"
+#include "ser_sd_transport.h"
+#include "ser_app_power_system_off.h"
+#include "ser_conn_cmd_decoder.h"
+#include "ser_conn_handlers.h"
+#include "conn_mw.h"
+#include "conn_mw_ble_gatts.h"
+
+#define CMD_QUEUE_SIZE  (SER_SD_TRANSPORT_PIPELINE_DEPTH + 1) /**< Commands in flight to the Connectivity Chip. */
+#define CONN_HANDLE     0x0010
+#define ATTR_LEN_MAX    20                                    /**< Size of each attribute in the stub. */
+#define BENCH_CALLS     200000
+
+/* Application side SoftDevice API, renamed in app_mw_gatts.c. */
+uint32_t app_sd_ble_gatts_value_set(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value);
+uint32_t app_sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * const p_hvx_params);
+
+/**@brief Command packet sent by the application and not yet processed by the Connectivity Chip. */
+typedef struct
+{
+    uint8_t  data[SER_HAL_TRANSPORT_APP_TO_CONN_MAX_PKT_SIZE];
+    uint16_t len;
+} cmd_pkt_t;
+
+static ser_hal_transport_events_handler_t m_hal_handler;
+
+static uint8_t   m_app_tx_buf[SER_HAL_TRANSPORT_APP_TO_CONN_MAX_PKT_SIZE];
+static uint8_t   m_conn_tx_buf[SER_HAL_TRANSPORT_CONN_TO_APP_MAX_PKT_SIZE];
+static bool      m_conn_context;    /**< The Connectivity Chip is processing a command. */
+static cmd_pkt_t m_cmd_queue[CMD_QUEUE_SIZE];
+static uint32_t  m_cmd_head;
+static uint32_t  m_cmd_tail;
+static bool      m_rx_buf_used;
+
+static uint8_t   m_attr_val[256][ATTR_LEN_MAX]; /**< Attribute values of the SoftDevice stub. */
+static uint32_t  m_sd_calls;
+
+
+/* Fake HAL transport shared by both chips. Commands wait in a queue until the application waits
+ * for a response; the Connectivity Chip then processes them and its responses go straight to the
+ * application transport. */
+
+uint32_t ser_hal_transport_open(ser_hal_transport_events_handler_t events_handler)
+{
+    m_hal_handler = events_handler;
+    return NRF_SUCCESS;
+}
+
+
+void ser_hal_transport_close(void)
+{
+    m_hal_handler = NULL;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_alloc(uint8_t ** pp_memory, uint16_t * p_num_of_bytes)
+{
+    if (m_conn_context)
+    {
+        *pp_memory      = m_conn_tx_buf;
+        *p_num_of_bytes = sizeof(m_conn_tx_buf);
+    }
+    else
+    {
+        *pp_memory      = m_app_tx_buf;
+        *p_num_of_bytes = sizeof(m_app_tx_buf);
+    }
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_free(uint8_t * p_buffer)
+{
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of_bytes)
+{
+    if (p_buffer == m_app_tx_buf)
+    {
+        TEST_ASSERT_EQUAL(SER_PKT_TYPE_CMD, p_buffer[SER_PKT_TYPE_POS]);
+        TEST_ASSERT(m_cmd_head - m_cmd_tail < CMD_QUEUE_SIZE);
+
+        cmd_pkt_t * p_cmd = &m_cmd_queue[m_cmd_head++ % CMD_QUEUE_SIZE];
+
+        memcpy(p_cmd->data, p_buffer, num_of_bytes);
+        p_cmd->len = num_of_bytes;
+        return NRF_SUCCESS;
+    }
+
+    TEST_ASSERT(p_buffer == m_conn_tx_buf);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_RESP, p_buffer[SER_PKT_TYPE_POS]);
+    TEST_ASSERT(!m_rx_buf_used);
+
+    m_rx_buf_used = true;
+
+    ser_hal_transport_evt_t evt =
+    {
+        .evt_type = SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED,
+        .evt_params.rx_pkt_received =
+        {
+            .p_buffer     = m_conn_tx_buf,
+            .num_of_bytes = num_of_bytes,
+        },
+    };
+    m_hal_handler(evt);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer)
+{
+    TEST_ASSERT(p_buffer == m_conn_tx_buf);
+    TEST_ASSERT(m_rx_buf_used);
+    m_rx_buf_used = false;
+    return NRF_SUCCESS;
+}
+
+
+bool ser_app_power_system_off_get(void)
+{
+    return false;
+}
+
+
+void ser_app_power_system_off_enter(void)
+{
+}
+
+
+void ser_conn_on_no_mem_handler(void)
+{
+    TEST_ASSERT(false);
+}
+
+
+/* Connectivity dispatcher for the commands under test. */
+uint32_t conn_mw_handler(uint8_t const * const p_rx_buf,
+                         uint32_t              rx_buf_len,
+                         uint8_t * const       p_tx_buf,
+                         uint32_t * const      p_tx_buf_len)
+{
+    switch (p_rx_buf[SER_CMD_OP_CODE_POS])
+    {
+        case SD_BLE_GATTS_VALUE_SET:
+            return conn_mw_ble_gatts_value_set(p_rx_buf, rx_buf_len, p_tx_buf, p_tx_buf_len);
+
+        case SD_BLE_GATTS_HVX:
+            return conn_mw_ble_gatts_hvx(p_rx_buf, rx_buf_len, p_tx_buf, p_tx_buf_len);
+
+        default:
+            return NRF_ERROR_NOT_SUPPORTED;
+    }
+}
+
+
+/* SoftDevice stubs of the Connectivity Chip. */
+
+/* Attribute N holds N % ATTR_LEN_MAX + 1 bytes; longer writes are truncated. */
+uint32_t sd_ble_gatts_value_set(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value)
+{
+    uint16_t const attr_len = (handle % ATTR_LEN_MAX) + 1;
+
+    m_sd_calls++;
+    if ((conn_handle != CONN_HANDLE) || (p_value->offset >= attr_len))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    p_value->len = MIN(p_value->len, attr_len - p_value->offset);
+    memcpy(&m_attr_val[handle & 0xFF][p_value->offset], p_value->p_value, p_value->len);
+    return NRF_SUCCESS;
+}
+
+
+/* Notifications of attribute N send at most N % ATTR_LEN_MAX + 1 bytes. */
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params)
+{
+    m_sd_calls++;
+    if (conn_handle != CONN_HANDLE)
+    {
+        return BLE_ERROR_INVALID_CONN_HANDLE;
+    }
+
+    *p_hvx_params->p_len = MIN(*p_hvx_params->p_len, (p_hvx_params->handle % ATTR_LEN_MAX) + 1);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_include_add(uint16_t service_handle, uint16_t inc_srvc_handle, uint16_t * p_include_handle)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_characteristic_add(uint16_t                   service_handle,
+                                         ble_gatts_char_md_t const * p_char_md,
+                                         ble_gatts_attr_t const *    p_attr_char_value,
+                                         ble_gatts_char_handles_t *  p_handles)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_descriptor_add(uint16_t char_handle, ble_gatts_attr_t const * p_attr, uint16_t * p_handle)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_value_get(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_service_changed(uint16_t conn_handle, uint16_t start_handle, uint16_t end_handle)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_rw_authorize_reply(uint16_t                                      conn_handle,
+                                         ble_gatts_rw_authorize_reply_params_t const * p_params)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_sys_attr_set(uint16_t conn_handle, uint8_t const * p_sys_attr_data, uint16_t len, uint32_t flags)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_sys_attr_get(uint16_t conn_handle, uint8_t * p_sys_attr_data, uint16_t * p_len, uint32_t flags)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_initial_user_handle_get(uint16_t * p_handle)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_attr_get(uint16_t handle, ble_uuid_t * p_uuid, ble_gatts_attr_md_t * p_md)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+uint32_t sd_ble_gatts_exchange_mtu_reply(uint16_t conn_handle, uint16_t server_rx_mtu)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+static void ble_evt_handler(uint8_t * p_buffer, uint16_t length)
+{
+    TEST_ASSERT(false);
+}
+
+
+/* The application waits for responses until the Connectivity Chip has processed every command. */
+static void os_rsp_wait_handler(void)
+{
+    while (m_cmd_tail != m_cmd_head)
+    {
+        cmd_pkt_t * p_cmd = &m_cmd_queue[m_cmd_tail++ % CMD_QUEUE_SIZE];
+
+        m_conn_context = true;
+        TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                          ser_conn_command_process(&p_cmd->data[SER_PKT_OP_CODE_POS],
+                                                   p_cmd->len - SER_PKT_TYPE_SIZE));
+        m_conn_context = false;
+    }
+}
+
+
+static void os_rsp_set_handler(void)
+{
+}
+
+
+/**@brief Function for calling sd_ble_gatts_value_set() on the application side.
+ *
+ * @param[in]  handle   Attribute handle.
+ * @param[out] p_value  Value structure, also passed to the call.
+ * @param[out] p_data   Buffer for the value.
+ * @param[in]  len      Length of the value.
+ */
+static uint32_t value_set(uint16_t handle, ble_gatts_value_t * p_value, uint8_t * p_data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        p_data[i] = (uint8_t)(handle + i);
+    }
+    p_value->len     = len;
+    p_value->offset  = 0;
+    p_value->p_value = p_data;
+    return app_sd_ble_gatts_value_set(CONN_HANDLE, handle, p_value);
+}
+
+
+/**@brief Function for calling sd_ble_gatts_hvx() on the application side.
+ *
+ * @param[in]  handle   Attribute handle.
+ * @param[out] p_len    Length of the notification, updated by the call.
+ * @param[in]  p_data   Notification data.
+ */
+static uint32_t hvx(uint16_t handle, uint16_t * p_len, uint8_t const * p_data)
+{
+    ble_gatts_hvx_params_t const params =
+    {
+        .handle = handle,
+        .type   = BLE_GATT_HVX_NOTIFICATION,
+        .p_len  = p_len,
+        .p_data = p_data,
+    };
+
+    *p_len = ATTR_LEN_MAX;
+    return app_sd_ble_gatts_hvx(CONN_HANDLE, &params);
+}
+
+
+/* Blocking calls get the length written by the SoftDevice back in their own structures. */
+static void blocking_out_params(void)
+{
+    ble_gatts_value_t value;
+    uint8_t           data[ATTR_LEN_MAX];
+    uint16_t          len;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, value_set(3, &value, data, ATTR_LEN_MAX));
+    TEST_ASSERT_EQUAL(4, value.len);
+    TEST_ASSERT(value.p_value == data);
+    TEST_ASSERT_EQUAL(0, memcmp(data, m_attr_val[3], 4));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, hvx(7, &len, data));
+    TEST_ASSERT_EQUAL(8, len);
+
+    value.offset = ATTR_LEN_MAX;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, app_sd_ble_gatts_value_set(CONN_HANDLE, 3, &value));
+    TEST_ASSERT_EQUAL(BLE_ERROR_INVALID_CONN_HANDLE,
+                      app_sd_ble_gatts_hvx(CONN_HANDLE + 1,
+                                           &(ble_gatts_hvx_params_t){.handle = 7, .p_len = &len, .p_data = data}));
+    TEST_ASSERT(!ser_sd_transport_is_busy());
+}
+
+
+/* Every pipelined call gets its own output parameters written when its response is decoded,
+ * although the middleware has registered the pointers of later calls since. */
+static void pipelined_out_params(void)
+{
+    ble_gatts_value_t values[SER_SD_TRANSPORT_PIPELINE_DEPTH];
+    uint8_t           data[SER_SD_TRANSPORT_PIPELINE_DEPTH][ATTR_LEN_MAX];
+    uint16_t          lens[SER_SD_TRANSPORT_PIPELINE_DEPTH];
+
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        uint32_t const sd_calls = m_sd_calls;
+
+        ser_sd_transport_pipeline_begin();
+        for (uint16_t i = 0; i < SER_SD_TRANSPORT_PIPELINE_DEPTH; i++)
+        {
+            uint16_t const handle = (uint16_t)(round * 5 + i * 2);
+
+            // Alternate the two calls so that each response is decoded with the other's pointers
+            // registered last.
+            if ((i + round) % 2 == 0)
+            {
+                TEST_ASSERT_EQUAL(NRF_SUCCESS, value_set(handle, &values[i], data[i], ATTR_LEN_MAX));
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL(NRF_SUCCESS, hvx(handle, &lens[i], data[i]));
+            }
+        }
+        TEST_ASSERT_EQUAL(sd_calls, m_sd_calls);
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_pipeline_end());
+        TEST_ASSERT_EQUAL(sd_calls + SER_SD_TRANSPORT_PIPELINE_DEPTH, m_sd_calls);
+
+        for (uint16_t i = 0; i < SER_SD_TRANSPORT_PIPELINE_DEPTH; i++)
+        {
+            uint16_t const handle   = (uint16_t)(round * 5 + i * 2);
+            uint16_t const expected = (handle % ATTR_LEN_MAX) + 1;
+
+            if ((i + round) % 2 == 0)
+            {
+                TEST_ASSERT_EQUAL(expected, values[i].len);
+                TEST_ASSERT(values[i].p_value == data[i]);
+                TEST_ASSERT_EQUAL(0, memcmp(data[i], m_attr_val[handle], expected));
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL(expected, lens[i]);
+            }
+        }
+    }
+
+    // A blocking call after the pipeline uses its own pointers again.
+    uint16_t len;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, hvx(2, &len, data[0]));
+    TEST_ASSERT_EQUAL(3, len);
+}
+
+
+/* Calls per second through both chips, with and without waiting for each response. */
+static void calls_per_second(void)
+{
+    uint8_t           data[ATTR_LEN_MAX];
+    uint16_t          lens[SER_SD_TRANSPORT_PIPELINE_DEPTH];
+
+    uint64_t start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCH_CALLS; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, hvx(1, &lens[0], data));
+    }
+    uint64_t const blocking_ns = host_test_time_ns() - start;
+
+    start = host_test_time_ns();
+    for (uint32_t i = 0; i < BENCH_CALLS; i += SER_SD_TRANSPORT_PIPELINE_DEPTH)
+    {
+        ser_sd_transport_pipeline_begin();
+        for (uint32_t j = 0; j < SER_SD_TRANSPORT_PIPELINE_DEPTH; j++)
+        {
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, hvx(1, &lens[j], data));
+        }
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_pipeline_end());
+    }
+    uint64_t const pipelined_ns = host_test_time_ns() - start;
+
+    TEST_ASSERT_EQUAL(2, lens[SER_SD_TRANSPORT_PIPELINE_DEPTH - 1]);
+    printf("    blocking hvx: %u calls/s\n",
+           (unsigned)(BENCH_CALLS * 1000000000ULL / blocking_ns));
+    printf("    pipelined hvx: %u calls/s\n",
+           (unsigned)(BENCH_CALLS * 1000000000ULL / pipelined_ns));
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_open(ble_evt_handler,
+                                                         NULL,
+                                                         os_rsp_wait_handler,
+                                                         os_rsp_set_handler,
+                                                         NULL));
+
+    host_test_run("blocking_out_params", blocking_out_params);
+    host_test_run("pipelined_out_params", pipelined_out_params);
+    host_test_run("calls_per_second", calls_per_second);
+    return 0;
+}
@@ -0,0 +1,505 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the socket HCI SLIP PHY against a peer on the other end of the socket: SLIP
+ *        framing in both directions, line rate pacing, flow control when either side stops
+ *        reading, and seeded loss injection.
+ *
+ * The test covers the PHY only. The HCI layer above it (ser_phy_hci.c), which retransmits
+ * dropped frames, needs app_timer and the SoftDevice handler, and a run of the application and
+ * connectivity sides as two processes is not part of the host tests.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "ser_config.h"
+#include "ser_phy_hci.h"
+#include "ser_phy_hci_slip_socket.h"
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define SLIP_END        0xC0
+#define SLIP_ESC        0xDB
+#define SLIP_ESC_END    0xDC
+#define SLIP_ESC_ESC    0xDD
+
+#define HDR_SIZE        4                               /**< HCI packet header size. */
+#define PAYLOAD_SIZE    SER_HAL_TRANSPORT_MAX_PKT_SIZE  /**< Largest payload. */
+#define FRAME_MAX       (2 * (HDR_SIZE + PAYLOAD_SIZE) + 2)
+#define TIMEOUT_S       20                              /**< A hang fails the test after this time. */
+#define LOSS_FRAMES     200                             /**< Frames sent per loss injection run. */
+#define LOSS_PPM        200000                          /**< Loss probability of the lossy runs, 20%. */
+#define LOSS_SEED       0x2545F491                      /**< Fixed seed, so that a failure can be replayed. */
+
+static int      m_listen_fd = -1;
+static int      m_peer_fd   = -1;
+
+static uint32_t m_sent_cnt;                 /**< SER_PHY_HCI_SLIP_EVT_PKT_SENT events. */
+static uint32_t m_hw_error_cnt;
+static uint8_t  m_rx_pkt[HDR_SIZE + PAYLOAD_SIZE];
+static uint16_t m_rx_len;
+static uint8_t *mp_rx_buf;                  /**< RX buffer not yet freed. */
+static uint32_t m_rx_cnt;
+
+/* Peer receive state. */
+static uint8_t  m_peer_frame[HDR_SIZE + PAYLOAD_SIZE];
+static uint32_t m_peer_frame_len;
+static bool     m_peer_escape;
+
+
+static void slip_evt_handler(ser_phy_hci_slip_evt_t * p_event)
+{
+    switch (p_event->evt_type)
+    {
+        case SER_PHY_HCI_SLIP_EVT_PKT_SENT:
+            m_sent_cnt++;
+            break;
+
+        case SER_PHY_HCI_SLIP_EVT_PKT_RECEIVED:
+            TEST_ASSERT(mp_rx_buf == NULL);
+            mp_rx_buf = p_event->evt_params.received_pkt.p_buffer;
+            m_rx_len  = p_event->evt_params.received_pkt.num_of_bytes;
+            memcpy(m_rx_pkt, mp_rx_buf, m_rx_len);
+            m_rx_cnt++;
+            break;
+
+        case SER_PHY_HCI_SLIP_EVT_HW_ERROR:
+            m_hw_error_cnt++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+static void rx_free(void)
+{
+    TEST_ASSERT(mp_rx_buf != NULL);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_phy_hci_slip_rx_buf_free(mp_rx_buf));
+    mp_rx_buf = NULL;
+}
+
+
+/**@brief Function for filling a packet with a pattern that contains the SLIP special bytes. */
+static void pkt_fill(uint8_t * p_pkt, uint32_t len, uint32_t seq)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        static uint8_t const pattern[] = {SLIP_END, SLIP_ESC, 0x00, 0x55};
+        p_pkt[i] = (i % 5 == 0) ? pattern[(i / 5 + seq) % sizeof(pattern)] : (uint8_t)(seq + i);
+    }
+}
+
+
+static uint32_t pkt_send(uint32_t seq, uint16_t payload_len)
+{
+    static uint8_t           hdr[HDR_SIZE];
+    static uint8_t           payload[PAYLOAD_SIZE];
+    ser_phy_hci_pkt_params_t header_params  = {.p_buffer = hdr,     .num_of_bytes = HDR_SIZE};
+    ser_phy_hci_pkt_params_t payload_params = {.p_buffer = payload, .num_of_bytes = payload_len};
+
+    pkt_fill(hdr, HDR_SIZE, seq);
+    pkt_fill(payload, payload_len, seq + 1);
+    return ser_phy_hci_slip_tx_pkt_send(&header_params, &payload_params, NULL);
+}
+
+
+static bool pkt_check(uint8_t const * p_pkt, uint32_t len, uint32_t seq, uint16_t payload_len)
+{
+    uint8_t expected[HDR_SIZE + PAYLOAD_SIZE];
+
+    if (len != HDR_SIZE + payload_len)
+    {
+        return false;
+    }
+    pkt_fill(expected, HDR_SIZE, seq);
+    pkt_fill(&expected[HDR_SIZE], payload_len, seq + 1);
+    return memcmp(expected, p_pkt, len) == 0;
+}
+
+
+/**@brief Function for sending a SLIP frame from the peer. */
+static void peer_frame_write(uint8_t const * p_pkt, uint32_t len)
+{
+    uint8_t  frame[FRAME_MAX];
+    uint32_t idx = 0;
+
+    frame[idx++] = SLIP_END;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (p_pkt[i] == SLIP_END)
+        {
+            frame[idx++] = SLIP_ESC;
+            frame[idx++] = SLIP_ESC_END;
+        }
+        else if (p_pkt[i] == SLIP_ESC)
+        {
+            frame[idx++] = SLIP_ESC;
+            frame[idx++] = SLIP_ESC_ESC;
+        }
+        else
+        {
+            frame[idx++] = p_pkt[i];
+        }
+    }
+    frame[idx++] = SLIP_END;
+
+    TEST_ASSERT_EQUAL(idx, write(m_peer_fd, frame, idx));
+}
+
+
+/**@brief Function for sending a packet filled like by pkt_send() from the peer. */
+static void peer_pkt_write(uint32_t seq, uint16_t payload_len)
+{
+    uint8_t pkt[HDR_SIZE + PAYLOAD_SIZE];
+
+    pkt_fill(pkt, HDR_SIZE, seq);
+    pkt_fill(&pkt[HDR_SIZE], payload_len, seq + 1);
+    peer_frame_write(pkt, HDR_SIZE + payload_len);
+}
+
+
+/**@brief Function for reading one SLIP frame on the peer side.
+ *
+ * @param[in] wait Whether to block until a frame is complete.
+ *
+ * @return Whether a frame was read into m_peer_frame.
+ */
+static bool peer_frame_read(bool wait)
+{
+    uint8_t byte;
+
+    for (;;)
+    {
+        ssize_t received = recv(m_peer_fd, &byte, 1, wait ? 0 : MSG_DONTWAIT);
+
+        if (received != 1)
+        {
+            TEST_ASSERT(!wait);
+            TEST_ASSERT((received < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)));
+            return false;
+        }
+
+        if (byte == SLIP_END)
+        {
+            if (m_peer_frame_len > 0)
+            {
+                return true;
+            }
+            continue;
+        }
+
+        if (m_peer_escape)
+        {
+            m_peer_escape = false;
+            TEST_ASSERT((byte == SLIP_ESC_END) || (byte == SLIP_ESC_ESC));
+            byte = (byte == SLIP_ESC_END) ? SLIP_END : SLIP_ESC;
+        }
+        else if (byte == SLIP_ESC)
+        {
+            m_peer_escape = true;
+            continue;
+        }
+
+        TEST_ASSERT(m_peer_frame_len < sizeof(m_peer_frame));
+        m_peer_frame[m_peer_frame_len++] = byte;
+    }
+}
+
+
+static void process_until_sent(uint32_t sent_cnt)
+{
+    while (m_sent_cnt < sent_cnt)
+    {
+        (void)ser_phy_hci_slip_socket_process();
+    }
+}
+
+
+static void link_open(uint32_t baudrate, uint32_t loss_ppm, uint32_t seed)
+{
+    struct sockaddr_un               addr   = {.sun_family = AF_UNIX};
+    ser_phy_hci_slip_socket_config_t config = {.baudrate = baudrate,
+                                               .loss_ppm = loss_ppm,
+                                               .seed     = seed};
+
+    strcpy(addr.sun_path, SER_PHY_SOCKET_PATH);
+    (void)unlink(SER_PHY_SOCKET_PATH);
+    m_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    TEST_ASSERT(m_listen_fd >= 0);
+    TEST_ASSERT_EQUAL(0, bind(m_listen_fd, (struct sockaddr *)&addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL(0, listen(m_listen_fd, 1));
+
+    ser_phy_hci_slip_socket_config_set(&config);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_phy_hci_slip_open(slip_evt_handler));
+    m_peer_fd = accept(m_listen_fd, NULL, NULL);
+    TEST_ASSERT(m_peer_fd >= 0);
+
+    m_sent_cnt       = 0;
+    m_hw_error_cnt   = 0;
+    m_rx_cnt         = 0;
+    m_peer_frame_len = 0;
+    m_peer_escape    = false;
+}
+
+
+static void link_close(void)
+{
+    ser_phy_hci_slip_close();
+    (void)close(m_peer_fd);
+    (void)close(m_listen_fd);
+    (void)unlink(SER_PHY_SOCKET_PATH);
+    TEST_ASSERT_EQUAL(0, m_hw_error_cnt);
+}
+
+
+/* Packets with SLIP special bytes arrive intact in both directions. */
+static void round_trip(void)
+{
+    link_open(0, 0, 1);
+    for (uint32_t seq = 0; seq < 20; seq++)
+    {
+        uint16_t len = (uint16_t)(1 + seq * 25);
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, pkt_send(seq, len));
+        process_until_sent(seq + 1);
+        TEST_ASSERT(peer_frame_read(true));
+        TEST_ASSERT(pkt_check(m_peer_frame, m_peer_frame_len, seq, len));
+        m_peer_frame_len = 0;
+
+        peer_pkt_write(seq + 100, len);
+        while (m_rx_cnt == seq)
+        {
+            (void)ser_phy_hci_slip_socket_process();
+        }
+        TEST_ASSERT(pkt_check(m_rx_pkt, m_rx_len, seq + 100, len));
+        rx_free();
+    }
+    link_close();
+}
+
+
+/* A frame is not reported as sent before its time on the emulated line has passed. */
+static void line_pacing(void)
+{
+    uint32_t const baudrate = 100000;
+    uint16_t const len      = 200;
+    uint64_t       start;
+    uint64_t       elapsed;
+
+    link_open(baudrate, 0, 1);
+    start = host_test_time_ns();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, pkt_send(0, len));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, pkt_send(1, len));
+    process_until_sent(2);
+    elapsed = host_test_time_ns() - start;
+
+    // At least the unescaped bytes of both frames, 10 bits each.
+    TEST_ASSERT(elapsed >= 2ULL * (HDR_SIZE + len + 2) * 10 * 1000000000ULL / baudrate);
+    TEST_ASSERT(peer_frame_read(true));
+    TEST_ASSERT(pkt_check(m_peer_frame, m_peer_frame_len, 0, len));
+    link_close();
+}
+
+
+/* While the peer does not read, transmission stalls without blocking: frames received in the
+ * meantime are still delivered, and once the peer reads again every frame arrives intact. */
+static void tx_backpressure(void)
+{
+    uint32_t sent = 0;
+    uint32_t idle = 0;
+
+    link_open(0, 0, 1);
+
+    // Send until the socket is full and the module stops reporting sent frames.
+    while (idle < 1000)
+    {
+        if (m_sent_cnt == sent)
+        {
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, pkt_send(sent, PAYLOAD_SIZE));
+            sent++;
+        }
+        idle = ser_phy_hci_slip_socket_process() ? 0 : idle + 1;
+    }
+    TEST_ASSERT(sent > 1);
+    TEST_ASSERT_EQUAL(sent - 1, m_sent_cnt);
+
+    // Reception goes on while transmission is stalled.
+    peer_pkt_write(1000, 16);
+    while (m_rx_cnt == 0)
+    {
+        (void)ser_phy_hci_slip_socket_process();
+    }
+    TEST_ASSERT(pkt_check(m_rx_pkt, m_rx_len, 1000, 16));
+    rx_free();
+    TEST_ASSERT_EQUAL(sent - 1, m_sent_cnt);
+
+    // The peer reads again. Every frame arrives once, in order.
+    for (uint32_t seq = 0; seq < sent; seq++)
+    {
+        while (!peer_frame_read(false))
+        {
+            (void)ser_phy_hci_slip_socket_process();
+        }
+        TEST_ASSERT(pkt_check(m_peer_frame, m_peer_frame_len, seq, PAYLOAD_SIZE));
+        m_peer_frame_len = 0;
+    }
+    process_until_sent(sent);
+    TEST_ASSERT(!peer_frame_read(false));
+    link_close();
+}
+
+
+/* While no RX buffer is free, reception stalls and no frame is lost. */
+static void rx_stall(void)
+{
+    ser_phy_hci_slip_socket_stats_t stats;
+
+    link_open(0, 0, 1);
+    for (uint32_t seq = 0; seq < 3; seq++)
+    {
+        peer_pkt_write(seq, 32);
+    }
+
+    for (uint32_t seq = 0; seq < 3; seq++)
+    {
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            (void)ser_phy_hci_slip_socket_process();
+        }
+        TEST_ASSERT_EQUAL(seq + 1, m_rx_cnt);
+        TEST_ASSERT(pkt_check(m_rx_pkt, m_rx_len, seq, 32));
+        rx_free();
+    }
+
+    ser_phy_hci_slip_socket_stats_get(&stats);
+    TEST_ASSERT_EQUAL(3, stats.rx_frames);
+    TEST_ASSERT_EQUAL(0, stats.rx_dropped);
+    link_close();
+}
+
+
+/**@brief Function for sending frames over a lossy link and recording which ones arrive.
+ *
+ * @param[in]  loss_ppm   Loss probability.
+ * @param[in]  seed       Loss injection seed.
+ * @param[out] p_received Per frame: whether the peer received it.
+ *
+ * @return Number of frames dropped.
+ */
+static uint32_t loss_run(uint32_t loss_ppm, uint32_t seed, bool * p_received)
+{
+    ser_phy_hci_slip_socket_stats_t stats;
+    uint32_t                        seq      = 0;
+    uint32_t                        received = 0;
+
+    link_open(0, loss_ppm, seed);
+    for (uint32_t i = 0; i < LOSS_FRAMES; i++)
+    {
+        // Dropped frames are still reported as sent; the HCI layer retransmits them.
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, pkt_send(i, 16));
+        process_until_sent(i + 1);
+    }
+
+    memset(p_received, 0, LOSS_FRAMES * sizeof(p_received[0]));
+    while (peer_frame_read(false))
+    {
+        // Frames arrive in order, with the dropped ones missing.
+        while (!pkt_check(m_peer_frame, m_peer_frame_len, seq, 16))
+        {
+            seq++;
+            TEST_ASSERT(seq < LOSS_FRAMES);
+        }
+        p_received[seq++] = true;
+        received++;
+        m_peer_frame_len = 0;
+    }
+
+    ser_phy_hci_slip_socket_stats_get(&stats);
+    TEST_ASSERT_EQUAL(LOSS_FRAMES, stats.tx_frames);
+    TEST_ASSERT_EQUAL(LOSS_FRAMES - received, stats.tx_dropped);
+    link_close();
+
+    return stats.tx_dropped;
+}
+
+
+/* Outgoing frames are dropped with the configured probability, and the same seed drops the same
+ * frames again. */
+static void loss_injection(void)
+{
+    static bool received[LOSS_FRAMES];
+    static bool replay[LOSS_FRAMES];
+    uint32_t    dropped;
+
+    TEST_ASSERT_EQUAL(0, loss_run(0, LOSS_SEED, received));
+    TEST_ASSERT_EQUAL(LOSS_FRAMES, loss_run(1000000, LOSS_SEED, received));
+
+    dropped = loss_run(LOSS_PPM, LOSS_SEED, received);
+    printf("    %u of %u frames dropped at %u ppm\n",
+           (unsigned)dropped, LOSS_FRAMES, LOSS_PPM);
+    TEST_ASSERT((dropped > LOSS_FRAMES / 10) && (dropped < 3 * LOSS_FRAMES / 10));
+
+    // Replay with the same seed.
+    TEST_ASSERT_EQUAL(dropped, loss_run(LOSS_PPM, LOSS_SEED, replay));
+    TEST_ASSERT(memcmp(received, replay, sizeof(received)) == 0);
+
+    // Another seed drops other frames.
+    (void)loss_run(LOSS_PPM, LOSS_SEED + 1, replay);
+    TEST_ASSERT(memcmp(received, replay, sizeof(received)) != 0);
+}
+
+
+int main(void)
+{
+    (void)alarm(TIMEOUT_S);
+
+    host_test_run("round_trip", round_trip);
+    host_test_run("line_pacing", line_pacing);
+    host_test_run("tx_backpressure", tx_backpressure);
+    host_test_run("rx_stall", rx_stall);
+    host_test_run("loss_injection", loss_injection);
+    return 0;
+}
@@ -0,0 +1,353 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the pipelined command mode of the application side SoftDevice transport
+ *        against a fake HAL transport that plays the Connectivity Chip.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "nrf_error.h"
+#include "app_util.h"
+#include "ble_serialization.h"
+#include "ser_hal_transport.h"
+#include "ser_sd_transport.h"
+#include "ser_app_power_system_off.h"
+
+#define CMD_COUNT_MAX   32      /**< Number of commands the fake Connectivity Chip can queue. */
+#define RSP_SIZE        (SER_PKT_TYPE_SIZE + SER_CMD_RSP_HEADER_SIZE + 1) /**< Response with one byte of output. */
+
+/**@brief Command received by the fake Connectivity Chip, and the response it sends. */
+typedef struct
+{
+    uint8_t  op_code;
+    uint32_t status;    /**< Return code in the response. */
+    uint8_t  output;    /**< Output parameter in the response. */
+} peer_cmd_t;
+
+/**@brief Response decoded by a decoder handler. */
+typedef struct
+{
+    uint8_t op_code;
+    uint8_t output;
+} decoded_t;
+
+static ser_hal_transport_events_handler_t m_hal_handler;
+
+static uint8_t    m_tx_buf[SER_HAL_TRANSPORT_TX_MAX_PKT_SIZE];
+static bool       m_tx_buf_used;
+static peer_cmd_t m_peer_cmds[CMD_COUNT_MAX];   /**< Commands received by the fake Connectivity Chip. */
+static uint32_t   m_peer_sent;                  /**< Number of commands received. */
+static uint32_t   m_peer_answered;              /**< Number of commands answered. */
+static uint32_t   m_peer_status[CMD_COUNT_MAX]; /**< Return code to answer each command with. */
+
+static uint8_t    m_rx_buf[RSP_SIZE];
+static bool       m_rx_buf_used;
+
+static decoded_t  m_decoded[CMD_COUNT_MAX];     /**< Responses decoded, in order. */
+static uint32_t   m_decoded_cnt;
+
+
+/* Fake HAL transport. There is one TX and one RX buffer, as with the real transports. */
+
+uint32_t ser_hal_transport_open(ser_hal_transport_events_handler_t events_handler)
+{
+    m_hal_handler = events_handler;
+    return NRF_SUCCESS;
+}
+
+
+void ser_hal_transport_close(void)
+{
+    m_hal_handler = NULL;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_alloc(uint8_t ** pp_memory, uint16_t * p_num_of_bytes)
+{
+    TEST_ASSERT(!m_tx_buf_used);
+    m_tx_buf_used   = true;
+    *pp_memory      = m_tx_buf;
+    *p_num_of_bytes = sizeof(m_tx_buf);
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_free(uint8_t * p_buffer)
+{
+    TEST_ASSERT(p_buffer == m_tx_buf);
+    m_tx_buf_used = false;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_tx_pkt_send(const uint8_t * p_buffer, uint16_t num_of_bytes)
+{
+    TEST_ASSERT(p_buffer == m_tx_buf);
+    TEST_ASSERT(num_of_bytes >= SER_PKT_TYPE_SIZE + SER_OP_CODE_SIZE);
+    TEST_ASSERT_EQUAL(SER_PKT_TYPE_CMD, p_buffer[SER_PKT_TYPE_POS]);
+    TEST_ASSERT(m_peer_sent < CMD_COUNT_MAX);
+
+    m_peer_cmds[m_peer_sent].op_code = p_buffer[SER_PKT_OP_CODE_POS];
+    m_peer_cmds[m_peer_sent].status  = m_peer_status[m_peer_sent];
+    m_peer_cmds[m_peer_sent].output  = (uint8_t)(0xA0 + m_peer_sent);
+    m_peer_sent++;
+    m_tx_buf_used = false;
+    return NRF_SUCCESS;
+}
+
+
+uint32_t ser_hal_transport_rx_pkt_free(uint8_t * p_buffer)
+{
+    TEST_ASSERT(p_buffer == m_rx_buf);
+    TEST_ASSERT(m_rx_buf_used);
+    m_rx_buf_used = false;
+    return NRF_SUCCESS;
+}
+
+
+bool ser_app_power_system_off_get(void)
+{
+    return false;
+}
+
+
+void ser_app_power_system_off_enter(void)
+{
+}
+
+
+static void ble_evt_handler(uint8_t * p_buffer, uint16_t length)
+{
+    TEST_ASSERT(false);
+}
+
+
+/**@brief Function for sending the responses to the oldest commands from the fake Connectivity
+ *        Chip.
+ *
+ * @param[in] count Number of commands to answer.
+ */
+static void peer_respond(uint32_t count)
+{
+    while (count-- > 0)
+    {
+        TEST_ASSERT(m_peer_answered < m_peer_sent);
+        TEST_ASSERT(!m_rx_buf_used);
+
+        peer_cmd_t const * p_cmd = &m_peer_cmds[m_peer_answered++];
+
+        m_rx_buf_used                                         = true;
+        m_rx_buf[SER_PKT_TYPE_POS]                            = SER_PKT_TYPE_RESP;
+        m_rx_buf[SER_PKT_TYPE_SIZE + SER_CMD_OP_CODE_POS]     = p_cmd->op_code;
+        (void)uint32_encode(p_cmd->status, &m_rx_buf[SER_PKT_TYPE_SIZE + SER_CMD_RSP_STATUS_CODE_POS]);
+        m_rx_buf[SER_PKT_TYPE_SIZE + SER_CMD_RSP_HEADER_SIZE] = p_cmd->output;
+
+        ser_hal_transport_evt_t evt =
+        {
+            .evt_type = SER_HAL_TRANSP_EVT_RX_PKT_RECEIVED,
+            .evt_params.rx_pkt_received =
+            {
+                .p_buffer     = m_rx_buf,
+                .num_of_bytes = sizeof(m_rx_buf),
+            },
+        };
+        m_hal_handler(evt);
+    }
+}
+
+
+/* The application waits for responses until the Connectivity Chip has answered everything. */
+static void os_rsp_wait_handler(void)
+{
+    peer_respond(m_peer_sent - m_peer_answered);
+}
+
+
+static void os_rsp_set_handler(void)
+{
+}
+
+
+/**@brief Response decoder, as generated for a SoftDevice call with one output parameter. */
+static uint32_t rsp_dec(const uint8_t * p_buffer, uint16_t length)
+{
+    TEST_ASSERT_EQUAL(SER_CMD_RSP_HEADER_SIZE + 1, length);
+    TEST_ASSERT(m_decoded_cnt < CMD_COUNT_MAX);
+
+    m_decoded[m_decoded_cnt].op_code = p_buffer[SER_CMD_OP_CODE_POS];
+    m_decoded[m_decoded_cnt].output  = p_buffer[SER_CMD_RSP_HEADER_SIZE];
+    m_decoded_cnt++;
+
+    return uint32_decode(&p_buffer[SER_CMD_RSP_STATUS_CODE_POS]);
+}
+
+
+/**@brief Function for making a SoftDevice call the way the generated middleware does.
+ *
+ * @return Return code of @ref ser_sd_transport_cmd_write.
+ */
+static uint32_t sd_call(uint8_t op_code)
+{
+    uint8_t * p_buf;
+    uint16_t  len;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_tx_alloc(&p_buf, &len));
+    p_buf[SER_PKT_TYPE_POS]    = SER_PKT_TYPE_CMD;
+    p_buf[SER_PKT_OP_CODE_POS] = op_code;
+    return ser_sd_transport_cmd_write(p_buf, SER_PKT_TYPE_SIZE + SER_OP_CODE_SIZE, rsp_dec);
+}
+
+
+static void reset(void)
+{
+    memset(m_peer_status, 0, sizeof(m_peer_status));
+    m_peer_sent     = 0;
+    m_peer_answered = 0;
+    m_decoded_cnt   = 0;
+}
+
+
+/* Every pipelined response is passed to the decoder of its command, in order, also when the
+ * responses arrive while commands are still being sent. */
+static void pipeline_decoders_run(void)
+{
+    uint8_t * p_buf;
+    uint16_t  len;
+
+    reset();
+    ser_sd_transport_pipeline_begin();
+    for (uint32_t i = 0; i < SER_SD_TRANSPORT_PIPELINE_DEPTH; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sd_call((uint8_t)(0x60 + i)));
+    }
+    TEST_ASSERT_EQUAL(0, m_decoded_cnt);
+    TEST_ASSERT(ser_sd_transport_is_busy());
+    TEST_ASSERT_EQUAL(NRF_ERROR_BUSY, ser_sd_transport_tx_alloc(&p_buf, &len));
+
+    peer_respond(3);
+    TEST_ASSERT_EQUAL(3, m_decoded_cnt);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sd_call((uint8_t)(0x70 + i)));
+    }
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_pipeline_end());
+    TEST_ASSERT(!ser_sd_transport_is_busy());
+    TEST_ASSERT_EQUAL(SER_SD_TRANSPORT_PIPELINE_DEPTH + 3, m_decoded_cnt);
+    for (uint32_t i = 0; i < m_decoded_cnt; i++)
+    {
+        TEST_ASSERT_EQUAL(m_peer_cmds[i].op_code, m_decoded[i].op_code);
+        TEST_ASSERT_EQUAL(0xA0 + i, m_decoded[i].output);
+    }
+    TEST_ASSERT(!m_rx_buf_used);
+}
+
+
+/* pipeline_end() reports the first error decoded, and the later responses are still decoded. */
+static void pipeline_first_error(void)
+{
+    reset();
+    m_peer_status[2] = NRF_ERROR_INVALID_PARAM;
+    m_peer_status[4] = NRF_ERROR_BUSY;
+
+    ser_sd_transport_pipeline_begin();
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sd_call((uint8_t)(0x60 + i)));
+    }
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM, ser_sd_transport_pipeline_end());
+    TEST_ASSERT_EQUAL(6, m_decoded_cnt);
+
+    // The next pipeline starts without an error.
+    reset();
+    ser_sd_transport_pipeline_begin();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sd_call(0x60));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_pipeline_end());
+}
+
+
+/* Outside pipelined mode, a call waits for its response and returns the decoded return code. */
+static void blocking_call(void)
+{
+    reset();
+    m_peer_status[1] = NRF_ERROR_NO_MEM;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sd_call(0x61));
+    TEST_ASSERT_EQUAL(1, m_decoded_cnt);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NO_MEM, sd_call(0x62));
+    TEST_ASSERT_EQUAL(2, m_decoded_cnt);
+    TEST_ASSERT_EQUAL(0xA1, m_decoded[1].output);
+    TEST_ASSERT(!ser_sd_transport_is_busy());
+}
+
+
+/* A physical layer error ends the wait for pipelined responses with NRF_ERROR_INTERNAL. */
+static void pipeline_phy_error(void)
+{
+    ser_hal_transport_evt_t evt = {.evt_type = SER_HAL_TRANSP_EVT_PHY_ERROR};
+
+    reset();
+    ser_sd_transport_pipeline_begin();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sd_call(0x60));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sd_call(0x61));
+    peer_respond(1);
+
+    m_hal_handler(evt);
+    m_peer_answered = m_peer_sent;
+    TEST_ASSERT(!ser_sd_transport_is_busy());
+    TEST_ASSERT_EQUAL(NRF_ERROR_INTERNAL, ser_sd_transport_pipeline_end());
+    TEST_ASSERT_EQUAL(1, m_decoded_cnt);
+}
+
+
+int main(void)
+{
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, ser_sd_transport_open(ble_evt_handler,
+                                                         NULL,
+                                                         os_rsp_wait_handler,
+                                                         os_rsp_set_handler,
+                                                         NULL));
+
+    host_test_run("pipeline_decoders_run", pipeline_decoders_run);
+    host_test_run("pipeline_first_error", pipeline_first_error);
+    host_test_run("blocking_call", blocking_call);
+    host_test_run("pipeline_phy_error", pipeline_phy_error);
+    return 0;
+}
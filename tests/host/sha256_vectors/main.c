@@ -0,0 +1,323 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the sha256 library with the FIPS 180-2 vectors, and a throughput benchmark of
+ *        the block-direct and the buffered update paths.
+ */
+#include <string.h>
+#include <stdlib.h>
+#include "host_test.h"
+#include "sdk_common.h"
+#include "sha256.h"
+
+#define SHA256_LEN          32          /**< Length of a digest. */
+#define MILLION_A_LEN       1000000     /**< Length of the one-million-'a' message. */
+#define SPLIT_DATA_LEN      4096        /**< Length of the message hashed in random chunks. */
+#define SPLIT_ROUNDS        200         /**< Number of random chunkings of the message. */
+#define BENCH_LEN           (1024 * 1024) /**< Number of bytes hashed by every benchmark run. */
+
+/**@brief Message with its expected digest. */
+typedef struct
+{
+    char const * p_msg;
+    uint8_t      digest[SHA256_LEN];
+} vector_t;
+
+/**@brief Message of bytes 0, 1, 2, ... with its expected digest. */
+typedef struct
+{
+    uint32_t len;
+    uint8_t  digest[SHA256_LEN];
+} counting_vector_t;
+
+static const vector_t m_vectors[] =
+{
+    {
+        "",
+        {0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+         0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55}
+    },
+    {
+        "abc",
+        {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+         0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad}
+    },
+    {
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+        {0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+         0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1}
+    },
+    {
+        "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+        {0xcf, 0x5b, 0x16, 0xa7, 0x78, 0xaf, 0x83, 0x80, 0x03, 0x6c, 0xe5, 0x9e, 0x7b, 0x04, 0x92, 0x37,
+         0x0b, 0x24, 0x9b, 0x11, 0xe8, 0xf0, 0x7a, 0x51, 0xaf, 0xac, 0x45, 0x03, 0x7a, 0xfe, 0xe9, 0xd1}
+    },
+};
+
+/* The lengths around the block size and the padding limit. */
+static const counting_vector_t m_counting_vectors[] =
+{
+    {
+        55,
+        {0x46, 0x3e, 0xb2, 0x8e, 0x72, 0xf8, 0x2e, 0x0a, 0x96, 0xc0, 0xa4, 0xcc, 0x53, 0x69, 0x0c, 0x57,
+         0x12, 0x81, 0x13, 0x1f, 0x67, 0x2a, 0xa2, 0x29, 0xe0, 0xd4, 0x5a, 0xe5, 0x9b, 0x59, 0x8b, 0x59}
+    },
+    {
+        56,
+        {0xda, 0x2a, 0xe4, 0xd6, 0xb3, 0x67, 0x48, 0xf2, 0xa3, 0x18, 0xf2, 0x3e, 0x7a, 0xb1, 0xdf, 0xdf,
+         0x45, 0xac, 0xdc, 0x9d, 0x04, 0x9b, 0xd8, 0x0e, 0x59, 0xde, 0x82, 0xa6, 0x08, 0x95, 0xf5, 0x62}
+    },
+    {
+        63,
+        {0x29, 0xaf, 0x26, 0x86, 0xfd, 0x53, 0x37, 0x4a, 0x36, 0xb0, 0x84, 0x66, 0x94, 0xcc, 0x34, 0x21,
+         0x77, 0xe4, 0x28, 0xd1, 0x64, 0x75, 0x15, 0xf0, 0x78, 0x78, 0x4d, 0x69, 0xcd, 0xb9, 0xe4, 0x88}
+    },
+    {
+        64,
+        {0xfd, 0xea, 0xb9, 0xac, 0xf3, 0x71, 0x03, 0x62, 0xbd, 0x26, 0x58, 0xcd, 0xc9, 0xa2, 0x9e, 0x8f,
+         0x9c, 0x75, 0x7f, 0xcf, 0x98, 0x11, 0x60, 0x3a, 0x8c, 0x44, 0x7c, 0xd1, 0xd9, 0x15, 0x11, 0x08}
+    },
+    {
+        65,
+        {0x4b, 0xfd, 0x2c, 0x8b, 0x6f, 0x1e, 0xec, 0x7a, 0x2a, 0xfe, 0xb4, 0x8b, 0x93, 0x4e, 0xe4, 0xb2,
+         0x69, 0x41, 0x82, 0x02, 0x7e, 0x6d, 0x0f, 0xc0, 0x75, 0x07, 0x4f, 0x2f, 0xab, 0xb3, 0x17, 0x81}
+    },
+    {
+        119,
+        {0xda, 0x18, 0x79, 0x7e, 0xd7, 0xc3, 0xa7, 0x77, 0xf0, 0x84, 0x7f, 0x42, 0x97, 0x24, 0xa2, 0xd8,
+         0xcd, 0x51, 0x38, 0xe6, 0xed, 0x28, 0x95, 0xc3, 0xfa, 0x1a, 0x6d, 0x39, 0xd1, 0x8f, 0x7e, 0xc6}
+    },
+    {
+        120,
+        {0xf5, 0x2b, 0x23, 0xdb, 0x1f, 0xbb, 0x6d, 0xed, 0x89, 0xef, 0x42, 0xa2, 0x3c, 0xe0, 0xc8, 0x92,
+         0x2c, 0x45, 0xf2, 0x5c, 0x50, 0xb5, 0x68, 0xa9, 0x3b, 0xf1, 0xc0, 0x75, 0x42, 0x0b, 0xbb, 0x7c}
+    },
+};
+
+static const uint8_t m_million_a_digest[SHA256_LEN] =
+{
+    0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+    0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0
+};
+
+
+static void hash(uint8_t const * p_data, size_t len, uint8_t * p_digest)
+{
+    sha256_context_t ctx;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_init(&ctx));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_update(&ctx, p_data, len));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, p_digest, false));
+}
+
+
+/* Hashes the data in chunks of random length, starting at a random offset into the buffer. */
+static void hash_split(uint8_t const * p_data, size_t len, uint32_t * p_seed, uint8_t * p_digest)
+{
+    sha256_context_t ctx;
+    size_t           done = 0;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_init(&ctx));
+    while (done < len)
+    {
+        size_t chunk = host_test_rand(p_seed) % 200;
+
+        chunk = MIN(chunk, len - done);
+
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_update(&ctx, &p_data[done], chunk));
+        done += chunk;
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, p_digest, false));
+}
+
+
+static void fips_vectors(void)
+{
+    uint8_t digest[SHA256_LEN];
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_vectors); i++)
+    {
+        hash((uint8_t const *)m_vectors[i].p_msg, strlen(m_vectors[i].p_msg), digest);
+        TEST_ASSERT(memcmp(digest, m_vectors[i].digest, SHA256_LEN) == 0);
+    }
+}
+
+
+/* Every message is hashed from each of the four word alignments, in one update and byte by
+ * byte, so that both the block-direct path and the buffered path produce the digest. */
+static void block_boundaries(void)
+{
+    static uint32_t buffer[64];
+    uint8_t       * p_buffer = (uint8_t *)buffer;
+    uint8_t         digest[SHA256_LEN];
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_counting_vectors); i++)
+    {
+        uint32_t len = m_counting_vectors[i].len;
+
+        for (uint32_t offset = 0; offset < sizeof(uint32_t); offset++)
+        {
+            sha256_context_t ctx;
+
+            for (uint32_t j = 0; j < len; j++)
+            {
+                p_buffer[offset + j] = (uint8_t)j;
+            }
+
+            hash(&p_buffer[offset], len, digest);
+            TEST_ASSERT(memcmp(digest, m_counting_vectors[i].digest, SHA256_LEN) == 0);
+
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_init(&ctx));
+            for (uint32_t j = 0; j < len; j++)
+            {
+                TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_update(&ctx, &p_buffer[offset + j], 1));
+            }
+            TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, digest, false));
+            TEST_ASSERT(memcmp(digest, m_counting_vectors[i].digest, SHA256_LEN) == 0);
+        }
+    }
+}
+
+
+static void million_a(void)
+{
+    uint8_t * p_msg = malloc(MILLION_A_LEN);
+    uint32_t  seed  = 0x5EED0031;
+    uint8_t   digest[SHA256_LEN];
+
+    TEST_ASSERT(p_msg != NULL);
+    memset(p_msg, 'a', MILLION_A_LEN);
+
+    hash(p_msg, MILLION_A_LEN, digest);
+    TEST_ASSERT(memcmp(digest, m_million_a_digest, SHA256_LEN) == 0);
+
+    hash_split(p_msg, MILLION_A_LEN, &seed, digest);
+    TEST_ASSERT(memcmp(digest, m_million_a_digest, SHA256_LEN) == 0);
+
+    free(p_msg);
+}
+
+
+/* Random chunkings of a random message give the digest of a single update. The chunks leave
+ * the context buffer at every fill level and the whole blocks at every alignment. */
+static void random_split(void)
+{
+    static uint8_t data[SPLIT_DATA_LEN];
+    uint32_t       seed = 0x5EED0131;
+    uint8_t        expected[SHA256_LEN];
+    uint8_t        digest[SHA256_LEN];
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)host_test_rand(&seed);
+    }
+    hash(data, sizeof(data), expected);
+
+    for (uint32_t round = 0; round < SPLIT_ROUNDS; round++)
+    {
+        hash_split(data, sizeof(data), &seed, digest);
+        TEST_ASSERT(memcmp(digest, expected, SHA256_LEN) == 0);
+    }
+}
+
+
+/* The little-endian digest is the big-endian digest reversed. */
+static void little_endian(void)
+{
+    sha256_context_t ctx;
+    uint8_t          digest[SHA256_LEN];
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_init(&ctx));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_update(&ctx, (uint8_t const *)"abc", 3));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, digest, true));
+
+    for (uint32_t i = 0; i < SHA256_LEN; i++)
+    {
+        TEST_ASSERT_EQUAL(m_vectors[1].digest[SHA256_LEN - 1 - i], digest[i]);
+    }
+}
+
+
+/* Hashes BENCH_LEN bytes in updates of @p chunk bytes and returns the throughput in MB/s. */
+static uint32_t bench_run(uint8_t const * p_data, size_t chunk)
+{
+    sha256_context_t ctx;
+    uint8_t          digest[SHA256_LEN];
+    uint64_t         start = host_test_time_ns();
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_init(&ctx));
+    for (size_t done = 0; done < BENCH_LEN; done += chunk)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_update(&ctx, &p_data[done], chunk));
+    }
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, sha256_final(&ctx, digest, false));
+
+    return (uint32_t)((uint64_t)BENCH_LEN * 1000 / MAX(host_test_time_ns() - start, 1));
+}
+
+
+/* Prints the throughput of whole aligned blocks, of whole unaligned blocks and of the buffered
+ * path that single-byte updates take. The figures are informational; host timing varies. */
+static void benchmark(void)
+{
+    uint32_t * p_buffer = malloc(BENCH_LEN + sizeof(uint32_t));
+    uint8_t  * p_data   = (uint8_t *)p_buffer;
+
+    TEST_ASSERT(p_buffer != NULL);
+    memset(p_data, 0xA5, BENCH_LEN + sizeof(uint32_t));
+
+    printf("    aligned blocks:   %u MB/s\n", (unsigned)bench_run(p_data, 4096));
+    printf("    unaligned blocks: %u MB/s\n", (unsigned)bench_run(p_data + 1, 4096));
+    printf("    byte updates:     %u MB/s\n", (unsigned)bench_run(p_data, 1));
+
+    free(p_buffer);
+}
+
+
+int main(void)
+{
+    host_test_run("fips_vectors", fips_vectors);
+    host_test_run("block_boundaries", block_boundaries);
+    host_test_run("million_a", million_a);
+    host_test_run("random_split", random_split);
+    host_test_run("little_endian", little_endian);
+    host_test_run("benchmark", benchmark);
+    return 0;
+}
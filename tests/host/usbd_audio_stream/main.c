@@ -0,0 +1,319 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Test of the USB Audio jitter buffer and rate matching against a drifting peripheral clock.
+ *
+ * USB frames and the peripheral clock are stepped in 1 ms increments. The peripheral moves
+ * whole DMA blocks, and its clock runs off the nominal sample rate by a fixed amount.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "app_usbd_audio.h"
+#include "app_usbd_audio_stream.h"
+
+#define SAMPLE_RATE     48000                   /**< Nominal sample rate. */
+#define FRAMES_PER_MS   (SAMPLE_RATE / 1000)    /**< Nominal sample frames per USB frame. */
+#define BLOCK_FRAMES    240                     /**< Sample frames per peripheral DMA block (5 ms). */
+#define EP_FRAMES       (FRAMES_PER_MS + 2)     /**< Sample frames per packet at most, with rate correction. */
+#define EP_SIZE         (4 * EP_FRAMES)         /**< Endpoint size: 16-bit stereo. */
+#define BUF_SIZE        (16 * 4 * FRAMES_PER_MS) /**< Jitter buffer size: 16 ms. */
+#define RUN_MS          120000                  /**< Length of one run. */
+#define SETTLE_MS       30000                   /**< Time given to the rate measurement to settle. */
+#define RATE_TOL_PPM    50                      /**< Accepted error of the matched rate. */
+#define DRIFT_PPM_OUT   300                     /**< Peripheral clock error in the OUT runs. */
+#define DRIFT_PPM_IN    400                     /**< Peripheral clock error in the IN runs. */
+
+static uint8_t m_jitter_buf[BUF_SIZE];
+
+
+/**@brief Function for getting the next value of a test signal that is never silent. */
+static int16_t ramp_next(uint32_t * p_count)
+{
+    return (int16_t)(1 + ((*p_count)++ % 32767));
+}
+
+
+/**@brief Function for advancing the peripheral clock by 1 ms.
+ *
+ * @return True if a DMA block is due.
+ */
+static bool dev_block_due(uint64_t * p_acc, int32_t ppm)
+{
+    *p_acc += (uint64_t)FRAMES_PER_MS * (1000000 + ppm);
+    if (*p_acc >= (uint64_t)BLOCK_FRAMES * 1000000)
+    {
+        *p_acc -= (uint64_t)BLOCK_FRAMES * 1000000;
+        return true;
+    }
+    return false;
+}
+
+
+static void rate_check(uint64_t frames, uint32_t ms, int32_t ppm)
+{
+    int64_t measured = (int64_t)(frames * 1000000 / ((uint64_t)ms * FRAMES_PER_MS)) - 1000000;
+
+    TEST_ASSERT(measured > ppm - RATE_TOL_PPM);
+    TEST_ASSERT(measured < ppm + RATE_TOL_PPM);
+}
+
+
+/* The host sends 16-bit stereo at the rate requested through the feedback endpoint, which it
+ * reads every refresh period. An I2S peripheral takes 24-bit stereo blocks. After settling,
+ * the buffer neither underruns nor overruns, and the signal comes out unbroken.
+ *
+ * Returns the average buffer level after settling, in sample frames. */
+static uint32_t out_run(int32_t ppm)
+{
+    app_usbd_audio_stream_t        stream;
+    app_usbd_audio_stream_stats_t  stats;
+    app_usbd_audio_stream_config_t config = {
+        .dir          = APP_USBD_AUDIO_STREAM_OUT,
+        .usb_fmt      = APP_USBD_AUDIO_PCM_S16,
+        .usb_channels = 2,
+        .dev_fmt      = APP_USBD_AUDIO_PCM_S24_4,
+        .dev_channels = 2,
+        .sample_rate  = SAMPLE_RATE,
+        .ep_size      = EP_SIZE,
+        .p_buf        = m_jitter_buf,
+        .buf_size     = sizeof(m_jitter_buf),
+    };
+    static int16_t packet[2 * EP_FRAMES];
+    static int32_t block[2 * BLOCK_FRAMES];
+    uint32_t       host_count = 0;
+    uint32_t       dev_count  = 0;
+    bool           started    = false;
+    uint32_t       feedback;
+    uint32_t       host_acc   = 0;
+    uint64_t       dev_acc    = 0;
+    uint64_t       sent       = 0;
+    uint64_t       level_sum  = 0;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_audio_stream_init(&stream, &config));
+    /* An empty buffer asks for more than the nominal rate. */
+    feedback = app_usbd_audio_stream_feedback_get(&stream);
+    TEST_ASSERT(feedback > (FRAMES_PER_MS << APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS));
+
+    for (uint32_t ms = 0; ms < RUN_MS; ms++)
+    {
+        host_acc += feedback;
+        uint32_t frames = host_acc >> APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS;
+        host_acc -= frames << APP_USBD_AUDIO_STREAM_RATE_FRACT_BITS;
+        TEST_ASSERT(frames <= EP_FRAMES);
+
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            packet[2 * i]     = ramp_next(&host_count);
+            packet[2 * i + 1] = packet[2 * i];
+        }
+        if (ms >= SETTLE_MS)
+        {
+            sent      += frames;
+            level_sum += app_usbd_audio_stream_level_get(&stream);
+        }
+        (void)app_usbd_audio_stream_usb_write(&stream, packet, frames * 4);
+
+        if (dev_block_due(&dev_acc, ppm))
+        {
+            app_usbd_audio_stream_dev_read(&stream, block, BLOCK_FRAMES);
+            for (uint32_t i = 0; i < BLOCK_FRAMES; i++)
+            {
+                started |= (block[2 * i] != 0);
+                if (started)
+                {
+                    int32_t expected = (int32_t)ramp_next(&dev_count) << 8;
+                    TEST_ASSERT_EQUAL(expected, block[2 * i]);
+                    TEST_ASSERT_EQUAL(expected, block[2 * i + 1]);
+                }
+            }
+        }
+
+        app_usbd_audio_stream_sof(&stream);
+        if ((ms % (1U << APP_USBD_AUDIO_FEEDBACK_REFRESH)) == 0)
+        {
+            feedback = app_usbd_audio_stream_feedback_get(&stream);
+        }
+        if (ms == SETTLE_MS)
+        {
+            app_usbd_audio_stream_stats_get(&stream, &stats);
+        }
+    }
+
+    app_usbd_audio_stream_stats_get(&stream, &stats);
+    TEST_ASSERT_EQUAL(0, stats.underruns);
+    TEST_ASSERT_EQUAL(0, stats.overruns);
+    TEST_ASSERT(stats.level_min > 0);
+    TEST_ASSERT(stats.level_max < BUF_SIZE / 4);
+    rate_check(sent, RUN_MS - SETTLE_MS, ppm);
+    return (uint32_t)(level_sum / (RUN_MS - SETTLE_MS));
+}
+
+
+/* The level correction alone would also keep the buffer from running dry, but only with a
+ * level offset that grows with the drift. The measured rate removes that offset. */
+static void out_drift(void)
+{
+    uint32_t fast = out_run(DRIFT_PPM_OUT);
+    uint32_t slow = out_run(-DRIFT_PPM_OUT);
+
+    TEST_ASSERT(fast <= slow + 1);
+    TEST_ASSERT(slow <= fast + 1);
+}
+
+
+/* A PDM peripheral delivers 16-bit mono blocks, and the host reads one 16-bit stereo packet
+ * per frame. After settling, the packet sizes follow the peripheral clock without underruns
+ * or overruns, and the signal arrives unbroken on both channels.
+ *
+ * Returns the average buffer level after settling, in sample frames. */
+static uint32_t in_run(int32_t ppm)
+{
+    app_usbd_audio_stream_t        stream;
+    app_usbd_audio_stream_stats_t  stats;
+    app_usbd_audio_stream_config_t config = {
+        .dir          = APP_USBD_AUDIO_STREAM_IN,
+        .usb_fmt      = APP_USBD_AUDIO_PCM_S16,
+        .usb_channels = 2,
+        .dev_fmt      = APP_USBD_AUDIO_PCM_S16,
+        .dev_channels = 1,
+        .sample_rate  = SAMPLE_RATE,
+        .ep_size      = EP_SIZE,
+        .p_buf        = m_jitter_buf,
+        .buf_size     = sizeof(m_jitter_buf),
+    };
+    static int16_t packet[2 * EP_FRAMES];
+    static int16_t block[BLOCK_FRAMES];
+    uint32_t       dev_count  = 0;
+    uint32_t       host_count = 0;
+    uint64_t       dev_acc    = 0;
+    uint64_t       received   = 0;
+    uint64_t       level_sum  = 0;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_audio_stream_init(&stream, &config));
+
+    for (uint32_t ms = 0; ms < RUN_MS; ms++)
+    {
+        if (dev_block_due(&dev_acc, ppm))
+        {
+            for (uint32_t i = 0; i < BLOCK_FRAMES; i++)
+            {
+                block[i] = ramp_next(&dev_count);
+            }
+            app_usbd_audio_stream_dev_write(&stream, block, BLOCK_FRAMES);
+        }
+
+        app_usbd_audio_stream_sof(&stream);
+        size_t size = app_usbd_audio_stream_usb_read(&stream, packet);
+        TEST_ASSERT(size <= config.ep_size);
+        for (uint32_t i = 0; i < size / 4; i++)
+        {
+            int16_t expected = ramp_next(&host_count);
+            TEST_ASSERT_EQUAL(expected, packet[2 * i]);
+            TEST_ASSERT_EQUAL(expected, packet[2 * i + 1]);
+        }
+        if (ms >= SETTLE_MS)
+        {
+            received  += size / 4;
+            level_sum += app_usbd_audio_stream_level_get(&stream);
+        }
+        if (ms == SETTLE_MS)
+        {
+            app_usbd_audio_stream_stats_get(&stream, &stats);
+        }
+    }
+
+    app_usbd_audio_stream_stats_get(&stream, &stats);
+    TEST_ASSERT_EQUAL(0, stats.underruns);
+    TEST_ASSERT_EQUAL(0, stats.overruns);
+    TEST_ASSERT(stats.level_min > 0);
+    TEST_ASSERT(stats.level_max < BUF_SIZE / 4);
+    rate_check(received, RUN_MS - SETTLE_MS, ppm);
+    return (uint32_t)(level_sum / (RUN_MS - SETTLE_MS));
+}
+
+
+static void in_drift(void)
+{
+    uint32_t fast = in_run(DRIFT_PPM_IN);
+    uint32_t slow = in_run(-DRIFT_PPM_IN);
+
+    TEST_ASSERT(fast <= slow + 1);
+    TEST_ASSERT(slow <= fast + 1);
+}
+
+
+static void pcm_convert(void)
+{
+    uint8_t const s24_3[6]   = { 0x56, 0x34, 0x92, 0x01, 0x00, 0x00 };
+    int16_t const mono[2]    = { 0x1234, -2 };
+    int32_t const s32[2]     = { 0x12345678, -0x10000 };
+    int32_t       s24_4[2];
+    int16_t       stereo[4];
+    int16_t       s16[2];
+
+    /* Widening sign-extends into the right-aligned container. */
+    app_usbd_audio_pcm_convert(s24_4, APP_USBD_AUDIO_PCM_S24_4, 2,
+                               s24_3, APP_USBD_AUDIO_PCM_S24_3, 2, 1);
+    TEST_ASSERT_EQUAL(-0x6DCBAA, s24_4[0]);
+    TEST_ASSERT_EQUAL(1, s24_4[1]);
+
+    /* A mono source is duplicated to both channels. */
+    app_usbd_audio_pcm_convert(stereo, APP_USBD_AUDIO_PCM_S16, 2,
+                               mono, APP_USBD_AUDIO_PCM_S16, 1, 2);
+    TEST_ASSERT_EQUAL(0x1234, stereo[0]);
+    TEST_ASSERT_EQUAL(0x1234, stereo[1]);
+    TEST_ASSERT_EQUAL(-2, stereo[2]);
+    TEST_ASSERT_EQUAL(-2, stereo[3]);
+
+    /* Narrowing keeps the most significant bits, and extra source channels are dropped. */
+    app_usbd_audio_pcm_convert(s16, APP_USBD_AUDIO_PCM_S16, 1,
+                               s32, APP_USBD_AUDIO_PCM_S32, 1, 2);
+    TEST_ASSERT_EQUAL(0x1234, s16[0]);
+    TEST_ASSERT_EQUAL(-1, s16[1]);
+}
+
+
+int main(void)
+{
+    host_test_run("out_drift", out_drift);
+    host_test_run("in_drift", in_drift);
+    host_test_run("pcm_convert", pcm_convert);
+    return 0;
+}
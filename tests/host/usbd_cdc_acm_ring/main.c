@@ -0,0 +1,632 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host test of the CDC ACM receive ring and scatter-list writes.
+ *
+ * The class runs against a stubbed USB stack: app_usbd_ep_handled_transfer() only records the
+ * handler of the endpoint, and the test then plays the peripheral. For the OUT endpoint it asks
+ * the consumer for a buffer, copies a packet into it and reports the transfer, as the driver
+ * does after the DMA. For the IN endpoint it calls the feeder until the transfer ends.
+ *
+ * The feeder sends packets in place only from RAM. nrfx_is_in_ram() checks for the device RAM
+ * address range, so the RAM segments are placed in a mapping at that address and static
+ * constants stand for flash.
+ */
+#include <string.h>
+#include <sys/mman.h>
+#include "host_test.h"
+#include "app_usbd_cdc_acm.h"
+
+#define CDC_ACM_COMM_INTERFACE  0
+#define CDC_ACM_COMM_EPIN       NRF_DRV_USBD_EPIN2
+#define CDC_ACM_DATA_INTERFACE  1
+#define CDC_ACM_DATA_EPIN       NRF_DRV_USBD_EPIN1
+#define CDC_ACM_DATA_EPOUT      NRF_DRV_USBD_EPOUT1
+
+#define EP_SIZE                 NRF_DRV_USBD_EPSIZE
+#define DEVICE_RAM_BASE         (0x20000000UL)  /**< Start of the device RAM, see nrfx_is_in_ram(). */
+#define DEVICE_RAM_SIZE         (4096)          /**< Size of the mapping standing for RAM. */
+#define TX_PACKETS_MAX          (16)            /**< Packets recorded per IN transfer. */
+
+/* Endpoint as seen by the stubbed driver. */
+typedef struct
+{
+    bool                        armed;
+    nrf_drv_usbd_handler_desc_t desc;
+    uint32_t                    aborts;
+} test_ep_t;
+
+/* IN transfer read by the host. */
+typedef struct
+{
+    uint8_t         data[TX_PACKETS_MAX * EP_SIZE];
+    size_t          size;
+    size_t          packet_sizes[TX_PACKETS_MAX];
+    uint8_t const * p_packets[TX_PACKETS_MAX];
+    size_t          packet_cnt;
+} test_in_transfer_t;
+
+static void cdc_acm_user_ev_handler(app_usbd_class_inst_t const * p_inst,
+                                    app_usbd_cdc_acm_user_event_t event);
+
+APP_USBD_CDC_ACM_GLOBAL_DEF(m_cdc_acm,
+                            cdc_acm_user_ev_handler,
+                            CDC_ACM_COMM_INTERFACE,
+                            CDC_ACM_DATA_INTERFACE,
+                            CDC_ACM_COMM_EPIN,
+                            CDC_ACM_DATA_EPIN,
+                            CDC_ACM_DATA_EPOUT,
+                            APP_USBD_CDC_COMM_PROTOCOL_AT_V250
+);
+
+static test_ep_t  m_ep_out;
+static test_ep_t  m_ep_in;
+static uint8_t    m_feeder_buffer[EP_SIZE];
+static uint32_t   m_rx_done_cnt;
+static uint32_t   m_tx_done_cnt;
+static uint8_t  * mp_ram;           /**< Mapping at the device RAM address. */
+static uint32_t   m_rand_state = 0x5EED1234;
+
+
+static void cdc_acm_user_ev_handler(app_usbd_class_inst_t const * p_inst,
+                                    app_usbd_cdc_acm_user_event_t event)
+{
+    UNUSED_PARAMETER(p_inst);
+
+    switch (event)
+    {
+        case APP_USBD_CDC_ACM_USER_EVT_RX_DONE:
+            m_rx_done_cnt++;
+            break;
+        case APP_USBD_CDC_ACM_USER_EVT_TX_DONE:
+            m_tx_done_cnt++;
+            break;
+        default:
+            break;
+    }
+}
+
+
+static test_ep_t * test_ep_get(nrf_drv_usbd_ep_t ep)
+{
+    if (ep == CDC_ACM_DATA_EPOUT)
+    {
+        return &m_ep_out;
+    }
+    TEST_ASSERT_EQUAL(CDC_ACM_DATA_EPIN, ep);
+    return &m_ep_in;
+}
+
+
+ret_code_t app_usbd_ep_handled_transfer(nrf_drv_usbd_ep_t                         ep,
+                                        nrf_drv_usbd_handler_desc_t const * const p_handler)
+{
+    test_ep_t * p_ep = test_ep_get(ep);
+
+    if (p_ep->armed)
+    {
+        return NRF_ERROR_BUSY;
+    }
+    p_ep->armed = true;
+    p_ep->desc  = *p_handler;
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_usbd_ep_transfer(nrf_drv_usbd_ep_t                     ep,
+                                nrf_drv_usbd_transfer_t const * const p_transfer)
+{
+    UNUSED_PARAMETER(ep);
+    UNUSED_PARAMETER(p_transfer);
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+bool nrfx_usbd_ep_is_busy(nrfx_usbd_ep_t ep)
+{
+    return test_ep_get(ep)->armed;
+}
+
+
+void nrfx_usbd_ep_abort(nrfx_usbd_ep_t ep)
+{
+    test_ep_t * p_ep = test_ep_get(ep);
+
+    p_ep->armed = false;
+    p_ep->aborts++;
+}
+
+
+void * nrfx_usbd_feeder_buffer_get(void)
+{
+    return m_feeder_buffer;
+}
+
+
+ret_code_t app_usbd_class_descriptor_find(app_usbd_class_inst_t const * const p_cinst,
+                                          uint8_t                             desc_type,
+                                          uint8_t                             desc_index,
+                                          uint8_t                           * p_desc,
+                                          size_t                            * p_desc_len)
+{
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
+ret_code_t app_usbd_core_setup_rsp(app_usbd_setup_t const * p_setup,
+                                   void const *             p_data,
+                                   size_t                   size)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+ret_code_t app_usbd_core_setup_data_handler_set(
+    nrf_drv_usbd_ep_t ep,
+    app_usbd_core_setup_data_handler_desc_t const * const p_handler_desc)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+void * app_usbd_core_setup_transfer_buff_get(size_t * p_size)
+{
+    return NULL;
+}
+
+
+static ret_code_t class_event_send(app_usbd_complex_evt_t const * p_evt)
+{
+    app_usbd_class_inst_t const * p_inst = app_usbd_cdc_acm_class_inst_get(&m_cdc_acm);
+
+    return p_inst->p_class_methods->event_handler(p_inst, p_evt);
+}
+
+
+static void ep_transfer_evt_send(nrf_drv_usbd_ep_t ep, nrf_drv_usbd_ep_status_t status)
+{
+    app_usbd_complex_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.drv_evt.data.eptransfer.ep     = ep;
+    evt.drv_evt.data.eptransfer.status = status;
+    evt.type                           = APP_USBD_EVT_DRV_EPTRANSFER;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, class_event_send(&evt));
+}
+
+
+/* The host sets or clears DTR, which opens or closes the port. */
+static void port_dtr_set(bool dtr)
+{
+    app_usbd_complex_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.setup_evt.type                = APP_USBD_EVT_DRV_SETUP;
+    evt.setup_evt.setup.bmRequestType = 0x21; // Class request to an interface, host to device.
+    evt.setup_evt.setup.bRequest      = APP_USBD_CDC_REQ_SET_CONTROL_LINE_STATE;
+    evt.setup_evt.setup.wValue.w      = dtr ? APP_USBD_CDC_ACM_LINE_STATE_DTR : 0;
+    evt.setup_evt.setup.wIndex.w      = CDC_ACM_COMM_INTERFACE;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, class_event_send(&evt));
+}
+
+
+/* Resets the port and the stubbed endpoints and opens the port. */
+static void port_open(void)
+{
+    app_usbd_complex_evt_t evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.type = APP_USBD_EVT_DRV_RESET;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, class_event_send(&evt));
+    app_usbd_cdc_acm_stats_clear(&m_cdc_acm);
+
+    memset(&m_ep_out, 0, sizeof(m_ep_out));
+    memset(&m_ep_in, 0, sizeof(m_ep_in));
+    m_rx_done_cnt = 0;
+    m_tx_done_cnt = 0;
+
+    port_dtr_set(true);
+}
+
+
+static void rand_fill(uint8_t * p_buf, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        p_buf[i] = (uint8_t)host_test_rand(&m_rand_state);
+    }
+}
+
+
+/* The host sends one packet on the armed OUT endpoint. Returns where the class placed it. */
+static uint8_t const * host_packet_send(uint8_t const * p_data, size_t size)
+{
+    nrf_drv_usbd_ep_transfer_t next;
+    uint32_t                   rx_done_cnt = m_rx_done_cnt;
+
+    TEST_ASSERT(size <= EP_SIZE);
+    TEST_ASSERT(m_ep_out.armed);
+
+    memset(&next, 0, sizeof(next));
+    // The ring consumer finalizes the transfer after every packet.
+    TEST_ASSERT(!m_ep_out.desc.handler.consumer(&next, m_ep_out.desc.p_context, EP_SIZE, size));
+    TEST_ASSERT_EQUAL(size, next.size);
+    memcpy(next.p_data.rx, p_data, size);
+
+    m_ep_out.armed = false;
+    ep_transfer_evt_send(CDC_ACM_DATA_EPOUT, NRF_USBD_EP_OK);
+    TEST_ASSERT_EQUAL(rx_done_cnt + 1, m_rx_done_cnt);
+
+    return next.p_data.rx;
+}
+
+
+/* Gets the oldest span and checks it against the expected data. */
+static void span_check(uint8_t const * p_expected, size_t size)
+{
+    uint8_t const * p_data;
+    size_t          length;
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_get(&m_cdc_acm, &p_data, &length));
+    TEST_ASSERT_EQUAL(size, length);
+    TEST_ASSERT_EQUAL(0, memcmp(p_data, p_expected, size));
+}
+
+
+/* The host reads the armed IN transfer to its end. */
+static void host_transfer_read(test_in_transfer_t * p_tr)
+{
+    nrf_drv_usbd_ep_transfer_t next;
+    bool                       more = true;
+
+    memset(p_tr, 0, sizeof(*p_tr));
+    TEST_ASSERT(m_ep_in.armed);
+
+    while (more)
+    {
+        TEST_ASSERT(p_tr->packet_cnt < TX_PACKETS_MAX);
+
+        memset(&next, 0, sizeof(next));
+        more = m_ep_in.desc.handler.feeder(&next, m_ep_in.desc.p_context, EP_SIZE);
+        TEST_ASSERT(next.size <= EP_SIZE);
+        // Every packet but the last must be full, or the host ends the transfer early.
+        TEST_ASSERT(!more || (next.size == EP_SIZE));
+
+        memcpy(&p_tr->data[p_tr->size], next.p_data.tx, next.size);
+        p_tr->size                          += next.size;
+        p_tr->packet_sizes[p_tr->packet_cnt] = next.size;
+        p_tr->p_packets[p_tr->packet_cnt]    = next.p_data.tx;
+        p_tr->packet_cnt++;
+    }
+
+    m_ep_in.armed = false;
+    ep_transfer_evt_send(CDC_ACM_DATA_EPIN, NRF_USBD_EP_OK);
+}
+
+
+/* Packets are placed back to back. A packet that does not fit before the end of the ring goes
+ * to its start, also when it is short, and the data before the wrap point is read first. */
+static void ring_wrap_short_packet(void)
+{
+    static uint8_t           ring[3 * EP_SIZE + 32];
+    uint8_t                  pkt[5][EP_SIZE];
+    uint8_t                  joined[3 * EP_SIZE];
+    app_usbd_cdc_acm_stats_t stats;
+
+    port_open();
+    for (size_t i = 0; i < ARRAY_SIZE(pkt); i++)
+    {
+        rand_fill(pkt[i], EP_SIZE);
+    }
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring, sizeof(ring)));
+    TEST_ASSERT(m_ep_out.armed);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      app_usbd_cdc_acm_rx_span_get(&m_cdc_acm, &(uint8_t const *){NULL}, &(size_t){0}));
+
+    TEST_ASSERT(host_packet_send(pkt[0], EP_SIZE) == &ring[0]);
+    TEST_ASSERT(host_packet_send(pkt[1], EP_SIZE) == &ring[EP_SIZE]);
+    TEST_ASSERT(host_packet_send(pkt[2], 30) == &ring[2 * EP_SIZE]);
+    TEST_ASSERT(m_ep_out.armed);
+
+    // 2 * EP_SIZE + 30: the two full packets and the short one are one span.
+    memcpy(joined, pkt[0], EP_SIZE);
+    memcpy(&joined[EP_SIZE], pkt[1], EP_SIZE);
+    memcpy(&joined[2 * EP_SIZE], pkt[2], 30);
+    span_check(joined, 2 * EP_SIZE + 30);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_LENGTH,
+                      app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 2 * EP_SIZE + 30 + 1));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 2 * EP_SIZE));
+    span_check(pkt[2], 30);
+
+    // 2 * EP_SIZE + 30 + EP_SIZE leaves 2 bytes before the end: the next packet wraps.
+    TEST_ASSERT(host_packet_send(pkt[3], EP_SIZE) == &ring[2 * EP_SIZE + 30]);
+    TEST_ASSERT(m_ep_out.armed);
+    TEST_ASSERT(host_packet_send(pkt[4], 10) == &ring[0]);
+
+    memcpy(joined, pkt[2], 30);
+    memcpy(&joined[30], pkt[3], EP_SIZE);
+    span_check(joined, 30 + EP_SIZE);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 30));
+    span_check(pkt[3], EP_SIZE);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, EP_SIZE));
+    span_check(pkt[4], 10);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 10));
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      app_usbd_cdc_acm_rx_span_get(&m_cdc_acm, &(uint8_t const *){NULL}, &(size_t){0}));
+
+    app_usbd_cdc_acm_stats_get(&m_cdc_acm, &stats);
+    TEST_ASSERT_EQUAL(4 * EP_SIZE + 30 + 10 - EP_SIZE, stats.rx_bytes);
+    TEST_ASSERT_EQUAL(0, stats.rx_ring_full);
+
+    app_usbd_cdc_acm_rx_ring_stop(&m_cdc_acm);
+}
+
+
+/* A full ring leaves the endpoint unarmed and counts it. Releasing data re-arms it once a
+ * packet fits again. */
+static void ring_full_rearm(void)
+{
+    static uint8_t           ring[2 * EP_SIZE];
+    uint8_t                  pkt[4][EP_SIZE];
+    app_usbd_cdc_acm_stats_t stats;
+
+    port_open();
+    for (size_t i = 0; i < ARRAY_SIZE(pkt); i++)
+    {
+        rand_fill(pkt[i], EP_SIZE);
+    }
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring, sizeof(ring)));
+    (void)host_packet_send(pkt[0], EP_SIZE);
+    TEST_ASSERT(m_ep_out.armed);
+    (void)host_packet_send(pkt[1], EP_SIZE);
+    TEST_ASSERT(!m_ep_out.armed);
+
+    app_usbd_cdc_acm_stats_get(&m_cdc_acm, &stats);
+    TEST_ASSERT_EQUAL(1, stats.rx_ring_full);
+    TEST_ASSERT_EQUAL(2 * EP_SIZE, stats.rx_bytes);
+
+    // Less than a packet freed: still no room.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, EP_SIZE - 1));
+    TEST_ASSERT(!m_ep_out.armed);
+
+    // A packet fits before the read position: the next one goes to the start of the ring.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 1));
+    TEST_ASSERT(m_ep_out.armed);
+    TEST_ASSERT(host_packet_send(pkt[2], 20) == &ring[0]);
+    TEST_ASSERT(!m_ep_out.armed);
+    app_usbd_cdc_acm_stats_get(&m_cdc_acm, &stats);
+    TEST_ASSERT_EQUAL(2, stats.rx_ring_full);
+
+    span_check(pkt[1], EP_SIZE);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, EP_SIZE));
+    TEST_ASSERT(m_ep_out.armed);
+    span_check(pkt[2], 20);
+
+    app_usbd_cdc_acm_rx_ring_stop(&m_cdc_acm);
+
+    // A packet exactly fills the room between the wrapped write position and the read position.
+    static uint8_t ring3[3 * EP_SIZE];
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring3, sizeof(ring3)));
+    for (size_t i = 0; i < 3; i++)
+    {
+        (void)host_packet_send(pkt[i], EP_SIZE);
+    }
+    TEST_ASSERT(!m_ep_out.armed);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 2 * EP_SIZE));
+    TEST_ASSERT(host_packet_send(pkt[3], EP_SIZE) == &ring3[0]);
+    TEST_ASSERT(m_ep_out.armed);
+    TEST_ASSERT(host_packet_send(pkt[0], EP_SIZE) == &ring3[EP_SIZE]);
+    TEST_ASSERT(!m_ep_out.armed);
+    app_usbd_cdc_acm_rx_ring_stop(&m_cdc_acm);
+
+    // Emptied while unarmed: the ring starts over from the beginning rather than wrapping, so
+    // the room after the last packet stays usable.
+    static uint8_t ring4[2 * EP_SIZE + 32];
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring4, sizeof(ring4)));
+    (void)host_packet_send(pkt[0], EP_SIZE);
+    (void)host_packet_send(pkt[1], EP_SIZE);
+    TEST_ASSERT(!m_ep_out.armed);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 2 * EP_SIZE));
+    TEST_ASSERT(host_packet_send(pkt[2], 10) == &ring4[0]);
+    TEST_ASSERT(host_packet_send(pkt[3], EP_SIZE) == &ring4[10]);
+    TEST_ASSERT(m_ep_out.armed);
+    TEST_ASSERT(host_packet_send(pkt[0], EP_SIZE) == &ring4[10 + EP_SIZE]);
+    TEST_ASSERT(!m_ep_out.armed);
+
+    app_usbd_cdc_acm_stats_get(&m_cdc_acm, &stats);
+    TEST_ASSERT_EQUAL(6, stats.rx_ring_full);
+
+    app_usbd_cdc_acm_rx_ring_stop(&m_cdc_acm);
+}
+
+
+/* Stopping an armed ring aborts the OUT transfer, and the abort event leaves the port idle. */
+static void ring_stop_while_armed(void)
+{
+    static uint8_t ring[2 * EP_SIZE];
+    uint8_t        pkt[EP_SIZE];
+    uint8_t        buf[8];
+
+    port_open();
+    rand_fill(pkt, sizeof(pkt));
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring, sizeof(ring)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE,
+                      app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring, sizeof(ring)));
+    (void)host_packet_send(pkt, 16);
+    TEST_ASSERT(m_ep_out.armed);
+
+    app_usbd_cdc_acm_rx_ring_stop(&m_cdc_acm);
+    TEST_ASSERT_EQUAL(1, m_ep_out.aborts);
+    TEST_ASSERT(!m_ep_out.armed);
+    ep_transfer_evt_send(CDC_ACM_DATA_EPOUT, NRF_USBD_EP_ABORTED);
+    TEST_ASSERT(!m_ep_out.armed);
+
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE,
+                      app_usbd_cdc_acm_rx_span_get(&m_cdc_acm, &(uint8_t const *){NULL}, &(size_t){0}));
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, app_usbd_cdc_acm_rx_span_release(&m_cdc_acm, 0));
+
+    // The port can go back to reads through the internal buffer, and to the ring after that.
+    TEST_ASSERT_EQUAL(NRF_ERROR_IO_PENDING, app_usbd_cdc_acm_read(&m_cdc_acm, buf, sizeof(buf)));
+    TEST_ASSERT(m_ep_out.armed);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE,
+                      app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring, sizeof(ring)));
+
+    // A stopped ring that was full has no transfer to abort.
+    port_open();
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring, sizeof(ring)));
+    (void)host_packet_send(pkt, EP_SIZE);
+    (void)host_packet_send(pkt, EP_SIZE);
+    TEST_ASSERT(!m_ep_out.armed);
+    app_usbd_cdc_acm_rx_ring_stop(&m_cdc_acm);
+    TEST_ASSERT_EQUAL(0, m_ep_out.aborts);
+
+    // Closing the port also stops the ring.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_rx_ring_start(&m_cdc_acm, ring, sizeof(ring)));
+    port_dtr_set(false);
+    TEST_ASSERT(!m_ep_out.armed);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE,
+                      app_usbd_cdc_acm_rx_span_get(&m_cdc_acm, &(uint8_t const *){NULL}, &(size_t){0}));
+}
+
+
+/* Flash data of the scatter lists. */
+static uint8_t const m_flash_seg[EP_SIZE + 30] = { 0xF1, 0xF2, 0xF3, 0xF4, [EP_SIZE + 29] = 0xFF };
+
+
+/* Full packets inside one RAM segment are sent in place. Packets that span segments or come
+ * from flash are gathered. A transfer of a multiple of the endpoint size ends with a ZLP. */
+static void list_gather_zlp(void)
+{
+    static test_in_transfer_t tr;
+    uint8_t                   expected[4 * EP_SIZE];
+    app_usbd_cdc_acm_stats_t  stats;
+
+    uint8_t * p_seg0 = mp_ram;
+    uint8_t * p_seg3 = mp_ram + 1024;
+
+    port_open();
+    rand_fill(p_seg0, 100);
+    rand_fill(p_seg3, 126);
+
+    // 100 + 30 + 0 + 126 = 4 * EP_SIZE.
+    app_usbd_cdc_acm_tx_seg_t const segs[] =
+    {
+        { p_seg0,          100 },
+        { m_flash_seg + 4, 30  },
+        { p_seg3,          0   },
+        { p_seg3,          126 },
+    };
+    memcpy(expected, p_seg0, 100);
+    memcpy(&expected[100], m_flash_seg + 4, 30);
+    memcpy(&expected[130], p_seg3, 126);
+
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_write_list(&m_cdc_acm, segs, ARRAY_SIZE(segs)));
+    TEST_ASSERT_EQUAL(NRF_ERROR_BUSY, app_usbd_cdc_acm_write_list(&m_cdc_acm, segs, ARRAY_SIZE(segs)));
+    host_transfer_read(&tr);
+
+    TEST_ASSERT_EQUAL(4 * EP_SIZE, tr.size);
+    TEST_ASSERT_EQUAL(0, memcmp(tr.data, expected, sizeof(expected)));
+    TEST_ASSERT_EQUAL(5, tr.packet_cnt);
+    TEST_ASSERT(tr.p_packets[0] == p_seg0);             // In place.
+    TEST_ASSERT(tr.p_packets[1] == m_feeder_buffer);    // RAM tail and flash.
+    TEST_ASSERT(tr.p_packets[2] == m_feeder_buffer);    // Flash tail, skipped empty segment and RAM.
+    TEST_ASSERT(tr.p_packets[3] == p_seg3 + 62);        // In place.
+    TEST_ASSERT_EQUAL(0, tr.packet_sizes[4]);           // ZLP.
+    TEST_ASSERT_EQUAL(1, m_tx_done_cnt);
+
+    app_usbd_cdc_acm_stats_get(&m_cdc_acm, &stats);
+    TEST_ASSERT_EQUAL(4 * EP_SIZE, stats.tx_bytes);
+
+    // Not a multiple of the endpoint size: the short packet ends the transfer. A full packet of
+    // flash data is gathered too.
+    app_usbd_cdc_acm_tx_seg_t const segs_flash[] =
+    {
+        { m_flash_seg, sizeof(m_flash_seg) },
+        { p_seg0,      6                   },
+    };
+    TEST_ASSERT_EQUAL(NRF_SUCCESS,
+                      app_usbd_cdc_acm_write_list(&m_cdc_acm, segs_flash, ARRAY_SIZE(segs_flash)));
+    host_transfer_read(&tr);
+    TEST_ASSERT_EQUAL(sizeof(m_flash_seg) + 6, tr.size);
+    TEST_ASSERT_EQUAL(0, memcmp(tr.data, m_flash_seg, sizeof(m_flash_seg)));
+    TEST_ASSERT_EQUAL(0, memcmp(&tr.data[sizeof(m_flash_seg)], p_seg0, 6));
+    TEST_ASSERT_EQUAL(2, tr.packet_cnt);
+    TEST_ASSERT(tr.p_packets[0] == m_feeder_buffer);
+    TEST_ASSERT_EQUAL(36, tr.packet_sizes[1]);
+
+    // A single full RAM segment: one packet in place and a ZLP.
+    app_usbd_cdc_acm_tx_seg_t const segs_one[] = { { p_seg3, EP_SIZE } };
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_cdc_acm_write_list(&m_cdc_acm, segs_one, 1));
+    host_transfer_read(&tr);
+    TEST_ASSERT_EQUAL(2, tr.packet_cnt);
+    TEST_ASSERT(tr.p_packets[0] == p_seg3);
+    TEST_ASSERT_EQUAL(0, tr.packet_sizes[1]);
+
+    app_usbd_cdc_acm_stats_get(&m_cdc_acm, &stats);
+    TEST_ASSERT_EQUAL(4 * EP_SIZE + sizeof(m_flash_seg) + 6 + EP_SIZE, stats.tx_bytes);
+    TEST_ASSERT_EQUAL(3, m_tx_done_cnt);
+
+    // A closed port takes no writes.
+    port_dtr_set(false);
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_STATE, app_usbd_cdc_acm_write_list(&m_cdc_acm, segs_one, 1));
+}
+
+
+int main(void)
+{
+    mp_ram = mmap((void *)DEVICE_RAM_BASE,
+                  DEVICE_RAM_SIZE,
+                  PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                  -1,
+                  0);
+    TEST_ASSERT(mp_ram == (uint8_t *)DEVICE_RAM_BASE);
+    TEST_ASSERT(nrfx_is_in_ram(mp_ram));
+    TEST_ASSERT(!nrfx_is_in_ram(m_flash_seg));
+
+    host_test_run("ring_wrap_short_packet", ring_wrap_short_packet);
+    host_test_run("ring_full_rearm", ring_full_rearm);
+    host_test_run("ring_stop_while_armed", ring_stop_while_armed);
+    host_test_run("list_gather_zlp", list_gather_zlp);
+    return 0;
+}
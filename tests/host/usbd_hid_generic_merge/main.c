@@ -0,0 +1,505 @@
+/**
+ * Copyright (c) 2020, Nordic Semiconductor ASA
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ *
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ *
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+/**
+ * @brief Host test of the HID generic IN report coalescing.
+ *
+ * The class runs against a stubbed USB stack: app_usbd_ep_transfer() records the IN transfer
+ * and the test completes it with an endpoint event, as the host does when it polls the
+ * endpoint. Reports merged while the endpoint is busy must add up the relative fields with
+ * saturation and keep the latest value of the other bytes, without touching the report in
+ * flight.
+ */
+#include <string.h>
+#include "host_test.h"
+#include "app_usbd_hid_generic.h"
+#include "app_usbd_hid_mouse_desc.h"
+
+#define HID_GENERIC_INTERFACE   0
+#define HID_GENERIC_EPIN        NRF_DRV_USBD_EPIN1
+#define REPORT_IN_QUEUE_SIZE    2
+#define REPORT_OUT_MAXSIZE      0
+#define REPORT_FEATURE_MAXSIZE  0
+
+#define MOUSE_REPORT_ID         1   /**< Report: ID, buttons, X (int8), Y (int16). */
+#define MOUSE_REPORT_SIZE       5
+#define WHEEL_REPORT_ID         2   /**< Report: ID, wheel (int8), pan (int8). */
+#define WHEEL_REPORT_SIZE       3
+
+/* IN transfer as seen by the stubbed driver. */
+typedef struct
+{
+    bool            armed;
+    uint8_t const * p_data;
+    size_t          size;
+    uint8_t         data[NRF_DRV_USBD_EPSIZE];  /**< Copy taken when the transfer starts. */
+} test_in_transfer_t;
+
+static void hid_user_ev_handler(app_usbd_class_inst_t const * p_inst,
+                                app_usbd_hid_user_event_t event);
+
+APP_USBD_HID_GENERIC_SUBCLASS_REPORT_DESC(mouse_desc, APP_USBD_HID_MOUSE_REPORT_DSC_BUTTON(2));
+
+static const app_usbd_hid_subclass_desc_t * reps[] = {&mouse_desc};
+
+APP_USBD_HID_GENERIC_GLOBAL_DEF(m_hid_generic,
+                                HID_GENERIC_INTERFACE,
+                                hid_user_ev_handler,
+                                (HID_GENERIC_EPIN),
+                                reps,
+                                REPORT_IN_QUEUE_SIZE,
+                                REPORT_OUT_MAXSIZE,
+                                REPORT_FEATURE_MAXSIZE,
+                                APP_USBD_HID_SUBCLASS_BOOT,
+                                APP_USBD_HID_PROTO_MOUSE);
+
+static const app_usbd_hid_generic_rel_field_t m_mouse_rel[] =
+{
+    { .offset = 2, .size = 1 },
+    { .offset = 3, .size = 2 },
+};
+
+static const app_usbd_hid_generic_rel_field_t m_wheel_rel[] =
+{
+    { .offset = 1, .size = 1 },
+    { .offset = 2, .size = 1 },
+};
+
+static uint8_t                           m_mouse_buf[2 * MOUSE_REPORT_SIZE];
+static uint8_t                           m_wheel_buf[2 * WHEEL_REPORT_SIZE];
+static app_usbd_hid_generic_merge_slot_t m_slots[2];
+static test_in_transfer_t                m_in;
+static uint32_t                          m_in_done_cnt;
+
+
+static void hid_user_ev_handler(app_usbd_class_inst_t const * p_inst,
+                                app_usbd_hid_user_event_t event)
+{
+    UNUSED_PARAMETER(p_inst);
+
+    if (event == APP_USBD_HID_USER_EVT_IN_REPORT_DONE)
+    {
+        m_in_done_cnt++;
+    }
+}
+
+
+ret_code_t app_usbd_ep_transfer(nrf_drv_usbd_ep_t                     ep,
+                                nrf_drv_usbd_transfer_t const * const p_transfer)
+{
+    TEST_ASSERT_EQUAL(HID_GENERIC_EPIN, ep);
+    TEST_ASSERT(!m_in.armed);
+    TEST_ASSERT(p_transfer->size <= sizeof(m_in.data));
+
+    m_in.armed  = true;
+    m_in.p_data = p_transfer->p_data.tx;
+    m_in.size   = p_transfer->size;
+    memcpy(m_in.data, m_in.p_data, m_in.size);
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_usbd_core_setup_rsp(app_usbd_setup_t const * p_setup,
+                                   void const *             p_data,
+                                   size_t                   size)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+ret_code_t app_usbd_core_setup_data_handler_set(nrf_drv_usbd_ep_t                         ep,
+                                                app_usbd_core_setup_data_handler_desc_t const * const p_handler_desc)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+
+bool app_usbd_wakeup_req(void)
+{
+    return false;
+}
+
+
+void * app_usbd_core_setup_transfer_buff_get(size_t * p_size)
+{
+    *p_size = 0;
+    return NULL;
+}
+
+
+ret_code_t app_usbd_class_descriptor_find(app_usbd_class_inst_t const * const p_cinst,
+                                          uint8_t                             desc_type,
+                                          uint8_t                             desc_index,
+                                          uint8_t                           * p_desc,
+                                          size_t                            * p_desc_len)
+{
+    return NRF_ERROR_NOT_FOUND;
+}
+
+
+ret_code_t app_usbd_class_sof_register(app_usbd_class_inst_t const * p_cinst)
+{
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_usbd_class_sof_unregister(app_usbd_class_inst_t const * p_cinst)
+{
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_usbd_class_rwu_register(app_usbd_class_inst_t const * const p_inst)
+{
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_usbd_class_rwu_unregister(app_usbd_class_inst_t const * const p_inst)
+{
+    return NRF_SUCCESS;
+}
+
+
+void nrfx_usbd_ep_abort(nrfx_usbd_ep_t ep)
+{
+    TEST_ASSERT_EQUAL(HID_GENERIC_EPIN, ep);
+    m_in.armed = false;
+}
+
+
+/* The host reads the IN report: the transfer ends and the class is told about it. */
+static void host_in_read(void)
+{
+    app_usbd_class_inst_t const * p_inst = app_usbd_hid_generic_class_inst_get(&m_hid_generic);
+    app_usbd_complex_evt_t        evt;
+
+    TEST_ASSERT(m_in.armed);
+    m_in.armed = false;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.drv_evt.data.eptransfer.ep     = HID_GENERIC_EPIN;
+    evt.drv_evt.data.eptransfer.status = NRF_USBD_EP_OK;
+    evt.type                           = APP_USBD_EVT_DRV_EPTRANSFER;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, p_inst->p_class_methods->event_handler(p_inst, &evt));
+}
+
+
+/* Checks the report on the bus against the expected bytes. */
+static void in_check(uint8_t const * p_expected, size_t size)
+{
+    TEST_ASSERT(m_in.armed);
+    TEST_ASSERT_EQUAL(size, m_in.size);
+    TEST_ASSERT(memcmp(m_in.data, p_expected, size) == 0);
+    /* The report in flight must not change until the transfer ends. */
+    TEST_ASSERT(memcmp(m_in.p_data, p_expected, size) == 0);
+}
+
+
+static void mouse_report_make(uint8_t * p_rep, uint8_t buttons, int8_t x, int16_t y)
+{
+    p_rep[0] = MOUSE_REPORT_ID;
+    p_rep[1] = buttons;
+    p_rep[2] = (uint8_t)x;
+    (void)uint16_encode((uint16_t)y, &p_rep[3]);
+}
+
+
+static void wheel_report_make(uint8_t * p_rep, int8_t wheel, int8_t pan)
+{
+    p_rep[0] = WHEEL_REPORT_ID;
+    p_rep[1] = (uint8_t)wheel;
+    p_rep[2] = (uint8_t)pan;
+}
+
+
+static void merge_start(void)
+{
+    memset(m_slots, 0, sizeof(m_slots));
+    m_slots[0].report_id = MOUSE_REPORT_ID;
+    m_slots[0].size      = MOUSE_REPORT_SIZE;
+    m_slots[0].rel_count = ARRAY_SIZE(m_mouse_rel);
+    m_slots[0].p_rel     = m_mouse_rel;
+    m_slots[0].p_buf     = m_mouse_buf;
+    m_slots[1].report_id = WHEEL_REPORT_ID;
+    m_slots[1].size      = WHEEL_REPORT_SIZE;
+    m_slots[1].rel_count = ARRAY_SIZE(m_wheel_rel);
+    m_slots[1].p_rel     = m_wheel_rel;
+    m_slots[1].p_buf     = m_wheel_buf;
+
+    TEST_ASSERT(!m_in.armed);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_merge_set(&m_hid_generic, m_slots, 2));
+    app_usbd_hid_generic_stats_clear(&m_hid_generic);
+    m_in_done_cnt = 0;
+}
+
+
+/* Relative fields add up with saturation, other bytes keep the latest value. */
+static void merge_saturation(void)
+{
+    app_usbd_hid_generic_stats_t stats;
+    uint8_t rep[MOUSE_REPORT_SIZE];
+    uint8_t first[MOUSE_REPORT_SIZE];
+    uint8_t expected[MOUSE_REPORT_SIZE];
+
+    merge_start();
+
+    // The endpoint is idle: the first report goes out at once, from the second half of the slot.
+    mouse_report_make(first, 0x01, 5, -5);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        first,
+                                                                        sizeof(first)));
+    in_check(first, sizeof(first));
+    TEST_ASSERT(m_in.p_data == m_mouse_buf + MOUSE_REPORT_SIZE);
+
+    // Reports merged while the endpoint is busy.
+    mouse_report_make(rep, 0x02, 100, 30000);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        rep,
+                                                                        sizeof(rep)));
+    mouse_report_make(rep, 0x03, 20, -100);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        rep,
+                                                                        sizeof(rep)));
+    app_usbd_hid_generic_stats_get(&m_hid_generic, &stats);
+    TEST_ASSERT_EQUAL(1, stats.merged);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+
+    mouse_report_make(rep, 0x00, 10, 5000);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        rep,
+                                                                        sizeof(rep)));
+    in_check(first, sizeof(first));
+
+    host_in_read();
+    mouse_report_make(expected, 0x00, INT8_MAX, INT16_MAX);
+    in_check(expected, sizeof(expected));
+
+    // Negative saturation, merged into the first half while the second one is on the bus.
+    mouse_report_make(rep, 0x04, -100, -30000);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        rep,
+                                                                        sizeof(rep)));
+    in_check(expected, sizeof(expected));
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        rep,
+                                                                        sizeof(rep)));
+    in_check(expected, sizeof(expected));
+
+    host_in_read();
+    mouse_report_make(expected, 0x04, INT8_MIN, INT16_MIN);
+    in_check(expected, sizeof(expected));
+
+    // Nothing is pending: the endpoint goes idle and the next report is sent at once.
+    host_in_read();
+    TEST_ASSERT(!m_in.armed);
+    mouse_report_make(rep, 0x01, -1, 1);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        rep,
+                                                                        sizeof(rep)));
+    in_check(rep, sizeof(rep));
+    host_in_read();
+
+    app_usbd_hid_generic_stats_get(&m_hid_generic, &stats);
+    TEST_ASSERT_EQUAL(4, stats.sent);
+    TEST_ASSERT_EQUAL(3, stats.merged);
+    TEST_ASSERT_EQUAL(2, stats.dropped);
+    TEST_ASSERT_EQUAL(4, m_in_done_cnt);
+}
+
+
+/* Slots take turns: a slot that was just sent waits for the others. */
+static void merge_round_robin(void)
+{
+    uint8_t mouse[MOUSE_REPORT_SIZE];
+    uint8_t wheel[WHEEL_REPORT_SIZE];
+
+    merge_start();
+
+    mouse_report_make(mouse, 0x00, 1, 1);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        mouse,
+                                                                        sizeof(mouse)));
+    in_check(mouse, sizeof(mouse));
+
+    // Mouse merged first, but the wheel slot is next in turn.
+    mouse_report_make(mouse, 0x00, 2, 2);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        mouse,
+                                                                        sizeof(mouse)));
+    wheel_report_make(wheel, 3, -3);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        wheel,
+                                                                        sizeof(wheel)));
+    host_in_read();
+    in_check(wheel, sizeof(wheel));
+    TEST_ASSERT(m_in.p_data == m_wheel_buf + WHEEL_REPORT_SIZE);
+
+    // Wheel pending again, the mouse has waited longer.
+    wheel_report_make(wheel, 4, -4);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        wheel,
+                                                                        sizeof(wheel)));
+    host_in_read();
+    in_check(mouse, sizeof(mouse));
+
+    host_in_read();
+    in_check(wheel, sizeof(wheel));
+
+    host_in_read();
+    TEST_ASSERT(!m_in.armed);
+}
+
+
+/* Queued reports go before merged ones, and an overflowing queue counts drops. */
+static void queue_priority(void)
+{
+    app_usbd_hid_generic_stats_t stats;
+    uint8_t mouse[MOUSE_REPORT_SIZE];
+    uint8_t queued[3][4] = { { 0xA0 }, { 0xA1 }, { 0xA2 } };
+
+    merge_start();
+
+    mouse_report_make(mouse, 0x00, 1, 1);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        mouse,
+                                                                        sizeof(mouse)));
+    mouse_report_make(mouse, 0x01, 7, 7);
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_merge(&m_hid_generic,
+                                                                        mouse,
+                                                                        sizeof(mouse)));
+
+    // Queue of two: the third report overwrites the oldest one.
+    for (size_t i = 0; i < ARRAY_SIZE(queued); i++)
+    {
+        TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_set(&m_hid_generic,
+                                                                          queued[i],
+                                                                          sizeof(queued[i])));
+    }
+    app_usbd_hid_generic_stats_get(&m_hid_generic, &stats);
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+
+    host_in_read();
+    in_check(queued[1], sizeof(queued[1]));
+    TEST_ASSERT(m_in.p_data == queued[1]);
+    host_in_read();
+    in_check(queued[2], sizeof(queued[2]));
+    host_in_read();
+    in_check(mouse, sizeof(mouse));
+    host_in_read();
+    TEST_ASSERT(!m_in.armed);
+
+    // A queued report on an idle endpoint is sent at once.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_in_report_set(&m_hid_generic,
+                                                                      queued[0],
+                                                                      sizeof(queued[0])));
+    in_check(queued[0], sizeof(queued[0]));
+    host_in_read();
+
+    app_usbd_hid_generic_stats_get(&m_hid_generic, &stats);
+    TEST_ASSERT_EQUAL(5, stats.sent);
+    TEST_ASSERT_EQUAL(0, stats.merged);
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+
+    app_usbd_hid_generic_stats_clear(&m_hid_generic);
+    app_usbd_hid_generic_stats_get(&m_hid_generic, &stats);
+    TEST_ASSERT_EQUAL(0, stats.sent + stats.merged + stats.dropped);
+}
+
+
+static void merge_set_args(void)
+{
+    app_usbd_hid_generic_rel_field_t rel = { .offset = 0, .size = 1 };
+    app_usbd_hid_generic_merge_slot_t slot;
+    uint8_t buf[2 * (NRF_DRV_USBD_EPSIZE + 1)];
+    uint8_t rep[MOUSE_REPORT_SIZE];
+
+    memset(&slot, 0, sizeof(slot));
+    slot.size = 4;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      app_usbd_hid_generic_merge_set(&m_hid_generic, &slot, 1));
+    slot.p_buf = buf;
+    slot.size  = 0;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      app_usbd_hid_generic_merge_set(&m_hid_generic, &slot, 1));
+    slot.size = NRF_DRV_USBD_EPSIZE + 1;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      app_usbd_hid_generic_merge_set(&m_hid_generic, &slot, 1));
+    slot.size = NRF_DRV_USBD_EPSIZE;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_merge_set(&m_hid_generic, &slot, 1));
+
+    slot.size      = 4;
+    slot.p_rel     = &rel;
+    slot.rel_count = 1;
+    rel.size       = 3;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      app_usbd_hid_generic_merge_set(&m_hid_generic, &slot, 1));
+    rel.size   = 2;
+    rel.offset = 3;
+    TEST_ASSERT_EQUAL(NRF_ERROR_INVALID_PARAM,
+                      app_usbd_hid_generic_merge_set(&m_hid_generic, &slot, 1));
+    rel.offset = 2;
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_merge_set(&m_hid_generic, &slot, 1));
+
+    // Reports are matched on the ID and the size.
+    merge_start();
+    mouse_report_make(rep, 0x00, 0, 0);
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      app_usbd_hid_generic_in_report_merge(&m_hid_generic, rep, sizeof(rep) - 1));
+    rep[0] = 3;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      app_usbd_hid_generic_in_report_merge(&m_hid_generic, rep, sizeof(rep)));
+    TEST_ASSERT(!m_in.armed);
+
+    // Without slots, nothing is merged.
+    TEST_ASSERT_EQUAL(NRF_SUCCESS, app_usbd_hid_generic_merge_set(&m_hid_generic, NULL, 2));
+    rep[0] = MOUSE_REPORT_ID;
+    TEST_ASSERT_EQUAL(NRF_ERROR_NOT_FOUND,
+                      app_usbd_hid_generic_in_report_merge(&m_hid_generic, rep, sizeof(rep)));
+}
+
+
+int main(void)
+{
+    host_test_run("merge_saturation", merge_saturation);
+    host_test_run("merge_round_robin", merge_round_robin);
+    host_test_run("queue_priority", queue_priority);
+    host_test_run("merge_set_args", merge_set_args);
+    return 0;
+}